@@ -14,6 +14,14 @@
  **/
 void libspdm_sleep(uint64_t milliseconds);
 
+/**
+ * Returns a monotonic time stamp, for measuring elapsed time.
+ *
+ * @return the time stamp, in nanoseconds since an unspecified starting point.
+ *
+ **/
+uint64_t libspdm_get_time_ns(void);
+
 /**
  * If no heartbeat arrives in seconds, the watchdog timeout event
  * should terminate the session.
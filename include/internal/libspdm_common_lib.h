@@ -12,6 +12,8 @@
 
 #define INVALID_SESSION_ID 0
 
+#define LIBSPDM_PEER_CERT_CHAIN_SLOT_ID_UNKNOWN 0xFF
+
 typedef struct {
     uint8_t spdm_version_count;
     spdm_version_number_t spdm_version[SPDM_MAX_VERSION_COUNT];
@@ -38,6 +40,13 @@ typedef struct {
     uint16_t key_schedule;
 } libspdm_device_algorithm_t;
 
+typedef struct {
+    uint32_t base_hash_algo;
+    const void *cert_chain;
+    uintn cert_chain_size;
+    uint8_t hash[LIBSPDM_MAX_HASH_SIZE];
+} libspdm_cert_chain_hash_cache_t;
+
 typedef struct {
 
     /* Local device info*/
@@ -54,6 +63,10 @@ typedef struct {
     uint8_t slot_count;
     /* My provisioned certificate (for slot_id - 0xFF, default 0)*/
     uint8_t provisioned_slot_id;
+    /* Digest of local_cert_chain_provision for each slot.
+     * An entry is valid while it matches the negotiated hash algorithm and the provisioned
+     * chain. It is flushed when LIBSPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN is set.*/
+    libspdm_cert_chain_hash_cache_t local_cert_chain_hash[SPDM_MAX_SLOT_COUNT];
 
     /* Peer Root Certificate*/
 
@@ -68,6 +81,8 @@ typedef struct {
     uintn peer_cert_chain_provision_size;
     /* Peer Cert verify*/
     libspdm_verify_spdm_cert_chain_func verify_peer_spdm_cert_chain;
+    /* Largest portion requested by GET_CERTIFICATE, 0 means LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN*/
+    uint16_t cert_chain_block_len;
 
     /* PSK provision locally*/
 
@@ -105,12 +120,17 @@ typedef struct {
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     uint8_t peer_used_cert_chain_buffer[LIBSPDM_MAX_CERT_CHAIN_SIZE];
     uintn peer_used_cert_chain_buffer_size;
+    /* index of the certificates in peer_used_cert_chain_buffer, after the root hash */
+    libspdm_cert_chain_index_t peer_used_cert_chain_index;
 #else
     uint8_t peer_used_cert_chain_buffer_hash[LIBSPDM_MAX_HASH_SIZE];
     uint32_t peer_used_cert_chain_buffer_hash_size;
     /* leaf cert public key of the peer */
     void *peer_used_leaf_cert_public_key;
 #endif
+    /* slot of the peer certificate chain, LIBSPDM_PEER_CERT_CHAIN_SLOT_ID_UNKNOWN if it was
+     * set by the integrator*/
+    uint8_t peer_used_cert_chain_slot_id;
 
     /* Local Used CertificateChain (for responder, or requester in mut auth)*/
 
@@ -171,9 +191,15 @@ typedef struct {
     libspdm_small_managed_buffer_t message_mut_c;
     libspdm_large_managed_buffer_t message_m;
 #else
-    void                   *digest_context_m1m2;
-    void                   *digest_context_mut_m1m2;
-    void                   *digest_context_l1l2;
+    /* The hash states are embedded, so the transcript hashing needs no allocation.
+     * A state is not started while its hash_nid is LIBSPDM_CRYPTO_NID_NULL.*/
+    libspdm_hash_state_t digest_context_m1m2;
+    libspdm_hash_state_t digest_context_mut_m1m2;
+    libspdm_hash_state_t digest_context_l1l2;
+#endif
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    /* measurement generation at the first GET_MEASUREMENTS of L1/L2 (responder only)*/
+    uint32_t measurement_generation;
 #endif
 } libspdm_transcript_t;
 
@@ -237,14 +263,20 @@ typedef struct {
     libspdm_medium_managed_buffer_t temp_message_k;
     bool message_f_initialized;
     bool finished_key_ready;
-    void                   *digest_context_th;
-    void                   *digest_context_l1l2;
-    void                   *hmac_rsp_context_th;
-    void                   *hmac_req_context_th;
+    /* A hash state is not started while its hash_nid is LIBSPDM_CRYPTO_NID_NULL,
+     * an HMAC state while its base_hash_algo is 0.*/
+    libspdm_hash_state_t digest_context_th;
+    libspdm_hash_state_t digest_context_l1l2;
+    libspdm_hmac_state_t hmac_rsp_context_th;
+    libspdm_hmac_state_t hmac_req_context_th;
     /* this is back up for message F reset.*/
-    void                   *digest_context_th_backup;
-    void                   *hmac_rsp_context_th_backup;
-    void                   *hmac_req_context_th_backup;
+    libspdm_hash_state_t digest_context_th_backup;
+    libspdm_hmac_state_t hmac_rsp_context_th_backup;
+    libspdm_hmac_state_t hmac_req_context_th_backup;
+#endif
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    /* measurement generation at the first GET_MEASUREMENTS of L1/L2 (responder only)*/
+    uint32_t measurement_generation;
 #endif
 } libspdm_session_transcript_t;
 
@@ -258,6 +290,58 @@ typedef struct {
     void *secured_message_context;
 } libspdm_session_info_t;
 
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+/* One measurement summary hash of the cached measurement generation.*/
+typedef struct {
+    /* 0 if the summary hash is not cached.*/
+    uint32_t generation;
+    spdm_version_number_t spdm_version;
+    uint8_t measurement_spec;
+    uint32_t measurement_hash_algo;
+    uint32_t base_hash_algo;
+    uint8_t hash[LIBSPDM_MAX_HASH_SIZE];
+} libspdm_measurement_summary_hash_cache_t;
+
+#define LIBSPDM_MEASUREMENT_SUMMARY_HASH_CACHE_TCB 0
+#define LIBSPDM_MEASUREMENT_SUMMARY_HASH_CACHE_ALL 1
+#define LIBSPDM_MEASUREMENT_SUMMARY_HASH_CACHE_COUNT 2
+
+/* Measurements of one device measurement generation, filled on the first use.*/
+typedef struct {
+    /* 0 if the measurement record is not cached.*/
+    uint32_t generation;
+    spdm_version_number_t spdm_version;
+    uint8_t measurement_spec;
+    uint32_t measurement_hash_algo;
+    bool raw_bit_stream;
+    /* all measurement blocks, as returned for measurement index 0xFF*/
+    uint8_t measurement_count;
+    uintn measurement_record_size;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    libspdm_measurement_summary_hash_cache_t
+        summary_hash[LIBSPDM_MEASUREMENT_SUMMARY_HASH_CACHE_COUNT];
+} libspdm_measurement_cache_t;
+#endif
+
+#if LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT
+/* The last verified measurement record of the peer, with the generation of every block.*/
+typedef struct {
+    /* incremented whenever a cached measurement block changes, never reset*/
+    uint32_t generation;
+    /* the blocks that changed before this generation are not known*/
+    uint32_t base_generation;
+    /* 0 if the measurement record is not cached.*/
+    uint8_t measurement_count;
+    uint8_t index[LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT];
+    /* the generation in which the block last changed*/
+    uint32_t block_generation[LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT];
+    uint32_t block_offset[LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT];
+    uint32_t block_size[LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT];
+    uint32_t measurement_record_size;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+} libspdm_peer_measurement_cache_t;
+#endif
+
 #define LIBSPDM_MAX_ENCAP_REQUEST_OP_CODE_SEQUENCE_COUNT 3
 typedef struct {
     uint32_t error_state;
@@ -272,14 +356,41 @@ typedef struct {
     spdm_message_header_t last_encap_request_header;
     uintn last_encap_request_size;
     uint16_t cert_chain_total_len;
-    libspdm_large_managed_buffer_t certificate_chain_buffer;
+    /* config.max_cert_chain_size bytes, laid out after the context*/
+    libspdm_managed_buffer_t *certificate_chain_buffer;
 } libspdm_encap_context_t;
 
-#define libspdm_context_struct_version 0x2
+#pragma pack(1)
+typedef struct {
+    spdm_message_header_t header;
+    uint16_t portion_length;
+    uint16_t remainder_length;
+    uint8_t cert_chain[LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN];
+} libspdm_certificate_response_max_t;
+#pragma pack()
+
+/* The buffers of GET_CERTIFICATE, kept in the context instead of on the stack.*/
+typedef struct {
+    libspdm_certificate_response_max_t response;
+    /* the whole certificate chain, if it is recorded or verified by the integrator*/
+    libspdm_large_managed_buffer_t cert_chain_buffer;
+    libspdm_cert_chain_stream_t cert_chain_stream;
+} libspdm_get_certificate_context_t;
+
+#define libspdm_context_struct_version 0x3
 
 typedef struct {
     uint32_t version;
 
+    /* Sizes of the buffers laid out after the context, see libspdm_init_context_ex()*/
+
+    libspdm_context_config_t config;
+    uintn context_size;
+
+    /* Set if the context is allocated by libspdm_allocate_context()*/
+
+    libspdm_context_free_func free_func;
+
     /* IO information*/
 
     libspdm_device_send_message_func send_message;
@@ -290,15 +401,36 @@ typedef struct {
     libspdm_transport_encode_message_func transport_encode_message;
     libspdm_transport_decode_message_func transport_decode_message;
 
+    /* Memory scope of the crypto objects*/
+
+    libspdm_memory_scope_func memory_scope;
+
+#if LIBSPDM_TRACE_SUPPORT
+    /* Trace events*/
+
+    libspdm_trace_func trace;
+    libspdm_trace_get_time_func trace_get_time;
+    uint8_t trace_request_code;
+#endif
+
+#if LIBSPDM_MESSAGE_CAPTURE_SUPPORT
+    /* Message capture*/
+
+    libspdm_capture_header_t *capture;
+    uint8_t capture_flags;
+    libspdm_trace_get_time_func capture_get_time;
+#endif
+
 
     /* command status*/
 
     uint32_t error_state;
 
     /* Cached plain text command
-     * If the command is cipher text, decrypt then cache it.*/
+     * If the command is cipher text, decrypt then cache it.
+     * config.max_message_size bytes, laid out after the context.*/
 
-    uint8_t last_spdm_request[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    uint8_t *last_spdm_request;
     uintn last_spdm_request_size;
 
     /* Cache session_id in this spdm_message, only valid for secured message.*/
@@ -320,6 +452,12 @@ typedef struct {
     uintn get_encap_response_func;
     libspdm_encap_context_t encap_context;
 
+#if LIBSPDM_ENABLE_CAPABILITY_CERT_CAP
+    /* Buffers of the peer certificate chain being received (requester only)*/
+
+    libspdm_get_certificate_context_t get_certificate_context;
+#endif
+
     /* Register spdm_session_state_callback function (responder only)
      * Register can know the state after StartSession / EndSession.*/
 
@@ -336,7 +474,19 @@ typedef struct {
     libspdm_connection_info_t connection_info;
     libspdm_transcript_t transcript;
 
-    libspdm_session_info_t session_info[LIBSPDM_MAX_SESSION_COUNT];
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    /* Measurements of the latest device measurement generation (responder only)*/
+    libspdm_measurement_cache_t measurement_cache;
+#endif
+
+#if LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT
+    /* Measurements of the peer of this connection (requester only)*/
+    libspdm_peer_measurement_cache_t peer_measurement_cache;
+#endif
+
+    /* config.max_session_count sessions, laid out after the context*/
+
+    libspdm_session_info_t *session_info;
 
     /* Cache lastest session ID for HANDSHAKE_IN_THE_CLEAR*/
 
@@ -346,10 +496,11 @@ typedef struct {
 
     libspdm_response_state_t response_state;
 
-    /* Cached data for SPDM_ERROR_CODE_RESPONSE_NOT_READY/SPDM_RESPOND_IF_READY*/
+    /* Cached data for SPDM_ERROR_CODE_RESPONSE_NOT_READY/SPDM_RESPOND_IF_READY
+     * cache_spdm_request is config.max_message_size bytes, laid out after the context.*/
 
     spdm_error_data_response_not_ready_t error_data;
-    uint8_t cache_spdm_request[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    uint8_t *cache_spdm_request;
     uintn cache_spdm_request_size;
     uint8_t current_token;
 
@@ -358,6 +509,11 @@ typedef struct {
     uint8_t retry_times;
     bool crypto_request;
 
+    /* Error code of the ERROR response to the last request, 0 if the response was not
+     * an ERROR or no response was received (requester only)*/
+
+    uint8_t peer_error_code;
+
 
     /* App context data for use by application*/
 
@@ -374,8 +530,9 @@ typedef struct {
      * this buffer is the transport message recived from spdm_context->receive_message()
      * or sent to spdm_context->send_message(). This message may be SPDM transport message
      * or secured SPDM transport message.
+     * It is config.max_message_size bytes, laid out after the context.
      **/
-    uint8_t request_response[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    uint8_t *request_response;
 
     /**
      * The BIT0 control to generate SPDM_ERROR_CODE_DECRYPT_ERROR response or drop the request silently.
@@ -469,6 +626,18 @@ void libspdm_init_managed_buffer(void *managed_buffer,
 void libspdm_reset_message_buffer_via_request_code(void *context, void *session_info,
                                                    uint8_t request_code);
 
+#if LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT
+/**
+ * Drop the cached measurements of the peer.
+ *
+ * The generation keeps counting, so every block of the next cached measurement record
+ * is reported as changed since any earlier generation.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ **/
+void libspdm_invalidate_peer_measurement_cache(libspdm_context_t *spdm_context);
+#endif
+
 /**
  * This function initializes the session info.
  *
@@ -497,6 +666,70 @@ uint16_t libspdm_allocate_req_session_id(libspdm_context_t *spdm_context);
  **/
 uint16_t libspdm_allocate_rsp_session_id(const libspdm_context_t *spdm_context);
 
+/**
+ * This function notifies the registered memory scope function of a memory scope event.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_id                    The session ID of the scope, or INVALID_SESSION_ID.
+ * @param  event                         The memory scope event.
+ **/
+void libspdm_notify_memory_scope(libspdm_context_t *spdm_context, uint32_t session_id,
+                                 libspdm_memory_scope_event_t event);
+
+#if LIBSPDM_TRACE_SUPPORT
+/**
+ * This function returns the start time stamp of a traced phase.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ *
+ * @return the time stamp, or 0 if no trace function is registered.
+ **/
+uint64_t libspdm_trace_begin(libspdm_context_t *spdm_context);
+
+/**
+ * This function emits the trace event of a phase to the registered trace function.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  phase                         The phase.
+ * @param  session_id                    The session ID, or INVALID_SESSION_ID.
+ * @param  size                          The size in bytes of the message, or 0.
+ * @param  start_time                    The time stamp returned by libspdm_trace_begin.
+ **/
+void libspdm_trace_end(libspdm_context_t *spdm_context, libspdm_trace_phase_t phase,
+                       uint32_t session_id, uintn size, uint64_t start_time);
+
+/**
+ * This function sets the request code of the following trace events.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  request_code                  The request code, or 0 for an APP message.
+ **/
+#define libspdm_trace_set_request_code(spdm_context, request_code) \
+    ((spdm_context)->trace_request_code = (request_code))
+#else
+#define libspdm_trace_begin(spdm_context) 0
+#define libspdm_trace_end(spdm_context, phase, session_id, size, start_time) \
+    ((void)(start_time))
+#define libspdm_trace_set_request_code(spdm_context, request_code)
+#endif
+
+#if LIBSPDM_MESSAGE_CAPTURE_SUPPORT
+/**
+ * This function records a message in the message capture of an SPDM context, if any.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  type                          The record type, LIBSPDM_CAPTURE_RECORD_*.
+ * @param  direction                     The direction, LIBSPDM_CAPTURE_DIRECTION_*.
+ * @param  session_id                    The session ID, or INVALID_SESSION_ID.
+ * @param  message_size                  The size in bytes of the message.
+ * @param  message                       A pointer to the message.
+ **/
+void libspdm_capture_message(libspdm_context_t *spdm_context, uint8_t type, uint8_t direction,
+                             uint32_t session_id, uintn message_size, const void *message);
+#else
+#define libspdm_capture_message(spdm_context, type, direction, session_id, message_size, message)
+#endif
+
 /**
  * This function returns if a given version is supported based upon the GET_VERSION/VERSION.
  *
@@ -535,6 +768,23 @@ libspdm_is_capabilities_flag_supported(const libspdm_context_t *spdm_context,
                                        uint32_t requester_capabilities_flag,
                                        uint32_t responder_capabilities_flag);
 
+/**
+ * This function returns the largest portion of a certificate chain in one CERTIFICATE response.
+ *
+ * The portion is limited by LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN and
+ * LIBSPDM_DATA_CERT_CHAIN_BLOCK_LEN if the certificate chain is received, and by
+ * LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN if it is sent. The whole CERTIFICATE response, including
+ * the headers in front of the portion, must also fit in the DataTransferSize of the receiver.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  is_receiver                   Indicate if the certificate chain is received or sent.
+ * @param  header_size                   size in bytes of the headers in front of the portion.
+ *
+ * @return the largest portion length, at least 1.
+ **/
+uint16_t libspdm_get_cert_chain_block_len(const libspdm_context_t *spdm_context,
+                                          bool is_receiver, uintn header_size);
+
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
 /*
  * This function calculates m1m2.
@@ -623,6 +873,33 @@ bool libspdm_generate_cert_chain_hash(libspdm_context_t *spdm_context,
 bool libspdm_verify_peer_digests(libspdm_context_t *spdm_context,
                                  void *digest, uintn digest_count);
 
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+/**
+ * This function builds the certificate index of the peer used certificate chain buffer.
+ *
+ * It must be called whenever peer_used_cert_chain_buffer is updated after the algorithm negotiation.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ **/
+void libspdm_build_peer_used_cert_chain_index(libspdm_context_t *spdm_context);
+#endif
+
+/**
+ * This function returns the leaf certificate of the peer certificate chain.
+ *
+ * The peer used certificate chain is looked up through its certificate index,
+ * the provisioned peer certificate chain is walked.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  leaf_cert                     The leaf certificate in the peer certificate chain.
+ * @param  leaf_cert_size                size in bytes of the leaf certificate.
+ *
+ * @retval true  The leaf certificate is returned.
+ * @retval false The leaf certificate is not found.
+ **/
+bool libspdm_get_peer_leaf_cert(libspdm_context_t *spdm_context,
+                                uint8_t **leaf_cert, uintn *leaf_cert_size);
+
 /**
  * This function verifies peer certificate chain buffer including spdm_cert_chain_t header.
  *
@@ -643,6 +920,60 @@ bool libspdm_verify_peer_cert_chain_buffer(libspdm_context_t *spdm_context,
                                            uintn *trust_anchor_size,
                                            bool is_requester);
 
+/**
+ * This function starts the verification of a peer certificate chain buffer including
+ * spdm_cert_chain_t header, while it is received.
+ *
+ * The stream runs the checks of libspdm_verify_peer_cert_chain_buffer() as the portions
+ * are appended with libspdm_verify_peer_cert_chain_stream_update(), so the verification
+ * stops at the first invalid certificate.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  stream                        The certificate chain stream.
+ * @param  verify                        If false, the certificates are only split and hashed.
+ * @param  is_requester                  Indicates if it is a requester message.
+ *
+ * @retval true  the stream is initialized.
+ * @retval false the stream initialization fails.
+ **/
+bool libspdm_verify_peer_cert_chain_stream_init(libspdm_context_t *spdm_context,
+                                                libspdm_cert_chain_stream_t *stream,
+                                                bool verify, bool is_requester);
+
+/**
+ * This function appends the next portion of a peer certificate chain buffer to the stream.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  stream                        The certificate chain stream.
+ * @param  data                          The next portion of the certificate chain buffer.
+ * @param  data_size                     size in bytes of the portion.
+ *
+ * @retval true  the portion is appended, and all complete certificates are verified.
+ * @retval false the certificate chain is not trusted.
+ **/
+bool libspdm_verify_peer_cert_chain_stream_update(libspdm_context_t *spdm_context,
+                                                  libspdm_cert_chain_stream_t *stream,
+                                                  const void *data, uintn data_size);
+
+/**
+ * This function completes the verification of a peer certificate chain buffer,
+ * and releases the stream.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  stream                        The certificate chain stream.
+ * @param  cert_chain_hash               The hash of the certificate chain buffer.
+ * @param  trust_anchor                  A buffer to hold the trust_anchor which is used to validate the peer certificate, if not NULL.
+ * @param  trust_anchor_size             A buffer to hold the trust_anchor_size, if not NULL.
+ *
+ * @retval true  Peer certificate chain buffer verification passed.
+ * @retval false Peer certificate chain buffer verification failed.
+ **/
+bool libspdm_verify_peer_cert_chain_stream_final(libspdm_context_t *spdm_context,
+                                                 libspdm_cert_chain_stream_t *stream,
+                                                 uint8_t *cert_chain_hash,
+                                                 void **trust_anchor,
+                                                 uintn *trust_anchor_size);
+
 /**
  * This function generates the challenge signature based upon m1m2 for authentication.
  *
@@ -633,6 +633,58 @@ void libspdm_init_basic_mut_auth_encap_state(libspdm_context_t *spdm_context);
 return_status libspdm_handle_encap_error_response_main(
     libspdm_context_t *spdm_context, uint8_t error_code);
 
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+/**
+ * Collect the device measurements for a GET_MEASUREMENTS request.
+ *
+ * If the device reports a measurement generation, the measurements are served from the
+ * measurement cache, and content_changed reports whether the generation moved since the
+ * first GET_MEASUREMENTS of the L1/L2 transcript. Otherwise the request is passed to
+ * libspdm_measurement_collection().
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_info                  A pointer to the SPDM session context, or NULL.
+ * @param  measurement_index             The index of the measurement to collect.
+ * @param  request_attribute             The request attribute of GET_MEASUREMENTS.
+ * @param  content_changed               The measurement content changed output param.
+ * @param  measurements_count            The number of measurements returned.
+ * @param  measurements                  A pointer to the destination buffer of the measurement blocks.
+ * @param  measurements_size             On input, the size in bytes of the destination buffer.
+ *                                       On output, the size in bytes of the measurement blocks.
+ *
+ * @return the status of libspdm_measurement_collection().
+ **/
+return_status libspdm_responder_collect_measurements(libspdm_context_t *spdm_context,
+                                                     libspdm_session_info_t *session_info,
+                                                     uint8_t measurement_index,
+                                                     uint8_t request_attribute,
+                                                     uint8_t *content_changed,
+                                                     uint8_t *measurements_count,
+                                                     void *measurements,
+                                                     uintn *measurements_size);
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
+
+/**
+ * Generate the measurement summary hash of the negotiated algorithms.
+ *
+ * If the device reports a measurement generation, the summary hash is computed once per
+ * generation, measurement hash algorithm and base hash algorithm, and then served from the
+ * measurement cache. Otherwise it is passed to libspdm_generate_measurement_summary_hash().
+ *
+ * @param  spdm_context                    A pointer to the SPDM context.
+ * @param  measurement_summary_hash_type   The type of the measurement summary hash.
+ * @param  measurement_summary_hash        The buffer to store the measurement summary hash.
+ * @param  measurement_summary_hash_size   The size in bytes of the buffer.
+ *
+ * @retval true  measurement summary hash is generated or skipped.
+ * @retval false measurement summary hash is not generated.
+ **/
+bool libspdm_responder_generate_measurement_summary_hash(
+    libspdm_context_t *spdm_context,
+    uint8_t measurement_summary_hash_type,
+    uint8_t *measurement_summary_hash,
+    uintn *measurement_summary_hash_size);
+
 /**
  * Set session_state to an SPDM secured message context and trigger callback.
  *
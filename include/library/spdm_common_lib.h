@@ -88,6 +88,10 @@ typedef enum {
     LIBSPDM_DATA_LOCAL_SLOT_COUNT,
     LIBSPDM_DATA_PEER_PUBLIC_ROOT_CERT,
     LIBSPDM_DATA_PEER_PUBLIC_CERT_CHAIN,
+    /* Largest portion of the peer certificate chain requested by GET_CERTIFICATE.
+     * 0 (default) requests as much as the local DataTransferSize and
+     * LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN allow.*/
+    LIBSPDM_DATA_CERT_CHAIN_BLOCK_LEN,
     LIBSPDM_DATA_BASIC_MUT_AUTH_REQUESTED,
     LIBSPDM_DATA_MUT_AUTH_REQUESTED,
     LIBSPDM_DATA_HEARTBEAT_PERIOD,
@@ -276,10 +280,41 @@ void libspdm_get_last_spdm_error_struct(void *spdm_context,
 void libspdm_set_last_spdm_error_struct(void *spdm_context,
                                         libspdm_error_struct_t *last_spdm_error);
 
+/* Sizes of the buffers of an SPDM context, chosen at run time.
+ * The compile time LIBSPDM_MAX_* values are the upper bounds.*/
+typedef struct {
+    /* Largest SPDM transport message sent or received, also the local DataTransferSize and
+     * MaxSPDMmsgSize. From SPDM_MIN_DATA_TRANSFER_SIZE_VERSION_12 to
+     * LIBSPDM_MAX_MESSAGE_BUFFER_SIZE.*/
+    uint32_t max_message_size;
+    /* Number of concurrent sessions, at most LIBSPDM_MAX_SESSION_COUNT.*/
+    uint32_t max_session_count;
+    /* Largest requester certificate chain received by the responder in an encapsulated
+     * GET_CERTIFICATE, at most LIBSPDM_MAX_MESSAGE_BUFFER_SIZE.*/
+    uint32_t max_cert_chain_size;
+} libspdm_context_config_t;
+
+/**
+ * Allocate memory for an SPDM context.
+ *
+ * @param  size                          The size in bytes to allocate.
+ *
+ * @return A pointer to the allocated memory, or NULL.
+ **/
+typedef void *(*libspdm_context_allocate_func)(uintn size);
+
+/**
+ * Free memory returned by libspdm_context_allocate_func.
+ *
+ * @param  buffer                        A pointer to the memory to free.
+ **/
+typedef void (*libspdm_context_free_func)(void *buffer);
+
 /**
  * Initialize an SPDM context.
  *
  * The size in bytes of the spdm_context can be returned by libspdm_get_context_size.
+ * The context is laid out with the LIBSPDM_MAX_* sizes, see libspdm_init_context_ex.
  *
  * @param  spdm_context                  A pointer to the SPDM context.
  *
@@ -288,6 +323,53 @@ void libspdm_set_last_spdm_error_struct(void *spdm_context,
  */
 return_status libspdm_init_context(void *context);
 
+/**
+ * Initialize an SPDM context in a caller provided buffer.
+ *
+ * The message, session and certificate chain buffers of the context are laid out in the same
+ * buffer, after the context itself, with the sizes of the configuration.
+ * The size in bytes of the buffer can be returned by libspdm_get_context_size_ex.
+ *
+ * @param  spdm_context                  A pointer to the buffer of the SPDM context.
+ * @param  context_size                  The size in bytes of the buffer.
+ * @param  config                        The configuration of the context.
+ *
+ * @retval RETURN_SUCCESS               context is initialized.
+ * @retval RETURN_INVALID_PARAMETER     The configuration is out of the LIBSPDM_MAX_* bounds.
+ * @retval RETURN_BUFFER_TOO_SMALL      context_size is smaller than libspdm_get_context_size_ex.
+ * @retval RETURN_DEVICE_ERROR          context initialization failed.
+ */
+return_status libspdm_init_context_ex(void *context, uintn context_size,
+                                      const libspdm_context_config_t *config);
+
+/**
+ * Allocate and initialize an SPDM context.
+ *
+ * The context and all its buffers are allocated at once with allocate_func,
+ * see libspdm_init_context_ex. The context is freed with libspdm_free_context.
+ *
+ * @param  config                        The configuration of the context.
+ * @param  allocate_func                 The function to allocate the context.
+ * @param  free_func                     The function to free the context.
+ * @param  spdm_context                  On output, a pointer to the SPDM context.
+ *
+ * @retval RETURN_SUCCESS               context is allocated and initialized.
+ * @retval RETURN_INVALID_PARAMETER     The configuration is out of the LIBSPDM_MAX_* bounds.
+ * @retval RETURN_OUT_OF_RESOURCES      allocate_func failed.
+ * @retval RETURN_DEVICE_ERROR          context initialization failed.
+ */
+return_status libspdm_allocate_context(const libspdm_context_config_t *config,
+                                       libspdm_context_allocate_func allocate_func,
+                                       libspdm_context_free_func free_func,
+                                       void **context);
+
+/**
+ * Zero and free an SPDM context allocated by libspdm_allocate_context.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ */
+void libspdm_free_context(void *context);
+
 /**
  * Reset an SPDM context.
  *
@@ -304,6 +386,16 @@ void libspdm_reset_context(void *context);
  **/
 uintn libspdm_get_context_size(void);
 
+/**
+ * Return the size in bytes of an SPDM context and of its buffers.
+ *
+ * @param  config                        The configuration of the context.
+ *
+ * @return the size in bytes of the SPDM context, or 0 if the configuration is out of the
+ *         LIBSPDM_MAX_* bounds.
+ **/
+uintn libspdm_get_context_size_ex(const libspdm_context_config_t *config);
+
 /**
  * Send an SPDM transport layer message to a device.
  *
@@ -507,6 +599,214 @@ void libspdm_register_verify_spdm_cert_chain_func(
     void *spdm_context,
     const libspdm_verify_spdm_cert_chain_func verify_spdm_cert_chain);
 
+typedef enum {
+    /* The objects allocated from now on belong to the session, or to the request if the
+     * session ID is INVALID_SESSION_ID (0).*/
+    LIBSPDM_MEMORY_SCOPE_ENTER,
+    /* The request is complete. The objects of the request are freed, and no scope is current.*/
+    LIBSPDM_MEMORY_SCOPE_LEAVE,
+    /* The session is freed. All the objects of the session are freed.*/
+    LIBSPDM_MEMORY_SCOPE_RELEASE,
+} libspdm_memory_scope_event_t;
+
+/**
+ * Notify the integrator of the lifetime of the objects allocated by the crypto backend.
+ *
+ * The responder enters the scope of a request before it builds the response, enters the scope
+ * of a new session once KEY_EXCHANGE or PSK_EXCHANGE assigned it, and leaves the scope once the
+ * response is built. Both the requester and the responder release the scope of a session in
+ * libspdm_free_session_id. An integrator may select an arena allocator per scope, and release
+ * it in one shot.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_id                    The session ID of the scope, or INVALID_SESSION_ID (0).
+ * @param  event                         The memory scope event.
+ **/
+typedef void (*libspdm_memory_scope_func)(void *spdm_context, uint32_t session_id,
+                                          libspdm_memory_scope_event_t event);
+
+/**
+ * Register the memory scope function of an SPDM context.
+ *
+ * This function must be called after libspdm_init_context, and before any SPDM communication.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  memory_scope                  The function to be called on memory scope events.
+ **/
+void libspdm_register_memory_scope_func(void *spdm_context,
+                                        libspdm_memory_scope_func memory_scope);
+
+typedef enum {
+    /* The transport layer encodes a message.*/
+    LIBSPDM_TRACE_PHASE_ENCODE,
+    /* The device IO sends a message.*/
+    LIBSPDM_TRACE_PHASE_SEND,
+    /* The device IO waits for and receives a response.*/
+    LIBSPDM_TRACE_PHASE_WAIT,
+    /* The transport layer decodes a message.*/
+    LIBSPDM_TRACE_PHASE_DECODE,
+    /* The responder builds the response of a request.*/
+    LIBSPDM_TRACE_PHASE_PROCESS,
+    /* A signature is generated.*/
+    LIBSPDM_TRACE_PHASE_SIGN,
+    /* A signature is verified.*/
+    LIBSPDM_TRACE_PHASE_VERIFY,
+    /* A transcript hash (TH1 or TH2) is calculated.*/
+    LIBSPDM_TRACE_PHASE_HASH,
+    /* The handshake or the data keys of a session are derived.*/
+    LIBSPDM_TRACE_PHASE_KEY_DERIVATION,
+    LIBSPDM_TRACE_PHASE_MAX,
+} libspdm_trace_phase_t;
+
+typedef struct {
+    libspdm_trace_phase_t phase;
+    /* The request code of the request the phase belongs to, or 0 for an APP message.*/
+    uint8_t request_code;
+    /* The session ID, or INVALID_SESSION_ID (0) if the phase is not in a session.*/
+    uint32_t session_id;
+    /* The size in bytes of the message for the ENCODE, SEND, WAIT, DECODE and PROCESS phases,
+     * else 0.*/
+    uintn size;
+    /* The time stamps of the phase, from the registered libspdm_trace_get_time_func.*/
+    uint64_t start_time;
+    uint64_t end_time;
+} libspdm_trace_event_t;
+
+/**
+ * Receive a trace event of an SPDM context.
+ *
+ * The function is called at the end of every phase, from the thread of the SPDM context.
+ * It should be quick, for example record the event in a preallocated buffer.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  event                         The trace event.
+ **/
+typedef void (*libspdm_trace_func)(void *spdm_context, const libspdm_trace_event_t *event);
+
+/**
+ * Return a monotonic time stamp for the trace events, such as libspdm_get_time_ns.
+ *
+ * @return the time stamp, in an integrator defined unit.
+ **/
+typedef uint64_t (*libspdm_trace_get_time_func)(void);
+
+/**
+ * Register the trace functions of an SPDM context.
+ *
+ * Without a trace function, a trace point costs one check. If LIBSPDM_TRACE_SUPPORT is 0,
+ * the trace points are compiled out and this function does nothing.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  trace                         The function to be called on trace events, or NULL.
+ * @param  get_time                      The function to get the time stamps of the events.
+ **/
+void libspdm_register_trace_func(void *spdm_context, libspdm_trace_func trace,
+                                 libspdm_trace_get_time_func get_time);
+
+/* The signature of a message capture, "SPDC".*/
+#define LIBSPDM_CAPTURE_SIGNATURE 0x43445053
+#define LIBSPDM_CAPTURE_VERSION 1
+
+/* The messages recorded by a message capture.*/
+/* The SPDM and APP messages, in plain text.*/
+#define LIBSPDM_CAPTURE_FLAG_MESSAGE BIT0
+/* The transport messages, as sent and received by the device IO.*/
+#define LIBSPDM_CAPTURE_FLAG_WIRE BIT1
+
+/* The type of a capture record.*/
+/* Fills the end of the record area, the next record is at offset 0.*/
+#define LIBSPDM_CAPTURE_RECORD_PAD 0
+#define LIBSPDM_CAPTURE_RECORD_SPDM 1
+#define LIBSPDM_CAPTURE_RECORD_APP 2
+#define LIBSPDM_CAPTURE_RECORD_WIRE 3
+
+/* The direction of a captured message, from the view of the capturing context.*/
+#define LIBSPDM_CAPTURE_DIRECTION_SEND 0
+#define LIBSPDM_CAPTURE_DIRECTION_RECEIVE 1
+
+#pragma pack(1)
+/*
+ * A message capture is a ring of records, in a buffer provided by the integrator.
+ * The buffer starts with a libspdm_capture_header_t, followed by the record area.
+ *
+ * Every record starts with a libspdm_capture_record_t followed by the message, and is padded
+ * to a multiple of 8 bytes. A record never wraps around the end of the record area: if the end
+ * cannot hold a record header, the next record is at offset 0, else a PAD record fills it.
+ * The oldest records are overwritten when the ring is full. The buffer can be copied or saved
+ * as is between two SPDM calls of the context, and rendered by spdm_capture_decode.
+ *
+ * tail, head, record_count and sequence are plain fields, written without barriers while a
+ * record is added. There is no protocol for a concurrent reader: a copy taken from another
+ * thread during an SPDM call of the context may be torn. The only reader is the integrator,
+ * between two SPDM calls or synchronized with the thread of the context.
+ */
+typedef struct {
+    uint32_t signature;
+    uint16_t version;
+    uint8_t flags;
+    uint8_t reserved;
+    /* The size in bytes of the record area.*/
+    uint32_t data_size;
+    /* The offset in the record area of the oldest record and of the next record.*/
+    uint32_t tail;
+    uint32_t head;
+    /* The number of records in the ring, including the PAD records.*/
+    uint32_t record_count;
+    /* The sequence number of the next record.*/
+    uint64_t sequence;
+} libspdm_capture_header_t;
+
+typedef struct {
+    /* The size in bytes of the record, including this header and the padding.*/
+    uint32_t record_size;
+    uint8_t type;
+    uint8_t direction;
+    uint16_t reserved;
+    /* The session ID, or INVALID_SESSION_ID (0) if the message is not in a session.*/
+    uint32_t session_id;
+    /* The size in bytes of the message. The record holds less if the message was truncated.*/
+    uint32_t message_size;
+    uint64_t sequence;
+    /* The time stamp from the registered libspdm_trace_get_time_func, or 0.*/
+    uint64_t time_stamp;
+} libspdm_capture_record_t;
+#pragma pack()
+
+/**
+ * Start the capture of the messages of an SPDM context.
+ *
+ * The messages are recorded in binary in a ring buffer, without formatting, so the capture can
+ * stay enabled in release builds. The capture is written from the thread of the SPDM context,
+ * without lock, and never blocks or fails an SPDM call: the oldest records are overwritten and
+ * a message larger than the record area is truncated. The buffer must not be read while an SPDM
+ * call of the context is in progress, see libspdm_capture_header_t.
+ * If LIBSPDM_MESSAGE_CAPTURE_SUPPORT is 0, the capture points are compiled out.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  buffer                        The capture buffer. It must stay valid until
+ *                                       libspdm_stop_message_capture is called.
+ * @param  buffer_size                   The size in bytes of the capture buffer.
+ * @param  flags                         The messages to capture, LIBSPDM_CAPTURE_FLAG_*.
+ * @param  get_time                      The function to get the time stamps of the records,
+ *                                       or NULL.
+ *
+ * @retval RETURN_SUCCESS               The capture is started.
+ * @retval RETURN_INVALID_PARAMETER     The buffer is too small for a record, or flags is 0.
+ * @retval RETURN_UNSUPPORTED           LIBSPDM_MESSAGE_CAPTURE_SUPPORT is 0.
+ **/
+return_status libspdm_start_message_capture(void *spdm_context, void *buffer,
+                                            uintn buffer_size, uint8_t flags,
+                                            libspdm_trace_get_time_func get_time);
+
+/**
+ * Stop the capture of the messages of an SPDM context.
+ *
+ * The capture buffer keeps the records, and can be reused by the integrator.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ **/
+void libspdm_stop_message_capture(void *spdm_context);
+
 /**
  * Reset message A cache in SPDM context.
  *
@@ -26,6 +26,46 @@
 #define LIBSPDM_MAX_AEAD_IV_SIZE 12
 #define LIBSPDM_MAX_AEAD_TAG_SIZE 16
 
+/* Offset and size of every certificate in one certificate chain, built in a single pass.*/
+typedef struct {
+    uint32_t cert_count;
+    uint32_t cert_offset[LIBSPDM_MAX_CERT_CHAIN_DEPTH];
+    uint32_t cert_size[LIBSPDM_MAX_CERT_CHAIN_DEPTH];
+} libspdm_cert_chain_index_t;
+
+/* Certificate chain buffer, including spdm_cert_chain_t header, that is verified while it is
+ * received, see libspdm_cert_chain_stream_init().
+ * Only the last complete certificate and the certificate being received are kept.*/
+typedef struct {
+    uint32_t base_hash_algo;
+    uint32_t base_asym_algo;
+    bool is_device_cert_model;
+    bool verify;
+    /* the first certificate must be, or be signed by, the trust anchor if it is not NULL*/
+    const uint8_t *trust_anchor;
+    uintn trust_anchor_size;
+    /* spdm_cert_chain_t header and root hash*/
+    uint8_t header[sizeof(spdm_cert_chain_t) + LIBSPDM_MAX_HASH_SIZE];
+    uintn header_size;
+    uintn received_size;
+    uint32_t cert_count;
+    /* the last complete certificate is in cert[issuer_slot], the next one in the other slot*/
+    uint8_t issuer_slot;
+    uintn issuer_size;
+    /* 0 until the DER header of the next certificate is received*/
+    uintn cert_size;
+    uintn pending_size;
+    uint8_t cert[2][LIBSPDM_MAX_CERT_SIZE];
+    libspdm_hash_state_t hash_state;
+} libspdm_cert_chain_stream_t;
+
+/* HMAC state built on two keyed hash states, see libspdm_hmac_state_init().*/
+typedef struct {
+    uint32_t base_hash_algo;
+    libspdm_hash_state_t inner;
+    libspdm_hash_state_t outer;
+} libspdm_hmac_state_t;
+
 /**
  * Allocates and initializes one HASH_CTX context for subsequent hash use.
  *
@@ -705,6 +745,110 @@ bool libspdm_hmac_all(uint32_t base_hash_algo, const void *data,
                       uintn data_size, const uint8_t *key,
                       uintn key_size, uint8_t *hmac_value);
 
+/**
+ * Initializes a fixed-size hash state, based upon the negotiated hash algorithm.
+ *
+ * Unlike libspdm_hash_new(), the state needs no allocation for the hash algorithms whose
+ * digest state is embedded in libspdm_hash_state_t. It must be released with
+ * libspdm_hash_state_free() unless it is finalized.
+ *
+ * @param  base_hash_algo                 SPDM base_hash_algo
+ * @param  state                          Pointer to the hash state being initialized.
+ *
+ * @retval true   Hash state initialization succeeded.
+ * @retval false  Hash state initialization failed.
+ **/
+bool libspdm_hash_state_init(uint32_t base_hash_algo, libspdm_hash_state_t *state);
+
+/**
+ * Computes the hash digest value of a copy of the hash state.
+ *
+ * The hash state is left unchanged, so more data can be appended to it.
+ *
+ * @param  state                          Pointer to the hash state.
+ * @param  hash_value                     Pointer to a buffer that receives the hash value.
+ *
+ * @retval true   Hash computation succeeded.
+ * @retval false  Hash computation failed.
+ **/
+bool libspdm_hash_state_final_copy(const libspdm_hash_state_t *state, uint8_t *hash_value);
+
+/**
+ * Initializes a fixed-size HMAC state with the key, based upon the negotiated HMAC algorithm.
+ *
+ * The HMAC is computed on top of two hash states, so the HMAC state needs no allocation
+ * when the hash states need none. It must be released with libspdm_hmac_state_free()
+ * unless it is finalized.
+ *
+ * @param  base_hash_algo                 SPDM base_hash_algo
+ * @param  state                          Pointer to the HMAC state being initialized.
+ * @param  key                            Pointer to the user-supplied key.
+ * @param  key_size                       key size in bytes.
+ *
+ * @retval true   HMAC state initialization succeeded.
+ * @retval false  HMAC state initialization failed.
+ **/
+bool libspdm_hmac_state_init(uint32_t base_hash_algo, libspdm_hmac_state_t *state,
+                             const uint8_t *key, uintn key_size);
+
+/**
+ * Makes a copy of an existing HMAC state.
+ *
+ * @param  state                          Pointer to the HMAC state being copied.
+ * @param  new_state                      Pointer to the new HMAC state.
+ *
+ * @retval true   HMAC state copy succeeded.
+ * @retval false  HMAC state copy failed.
+ **/
+bool libspdm_hmac_state_duplicate(const libspdm_hmac_state_t *state,
+                                  libspdm_hmac_state_t *new_state);
+
+/**
+ * Digests the input data and updates the HMAC state.
+ *
+ * @param  state                          Pointer to the HMAC state.
+ * @param  data                           Pointer to the buffer containing the data to be HMACed.
+ * @param  data_size                      size of data buffer in bytes.
+ *
+ * @retval true   HMAC data digest succeeded.
+ * @retval false  HMAC data digest failed.
+ **/
+bool libspdm_hmac_state_update(libspdm_hmac_state_t *state, const void *data,
+                               uintn data_size);
+
+/**
+ * Completes computation of the HMAC value and releases the HMAC state.
+ *
+ * @param  state                          Pointer to the HMAC state.
+ * @param  hmac_value                     Pointer to a buffer that receives the HMAC value.
+ *
+ * @retval true   HMAC computation succeeded.
+ * @retval false  HMAC computation failed.
+ **/
+bool libspdm_hmac_state_final(libspdm_hmac_state_t *state, uint8_t *hmac_value);
+
+/**
+ * Computes the HMAC value of a copy of the HMAC state.
+ *
+ * The HMAC state is left unchanged, so more data can be appended to it.
+ *
+ * @param  state                          Pointer to the HMAC state.
+ * @param  hmac_value                     Pointer to a buffer that receives the HMAC value.
+ *
+ * @retval true   HMAC computation succeeded.
+ * @retval false  HMAC computation failed.
+ **/
+bool libspdm_hmac_state_final_copy(const libspdm_hmac_state_t *state, uint8_t *hmac_value);
+
+/**
+ * Releases an HMAC state. The state is zeroed.
+ *
+ * It is safe to release a state that is zeroed, already released or finalized.
+ *
+ * @param  state                          Pointer to the HMAC state.
+ **/
+void libspdm_hmac_state_free(libspdm_hmac_state_t *state);
+
 /**
  * Derive HMAC-based Expand key Derivation Function (HKDF) Expand, based upon the negotiated HKDF algorithm.
  *
@@ -723,6 +867,26 @@ bool libspdm_hkdf_expand(uint32_t base_hash_algo, const uint8_t *prk,
                          uintn prk_size, const uint8_t *info,
                          uintn info_size, uint8_t *out, uintn out_size);
 
+/**
+ * Derive HMAC-based Expand key Derivation Function (HKDF) Expand from a pre-keyed PRK state.
+ *
+ * The PRK state is an HMAC state initialized by libspdm_hmac_state_init() with the PRK
+ * as key. It is left unchanged, so all labels derived from one secret share the HMAC
+ * key setup.
+ *
+ * @param  prk_state                    Pointer to the HMAC state keyed with the PRK.
+ * @param  info                         Pointer to the application specific info.
+ * @param  info_size                     info size in bytes.
+ * @param  out                          Pointer to buffer to receive hkdf value.
+ * @param  out_size                      size of hkdf bytes to generate.
+ *
+ * @retval true   Hkdf generated successfully.
+ * @retval false  Hkdf generation failed.
+ **/
+bool libspdm_hkdf_expand_with_state(const libspdm_hmac_state_t *prk_state,
+                                    const uint8_t *info, uintn info_size,
+                                    uint8_t *out, uintn out_size);
+
 /**
  * This function returns the SPDM asymmetric algorithm size.
  *
@@ -1294,6 +1458,39 @@ libspdm_get_dmtf_subject_alt_name(const uint8_t *cert, const intn cert_size,
                                   uintn *name_buffer_size,
                                   uint8_t *oid, uintn *oid_size);
 
+/**
+ * Build the certificate index of one certificate chain data, walking the chain only once.
+ *
+ * If the chain holds no certificate or more than LIBSPDM_MAX_CERT_CHAIN_DEPTH certificates,
+ * the index is left empty and libspdm_get_cert_from_cert_chain_index() walks the chain instead.
+ *
+ * @param  cert_chain_data          The certificate chain data without spdm_cert_chain_t header.
+ * @param  cert_chain_data_size     size in bytes of the certificate chain data.
+ * @param  cert_chain_index         The certificate index to build.
+ **/
+void libspdm_build_cert_chain_index(const uint8_t *cert_chain_data, uintn cert_chain_data_size,
+                                    libspdm_cert_chain_index_t *cert_chain_index);
+
+/**
+ * Get one certificate from the certificate chain data, using its certificate index.
+ *
+ * @param  cert_chain_index         The certificate index built from cert_chain_data.
+ * @param  cert_chain_data          The certificate chain data without spdm_cert_chain_t header.
+ * @param  cert_chain_data_size     size in bytes of the certificate chain data.
+ * @param  cert_index               index of certificate. If index is -1 indicates the
+ *                                  last certificate in cert_chain_data.
+ * @param  cert                     The certificate at the index of cert_chain_data.
+ * @param  cert_length              The length of the certificate in bytes.
+ *
+ * @retval  true   Success.
+ * @retval  false  Failed to get certificate from certificate chain.
+ **/
+bool libspdm_get_cert_from_cert_chain_index(const libspdm_cert_chain_index_t *cert_chain_index,
+                                            uint8_t *cert_chain_data,
+                                            uintn cert_chain_data_size,
+                                            int32_t cert_index, uint8_t **cert,
+                                            uintn *cert_length);
+
 /**
  * This function verifies the integrity of certificate chain data without spdm_cert_chain_t header.
  *
@@ -1329,6 +1526,80 @@ bool libspdm_verify_certificate_chain_buffer(uint32_t base_hash_algo, uint32_t b
                                              uintn cert_chain_buffer_size,
                                              bool is_device_cert_model);
 
+/**
+ * This function starts the verification of a certificate chain buffer including
+ * spdm_cert_chain_t header, which is then appended portion by portion with
+ * libspdm_cert_chain_stream_update().
+ *
+ * It runs the checks of libspdm_verify_certificate_chain_buffer(), but each certificate is
+ * verified as soon as it is received, so the size of the chain is not limited by a buffer.
+ * Each certificate must not be larger than LIBSPDM_MAX_CERT_SIZE.
+ *
+ * The stream must be released with libspdm_cert_chain_stream_free() unless
+ * libspdm_cert_chain_stream_final() is called.
+ *
+ * @param  stream                         The certificate chain stream.
+ * @param  base_hash_algo                 SPDM base_hash_algo
+ * @param  base_asym_algo                 SPDM base_asym_algo
+ * @param  is_device_cert_model           If true, the cert chain is DeviceCert model;
+ *                                        If false, the cert chain is AliasCert model;
+ * @param  verify                         If false, the certificates are only split and hashed.
+ *
+ * @retval true  the stream is initialized.
+ * @retval false the stream initialization fails.
+ **/
+bool libspdm_cert_chain_stream_init(libspdm_cert_chain_stream_t *stream,
+                                    uint32_t base_hash_algo, uint32_t base_asym_algo,
+                                    bool is_device_cert_model, bool verify);
+
+/**
+ * This function appends the next portion of the certificate chain buffer to the stream,
+ * and verifies every certificate it completes.
+ *
+ * @param  stream                         The certificate chain stream.
+ * @param  data                           The next portion of the certificate chain buffer.
+ * @param  data_size                      size in bytes of the portion.
+ *
+ * @retval true  the portion is appended, and all complete certificates are verified.
+ * @retval false a certificate is invalid, the stream must not be appended any more.
+ **/
+bool libspdm_cert_chain_stream_update(libspdm_cert_chain_stream_t *stream,
+                                      const void *data, uintn data_size);
+
+/**
+ * This function completes the verification of the certificate chain buffer,
+ * and releases the stream.
+ *
+ * @param  stream                         The certificate chain stream.
+ * @param  cert_chain_hash                The hash of the certificate chain buffer.
+ *
+ * @retval true  certificate chain buffer integrity verification pass.
+ * @retval false certificate chain buffer integrity verification fail.
+ **/
+bool libspdm_cert_chain_stream_final(libspdm_cert_chain_stream_t *stream,
+                                     uint8_t *cert_chain_hash);
+
+/**
+ * This function returns the last complete certificate of the stream, which is the leaf
+ * certificate once libspdm_cert_chain_stream_final() succeeds.
+ *
+ * @param  stream                         The certificate chain stream.
+ * @param  cert                           The last complete certificate.
+ * @param  cert_size                      size in bytes of the certificate.
+ *
+ * @retval true  the certificate is returned.
+ * @retval false no certificate is complete.
+ **/
+bool libspdm_cert_chain_stream_get_leaf_cert(const libspdm_cert_chain_stream_t *stream,
+                                             const uint8_t **cert, uintn *cert_size);
+
+/**
+ * This function releases the stream without completing the verification.
+ *
+ * @param  stream                         The certificate chain stream.
+ **/
+void libspdm_cert_chain_stream_free(libspdm_cert_chain_stream_t *stream);
+
 /**
  * Retrieve the asymmetric public key from one DER-encoded X509 certificate,
  * based upon negotiated asymmetric or requester asymmetric algorithm.
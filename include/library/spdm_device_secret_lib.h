@@ -91,6 +91,21 @@ return_status libspdm_measurement_collection(
     void *measurements,
     uintn *measurements_size);
 
+/**
+ * Return the generation of the device measurements.
+ *
+ * The device increments the generation whenever the content of any measurement block
+ * changes, and never returns 0 once it tracks changes. The responder then collects the
+ * measurements and the measurement summary hashes once per generation and serves
+ * GET_MEASUREMENTS, CHALLENGE, KEY_EXCHANGE and PSK_EXCHANGE from its cache. A signed
+ * MEASUREMENTS response reports a detected change if the generation moved since the
+ * first GET_MEASUREMENTS of the L1/L2 transcript.
+ *
+ * @return The measurement generation. 0 if the device does not track measurement changes,
+ *         the measurements are then collected for every request.
+ **/
+uint32_t libspdm_measurement_get_generation(void);
+
 /**
  * This function calculates the measurement summary hash.
  *
@@ -35,9 +35,26 @@
 #ifndef LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE
 #define LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE 0x1000
 #endif
+/* Largest portion of the local certificate chain sent in one CERTIFICATE response.*/
 #ifndef LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN
 #define LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN 1024
 #endif
+/* Largest portion of a peer certificate chain requested by one GET_CERTIFICATE.
+ * It must leave room for the SPDM, secured message and transport headers in
+ * LIBSPDM_MAX_MESSAGE_BUFFER_SIZE. See libspdm_get_cert_chain_block_len().*/
+#ifndef LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN
+#define LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN 0x1000
+#endif
+/* Chains with more certificates are still accepted, but lookups walk the chain.*/
+#ifndef LIBSPDM_MAX_CERT_CHAIN_DEPTH
+#define LIBSPDM_MAX_CERT_CHAIN_DEPTH 16
+#endif
+/* Largest certificate of a peer certificate chain that is verified while it is received.
+ * The default leaves room for RSA 4096 certificates with large extensions. The context keeps
+ * two certificates, so it may be lowered to the largest certificate the peers use.*/
+#ifndef LIBSPDM_MAX_CERT_SIZE
+#define LIBSPDM_MAX_CERT_SIZE LIBSPDM_MAX_CERT_CHAIN_SIZE
+#endif
 
 #ifndef LIBSPDM_MAX_MESSAGE_BUFFER_SIZE
 #define LIBSPDM_MAX_MESSAGE_BUFFER_SIZE 0x1200
@@ -64,6 +81,32 @@
 #define LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT 0
 #endif
 
+/* If the responder caches the measurement record and the measurement summary hashes of
+ * one measurement generation, see libspdm_measurement_get_generation().
+ * It adds LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE bytes and two summary hashes to the context.*/
+#ifndef LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+#define LIBSPDM_MEASUREMENT_CACHE_SUPPORT 0
+#endif
+
+/* If the requester caches the last measurement record of the peer per connection,
+ * see libspdm_refresh_measurement_cache().
+ * It adds LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE bytes and the block offsets to the context.*/
+#ifndef LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT
+#define LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT 0
+#endif
+
+/* If the requester and the responder emit trace events, see libspdm_register_trace_func().
+ * When it is 0, the trace points are compiled out.*/
+#ifndef LIBSPDM_TRACE_SUPPORT
+#define LIBSPDM_TRACE_SUPPORT 1
+#endif
+
+/* If the requester and the responder can capture their messages in a ring buffer,
+ * see libspdm_start_message_capture(). When it is 0, the capture points are compiled out.*/
+#ifndef LIBSPDM_MESSAGE_CAPTURE_SUPPORT
+#define LIBSPDM_MESSAGE_CAPTURE_SUPPORT 1
+#endif
+
 
 /* Crypto Configuation
  * In each category, at least one should be selected.
@@ -151,7 +151,8 @@ return_status libspdm_get_certificate_ex(void *context, uint8_t slot_id,
  *
  * @param  spdm_context                  A pointer to the SPDM context.
  * @param  slot_id                      The number of slot for the certificate chain.
- * @param  length                       LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN.
+ * @param  length                       length parameter in the get_certificate message, limited by
+ *                                     LIBSPDM_DATA_CERT_CHAIN_BLOCK_LEN and the local DataTransferSize.
  * @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
  *                                     On output, indicate the size in bytes of the certificate chain.
  * @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
@@ -178,7 +179,8 @@ return_status libspdm_get_certificate_choose_length(void *spdm_context,
  *
  * @param  spdm_context                  A pointer to the SPDM context.
  * @param  slot_id                      The number of slot for the certificate chain.
- * @param  length                       LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN.
+ * @param  length                       length parameter in the get_certificate message, limited by
+ *                                     LIBSPDM_DATA_CERT_CHAIN_BLOCK_LEN and the local DataTransferSize.
  * @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
  *                                     On output, indicate the size in bytes of the certificate chain.
  * @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
@@ -321,6 +323,215 @@ return_status libspdm_get_measurement_ex(void *context, const uint32_t *session_
                                          void *requester_nonce,
                                          void *responder_nonce);
 
+/* One measurement block of a measurement record, pointing into the record.*/
+typedef struct {
+    uint8_t index;
+    uint8_t measurement_specification;
+    uint16_t measurement_size;
+    const void *measurement;
+} libspdm_measurement_table_entry_t;
+
+/* The measurement blocks of a measurement record, in record order.*/
+typedef struct {
+    uint8_t number_of_blocks;
+    libspdm_measurement_table_entry_t entry[LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT];
+} libspdm_measurement_table_t;
+
+/**
+ * This function parses a measurement record into a measurement table.
+ *
+ * The measurement is not copied, every table entry points into the measurement record,
+ * so the record must stay valid as long as the table is used.
+ *
+ * @param  measurement_record_length      The size in bytes of the measurement record.
+ * @param  measurement_record            A pointer to the measurement record.
+ * @param  measurement_table             The measurement table to fill.
+ *
+ * @retval true   The measurement record is parsed successfully.
+ * @retval false  The measurement record is malformed, or it holds more than
+ *                LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT blocks.
+ **/
+bool libspdm_parse_measurement_record(uint32_t measurement_record_length,
+                                      const void *measurement_record,
+                                      libspdm_measurement_table_t *measurement_table);
+
+/**
+ * This function returns the measurement table entry of a measurement index.
+ *
+ * @param  measurement_table             The measurement table.
+ * @param  index                        The measurement index.
+ *
+ * @return The measurement table entry, or NULL if the table has no block of this index.
+ **/
+const libspdm_measurement_table_entry_t *libspdm_get_measurement_table_entry(
+    const libspdm_measurement_table_t *measurement_table, uint8_t index);
+
+/**
+ * This function gets all measurements of the device with a single signature.
+ *
+ * It sends one unsigned GET_MEASUREMENTS for all measurements, then, if the device supports
+ * signed measurements, one signed GET_MEASUREMENTS for the last measurement index, in the same
+ * L1/L2 transcript. The signature of the second response covers both responses, so the whole
+ * measurement set is verified once, in two round trips.
+ *
+ * The measurement indices need not be contiguous. If the device rejects the signed request
+ * with ERROR(InvalidRequest), the previous index is signed instead, down to the first index.
+ * A rejected request is in the L1/L2 of neither side. Any other failure ends the sweep.
+ * The block of the signed response must be the same as in the measurement record, otherwise
+ * the measurements changed between the two responses and the sweep fails with
+ * RETURN_DEVICE_ERROR, so that it can be retried.
+ *
+ * The measurement record buffer receives the block of the signed response after the
+ * measurement record, so it needs room for one more block than the measurement record.
+ * The measurement table points into the measurement record.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+ *                                     If session_id is NULL, it is a normal message.
+ *                                     If session_id is NOT NULL, it is a secured message.
+ * @param  slot_id                      The number of slot for the certificate chain.
+ * @param  content_changed               The measurement content changed output param of the signed response.
+ * @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+ *                                     On output, indicate the size in bytes of the measurement record.
+ * @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+ * @param  measurement_table             The measurement table of the measurement record, on output.
+ *
+ * @retval RETURN_SUCCESS               The measurements are got successfully.
+ * @retval RETURN_BUFFER_TOO_SMALL      The measurement record buffer is too small.
+ * @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+ * @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+ **/
+return_status libspdm_get_measurement_sweep(void *context, const uint32_t *session_id,
+                                            uint8_t slot_id,
+                                            uint8_t *content_changed,
+                                            uint32_t *measurement_record_length,
+                                            void *measurement_record,
+                                            libspdm_measurement_table_t *measurement_table);
+
+/**
+ * This function refreshes the measurement cache of the connection with all measurements
+ * of the device.
+ *
+ * It sends one GET_MEASUREMENTS of all measurements, signed if the device supports signed
+ * measurements, and compares every measurement block with the cached one. The cache is
+ * rewritten, and its generation incremented, only if a block changed, appeared or disappeared.
+ * The unchanged blocks keep the generation in which they last changed.
+ *
+ * The cache is dropped when the connection is reset, and when any signed MEASUREMENTS
+ * response of SPDM 1.2 reports that the measurements changed within its L1/L2.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+ *                                     If session_id is NULL, it is a normal message.
+ *                                     If session_id is NOT NULL, it is a secured message.
+ * @param  slot_id                      The number of slot for the certificate chain.
+ * @param  generation                    The generation of the measurement cache.
+ *
+ * @retval RETURN_SUCCESS               The measurement cache is refreshed successfully.
+ * @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+ * @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+ **/
+return_status libspdm_refresh_measurement_cache(void *context, const uint32_t *session_id,
+                                                uint8_t slot_id, uint32_t *generation);
+
+/**
+ * This function returns the measurement indices whose cached measurement block changed
+ * after a generation of the measurement cache.
+ *
+ * If the changes since this generation are not known, for example because a block
+ * disappeared or the cache was dropped since, all cached indices are returned.
+ * A generation of 0 returns all cached indices.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  generation                    The generation returned by a previous refresh, or 0.
+ * @param  index_count                   On input, the number of entries of the index list.
+ *                                     On output, the number of changed measurement indices.
+ * @param  index_list                    The changed measurement indices, in record order.
+ *
+ * @retval RETURN_SUCCESS               The changed measurement indices are returned.
+ * @retval RETURN_NOT_FOUND             The measurement cache is empty.
+ * @retval RETURN_BUFFER_TOO_SMALL      The index list is too small, index_count is updated.
+ **/
+return_status libspdm_get_cached_measurement_changes(void *context, uint32_t generation,
+                                                     uint8_t *index_count,
+                                                     uint8_t *index_list);
+
+/**
+ * This function copies one cached measurement block, with its common header.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  index                        The measurement index.
+ * @param  block_generation              The generation in which the block last changed, if not NULL.
+ * @param  measurement_block_length       On input, the size in bytes of the destination buffer.
+ *                                     On output, the size in bytes of the measurement block.
+ * @param  measurement_block             A pointer to a destination buffer to store the measurement block.
+ *
+ * @retval RETURN_SUCCESS               The measurement block is copied.
+ * @retval RETURN_NOT_FOUND             No measurement block of this index is cached.
+ * @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small, measurement_block_length is updated.
+ **/
+return_status libspdm_get_cached_measurement(void *context, uint8_t index,
+                                             uint32_t *block_generation,
+                                             uint32_t *measurement_block_length,
+                                             void *measurement_block);
+
+/* The steps of libspdm_attest(), in protocol order.*/
+#define LIBSPDM_ATTEST_STEP_INIT_CONNECTION 0
+#define LIBSPDM_ATTEST_STEP_GET_DIGESTS 1
+#define LIBSPDM_ATTEST_STEP_GET_CERTIFICATE 2
+#define LIBSPDM_ATTEST_STEP_CHALLENGE 3
+#define LIBSPDM_ATTEST_STEP_GET_MEASUREMENTS 4
+#define LIBSPDM_ATTEST_STEP_COUNT 5
+
+/* The evidence of one attestation of the device.*/
+typedef struct {
+    /* bit (1 << LIBSPDM_ATTEST_STEP_*) is set if the step was sent*/
+    uint8_t step_mask;
+    /* the time of every step sent, in nanoseconds, of all its attempts*/
+    uint64_t step_time_ns[LIBSPDM_ATTEST_STEP_COUNT];
+    uint8_t slot_id;
+    /* true if a signature of the device was verified, over CHALLENGE_AUTH or MEASUREMENTS*/
+    bool authenticated;
+    /* the digest of the certificate chain of the slot, or 0 size without certificates*/
+    uint32_t cert_chain_hash_size;
+    uint8_t cert_chain_hash[LIBSPDM_MAX_HASH_SIZE];
+    /* the measurement content changed field of the MEASUREMENTS response*/
+    uint8_t content_changed;
+    uint8_t number_of_blocks;
+} libspdm_attest_evidence_t;
+
+/**
+ * This function attests the device with the fewest requests and signatures the negotiated
+ * capabilities allow.
+ *
+ * - VCA is skipped if the connection is already negotiated.
+ * - GET_DIGESTS is skipped past NEGOTIATED, the certificate chain of this connection is known.
+ * - GET_CERTIFICATE is skipped if the certificate chain verified before is of the slot, and
+ *   it matches the digest of the slot, even in a previous connection. Past NEGOTIATED, the
+ *   certificate chain of another slot is requested again.
+ * - CHALLENGE is skipped if the measurements are requested and the device signs them,
+ *   because the signed MEASUREMENTS response authenticates the device on its own.
+ *   CHALLENGE is only sent if the device rejects GET_MEASUREMENTS with an ERROR before it.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  slot_id                      The number of slot for the certificate chain.
+ * @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+ *                                     On output, indicate the size in bytes of the measurement record.
+ *                                     NULL if no measurements are requested.
+ * @param  measurement_record            A pointer to a destination buffer to store all measurement blocks.
+ *                                     NULL if no measurements are requested.
+ * @param  evidence                      The evidence of the attestation.
+ *
+ * @retval RETURN_SUCCESS               The device is attested, evidence->authenticated tells if
+ *                                     a signature was verified.
+ * @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+ * @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+ **/
+return_status libspdm_attest(void *spdm_context, uint8_t slot_id,
+                             uint32_t *measurement_record_length,
+                             void *measurement_record,
+                             libspdm_attest_evidence_t *evidence);
+
 /**
  * This function sends KEY_EXCHANGE/FINISH or PSK_EXCHANGE/PSK_FINISH
  * to start an SPDM Session.
@@ -323,6 +323,18 @@ void libspdm_hmac_free_with_request_finished_key(
 bool libspdm_hmac_init_with_request_finished_key(
     void *spdm_secured_message_context, void *hmac_ctx);
 
+/**
+ * Initializes a fixed-size HMAC state with request_finished_key.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  hmac_state                      Pointer to the HMAC state being initialized.
+ *
+ * @retval true   The key is set successfully.
+ * @retval false  The key is set unsuccessfully.
+ **/
+bool libspdm_hmac_state_init_with_request_finished_key(
+    void *spdm_secured_message_context, libspdm_hmac_state_t *hmac_state);
+
 /**
  * Makes a copy of an existing HMAC context, with request_finished_key.
  *
@@ -416,6 +428,18 @@ void libspdm_hmac_free_with_response_finished_key(
 bool libspdm_hmac_init_with_response_finished_key(
     void *spdm_secured_message_context, void *hmac_ctx);
 
+/**
+ * Initializes a fixed-size HMAC state with response_finished_key.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  hmac_state                      Pointer to the HMAC state being initialized.
+ *
+ * @retval true   The key is set successfully.
+ * @retval false  The key is set unsuccessfully.
+ **/
+bool libspdm_hmac_state_init_with_response_finished_key(
+    void *spdm_secured_message_context, libspdm_hmac_state_t *hmac_state);
+
 /**
  * Makes a copy of an existing HMAC context, with response_finished_key.
  *
@@ -0,0 +1,195 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "internal/libspdm_common_lib.h"
+
+/* The records are padded to this alignment.*/
+#define LIBSPDM_CAPTURE_ALIGNMENT 8
+
+#define LIBSPDM_CAPTURE_ALIGN(size) \
+    (((size) + LIBSPDM_CAPTURE_ALIGNMENT - 1) & ~(LIBSPDM_CAPTURE_ALIGNMENT - 1))
+
+/**
+ * Start the capture of the messages of an SPDM context.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  buffer                        The capture buffer.
+ * @param  buffer_size                   The size in bytes of the capture buffer.
+ * @param  flags                         The messages to capture, LIBSPDM_CAPTURE_FLAG_*.
+ * @param  get_time                      The function to get the time stamps of the records,
+ *                                       or NULL.
+ *
+ * @retval RETURN_SUCCESS               The capture is started.
+ * @retval RETURN_INVALID_PARAMETER     The buffer is too small for a record, or flags is 0.
+ * @retval RETURN_UNSUPPORTED           LIBSPDM_MESSAGE_CAPTURE_SUPPORT is 0.
+ **/
+return_status libspdm_start_message_capture(void *context, void *buffer,
+                                            uintn buffer_size, uint8_t flags,
+                                            libspdm_trace_get_time_func get_time)
+{
+#if LIBSPDM_MESSAGE_CAPTURE_SUPPORT
+    libspdm_context_t *spdm_context;
+    libspdm_capture_header_t *header;
+    uintn data_size;
+
+    spdm_context = context;
+    if ((buffer == NULL) || (buffer_size < sizeof(libspdm_capture_header_t)) ||
+        ((flags & (LIBSPDM_CAPTURE_FLAG_MESSAGE | LIBSPDM_CAPTURE_FLAG_WIRE)) == 0)) {
+        return RETURN_INVALID_PARAMETER;
+    }
+    data_size = buffer_size - sizeof(libspdm_capture_header_t);
+    if ((uint64_t)data_size > 0xFFFFFFFF) {
+        data_size = 0xFFFFFFFF;
+    }
+    data_size &= ~(uintn)(LIBSPDM_CAPTURE_ALIGNMENT - 1);
+    if (data_size < LIBSPDM_CAPTURE_ALIGN(sizeof(libspdm_capture_record_t) + 1)) {
+        return RETURN_INVALID_PARAMETER;
+    }
+
+    header = buffer;
+    libspdm_zero_mem(header, sizeof(libspdm_capture_header_t));
+    header->signature = LIBSPDM_CAPTURE_SIGNATURE;
+    header->version = LIBSPDM_CAPTURE_VERSION;
+    header->flags = flags;
+    header->data_size = (uint32_t)data_size;
+
+    spdm_context->capture = header;
+    spdm_context->capture_flags = flags;
+    spdm_context->capture_get_time = get_time;
+    return RETURN_SUCCESS;
+#else
+    return RETURN_UNSUPPORTED;
+#endif
+}
+
+/**
+ * Stop the capture of the messages of an SPDM context.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ **/
+void libspdm_stop_message_capture(void *context)
+{
+#if LIBSPDM_MESSAGE_CAPTURE_SUPPORT
+    libspdm_context_t *spdm_context;
+
+    spdm_context = context;
+    spdm_context->capture = NULL;
+    spdm_context->capture_flags = 0;
+    spdm_context->capture_get_time = NULL;
+#endif
+}
+
+#if LIBSPDM_MESSAGE_CAPTURE_SUPPORT
+/**
+ * This function returns the offset of a record, wrapped to 0 if the end of the record area
+ * cannot hold a record header.
+ **/
+static uint32_t libspdm_capture_wrap(const libspdm_capture_header_t *header, uint32_t offset)
+{
+    if (header->data_size - offset < sizeof(libspdm_capture_record_t)) {
+        return 0;
+    }
+    return offset;
+}
+
+/**
+ * This function drops the oldest records, until the record area [start, end) is free.
+ *
+ * start is the head of the ring, so the records from the tail are the ones in the area.
+ **/
+static void libspdm_capture_reclaim(libspdm_capture_header_t *header, uint32_t start,
+                                    uint32_t end)
+{
+    const libspdm_capture_record_t *record;
+
+    while ((header->record_count != 0) && (header->tail >= start) && (header->tail < end)) {
+        record = (const libspdm_capture_record_t *)((uint8_t *)(header + 1) + header->tail);
+        header->tail = libspdm_capture_wrap(header, header->tail + record->record_size);
+        header->record_count--;
+    }
+}
+
+/**
+ * This function writes a record at the head of the ring.
+ **/
+static void libspdm_capture_write(libspdm_capture_header_t *header, uint32_t record_size,
+                                  const libspdm_capture_record_t *record,
+                                  uintn message_size, const void *message)
+{
+    uint8_t *data;
+    libspdm_capture_record_t *head_record;
+
+    libspdm_capture_reclaim(header, header->head, header->head + record_size);
+    if (header->record_count == 0) {
+        header->tail = header->head;
+    }
+
+    data = (uint8_t *)(header + 1) + header->head;
+    head_record = (libspdm_capture_record_t *)data;
+    libspdm_copy_mem(head_record, sizeof(libspdm_capture_record_t),
+                     record, sizeof(libspdm_capture_record_t));
+    head_record->record_size = record_size;
+    head_record->sequence = header->sequence;
+    if (message_size != 0) {
+        libspdm_copy_mem(head_record + 1, record_size - sizeof(libspdm_capture_record_t),
+                         message, message_size);
+    }
+
+    header->head = libspdm_capture_wrap(header, header->head + record_size);
+    header->record_count++;
+    header->sequence++;
+}
+
+/**
+ * This function records a message in the message capture of an SPDM context, if any.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  type                          The record type, LIBSPDM_CAPTURE_RECORD_*.
+ * @param  direction                     The direction, LIBSPDM_CAPTURE_DIRECTION_*.
+ * @param  session_id                    The session ID, or INVALID_SESSION_ID.
+ * @param  message_size                  The size in bytes of the message.
+ * @param  message                       A pointer to the message.
+ **/
+void libspdm_capture_message(libspdm_context_t *spdm_context, uint8_t type, uint8_t direction,
+                             uint32_t session_id, uintn message_size, const void *message)
+{
+    libspdm_capture_header_t *header;
+    libspdm_capture_record_t record;
+    uintn captured_size;
+    uint32_t record_size;
+    uint8_t flag;
+
+    header = spdm_context->capture;
+    flag = (type == LIBSPDM_CAPTURE_RECORD_WIRE) ?
+           LIBSPDM_CAPTURE_FLAG_WIRE : LIBSPDM_CAPTURE_FLAG_MESSAGE;
+    if ((header == NULL) || ((spdm_context->capture_flags & flag) == 0)) {
+        return;
+    }
+
+    captured_size = message_size;
+    if (captured_size > header->data_size - sizeof(libspdm_capture_record_t)) {
+        captured_size = header->data_size - sizeof(libspdm_capture_record_t);
+    }
+    record_size = (uint32_t)LIBSPDM_CAPTURE_ALIGN(sizeof(libspdm_capture_record_t) +
+                                                  captured_size);
+
+    libspdm_zero_mem(&record, sizeof(record));
+    record.time_stamp = (spdm_context->capture_get_time != NULL) ?
+                        spdm_context->capture_get_time() : 0;
+
+    /* A record does not wrap around, a PAD record fills the end of the record area.*/
+    if (header->data_size - header->head < record_size) {
+        record.type = LIBSPDM_CAPTURE_RECORD_PAD;
+        libspdm_capture_write(header, header->data_size - header->head, &record, 0, NULL);
+    }
+
+    record.type = type;
+    record.direction = direction;
+    record.session_id = session_id;
+    record.message_size = (uint32_t)message_size;
+    libspdm_capture_write(header, record_size, &record, captured_size, message);
+}
+#endif
@@ -174,7 +174,7 @@ return_status libspdm_set_data(void *context, libspdm_data_type_t data_type,
             return RETURN_INVALID_PARAMETER;
         }
         /* Only allow set smaller value*/
-        LIBSPDM_ASSERT (*(uint32_t *)data <= LIBSPDM_MAX_MESSAGE_BUFFER_SIZE);
+        LIBSPDM_ASSERT (*(uint32_t *)data <= spdm_context->config.max_message_size);
         spdm_context->local_context.capability.data_transfer_size =
             *(uint32_t *)data;
         break;
@@ -183,7 +183,7 @@ return_status libspdm_set_data(void *context, libspdm_data_type_t data_type,
             return RETURN_INVALID_PARAMETER;
         }
         /* Only allow set smaller value. Need different value for CHUNK - TBD*/
-        LIBSPDM_ASSERT (*(uint32_t *)data <= LIBSPDM_MAX_MESSAGE_BUFFER_SIZE);
+        LIBSPDM_ASSERT (*(uint32_t *)data <= spdm_context->config.max_message_size);
         spdm_context->local_context.capability.max_spdm_msg_size =
             *(uint32_t *)data;
         break;
@@ -345,6 +345,9 @@ return_status libspdm_set_data(void *context, libspdm_data_type_t data_type,
         .local_cert_chain_provision_size[slot_id] = data_size;
         spdm_context->local_context.local_cert_chain_provision[slot_id] =
             data;
+        /* The chain may be updated in place, so flush its digest.*/
+        libspdm_zero_mem(&spdm_context->local_context.local_cert_chain_hash[slot_id],
+                         sizeof(libspdm_cert_chain_hash_cache_t));
         break;
     case LIBSPDM_DATA_LOCAL_USED_CERT_CHAIN_BUFFER:
         if (data_size > LIBSPDM_MAX_CERT_CHAIN_SIZE) {
@@ -365,6 +368,8 @@ return_status libspdm_set_data(void *context, libspdm_data_type_t data_type,
         libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
                          sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer),
                          data, data_size);
+        /* The negotiated hash size may not be known yet, so leave the chain unindexed.*/
+        spdm_context->connection_info.peer_used_cert_chain_index.cert_count = 0;
 #else
         status = libspdm_hash_all(
             spdm_context->connection_info.algorithm.base_hash_algo,
@@ -406,6 +411,8 @@ return_status libspdm_set_data(void *context, libspdm_data_type_t data_type,
             return RETURN_UNSUPPORTED;
         }
 #endif
+        spdm_context->connection_info.peer_used_cert_chain_slot_id =
+            LIBSPDM_PEER_CERT_CHAIN_SLOT_ID_UNKNOWN;
         break;
     case LIBSPDM_DATA_BASIC_MUT_AUTH_REQUESTED:
         if (data_size != sizeof(bool)) {
@@ -443,6 +450,15 @@ return_status libspdm_set_data(void *context, libspdm_data_type_t data_type,
         spdm_context->encap_context.req_slot_id =
             parameter->additional_data[0];
         break;
+    case LIBSPDM_DATA_CERT_CHAIN_BLOCK_LEN:
+        if (data_size != sizeof(uint16_t)) {
+            return RETURN_INVALID_PARAMETER;
+        }
+        if (*(uint16_t *)data > LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN) {
+            return RETURN_INVALID_PARAMETER;
+        }
+        spdm_context->local_context.cert_chain_block_len = *(uint16_t *)data;
+        break;
     case LIBSPDM_DATA_HEARTBEAT_PERIOD:
         if (data_size != sizeof(uint8_t)) {
             return RETURN_INVALID_PARAMETER;
@@ -689,6 +705,10 @@ return_status libspdm_get_data(void *context, libspdm_data_type_t data_type,
         target_data_size = sizeof(uint32_t);
         target_data = &spdm_context->response_state;
         break;
+    case LIBSPDM_DATA_CERT_CHAIN_BLOCK_LEN:
+        target_data_size = sizeof(uint16_t);
+        target_data = &spdm_context->local_context.cert_chain_block_len;
+        break;
     case LIBSPDM_DATA_SESSION_USE_PSK:
         target_data_size = sizeof(bool);
         target_data = &session_info->use_psk;
@@ -754,11 +774,7 @@ void libspdm_reset_message_b(void *context)
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     libspdm_reset_managed_buffer(&spdm_context->transcript.message_b);
 #else
-    if (spdm_context->transcript.digest_context_m1m2 != NULL) {
-        libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                           spdm_context->transcript.digest_context_m1m2);
-        spdm_context->transcript.digest_context_m1m2 = NULL;
-    }
+    libspdm_hash_state_free(&spdm_context->transcript.digest_context_m1m2);
 #endif
 }
 
@@ -775,11 +791,7 @@ void libspdm_reset_message_c(void *context)
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     libspdm_reset_managed_buffer(&spdm_context->transcript.message_c);
 #else
-    if (spdm_context->transcript.digest_context_m1m2 != NULL) {
-        libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                           spdm_context->transcript.digest_context_m1m2);
-        spdm_context->transcript.digest_context_m1m2 = NULL;
-    }
+    libspdm_hash_state_free(&spdm_context->transcript.digest_context_m1m2);
 #endif
 }
 
@@ -796,11 +808,7 @@ void libspdm_reset_message_mut_b(void *context)
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     libspdm_reset_managed_buffer(&spdm_context->transcript.message_mut_b);
 #else
-    if (spdm_context->transcript.digest_context_mut_m1m2 != NULL) {
-        libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                           spdm_context->transcript.digest_context_mut_m1m2);
-        spdm_context->transcript.digest_context_mut_m1m2 = NULL;
-    }
+    libspdm_hash_state_free(&spdm_context->transcript.digest_context_mut_m1m2);
 #endif
 }
 
@@ -817,11 +825,7 @@ void libspdm_reset_message_mut_c(void *context)
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     libspdm_reset_managed_buffer(&spdm_context->transcript.message_mut_c);
 #else
-    if (spdm_context->transcript.digest_context_mut_m1m2 != NULL) {
-        libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                           spdm_context->transcript.digest_context_mut_m1m2);
-        spdm_context->transcript.digest_context_mut_m1m2 = NULL;
-    }
+    libspdm_hash_state_free(&spdm_context->transcript.digest_context_mut_m1m2);
 #endif
 }
 
@@ -848,17 +852,9 @@ void libspdm_reset_message_m(void *context, void *session_info)
     }
 #else
     if (spdm_session_info == NULL) {
-        if (spdm_context->transcript.digest_context_l1l2 != NULL) {
-            libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                               spdm_context->transcript.digest_context_l1l2);
-            spdm_context->transcript.digest_context_l1l2 = NULL;
-        }
+        libspdm_hash_state_free(&spdm_context->transcript.digest_context_l1l2);
     } else {
-        if (spdm_session_info->session_transcript.digest_context_l1l2 != NULL) {
-            libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                               spdm_session_info->session_transcript.digest_context_l1l2);
-            spdm_session_info->session_transcript.digest_context_l1l2 = NULL;
-        }
+        libspdm_hash_state_free(&spdm_session_info->session_transcript.digest_context_l1l2);
     }
 #endif
 }
@@ -878,44 +874,14 @@ void libspdm_reset_message_k(void *context, void *session_info)
     libspdm_reset_managed_buffer(&spdm_session_info->session_transcript.message_k);
 #else
     {
-        libspdm_context_t *spdm_context;
-        void *secured_message_context;
-
-        spdm_context = context;
-        secured_message_context = spdm_session_info->secured_message_context;
-
         libspdm_reset_managed_buffer(&spdm_session_info->session_transcript.temp_message_k);
 
-        if (spdm_session_info->session_transcript.digest_context_th != NULL) {
-            libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                               spdm_session_info->session_transcript.digest_context_th);
-            spdm_session_info->session_transcript.digest_context_th = NULL;
-        }
-        if (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL) {
-            libspdm_hmac_free_with_response_finished_key (secured_message_context,
-                                                          spdm_session_info->session_transcript.hmac_rsp_context_th);
-            spdm_session_info->session_transcript.hmac_rsp_context_th = NULL;
-        }
-        if (spdm_session_info->session_transcript.hmac_req_context_th != NULL) {
-            libspdm_hmac_free_with_request_finished_key (secured_message_context,
-                                                         spdm_session_info->session_transcript.hmac_req_context_th);
-            spdm_session_info->session_transcript.hmac_req_context_th = NULL;
-        }
-        if (spdm_session_info->session_transcript.digest_context_th_backup != NULL) {
-            libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                               spdm_session_info->session_transcript.digest_context_th_backup);
-            spdm_session_info->session_transcript.digest_context_th_backup = NULL;
-        }
-        if (spdm_session_info->session_transcript.hmac_rsp_context_th_backup != NULL) {
-            libspdm_hmac_free_with_response_finished_key (secured_message_context,
-                                                          spdm_session_info->session_transcript.hmac_rsp_context_th_backup);
-            spdm_session_info->session_transcript.hmac_rsp_context_th_backup = NULL;
-        }
-        if (spdm_session_info->session_transcript.hmac_req_context_th_backup != NULL) {
-            libspdm_hmac_free_with_request_finished_key (secured_message_context,
-                                                         spdm_session_info->session_transcript.hmac_req_context_th_backup);
-            spdm_session_info->session_transcript.hmac_req_context_th_backup = NULL;
-        }
+        libspdm_hash_state_free(&spdm_session_info->session_transcript.digest_context_th);
+        libspdm_hmac_state_free(&spdm_session_info->session_transcript.hmac_rsp_context_th);
+        libspdm_hmac_state_free(&spdm_session_info->session_transcript.hmac_req_context_th);
+        libspdm_hash_state_free(&spdm_session_info->session_transcript.digest_context_th_backup);
+        libspdm_hmac_state_free(&spdm_session_info->session_transcript.hmac_rsp_context_th_backup);
+        libspdm_hmac_state_free(&spdm_session_info->session_transcript.hmac_req_context_th_backup);
         spdm_session_info->session_transcript.finished_key_ready = false;
     }
 #endif
@@ -936,32 +902,34 @@ void libspdm_reset_message_f(void *context, void *session_info)
     libspdm_reset_managed_buffer(&spdm_session_info->session_transcript.message_f);
 #else
     {
-        libspdm_context_t *spdm_context;
-        void *secured_message_context;
-
-        spdm_context = context;
-        secured_message_context = spdm_session_info->secured_message_context;
-
-        if (spdm_session_info->session_transcript.digest_context_th != NULL) {
-            libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                               spdm_session_info->session_transcript.digest_context_th);
-            spdm_session_info->session_transcript.digest_context_th =
-                spdm_session_info->session_transcript.digest_context_th_backup;
-            spdm_session_info->session_transcript.digest_context_th_backup = NULL;
-        }
-        if (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL) {
-            libspdm_hmac_free_with_response_finished_key (secured_message_context,
-                                                          spdm_session_info->session_transcript.hmac_rsp_context_th);
-            spdm_session_info->session_transcript.hmac_rsp_context_th =
-                spdm_session_info->session_transcript.hmac_rsp_context_th_backup;
-            spdm_session_info->session_transcript.hmac_rsp_context_th_backup = NULL;
-        }
-        if (spdm_session_info->session_transcript.hmac_req_context_th != NULL) {
-            libspdm_hmac_free_with_response_finished_key (secured_message_context,
-                                                          spdm_session_info->session_transcript.hmac_req_context_th);
-            spdm_session_info->session_transcript.hmac_req_context_th =
-                spdm_session_info->session_transcript.hmac_req_context_th_backup;
-            spdm_session_info->session_transcript.hmac_req_context_th_backup = NULL;
+        /* restore the message_k states that were backed up by the first append_message_f.*/
+        if (spdm_session_info->session_transcript.digest_context_th.hash_nid !=
+            LIBSPDM_CRYPTO_NID_NULL) {
+            libspdm_hash_state_free(&spdm_session_info->session_transcript.digest_context_th);
+            libspdm_copy_mem(&spdm_session_info->session_transcript.digest_context_th,
+                             sizeof(libspdm_hash_state_t),
+                             &spdm_session_info->session_transcript.digest_context_th_backup,
+                             sizeof(libspdm_hash_state_t));
+            libspdm_zero_mem(&spdm_session_info->session_transcript.digest_context_th_backup,
+                             sizeof(libspdm_hash_state_t));
+        }
+        if (spdm_session_info->session_transcript.hmac_rsp_context_th.base_hash_algo != 0) {
+            libspdm_hmac_state_free(&spdm_session_info->session_transcript.hmac_rsp_context_th);
+            libspdm_copy_mem(&spdm_session_info->session_transcript.hmac_rsp_context_th,
+                             sizeof(libspdm_hmac_state_t),
+                             &spdm_session_info->session_transcript.hmac_rsp_context_th_backup,
+                             sizeof(libspdm_hmac_state_t));
+            libspdm_zero_mem(&spdm_session_info->session_transcript.hmac_rsp_context_th_backup,
+                             sizeof(libspdm_hmac_state_t));
+        }
+        if (spdm_session_info->session_transcript.hmac_req_context_th.base_hash_algo != 0) {
+            libspdm_hmac_state_free(&spdm_session_info->session_transcript.hmac_req_context_th);
+            libspdm_copy_mem(&spdm_session_info->session_transcript.hmac_req_context_th,
+                             sizeof(libspdm_hmac_state_t),
+                             &spdm_session_info->session_transcript.hmac_req_context_th_backup,
+                             sizeof(libspdm_hmac_state_t));
+            libspdm_zero_mem(&spdm_session_info->session_transcript.hmac_req_context_th_backup,
+                             sizeof(libspdm_hmac_state_t));
         }
         spdm_session_info->session_transcript.message_f_initialized = false;
     }
@@ -1065,37 +1033,25 @@ return_status libspdm_append_message_b(void *context, const void *message,
     {
         bool result;
 
-        if (spdm_context->transcript.digest_context_m1m2 == NULL) {
-            spdm_context->transcript.digest_context_m1m2 = libspdm_hash_new (
-                spdm_context->connection_info.algorithm.base_hash_algo);
-            if (spdm_context->transcript.digest_context_m1m2 == NULL) {
-                return RETURN_DEVICE_ERROR;
-            }
-            result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                        spdm_context->transcript.digest_context_m1m2);
+        if (spdm_context->transcript.digest_context_m1m2.hash_nid == LIBSPDM_CRYPTO_NID_NULL) {
+            result = libspdm_hash_state_init (
+                spdm_context->connection_info.algorithm.base_hash_algo,
+                &spdm_context->transcript.digest_context_m1m2);
             if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_m1m2);
-                spdm_context->transcript.digest_context_m1m2 = NULL;
                 return RETURN_DEVICE_ERROR;
             }
-            result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                          spdm_context->transcript.digest_context_m1m2,
-                                          libspdm_get_managed_buffer(&spdm_context->transcript.
-                                                                     message_a),
-                                          libspdm_get_managed_buffer_size(&spdm_context->transcript.
-                                                                          message_a));
+            result = libspdm_hash_state_update (
+                &spdm_context->transcript.digest_context_m1m2,
+                libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
+                libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
             if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_m1m2);
-                spdm_context->transcript.digest_context_m1m2 = NULL;
+                libspdm_hash_state_free(&spdm_context->transcript.digest_context_m1m2);
                 return RETURN_DEVICE_ERROR;
             }
         }
 
-        result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                      spdm_context->transcript.digest_context_m1m2, message,
-                                      message_size);
+        result = libspdm_hash_state_update (&spdm_context->transcript.digest_context_m1m2,
+                                            message, message_size);
         if (!result) {
             return RETURN_DEVICE_ERROR;
         }
@@ -1128,37 +1084,25 @@ return_status libspdm_append_message_c(void *context, const void *message,
     {
         bool result;
 
-        if (spdm_context->transcript.digest_context_m1m2 == NULL) {
-            spdm_context->transcript.digest_context_m1m2 = libspdm_hash_new (
-                spdm_context->connection_info.algorithm.base_hash_algo);
-            if (spdm_context->transcript.digest_context_m1m2 == NULL) {
-                return RETURN_DEVICE_ERROR;
-            }
-            result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                        spdm_context->transcript.digest_context_m1m2);
+        if (spdm_context->transcript.digest_context_m1m2.hash_nid == LIBSPDM_CRYPTO_NID_NULL) {
+            result = libspdm_hash_state_init (
+                spdm_context->connection_info.algorithm.base_hash_algo,
+                &spdm_context->transcript.digest_context_m1m2);
             if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_m1m2);
-                spdm_context->transcript.digest_context_m1m2 = NULL;
                 return RETURN_DEVICE_ERROR;
             }
-            result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                          spdm_context->transcript.digest_context_m1m2,
-                                          libspdm_get_managed_buffer(&spdm_context->transcript.
-                                                                     message_a),
-                                          libspdm_get_managed_buffer_size(&spdm_context->transcript.
-                                                                          message_a));
+            result = libspdm_hash_state_update (
+                &spdm_context->transcript.digest_context_m1m2,
+                libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
+                libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
             if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_m1m2);
-                spdm_context->transcript.digest_context_m1m2 = NULL;
+                libspdm_hash_state_free(&spdm_context->transcript.digest_context_m1m2);
                 return RETURN_DEVICE_ERROR;
             }
         }
 
-        result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                      spdm_context->transcript.digest_context_m1m2, message,
-                                      message_size);
+        result = libspdm_hash_state_update (&spdm_context->transcript.digest_context_m1m2,
+                                            message, message_size);
         if (!result) {
             return RETURN_DEVICE_ERROR;
         }
@@ -1191,25 +1135,17 @@ return_status libspdm_append_message_mut_b(void *context, const void *message,
     {
         bool result;
 
-        if (spdm_context->transcript.digest_context_mut_m1m2 == NULL) {
-            spdm_context->transcript.digest_context_mut_m1m2 = libspdm_hash_new (
-                spdm_context->connection_info.algorithm.base_hash_algo);
-            if (spdm_context->transcript.digest_context_mut_m1m2 == NULL) {
-                return RETURN_DEVICE_ERROR;
-            }
-            result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                        spdm_context->transcript.digest_context_mut_m1m2);
+        if (spdm_context->transcript.digest_context_mut_m1m2.hash_nid == LIBSPDM_CRYPTO_NID_NULL) {
+            result = libspdm_hash_state_init (
+                spdm_context->connection_info.algorithm.base_hash_algo,
+                &spdm_context->transcript.digest_context_mut_m1m2);
             if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_mut_m1m2);
-                spdm_context->transcript.digest_context_mut_m1m2 = NULL;
                 return RETURN_DEVICE_ERROR;
             }
         }
 
-        result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                      spdm_context->transcript.digest_context_mut_m1m2, message,
-                                      message_size);
+        result = libspdm_hash_state_update (&spdm_context->transcript.digest_context_mut_m1m2,
+                                            message, message_size);
         if (!result) {
             return RETURN_DEVICE_ERROR;
         }
@@ -1242,25 +1178,17 @@ return_status libspdm_append_message_mut_c(void *context, const void *message,
     {
         bool result;
 
-        if (spdm_context->transcript.digest_context_mut_m1m2 == NULL) {
-            spdm_context->transcript.digest_context_mut_m1m2 = libspdm_hash_new (
-                spdm_context->connection_info.algorithm.base_hash_algo);
-            if (spdm_context->transcript.digest_context_mut_m1m2 == NULL) {
-                return RETURN_DEVICE_ERROR;
-            }
-            result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                        spdm_context->transcript.digest_context_mut_m1m2);
+        if (spdm_context->transcript.digest_context_mut_m1m2.hash_nid == LIBSPDM_CRYPTO_NID_NULL) {
+            result = libspdm_hash_state_init (
+                spdm_context->connection_info.algorithm.base_hash_algo,
+                &spdm_context->transcript.digest_context_mut_m1m2);
             if (!result) {
-                libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                   spdm_context->transcript.digest_context_mut_m1m2);
-                spdm_context->transcript.digest_context_mut_m1m2 = NULL;
                 return RETURN_DEVICE_ERROR;
             }
         }
 
-        result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                      spdm_context->transcript.digest_context_mut_m1m2, message,
-                                      message_size);
+        result = libspdm_hash_state_update (&spdm_context->transcript.digest_context_mut_m1m2,
+                                            message, message_size);
         if (!result) {
             return RETURN_DEVICE_ERROR;
         }
@@ -1303,83 +1231,35 @@ return_status libspdm_append_message_m(void *context, void *session_info,
     {
         bool result;
 
+        libspdm_hash_state_t *digest_context_l1l2;
+
         if (spdm_session_info == NULL) {
-            if (spdm_context->transcript.digest_context_l1l2 == NULL) {
-                spdm_context->transcript.digest_context_l1l2 = libspdm_hash_new (
-                    spdm_context->connection_info.algorithm.base_hash_algo);
-                if (spdm_context->transcript.digest_context_l1l2 == NULL) {
-                    return RETURN_DEVICE_ERROR;
-                }
-                result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                            spdm_context->transcript.digest_context_l1l2);
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_context->transcript.digest_context_l1l2);
-                    spdm_context->transcript.digest_context_l1l2 = NULL;
-                    return RETURN_DEVICE_ERROR;
-                }
-            }
-            if ((spdm_context->connection_info.version >> SPDM_VERSION_NUMBER_SHIFT_BIT) >
-                SPDM_MESSAGE_VERSION_11) {
-
-                /* Need append VCA since 1.2 script*/
-
-                result = libspdm_hash_update (
-                    spdm_context->connection_info.algorithm.base_hash_algo,
-                    spdm_context->transcript.digest_context_l1l2,
-                    libspdm_get_managed_buffer(
-                        &spdm_context->transcript.message_a),
-                    libspdm_get_managed_buffer_size(&spdm_context->transcript.
-                                                    message_a));
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_context->transcript.digest_context_l1l2);
-                    spdm_context->transcript.digest_context_l1l2 = NULL;
-                    return RETURN_DEVICE_ERROR;
-                }
-            }
-            result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                          spdm_context->transcript.digest_context_l1l2, message,
-                                          message_size);
+            digest_context_l1l2 = &spdm_context->transcript.digest_context_l1l2;
         } else {
-            if (spdm_session_info->session_transcript.digest_context_l1l2 == NULL) {
-                spdm_session_info->session_transcript.digest_context_l1l2 = libspdm_hash_new (
-                    spdm_context->connection_info.algorithm.base_hash_algo);
-                if (spdm_session_info->session_transcript.digest_context_l1l2 == NULL) {
-                    return RETURN_DEVICE_ERROR;
-                }
-                result = libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                                            spdm_session_info->session_transcript.digest_context_l1l2);
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_session_info->session_transcript.digest_context_l1l2);
-                    spdm_session_info->session_transcript.digest_context_l1l2 = NULL;
-                    return RETURN_DEVICE_ERROR;
-                }
+            digest_context_l1l2 = &spdm_session_info->session_transcript.digest_context_l1l2;
+        }
+        if (digest_context_l1l2->hash_nid == LIBSPDM_CRYPTO_NID_NULL) {
+            result = libspdm_hash_state_init (
+                spdm_context->connection_info.algorithm.base_hash_algo, digest_context_l1l2);
+            if (!result) {
+                return RETURN_DEVICE_ERROR;
             }
-            if ((spdm_context->connection_info.version >> SPDM_VERSION_NUMBER_SHIFT_BIT) >
-                SPDM_MESSAGE_VERSION_11) {
-
-                /* Need append VCA since 1.2 script*/
-
-                result = libspdm_hash_update (
-                    spdm_context->connection_info.algorithm.base_hash_algo,
-                    spdm_session_info->session_transcript.digest_context_l1l2,
-                    libspdm_get_managed_buffer(
-                        &spdm_context->transcript.message_a),
-                    libspdm_get_managed_buffer_size(&spdm_context->transcript.
-                                                    message_a));
-                if (!result) {
-                    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                                       spdm_session_info->session_transcript.digest_context_l1l2);
-                    spdm_session_info->session_transcript.digest_context_l1l2 = NULL;
-                    return RETURN_DEVICE_ERROR;
-                }
+        }
+        if ((spdm_context->connection_info.version >> SPDM_VERSION_NUMBER_SHIFT_BIT) >
+            SPDM_MESSAGE_VERSION_11) {
+
+            /* Need append VCA since 1.2 script*/
+
+            result = libspdm_hash_state_update (
+                digest_context_l1l2,
+                libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
+                libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
+            if (!result) {
+                libspdm_hash_state_free(digest_context_l1l2);
+                return RETURN_DEVICE_ERROR;
             }
-            result = libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                          spdm_session_info->session_transcript.digest_context_l1l2,
-                                          message, message_size);
         }
+        result = libspdm_hash_state_update (digest_context_l1l2, message, message_size);
 
         if (!result) {
             return RETURN_DEVICE_ERROR;
@@ -1428,7 +1308,8 @@ return_status libspdm_append_message_k(void *context, void *session_info,
         secured_message_context = spdm_session_info->secured_message_context;
         finished_key_ready = libspdm_secured_message_is_finished_key_ready(secured_message_context);
 
-        if (spdm_session_info->session_transcript.digest_context_th == NULL) {
+        if (spdm_session_info->session_transcript.digest_context_th.hash_nid ==
+            LIBSPDM_CRYPTO_NID_NULL) {
             if (!spdm_session_info->use_psk) {
                 if (is_requester) {
                     if(spdm_context->connection_info.peer_used_cert_chain_buffer_hash_size != 0) {
@@ -1479,32 +1360,29 @@ return_status libspdm_append_message_k(void *context, void *session_info,
 
         /* prepare digest_context_th*/
 
-        if (spdm_session_info->session_transcript.digest_context_th == NULL) {
-            spdm_session_info->session_transcript.digest_context_th = libspdm_hash_new (
-                spdm_context->connection_info.algorithm.base_hash_algo);
-            libspdm_hash_init (spdm_context->connection_info.algorithm.base_hash_algo,
-                               spdm_session_info->session_transcript.digest_context_th);
-            libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                 spdm_session_info->session_transcript.digest_context_th,
-                                 libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
-                                 libspdm_get_managed_buffer_size(
-                                     &spdm_context->transcript.message_a));
+        if (spdm_session_info->session_transcript.digest_context_th.hash_nid ==
+            LIBSPDM_CRYPTO_NID_NULL) {
+            libspdm_hash_state_init (spdm_context->connection_info.algorithm.base_hash_algo,
+                                     &spdm_session_info->session_transcript.digest_context_th);
+            libspdm_hash_state_update (&spdm_session_info->session_transcript.digest_context_th,
+                                       libspdm_get_managed_buffer(
+                                           &spdm_context->transcript.message_a),
+                                       libspdm_get_managed_buffer_size(
+                                           &spdm_context->transcript.message_a));
             libspdm_append_managed_buffer(
                 &spdm_session_info->session_transcript.temp_message_k,
                 libspdm_get_managed_buffer(&spdm_context->transcript.message_a),
                 libspdm_get_managed_buffer_size(&spdm_context->transcript.message_a));
             if (!spdm_session_info->use_psk) {
-                libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                     spdm_session_info->session_transcript.digest_context_th,
-                                     cert_chain_buffer_hash, hash_size);
+                libspdm_hash_state_update (&spdm_session_info->session_transcript.digest_context_th,
+                                           cert_chain_buffer_hash, hash_size);
                 libspdm_append_managed_buffer(
                     &spdm_session_info->session_transcript.temp_message_k,
                     cert_chain_buffer_hash, hash_size);
             }
         }
-        libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                             spdm_session_info->session_transcript.digest_context_th, message,
-                             message_size);
+        libspdm_hash_state_update (&spdm_session_info->session_transcript.digest_context_th,
+                                   message, message_size);
         if (!finished_key_ready) {
 
             /* append message only if finished_key is NOT ready.*/
@@ -1527,58 +1405,32 @@ return_status libspdm_append_message_k(void *context, void *session_info,
 
         /* prepare hmac_rsp_context_th*/
 
-        if (spdm_session_info->session_transcript.hmac_rsp_context_th == NULL) {
-            spdm_session_info->session_transcript.hmac_rsp_context_th =
-                libspdm_hmac_new_with_response_finished_key (
-                    secured_message_context);
-            libspdm_hmac_init_with_response_finished_key (secured_message_context,
-                                                          spdm_session_info->session_transcript.hmac_rsp_context_th);
-            libspdm_hmac_update_with_response_finished_key (secured_message_context,
-                                                            spdm_session_info->session_transcript.hmac_rsp_context_th,
-                                                            libspdm_get_managed_buffer(&
-                                                                                       spdm_session_info
-                                                                                       ->
-                                                                                       session_transcript
-                                                                                       .
-                                                                                       temp_message_k),
-                                                            libspdm_get_managed_buffer_size(&
-                                                                                            spdm_session_info
-                                                                                            ->
-                                                                                            session_transcript
-                                                                                            .
-                                                                                            temp_message_k));
-        }
-        libspdm_hmac_update_with_response_finished_key (secured_message_context,
-                                                        spdm_session_info->session_transcript.hmac_rsp_context_th, message,
-                                                        message_size);
+        if (spdm_session_info->session_transcript.hmac_rsp_context_th.base_hash_algo == 0) {
+            libspdm_hmac_state_init_with_response_finished_key (
+                secured_message_context, &spdm_session_info->session_transcript.hmac_rsp_context_th);
+            libspdm_hmac_state_update (
+                &spdm_session_info->session_transcript.hmac_rsp_context_th,
+                libspdm_get_managed_buffer(&spdm_session_info->session_transcript.temp_message_k),
+                libspdm_get_managed_buffer_size(
+                    &spdm_session_info->session_transcript.temp_message_k));
+        }
+        libspdm_hmac_state_update (&spdm_session_info->session_transcript.hmac_rsp_context_th,
+                                   message, message_size);
 
 
         /* prepare hmac_req_context_th*/
 
-        if (spdm_session_info->session_transcript.hmac_req_context_th == NULL) {
-            spdm_session_info->session_transcript.hmac_req_context_th =
-                libspdm_hmac_new_with_request_finished_key (
-                    secured_message_context);
-            libspdm_hmac_init_with_request_finished_key (secured_message_context,
-                                                         spdm_session_info->session_transcript.hmac_req_context_th);
-            libspdm_hmac_update_with_request_finished_key (secured_message_context,
-                                                           spdm_session_info->session_transcript.hmac_req_context_th,
-                                                           libspdm_get_managed_buffer(&
-                                                                                      spdm_session_info
-                                                                                      ->
-                                                                                      session_transcript
-                                                                                      .
-                                                                                      temp_message_k),
-                                                           libspdm_get_managed_buffer_size(&
-                                                                                           spdm_session_info
-                                                                                           ->
-                                                                                           session_transcript
-                                                                                           .
-                                                                                           temp_message_k));
-        }
-        libspdm_hmac_update_with_request_finished_key (secured_message_context,
-                                                       spdm_session_info->session_transcript.hmac_req_context_th, message,
-                                                       message_size);
+        if (spdm_session_info->session_transcript.hmac_req_context_th.base_hash_algo == 0) {
+            libspdm_hmac_state_init_with_request_finished_key (
+                secured_message_context, &spdm_session_info->session_transcript.hmac_req_context_th);
+            libspdm_hmac_state_update (
+                &spdm_session_info->session_transcript.hmac_req_context_th,
+                libspdm_get_managed_buffer(&spdm_session_info->session_transcript.temp_message_k),
+                libspdm_get_managed_buffer_size(
+                    &spdm_session_info->session_transcript.temp_message_k));
+        }
+        libspdm_hmac_state_update (&spdm_session_info->session_transcript.hmac_req_context_th,
+                                   message, message_size);
         return RETURN_SUCCESS;
     }
 #endif
@@ -1632,9 +1484,10 @@ return_status libspdm_append_message_f(void *context, void *session_info,
              * trigger message_k to initialize by using zero length message_k, no impact to hash or HMAC.
              *   only temp_message_k is appended.*/
 
-            if (spdm_session_info->session_transcript.digest_context_th == NULL ||
-                spdm_session_info->session_transcript.hmac_rsp_context_th == NULL ||
-                spdm_session_info->session_transcript.hmac_req_context_th == NULL) {
+            if (spdm_session_info->session_transcript.digest_context_th.hash_nid ==
+                LIBSPDM_CRYPTO_NID_NULL ||
+                spdm_session_info->session_transcript.hmac_rsp_context_th.base_hash_algo == 0 ||
+                spdm_session_info->session_transcript.hmac_req_context_th.base_hash_algo == 0) {
                 status = libspdm_append_message_k (context, session_info, is_requester, NULL, 0);
                 if (RETURN_ERROR(status)) {
                     return status;
@@ -1692,74 +1545,71 @@ return_status libspdm_append_message_f(void *context, void *session_info,
             /* It is first time call, backup current message_k context
              * this backup will be used in reset_message_f.*/
 
-            LIBSPDM_ASSERT (spdm_session_info->session_transcript.digest_context_th != NULL);
-            spdm_session_info->session_transcript.digest_context_th_backup = libspdm_hash_new (
-                spdm_context->connection_info.algorithm.base_hash_algo);
-            libspdm_hash_duplicate (spdm_context->connection_info.algorithm.base_hash_algo,
-                                    spdm_session_info->session_transcript.digest_context_th,
-                                    spdm_session_info->session_transcript.digest_context_th_backup);
+            LIBSPDM_ASSERT (spdm_session_info->session_transcript.digest_context_th.hash_nid !=
+                            LIBSPDM_CRYPTO_NID_NULL);
+            libspdm_hash_state_free(&spdm_session_info->session_transcript.digest_context_th_backup);
+            libspdm_hash_state_duplicate (
+                &spdm_session_info->session_transcript.digest_context_th,
+                &spdm_session_info->session_transcript.digest_context_th_backup);
 
-            LIBSPDM_ASSERT (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL);
-            spdm_session_info->session_transcript.hmac_rsp_context_th_backup =
-                libspdm_hmac_new_with_response_finished_key (
-                    secured_message_context);
-            libspdm_hmac_duplicate_with_response_finished_key (secured_message_context,
-                                                               spdm_session_info->session_transcript.hmac_rsp_context_th,
-                                                               spdm_session_info->session_transcript.hmac_rsp_context_th_backup);
+            LIBSPDM_ASSERT (
+                spdm_session_info->session_transcript.hmac_rsp_context_th.base_hash_algo != 0);
+            libspdm_hmac_state_free(&spdm_session_info->session_transcript.hmac_rsp_context_th_backup);
+            libspdm_hmac_state_duplicate (
+                &spdm_session_info->session_transcript.hmac_rsp_context_th,
+                &spdm_session_info->session_transcript.hmac_rsp_context_th_backup);
 
-            LIBSPDM_ASSERT (spdm_session_info->session_transcript.hmac_req_context_th != NULL);
-            spdm_session_info->session_transcript.hmac_req_context_th_backup =
-                libspdm_hmac_new_with_request_finished_key (
-                    secured_message_context);
-            libspdm_hmac_duplicate_with_request_finished_key (secured_message_context,
-                                                              spdm_session_info->session_transcript.hmac_req_context_th,
-                                                              spdm_session_info->session_transcript.hmac_req_context_th_backup);
+            LIBSPDM_ASSERT (
+                spdm_session_info->session_transcript.hmac_req_context_th.base_hash_algo != 0);
+            libspdm_hmac_state_free(&spdm_session_info->session_transcript.hmac_req_context_th_backup);
+            libspdm_hmac_state_duplicate (
+                &spdm_session_info->session_transcript.hmac_req_context_th,
+                &spdm_session_info->session_transcript.hmac_req_context_th_backup);
         }
 
 
         /* prepare digest_context_th*/
 
-        LIBSPDM_ASSERT (spdm_session_info->session_transcript.digest_context_th != NULL);
+        LIBSPDM_ASSERT (spdm_session_info->session_transcript.digest_context_th.hash_nid !=
+                        LIBSPDM_CRYPTO_NID_NULL);
         if (!spdm_session_info->session_transcript.message_f_initialized) {
             if (!spdm_session_info->use_psk && spdm_session_info->mut_auth_requested) {
-                libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                                     spdm_session_info->session_transcript.digest_context_th,
-                                     mut_cert_chain_buffer_hash, hash_size);
+                libspdm_hash_state_update (&spdm_session_info->session_transcript.digest_context_th,
+                                           mut_cert_chain_buffer_hash, hash_size);
             }
         }
-        libspdm_hash_update (spdm_context->connection_info.algorithm.base_hash_algo,
-                             spdm_session_info->session_transcript.digest_context_th, message,
-                             message_size);
+        libspdm_hash_state_update (&spdm_session_info->session_transcript.digest_context_th,
+                                   message, message_size);
 
 
         /* prepare hmac_rsp_context_th*/
 
-        LIBSPDM_ASSERT (spdm_session_info->session_transcript.hmac_rsp_context_th != NULL);
+        LIBSPDM_ASSERT (
+            spdm_session_info->session_transcript.hmac_rsp_context_th.base_hash_algo != 0);
         if (!spdm_session_info->session_transcript.message_f_initialized) {
             if (!spdm_session_info->use_psk && spdm_session_info->mut_auth_requested) {
-                libspdm_hmac_update_with_response_finished_key (secured_message_context,
-                                                                spdm_session_info->session_transcript.hmac_rsp_context_th, mut_cert_chain_buffer_hash,
-                                                                hash_size);
+                libspdm_hmac_state_update (
+                    &spdm_session_info->session_transcript.hmac_rsp_context_th,
+                    mut_cert_chain_buffer_hash, hash_size);
             }
         }
-        libspdm_hmac_update_with_response_finished_key (secured_message_context,
-                                                        spdm_session_info->session_transcript.hmac_rsp_context_th, message,
-                                                        message_size);
+        libspdm_hmac_state_update (&spdm_session_info->session_transcript.hmac_rsp_context_th,
+                                   message, message_size);
 
 
         /* prepare hmac_req_context_th*/
 
-        LIBSPDM_ASSERT (spdm_session_info->session_transcript.hmac_req_context_th != NULL);
+        LIBSPDM_ASSERT (
+            spdm_session_info->session_transcript.hmac_req_context_th.base_hash_algo != 0);
         if (!spdm_session_info->session_transcript.message_f_initialized) {
             if (!spdm_session_info->use_psk && spdm_session_info->mut_auth_requested) {
-                libspdm_hmac_update_with_request_finished_key (secured_message_context,
-                                                               spdm_session_info->session_transcript.hmac_req_context_th, mut_cert_chain_buffer_hash,
-                                                               hash_size);
+                libspdm_hmac_state_update (
+                    &spdm_session_info->session_transcript.hmac_req_context_th,
+                    mut_cert_chain_buffer_hash, hash_size);
             }
         }
-        libspdm_hmac_update_with_request_finished_key (secured_message_context,
-                                                       spdm_session_info->session_transcript.hmac_req_context_th, message,
-                                                       message_size);
+        libspdm_hmac_state_update (&spdm_session_info->session_transcript.hmac_req_context_th,
+                                   message, message_size);
 
         spdm_session_info->session_transcript.message_f_initialized = true;
         return RETURN_SUCCESS;
@@ -1843,6 +1693,47 @@ libspdm_is_capabilities_flag_supported(const libspdm_context_t *spdm_context,
     }
 }
 
+/**
+ * This function returns the largest portion of a certificate chain in one CERTIFICATE response.
+ *
+ * The portion is limited by LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN and
+ * LIBSPDM_DATA_CERT_CHAIN_BLOCK_LEN if the certificate chain is received, and by
+ * LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN if it is sent. The whole CERTIFICATE response, including
+ * the headers in front of the portion, must also fit in the DataTransferSize of the receiver.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  is_receiver                   Indicate if the certificate chain is received or sent.
+ * @param  header_size                   size in bytes of the headers in front of the portion.
+ *
+ * @return the largest portion length, at least 1.
+ **/
+uint16_t libspdm_get_cert_chain_block_len(const libspdm_context_t *spdm_context,
+                                          bool is_receiver, uintn header_size)
+{
+    uintn block_len;
+    uint32_t data_transfer_size;
+
+    if (is_receiver) {
+        block_len = LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN;
+        if (spdm_context->local_context.cert_chain_block_len != 0) {
+            block_len = MIN(block_len, spdm_context->local_context.cert_chain_block_len);
+        }
+        data_transfer_size = spdm_context->local_context.capability.data_transfer_size;
+    } else {
+        block_len = LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN;
+        data_transfer_size = spdm_context->connection_info.capability.data_transfer_size;
+    }
+
+    /* 0 means the DataTransferSize is not known.*/
+    if (data_transfer_size != 0) {
+        if (data_transfer_size <= header_size) {
+            return 1;
+        }
+        block_len = MIN(block_len, data_transfer_size - header_size);
+    }
+    return (uint16_t)block_len;
+}
+
 /**
  * Register SPDM device input/output functions.
  *
@@ -1886,6 +1777,104 @@ void libspdm_register_transport_layer_func(
     return;
 }
 
+/**
+ * Register the memory scope function of an SPDM context.
+ *
+ * This function must be called after libspdm_init_context, and before any SPDM communication.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  memory_scope                  The function to be called on memory scope events.
+ **/
+void libspdm_register_memory_scope_func(void *context,
+                                        libspdm_memory_scope_func memory_scope)
+{
+    libspdm_context_t *spdm_context;
+
+    spdm_context = context;
+    spdm_context->memory_scope = memory_scope;
+}
+
+/**
+ * This function notifies the registered memory scope function of a memory scope event.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_id                    The session ID of the scope, or INVALID_SESSION_ID.
+ * @param  event                         The memory scope event.
+ **/
+void libspdm_notify_memory_scope(libspdm_context_t *spdm_context, uint32_t session_id,
+                                 libspdm_memory_scope_event_t event)
+{
+    if (spdm_context->memory_scope != NULL) {
+        spdm_context->memory_scope(spdm_context, session_id, event);
+    }
+}
+
+/**
+ * Register the trace functions of an SPDM context.
+ *
+ * Without a trace function, a trace point costs one check. If LIBSPDM_TRACE_SUPPORT is 0,
+ * the trace points are compiled out and this function does nothing.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  trace                         The function to be called on trace events, or NULL.
+ * @param  get_time                      The function to get the time stamps of the events.
+ **/
+void libspdm_register_trace_func(void *context, libspdm_trace_func trace,
+                                 libspdm_trace_get_time_func get_time)
+{
+#if LIBSPDM_TRACE_SUPPORT
+    libspdm_context_t *spdm_context;
+
+    spdm_context = context;
+    LIBSPDM_ASSERT((trace == NULL) || (get_time != NULL));
+    spdm_context->trace = trace;
+    spdm_context->trace_get_time = get_time;
+#endif
+}
+
+#if LIBSPDM_TRACE_SUPPORT
+/**
+ * This function returns the start time stamp of a traced phase.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ *
+ * @return the time stamp, or 0 if no trace function is registered.
+ **/
+uint64_t libspdm_trace_begin(libspdm_context_t *spdm_context)
+{
+    if (spdm_context->trace == NULL) {
+        return 0;
+    }
+    return spdm_context->trace_get_time();
+}
+
+/**
+ * This function emits the trace event of a phase to the registered trace function.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  phase                         The phase.
+ * @param  session_id                    The session ID, or INVALID_SESSION_ID.
+ * @param  size                          The size in bytes of the message, or 0.
+ * @param  start_time                    The time stamp returned by libspdm_trace_begin.
+ **/
+void libspdm_trace_end(libspdm_context_t *spdm_context, libspdm_trace_phase_t phase,
+                       uint32_t session_id, uintn size, uint64_t start_time)
+{
+    libspdm_trace_event_t event;
+
+    if (spdm_context->trace == NULL) {
+        return;
+    }
+    event.phase = phase;
+    event.request_code = spdm_context->trace_request_code;
+    event.session_id = session_id;
+    event.size = size;
+    event.start_time = start_time;
+    event.end_time = spdm_context->trace_get_time();
+    spdm_context->trace(spdm_context, &event);
+}
+#endif
+
 /**
  * Get the last error of an SPDM context.
  *
@@ -1933,10 +1922,77 @@ void libspdm_set_last_spdm_error_struct(void *context,
                      last_spdm_error, sizeof(libspdm_error_struct_t));
 }
 
+/* Offsets of the buffers laid out after libspdm_context_t.*/
+typedef struct {
+    uintn session_info_offset;
+    uintn secured_message_context_offset;
+    uintn last_spdm_request_offset;
+    uintn cache_spdm_request_offset;
+    uintn request_response_offset;
+    uintn certificate_chain_buffer_offset;
+    uintn context_size;
+} libspdm_context_layout_t;
+
+#define LIBSPDM_CONTEXT_ALIGN(size) \
+    (((size) + sizeof(uint64_t) - 1) & ~((uintn)sizeof(uint64_t) - 1))
+
+/**
+ * Return the context configuration with the LIBSPDM_MAX_* sizes.
+ *
+ * @param  config                        On output, the configuration.
+ **/
+static void libspdm_get_default_context_config(libspdm_context_config_t *config)
+{
+    config->max_message_size = LIBSPDM_MAX_MESSAGE_BUFFER_SIZE;
+    config->max_session_count = LIBSPDM_MAX_SESSION_COUNT;
+    config->max_cert_chain_size = LIBSPDM_MAX_MESSAGE_BUFFER_SIZE;
+}
+
+/**
+ * Compute where the buffers of an SPDM context are laid out.
+ *
+ * @param  config                        The configuration of the context.
+ * @param  layout                        On output, the offsets of the buffers.
+ *
+ * @retval true   the layout is computed.
+ * @retval false  the configuration is out of the LIBSPDM_MAX_* bounds.
+ **/
+static bool libspdm_get_context_layout(const libspdm_context_config_t *config,
+                                       libspdm_context_layout_t *layout)
+{
+    uintn offset;
+
+    if ((config->max_message_size < SPDM_MIN_DATA_TRANSFER_SIZE_VERSION_12) ||
+        (config->max_message_size > LIBSPDM_MAX_MESSAGE_BUFFER_SIZE) ||
+        (config->max_session_count > LIBSPDM_MAX_SESSION_COUNT) ||
+        (config->max_cert_chain_size > LIBSPDM_MAX_MESSAGE_BUFFER_SIZE)) {
+        return false;
+    }
+
+    offset = LIBSPDM_CONTEXT_ALIGN(sizeof(libspdm_context_t));
+    layout->session_info_offset = offset;
+    offset += LIBSPDM_CONTEXT_ALIGN(sizeof(libspdm_session_info_t) * config->max_session_count);
+    layout->secured_message_context_offset = offset;
+    offset += LIBSPDM_CONTEXT_ALIGN(libspdm_secured_message_get_context_size()) *
+              config->max_session_count;
+    layout->last_spdm_request_offset = offset;
+    offset += LIBSPDM_CONTEXT_ALIGN(config->max_message_size);
+    layout->cache_spdm_request_offset = offset;
+    offset += LIBSPDM_CONTEXT_ALIGN(config->max_message_size);
+    layout->request_response_offset = offset;
+    offset += LIBSPDM_CONTEXT_ALIGN(config->max_message_size);
+    layout->certificate_chain_buffer_offset = offset;
+    offset += LIBSPDM_CONTEXT_ALIGN(sizeof(libspdm_managed_buffer_t) +
+                                    config->max_cert_chain_size);
+    layout->context_size = offset;
+    return true;
+}
+
 /**
  * Initialize an SPDM context.
  *
  * The size in bytes of the spdm_context can be returned by libspdm_get_context_size.
+ * The context is laid out with the LIBSPDM_MAX_* sizes, see libspdm_init_context_ex.
  *
  * @param  spdm_context                  A pointer to the SPDM context.
  *
@@ -1944,15 +2000,58 @@ void libspdm_set_last_spdm_error_struct(void *context,
  * @retval RETURN_DEVICE_ERROR  context initialization failed.
  */
 return_status libspdm_init_context(void *context)
+{
+    libspdm_context_config_t config;
+
+    libspdm_get_default_context_config(&config);
+    return libspdm_init_context_ex(context, libspdm_get_context_size(), &config);
+}
+
+/**
+ * Initialize an SPDM context in a caller provided buffer.
+ *
+ * The message, session and certificate chain buffers of the context are laid out in the same
+ * buffer, after the context itself, with the sizes of the configuration.
+ * The size in bytes of the buffer can be returned by libspdm_get_context_size_ex.
+ *
+ * @param  spdm_context                  A pointer to the buffer of the SPDM context.
+ * @param  context_size                  The size in bytes of the buffer.
+ * @param  config                        The configuration of the context.
+ *
+ * @retval RETURN_SUCCESS               context is initialized.
+ * @retval RETURN_INVALID_PARAMETER     The configuration is out of the LIBSPDM_MAX_* bounds.
+ * @retval RETURN_BUFFER_TOO_SMALL      context_size is smaller than libspdm_get_context_size_ex.
+ * @retval RETURN_DEVICE_ERROR          context initialization failed.
+ */
+return_status libspdm_init_context_ex(void *context, uintn context_size,
+                                      const libspdm_context_config_t *config)
 {
     libspdm_context_t *spdm_context;
+    libspdm_context_layout_t layout;
     void *secured_message_context;
     uintn SecuredMessageContextSize;
     uintn index;
 
+    if ((context == NULL) || (config == NULL) ||
+        !libspdm_get_context_layout(config, &layout)) {
+        return RETURN_INVALID_PARAMETER;
+    }
+    if (context_size < layout.context_size) {
+        return RETURN_BUFFER_TOO_SMALL;
+    }
+
     spdm_context = context;
-    libspdm_zero_mem(spdm_context, sizeof(libspdm_context_t));
+    libspdm_zero_mem(spdm_context, layout.context_size);
     spdm_context->version = libspdm_context_struct_version;
+    spdm_context->config = *config;
+    spdm_context->context_size = layout.context_size;
+    spdm_context->session_info =
+        (void *)((uint8_t *)spdm_context + layout.session_info_offset);
+    spdm_context->last_spdm_request = (uint8_t *)spdm_context + layout.last_spdm_request_offset;
+    spdm_context->cache_spdm_request = (uint8_t *)spdm_context + layout.cache_spdm_request_offset;
+    spdm_context->request_response = (uint8_t *)spdm_context + layout.request_response_offset;
+    spdm_context->encap_context.certificate_chain_buffer =
+        (void *)((uint8_t *)spdm_context + layout.certificate_chain_buffer_offset);
     spdm_context->transcript.message_a.max_buffer_size =
         sizeof(spdm_context->transcript.message_a.buffer);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
@@ -1983,21 +2082,25 @@ return_status libspdm_init_context(void *context)
         SPDM_MESSAGE_VERSION_10 << SPDM_VERSION_NUMBER_SHIFT_BIT;
     spdm_context->local_context.capability.st1 = SPDM_ST1_VALUE_US;
 
-    spdm_context->encap_context.certificate_chain_buffer.max_buffer_size =
-        sizeof(spdm_context->encap_context.certificate_chain_buffer.buffer);
+    spdm_context->encap_context.certificate_chain_buffer->max_buffer_size =
+        config->max_cert_chain_size;
 
-    /* From the config.h, need different value for CHUNK - TBD*/
-    spdm_context->local_context.capability.data_transfer_size = LIBSPDM_MAX_MESSAGE_BUFFER_SIZE;
-    spdm_context->local_context.capability.max_spdm_msg_size = LIBSPDM_MAX_MESSAGE_BUFFER_SIZE;
+    /* Need different value for CHUNK - TBD*/
+    spdm_context->local_context.capability.data_transfer_size = config->max_message_size;
+    spdm_context->local_context.capability.max_spdm_msg_size = config->max_message_size;
 
 #if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     spdm_context->connection_info.peer_used_cert_chain_buffer_hash_size = 0;
     spdm_context->connection_info.peer_used_leaf_cert_public_key = NULL;
 #endif
-
-    secured_message_context = (void *)((uintn)(spdm_context + 1));
-    SecuredMessageContextSize = libspdm_secured_message_get_context_size();
-    for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++) {
+    spdm_context->connection_info.peer_used_cert_chain_slot_id =
+        LIBSPDM_PEER_CERT_CHAIN_SLOT_ID_UNKNOWN;
+
+    secured_message_context =
+        (void *)((uint8_t *)spdm_context + layout.secured_message_context_offset);
+    SecuredMessageContextSize =
+        LIBSPDM_CONTEXT_ALIGN(libspdm_secured_message_get_context_size());
+    for (index = 0; index < config->max_session_count; index++) {
         spdm_context->session_info[index].secured_message_context =
             (void *)((uintn)secured_message_context +
                      SecuredMessageContextSize * index);
@@ -2017,6 +2120,79 @@ return_status libspdm_init_context(void *context)
     return RETURN_SUCCESS;
 }
 
+
+/**
+ * Allocate and initialize an SPDM context.
+ *
+ * The context and all its buffers are allocated at once with allocate_func,
+ * see libspdm_init_context_ex. The context is freed with libspdm_free_context.
+ *
+ * @param  config                        The configuration of the context.
+ * @param  allocate_func                 The function to allocate the context.
+ * @param  free_func                     The function to free the context.
+ * @param  spdm_context                  On output, a pointer to the SPDM context.
+ *
+ * @retval RETURN_SUCCESS               context is allocated and initialized.
+ * @retval RETURN_INVALID_PARAMETER     The configuration is out of the LIBSPDM_MAX_* bounds.
+ * @retval RETURN_OUT_OF_RESOURCES      allocate_func failed.
+ * @retval RETURN_DEVICE_ERROR          context initialization failed.
+ */
+return_status libspdm_allocate_context(const libspdm_context_config_t *config,
+                                       libspdm_context_allocate_func allocate_func,
+                                       libspdm_context_free_func free_func,
+                                       void **context)
+{
+    libspdm_context_t *spdm_context;
+    uintn context_size;
+    return_status status;
+
+    if ((config == NULL) || (allocate_func == NULL) || (free_func == NULL) ||
+        (context == NULL)) {
+        return RETURN_INVALID_PARAMETER;
+    }
+    context_size = libspdm_get_context_size_ex(config);
+    if (context_size == 0) {
+        return RETURN_INVALID_PARAMETER;
+    }
+    spdm_context = allocate_func(context_size);
+    if (spdm_context == NULL) {
+        return RETURN_OUT_OF_RESOURCES;
+    }
+    status = libspdm_init_context_ex(spdm_context, context_size, config);
+    if (RETURN_ERROR(status)) {
+        libspdm_zero_mem(spdm_context, context_size);
+        free_func(spdm_context);
+        return status;
+    }
+    spdm_context->free_func = free_func;
+    *context = spdm_context;
+    return RETURN_SUCCESS;
+}
+
+/**
+ * Zero and free an SPDM context allocated by libspdm_allocate_context.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ */
+void libspdm_free_context(void *context)
+{
+    libspdm_context_t *spdm_context;
+    libspdm_context_free_func free_func;
+
+    spdm_context = context;
+    if (spdm_context == NULL) {
+        return;
+    }
+    free_func = spdm_context->free_func;
+    LIBSPDM_ASSERT(free_func != NULL);
+    if (free_func == NULL) {
+        return;
+    }
+    /* The session keys are in the context.*/
+    libspdm_zero_mem(spdm_context, spdm_context->context_size);
+    free_func(spdm_context);
+}
+
 /**
  * Reset an SPDM context.
  *
@@ -2027,6 +2203,7 @@ return_status libspdm_init_context(void *context)
 void libspdm_reset_context(void *context)
 {
     libspdm_context_t *spdm_context;
+    libspdm_managed_buffer_t *certificate_chain_buffer;
     uintn index;
 
     spdm_context = context;
@@ -2036,7 +2213,9 @@ void libspdm_reset_context(void *context)
                      sizeof(libspdm_device_capability_t));
     libspdm_zero_mem(&spdm_context->connection_info.algorithm, sizeof(libspdm_device_algorithm_t));
     libspdm_zero_mem(&spdm_context->last_spdm_error, sizeof(libspdm_error_struct_t));
+    certificate_chain_buffer = spdm_context->encap_context.certificate_chain_buffer;
     libspdm_zero_mem(&spdm_context->encap_context, sizeof(libspdm_encap_context_t));
+    spdm_context->encap_context.certificate_chain_buffer = certificate_chain_buffer;
     spdm_context->connection_info.local_used_cert_chain_buffer_size = 0;
     spdm_context->connection_info.local_used_cert_chain_buffer = NULL;
     spdm_context->cache_spdm_request_size = 0;
@@ -2046,16 +2225,39 @@ void libspdm_reset_context(void *context)
     spdm_context->last_spdm_request_session_id = INVALID_SESSION_ID;
     spdm_context->last_spdm_request_session_id_valid = false;
     spdm_context->last_spdm_request_size = 0;
-    spdm_context->encap_context.certificate_chain_buffer.max_buffer_size =
-        sizeof(spdm_context->encap_context.certificate_chain_buffer.buffer);
-    for (index = 0; index < LIBSPDM_MAX_SESSION_COUNT; index++)
+    certificate_chain_buffer->max_buffer_size = spdm_context->config.max_cert_chain_size;
+    certificate_chain_buffer->buffer_size = 0;
+    for (index = 0; index < spdm_context->config.max_session_count; index++)
     {
         libspdm_session_info_init(spdm_context,
                                   &spdm_context->session_info[index],
                                   INVALID_SESSION_ID,
                                   false);
     }
+#if LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT
+    libspdm_invalidate_peer_measurement_cache(spdm_context);
+#endif
 }
+
+#if LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT
+/**
+ * Drop the cached measurements of the peer.
+ *
+ * The generation keeps counting, so every block of the next cached measurement record
+ * is reported as changed since any earlier generation.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ **/
+void libspdm_invalidate_peer_measurement_cache(libspdm_context_t *spdm_context)
+{
+    libspdm_peer_measurement_cache_t *cache;
+
+    cache = &spdm_context->peer_measurement_cache;
+    cache->measurement_count = 0;
+    cache->measurement_record_size = 0;
+    cache->base_generation = cache->generation + 1;
+}
+#endif
 /**
  * Return the size in bytes of the SPDM context.
  *
@@ -2063,8 +2265,28 @@ void libspdm_reset_context(void *context)
  **/
 uintn libspdm_get_context_size(void)
 {
-    return sizeof(libspdm_context_t) +
-           libspdm_secured_message_get_context_size() * LIBSPDM_MAX_SESSION_COUNT;
+    libspdm_context_config_t config;
+
+    libspdm_get_default_context_config(&config);
+    return libspdm_get_context_size_ex(&config);
+}
+
+/**
+ * Return the size in bytes of an SPDM context and of its buffers.
+ *
+ * @param  config                        The configuration of the context.
+ *
+ * @return the size in bytes of the SPDM context, or 0 if the configuration is out of the
+ *         LIBSPDM_MAX_* bounds.
+ **/
+uintn libspdm_get_context_size_ex(const libspdm_context_config_t *config)
+{
+    libspdm_context_layout_t layout;
+
+    if ((config == NULL) || !libspdm_get_context_layout(config, &layout)) {
+        return 0;
+    }
+    return layout.context_size;
 }
 
 /**
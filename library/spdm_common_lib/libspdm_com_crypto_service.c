@@ -81,6 +81,69 @@ bool libspdm_get_peer_cert_chain_data(void *context,
     return true;
 }
 
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+/**
+ * This function builds the certificate index of the peer used certificate chain buffer.
+ *
+ * It must be called whenever peer_used_cert_chain_buffer is updated after the algorithm negotiation.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ **/
+void libspdm_build_peer_used_cert_chain_index(libspdm_context_t *spdm_context)
+{
+    uintn hash_size;
+    uintn header_size;
+
+    hash_size = libspdm_get_hash_size(
+        spdm_context->connection_info.algorithm.base_hash_algo);
+    header_size = sizeof(spdm_cert_chain_t) + hash_size;
+
+    if (spdm_context->connection_info.peer_used_cert_chain_buffer_size <= header_size) {
+        spdm_context->connection_info.peer_used_cert_chain_index.cert_count = 0;
+        return;
+    }
+    libspdm_build_cert_chain_index(
+        spdm_context->connection_info.peer_used_cert_chain_buffer + header_size,
+        spdm_context->connection_info.peer_used_cert_chain_buffer_size - header_size,
+        &spdm_context->connection_info.peer_used_cert_chain_index);
+}
+#endif
+
+/**
+ * This function returns the leaf certificate of the peer certificate chain.
+ *
+ * The peer used certificate chain is looked up through its certificate index,
+ * the provisioned peer certificate chain is walked.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  leaf_cert                     The leaf certificate in the peer certificate chain.
+ * @param  leaf_cert_size                size in bytes of the leaf certificate.
+ *
+ * @retval true  The leaf certificate is returned.
+ * @retval false The leaf certificate is not found.
+ **/
+bool libspdm_get_peer_leaf_cert(libspdm_context_t *spdm_context,
+                                uint8_t **leaf_cert, uintn *leaf_cert_size)
+{
+    uint8_t *cert_chain_data;
+    uintn cert_chain_data_size;
+
+    if (!libspdm_get_peer_cert_chain_data(spdm_context, (void **)&cert_chain_data,
+                                          &cert_chain_data_size)) {
+        return false;
+    }
+
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    if (spdm_context->connection_info.peer_used_cert_chain_buffer_size != 0) {
+        return libspdm_get_cert_from_cert_chain_index(
+            &spdm_context->connection_info.peer_used_cert_chain_index,
+            cert_chain_data, cert_chain_data_size, -1, leaf_cert, leaf_cert_size);
+    }
+#endif
+    return libspdm_x509_get_cert_from_cert_chain(cert_chain_data, cert_chain_data_size, -1,
+                                                 leaf_cert, leaf_cert_size);
+}
+
 /**
  * This function returns local used certificate chain buffer including spdm_cert_chain_t header.
  *
@@ -309,8 +372,8 @@ bool libspdm_calculate_m1m2_hash(void *context, bool is_mut,
         spdm_context->connection_info.algorithm.base_hash_algo);
 
     if (is_mut) {
-        result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
-                                     spdm_context->transcript.digest_context_mut_m1m2, m1m2_hash);
+        result = libspdm_hash_state_final (&spdm_context->transcript.digest_context_mut_m1m2,
+                                           m1m2_hash);
         if (!result) {
             return false;
         }
@@ -319,8 +382,8 @@ bool libspdm_calculate_m1m2_hash(void *context, bool is_mut,
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
 
     } else {
-        result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
-                                     spdm_context->transcript.digest_context_m1m2, m1m2_hash);
+        result = libspdm_hash_state_final (&spdm_context->transcript.digest_context_m1m2,
+                                           m1m2_hash);
         if (!result) {
             return false;
         }
@@ -464,13 +527,12 @@ bool libspdm_calculate_l1l2_hash(void *context, void *session_info,
         spdm_context->connection_info.algorithm.base_hash_algo);
 
     if (spdm_session_info == NULL) {
-        result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
-                                     spdm_context->transcript.digest_context_l1l2, l1l2_hash);
+        result = libspdm_hash_state_final (&spdm_context->transcript.digest_context_l1l2,
+                                           l1l2_hash);
     } else {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "use message_m in session :\n"));
-        result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
-                                     spdm_session_info->session_transcript.digest_context_l1l2,
-                                     l1l2_hash);
+        result = libspdm_hash_state_final (
+            &spdm_session_info->session_transcript.digest_context_l1l2, l1l2_hash);
     }
     if (!result) {
         return false;
@@ -488,6 +550,9 @@ bool libspdm_calculate_l1l2_hash(void *context, void *session_info,
 /**
  * This function generates the certificate chain hash.
  *
+ * The hash of each slot is cached in the local context, so it is computed once per
+ * provisioned certificate chain and negotiated hash algorithm.
+ *
  * @param  spdm_context                  A pointer to the SPDM context.
  * @param  slot_id                    The slot index of the certificate chain.
  * @param  signature                    The buffer to store the certificate chain hash.
@@ -498,13 +563,37 @@ bool libspdm_calculate_l1l2_hash(void *context, void *session_info,
 bool libspdm_generate_cert_chain_hash(libspdm_context_t *spdm_context,
                                       uintn slot_id, uint8_t *hash)
 {
+    libspdm_cert_chain_hash_cache_t *cache;
+    uint32_t base_hash_algo;
+    uintn hash_size;
+
     LIBSPDM_ASSERT(slot_id < spdm_context->local_context.slot_count);
-    return libspdm_hash_all(
-        spdm_context->connection_info.algorithm.base_hash_algo,
-        spdm_context->local_context.local_cert_chain_provision[slot_id],
-        spdm_context->local_context
-        .local_cert_chain_provision_size[slot_id],
-        hash);
+    base_hash_algo = spdm_context->connection_info.algorithm.base_hash_algo;
+    hash_size = libspdm_get_hash_size(base_hash_algo);
+    cache = &spdm_context->local_context.local_cert_chain_hash[slot_id];
+
+    if ((cache->base_hash_algo != base_hash_algo) ||
+        (cache->cert_chain !=
+         spdm_context->local_context.local_cert_chain_provision[slot_id]) ||
+        (cache->cert_chain_size !=
+         spdm_context->local_context.local_cert_chain_provision_size[slot_id])) {
+        libspdm_zero_mem(cache, sizeof(libspdm_cert_chain_hash_cache_t));
+        if (!libspdm_hash_all(
+                base_hash_algo,
+                spdm_context->local_context.local_cert_chain_provision[slot_id],
+                spdm_context->local_context
+                .local_cert_chain_provision_size[slot_id],
+                cache->hash)) {
+            return false;
+        }
+        cache->base_hash_algo = base_hash_algo;
+        cache->cert_chain = spdm_context->local_context.local_cert_chain_provision[slot_id];
+        cache->cert_chain_size =
+            spdm_context->local_context.local_cert_chain_provision_size[slot_id];
+    }
+
+    libspdm_copy_mem(hash, hash_size, cache->hash, hash_size);
+    return true;
 }
 
 /**
@@ -565,6 +654,52 @@ bool libspdm_verify_peer_digests(libspdm_context_t *spdm_context,
     return true;
 }
 
+/**
+ * This function finds the provisioned root certificate of a root hash.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  root_hash                     The root hash of a peer certificate chain.
+ * @param  root_cert                     The provisioned root certificate.
+ * @param  root_cert_size                size in bytes of the provisioned root certificate.
+ *
+ * @retval true  A provisioned root certificate matches the root hash.
+ * @retval false No provisioned root certificate matches the root hash.
+ **/
+static bool libspdm_find_peer_root_cert(libspdm_context_t *spdm_context,
+                                        const uint8_t *root_hash,
+                                        uint8_t **root_cert, uintn *root_cert_size)
+{
+    uint8_t root_cert_hash[LIBSPDM_MAX_HASH_SIZE];
+    uintn root_cert_hash_size;
+    uint8_t root_cert_index;
+
+    root_cert_hash_size = libspdm_get_hash_size(
+        spdm_context->connection_info.algorithm.base_hash_algo);
+
+    for (root_cert_index = 0; root_cert_index < LIBSPDM_MAX_ROOT_CERT_SUPPORT;
+         root_cert_index++) {
+        *root_cert = spdm_context->local_context.peer_root_cert_provision[root_cert_index];
+        *root_cert_size =
+            spdm_context->local_context.peer_root_cert_provision_size[root_cert_index];
+        if ((*root_cert == NULL) || (*root_cert_size == 0)) {
+            break;
+        }
+        if (!libspdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+                              *root_cert, *root_cert_size, root_cert_hash)) {
+            LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                           "!!! verify_peer_cert_chain_buffer - FAIL (hash calculation) !!!\n"));
+            return false;
+        }
+        if (libspdm_const_compare_mem(root_hash, root_cert_hash, root_cert_hash_size) == 0) {
+            return true;
+        }
+    }
+
+    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                   "!!! verify_peer_cert_chain_buffer - FAIL (all root cert hash mismatch) !!!\n"));
+    return false;
+}
+
 /**
  * This function verifies peer certificate chain buffer including spdm_cert_chain_t header.
  *
@@ -589,12 +724,10 @@ bool libspdm_verify_peer_cert_chain_buffer(libspdm_context_t *spdm_context,
     uintn cert_chain_data_size;
     uint8_t *root_cert;
     uintn root_cert_size;
-    uint8_t root_cert_hash[LIBSPDM_MAX_HASH_SIZE];
     uintn root_cert_hash_size;
     uint8_t *received_root_cert;
     uintn received_root_cert_size;
     bool result;
-    uint8_t root_cert_index;
     bool is_device_cert_model;
 
     if((spdm_context->connection_info.capability.flags &
@@ -619,10 +752,8 @@ bool libspdm_verify_peer_cert_chain_buffer(libspdm_context_t *spdm_context,
         return false;
     }
 
-    root_cert_index = 0;
-    root_cert = spdm_context->local_context.peer_root_cert_provision[root_cert_index];
-    root_cert_size =
-        spdm_context->local_context.peer_root_cert_provision_size[root_cert_index];
+    root_cert = spdm_context->local_context.peer_root_cert_provision[0];
+    root_cert_size = spdm_context->local_context.peer_root_cert_provision_size[0];
     cert_chain_data = spdm_context->local_context.peer_cert_chain_provision;
     cert_chain_data_size =
         spdm_context->local_context.peer_cert_chain_provision_size;
@@ -631,31 +762,11 @@ bool libspdm_verify_peer_cert_chain_buffer(libspdm_context_t *spdm_context,
         spdm_context->connection_info.algorithm.base_hash_algo);
 
     if ((root_cert != NULL) && (root_cert_size != 0)) {
-        while ((root_cert != NULL) && (root_cert_size != 0)) {
-            result = libspdm_hash_all(
-                spdm_context->connection_info.algorithm.base_hash_algo,
-                root_cert, root_cert_size, root_cert_hash);
-            if (!result) {
-                LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
-                               "!!! verify_peer_cert_chain_buffer - FAIL (hash calculation) !!!\n"));
-                return false;
-            }
-
-            if (libspdm_const_compare_mem((uint8_t *)cert_chain_buffer + sizeof(spdm_cert_chain_t),
-                                          root_cert_hash, root_cert_hash_size) == 0) {
-                break;
-            } else if ((root_cert_index < (LIBSPDM_MAX_ROOT_CERT_SUPPORT - 1)) &&
-                       (spdm_context->local_context.peer_root_cert_provision[root_cert_index + 1] !=
-                        NULL)) {
-                root_cert_index++;
-                root_cert = spdm_context->local_context.peer_root_cert_provision[root_cert_index];
-                root_cert_size =
-                    spdm_context->local_context.peer_root_cert_provision_size[root_cert_index];
-            } else {
-                LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
-                               "!!! verify_peer_cert_chain_buffer - FAIL (all root cert hash mismatch) !!!\n"));
-                return false;
-            }
+        if (!libspdm_find_peer_root_cert(spdm_context,
+                                         (const uint8_t *)cert_chain_buffer +
+                                         sizeof(spdm_cert_chain_t),
+                                         &root_cert, &root_cert_size)) {
+            return false;
         }
 
         result = libspdm_x509_get_cert_from_cert_chain(
@@ -719,6 +830,167 @@ bool libspdm_verify_peer_cert_chain_buffer(libspdm_context_t *spdm_context,
     return true;
 }
 
+/**
+ * This function starts the verification of a peer certificate chain buffer including
+ * spdm_cert_chain_t header, while it is received.
+ *
+ * The stream runs the checks of libspdm_verify_peer_cert_chain_buffer() as the portions
+ * are appended with libspdm_verify_peer_cert_chain_stream_update(), so the verification
+ * stops at the first invalid certificate.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  stream                        The certificate chain stream.
+ * @param  verify                        If false, the certificates are only split and hashed.
+ * @param  is_requester                  Indicates if it is a requester message.
+ *
+ * @retval true  the stream is initialized.
+ * @retval false the stream initialization fails.
+ **/
+bool libspdm_verify_peer_cert_chain_stream_init(libspdm_context_t *spdm_context,
+                                                libspdm_cert_chain_stream_t *stream,
+                                                bool verify, bool is_requester)
+{
+    uint32_t base_asym_algo;
+    bool is_device_cert_model;
+
+    if((spdm_context->connection_info.capability.flags &
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ALIAS_CERT_CAP) == 0) {
+        is_device_cert_model = true;
+    } else {
+        is_device_cert_model = false;
+    }
+    if (is_requester) {
+        base_asym_algo = spdm_context->connection_info.algorithm.base_asym_algo;
+    } else {
+        base_asym_algo = spdm_context->connection_info.algorithm.req_base_asym_alg;
+    }
+
+    return libspdm_cert_chain_stream_init(
+        stream, spdm_context->connection_info.algorithm.base_hash_algo, base_asym_algo,
+        is_device_cert_model, verify);
+}
+
+/**
+ * This function appends the next portion of a peer certificate chain buffer to the stream.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  stream                        The certificate chain stream.
+ * @param  data                          The next portion of the certificate chain buffer.
+ * @param  data_size                     size in bytes of the portion.
+ *
+ * @retval true  the portion is appended, and all complete certificates are verified.
+ * @retval false the certificate chain is not trusted.
+ **/
+bool libspdm_verify_peer_cert_chain_stream_update(libspdm_context_t *spdm_context,
+                                                  libspdm_cert_chain_stream_t *stream,
+                                                  const void *data, uintn data_size)
+{
+    const uint8_t *ptr;
+    uintn header_size;
+    uintn copy_size;
+    uint8_t *cert_chain_data;
+    uintn cert_chain_data_size;
+
+    if (!stream->verify) {
+        return libspdm_cert_chain_stream_update(stream, data, data_size);
+    }
+
+    ptr = data;
+    cert_chain_data = spdm_context->local_context.peer_cert_chain_provision;
+    cert_chain_data_size = spdm_context->local_context.peer_cert_chain_provision_size;
+    header_size = sizeof(spdm_cert_chain_t) +
+                  libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+
+    if ((spdm_context->local_context.peer_root_cert_provision[0] != NULL) &&
+        (spdm_context->local_context.peer_root_cert_provision_size[0] != 0)) {
+        /* The trust anchor is selected by the root hash, before the first certificate.*/
+        if (stream->received_size < header_size) {
+            copy_size = MIN(data_size, header_size - stream->received_size);
+            if (!libspdm_cert_chain_stream_update(stream, ptr, copy_size)) {
+                return false;
+            }
+            ptr += copy_size;
+            data_size -= copy_size;
+            if ((stream->received_size == header_size) &&
+                !libspdm_find_peer_root_cert(spdm_context,
+                                             stream->header + sizeof(spdm_cert_chain_t),
+                                             (uint8_t **)&stream->trust_anchor,
+                                             &stream->trust_anchor_size)) {
+                return false;
+            }
+        }
+    } else if ((cert_chain_data != NULL) && (cert_chain_data_size != 0)) {
+        /* The chain must be equal to the one provisioned in trusted environment.*/
+        if ((stream->received_size + data_size > cert_chain_data_size) ||
+            (libspdm_const_compare_mem(cert_chain_data + stream->received_size, ptr,
+                                       data_size) != 0)) {
+            LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                           "!!! verify_peer_cert_chain_buffer - FAIL !!!\n"));
+            return false;
+        }
+    }
+
+    return libspdm_cert_chain_stream_update(stream, ptr, data_size);
+}
+
+/**
+ * This function completes the verification of a peer certificate chain buffer,
+ * and releases the stream.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  stream                        The certificate chain stream.
+ * @param  cert_chain_hash               The hash of the certificate chain buffer.
+ * @param  trust_anchor                  A buffer to hold the trust_anchor which is used to validate the peer certificate, if not NULL.
+ * @param  trust_anchor_size             A buffer to hold the trust_anchor_size, if not NULL.
+ *
+ * @retval true  Peer certificate chain buffer verification passed.
+ * @retval false Peer certificate chain buffer verification failed.
+ **/
+bool libspdm_verify_peer_cert_chain_stream_final(libspdm_context_t *spdm_context,
+                                                 libspdm_cert_chain_stream_t *stream,
+                                                 uint8_t *cert_chain_hash,
+                                                 void **trust_anchor,
+                                                 uintn *trust_anchor_size)
+{
+    uint8_t *cert_chain_data;
+    uintn cert_chain_data_size;
+
+    if (!libspdm_cert_chain_stream_final(stream, cert_chain_hash)) {
+        return false;
+    }
+    if (!stream->verify) {
+        return true;
+    }
+
+    cert_chain_data = spdm_context->local_context.peer_cert_chain_provision;
+    cert_chain_data_size = spdm_context->local_context.peer_cert_chain_provision_size;
+    if (stream->trust_anchor != NULL) {
+        if (trust_anchor != NULL) {
+            *trust_anchor = (void *)stream->trust_anchor;
+        }
+        if (trust_anchor_size != NULL) {
+            *trust_anchor_size = stream->trust_anchor_size;
+        }
+    } else if ((cert_chain_data != NULL) && (cert_chain_data_size != 0)) {
+        if (stream->received_size != cert_chain_data_size) {
+            LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                           "!!! verify_peer_cert_chain_buffer - FAIL !!!\n"));
+            return false;
+        }
+        if (trust_anchor != NULL) {
+            *trust_anchor = cert_chain_data + sizeof(spdm_cert_chain_t) +
+                            libspdm_get_hash_size(
+                spdm_context->connection_info.algorithm.base_hash_algo);
+        }
+        if (trust_anchor_size != NULL) {
+            *trust_anchor_size = cert_chain_data_size;
+        }
+    }
+    LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "!!! verify_peer_cert_chain_buffer - PASS !!!\n"));
+
+    return true;
+}
+
 /**
  * This function generates the challenge signature based upon m1m2 for authentication.
  *
@@ -925,8 +1197,6 @@ bool libspdm_verify_challenge_auth_signature(libspdm_context_t *spdm_context,
     uint8_t *cert_buffer;
     uintn cert_buffer_size;
     void *context;
-    uint8_t *cert_chain_data;
-    uintn cert_chain_data_size;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     uint8_t m1m2_buffer[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
     uintn m1m2_buffer_size;
@@ -949,16 +1219,8 @@ bool libspdm_verify_challenge_auth_signature(libspdm_context_t *spdm_context,
     }
 
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    result = libspdm_get_peer_cert_chain_data(
-        spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
-    if (!result) {
-        return false;
-    }
-
     /* Get leaf cert from cert chain*/
-    result = libspdm_x509_get_cert_from_cert_chain(cert_chain_data,
-                                                   cert_chain_data_size, -1,
-                                                   &cert_buffer, &cert_buffer_size);
+    result = libspdm_get_peer_leaf_cert(spdm_context, &cert_buffer, &cert_buffer_size);
     if (!result) {
         return false;
     }
@@ -1037,18 +1299,8 @@ bool libspdm_verify_challenge_auth_signature(libspdm_context_t *spdm_context,
         }
     }
 
-    result = libspdm_get_peer_cert_chain_data(
-        spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
-    if (!result) {
-        return false;
-    }
-
-
     /* Get leaf cert from cert chain*/
-
-    result = libspdm_x509_get_cert_from_cert_chain(cert_chain_data,
-                                                   cert_chain_data_size, -1,
-                                                   &cert_buffer, &cert_buffer_size);
+    result = libspdm_get_peer_leaf_cert(spdm_context, &cert_buffer, &cert_buffer_size);
     if (!result) {
         return false;
     }
@@ -1218,8 +1470,6 @@ bool libspdm_verify_measurement_signature(libspdm_context_t *spdm_context,
     uint8_t *cert_buffer;
     uintn cert_buffer_size;
     void *context;
-    uint8_t *cert_chain_data;
-    uintn cert_chain_data_size;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     uint8_t l1l2_buffer[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
     uintn l1l2_buffer_size;
@@ -1242,16 +1492,8 @@ bool libspdm_verify_measurement_signature(libspdm_context_t *spdm_context,
     }
 
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    result = libspdm_get_peer_cert_chain_data(
-        spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
-    if (!result) {
-        return false;
-    }
-
     /* Get leaf cert from cert chain*/
-    result = libspdm_x509_get_cert_from_cert_chain(cert_chain_data,
-                                                   cert_chain_data_size, -1,
-                                                   &cert_buffer, &cert_buffer_size);
+    result = libspdm_get_peer_leaf_cert(spdm_context, &cert_buffer, &cert_buffer_size);
     if (!result) {
         return false;
     }
@@ -1288,18 +1530,8 @@ bool libspdm_verify_measurement_signature(libspdm_context_t *spdm_context,
         return true;
     }
 
-    result = libspdm_get_peer_cert_chain_data(
-        spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
-    if (!result) {
-        return false;
-    }
-
-
     /* Get leaf cert from cert chain*/
-
-    result = libspdm_x509_get_cert_from_cert_chain(cert_chain_data,
-                                                   cert_chain_data_size, -1,
-                                                   &cert_buffer, &cert_buffer_size);
+    result = libspdm_get_peer_leaf_cert(spdm_context, &cert_buffer, &cert_buffer_size);
     if (!result) {
         return false;
     }
@@ -110,7 +110,6 @@ bool libspdm_calculate_th_hash_for_exchange(
     libspdm_context_t *spdm_context;
     libspdm_session_info_t *session_info;
     uint32_t hash_size;
-    void *digest_context_th;
     bool result;
 
     spdm_context = context;
@@ -121,23 +120,9 @@ bool libspdm_calculate_th_hash_for_exchange(
 
     LIBSPDM_ASSERT(*th_hash_buffer_size >= hash_size);
 
-    /* duplicate the th context, because we still need use original context to continue.*/
-    digest_context_th = libspdm_hash_new (
-        spdm_context->connection_info.algorithm.base_hash_algo);
-    if (digest_context_th == NULL) {
-        return false;
-    }
-    result = libspdm_hash_duplicate (spdm_context->connection_info.algorithm.base_hash_algo,
-                                     session_info->session_transcript.digest_context_th,
-                                     digest_context_th);
-    if (!result) {
-        libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                           digest_context_th);
-        return false;
-    }
-    result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
-                                 digest_context_th, th_hash_buffer);
-    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, digest_context_th);
+    /* finalize a copy of the th state, because we still need use original state to continue.*/
+    result = libspdm_hash_state_final_copy (&session_info->session_transcript.digest_context_th,
+                                            th_hash_buffer);
     if (!result) {
         return false;
     }
@@ -163,45 +148,30 @@ bool libspdm_calculate_th_hmac_for_exchange_rsp(
 {
     libspdm_context_t *spdm_context;
     libspdm_session_info_t *session_info;
-    void *secured_message_context;
     uint32_t hash_size;
-    void *hmac_context_th;
     return_status status;
     bool result;
 
     spdm_context = context;
     session_info = spdm_session_info;
-    secured_message_context = session_info->secured_message_context;
 
     hash_size = libspdm_get_hash_size(
         spdm_context->connection_info.algorithm.base_hash_algo);
 
     LIBSPDM_ASSERT(*th_hmac_buffer_size >= hash_size);
 
-    if (session_info->session_transcript.hmac_rsp_context_th == NULL) {
+    if (session_info->session_transcript.hmac_rsp_context_th.base_hash_algo == 0) {
         /* trigger message_k to initialize hmac context after finished_key is ready.*/
         status = libspdm_append_message_k (context, spdm_session_info, is_requester, NULL, 0);
         if (RETURN_ERROR(status)) {
             return false;
         }
-        LIBSPDM_ASSERT(session_info->session_transcript.hmac_rsp_context_th != NULL);
+        LIBSPDM_ASSERT(session_info->session_transcript.hmac_rsp_context_th.base_hash_algo != 0);
     }
 
-    /* duplicate the th context, because we still need use original context to continue.*/
-    hmac_context_th = libspdm_hmac_new_with_response_finished_key (secured_message_context);
-    if (hmac_context_th == NULL) {
-        return false;
-    }
-    result = libspdm_hmac_duplicate_with_response_finished_key (secured_message_context,
-                                                                session_info->session_transcript.hmac_rsp_context_th,
-                                                                hmac_context_th);
-    if (!result) {
-        libspdm_hmac_free_with_response_finished_key (secured_message_context, hmac_context_th);
-        return false;
-    }
-    result = libspdm_hmac_final_with_response_finished_key (secured_message_context,
-                                                            hmac_context_th, th_hmac_buffer);
-    libspdm_hmac_free_with_response_finished_key (secured_message_context, hmac_context_th);
+    /* finalize a copy of the th state, because we still need use original state to continue.*/
+    result = libspdm_hmac_state_final_copy (&session_info->session_transcript.hmac_rsp_context_th,
+                                            th_hmac_buffer);
     if (!result) {
         return false;
     }
@@ -356,7 +326,6 @@ bool libspdm_calculate_th_hash_for_finish(void *context,
     libspdm_context_t *spdm_context;
     libspdm_session_info_t *session_info;
     uint32_t hash_size;
-    void *digest_context_th;
     bool result;
 
     spdm_context = context;
@@ -367,23 +336,9 @@ bool libspdm_calculate_th_hash_for_finish(void *context,
 
     LIBSPDM_ASSERT(*th_hash_buffer_size >= hash_size);
 
-    /* duplicate the th context, because we still need use original context to continue.*/
-    digest_context_th = libspdm_hash_new (
-        spdm_context->connection_info.algorithm.base_hash_algo);
-    if (digest_context_th == NULL) {
-        return false;
-    }
-    result = libspdm_hash_duplicate (spdm_context->connection_info.algorithm.base_hash_algo,
-                                     session_info->session_transcript.digest_context_th,
-                                     digest_context_th);
-    if (!result) {
-        libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo,
-                           digest_context_th);
-        return false;
-    }
-    result = libspdm_hash_final (spdm_context->connection_info.algorithm.base_hash_algo,
-                                 digest_context_th, th_hash_buffer);
-    libspdm_hash_free (spdm_context->connection_info.algorithm.base_hash_algo, digest_context_th);
+    /* finalize a copy of the th state, because we still need use original state to continue.*/
+    result = libspdm_hash_state_final_copy (&session_info->session_transcript.digest_context_th,
+                                            th_hash_buffer);
     if (!result) {
         return false;
     }
@@ -410,37 +365,22 @@ bool libspdm_calculate_th_hmac_for_finish_rsp(void *context,
 {
     libspdm_context_t *spdm_context;
     libspdm_session_info_t *session_info;
-    void *secured_message_context;
     uint32_t hash_size;
-    void *hmac_context_th;
     bool result;
 
     spdm_context = context;
     session_info = spdm_session_info;
-    secured_message_context = session_info->secured_message_context;
 
     hash_size = libspdm_get_hash_size(
         spdm_context->connection_info.algorithm.base_hash_algo);
 
     LIBSPDM_ASSERT(*th_hmac_buffer_size >= hash_size);
 
-    LIBSPDM_ASSERT(session_info->session_transcript.hmac_rsp_context_th != NULL);
+    LIBSPDM_ASSERT(session_info->session_transcript.hmac_rsp_context_th.base_hash_algo != 0);
 
-    /* duplicate the th context, because we still need use original context to continue.*/
-    hmac_context_th = libspdm_hmac_new_with_response_finished_key (secured_message_context);
-    if (hmac_context_th == NULL) {
-        return false;
-    }
-    result = libspdm_hmac_duplicate_with_response_finished_key (secured_message_context,
-                                                                session_info->session_transcript.hmac_rsp_context_th,
-                                                                hmac_context_th);
-    if (!result) {
-        libspdm_hmac_free_with_response_finished_key (secured_message_context, hmac_context_th);
-        return false;
-    }
-    result = libspdm_hmac_final_with_response_finished_key (secured_message_context,
-                                                            hmac_context_th, th_hmac_buffer);
-    libspdm_hmac_free_with_response_finished_key (secured_message_context, hmac_context_th);
+    /* finalize a copy of the th state, because we still need use original state to continue.*/
+    result = libspdm_hmac_state_final_copy (&session_info->session_transcript.hmac_rsp_context_th,
+                                            th_hmac_buffer);
     if (!result) {
         return false;
     }
@@ -467,37 +407,22 @@ bool libspdm_calculate_th_hmac_for_finish_req(void *context,
 {
     libspdm_context_t *spdm_context;
     libspdm_session_info_t *session_info;
-    void *secured_message_context;
     uint32_t hash_size;
-    void *hmac_context_th;
     bool result;
 
     spdm_context = context;
     session_info = spdm_session_info;
-    secured_message_context = session_info->secured_message_context;
 
     hash_size = libspdm_get_hash_size(
         spdm_context->connection_info.algorithm.base_hash_algo);
 
     LIBSPDM_ASSERT(*th_hmac_buffer_size >= hash_size);
 
-    LIBSPDM_ASSERT(session_info->session_transcript.hmac_req_context_th != NULL);
+    LIBSPDM_ASSERT(session_info->session_transcript.hmac_req_context_th.base_hash_algo != 0);
 
-    /* duplicate the th context, because we still need use original context to continue.*/
-    hmac_context_th = libspdm_hmac_new_with_request_finished_key (secured_message_context);
-    if (hmac_context_th == NULL) {
-        return false;
-    }
-    result = libspdm_hmac_duplicate_with_request_finished_key (secured_message_context,
-                                                               session_info->session_transcript.hmac_req_context_th,
-                                                               hmac_context_th);
-    if (!result) {
-        libspdm_hmac_free_with_request_finished_key (secured_message_context, hmac_context_th);
-        return false;
-    }
-    result = libspdm_hmac_final_with_request_finished_key (secured_message_context,
-                                                           hmac_context_th, th_hmac_buffer);
-    libspdm_hmac_free_with_request_finished_key (secured_message_context, hmac_context_th);
+    /* finalize a copy of the th state, because we still need use original state to continue.*/
+    result = libspdm_hmac_state_final_copy (&session_info->session_transcript.hmac_req_context_th,
+                                            th_hmac_buffer);
     if (!result) {
         return false;
     }
@@ -676,8 +601,6 @@ bool libspdm_verify_key_exchange_rsp_signature(
     uintn hash_size;
     uint8_t hash_data[LIBSPDM_MAX_HASH_SIZE];
     bool result;
-    uint8_t *cert_chain_data;
-    uintn cert_chain_data_size;
     uint8_t *cert_buffer;
     uintn cert_buffer_size;
     void *context;
@@ -732,14 +655,7 @@ bool libspdm_verify_key_exchange_rsp_signature(
  #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     /* Get leaf cert from cert chain*/
 
-    result = libspdm_get_peer_cert_chain_data(
-        spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
-    if (!result) {
-        return false;
-    }
-    result = libspdm_x509_get_cert_from_cert_chain(cert_chain_data,
-                                                   cert_chain_data_size, -1,
-                                                   &cert_buffer, &cert_buffer_size);
+    result = libspdm_get_peer_leaf_cert(spdm_context, &cert_buffer, &cert_buffer_size);
     if (!result) {
         return false;
     }
@@ -768,14 +684,7 @@ bool libspdm_verify_key_exchange_rsp_signature(
             hash_data, hash_size, sign_data, sign_data_size);
     } else {
         /* Get leaf cert from cert chain*/
-        result = libspdm_get_peer_cert_chain_data(
-            spdm_context, (void **)&cert_chain_data, &cert_chain_data_size);
-        if (!result) {
-            return false;
-        }
-        result = libspdm_x509_get_cert_from_cert_chain(cert_chain_data,
-                                                       cert_chain_data_size, -1,
-                                                       &cert_buffer, &cert_buffer_size);
+        result = libspdm_get_peer_leaf_cert(spdm_context, &cert_buffer, &cert_buffer_size);
         if (!result) {
             return false;
         }
@@ -1072,8 +981,6 @@ bool libspdm_verify_finish_req_signature(libspdm_context_t *spdm_context,
     uintn hash_size;
     uint8_t hash_data[LIBSPDM_MAX_HASH_SIZE];
     bool result;
-    uint8_t *mut_cert_chain_data;
-    uintn mut_cert_chain_data_size;
     uint8_t *mut_cert_buffer;
     uintn mut_cert_buffer_size;
     void *context;
@@ -1138,16 +1045,7 @@ bool libspdm_verify_finish_req_signature(libspdm_context_t *spdm_context,
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     /* Get leaf cert from cert chain*/
 
-    result = libspdm_get_peer_cert_chain_data(spdm_context,
-                                              (void **)&mut_cert_chain_data,
-                                              &mut_cert_chain_data_size);
-    if (!result) {
-        return false;
-    }
-    result = libspdm_x509_get_cert_from_cert_chain(mut_cert_chain_data,
-                                                   mut_cert_chain_data_size, -1,
-                                                   &mut_cert_buffer,
-                                                   &mut_cert_buffer_size);
+    result = libspdm_get_peer_leaf_cert(spdm_context, &mut_cert_buffer, &mut_cert_buffer_size);
     if (!result) {
         return false;
     }
@@ -1177,16 +1075,7 @@ bool libspdm_verify_finish_req_signature(libspdm_context_t *spdm_context,
             hash_data, hash_size, sign_data, sign_data_size);
     } else {
         /* Get leaf cert from cert chain*/
-        result = libspdm_get_peer_cert_chain_data(spdm_context,
-                                                  (void **)&mut_cert_chain_data,
-                                                  &mut_cert_chain_data_size);
-        if (!result) {
-            return false;
-        }
-        result = libspdm_x509_get_cert_from_cert_chain(mut_cert_chain_data,
-                                                       mut_cert_chain_data_size, -1,
-                                                       &mut_cert_buffer,
-                                                       &mut_cert_buffer_size);
+        result = libspdm_get_peer_leaf_cert(spdm_context, &mut_cert_buffer, &mut_cert_buffer_size);
         if (!result) {
             return false;
         }
@@ -1513,6 +1513,250 @@ bool libspdm_hmac_all(uint32_t base_hash_algo, const void *data,
     return hmac_function(data, data_size, key, key_size, hmac_value);
 }
 
+/* Largest input block size of the supported hash algorithms, SHA3-256.*/
+#define LIBSPDM_MAX_HASH_BLOCK_SIZE 136
+
+/**
+ * Return the input block size of the hash algorithm, used to pad the HMAC key.
+ *
+ * @param  base_hash_algo                 SPDM base_hash_algo
+ *
+ * @return hash block size in bytes, or 0 if the algorithm is unknown.
+ **/
+static uint32_t libspdm_get_hash_block_size(uint32_t base_hash_algo)
+{
+    switch (base_hash_algo) {
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256:
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256:
+        return 64;
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384:
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512:
+        return 128;
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256:
+        return 136;
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384:
+        return 104;
+    case SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512:
+        return 72;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Initializes a fixed-size hash state, based upon the negotiated hash algorithm.
+ *
+ * Unlike libspdm_hash_new(), the state needs no allocation for the hash algorithms whose
+ * digest state is embedded in libspdm_hash_state_t. It must be released with
+ * libspdm_hash_state_free() unless it is finalized.
+ *
+ * @param  base_hash_algo                 SPDM base_hash_algo
+ * @param  state                          Pointer to the hash state being initialized.
+ *
+ * @retval true   Hash state initialization succeeded.
+ * @retval false  Hash state initialization failed.
+ **/
+bool libspdm_hash_state_init(uint32_t base_hash_algo, libspdm_hash_state_t *state)
+{
+    /* Reject the hash algorithms disabled in the configuration.*/
+    if (libspdm_get_hash_init_func(base_hash_algo) == NULL) {
+        return false;
+    }
+    return libspdm_hash_state_init_by_nid(libspdm_get_hash_nid(base_hash_algo), state);
+}
+
+/**
+ * Computes the hash digest value of a copy of the hash state.
+ *
+ * The hash state is left unchanged, so more data can be appended to it.
+ *
+ * @param  state                          Pointer to the hash state.
+ * @param  hash_value                     Pointer to a buffer that receives the hash value.
+ *
+ * @retval true   Hash computation succeeded.
+ * @retval false  Hash computation failed.
+ **/
+bool libspdm_hash_state_final_copy(const libspdm_hash_state_t *state, uint8_t *hash_value)
+{
+    libspdm_hash_state_t state_copy;
+
+    if (!libspdm_hash_state_duplicate(state, &state_copy)) {
+        return false;
+    }
+    return libspdm_hash_state_final(&state_copy, hash_value);
+}
+
+/**
+ * Initializes a fixed-size HMAC state with the key, based upon the negotiated HMAC algorithm.
+ *
+ * The HMAC is computed on top of two hash states, so the HMAC state needs no allocation
+ * when the hash states need none. It must be released with libspdm_hmac_state_free()
+ * unless it is finalized.
+ *
+ * @param  base_hash_algo                 SPDM base_hash_algo
+ * @param  state                          Pointer to the HMAC state being initialized.
+ * @param  key                            Pointer to the user-supplied key.
+ * @param  key_size                       key size in bytes.
+ *
+ * @retval true   HMAC state initialization succeeded.
+ * @retval false  HMAC state initialization failed.
+ **/
+bool libspdm_hmac_state_init(uint32_t base_hash_algo, libspdm_hmac_state_t *state,
+                             const uint8_t *key, uintn key_size)
+{
+    uint8_t pad[LIBSPDM_MAX_HASH_BLOCK_SIZE];
+    uint32_t block_size;
+    uintn index;
+    bool result;
+
+    if ((state == NULL) || (key == NULL && key_size != 0)) {
+        return false;
+    }
+    libspdm_zero_mem(state, sizeof(libspdm_hmac_state_t));
+    block_size = libspdm_get_hash_block_size(base_hash_algo);
+    if (block_size == 0) {
+        return false;
+    }
+
+    /* RFC 2104: keys longer than the block size are hashed first.*/
+    libspdm_zero_mem(pad, sizeof(pad));
+    if (key_size > block_size) {
+        if (!libspdm_hash_all(base_hash_algo, key, key_size, pad)) {
+            return false;
+        }
+    } else if (key_size != 0) {
+        libspdm_copy_mem(pad, sizeof(pad), key, key_size);
+    }
+
+    for (index = 0; index < block_size; index++) {
+        pad[index] ^= 0x36;
+    }
+    result = libspdm_hash_state_init(base_hash_algo, &state->inner) &&
+             libspdm_hash_state_update(&state->inner, pad, block_size);
+    for (index = 0; index < block_size; index++) {
+        pad[index] ^= 0x36 ^ 0x5c;
+    }
+    result = result &&
+             libspdm_hash_state_init(base_hash_algo, &state->outer) &&
+             libspdm_hash_state_update(&state->outer, pad, block_size);
+    libspdm_zero_mem(pad, sizeof(pad));
+    if (!result) {
+        libspdm_hmac_state_free(state);
+        return false;
+    }
+    state->base_hash_algo = base_hash_algo;
+    return true;
+}
+
+/**
+ * Makes a copy of an existing HMAC state.
+ *
+ * @param  state                          Pointer to the HMAC state being copied.
+ * @param  new_state                      Pointer to the new HMAC state.
+ *
+ * @retval true   HMAC state copy succeeded.
+ * @retval false  HMAC state copy failed.
+ **/
+bool libspdm_hmac_state_duplicate(const libspdm_hmac_state_t *state,
+                                  libspdm_hmac_state_t *new_state)
+{
+    if ((state == NULL) || (new_state == NULL)) {
+        return false;
+    }
+    if (!libspdm_hash_state_duplicate(&state->inner, &new_state->inner)) {
+        return false;
+    }
+    if (!libspdm_hash_state_duplicate(&state->outer, &new_state->outer)) {
+        libspdm_hash_state_free(&new_state->inner);
+        return false;
+    }
+    new_state->base_hash_algo = state->base_hash_algo;
+    return true;
+}
+
+/**
+ * Digests the input data and updates the HMAC state.
+ *
+ * @param  state                          Pointer to the HMAC state.
+ * @param  data                           Pointer to the buffer containing the data to be HMACed.
+ * @param  data_size                      size of data buffer in bytes.
+ *
+ * @retval true   HMAC data digest succeeded.
+ * @retval false  HMAC data digest failed.
+ **/
+bool libspdm_hmac_state_update(libspdm_hmac_state_t *state, const void *data,
+                               uintn data_size)
+{
+    if (state == NULL) {
+        return false;
+    }
+    return libspdm_hash_state_update(&state->inner, data, data_size);
+}
+
+/**
+ * Completes computation of the HMAC value and releases the HMAC state.
+ *
+ * @param  state                          Pointer to the HMAC state.
+ * @param  hmac_value                     Pointer to a buffer that receives the HMAC value.
+ *
+ * @retval true   HMAC computation succeeded.
+ * @retval false  HMAC computation failed.
+ **/
+bool libspdm_hmac_state_final(libspdm_hmac_state_t *state, uint8_t *hmac_value)
+{
+    uint8_t inner_hash[LIBSPDM_MAX_HASH_SIZE];
+    bool result;
+
+    if ((state == NULL) || (hmac_value == NULL)) {
+        return false;
+    }
+    result = libspdm_hash_state_final(&state->inner, inner_hash) &&
+             libspdm_hash_state_update(&state->outer, inner_hash,
+                                       libspdm_get_hash_size(state->base_hash_algo)) &&
+             libspdm_hash_state_final(&state->outer, hmac_value);
+    libspdm_zero_mem(inner_hash, sizeof(inner_hash));
+    libspdm_hmac_state_free(state);
+    return result;
+}
+
+/**
+ * Computes the HMAC value of a copy of the HMAC state.
+ *
+ * The HMAC state is left unchanged, so more data can be appended to it.
+ *
+ * @param  state                          Pointer to the HMAC state.
+ * @param  hmac_value                     Pointer to a buffer that receives the HMAC value.
+ *
+ * @retval true   HMAC computation succeeded.
+ * @retval false  HMAC computation failed.
+ **/
+bool libspdm_hmac_state_final_copy(const libspdm_hmac_state_t *state, uint8_t *hmac_value)
+{
+    libspdm_hmac_state_t state_copy;
+
+    if (!libspdm_hmac_state_duplicate(state, &state_copy)) {
+        return false;
+    }
+    return libspdm_hmac_state_final(&state_copy, hmac_value);
+}
+
+/**
+ * Releases an HMAC state. The state is zeroed.
+ *
+ * It is safe to release a state that is zeroed, already released or finalized.
+ *
+ * @param  state                          Pointer to the HMAC state.
+ **/
+void libspdm_hmac_state_free(libspdm_hmac_state_t *state)
+{
+    if (state == NULL) {
+        return;
+    }
+    libspdm_hash_state_free(&state->inner);
+    libspdm_hash_state_free(&state->outer);
+    state->base_hash_algo = 0;
+}
+
 /**
  * Return HKDF expand function, based upon the negotiated HKDF algorithm.
  *
@@ -1607,6 +1851,78 @@ bool libspdm_hkdf_expand(uint32_t base_hash_algo, const uint8_t *prk,
                                 out_size);
 }
 
+/**
+ * Derive HMAC-based Expand key Derivation Function (HKDF) Expand from a pre-keyed PRK state.
+ *
+ * The PRK state is an HMAC state initialized by libspdm_hmac_state_init() with the PRK
+ * as key. It is left unchanged, so all labels derived from one secret share the HMAC
+ * key setup.
+ *
+ * @param  prk_state                    Pointer to the HMAC state keyed with the PRK.
+ * @param  info                         Pointer to the application specific info.
+ * @param  info_size                     info size in bytes.
+ * @param  out                          Pointer to buffer to receive hkdf value.
+ * @param  out_size                      size of hkdf bytes to generate.
+ *
+ * @retval true   Hkdf generated successfully.
+ * @retval false  Hkdf generation failed.
+ **/
+bool libspdm_hkdf_expand_with_state(const libspdm_hmac_state_t *prk_state,
+                                    const uint8_t *info, uintn info_size,
+                                    uint8_t *out, uintn out_size)
+{
+    libspdm_hmac_state_t hmac_state;
+    uint8_t digest[LIBSPDM_MAX_HASH_SIZE];
+    uint32_t hash_size;
+    uintn copy_size;
+    uintn offset;
+    uint8_t counter;
+    bool result;
+
+    if ((prk_state == NULL) || (prk_state->base_hash_algo == 0) ||
+        (info == NULL && info_size != 0) || (out == NULL)) {
+        return false;
+    }
+    hash_size = libspdm_get_hash_size(prk_state->base_hash_algo);
+    /* RFC 5869: at most 255 blocks.*/
+    if ((hash_size == 0) || (out_size > (uintn)hash_size * 255)) {
+        return false;
+    }
+
+    /* T(n) = HMAC(PRK, T(n-1) | info | n)*/
+    result = true;
+    counter = 0;
+    copy_size = 0;
+    for (offset = 0; offset < out_size; offset += copy_size) {
+        counter++;
+        result = libspdm_hmac_state_duplicate(prk_state, &hmac_state);
+        if (!result) {
+            break;
+        }
+        if (counter > 1) {
+            result = libspdm_hmac_state_update(&hmac_state, digest, hash_size);
+        }
+        result = result &&
+                 libspdm_hmac_state_update(&hmac_state, info, info_size) &&
+                 libspdm_hmac_state_update(&hmac_state, &counter, sizeof(counter)) &&
+                 libspdm_hmac_state_final(&hmac_state, digest);
+        if (!result) {
+            libspdm_hmac_state_free(&hmac_state);
+            break;
+        }
+        copy_size = out_size - offset;
+        if (copy_size > hash_size) {
+            copy_size = hash_size;
+        }
+        libspdm_copy_mem(out + offset, out_size - offset, digest, copy_size);
+    }
+    libspdm_zero_mem(digest, sizeof(digest));
+    if (!result) {
+        libspdm_zero_mem(out, out_size);
+    }
+    return result;
+}
+
 typedef struct {
     bool is_requester;
     uint8_t op_code;
@@ -4087,17 +4403,16 @@ bool libspdm_get_signature_algo_OID(uint32_t base_asym_algo, uint32_t base_hash_
 /**
  * Verify cert signature algo is matched to negotiated algo
  *
- * @param[in]  cert                  Pointer to the DER-encoded certificate data.
- * @param[in]  cert_size             The size of certificate data in bytes.
+ * @param[in]  x509_cert             Pointer to the X509 object of the certificate.
  * @param[in]  base_asym_algo        SPDM base_asym_algo
  * @param[in]  base_hash_algo        SPDM base_hash_algo
  *
  * @retval  true   verify pass
  * @retval  false  verify fail
  **/
-bool libspdm_verify_cert_signature_algo_OID(const uint8_t *cert, uintn cert_size,
-                                            uint32_t base_asym_algo,
-                                            uint32_t base_hash_algo)
+static bool libspdm_verify_cert_signature_algo_OID(const void *x509_cert,
+                                                   uint32_t base_asym_algo,
+                                                   uint32_t base_hash_algo)
 {
     /*signature algo OID from cert*/
     uint8_t cert_signature_algo_oid[LIBSPDM_MAX_SIGNATURE_ALGO_OID_LEN];
@@ -4125,8 +4440,8 @@ bool libspdm_verify_cert_signature_algo_OID(const uint8_t *cert, uintn cert_size
     }
 
     /*get signature algo OID from cert*/
-    ret = libspdm_x509_get_signature_algorithm(cert, cert_size,
-                                               cert_signature_algo_oid, &oid_len);
+    ret = libspdm_x509_object_get_signature_algorithm(x509_cert,
+                                                      cert_signature_algo_oid, &oid_len);
     if (ret != RETURN_SUCCESS ||
         oid_len != libspdm_get_signature_algo_OID_len(base_asym_algo)||
         libspdm_const_compare_mem(cert_signature_algo_oid,
@@ -4142,14 +4457,13 @@ bool libspdm_verify_cert_signature_algo_OID(const uint8_t *cert, uintn cert_size
 /**
  * Verify leaf cert basic_constraints CA is false
  *
- * @param[in]  cert                  Pointer to the DER-encoded certificate data.
- * @param[in]  cert_size             The size of certificate data in bytes.
+ * @param[in]  x509_cert             Pointer to the X509 object of the certificate.
  *
  * @retval  true   verify pass,two case: 1.basic constraints is not present in cert;
  *                                       2. cert basic_constraints CA is false;
  * @retval  false  verify fail
  **/
-bool libspdm_verify_leaf_cert_basic_constraints(const uint8_t *cert, uintn cert_size)
+static bool libspdm_verify_leaf_cert_basic_constraints(const void *x509_cert)
 {
     bool status;
     return_status ret;
@@ -4159,8 +4473,8 @@ bool libspdm_verify_leaf_cert_basic_constraints(const uint8_t *cert, uintn cert_
 
     len = BASIC_CONSTRAINTS_LEN;
 
-    ret = libspdm_x509_get_extended_basic_constraints(cert, cert_size,
-                                                      cert_basic_constraints, &len);
+    ret = libspdm_x509_object_get_extended_basic_constraints(x509_cert,
+                                                             cert_basic_constraints, &len);
 
     if (ret == RETURN_NOT_FOUND) {
         /* basic constraints is not present in cert */
@@ -4180,15 +4494,16 @@ bool libspdm_verify_leaf_cert_basic_constraints(const uint8_t *cert, uintn cert_
 /**
  * Verify leaf cert extend spdm OID
  *
- * @param[in]  cert                  Pointer to the DER-encoded certificate data.
- * @param[in]  cert_size             The size of certificate data in bytes.
+ * @param[in]  x509_cert             Pointer to the X509 object of the certificate.
+ * @param[in]  is_device_cert_model  If true, the cert chain is DeviceCert model;
+ *                                   If false, the cert chain is AliasCert model;
  *
  * @retval  true   verify pass
  * @retval  false  verify fail,two case: 1. return is not RETURN_SUCCESS or RETURN_NOT_FOUND;
  *                                       2. m_libspdm_hardware_identity_oid is found in AliasCert model;
  **/
-bool libspdm_verify_leaf_cert_eku_spdm_OID(const uint8_t *cert, uintn cert_size,
-                                           bool is_device_cert_model)
+static bool libspdm_verify_leaf_cert_eku_spdm_OID(const void *x509_cert,
+                                                  bool is_device_cert_model)
 {
     bool status;
     return_status ret;
@@ -4199,15 +4514,15 @@ bool libspdm_verify_leaf_cert_eku_spdm_OID(const uint8_t *cert, uintn cert_size,
 
     len = SPDM_EXTENDSION_LEN;
 
-    if (cert == NULL || cert_size == 0) {
+    if (x509_cert == NULL) {
         return false;
     }
 
-    ret = libspdm_x509_get_extension_data((uint8_t *)cert, cert_size,
-                                          (uint8_t *)m_oid_spdm_extension,
-                                          sizeof(m_oid_spdm_extension),
-                                          spdm_extension,
-                                          &len);
+    ret = libspdm_x509_object_get_extension_data(x509_cert,
+                                                 (uint8_t *)m_oid_spdm_extension,
+                                                 sizeof(m_oid_spdm_extension),
+                                                 spdm_extension,
+                                                 &len);
 
     if(ret == RETURN_NOT_FOUND) {
         status = true;
@@ -4240,6 +4555,8 @@ bool libspdm_verify_leaf_cert_eku_spdm_OID(const uint8_t *cert, uintn cert_size,
 /**
  * Certificate Check for SPDM leaf cert.
  *
+ * The certificate is parsed once and every check runs on the same X509 object.
+ *
  * @param[in]  cert                  Pointer to the DER-encoded certificate data.
  * @param[in]  cert_size             The size of certificate data in bytes.
  * @param[in]  base_asym_algo        SPDM base_asym_algo
@@ -4264,6 +4581,7 @@ bool libspdm_x509_certificate_check(const uint8_t *cert, uintn cert_size,
     uintn cert_version;
     return_status ret;
     uintn value;
+    void *x509_cert;
 #if (LIBSPDM_RSA_SSA_SUPPORT == 1) || (LIBSPDM_RSA_PSS_SUPPORT == 1)
     void *rsa_context;
 #endif
@@ -4297,9 +4615,14 @@ bool libspdm_x509_certificate_check(const uint8_t *cert, uintn cert_size,
     end_cert_from_len = 64;
     end_cert_to_len = 64;
 
+    x509_cert = NULL;
+    if (!libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert)) {
+        return false;
+    }
+
     /* 1. version*/
     cert_version = 0;
-    ret = libspdm_x509_get_version(cert, cert_size, &cert_version);
+    ret = libspdm_x509_object_get_version(x509_cert, &cert_version);
     if (RETURN_ERROR(ret)) {
         status = false;
         goto cleanup;
@@ -4311,7 +4634,7 @@ bool libspdm_x509_certificate_check(const uint8_t *cert, uintn cert_size,
 
     /* 2. serial_number*/
     asn1_buffer_len = 0;
-    ret = libspdm_x509_get_serial_number(cert, cert_size, NULL, &asn1_buffer_len);
+    ret = libspdm_x509_object_get_serial_number(x509_cert, NULL, &asn1_buffer_len);
     if (ret != RETURN_BUFFER_TOO_SMALL) {
         status = false;
         goto cleanup;
@@ -4319,14 +4642,14 @@ bool libspdm_x509_certificate_check(const uint8_t *cert, uintn cert_size,
 
     /* 3. verify sinature_algorithem*/
     status =
-        libspdm_verify_cert_signature_algo_OID(cert, cert_size, base_asym_algo, base_hash_algo);
+        libspdm_verify_cert_signature_algo_OID(x509_cert, base_asym_algo, base_hash_algo);
     if (!status) {
         goto cleanup;
     }
 
     /* 4. issuer_name*/
     asn1_buffer_len = 0;
-    status = libspdm_x509_get_issuer_name(cert, cert_size, NULL, &asn1_buffer_len);
+    status = libspdm_x509_object_get_issuer_name(x509_cert, NULL, &asn1_buffer_len);
     if (asn1_buffer_len <= 0) {
         status = false;
         goto cleanup;
@@ -4334,16 +4657,16 @@ bool libspdm_x509_certificate_check(const uint8_t *cert, uintn cert_size,
 
     /* 5. subject_name*/
     asn1_buffer_len = 0;
-    status = libspdm_x509_get_subject_name(cert, cert_size, NULL, &asn1_buffer_len);
+    status = libspdm_x509_object_get_subject_name(x509_cert, NULL, &asn1_buffer_len);
     if (asn1_buffer_len <= 0) {
         status = false;
         goto cleanup;
     }
 
     /* 6. validaity*/
-    status = libspdm_x509_get_validity(cert, cert_size, end_cert_from,
-                                       &end_cert_from_len, end_cert_to,
-                                       &end_cert_to_len);
+    status = libspdm_x509_object_get_validity(x509_cert, end_cert_from,
+                                              &end_cert_from_len, end_cert_to,
+                                              &end_cert_to_len);
     if (!status) {
         goto cleanup;
     }
@@ -4358,26 +4681,26 @@ bool libspdm_x509_certificate_check(const uint8_t *cert, uintn cert_size,
     status = false;
 #if (LIBSPDM_RSA_SSA_SUPPORT == 1) || (LIBSPDM_RSA_PSS_SUPPORT == 1)
     if (!status) {
-        status = libspdm_rsa_get_public_key_from_x509(cert, cert_size,
-                                                      &rsa_context);
+        status = libspdm_rsa_get_public_key_from_x509_object(x509_cert,
+                                                             &rsa_context);
     }
 #endif
 #if LIBSPDM_ECDSA_SUPPORT == 1
     if (!status) {
-        status = libspdm_ec_get_public_key_from_x509(cert, cert_size,
-                                                     &ec_context);
+        status = libspdm_ec_get_public_key_from_x509_object(x509_cert,
+                                                            &ec_context);
     }
 #endif
 #if (LIBSPDM_EDDSA_ED25519_SUPPORT == 1) || (LIBSPDM_EDDSA_ED448_SUPPORT == 1)
     if (!status) {
-        status = libspdm_ecd_get_public_key_from_x509(cert, cert_size,
-                                                      &ecd_context);
+        status = libspdm_ecd_get_public_key_from_x509_object(x509_cert,
+                                                             &ecd_context);
     }
 #endif
 #if LIBSPDM_SM2_DSA_SUPPORT == 1
     if (!status) {
-        status = libspdm_sm2_get_public_key_from_x509(cert, cert_size,
-                                                      &sm2_context);
+        status = libspdm_sm2_get_public_key_from_x509_object(x509_cert,
+                                                             &sm2_context);
     }
 #endif
     if (!status) {
@@ -4386,7 +4709,7 @@ bool libspdm_x509_certificate_check(const uint8_t *cert, uintn cert_size,
 
     /* 8. key_usage*/
     value = 0;
-    status = libspdm_x509_get_key_usage(cert, cert_size, &value);
+    status = libspdm_x509_object_get_key_usage(x509_cert, &value);
     if (!status) {
         goto cleanup;
     }
@@ -4398,26 +4721,27 @@ bool libspdm_x509_certificate_check(const uint8_t *cert, uintn cert_size,
     }
 
     /* 9. verify SPDM extension OID*/
-    status = libspdm_verify_leaf_cert_eku_spdm_OID(cert, cert_size, is_device_cert_model);
+    status = libspdm_verify_leaf_cert_eku_spdm_OID(x509_cert, is_device_cert_model);
     if (!status) {
         goto cleanup;
     }
 
     /* 10. verify basic constraints*/
-    status = libspdm_verify_leaf_cert_basic_constraints(cert, cert_size);
+    status = libspdm_verify_leaf_cert_basic_constraints(x509_cert);
     if (!status) {
         goto cleanup;
     }
 
     /* 11. extended_key_usage*/
     value = 0;
-    ret = libspdm_x509_get_extended_key_usage(cert, cert_size, NULL, &value);
+    ret = libspdm_x509_object_get_extended_key_usage(x509_cert, NULL, &value);
     if (ret != RETURN_BUFFER_TOO_SMALL || value == 0) {
         status = false;
         goto cleanup;
     }
 
 cleanup:
+    libspdm_x509_free(x509_cert);
 #if (LIBSPDM_RSA_SSA_SUPPORT == 1) || (LIBSPDM_RSA_PSS_SUPPORT == 1)
     if (rsa_context != NULL) {
         libspdm_rsa_free(rsa_context);
@@ -4457,34 +4781,38 @@ bool libspdm_is_root_certificate(const uint8_t *cert, uintn cert_size)
     uintn issuer_name_len;
     uint8_t subject_name[LIBSPDM_MAX_MESSAGE_SMALL_BUFFER_SIZE];
     uintn subject_name_len;
+    void *x509_cert;
     bool result;
 
     if (cert == NULL || cert_size == 0) {
         return false;
     }
 
+    x509_cert = NULL;
+    if (!libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert)) {
+        return false;
+    }
+
     /* 1. issuer_name*/
     issuer_name_len = LIBSPDM_MAX_MESSAGE_SMALL_BUFFER_SIZE;
-    result = libspdm_x509_get_issuer_name(cert, cert_size, issuer_name, &issuer_name_len);
+    result = libspdm_x509_object_get_issuer_name(x509_cert, issuer_name, &issuer_name_len);
     if (!result) {
-        return false;
+        goto cleanup;
     }
 
     /* 2. subject_name*/
     subject_name_len = LIBSPDM_MAX_MESSAGE_SMALL_BUFFER_SIZE;
-    result = libspdm_x509_get_subject_name(cert, cert_size, subject_name, &subject_name_len);
+    result = libspdm_x509_object_get_subject_name(x509_cert, subject_name, &subject_name_len);
     if (!result) {
-        return false;
+        goto cleanup;
     }
 
-    if (issuer_name_len != subject_name_len) {
-        return false;
-    }
-    if (libspdm_const_compare_mem(issuer_name, subject_name, issuer_name_len) != 0) {
-        return false;
-    }
+    result = (issuer_name_len == subject_name_len) &&
+             (libspdm_const_compare_mem(issuer_name, subject_name, issuer_name_len) == 0);
 
-    return true;
+cleanup:
+    libspdm_x509_free(x509_cert);
+    return result;
 }
 
 static uint8_t m_libspdm_oid_subject_alt_name[] = { 0x55, 0x1D, 0x11 };
@@ -4615,24 +4943,33 @@ libspdm_get_dmtf_subject_alt_name(const uint8_t *cert, const intn cert_size,
 {
     return_status status;
     uintn extension_data_size;
+    void *x509_cert;
+
+    x509_cert = NULL;
+    if (!libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert)) {
+        return RETURN_NOT_FOUND;
+    }
 
     extension_data_size = 0;
-    status = libspdm_x509_get_extension_data(cert, cert_size,
-                                             m_libspdm_oid_subject_alt_name,
-                                             sizeof(m_libspdm_oid_subject_alt_name), NULL,
-                                             &extension_data_size);
+    status = libspdm_x509_object_get_extension_data(x509_cert,
+                                                    m_libspdm_oid_subject_alt_name,
+                                                    sizeof(m_libspdm_oid_subject_alt_name), NULL,
+                                                    &extension_data_size);
     if (status != RETURN_BUFFER_TOO_SMALL) {
+        libspdm_x509_free(x509_cert);
         return RETURN_NOT_FOUND;
     }
     if (extension_data_size > *name_buffer_size) {
+        libspdm_x509_free(x509_cert);
         *name_buffer_size = extension_data_size;
         return RETURN_BUFFER_TOO_SMALL;
     }
     status =
-        libspdm_x509_get_extension_data(cert, cert_size,
-                                        m_libspdm_oid_subject_alt_name,
-                                        sizeof(m_libspdm_oid_subject_alt_name),
-                                        (uint8_t *)name_buffer, name_buffer_size);
+        libspdm_x509_object_get_extension_data(x509_cert,
+                                               m_libspdm_oid_subject_alt_name,
+                                               sizeof(m_libspdm_oid_subject_alt_name),
+                                               (uint8_t *)name_buffer, name_buffer_size);
+    libspdm_x509_free(x509_cert);
     if (RETURN_ERROR(status)) {
         return status;
     }
@@ -4642,6 +4979,84 @@ libspdm_get_dmtf_subject_alt_name(const uint8_t *cert, const intn cert_size,
         name_buffer_size, oid, oid_size);
 }
 
+/**
+ * Build the certificate index of one certificate chain data, walking the chain only once.
+ *
+ * If the chain holds no certificate or more than LIBSPDM_MAX_CERT_CHAIN_DEPTH certificates,
+ * the index is left empty and libspdm_get_cert_from_cert_chain_index() walks the chain instead.
+ *
+ * @param  cert_chain_data          The certificate chain data without spdm_cert_chain_t header.
+ * @param  cert_chain_data_size     size in bytes of the certificate chain data.
+ * @param  cert_chain_index         The certificate index to build.
+ **/
+void libspdm_build_cert_chain_index(const uint8_t *cert_chain_data, uintn cert_chain_data_size,
+                                    libspdm_cert_chain_index_t *cert_chain_index)
+{
+    uint8_t *cert;
+    uintn cert_size;
+    uintn offset;
+
+    cert_chain_index->cert_count = 0;
+    offset = 0;
+
+    /* Each step only parses the header of the first certificate of the remaining chain.*/
+    while (offset < cert_chain_data_size) {
+        if (!libspdm_x509_get_cert_from_cert_chain((uint8_t *)cert_chain_data + offset,
+                                                   cert_chain_data_size - offset, 0,
+                                                   &cert, &cert_size)) {
+            break;
+        }
+        if (cert_chain_index->cert_count == LIBSPDM_MAX_CERT_CHAIN_DEPTH) {
+            cert_chain_index->cert_count = 0;
+            return;
+        }
+        cert_chain_index->cert_offset[cert_chain_index->cert_count] = (uint32_t)offset;
+        cert_chain_index->cert_size[cert_chain_index->cert_count] = (uint32_t)cert_size;
+        cert_chain_index->cert_count++;
+        offset += cert_size;
+    }
+}
+
+/**
+ * Get one certificate from the certificate chain data, using its certificate index.
+ *
+ * @param  cert_chain_index         The certificate index built from cert_chain_data.
+ * @param  cert_chain_data          The certificate chain data without spdm_cert_chain_t header.
+ * @param  cert_chain_data_size     size in bytes of the certificate chain data.
+ * @param  cert_index               index of certificate. If index is -1 indicates the
+ *                                  last certificate in cert_chain_data.
+ * @param  cert                     The certificate at the index of cert_chain_data.
+ * @param  cert_length              The length of the certificate in bytes.
+ *
+ * @retval  true   Success.
+ * @retval  false  Failed to get certificate from certificate chain.
+ **/
+bool libspdm_get_cert_from_cert_chain_index(const libspdm_cert_chain_index_t *cert_chain_index,
+                                            uint8_t *cert_chain_data,
+                                            uintn cert_chain_data_size,
+                                            int32_t cert_index, uint8_t **cert,
+                                            uintn *cert_length)
+{
+    uint32_t index;
+
+    if (cert_chain_index->cert_count == 0) {
+        return libspdm_x509_get_cert_from_cert_chain(cert_chain_data, cert_chain_data_size,
+                                                     cert_index, cert, cert_length);
+    }
+
+    if (cert_index == -1) {
+        index = cert_chain_index->cert_count - 1;
+    } else if ((cert_index >= 0) && ((uint32_t)cert_index < cert_chain_index->cert_count)) {
+        index = (uint32_t)cert_index;
+    } else {
+        return false;
+    }
+
+    *cert = cert_chain_data + cert_chain_index->cert_offset[index];
+    *cert_length = cert_chain_index->cert_size[index];
+    return true;
+}
+
 /**
  * This function verifies the integrity of certificate chain data without spdm_cert_chain_t header.
  *
@@ -4663,6 +5078,7 @@ bool libspdm_verify_cert_chain_data(uint8_t *cert_chain_data, uintn cert_chain_d
     uintn root_cert_buffer_size;
     uint8_t *leaf_cert_buffer;
     uintn leaf_cert_buffer_size;
+    libspdm_cert_chain_index_t cert_chain_index;
 
     if (cert_chain_data_size >
         MAX_UINT16 - (sizeof(spdm_cert_chain_t) + LIBSPDM_MAX_HASH_SIZE)) {
@@ -4671,8 +5087,10 @@ bool libspdm_verify_cert_chain_data(uint8_t *cert_chain_data, uintn cert_chain_d
         return false;
     }
 
-    if (!libspdm_x509_get_cert_from_cert_chain(
-            cert_chain_data, cert_chain_data_size, 0, &root_cert_buffer,
+    libspdm_build_cert_chain_index(cert_chain_data, cert_chain_data_size, &cert_chain_index);
+
+    if (!libspdm_get_cert_from_cert_chain_index(
+            &cert_chain_index, cert_chain_data, cert_chain_data_size, 0, &root_cert_buffer,
             &root_cert_buffer_size)) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
                        "!!! VerifyCertificateChainData - FAIL (get root certificate failed)!!!\n"));
@@ -4686,8 +5104,8 @@ bool libspdm_verify_cert_chain_data(uint8_t *cert_chain_data, uintn cert_chain_d
         return false;
     }
 
-    if (!libspdm_x509_get_cert_from_cert_chain(
-            cert_chain_data, cert_chain_data_size, -1,
+    if (!libspdm_get_cert_from_cert_chain_index(
+            &cert_chain_index, cert_chain_data, cert_chain_data_size, -1,
             &leaf_cert_buffer, &leaf_cert_buffer_size)) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
                        "!!! VerifyCertificateChainData - FAIL (get leaf certificate failed)!!!\n"));
@@ -4731,6 +5149,7 @@ bool libspdm_verify_certificate_chain_buffer(uint32_t base_hash_algo, uint32_t b
     uint8_t calc_root_cert_hash[LIBSPDM_MAX_HASH_SIZE];
     uint8_t *leaf_cert_buffer;
     uintn leaf_cert_buffer_size;
+    libspdm_cert_chain_index_t cert_chain_index;
     bool result;
 
     hash_size = libspdm_get_hash_size(base_hash_algo);
@@ -4751,8 +5170,9 @@ bool libspdm_verify_certificate_chain_buffer(uint32_t base_hash_algo, uint32_t b
                       sizeof(spdm_cert_chain_t) + hash_size;
     cert_chain_data_size =
         cert_chain_buffer_size - sizeof(spdm_cert_chain_t) - hash_size;
-    if (!libspdm_x509_get_cert_from_cert_chain(
-            cert_chain_data, cert_chain_data_size, 0, &first_cert_buffer,
+    libspdm_build_cert_chain_index(cert_chain_data, cert_chain_data_size, &cert_chain_index);
+    if (!libspdm_get_cert_from_cert_chain_index(
+            &cert_chain_index, cert_chain_data, cert_chain_data_size, 0, &first_cert_buffer,
             &first_cert_buffer_size)) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
                        "!!! VerifyCertificateChainBuffer - FAIL (get root certificate failed)!!!\n"));
@@ -4789,8 +5209,8 @@ bool libspdm_verify_certificate_chain_buffer(uint32_t base_hash_algo, uint32_t b
         }
     }
 
-    if (!libspdm_x509_get_cert_from_cert_chain(
-            cert_chain_data, cert_chain_data_size, -1,
+    if (!libspdm_get_cert_from_cert_chain_index(
+            &cert_chain_index, cert_chain_data, cert_chain_data_size, -1,
             &leaf_cert_buffer, &leaf_cert_buffer_size)) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
                        "!!! VerifyCertificateChainBuffer - FAIL (get leaf certificate failed)!!!\n"));
@@ -4808,6 +5228,294 @@ bool libspdm_verify_certificate_chain_buffer(uint32_t base_hash_algo, uint32_t b
     return true;
 }
 
+/**
+ * Return the size of a DER-encoded certificate from the beginning of its encoding.
+ *
+ * @param  data                     The first bytes of the certificate.
+ * @param  data_size                size in bytes of data.
+ * @param  cert_size                The size in bytes of the certificate, 0 if more bytes are needed.
+ *
+ * @retval true   The size is returned, or more bytes are needed.
+ * @retval false  The data is not the beginning of a certificate.
+ **/
+static bool libspdm_get_der_cert_size(const uint8_t *data, uintn data_size, uintn *cert_size)
+{
+    uintn length_size;
+    uintn length;
+    uintn index;
+
+    *cert_size = 0;
+    if (data_size < 2) {
+        return true;
+    }
+    if (data[0] != (LIBSPDM_CRYPTO_ASN1_SEQUENCE | LIBSPDM_CRYPTO_ASN1_CONSTRUCTED)) {
+        return false;
+    }
+    if ((data[1] & 0x80) == 0) {
+        *cert_size = 2 + data[1];
+        return true;
+    }
+    length_size = data[1] & 0x7F;
+    if ((length_size == 0) || (length_size > sizeof(uint32_t))) {
+        return false;
+    }
+    if (data_size < 2 + length_size) {
+        return true;
+    }
+    length = 0;
+    for (index = 0; index < length_size; index++) {
+        length = (length << 8) | data[2 + index];
+    }
+    *cert_size = 2 + length_size + length;
+    return true;
+}
+
+/**
+ * Verify the certificate just completed in the stream, then keep it as the issuer of the next one.
+ *
+ * @param  stream                   The certificate chain stream.
+ *
+ * @retval true   The certificate is verified.
+ * @retval false  The certificate is invalid.
+ **/
+static bool libspdm_cert_chain_stream_add_cert(libspdm_cert_chain_stream_t *stream)
+{
+    uint8_t *cert;
+    uint8_t *issuer;
+    uint8_t calc_root_cert_hash[LIBSPDM_MAX_HASH_SIZE];
+
+    cert = stream->cert[stream->issuer_slot ^ 1];
+    issuer = stream->cert[stream->issuer_slot];
+
+    if (stream->verify && (stream->cert_count == 0)) {
+        if (libspdm_is_root_certificate(cert, stream->cert_size)) {
+            if (!libspdm_hash_all(stream->base_hash_algo, cert, stream->cert_size,
+                                  calc_root_cert_hash)) {
+                return false;
+            }
+            if (libspdm_const_compare_mem(stream->header + sizeof(spdm_cert_chain_t),
+                                          calc_root_cert_hash,
+                                          stream->header_size - sizeof(spdm_cert_chain_t)) != 0) {
+                LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                               "!!! CertChainStream - FAIL (cert root hash mismatch) !!!\n"));
+                return false;
+            }
+            if ((stream->trust_anchor != NULL) &&
+                ((stream->trust_anchor_size != stream->cert_size) ||
+                 (libspdm_const_compare_mem(cert, stream->trust_anchor,
+                                            stream->cert_size) != 0))) {
+                LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                               "!!! CertChainStream - FAIL (root cert mismatch) !!!\n"));
+                return false;
+            }
+        } else if ((stream->trust_anchor != NULL) &&
+                   !libspdm_x509_verify_cert(cert, stream->cert_size,
+                                             stream->trust_anchor, stream->trust_anchor_size)) {
+            LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                           "!!! CertChainStream - FAIL (received root cert verify failed) !!!\n"));
+            return false;
+        }
+    } else if (stream->verify) {
+        if (!libspdm_x509_verify_cert_chain(issuer, stream->issuer_size,
+                                            cert, stream->cert_size)) {
+            LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                           "!!! CertChainStream - FAIL (cert %d verify failed) !!!\n",
+                           stream->cert_count));
+            return false;
+        }
+    }
+
+    stream->issuer_slot ^= 1;
+    stream->issuer_size = stream->cert_size;
+    stream->cert_size = 0;
+    stream->pending_size = 0;
+    stream->cert_count++;
+    return true;
+}
+
+/**
+ * This function starts the verification of a certificate chain buffer including
+ * spdm_cert_chain_t header, which is then appended portion by portion with
+ * libspdm_cert_chain_stream_update().
+ *
+ * It runs the checks of libspdm_verify_certificate_chain_buffer(), but each certificate is
+ * verified as soon as it is received, so the size of the chain is not limited by a buffer.
+ * Each certificate must not be larger than LIBSPDM_MAX_CERT_SIZE.
+ *
+ * The stream must be released with libspdm_cert_chain_stream_free() unless
+ * libspdm_cert_chain_stream_final() is called.
+ *
+ * @param  stream                         The certificate chain stream.
+ * @param  base_hash_algo                 SPDM base_hash_algo
+ * @param  base_asym_algo                 SPDM base_asym_algo
+ * @param  is_device_cert_model           If true, the cert chain is DeviceCert model;
+ *                                        If false, the cert chain is AliasCert model;
+ * @param  verify                         If false, the certificates are only split and hashed.
+ *
+ * @retval true  the stream is initialized.
+ * @retval false the stream initialization fails.
+ **/
+bool libspdm_cert_chain_stream_init(libspdm_cert_chain_stream_t *stream,
+                                    uint32_t base_hash_algo, uint32_t base_asym_algo,
+                                    bool is_device_cert_model, bool verify)
+{
+    stream->base_hash_algo = base_hash_algo;
+    stream->base_asym_algo = base_asym_algo;
+    stream->is_device_cert_model = is_device_cert_model;
+    stream->verify = verify;
+    stream->trust_anchor = NULL;
+    stream->trust_anchor_size = 0;
+    stream->header_size = 0;
+    stream->received_size = 0;
+    stream->cert_count = 0;
+    stream->issuer_slot = 0;
+    stream->issuer_size = 0;
+    stream->cert_size = 0;
+    stream->pending_size = 0;
+    return libspdm_hash_state_init(base_hash_algo, &stream->hash_state);
+}
+
+/**
+ * This function appends the next portion of the certificate chain buffer to the stream,
+ * and verifies every certificate it completes.
+ *
+ * @param  stream                         The certificate chain stream.
+ * @param  data                           The next portion of the certificate chain buffer.
+ * @param  data_size                      size in bytes of the portion.
+ *
+ * @retval true  the portion is appended, and all complete certificates are verified.
+ * @retval false a certificate is invalid, the stream must not be appended any more.
+ **/
+bool libspdm_cert_chain_stream_update(libspdm_cert_chain_stream_t *stream,
+                                      const void *data, uintn data_size)
+{
+    const uint8_t *ptr;
+    uint8_t *cert;
+    uintn header_size;
+    uintn copy_size;
+
+    if (!libspdm_hash_state_update(&stream->hash_state, data, data_size)) {
+        return false;
+    }
+    stream->received_size += data_size;
+    ptr = data;
+
+    header_size = sizeof(spdm_cert_chain_t) + libspdm_get_hash_size(stream->base_hash_algo);
+    if (stream->header_size < header_size) {
+        copy_size = MIN(data_size, header_size - stream->header_size);
+        libspdm_copy_mem(stream->header + stream->header_size,
+                         sizeof(stream->header) - stream->header_size, ptr, copy_size);
+        stream->header_size += copy_size;
+        ptr += copy_size;
+        data_size -= copy_size;
+    }
+
+    while (data_size > 0) {
+        cert = stream->cert[stream->issuer_slot ^ 1];
+
+        /* Gather the DER header first, to know where the certificate ends.*/
+        if (stream->cert_size == 0) {
+            copy_size = MIN(data_size, 2 + sizeof(uint32_t) - stream->pending_size);
+        } else {
+            copy_size = MIN(data_size, stream->cert_size - stream->pending_size);
+        }
+        libspdm_copy_mem(cert + stream->pending_size,
+                         LIBSPDM_MAX_CERT_SIZE - stream->pending_size, ptr, copy_size);
+        stream->pending_size += copy_size;
+        ptr += copy_size;
+        data_size -= copy_size;
+
+        if (stream->cert_size == 0) {
+            if (!libspdm_get_der_cert_size(cert, stream->pending_size, &stream->cert_size)) {
+                LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                               "!!! CertChainStream - FAIL (invalid certificate) !!!\n"));
+                return false;
+            }
+            if ((stream->cert_size > LIBSPDM_MAX_CERT_SIZE) ||
+                ((stream->cert_size != 0) && (stream->cert_size < stream->pending_size))) {
+                LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                               "!!! CertChainStream - FAIL (certificate size) !!!\n"));
+                return false;
+            }
+        }
+        if ((stream->cert_size != 0) && (stream->pending_size == stream->cert_size)) {
+            if (!libspdm_cert_chain_stream_add_cert(stream)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * This function completes the verification of the certificate chain buffer,
+ * and releases the stream.
+ *
+ * @param  stream                         The certificate chain stream.
+ * @param  cert_chain_hash                The hash of the certificate chain buffer.
+ *
+ * @retval true  certificate chain buffer integrity verification pass.
+ * @retval false certificate chain buffer integrity verification fail.
+ **/
+bool libspdm_cert_chain_stream_final(libspdm_cert_chain_stream_t *stream,
+                                     uint8_t *cert_chain_hash)
+{
+    const uint8_t *leaf_cert;
+    uintn leaf_cert_size;
+
+    if ((stream->pending_size != 0) ||
+        !libspdm_cert_chain_stream_get_leaf_cert(stream, &leaf_cert, &leaf_cert_size)) {
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                       "!!! CertChainStream - FAIL (incomplete certificate chain) !!!\n"));
+        libspdm_hash_state_free(&stream->hash_state);
+        return false;
+    }
+
+    if (stream->verify &&
+        !libspdm_x509_certificate_check(leaf_cert, leaf_cert_size,
+                                        stream->base_asym_algo, stream->base_hash_algo,
+                                        stream->is_device_cert_model)) {
+        LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
+                       "!!! CertChainStream - FAIL (leaf certificate check failed) !!!\n"));
+        libspdm_hash_state_free(&stream->hash_state);
+        return false;
+    }
+
+    return libspdm_hash_state_final(&stream->hash_state, cert_chain_hash);
+}
+
+/**
+ * This function returns the last complete certificate of the stream, which is the leaf
+ * certificate once libspdm_cert_chain_stream_final() succeeds.
+ *
+ * @param  stream                         The certificate chain stream.
+ * @param  cert                           The last complete certificate.
+ * @param  cert_size                      size in bytes of the certificate.
+ *
+ * @retval true  the certificate is returned.
+ * @retval false no certificate is complete.
+ **/
+bool libspdm_cert_chain_stream_get_leaf_cert(const libspdm_cert_chain_stream_t *stream,
+                                             const uint8_t **cert, uintn *cert_size)
+{
+    if (stream->cert_count == 0) {
+        return false;
+    }
+    *cert = stream->cert[stream->issuer_slot];
+    *cert_size = stream->issuer_size;
+    return true;
+}
+
+/**
+ * This function releases the stream without completing the verification.
+ *
+ * @param  stream                         The certificate chain stream.
+ **/
+void libspdm_cert_chain_stream_free(libspdm_cert_chain_stream_t *stream)
+{
+    libspdm_hash_state_free(&stream->hash_state);
+}
+
 /**
  * Retrieve the asymmetric public key from one DER-encoded X509 certificate,
  * based upon negotiated asymmetric or requester asymmetric algorithm.
@@ -0,0 +1,273 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "internal/libspdm_requester_lib.h"
+#include "hal/library/platform_lib.h"
+
+/**
+ * Record that an attestation step was sent, and add how long it took.
+ *
+ * @param  evidence                      The evidence of the attestation.
+ * @param  step                          The LIBSPDM_ATTEST_STEP_* of the step.
+ * @param  start_time                    The time stamp taken before the step.
+ **/
+static void libspdm_attest_record_step(libspdm_attest_evidence_t *evidence, uint8_t step,
+                                       uint64_t start_time)
+{
+    evidence->step_mask |= (uint8_t)(1 << step);
+    evidence->step_time_ns[step] += libspdm_get_time_ns() - start_time;
+}
+
+#if LIBSPDM_ENABLE_CAPABILITY_CERT_CAP
+/**
+ * Return the digest of the peer certificate chain that was verified before, if any.
+ *
+ * The certificate chain of the peer is kept across connections, so the digest is of the
+ * base hash algorithm negotiated when the certificate chain was verified. The certificate chain
+ * may be of another slot, see connection_info.peer_used_cert_chain_slot_id.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  hash                          The digest of the certificate chain.
+ *
+ * @retval true   A verified certificate chain is cached.
+ * @retval false  No verified certificate chain is cached.
+ **/
+static bool libspdm_attest_get_cached_cert_chain_hash(libspdm_context_t *spdm_context,
+                                                      uint8_t *hash)
+{
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    if (spdm_context->connection_info.peer_used_cert_chain_buffer_size == 0) {
+        return false;
+    }
+    return libspdm_hash_all(spdm_context->connection_info.algorithm.base_hash_algo,
+                            spdm_context->connection_info.peer_used_cert_chain_buffer,
+                            spdm_context->connection_info.peer_used_cert_chain_buffer_size,
+                            hash);
+#else
+    if ((spdm_context->connection_info.peer_used_cert_chain_buffer_hash_size !=
+         libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo)) ||
+        (spdm_context->connection_info.peer_used_leaf_cert_public_key == NULL)) {
+        return false;
+    }
+    libspdm_copy_mem(hash, LIBSPDM_MAX_HASH_SIZE,
+                     spdm_context->connection_info.peer_used_cert_chain_buffer_hash,
+                     spdm_context->connection_info.peer_used_cert_chain_buffer_hash_size);
+    return true;
+#endif
+}
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CERT_CAP*/
+
+/**
+ * This function attests the device with the fewest requests and signatures the negotiated
+ * capabilities allow.
+ *
+ * - VCA is skipped if the connection is already negotiated.
+ * - GET_DIGESTS is skipped past NEGOTIATED, the certificate chain of this connection is known.
+ * - GET_CERTIFICATE is skipped if the certificate chain verified before is of the slot, and
+ *   it matches the digest of the slot, even in a previous connection. Past NEGOTIATED, the
+ *   certificate chain of another slot is requested again.
+ * - CHALLENGE is skipped if the measurements are requested and the device signs them,
+ *   because the signed MEASUREMENTS response authenticates the device on its own.
+ *   CHALLENGE is only sent if the device rejects GET_MEASUREMENTS with an ERROR before it.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  slot_id                      The number of slot for the certificate chain.
+ * @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+ *                                     On output, indicate the size in bytes of the measurement record.
+ *                                     NULL if no measurements are requested.
+ * @param  measurement_record            A pointer to a destination buffer to store all measurement blocks.
+ *                                     NULL if no measurements are requested.
+ * @param  evidence                      The evidence of the attestation.
+ *
+ * @retval RETURN_SUCCESS               The device is attested, evidence->authenticated tells if
+ *                                     a signature was verified.
+ * @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+ * @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+ **/
+return_status libspdm_attest(void *context, uint8_t slot_id,
+                             uint32_t *measurement_record_length,
+                             void *measurement_record,
+                             libspdm_attest_evidence_t *evidence)
+{
+    libspdm_context_t *spdm_context;
+    return_status status;
+    uint64_t start_time;
+    bool get_measurements;
+    bool signed_measurements;
+#if LIBSPDM_ENABLE_CAPABILITY_CERT_CAP
+    uint8_t slot_mask;
+    uint8_t total_digest_buffer[LIBSPDM_MAX_HASH_SIZE * SPDM_MAX_SLOT_COUNT];
+    uint8_t cached_hash[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t index;
+    uint8_t digest_index;
+    bool cert_chain_cached;
+    bool digest_received;
+#endif
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+    uint8_t request_attribute;
+#endif
+
+    spdm_context = context;
+    if ((evidence == NULL) || (slot_id >= SPDM_MAX_SLOT_COUNT) ||
+        ((measurement_record_length == NULL) != (measurement_record == NULL))) {
+        return RETURN_INVALID_PARAMETER;
+    }
+    libspdm_zero_mem(evidence, sizeof(libspdm_attest_evidence_t));
+    evidence->slot_id = slot_id;
+
+    if (spdm_context->connection_info.connection_state < LIBSPDM_CONNECTION_STATE_NEGOTIATED) {
+        start_time = libspdm_get_time_ns();
+        status = libspdm_init_connection(spdm_context, false);
+        libspdm_attest_record_step(evidence, LIBSPDM_ATTEST_STEP_INIT_CONNECTION, start_time);
+        if (RETURN_ERROR(status)) {
+            return status;
+        }
+    }
+
+    get_measurements = (measurement_record != NULL) &&
+                       libspdm_is_capabilities_flag_supported(
+        spdm_context, true, 0, SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP);
+    signed_measurements = get_measurements &&
+                          libspdm_is_capabilities_flag_supported(
+        spdm_context, true, 0, SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG);
+
+#if LIBSPDM_ENABLE_CAPABILITY_CERT_CAP
+    if (libspdm_is_capabilities_flag_supported(
+            spdm_context, true, 0, SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP)) {
+        evidence->cert_chain_hash_size =
+            libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+        /* Only the certificate chain of the slot is reused.*/
+        cert_chain_cached = (spdm_context->connection_info.peer_used_cert_chain_slot_id ==
+                             slot_id) &&
+                            libspdm_attest_get_cached_cert_chain_hash(spdm_context, cached_hash);
+
+        /* GET_DIGESTS is only allowed right after the negotiation. Past it, the certificate
+         * chain of this connection is already known.*/
+        digest_received = (spdm_context->connection_info.connection_state ==
+                           LIBSPDM_CONNECTION_STATE_NEGOTIATED);
+        if (digest_received) {
+            start_time = libspdm_get_time_ns();
+            status = libspdm_get_digest(spdm_context, &slot_mask, total_digest_buffer);
+            libspdm_attest_record_step(evidence, LIBSPDM_ATTEST_STEP_GET_DIGESTS, start_time);
+            if (RETURN_ERROR(status)) {
+                return status;
+            }
+            if ((slot_mask & (1 << slot_id)) == 0) {
+                return RETURN_DEVICE_ERROR;
+            }
+            /* the digests are packed in slot order*/
+            digest_index = 0;
+            for (index = 0; index < slot_id; index++) {
+                if ((slot_mask & (1 << index)) != 0) {
+                    digest_index++;
+                }
+            }
+            libspdm_copy_mem(evidence->cert_chain_hash, sizeof(evidence->cert_chain_hash),
+                             total_digest_buffer + digest_index * evidence->cert_chain_hash_size,
+                             evidence->cert_chain_hash_size);
+            cert_chain_cached = cert_chain_cached &&
+                                libspdm_const_compare_mem(cached_hash,
+                                                          evidence->cert_chain_hash,
+                                                          evidence->cert_chain_hash_size) == 0;
+        } else if (cert_chain_cached) {
+            libspdm_copy_mem(evidence->cert_chain_hash, sizeof(evidence->cert_chain_hash),
+                             cached_hash, evidence->cert_chain_hash_size);
+        }
+
+        if (!cert_chain_cached) {
+            start_time = libspdm_get_time_ns();
+            status = libspdm_get_certificate(spdm_context, slot_id, NULL, NULL);
+            libspdm_attest_record_step(evidence, LIBSPDM_ATTEST_STEP_GET_CERTIFICATE,
+                                       start_time);
+            if (RETURN_ERROR(status)) {
+                return status;
+            }
+            if (!libspdm_attest_get_cached_cert_chain_hash(spdm_context, cached_hash)) {
+                return RETURN_SECURITY_VIOLATION;
+            }
+            /* the certificate chain must be the one the digest of the slot is of*/
+            if (digest_received &&
+                (libspdm_const_compare_mem(cached_hash, evidence->cert_chain_hash,
+                                           evidence->cert_chain_hash_size) != 0)) {
+                return RETURN_SECURITY_VIOLATION;
+            }
+            libspdm_copy_mem(evidence->cert_chain_hash, sizeof(evidence->cert_chain_hash),
+                             cached_hash, evidence->cert_chain_hash_size);
+        }
+    }
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CERT_CAP*/
+
+#if LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP
+    if (!signed_measurements &&
+        libspdm_is_capabilities_flag_supported(
+            spdm_context, true, 0, SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP)) {
+        start_time = libspdm_get_time_ns();
+        status = libspdm_challenge(
+            spdm_context, slot_id,
+            SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH, NULL, NULL);
+        libspdm_attest_record_step(evidence, LIBSPDM_ATTEST_STEP_CHALLENGE, start_time);
+        if (RETURN_ERROR(status)) {
+            return status;
+        }
+        evidence->authenticated = true;
+    }
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP*/
+
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+    if (get_measurements) {
+        if (signed_measurements) {
+            request_attribute = SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE;
+        } else {
+            request_attribute = 0;
+        }
+        start_time = libspdm_get_time_ns();
+        status = libspdm_get_measurement(
+            spdm_context, NULL, request_attribute,
+            SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+            slot_id, &evidence->content_changed, &evidence->number_of_blocks,
+            measurement_record_length, measurement_record);
+        libspdm_attest_record_step(evidence, LIBSPDM_ATTEST_STEP_GET_MEASUREMENTS, start_time);
+#if LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP
+        /* A device may still require CHALLENGE before GET_MEASUREMENTS out of a session,
+         * it rejects GET_MEASUREMENTS with an ERROR response then.*/
+        if ((status == RETURN_DEVICE_ERROR) && (spdm_context->peer_error_code != 0) &&
+            signed_measurements &&
+            libspdm_is_capabilities_flag_supported(
+                spdm_context, true, 0, SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP)) {
+            start_time = libspdm_get_time_ns();
+            status = libspdm_challenge(
+                spdm_context, slot_id,
+                SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH, NULL, NULL);
+            libspdm_attest_record_step(evidence, LIBSPDM_ATTEST_STEP_CHALLENGE, start_time);
+            if (RETURN_ERROR(status)) {
+                return status;
+            }
+            start_time = libspdm_get_time_ns();
+            status = libspdm_get_measurement(
+                spdm_context, NULL, request_attribute,
+                SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+                slot_id, &evidence->content_changed, &evidence->number_of_blocks,
+                measurement_record_length, measurement_record);
+            libspdm_attest_record_step(evidence, LIBSPDM_ATTEST_STEP_GET_MEASUREMENTS,
+                                       start_time);
+        }
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP*/
+        if (RETURN_ERROR(status)) {
+            return status;
+        }
+        if (signed_measurements) {
+            evidence->authenticated = true;
+        }
+    }
+#else
+    if (get_measurements) {
+        return RETURN_UNSUPPORTED;
+    }
+    (void)signed_measurements;
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
+
+    return RETURN_SUCCESS;
+}
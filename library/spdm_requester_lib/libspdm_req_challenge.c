@@ -69,6 +69,7 @@ return_status libspdm_try_challenge(void *context, uint8_t slot_id,
     uintn signature_size;
     libspdm_context_t *spdm_context;
     uint8_t auth_attribute;
+    uint64_t start_time;
 
     LIBSPDM_ASSERT((slot_id < SPDM_MAX_SLOT_COUNT) || (slot_id == 0xff));
 
@@ -261,8 +262,10 @@ return_status libspdm_try_challenge(void *context, uint8_t slot_id,
     signature = ptr;
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "signature (0x%x):\n", signature_size));
     libspdm_internal_dump_hex(signature, signature_size);
+    start_time = libspdm_trace_begin(spdm_context);
     result = libspdm_verify_challenge_auth_signature(
         spdm_context, true, signature, signature_size);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_VERIFY, INVALID_SESSION_ID, 0, start_time);
     if (!result) {
         libspdm_reset_message_c(spdm_context);
         spdm_context->error_state =
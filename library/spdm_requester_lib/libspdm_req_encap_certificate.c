@@ -81,9 +81,11 @@ return_status libspdm_get_encap_response_certificate(void *context,
 
     offset = spdm_request->offset;
     length = spdm_request->length;
-    if (length > LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN) {
-        length = LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN;
-    }
+    /* The CERTIFICATE response is delivered in DELIVER_ENCAPSULATED_RESPONSE.*/
+    length = MIN(length, libspdm_get_cert_chain_block_len(
+                     spdm_context, false,
+                     sizeof(spdm_deliver_encapsulated_response_request_t) +
+                     sizeof(spdm_certificate_response_t)));
 
     if (offset >= spdm_context->local_context
         .local_cert_chain_provision_size[slot_id]) {
@@ -42,6 +42,7 @@ return_status libspdm_get_encap_response_challenge_auth(
     uint8_t auth_attribute;
     return_status status;
     uintn response_capacity;
+    uint64_t start_time;
 
     spdm_context = context;
     spdm_request = request;
@@ -153,8 +154,10 @@ return_status libspdm_get_encap_response_challenge_auth(
             spdm_context, SPDM_ERROR_CODE_UNSPECIFIED, 0,
             response_size, response);
     }
+    start_time = libspdm_trace_begin(spdm_context);
     result =
         libspdm_generate_challenge_auth_signature(spdm_context, true, ptr);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_SIGN, INVALID_SESSION_ID, 0, start_time);
     if (!result) {
         return libspdm_generate_encap_error_response(
             spdm_context, SPDM_ERROR_CODE_UNSPECIFIED,
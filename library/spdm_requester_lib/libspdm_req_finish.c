@@ -49,6 +49,7 @@ return_status libspdm_try_send_receive_finish(libspdm_context_t *spdm_context,
     bool result;
     uint8_t th2_hash_data[64];
     libspdm_session_state_t session_state;
+    uint64_t start_time;
 
     if (!libspdm_is_capabilities_flag_supported(
             spdm_context, true,
@@ -137,8 +138,10 @@ return_status libspdm_try_send_receive_finish(libspdm_context_t *spdm_context,
         goto error;
     }
     if (session_info->mut_auth_requested) {
+        start_time = libspdm_trace_begin(spdm_context);
         result = libspdm_generate_finish_req_signature(spdm_context,
                                                        session_info, ptr);
+        libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_SIGN, session_id, 0, start_time);
         if (!result) {
             status = RETURN_SECURITY_VIOLATION;
             goto error;
@@ -255,14 +258,18 @@ return_status libspdm_try_send_receive_finish(libspdm_context_t *spdm_context,
     }
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_data_key[%x]\n", session_id));
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_calculate_th2_hash(spdm_context, session_info, true,
                                         th2_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_HASH, session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         status = RETURN_SECURITY_VIOLATION;
         goto error;
     }
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_generate_session_data_key(
         session_info->secured_message_context, th2_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_KEY_DERIVATION, session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         status = RETURN_SECURITY_VIOLATION;
         goto error;
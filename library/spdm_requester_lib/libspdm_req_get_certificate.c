@@ -8,17 +8,6 @@
 
 #if LIBSPDM_ENABLE_CAPABILITY_CERT_CAP
 
-#pragma pack(1)
-
-typedef struct {
-    spdm_message_header_t header;
-    uint16_t portion_length;
-    uint16_t remainder_length;
-    uint8_t cert_chain[LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN];
-} libspdm_certificate_response_max_t;
-
-#pragma pack()
-
 /**
  * This function sends GET_CERTIFICATE
  * to get certificate chain in one slot from device.
@@ -31,7 +20,7 @@ typedef struct {
  *
  * @param  spdm_context                  A pointer to the SPDM context.
  * @param  slot_id                      The number of slot for the certificate chain.
- * @param  length                       length parameter in the get_certificate message (limited by LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN).
+ * @param  length                       length parameter in the get_certificate message (limited by libspdm_get_cert_chain_block_len()).
  * @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
  *                                     On output, indicate the size in bytes of the certificate chain.
  * @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
@@ -52,12 +41,20 @@ return_status libspdm_try_get_certificate(void *context, uint8_t slot_id,
     bool result;
     return_status status;
     spdm_get_certificate_request_t spdm_request;
-    libspdm_certificate_response_max_t spdm_response;
+    libspdm_certificate_response_max_t *spdm_response;
     uintn spdm_response_size;
-    libspdm_large_managed_buffer_t certificate_chain_buffer;
+    libspdm_large_managed_buffer_t *certificate_chain_buffer;
+    libspdm_cert_chain_stream_t *cert_chain_stream;
     libspdm_context_t *spdm_context;
-    uint16_t total_responder_cert_chain_buffer_length;
-    uintn cert_chain_capacity;
+    uint32_t total_responder_cert_chain_buffer_length;
+    uintn received_cert_chain_size;
+    bool verify_cert_chain;
+    bool collect_cert_chain;
+    uint8_t cert_chain_hash[LIBSPDM_MAX_HASH_SIZE];
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    const uint8_t *leaf_cert;
+    uintn leaf_cert_size;
+#endif
 
     LIBSPDM_ASSERT(slot_id < SPDM_MAX_SLOT_COUNT);
 
@@ -69,6 +66,9 @@ return_status libspdm_try_get_certificate(void *context, uint8_t slot_id,
     }
     libspdm_reset_message_buffer_via_request_code(spdm_context, NULL,
                                                   SPDM_GET_CERTIFICATE);
+    spdm_response = &spdm_context->get_certificate_context.response;
+    certificate_chain_buffer = &spdm_context->get_certificate_context.cert_chain_buffer;
+    cert_chain_stream = &spdm_context->get_certificate_context.cert_chain_stream;
     if ((spdm_context->connection_info.connection_state !=
          LIBSPDM_CONNECTION_STATE_NEGOTIATED) &&
         (spdm_context->connection_info.connection_state !=
@@ -78,9 +78,27 @@ return_status libspdm_try_get_certificate(void *context, uint8_t slot_id,
         return RETURN_UNSUPPORTED;
     }
 
-    libspdm_init_managed_buffer(&certificate_chain_buffer,
-                                LIBSPDM_MAX_MESSAGE_BUFFER_SIZE);
-    length = MIN(length, LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN);
+    /* Each certificate is verified as soon as it is received. The whole chain is only kept
+     * if it is recorded, or if the integrator verifies it.*/
+    verify_cert_chain = (spdm_context->local_context.verify_peer_spdm_cert_chain == NULL);
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    collect_cert_chain = true;
+#else
+    collect_cert_chain = !verify_cert_chain;
+#endif
+    if (collect_cert_chain) {
+        libspdm_init_managed_buffer(certificate_chain_buffer,
+                                    LIBSPDM_MAX_MESSAGE_BUFFER_SIZE);
+    }
+    if (verify_cert_chain &&
+        !libspdm_verify_peer_cert_chain_stream_init(spdm_context, cert_chain_stream,
+                                                    true, true)) {
+        return RETURN_DEVICE_ERROR;
+    }
+    received_cert_chain_size = 0;
+    total_responder_cert_chain_buffer_length = 0;
+    length = MIN(length, libspdm_get_cert_chain_block_len(spdm_context, true,
+                                                          sizeof(spdm_certificate_response_t)));
 
     spdm_context->error_state = LIBSPDM_STATUS_ERROR_DEVICE_NO_CAPABILITIES;
 
@@ -91,12 +109,11 @@ return_status libspdm_try_get_certificate(void *context, uint8_t slot_id,
             SPDM_GET_CERTIFICATE;
         spdm_request.header.param1 = slot_id;
         spdm_request.header.param2 = 0;
-        spdm_request.offset = (uint16_t)libspdm_get_managed_buffer_size(
-            &certificate_chain_buffer);
+        spdm_request.offset = (uint16_t)received_cert_chain_size;
         if (spdm_request.offset == 0) {
             spdm_request.length = length;
         } else {
-            spdm_request.length = MIN(length, spdm_response.remainder_length);
+            spdm_request.length = MIN(length, spdm_response->remainder_length);
         }
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "request (offset 0x%x, size 0x%x):\n",
                        spdm_request.offset, spdm_request.length));
@@ -108,11 +125,11 @@ return_status libspdm_try_get_certificate(void *context, uint8_t slot_id,
             goto done;
         }
 
-        spdm_response_size = sizeof(spdm_response);
-        libspdm_zero_mem(&spdm_response, sizeof(spdm_response));
+        spdm_response_size = sizeof(*spdm_response);
+        libspdm_zero_mem(spdm_response, sizeof(*spdm_response));
         status = libspdm_receive_spdm_response(spdm_context, NULL,
                                                &spdm_response_size,
-                                               &spdm_response);
+                                               spdm_response);
         if (RETURN_ERROR(status)) {
             goto done;
         }
@@ -120,20 +137,21 @@ return_status libspdm_try_get_certificate(void *context, uint8_t slot_id,
             status = RETURN_DEVICE_ERROR;
             goto done;
         }
-        if (spdm_response.header.spdm_version != spdm_request.header.spdm_version) {
-            return RETURN_DEVICE_ERROR;
+        if (spdm_response->header.spdm_version != spdm_request.header.spdm_version) {
+            status = RETURN_DEVICE_ERROR;
+            goto done;
         }
-        if (spdm_response.header.request_response_code == SPDM_ERROR) {
+        if (spdm_response->header.request_response_code == SPDM_ERROR) {
             status = libspdm_handle_error_response_main(
                 spdm_context, NULL,
                 &spdm_response_size,
-                &spdm_response, SPDM_GET_CERTIFICATE,
+                spdm_response, SPDM_GET_CERTIFICATE,
                 SPDM_CERTIFICATE,
                 sizeof(libspdm_certificate_response_max_t));
             if (RETURN_ERROR(status)) {
                 goto done;
             }
-        } else if (spdm_response.header.request_response_code !=
+        } else if (spdm_response->header.request_response_code !=
                    SPDM_CERTIFICATE) {
             status = RETURN_DEVICE_ERROR;
             goto done;
@@ -142,35 +160,40 @@ return_status libspdm_try_get_certificate(void *context, uint8_t slot_id,
             status = RETURN_DEVICE_ERROR;
             goto done;
         }
-        if (spdm_response_size > sizeof(spdm_response)) {
+        if (spdm_response_size > sizeof(*spdm_response)) {
             status = RETURN_DEVICE_ERROR;
             goto done;
         }
-        if ((spdm_response.portion_length > spdm_request.length) ||
-            (spdm_response.portion_length == 0)) {
+        if ((spdm_response->portion_length > spdm_request.length) ||
+            (spdm_response->portion_length == 0)) {
             status = RETURN_DEVICE_ERROR;
             goto done;
         }
-        if ((spdm_response.header.param1 & SPDM_CERTIFICATE_RESPONSE_SLOT_ID_MASK) != slot_id) {
+        if ((spdm_response->header.param1 & SPDM_CERTIFICATE_RESPONSE_SLOT_ID_MASK) != slot_id) {
             status = RETURN_DEVICE_ERROR;
             goto done;
         }
         if (spdm_response_size < sizeof(spdm_certificate_response_t) +
-            spdm_response.portion_length) {
+            spdm_response->portion_length) {
             status = RETURN_DEVICE_ERROR;
             goto done;
         }
         if (spdm_request.offset == 0) {
-            total_responder_cert_chain_buffer_length = spdm_response.portion_length +
-                                                       spdm_response.remainder_length;
-        } else if (spdm_request.offset + spdm_response.portion_length +
-                   spdm_response.remainder_length != total_responder_cert_chain_buffer_length) {
+            total_responder_cert_chain_buffer_length = (uint32_t)spdm_response->portion_length +
+                                                       spdm_response->remainder_length;
+            /* the offset of the next request must fit*/
+            if (total_responder_cert_chain_buffer_length > MAX_UINT16) {
+                status = RETURN_DEVICE_ERROR;
+                goto done;
+            }
+        } else if ((uint32_t)spdm_request.offset + spdm_response->portion_length +
+                   spdm_response->remainder_length != total_responder_cert_chain_buffer_length) {
             status = RETURN_DEVICE_ERROR;
             goto done;
         }
 
         spdm_response_size = sizeof(spdm_certificate_response_t) +
-                             spdm_response.portion_length;
+                             spdm_response->portion_length;
 
         /* Cache data*/
 
@@ -180,7 +203,7 @@ return_status libspdm_try_get_certificate(void *context, uint8_t slot_id,
             status = RETURN_SECURITY_VIOLATION;
             goto done;
         }
-        status = libspdm_append_message_b(spdm_context, &spdm_response,
+        status = libspdm_append_message_b(spdm_context, spdm_response,
                                           spdm_response_size);
         if (RETURN_ERROR(status)) {
             status = RETURN_SECURITY_VIOLATION;
@@ -188,39 +211,59 @@ return_status libspdm_try_get_certificate(void *context, uint8_t slot_id,
         }
 
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "Certificate (offset 0x%x, size 0x%x):\n",
-                       spdm_request.offset, spdm_response.portion_length));
-        libspdm_internal_dump_hex(spdm_response.cert_chain,
-                                  spdm_response.portion_length);
+                       spdm_request.offset, spdm_response->portion_length));
+        libspdm_internal_dump_hex(spdm_response->cert_chain,
+                                  spdm_response->portion_length);
+
+        if (collect_cert_chain) {
+            status = libspdm_append_managed_buffer(certificate_chain_buffer,
+                                                   spdm_response->cert_chain,
+                                                   spdm_response->portion_length);
+            if (RETURN_ERROR(status)) {
+                status = RETURN_SECURITY_VIOLATION;
+                goto done;
+            }
+        }
+        spdm_context->connection_info.connection_state =
+            LIBSPDM_CONNECTION_STATE_AFTER_CERTIFICATE;
 
-        status = libspdm_append_managed_buffer(&certificate_chain_buffer,
-                                               spdm_response.cert_chain,
-                                               spdm_response.portion_length);
-        if (RETURN_ERROR(status)) {
+        /* Stop at the first invalid certificate, instead of getting the rest of the chain.*/
+        if (verify_cert_chain &&
+            !libspdm_verify_peer_cert_chain_stream_update(spdm_context, cert_chain_stream,
+                                                          spdm_response->cert_chain,
+                                                          spdm_response->portion_length)) {
+            spdm_context->error_state =
+                LIBSPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
             status = RETURN_SECURITY_VIOLATION;
             goto done;
         }
-        spdm_context->connection_info.connection_state =
-            LIBSPDM_CONNECTION_STATE_AFTER_CERTIFICATE;
 
-    } while (spdm_response.remainder_length != 0);
+        if ((cert_chain_size != NULL) && (cert_chain != NULL) &&
+            (received_cert_chain_size + spdm_response->portion_length <= *cert_chain_size)) {
+            libspdm_copy_mem((uint8_t *)cert_chain + received_cert_chain_size,
+                             *cert_chain_size - received_cert_chain_size,
+                             spdm_response->cert_chain, spdm_response->portion_length);
+        }
+        received_cert_chain_size += spdm_response->portion_length;
 
-    if (spdm_context->local_context.verify_peer_spdm_cert_chain != NULL) {
-        status = spdm_context->local_context.verify_peer_spdm_cert_chain (
-            spdm_context, slot_id, libspdm_get_managed_buffer_size(&certificate_chain_buffer),
-            libspdm_get_managed_buffer(&certificate_chain_buffer),
+    } while (spdm_response->remainder_length != 0);
+
+    if (verify_cert_chain) {
+        result = libspdm_verify_peer_cert_chain_stream_final(
+            spdm_context, cert_chain_stream, cert_chain_hash,
             trust_anchor, trust_anchor_size);
-        if (RETURN_ERROR(status)) {
+        if (!result) {
             spdm_context->error_state =
                 LIBSPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
             status = RETURN_SECURITY_VIOLATION;
             goto done;
         }
     } else {
-        result = libspdm_verify_peer_cert_chain_buffer(
-            spdm_context, libspdm_get_managed_buffer(&certificate_chain_buffer),
-            libspdm_get_managed_buffer_size(&certificate_chain_buffer),
-            trust_anchor, trust_anchor_size, true);
-        if (!result) {
+        status = spdm_context->local_context.verify_peer_spdm_cert_chain (
+            spdm_context, slot_id, libspdm_get_managed_buffer_size(certificate_chain_buffer),
+            libspdm_get_managed_buffer(certificate_chain_buffer),
+            trust_anchor, trust_anchor_size);
+        if (RETURN_ERROR(status)) {
             spdm_context->error_state =
                 LIBSPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
             status = RETURN_SECURITY_VIOLATION;
@@ -230,17 +273,42 @@ return_status libspdm_try_get_certificate(void *context, uint8_t slot_id,
 
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     spdm_context->connection_info.peer_used_cert_chain_buffer_size =
-        libspdm_get_managed_buffer_size(&certificate_chain_buffer);
+        libspdm_get_managed_buffer_size(certificate_chain_buffer);
     libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
                      sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer),
-                     libspdm_get_managed_buffer(&certificate_chain_buffer),
-                     libspdm_get_managed_buffer_size(&certificate_chain_buffer));
+                     libspdm_get_managed_buffer(certificate_chain_buffer),
+                     libspdm_get_managed_buffer_size(certificate_chain_buffer));
+    libspdm_build_peer_used_cert_chain_index(spdm_context);
 #else
-    result = libspdm_hash_all(
-        spdm_context->connection_info.algorithm.base_hash_algo,
-        libspdm_get_managed_buffer(&certificate_chain_buffer),
-        libspdm_get_managed_buffer_size(&certificate_chain_buffer),
-        spdm_context->connection_info.peer_used_cert_chain_buffer_hash);
+    if (verify_cert_chain) {
+        libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer_hash,
+                         sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer_hash),
+                         cert_chain_hash,
+                         libspdm_get_hash_size(
+                             spdm_context->connection_info.algorithm.base_hash_algo));
+        result = libspdm_cert_chain_stream_get_leaf_cert(cert_chain_stream,
+                                                         &leaf_cert, &leaf_cert_size);
+        if (result) {
+            result = libspdm_asym_get_public_key_from_x509(
+                spdm_context->connection_info.algorithm.base_asym_algo,
+                leaf_cert, leaf_cert_size,
+                &spdm_context->connection_info.peer_used_leaf_cert_public_key);
+        }
+    } else {
+        result = libspdm_hash_all(
+            spdm_context->connection_info.algorithm.base_hash_algo,
+            libspdm_get_managed_buffer(certificate_chain_buffer),
+            libspdm_get_managed_buffer_size(certificate_chain_buffer),
+            spdm_context->connection_info.peer_used_cert_chain_buffer_hash);
+        if (result) {
+            result = libspdm_get_leaf_cert_public_key_from_cert_chain(
+                spdm_context->connection_info.algorithm.base_hash_algo,
+                spdm_context->connection_info.algorithm.base_asym_algo,
+                libspdm_get_managed_buffer(certificate_chain_buffer),
+                libspdm_get_managed_buffer_size(certificate_chain_buffer),
+                &spdm_context->connection_info.peer_used_leaf_cert_public_key);
+        }
+    }
     if (!result) {
         spdm_context->error_state =
             LIBSPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
@@ -250,43 +318,25 @@ return_status libspdm_try_get_certificate(void *context, uint8_t slot_id,
 
     spdm_context->connection_info.peer_used_cert_chain_buffer_hash_size =
         libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
-
-    result = libspdm_get_leaf_cert_public_key_from_cert_chain(
-        spdm_context->connection_info.algorithm.base_hash_algo,
-        spdm_context->connection_info.algorithm.base_asym_algo,
-        libspdm_get_managed_buffer(&certificate_chain_buffer),
-        libspdm_get_managed_buffer_size(&certificate_chain_buffer),
-        &spdm_context->connection_info.peer_used_leaf_cert_public_key);
-    if (!result) {
-        spdm_context->error_state =
-            LIBSPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
-        status = RETURN_SECURITY_VIOLATION;
-        goto done;
-    }
 #endif
+    spdm_context->connection_info.peer_used_cert_chain_slot_id = slot_id;
 
     spdm_context->error_state = LIBSPDM_STATUS_SUCCESS;
 
     if (cert_chain_size != NULL) {
-        if (*cert_chain_size <
-            libspdm_get_managed_buffer_size(&certificate_chain_buffer)) {
-            *cert_chain_size = libspdm_get_managed_buffer_size(
-                &certificate_chain_buffer);
-            return RETURN_BUFFER_TOO_SMALL;
-        }
-        cert_chain_capacity = *cert_chain_size;
-        *cert_chain_size =
-            libspdm_get_managed_buffer_size(&certificate_chain_buffer);
-        if (cert_chain != NULL) {
-            libspdm_copy_mem(cert_chain,
-                             cert_chain_capacity,
-                             libspdm_get_managed_buffer(&certificate_chain_buffer),
-                             libspdm_get_managed_buffer_size(&certificate_chain_buffer));
+        if (*cert_chain_size < received_cert_chain_size) {
+            *cert_chain_size = received_cert_chain_size;
+            status = RETURN_BUFFER_TOO_SMALL;
+            goto done;
         }
+        *cert_chain_size = received_cert_chain_size;
     }
 
     status = RETURN_SUCCESS;
 done:
+    if (verify_cert_chain) {
+        libspdm_cert_chain_stream_free(cert_chain_stream);
+    }
     return status;
 }
 
@@ -315,7 +365,7 @@ return_status libspdm_get_certificate(void *context, uint8_t slot_id,
                                       void *cert_chain)
 {
     return libspdm_get_certificate_choose_length(context, slot_id,
-                                                 LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN,
+                                                 LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN,
                                                  cert_chain_size, cert_chain);
 }
 
@@ -348,7 +398,7 @@ return_status libspdm_get_certificate_ex(void *context, uint8_t slot_id,
                                          uintn *trust_anchor_size)
 {
     return libspdm_get_certificate_choose_length_ex(context, slot_id,
-                                                    LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN,
+                                                    LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN,
                                                     cert_chain_size, cert_chain,
                                                     trust_anchor, trust_anchor_size);
 }
@@ -365,7 +415,7 @@ return_status libspdm_get_certificate_ex(void *context, uint8_t slot_id,
  *
  * @param  spdm_context                  A pointer to the SPDM context.
  * @param  slot_id                      The number of slot for the certificate chain.
- * @param  length                       length parameter in the get_certificate message (limited by LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN).
+ * @param  length                       length parameter in the get_certificate message (limited by libspdm_get_cert_chain_block_len()).
  * @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
  *                                     On output, indicate the size in bytes of the certificate chain.
  * @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
@@ -410,7 +460,7 @@ return_status libspdm_get_certificate_choose_length(void *context,
  *
  * @param  spdm_context                  A pointer to the SPDM context.
  * @param  slot_id                      The number of slot for the certificate chain.
- * @param  length                       length parameter in the get_certificate message (limited by LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN).
+ * @param  length                       length parameter in the get_certificate message (limited by libspdm_get_cert_chain_block_len()).
  * @param  cert_chain_size                On input, indicate the size in bytes of the destination buffer to store the digest buffer.
  *                                     On output, indicate the size in bytes of the certificate chain.
  * @param  cert_chain                    A pointer to a destination buffer to store the certificate chain.
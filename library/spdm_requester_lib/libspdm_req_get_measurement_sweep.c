@@ -0,0 +1,211 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "internal/libspdm_requester_lib.h"
+
+/**
+ * This function parses a measurement record into a measurement table.
+ *
+ * The measurement is not copied, every table entry points into the measurement record,
+ * so the record must stay valid as long as the table is used.
+ *
+ * @param  measurement_record_length      The size in bytes of the measurement record.
+ * @param  measurement_record            A pointer to the measurement record.
+ * @param  measurement_table             The measurement table to fill.
+ *
+ * @retval true   The measurement record is parsed successfully.
+ * @retval false  The measurement record is malformed, or it holds more than
+ *                LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT blocks.
+ **/
+bool libspdm_parse_measurement_record(uint32_t measurement_record_length,
+                                      const void *measurement_record,
+                                      libspdm_measurement_table_t *measurement_table)
+{
+    const spdm_measurement_block_common_header_t *measurement_block_header;
+    libspdm_measurement_table_entry_t *entry;
+    uint32_t offset;
+
+    if ((measurement_record == NULL) || (measurement_table == NULL)) {
+        return false;
+    }
+
+    measurement_table->number_of_blocks = 0;
+    offset = 0;
+    while (offset < measurement_record_length) {
+        if (measurement_record_length - offset <
+            sizeof(spdm_measurement_block_common_header_t)) {
+            return false;
+        }
+        measurement_block_header = (const void *)((const uint8_t *)measurement_record + offset);
+        offset += sizeof(spdm_measurement_block_common_header_t);
+        if (measurement_block_header->measurement_size > measurement_record_length - offset) {
+            return false;
+        }
+        if (measurement_table->number_of_blocks >= LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT) {
+            return false;
+        }
+
+        entry = &measurement_table->entry[measurement_table->number_of_blocks];
+        entry->index = measurement_block_header->index;
+        entry->measurement_specification = measurement_block_header->measurement_specification;
+        entry->measurement_size = measurement_block_header->measurement_size;
+        entry->measurement = measurement_block_header + 1;
+        measurement_table->number_of_blocks++;
+
+        offset += measurement_block_header->measurement_size;
+    }
+    return true;
+}
+
+/**
+ * This function returns the measurement table entry of a measurement index.
+ *
+ * @param  measurement_table             The measurement table.
+ * @param  index                        The measurement index.
+ *
+ * @return The measurement table entry, or NULL if the table has no block of this index.
+ **/
+const libspdm_measurement_table_entry_t *libspdm_get_measurement_table_entry(
+    const libspdm_measurement_table_t *measurement_table, uint8_t index)
+{
+    uint8_t entry_index;
+
+    for (entry_index = 0; entry_index < measurement_table->number_of_blocks; entry_index++) {
+        if (measurement_table->entry[entry_index].index == index) {
+            return &measurement_table->entry[entry_index];
+        }
+    }
+    return NULL;
+}
+
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+
+/**
+ * This function gets all measurements of the device with a single signature.
+ *
+ * It sends one unsigned GET_MEASUREMENTS for all measurements, then, if the device supports
+ * signed measurements, one signed GET_MEASUREMENTS for the last measurement index, in the same
+ * L1/L2 transcript. The signature of the second response covers both responses, so the whole
+ * measurement set is verified once, in two round trips.
+ *
+ * The measurement indices need not be contiguous. If the device rejects the signed request
+ * with ERROR(InvalidRequest), the previous index is signed instead, down to the first index.
+ * A rejected request is in the L1/L2 of neither side. Any other failure ends the sweep.
+ * The block of the signed response must be the same as in the measurement record, otherwise
+ * the measurements changed between the two responses and the sweep fails with
+ * RETURN_DEVICE_ERROR, so that it can be retried.
+ *
+ * The measurement record buffer receives the block of the signed response after the
+ * measurement record, so it needs room for one more block than the measurement record.
+ * The measurement table points into the measurement record.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+ *                                     If session_id is NULL, it is a normal message.
+ *                                     If session_id is NOT NULL, it is a secured message.
+ * @param  slot_id                      The number of slot for the certificate chain.
+ * @param  content_changed               The measurement content changed output param of the signed response.
+ * @param  measurement_record_length      On input, indicate the size in bytes of the destination buffer to store the measurement record.
+ *                                     On output, indicate the size in bytes of the measurement record.
+ * @param  measurement_record            A pointer to a destination buffer to store the measurement record.
+ * @param  measurement_table             The measurement table of the measurement record, on output.
+ *
+ * @retval RETURN_SUCCESS               The measurements are got successfully.
+ * @retval RETURN_BUFFER_TOO_SMALL      The measurement record buffer is too small.
+ * @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+ * @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+ **/
+return_status libspdm_get_measurement_sweep(void *context, const uint32_t *session_id,
+                                            uint8_t slot_id_param,
+                                            uint8_t *content_changed,
+                                            uint32_t *measurement_record_length,
+                                            void *measurement_record,
+                                            libspdm_measurement_table_t *measurement_table)
+{
+    libspdm_context_t *spdm_context;
+    libspdm_session_info_t *session_info;
+    return_status status;
+    const libspdm_measurement_table_entry_t *entry;
+    const uint8_t *block;
+    uint8_t *signed_block;
+    uint8_t number_of_blocks;
+    uint8_t entry_index;
+    uint32_t record_length;
+    uint32_t block_length;
+
+    spdm_context = context;
+    if ((measurement_record_length == NULL) || (measurement_record == NULL) ||
+        (measurement_table == NULL)) {
+        return RETURN_INVALID_PARAMETER;
+    }
+    session_info = NULL;
+    if (session_id != NULL) {
+        session_info = libspdm_get_session_info_via_session_id(spdm_context, *session_id);
+    }
+
+    /* The unsigned response stays in L1/L2 until the signed response covers it.*/
+    record_length = *measurement_record_length;
+    status = libspdm_get_measurement(
+        spdm_context, session_id, 0,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        slot_id_param, NULL, &number_of_blocks, &record_length, measurement_record);
+    if (RETURN_ERROR(status)) {
+        goto error;
+    }
+    if (!libspdm_parse_measurement_record(record_length, measurement_record,
+                                          measurement_table) ||
+        (measurement_table->number_of_blocks != number_of_blocks) ||
+        (number_of_blocks == 0)) {
+        status = RETURN_DEVICE_ERROR;
+        goto error;
+    }
+
+    if (!libspdm_is_capabilities_flag_supported(
+            spdm_context, true, 0,
+            SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG)) {
+        libspdm_reset_message_m(spdm_context, session_info);
+        *measurement_record_length = record_length;
+        return RETURN_SUCCESS;
+    }
+
+    /* Sign with the last index that the device accepts on its own.*/
+    signed_block = (uint8_t *)measurement_record + record_length;
+    entry_index = measurement_table->number_of_blocks;
+    do {
+        entry_index--;
+        entry = &measurement_table->entry[entry_index];
+        block_length = *measurement_record_length - record_length;
+        status = libspdm_get_measurement(
+            spdm_context, session_id, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+            entry->index, slot_id_param, content_changed, &number_of_blocks, &block_length,
+            signed_block);
+    } while ((status == RETURN_DEVICE_ERROR) &&
+             (spdm_context->peer_error_code == SPDM_ERROR_CODE_INVALID_REQUEST) &&
+             (entry_index != 0));
+    if (RETURN_ERROR(status)) {
+        goto error;
+    }
+
+    block = (const uint8_t *)entry->measurement - sizeof(spdm_measurement_block_common_header_t);
+    if ((number_of_blocks != 1) ||
+        (block_length != sizeof(spdm_measurement_block_common_header_t) +
+         entry->measurement_size) ||
+        (libspdm_const_compare_mem(signed_block, block, block_length) != 0)) {
+        status = RETURN_DEVICE_ERROR;
+        goto error;
+    }
+
+    *measurement_record_length = record_length;
+    return RETURN_SUCCESS;
+
+error:
+    /* Never leave a partial sweep in L1/L2 for the next signed measurement.*/
+    libspdm_reset_message_m(spdm_context, session_info);
+    measurement_table->number_of_blocks = 0;
+    return status;
+}
+
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
@@ -81,6 +81,7 @@ return_status libspdm_try_get_measurement(void *context, const uint32_t *session
     libspdm_context_t *spdm_context;
     libspdm_session_info_t *session_info;
     libspdm_session_state_t session_state;
+    uint64_t start_time;
 
     spdm_context = context;
     if (!libspdm_is_capabilities_flag_supported(
@@ -91,8 +92,9 @@ return_status libspdm_try_get_measurement(void *context, const uint32_t *session
     libspdm_reset_message_buffer_via_request_code(spdm_context, NULL,
                                                   SPDM_GET_MEASUREMENTS);
     if (session_id == NULL) {
+        /* SPDM allows GET_MEASUREMENTS once the algorithms are negotiated.*/
         if (spdm_context->connection_info.connection_state <
-            LIBSPDM_CONNECTION_STATE_AUTHENTICATED) {
+            LIBSPDM_CONNECTION_STATE_NEGOTIATED) {
             return RETURN_UNSUPPORTED;
         }
         session_info = NULL;
@@ -325,8 +327,11 @@ return_status libspdm_try_get_measurement(void *context, const uint32_t *session
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "signature (0x%x):\n", signature_size));
         libspdm_internal_dump_hex(signature, signature_size);
 
+        start_time = libspdm_trace_begin(spdm_context);
         result = libspdm_verify_measurement_signature(
             spdm_context, session_info, signature, signature_size);
+        libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_VERIFY,
+                          (session_id != NULL) ? *session_id : INVALID_SESSION_ID, 0, start_time);
         if (!result) {
             spdm_context->error_state =
                 LIBSPDM_STATUS_ERROR_MEASUREMENT_AUTH_FAILURE;
@@ -335,6 +340,15 @@ return_status libspdm_try_get_measurement(void *context, const uint32_t *session
         }
 
         libspdm_reset_message_m(spdm_context, session_info);
+
+#if LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT
+        /* The measurements moved within this L1/L2, so the cached ones may be stale.*/
+        if ((spdm_response.header.spdm_version >= SPDM_MESSAGE_VERSION_12) &&
+            ((spdm_response.header.param2 & SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_MASK) ==
+             SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED)) {
+            libspdm_invalidate_peer_measurement_cache(spdm_context);
+        }
+#endif
     } else {
         if (spdm_response_size <
             sizeof(spdm_measurements_response_t) +
@@ -85,6 +85,7 @@ return_status libspdm_try_send_receive_key_exchange(
     libspdm_session_info_t *session_info;
     uintn opaque_key_exchange_req_size;
     uint8_t th1_hash_data[64];
+    uint64_t start_time;
 
     LIBSPDM_ASSERT((slot_id < SPDM_MAX_SLOT_COUNT) || (slot_id == 0xff));
 
@@ -404,8 +405,10 @@ return_status libspdm_try_send_receive_key_exchange(
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "signature (0x%x):\n", signature_size));
     libspdm_internal_dump_hex(signature, signature_size);
     ptr += signature_size;
+    start_time = libspdm_trace_begin(spdm_context);
     result = libspdm_verify_key_exchange_rsp_signature(
         spdm_context, session_info, signature, signature_size);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_VERIFY, *session_id, 0, start_time);
     if (!result) {
         libspdm_free_session_id(spdm_context, *session_id);
         libspdm_secured_message_dhe_free(
@@ -442,14 +445,18 @@ return_status libspdm_try_send_receive_key_exchange(
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_handshake_key[%x]\n",
                    *session_id));
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_calculate_th1_hash(spdm_context, session_info, true,
                                         th1_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_HASH, *session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         libspdm_free_session_id(spdm_context, *session_id);
         return RETURN_SECURITY_VIOLATION;
     }
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_generate_session_handshake_key(
         session_info->secured_message_context, th1_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_KEY_DERIVATION, *session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         libspdm_free_session_id(spdm_context, *session_id);
         return RETURN_SECURITY_VIOLATION;
@@ -0,0 +1,269 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "internal/libspdm_requester_lib.h"
+
+#if (LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP) && (LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT)
+
+/**
+ * Return the position of a measurement index in the measurement cache.
+ *
+ * @param  cache                         The measurement cache.
+ * @param  index                        The measurement index.
+ *
+ * @return the position in the cache, or cache->measurement_count if the index is not cached.
+ **/
+static uint8_t libspdm_find_cached_measurement(const libspdm_peer_measurement_cache_t *cache,
+                                              uint8_t index)
+{
+    uint8_t cache_index;
+
+    for (cache_index = 0; cache_index < cache->measurement_count; cache_index++) {
+        if (cache->index[cache_index] == index) {
+            break;
+        }
+    }
+    return cache_index;
+}
+
+/**
+ * This function refreshes the measurement cache of the connection with all measurements
+ * of the device.
+ *
+ * It sends one GET_MEASUREMENTS of all measurements, signed if the device supports signed
+ * measurements, and compares every measurement block with the cached one. The cache is
+ * rewritten, and its generation incremented, only if a block changed, appeared or disappeared.
+ * The unchanged blocks keep the generation in which they last changed.
+ *
+ * The cache is dropped when the connection is reset, and when any signed MEASUREMENTS
+ * response of SPDM 1.2 reports that the measurements changed within its L1/L2.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_id                    Indicates if it is a secured message protected via SPDM session.
+ *                                     If session_id is NULL, it is a normal message.
+ *                                     If session_id is NOT NULL, it is a secured message.
+ * @param  slot_id                      The number of slot for the certificate chain.
+ * @param  generation                    The generation of the measurement cache.
+ *
+ * @retval RETURN_SUCCESS               The measurement cache is refreshed successfully.
+ * @retval RETURN_DEVICE_ERROR          A device error occurs when communicates with the device.
+ * @retval RETURN_SECURITY_VIOLATION    Any verification fails.
+ **/
+return_status libspdm_refresh_measurement_cache(void *context, const uint32_t *session_id,
+                                                uint8_t slot_id_param, uint32_t *generation)
+{
+    libspdm_context_t *spdm_context;
+    libspdm_peer_measurement_cache_t *cache;
+    return_status status;
+    uint8_t request_attribute;
+    uint8_t number_of_blocks;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    libspdm_measurement_table_t measurement_table;
+    const libspdm_measurement_table_entry_t *entry;
+    const uint8_t *measurement_block;
+    uint32_t measurement_block_size[LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT];
+    uint32_t block_generation[LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT];
+    uint8_t entry_index;
+    uint8_t cache_index;
+    bool changed;
+    bool removed;
+
+    spdm_context = context;
+    if (generation == NULL) {
+        return RETURN_INVALID_PARAMETER;
+    }
+    cache = &spdm_context->peer_measurement_cache;
+
+    if (libspdm_is_capabilities_flag_supported(
+            spdm_context, true, 0,
+            SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG)) {
+        request_attribute = SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE;
+    } else {
+        request_attribute = 0;
+    }
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement(
+        spdm_context, session_id, request_attribute,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        slot_id_param, NULL, &number_of_blocks, &measurement_record_length,
+        measurement_record);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    if (!libspdm_parse_measurement_record(measurement_record_length, measurement_record,
+                                          &measurement_table)) {
+        return RETURN_DEVICE_ERROR;
+    }
+
+    /* A block is unchanged if the same index has the same bytes in the cache.*/
+    changed = false;
+    for (entry_index = 0; entry_index < measurement_table.number_of_blocks; entry_index++) {
+        entry = &measurement_table.entry[entry_index];
+        measurement_block = (const uint8_t *)entry->measurement -
+                            sizeof(spdm_measurement_block_common_header_t);
+        measurement_block_size[entry_index] =
+            sizeof(spdm_measurement_block_common_header_t) + entry->measurement_size;
+        block_generation[entry_index] = 0;
+
+        cache_index = libspdm_find_cached_measurement(cache, entry->index);
+        if ((cache_index < cache->measurement_count) &&
+            (cache->block_size[cache_index] == measurement_block_size[entry_index]) &&
+            libspdm_const_compare_mem(
+                cache->measurement_record + cache->block_offset[cache_index],
+                measurement_block, measurement_block_size[entry_index]) == 0) {
+            block_generation[entry_index] = cache->block_generation[cache_index];
+        } else {
+            changed = true;
+        }
+    }
+    removed = false;
+    for (cache_index = 0; cache_index < cache->measurement_count; cache_index++) {
+        if (libspdm_get_measurement_table_entry(&measurement_table,
+                                                cache->index[cache_index]) == NULL) {
+            removed = true;
+        }
+    }
+    if (!changed && !removed) {
+        *generation = cache->generation;
+        return RETURN_SUCCESS;
+    }
+
+    cache->generation++;
+    if (removed) {
+        /* A removed block has no generation to report it by.*/
+        cache->base_generation = cache->generation;
+    }
+    for (entry_index = 0; entry_index < measurement_table.number_of_blocks; entry_index++) {
+        entry = &measurement_table.entry[entry_index];
+        cache->index[entry_index] = entry->index;
+        cache->block_offset[entry_index] =
+            (uint32_t)((const uint8_t *)entry->measurement - measurement_record -
+                       sizeof(spdm_measurement_block_common_header_t));
+        cache->block_size[entry_index] = measurement_block_size[entry_index];
+        if (block_generation[entry_index] == 0) {
+            cache->block_generation[entry_index] = cache->generation;
+        } else {
+            cache->block_generation[entry_index] = block_generation[entry_index];
+        }
+    }
+    cache->measurement_count = measurement_table.number_of_blocks;
+    libspdm_copy_mem(cache->measurement_record, sizeof(cache->measurement_record),
+                     measurement_record, measurement_record_length);
+    cache->measurement_record_size = measurement_record_length;
+
+    *generation = cache->generation;
+    return RETURN_SUCCESS;
+}
+
+/**
+ * This function returns the measurement indices whose cached measurement block changed
+ * after a generation of the measurement cache.
+ *
+ * If the changes since this generation are not known, for example because a block
+ * disappeared or the cache was dropped since, all cached indices are returned.
+ * A generation of 0 returns all cached indices.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  generation                    The generation returned by a previous refresh, or 0.
+ * @param  index_count                   On input, the number of entries of the index list.
+ *                                     On output, the number of changed measurement indices.
+ * @param  index_list                    The changed measurement indices, in record order.
+ *
+ * @retval RETURN_SUCCESS               The changed measurement indices are returned.
+ * @retval RETURN_NOT_FOUND             The measurement cache is empty.
+ * @retval RETURN_BUFFER_TOO_SMALL      The index list is too small, index_count is updated.
+ **/
+return_status libspdm_get_cached_measurement_changes(void *context, uint32_t generation,
+                                                     uint8_t *index_count,
+                                                     uint8_t *index_list)
+{
+    libspdm_context_t *spdm_context;
+    const libspdm_peer_measurement_cache_t *cache;
+    uint8_t cache_index;
+    uint8_t changed_count;
+
+    spdm_context = context;
+    if ((index_count == NULL) || ((index_list == NULL) && (*index_count != 0))) {
+        return RETURN_INVALID_PARAMETER;
+    }
+    cache = &spdm_context->peer_measurement_cache;
+    if (cache->measurement_count == 0) {
+        return RETURN_NOT_FOUND;
+    }
+    if (generation < cache->base_generation) {
+        generation = 0;
+    }
+
+    changed_count = 0;
+    for (cache_index = 0; cache_index < cache->measurement_count; cache_index++) {
+        if (cache->block_generation[cache_index] > generation) {
+            changed_count++;
+        }
+    }
+    if (*index_count < changed_count) {
+        *index_count = changed_count;
+        return RETURN_BUFFER_TOO_SMALL;
+    }
+
+    changed_count = 0;
+    for (cache_index = 0; cache_index < cache->measurement_count; cache_index++) {
+        if (cache->block_generation[cache_index] > generation) {
+            index_list[changed_count++] = cache->index[cache_index];
+        }
+    }
+    *index_count = changed_count;
+    return RETURN_SUCCESS;
+}
+
+/**
+ * This function copies one cached measurement block, with its common header.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  index                        The measurement index.
+ * @param  block_generation              The generation in which the block last changed, if not NULL.
+ * @param  measurement_block_length       On input, the size in bytes of the destination buffer.
+ *                                     On output, the size in bytes of the measurement block.
+ * @param  measurement_block             A pointer to a destination buffer to store the measurement block.
+ *
+ * @retval RETURN_SUCCESS               The measurement block is copied.
+ * @retval RETURN_NOT_FOUND             No measurement block of this index is cached.
+ * @retval RETURN_BUFFER_TOO_SMALL      The buffer is too small, measurement_block_length is updated.
+ **/
+return_status libspdm_get_cached_measurement(void *context, uint8_t index,
+                                             uint32_t *block_generation,
+                                             uint32_t *measurement_block_length,
+                                             void *measurement_block)
+{
+    libspdm_context_t *spdm_context;
+    const libspdm_peer_measurement_cache_t *cache;
+    uint8_t cache_index;
+
+    spdm_context = context;
+    if ((measurement_block_length == NULL) || (measurement_block == NULL)) {
+        return RETURN_INVALID_PARAMETER;
+    }
+    cache = &spdm_context->peer_measurement_cache;
+    cache_index = libspdm_find_cached_measurement(cache, index);
+    if (cache_index == cache->measurement_count) {
+        return RETURN_NOT_FOUND;
+    }
+    if (*measurement_block_length < cache->block_size[cache_index]) {
+        *measurement_block_length = cache->block_size[cache_index];
+        return RETURN_BUFFER_TOO_SMALL;
+    }
+
+    libspdm_copy_mem(measurement_block, *measurement_block_length,
+                     cache->measurement_record + cache->block_offset[cache_index],
+                     cache->block_size[cache_index]);
+    *measurement_block_length = cache->block_size[cache_index];
+    if (block_generation != NULL) {
+        *block_generation = cache->block_generation[cache_index];
+    }
+    return RETURN_SUCCESS;
+}
+
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP && LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT*/
@@ -89,6 +89,7 @@ return_status libspdm_try_send_receive_psk_exchange(
     uint8_t th1_hash_data[64];
     uint8_t th2_hash_data[64];
     uint32_t algo_size;
+    uint64_t start_time;
 
     /* Check capabilities even if GET_CAPABILITIES is not sent.
      * Assuming capabilities are provisioned.*/
@@ -327,14 +328,18 @@ return_status libspdm_try_send_receive_psk_exchange(
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_handshake_key[%x]\n",
                    *session_id));
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_calculate_th1_hash(spdm_context, session_info, true,
                                         th1_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_HASH, *session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         libspdm_free_session_id(spdm_context, *session_id);
         return RETURN_SECURITY_VIOLATION;
     }
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_generate_session_handshake_key(
         session_info->secured_message_context, th1_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_KEY_DERIVATION, *session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         libspdm_free_session_id(spdm_context, *session_id);
         return RETURN_SECURITY_VIOLATION;
@@ -377,14 +382,19 @@ return_status libspdm_try_send_receive_psk_exchange(
 
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_data_key[%x]\n",
                        session_id));
+        start_time = libspdm_trace_begin(spdm_context);
         status = libspdm_calculate_th2_hash(spdm_context, session_info,
                                             true, th2_hash_data);
+        libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_HASH, *session_id, 0, start_time);
         if (RETURN_ERROR(status)) {
             libspdm_free_session_id(spdm_context, *session_id);
             return RETURN_SECURITY_VIOLATION;
         }
+        start_time = libspdm_trace_begin(spdm_context);
         status = libspdm_generate_session_data_key(
             session_info->secured_message_context, th2_hash_data);
+        libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_KEY_DERIVATION,
+                          *session_id, 0, start_time);
         if (RETURN_ERROR(status)) {
             libspdm_free_session_id(spdm_context, *session_id);
             return RETURN_SECURITY_VIOLATION;
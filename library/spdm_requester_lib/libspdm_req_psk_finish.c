@@ -44,6 +44,7 @@ return_status libspdm_try_send_receive_psk_finish(libspdm_context_t *spdm_contex
     uint8_t th2_hash_data[64];
     libspdm_session_state_t session_state;
     bool result;
+    uint64_t start_time;
 
     if (!libspdm_is_capabilities_flag_supported(
             spdm_context, true,
@@ -162,14 +163,18 @@ return_status libspdm_try_send_receive_psk_finish(libspdm_context_t *spdm_contex
     }
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_data_key[%x]\n", session_id));
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_calculate_th2_hash(spdm_context, session_info, true,
                                         th2_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_HASH, session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         status = RETURN_SECURITY_VIOLATION;
         goto error;
     }
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_generate_session_data_key(
         session_info->secured_message_context, th2_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_KEY_DERIVATION, session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         status = RETURN_SECURITY_VIOLATION;
         goto error;
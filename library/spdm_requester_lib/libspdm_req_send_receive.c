@@ -31,27 +31,53 @@ return_status libspdm_send_request(void *context, const uint32_t *session_id,
     uint8_t message[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
     uintn message_size;
     uint64_t timeout;
+    uint64_t start_time;
 
     spdm_context = context;
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_send_spdm_request[%x] (0x%x): \n",
                    (session_id != NULL) ? *session_id : 0x0, request_size));
     libspdm_internal_dump_hex(request, request_size);
+    libspdm_capture_message(spdm_context,
+                            is_app_message ? LIBSPDM_CAPTURE_RECORD_APP :
+                            LIBSPDM_CAPTURE_RECORD_SPDM,
+                            LIBSPDM_CAPTURE_DIRECTION_SEND,
+                            (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                            request_size, request);
 
+    if (!is_app_message && (request_size >= sizeof(spdm_message_header_t))) {
+        libspdm_trace_set_request_code(
+            spdm_context, ((const spdm_message_header_t *)request)->request_response_code);
+    } else {
+        libspdm_trace_set_request_code(spdm_context, 0);
+    }
+
+    start_time = libspdm_trace_begin(spdm_context);
     message_size = sizeof(message);
     status = spdm_context->transport_encode_message(
         spdm_context, session_id, is_app_message, true, request_size,
         request, &message_size, message);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_ENCODE,
+                      (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                      request_size, start_time);
     if (RETURN_ERROR(status)) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "transport_encode_message status - %p\n",
                        status));
         return status;
     }
+    libspdm_capture_message(spdm_context, LIBSPDM_CAPTURE_RECORD_WIRE,
+                            LIBSPDM_CAPTURE_DIRECTION_SEND,
+                            (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                            message_size, message);
 
     timeout = spdm_context->local_context.capability.rtt;
 
+    start_time = libspdm_trace_begin(spdm_context);
     status = spdm_context->send_message(spdm_context, message_size, message,
                                         timeout);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_SEND,
+                      (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                      message_size, start_time);
     if (RETURN_ERROR(status)) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_send_spdm_request[%x] status - %p\n",
                        (session_id != NULL) ? *session_id : 0x0, status));
@@ -88,6 +114,7 @@ return_status libspdm_receive_response(void *context, const uint32_t *session_id
     uint32_t *message_session_id;
     bool is_message_app_message;
     uint64_t timeout;
+    uint64_t start_time;
 
     spdm_context = context;
 
@@ -101,21 +128,33 @@ return_status libspdm_receive_response(void *context, const uint32_t *session_id
                   spdm_context->local_context.capability.st1;
     }
 
+    start_time = libspdm_trace_begin(spdm_context);
     message_size = sizeof(message);
     status = spdm_context->receive_message(spdm_context, &message_size,
                                            message, timeout);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_WAIT,
+                      (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                      RETURN_ERROR(status) ? 0 : message_size, start_time);
     if (RETURN_ERROR(status)) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
                        "libspdm_receive_spdm_response[%x] status - %p\n",
                        (session_id != NULL) ? *session_id : 0x0, status));
         return status;
     }
+    libspdm_capture_message(spdm_context, LIBSPDM_CAPTURE_RECORD_WIRE,
+                            LIBSPDM_CAPTURE_DIRECTION_RECEIVE,
+                            (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                            message_size, message);
 
+    start_time = libspdm_trace_begin(spdm_context);
     message_session_id = NULL;
     is_message_app_message = false;
     status = spdm_context->transport_decode_message(
         spdm_context, &message_session_id, &is_message_app_message,
         false, message_size, message, response_size, response);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_DECODE,
+                      (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                      RETURN_ERROR(status) ? 0 : *response_size, start_time);
 
     if (session_id != NULL) {
         if (message_session_id == NULL) {
@@ -157,6 +196,12 @@ return_status libspdm_receive_response(void *context, const uint32_t *session_id
                        (session_id != NULL) ? *session_id : 0x0, status));
     } else {
         libspdm_internal_dump_hex(response, *response_size);
+        libspdm_capture_message(spdm_context,
+                                is_app_message ? LIBSPDM_CAPTURE_RECORD_APP :
+                                LIBSPDM_CAPTURE_RECORD_SPDM,
+                                LIBSPDM_CAPTURE_DIRECTION_RECEIVE,
+                                (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                                *response_size, response);
     }
     return status;
 
@@ -190,6 +235,8 @@ return_status libspdm_send_spdm_request(libspdm_context_t *spdm_context,
     libspdm_session_info_t *session_info;
     libspdm_session_state_t session_state;
 
+    spdm_context->peer_error_code = 0;
+
     if ((spdm_context->connection_info.capability.data_transfer_size != 0) &&
         (request_size > spdm_context->connection_info.capability.data_transfer_size)) {
         return RETURN_BAD_BUFFER_SIZE;
@@ -221,6 +268,9 @@ return_status libspdm_send_spdm_request(libspdm_context_t *spdm_context,
 /**
  * Receive an SPDM response from a device.
  *
+ * The error code of an ERROR response is recorded in the context, for the callers that
+ * need to tell a rejected request from a failed transport.
+ *
  * @param  spdm_context                  The SPDM context for the device.
  * @param  session_id                    Indicate if the response is a secured message.
  *                                     If session_id is NULL, it is a normal message.
@@ -240,6 +290,7 @@ return_status libspdm_receive_spdm_response(libspdm_context_t *spdm_context,
 {
     libspdm_session_info_t *session_info;
     libspdm_session_state_t session_state;
+    return_status status;
 
     if ((session_id != NULL) &&
         libspdm_is_capabilities_flag_supported(
@@ -260,6 +311,11 @@ return_status libspdm_receive_spdm_response(libspdm_context_t *spdm_context,
         }
     }
 
-    return libspdm_receive_response(spdm_context, session_id, false,
-                                    response_size, response);
+    status = libspdm_receive_response(spdm_context, session_id, false,
+                                      response_size, response);
+    if (!RETURN_ERROR(status) && (*response_size >= sizeof(spdm_message_header_t)) &&
+        (((const spdm_message_header_t *)response)->request_response_code == SPDM_ERROR)) {
+        spdm_context->peer_error_code = ((const spdm_message_header_t *)response)->param1;
+    }
+    return status;
 }
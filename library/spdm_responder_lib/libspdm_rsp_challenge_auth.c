@@ -45,6 +45,7 @@ return_status libspdm_get_response_challenge_auth(void *context,
     uint8_t auth_attribute;
     return_status status;
     uintn response_capacity;
+    uint64_t start_time;
 
     spdm_context = context;
     spdm_request = request;
@@ -179,11 +180,8 @@ return_status libspdm_get_response_challenge_auth(void *context,
     if (libspdm_is_capabilities_flag_supported(
             spdm_context, false, 0, SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP)) {
 
-        result = libspdm_generate_measurement_summary_hash(
-            spdm_context->connection_info.version,
-            spdm_context->connection_info.algorithm.base_hash_algo,
-            spdm_context->connection_info.algorithm.measurement_spec,
-            spdm_context->connection_info.algorithm.measurement_hash_algo,
+        result = libspdm_responder_generate_measurement_summary_hash(
+            spdm_context,
             spdm_request->header.param2,
             ptr,
             &measurement_summary_hash_size);
@@ -229,8 +227,10 @@ return_status libspdm_get_response_challenge_auth(void *context,
                                                SPDM_ERROR_CODE_UNSPECIFIED, 0,
                                                response_size, response);
     }
+    start_time = libspdm_trace_begin(spdm_context);
     result = libspdm_generate_challenge_auth_signature(spdm_context, false,
                                                        ptr);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_SIGN, INVALID_SESSION_ID, 0, start_time);
     if (!result) {
         libspdm_reset_message_c(spdm_context);
         return libspdm_generate_error_response(
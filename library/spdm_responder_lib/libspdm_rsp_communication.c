@@ -64,8 +64,14 @@ return_status libspdm_process_message(void *context, uint32_t **session_id,
     }
     libspdm_zero_mem(response, *response_size);
 
+    libspdm_notify_memory_scope(spdm_context,
+                                (session_id_ptr != NULL) ? *session_id_ptr : INVALID_SESSION_ID,
+                                LIBSPDM_MEMORY_SCOPE_ENTER);
     status = libspdm_build_response(spdm_context, session_id_ptr, is_app_message,
                                     response_size, response);
+    libspdm_notify_memory_scope(spdm_context,
+                                (session_id_ptr != NULL) ? *session_id_ptr : INVALID_SESSION_ID,
+                                LIBSPDM_MEMORY_SCOPE_LEAVE);
     if (RETURN_ERROR(status)) {
         return status;
     }
@@ -94,10 +100,11 @@ return_status libspdm_responder_dispatch_message(void *context)
     uint8_t *response;
     uintn response_size;
     uint32_t *session_id;
+    uint64_t start_time;
 
     spdm_context = context;
 
-    request_size = sizeof(spdm_context->request_response);
+    request_size = spdm_context->config.max_message_size;
     request = spdm_context->request_response;
     status = spdm_context->receive_message(spdm_context, &request_size,
                                            request, 0);
@@ -105,7 +112,7 @@ return_status libspdm_responder_dispatch_message(void *context)
         return status;
     }
 
-    response_size = sizeof(spdm_context->request_response);
+    response_size = spdm_context->config.max_message_size;
     response = spdm_context->request_response;
     status = libspdm_process_message(spdm_context, &session_id, request,
                                      request_size, response, &response_size);
@@ -113,8 +120,12 @@ return_status libspdm_responder_dispatch_message(void *context)
         return status;
     }
 
+    start_time = libspdm_trace_begin(spdm_context);
     status = spdm_context->send_message(spdm_context, response_size,
                                         response, 0);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_SEND,
+                      (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                      response_size, start_time);
 
     return status;
 }
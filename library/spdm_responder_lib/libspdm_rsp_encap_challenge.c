@@ -107,6 +107,7 @@ return_status libspdm_process_encap_response_challenge_auth(
     uintn signature_size;
     uint8_t auth_attribute;
     return_status status;
+    uint64_t start_time;
 
     spdm_context->encap_context.error_state =
         LIBSPDM_STATUS_ERROR_DEVICE_NO_CAPABILITIES;
@@ -225,8 +226,10 @@ return_status libspdm_process_encap_response_challenge_auth(
     signature = ptr;
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "Encap signature (0x%x):\n", signature_size));
     libspdm_internal_dump_hex(signature, signature_size);
+    start_time = libspdm_trace_begin(spdm_context);
     result = libspdm_verify_challenge_auth_signature(
         spdm_context, false, signature, signature_size);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_VERIFY, INVALID_SESSION_ID, 0, start_time);
     if (!result) {
         spdm_context->encap_context.error_state =
             LIBSPDM_STATUS_ERROR_CERTIFICATE_FAILURE;
@@ -47,8 +47,12 @@ libspdm_get_encap_request_get_certificate(libspdm_context_t *spdm_context,
     spdm_request->header.param1 = spdm_context->encap_context.req_slot_id;
     spdm_request->header.param2 = 0;
     spdm_request->offset = (uint16_t)libspdm_get_managed_buffer_size(
-        &spdm_context->encap_context.certificate_chain_buffer);
-    spdm_request->length = LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN;
+        spdm_context->encap_context.certificate_chain_buffer);
+    /* The CERTIFICATE response is delivered in DELIVER_ENCAPSULATED_RESPONSE.*/
+    spdm_request->length = libspdm_get_cert_chain_block_len(
+        spdm_context, true,
+        sizeof(spdm_deliver_encapsulated_response_request_t) +
+        sizeof(spdm_certificate_response_t));
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "request (offset 0x%x, size 0x%x):\n",
                    spdm_request->offset, spdm_request->length));
 
@@ -121,12 +125,16 @@ return_status libspdm_process_encap_response_certificate(
     if (encap_response_size < sizeof(spdm_certificate_response_t)) {
         return RETURN_DEVICE_ERROR;
     }
-    if ((spdm_response->portion_length > LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN) ||
+    if ((spdm_response->portion_length >
+         libspdm_get_cert_chain_block_len(
+             spdm_context, true,
+             sizeof(spdm_deliver_encapsulated_response_request_t) +
+             sizeof(spdm_certificate_response_t))) ||
         (spdm_response->portion_length == 0)) {
         return RETURN_DEVICE_ERROR;
     }
     request_offset = (uint16_t)libspdm_get_managed_buffer_size(
-        &spdm_context->encap_context.certificate_chain_buffer);
+        spdm_context->encap_context.certificate_chain_buffer);
     if (request_offset == 0) {
         spdm_context->encap_context.cert_chain_total_len = spdm_response->portion_length +
                                                            spdm_response->remainder_length;
@@ -155,13 +163,13 @@ return_status libspdm_process_encap_response_certificate(
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "Certificate (offset 0x%x, size 0x%x):\n",
                    libspdm_get_managed_buffer_size(
-                       &spdm_context->encap_context.certificate_chain_buffer),
+                       spdm_context->encap_context.certificate_chain_buffer),
                    spdm_response->portion_length));
     libspdm_internal_dump_hex((void *)(spdm_response + 1),
                               spdm_response->portion_length);
 
     status = libspdm_append_managed_buffer(
-        &spdm_context->encap_context.certificate_chain_buffer,
+        spdm_context->encap_context.certificate_chain_buffer,
         (void *)(spdm_response + 1), spdm_response->portion_length);
     if (RETURN_ERROR(status)) {
         return RETURN_SECURITY_VIOLATION;
@@ -178,9 +186,9 @@ return_status libspdm_process_encap_response_certificate(
         status = spdm_context->local_context.verify_peer_spdm_cert_chain (
             spdm_context, spdm_context->encap_context.req_slot_id,
             libspdm_get_managed_buffer_size(
-                &spdm_context->encap_context.certificate_chain_buffer),
+                spdm_context->encap_context.certificate_chain_buffer),
             libspdm_get_managed_buffer(
-                &spdm_context->encap_context.certificate_chain_buffer),
+                spdm_context->encap_context.certificate_chain_buffer),
             NULL, NULL);
         if (RETURN_ERROR(status)) {
             spdm_context->encap_context.error_state =
@@ -191,9 +199,9 @@ return_status libspdm_process_encap_response_certificate(
         result = libspdm_verify_peer_cert_chain_buffer(
             spdm_context,
             libspdm_get_managed_buffer(
-                &spdm_context->encap_context.certificate_chain_buffer),
+                spdm_context->encap_context.certificate_chain_buffer),
             libspdm_get_managed_buffer_size(
-                &spdm_context->encap_context.certificate_chain_buffer),
+                spdm_context->encap_context.certificate_chain_buffer),
             NULL, NULL, false);
         if (!result) {
             spdm_context->encap_context.error_state =
@@ -205,20 +213,21 @@ return_status libspdm_process_encap_response_certificate(
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     spdm_context->connection_info.peer_used_cert_chain_buffer_size =
         libspdm_get_managed_buffer_size(
-            &spdm_context->encap_context.certificate_chain_buffer);
+            spdm_context->encap_context.certificate_chain_buffer);
     libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
                      sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer),
                      libspdm_get_managed_buffer(
-                         &spdm_context->encap_context.certificate_chain_buffer),
+                         spdm_context->encap_context.certificate_chain_buffer),
                      libspdm_get_managed_buffer_size(
-                         &spdm_context->encap_context.certificate_chain_buffer));
+                         spdm_context->encap_context.certificate_chain_buffer));
+    libspdm_build_peer_used_cert_chain_index(spdm_context);
 #else
     result = libspdm_hash_all(
         spdm_context->connection_info.algorithm.base_hash_algo,
         libspdm_get_managed_buffer(
-            &spdm_context->encap_context.certificate_chain_buffer),
+            spdm_context->encap_context.certificate_chain_buffer),
         libspdm_get_managed_buffer_size(
-            &spdm_context->encap_context.certificate_chain_buffer),
+            spdm_context->encap_context.certificate_chain_buffer),
         spdm_context->connection_info.peer_used_cert_chain_buffer_hash);
     if (!result) {
         spdm_context->encap_context.error_state =
@@ -232,9 +241,9 @@ return_status libspdm_process_encap_response_certificate(
         spdm_context->connection_info.algorithm.base_hash_algo,
         spdm_context->connection_info.algorithm.req_base_asym_alg,
         libspdm_get_managed_buffer(
-            &spdm_context->encap_context.certificate_chain_buffer),
+            spdm_context->encap_context.certificate_chain_buffer),
         libspdm_get_managed_buffer_size(
-            &spdm_context->encap_context.certificate_chain_buffer),
+            spdm_context->encap_context.certificate_chain_buffer),
         &spdm_context->connection_info.peer_used_leaf_cert_public_key);
     if (!result) {
         spdm_context->encap_context.error_state =
@@ -242,6 +251,8 @@ return_status libspdm_process_encap_response_certificate(
         return RETURN_SECURITY_VIOLATION;
     }
 #endif
+    spdm_context->connection_info.peer_used_cert_chain_slot_id =
+        spdm_context->encap_context.req_slot_id;
 
     spdm_context->encap_context.error_state = LIBSPDM_STATUS_SUCCESS;
 
@@ -196,7 +196,7 @@ void libspdm_init_mut_auth_encap_state(libspdm_context_t *spdm_context,
     spdm_context->encap_context.last_encap_request_size = 0;
     libspdm_zero_mem(&spdm_context->encap_context.last_encap_request_header,
                      sizeof(spdm_context->encap_context.last_encap_request_header));
-    spdm_context->encap_context.certificate_chain_buffer.buffer_size = 0;
+    spdm_context->encap_context.certificate_chain_buffer->buffer_size = 0;
     spdm_context->response_state = LIBSPDM_RESPONSE_STATE_PROCESSING_ENCAP;
 
 
@@ -248,7 +248,7 @@ void libspdm_init_basic_mut_auth_encap_state(libspdm_context_t *spdm_context)
     spdm_context->encap_context.last_encap_request_size = 0;
     libspdm_zero_mem(&spdm_context->encap_context.last_encap_request_header,
                      sizeof(spdm_context->encap_context.last_encap_request_header));
-    spdm_context->encap_context.certificate_chain_buffer.buffer_size = 0;
+    spdm_context->encap_context.certificate_chain_buffer->buffer_size = 0;
     spdm_context->response_state = LIBSPDM_RESPONSE_STATE_PROCESSING_ENCAP;
 
 
@@ -307,7 +307,7 @@ void libspdm_init_key_update_encap_state(void *context)
     spdm_context->encap_context.last_encap_request_size = 0;
     libspdm_zero_mem(&spdm_context->encap_context.last_encap_request_header,
                      sizeof(spdm_context->encap_context.last_encap_request_header));
-    spdm_context->encap_context.certificate_chain_buffer.buffer_size = 0;
+    spdm_context->encap_context.certificate_chain_buffer->buffer_size = 0;
     spdm_context->response_state = LIBSPDM_RESPONSE_STATE_PROCESSING_ENCAP;
 
     libspdm_reset_message_mut_b(spdm_context);
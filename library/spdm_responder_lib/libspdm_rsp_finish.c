@@ -43,6 +43,7 @@ return_status libspdm_get_response_finish(void *context, uintn request_size,
     uint8_t th2_hash_data[64];
     return_status status;
     libspdm_session_state_t session_state;
+    uint64_t start_time;
 
     spdm_context = context;
     spdm_request = request;
@@ -163,10 +164,12 @@ return_status libspdm_get_response_finish(void *context, uintn request_size,
                                                response_size, response);
     }
     if (session_info->mut_auth_requested) {
+        start_time = libspdm_trace_begin(spdm_context);
         result = libspdm_verify_finish_req_signature(
             spdm_context, session_info,
             (uint8_t *)request + sizeof(spdm_finish_request_t),
             signature_size);
+        libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_VERIFY, session_id, 0, start_time);
         if (!result) {
             if((spdm_context->handle_error_return_policy & BIT0) == 0) {
                 return libspdm_generate_error_response(
@@ -273,15 +276,19 @@ return_status libspdm_get_response_finish(void *context, uintn request_size,
     }
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_data_key[%x]\n", session_id));
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_calculate_th2_hash(spdm_context, session_info, false,
                                         th2_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_HASH, session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         return libspdm_generate_error_response(spdm_context,
                                                SPDM_ERROR_CODE_UNSPECIFIED, 0,
                                                response_size, response);
     }
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_generate_session_data_key(
         session_info->secured_message_context, th2_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_KEY_DERIVATION, session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         return libspdm_generate_error_response(spdm_context,
                                                SPDM_ERROR_CODE_UNSPECIFIED, 0,
@@ -53,7 +53,7 @@ return_status libspdm_responder_handle_response_state(void *context,
             spdm_context->cache_spdm_request_size =
                 spdm_context->last_spdm_request_size;
             libspdm_copy_mem(spdm_context->cache_spdm_request,
-                             sizeof(spdm_context->cache_spdm_request),
+                             spdm_context->config.max_message_size,
                              spdm_context->last_spdm_request,
                              spdm_context->last_spdm_request_size);
             spdm_context->error_data.rd_exponent = 1;
@@ -51,6 +51,7 @@ return_status libspdm_get_response_key_exchange(void *context,
     return_status status;
     uintn opaque_key_exchange_rsp_size;
     uint8_t th1_hash_data[64];
+    uint64_t start_time;
 
     spdm_context = context;
     spdm_request = request;
@@ -198,6 +199,7 @@ return_status libspdm_get_response_key_exchange(void *context,
             spdm_context, SPDM_ERROR_CODE_SESSION_LIMIT_EXCEEDED, 0,
             response_size, response);
     }
+    libspdm_notify_memory_scope(spdm_context, session_id, LIBSPDM_MEMORY_SCOPE_ENTER);
 
     spdm_response->rsp_session_id = rsp_session_id;
 
@@ -273,11 +275,8 @@ return_status libspdm_get_response_key_exchange(void *context,
     if (libspdm_is_capabilities_flag_supported(
             spdm_context, false, 0, SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP)) {
 
-        result = libspdm_generate_measurement_summary_hash(
-            spdm_context->connection_info.version,
-            spdm_context->connection_info.algorithm.base_hash_algo,
-            spdm_context->connection_info.algorithm.measurement_spec,
-            spdm_context->connection_info.algorithm.measurement_hash_algo,
+        result = libspdm_responder_generate_measurement_summary_hash(
+            spdm_context,
             spdm_request->header.param1,
             ptr,
             &measurement_summary_hash_size);
@@ -323,8 +322,10 @@ return_status libspdm_get_response_key_exchange(void *context,
                                                SPDM_ERROR_CODE_UNSPECIFIED, 0,
                                                response_size, response);
     }
+    start_time = libspdm_trace_begin(spdm_context);
     result = libspdm_generate_key_exchange_rsp_signature(spdm_context,
                                                          session_info, ptr);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_SIGN, session_id, 0, start_time);
     if (!result) {
         libspdm_free_session_id(spdm_context, session_id);
         return libspdm_generate_error_response(
@@ -342,16 +343,20 @@ return_status libspdm_get_response_key_exchange(void *context,
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_handshake_key[%x]\n",
                    session_id));
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_calculate_th1_hash(spdm_context, session_info, false,
                                         th1_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_HASH, session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         libspdm_free_session_id(spdm_context, session_id);
         return libspdm_generate_error_response(spdm_context,
                                                SPDM_ERROR_CODE_UNSPECIFIED, 0,
                                                response_size, response);
     }
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_generate_session_handshake_key(
         session_info->secured_message_context, th1_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_KEY_DERIVATION, session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         libspdm_free_session_id(spdm_context, session_id);
         return libspdm_generate_error_response(spdm_context,
@@ -0,0 +1,337 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Responder measurement cache.
+ *
+ * When the device reports a measurement generation, the measurement record and the
+ * measurement summary hashes are collected from spdm_device_secret_lib once per generation,
+ * and every GET_MEASUREMENTS, CHALLENGE, KEY_EXCHANGE and PSK_EXCHANGE of the same
+ * generation is served from the cache in the SPDM context.
+ **/
+
+#include "internal/libspdm_responder_lib.h"
+
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+
+/**
+ * Return if no GET_MEASUREMENTS is recorded in L1/L2 yet.
+ **/
+static bool libspdm_is_message_m_empty(const libspdm_context_t *spdm_context,
+                                       const libspdm_session_info_t *session_info)
+{
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    if (session_info == NULL) {
+        return spdm_context->transcript.message_m.buffer_size == 0;
+    }
+    return session_info->session_transcript.message_m.buffer_size == 0;
+#else
+    if (session_info == NULL) {
+        return spdm_context->transcript.digest_context_l1l2.hash_nid ==
+               LIBSPDM_CRYPTO_NID_NULL;
+    }
+    return session_info->session_transcript.digest_context_l1l2.hash_nid ==
+           LIBSPDM_CRYPTO_NID_NULL;
+#endif
+}
+
+/**
+ * Fill the measurement record cache with all measurements of one generation.
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  generation                    The current device measurement generation.
+ * @param  raw_bit_stream                Indicate if the raw bit stream is requested.
+ *
+ * @return the status of libspdm_measurement_collection().
+ **/
+static return_status libspdm_fill_measurement_record_cache(libspdm_context_t *spdm_context,
+                                                           uint32_t generation,
+                                                           bool raw_bit_stream)
+{
+    libspdm_measurement_cache_t *cache;
+    return_status status;
+
+    cache = &spdm_context->measurement_cache;
+    if ((cache->generation == generation) &&
+        (cache->spdm_version == spdm_context->connection_info.version) &&
+        (cache->measurement_spec ==
+         spdm_context->connection_info.algorithm.measurement_spec) &&
+        (cache->measurement_hash_algo ==
+         spdm_context->connection_info.algorithm.measurement_hash_algo) &&
+        (cache->raw_bit_stream == raw_bit_stream)) {
+        return RETURN_SUCCESS;
+    }
+
+    cache->generation = 0;
+    cache->measurement_record_size = sizeof(cache->measurement_record);
+    status = libspdm_measurement_collection(
+        spdm_context->connection_info.version,
+        spdm_context->connection_info.algorithm.measurement_spec,
+        spdm_context->connection_info.algorithm.measurement_hash_algo,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        raw_bit_stream ? SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_RAW_BIT_STREAM_REQUESTED : 0,
+        NULL,
+        &cache->measurement_count,
+        cache->measurement_record,
+        &cache->measurement_record_size);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    LIBSPDM_ASSERT(cache->measurement_count <= LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT);
+
+    cache->spdm_version = spdm_context->connection_info.version;
+    cache->measurement_spec = spdm_context->connection_info.algorithm.measurement_spec;
+    cache->measurement_hash_algo =
+        spdm_context->connection_info.algorithm.measurement_hash_algo;
+    cache->raw_bit_stream = raw_bit_stream;
+    cache->generation = generation;
+    return RETURN_SUCCESS;
+}
+
+/**
+ * Copy the requested measurements out of the measurement record cache.
+ *
+ * The parameters and return values follow libspdm_measurement_collection().
+ **/
+static return_status libspdm_get_cached_measurements(const libspdm_measurement_cache_t *cache,
+                                                     uint8_t measurement_index,
+                                                     uint8_t *measurements_count,
+                                                     void *measurements,
+                                                     uintn *measurements_size)
+{
+    const spdm_measurement_block_common_header_t *measurement_block;
+    uintn measurement_block_size;
+    uintn offset;
+    uint8_t index;
+
+    if (measurement_index ==
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
+        *measurements_count = cache->measurement_count;
+        return RETURN_SUCCESS;
+    }
+
+    if (measurement_index ==
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) {
+        if (cache->measurement_record_size > *measurements_size) {
+            return RETURN_BUFFER_TOO_SMALL;
+        }
+        libspdm_copy_mem(measurements, *measurements_size,
+                         cache->measurement_record, cache->measurement_record_size);
+        *measurements_count = cache->measurement_count;
+        *measurements_size = cache->measurement_record_size;
+        return RETURN_SUCCESS;
+    }
+
+    offset = 0;
+    for (index = 0; index < cache->measurement_count; index++) {
+        if (offset + sizeof(spdm_measurement_block_common_header_t) >
+            cache->measurement_record_size) {
+            break;
+        }
+        measurement_block = (const void *)(cache->measurement_record + offset);
+        measurement_block_size = sizeof(spdm_measurement_block_common_header_t) +
+                                 measurement_block->measurement_size;
+        if (offset + measurement_block_size > cache->measurement_record_size) {
+            break;
+        }
+        if (measurement_block->index == measurement_index) {
+            if (measurement_block_size > *measurements_size) {
+                return RETURN_BUFFER_TOO_SMALL;
+            }
+            libspdm_copy_mem(measurements, *measurements_size,
+                             measurement_block, measurement_block_size);
+            *measurements_count = 1;
+            *measurements_size = measurement_block_size;
+            return RETURN_SUCCESS;
+        }
+        offset += measurement_block_size;
+    }
+
+    *measurements_count = 0;
+    return RETURN_NOT_FOUND;
+}
+
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
+
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT*/
+
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+
+/**
+ * Collect the device measurements for a GET_MEASUREMENTS request.
+ *
+ * If the device reports a measurement generation, the measurements are served from the
+ * measurement cache, and content_changed reports whether the generation moved since the
+ * first GET_MEASUREMENTS of the L1/L2 transcript. Otherwise the request is passed to
+ * libspdm_measurement_collection().
+ *
+ * @param  spdm_context                  A pointer to the SPDM context.
+ * @param  session_info                  A pointer to the SPDM session context, or NULL.
+ * @param  measurement_index             The index of the measurement to collect.
+ * @param  request_attribute             The request attribute of GET_MEASUREMENTS.
+ * @param  content_changed               The measurement content changed output param.
+ * @param  measurements_count            The number of measurements returned.
+ * @param  measurements                  A pointer to the destination buffer of the measurement blocks.
+ * @param  measurements_size             On input, the size in bytes of the destination buffer.
+ *                                       On output, the size in bytes of the measurement blocks.
+ *
+ * @return the status of libspdm_measurement_collection().
+ **/
+return_status libspdm_responder_collect_measurements(libspdm_context_t *spdm_context,
+                                                     libspdm_session_info_t *session_info,
+                                                     uint8_t measurement_index,
+                                                     uint8_t request_attribute,
+                                                     uint8_t *content_changed,
+                                                     uint8_t *measurements_count,
+                                                     void *measurements,
+                                                     uintn *measurements_size)
+{
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    uint32_t generation;
+    uint32_t *transcript_generation;
+    return_status status;
+
+    generation = libspdm_measurement_get_generation();
+    if (generation != 0) {
+        status = libspdm_fill_measurement_record_cache(
+            spdm_context, generation,
+            (request_attribute &
+             SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_RAW_BIT_STREAM_REQUESTED) != 0);
+        if (RETURN_ERROR(status)) {
+            return status;
+        }
+        status = libspdm_get_cached_measurements(&spdm_context->measurement_cache,
+                                                 measurement_index, measurements_count,
+                                                 measurements, measurements_size);
+        if (RETURN_ERROR(status)) {
+            return status;
+        }
+
+        if (session_info == NULL) {
+            transcript_generation = &spdm_context->transcript.measurement_generation;
+        } else {
+            transcript_generation = &session_info->session_transcript.measurement_generation;
+        }
+        if (libspdm_is_message_m_empty(spdm_context, session_info)) {
+            *transcript_generation = generation;
+        }
+        if ((spdm_context->connection_info.version >> SPDM_VERSION_NUMBER_SHIFT_BIT) >=
+            SPDM_MESSAGE_VERSION_12) {
+            if ((request_attribute &
+                 SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) == 0) {
+                *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_NO_DETECTION;
+            } else if (*transcript_generation == generation) {
+                *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED;
+            } else {
+                *content_changed = SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED;
+            }
+        }
+        return RETURN_SUCCESS;
+    }
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT*/
+
+    return libspdm_measurement_collection(
+        spdm_context->connection_info.version,
+        spdm_context->connection_info.algorithm.measurement_spec,
+        spdm_context->connection_info.algorithm.measurement_hash_algo,
+        measurement_index,
+        request_attribute,
+        content_changed,
+        measurements_count,
+        measurements,
+        measurements_size);
+}
+
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
+
+/**
+ * Generate the measurement summary hash of the negotiated algorithms.
+ *
+ * If the device reports a measurement generation, the summary hash is computed once per
+ * generation, measurement hash algorithm and base hash algorithm, and then served from the
+ * measurement cache. Otherwise it is passed to libspdm_generate_measurement_summary_hash().
+ *
+ * @param  spdm_context                    A pointer to the SPDM context.
+ * @param  measurement_summary_hash_type   The type of the measurement summary hash.
+ * @param  measurement_summary_hash        The buffer to store the measurement summary hash.
+ * @param  measurement_summary_hash_size   The size in bytes of the buffer.
+ *
+ * @retval true  measurement summary hash is generated or skipped.
+ * @retval false measurement summary hash is not generated.
+ **/
+bool libspdm_responder_generate_measurement_summary_hash(
+    libspdm_context_t *spdm_context,
+    uint8_t measurement_summary_hash_type,
+    uint8_t *measurement_summary_hash,
+    uintn *measurement_summary_hash_size)
+{
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+    libspdm_measurement_summary_hash_cache_t *summary_hash;
+    uint32_t generation;
+
+    switch (measurement_summary_hash_type) {
+    case SPDM_CHALLENGE_REQUEST_TCB_COMPONENT_MEASUREMENT_HASH:
+        summary_hash = &spdm_context->measurement_cache.summary_hash[
+            LIBSPDM_MEASUREMENT_SUMMARY_HASH_CACHE_TCB];
+        break;
+    case SPDM_CHALLENGE_REQUEST_ALL_MEASUREMENTS_HASH:
+        summary_hash = &spdm_context->measurement_cache.summary_hash[
+            LIBSPDM_MEASUREMENT_SUMMARY_HASH_CACHE_ALL];
+        break;
+    default:
+        summary_hash = NULL;
+        break;
+    }
+
+    generation = libspdm_measurement_get_generation();
+    if ((summary_hash != NULL) && (generation != 0) &&
+        (*measurement_summary_hash_size ==
+         libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo))) {
+        if ((summary_hash->generation != generation) ||
+            (summary_hash->spdm_version != spdm_context->connection_info.version) ||
+            (summary_hash->measurement_spec !=
+             spdm_context->connection_info.algorithm.measurement_spec) ||
+            (summary_hash->measurement_hash_algo !=
+             spdm_context->connection_info.algorithm.measurement_hash_algo) ||
+            (summary_hash->base_hash_algo !=
+             spdm_context->connection_info.algorithm.base_hash_algo)) {
+            summary_hash->generation = 0;
+            if (!libspdm_generate_measurement_summary_hash(
+                    spdm_context->connection_info.version,
+                    spdm_context->connection_info.algorithm.base_hash_algo,
+                    spdm_context->connection_info.algorithm.measurement_spec,
+                    spdm_context->connection_info.algorithm.measurement_hash_algo,
+                    measurement_summary_hash_type,
+                    summary_hash->hash,
+                    measurement_summary_hash_size)) {
+                return false;
+            }
+            summary_hash->spdm_version = spdm_context->connection_info.version;
+            summary_hash->measurement_spec =
+                spdm_context->connection_info.algorithm.measurement_spec;
+            summary_hash->measurement_hash_algo =
+                spdm_context->connection_info.algorithm.measurement_hash_algo;
+            summary_hash->base_hash_algo =
+                spdm_context->connection_info.algorithm.base_hash_algo;
+            summary_hash->generation = generation;
+        }
+        libspdm_copy_mem(measurement_summary_hash, *measurement_summary_hash_size,
+                         summary_hash->hash, *measurement_summary_hash_size);
+        return true;
+    }
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT*/
+
+    return libspdm_generate_measurement_summary_hash(
+        spdm_context->connection_info.version,
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        spdm_context->connection_info.algorithm.measurement_spec,
+        spdm_context->connection_info.algorithm.measurement_hash_algo,
+        measurement_summary_hash_type,
+        measurement_summary_hash,
+        measurement_summary_hash_size);
+}
@@ -31,6 +31,7 @@ bool libspdm_create_measurement_signature(libspdm_context_t *spdm_context,
     uintn signature_size;
     bool result;
     return_status status;
+    uint64_t start_time;
 
     signature_size = libspdm_get_asym_signature_size(
         spdm_context->connection_info.algorithm.base_asym_algo);
@@ -65,7 +66,11 @@ bool libspdm_create_measurement_signature(libspdm_context_t *spdm_context,
         return false;
     }
 
+    start_time = libspdm_trace_begin(spdm_context);
     result = libspdm_generate_measurement_signature(spdm_context, session_info, ptr);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_SIGN,
+                      (session_info != NULL) ? session_info->session_id : INVALID_SESSION_ID,
+                      0, start_time);
 
     return result;
 }
@@ -176,8 +181,9 @@ return_status libspdm_get_response_measurements(void *context,
             SPDM_GET_MEASUREMENTS, response_size, response);
     }
     if (!spdm_context->last_spdm_request_session_id_valid) {
+        /* SPDM allows GET_MEASUREMENTS once the algorithms are negotiated.*/
         if (spdm_context->connection_info.connection_state <
-            LIBSPDM_CONNECTION_STATE_AUTHENTICATED) {
+            LIBSPDM_CONNECTION_STATE_NEGOTIATED) {
             return libspdm_generate_error_response(
                 spdm_context,
                 SPDM_ERROR_CODE_UNEXPECTED_REQUEST, 0,
@@ -299,10 +305,9 @@ return_status libspdm_get_response_measurements(void *context,
 
     measurements = (uint8_t*)response + sizeof(spdm_measurements_response_t);
 
-    status = libspdm_measurement_collection(
-        spdm_context->connection_info.version,
-        spdm_context->connection_info.algorithm.measurement_spec,
-        spdm_context->connection_info.algorithm.measurement_hash_algo,
+    status = libspdm_responder_collect_measurements(
+        spdm_context,
+        session_info,
         measurements_index,
         spdm_request->header.param1,
         &content_changed,
@@ -40,6 +40,7 @@ return_status libspdm_get_response_psk_finish(void *context,
     const spdm_psk_finish_request_t *spdm_request;
     return_status status;
     libspdm_session_state_t session_state;
+    uint64_t start_time;
 
     spdm_context = context;
     spdm_request = request;
@@ -159,15 +160,19 @@ return_status libspdm_get_response_psk_finish(void *context,
     }
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "libspdm_generate_session_data_key[%x]\n", session_id));
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_calculate_th2_hash(spdm_context, session_info, false,
                                         th2_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_HASH, session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         return libspdm_generate_error_response(spdm_context,
                                                SPDM_ERROR_CODE_UNSPECIFIED, 0,
                                                response_size, response);
     }
+    start_time = libspdm_trace_begin(spdm_context);
     status = libspdm_generate_session_data_key(
         session_info->secured_message_context, th2_hash_data);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_KEY_DERIVATION, session_id, 0, start_time);
     if (RETURN_ERROR(status)) {
         return libspdm_generate_error_response(spdm_context,
                                                SPDM_ERROR_CODE_UNSPECIFIED, 0,
@@ -127,6 +127,7 @@ return_status libspdm_process_request(void *context, uint32_t **session_id,
     return_status status;
     libspdm_session_info_t *session_info;
     uint32_t *message_session_id;
+    uint64_t start_time;
 
     spdm_context = context;
 
@@ -139,14 +140,32 @@ return_status libspdm_process_request(void *context, uint32_t **session_id,
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "SpdmReceiveRequest[.] ...\n"));
 
+    libspdm_capture_message(spdm_context, LIBSPDM_CAPTURE_RECORD_WIRE,
+                            LIBSPDM_CAPTURE_DIRECTION_RECEIVE, INVALID_SESSION_ID,
+                            request_size, request);
+
+    start_time = libspdm_trace_begin(spdm_context);
     message_session_id = NULL;
     spdm_context->last_spdm_request_session_id_valid = false;
     spdm_context->last_spdm_request_size =
-        sizeof(spdm_context->last_spdm_request);
+        spdm_context->config.max_message_size;
     status = spdm_context->transport_decode_message(
         spdm_context, &message_session_id, is_app_message, true,
         request_size, request, &spdm_context->last_spdm_request_size,
         spdm_context->last_spdm_request);
+    if (!RETURN_ERROR(status) && !(*is_app_message) &&
+        (spdm_context->last_spdm_request_size >= sizeof(spdm_message_header_t))) {
+        libspdm_trace_set_request_code(
+            spdm_context,
+            ((const spdm_message_header_t *)spdm_context->last_spdm_request)
+            ->request_response_code);
+    } else {
+        libspdm_trace_set_request_code(spdm_context, 0);
+    }
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_DECODE,
+                      (message_session_id != NULL) ? *message_session_id : INVALID_SESSION_ID,
+                      RETURN_ERROR(status) ? 0 : spdm_context->last_spdm_request_size,
+                      start_time);
     if (RETURN_ERROR(status)) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "transport_decode_message : %p\n", status));
         if (spdm_context->last_spdm_error.error_code != 0) {
@@ -189,6 +208,14 @@ return_status libspdm_process_request(void *context, uint32_t **session_id,
                    spdm_context->last_spdm_request_size));
     libspdm_internal_dump_hex((uint8_t *)spdm_context->last_spdm_request,
                               spdm_context->last_spdm_request_size);
+    libspdm_capture_message(spdm_context,
+                            *is_app_message ? LIBSPDM_CAPTURE_RECORD_APP :
+                            LIBSPDM_CAPTURE_RECORD_SPDM,
+                            LIBSPDM_CAPTURE_DIRECTION_RECEIVE,
+                            (message_session_id != NULL) ?
+                            *message_session_id : INVALID_SESSION_ID,
+                            spdm_context->last_spdm_request_size,
+                            spdm_context->last_spdm_request);
 
     return RETURN_SUCCESS;
 }
@@ -318,6 +345,7 @@ return_status libspdm_build_response(void *context, const uint32_t *session_id,
     spdm_message_header_t *spdm_request;
     spdm_message_header_t *spdm_response;
     bool result;
+    uint64_t start_time;
 
     spdm_context = context;
     status = RETURN_UNSUPPORTED;
@@ -375,6 +403,10 @@ return_status libspdm_build_response(void *context, const uint32_t *session_id,
                            status));
             return status;
         }
+        libspdm_capture_message(spdm_context, LIBSPDM_CAPTURE_RECORD_WIRE,
+                                LIBSPDM_CAPTURE_DIRECTION_SEND,
+                                (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                                *response_size, response);
 
         libspdm_zero_mem(&spdm_context->last_spdm_error,
                          sizeof(spdm_context->last_spdm_error));
@@ -408,6 +440,7 @@ return_status libspdm_build_response(void *context, const uint32_t *session_id,
         return RETURN_NOT_READY;
     }
 
+    start_time = libspdm_trace_begin(spdm_context);
     my_response_size = sizeof(my_response);
     libspdm_zero_mem(my_response, sizeof(my_response));
     get_response_func = NULL;
@@ -434,6 +467,9 @@ return_status libspdm_build_response(void *context, const uint32_t *session_id,
             status = RETURN_NOT_FOUND;
         }
     }
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_PROCESS,
+                      (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                      my_response_size, start_time);
 
     if ((spdm_context->connection_info.capability.data_transfer_size != 0) &&
         (my_response_size > spdm_context->connection_info.capability.data_transfer_size)) {
@@ -467,14 +503,28 @@ return_status libspdm_build_response(void *context, const uint32_t *session_id,
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "SpdmSendResponse[%x] (0x%x): \n",
                    (session_id != NULL) ? *session_id : 0, my_response_size));
     libspdm_internal_dump_hex(my_response, my_response_size);
-
+    libspdm_capture_message(spdm_context,
+                            is_app_message ? LIBSPDM_CAPTURE_RECORD_APP :
+                            LIBSPDM_CAPTURE_RECORD_SPDM,
+                            LIBSPDM_CAPTURE_DIRECTION_SEND,
+                            (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                            my_response_size, my_response);
+
+    start_time = libspdm_trace_begin(spdm_context);
     status = spdm_context->transport_encode_message(
         spdm_context, session_id, is_app_message, false,
         my_response_size, my_response, response_size, response);
+    libspdm_trace_end(spdm_context, LIBSPDM_TRACE_PHASE_ENCODE,
+                      (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                      my_response_size, start_time);
     if (RETURN_ERROR(status)) {
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "transport_encode_message : %p\n", status));
         return status;
     }
+    libspdm_capture_message(spdm_context, LIBSPDM_CAPTURE_RECORD_WIRE,
+                            LIBSPDM_CAPTURE_DIRECTION_SEND,
+                            (session_id != NULL) ? *session_id : INVALID_SESSION_ID,
+                            *response_size, response);
 
     spdm_response = (void *)my_response;
     if (session_id != NULL) {
@@ -88,7 +88,7 @@ return_status libspdm_bin_concat(const char *label, uintn label_size,
  * This function generates SPDM AEAD key and IV for a session.
  *
  * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
- * @param  major_secret                  The major secret.
+ * @param  major_secret_state            The HMAC state keyed with the major secret.
  * @param  key                          The buffer to store the AEAD key.
  * @param  iv                           The buffer to store the AEAD IV.
  *
@@ -96,7 +96,7 @@ return_status libspdm_bin_concat(const char *label, uintn label_size,
  **/
 return_status libspdm_generate_aead_key_and_iv(
     libspdm_secured_message_context_t *secured_message_context,
-    const uint8_t *major_secret, uint8_t *key, uint8_t *iv)
+    const libspdm_hmac_state_t *major_secret_state, uint8_t *key, uint8_t *iv)
 {
     return_status status;
     bool ret_val;
@@ -119,9 +119,8 @@ return_status libspdm_generate_aead_key_and_iv(
     LIBSPDM_ASSERT_RETURN_ERROR(status);
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str5 (0x%x):\n", bin_str5_size));
     libspdm_internal_dump_hex(bin_str5, bin_str5_size);
-    ret_val = libspdm_hkdf_expand(secured_message_context->base_hash_algo,
-                                  major_secret, hash_size, bin_str5,
-                                  bin_str5_size, key, key_length);
+    ret_val = libspdm_hkdf_expand_with_state(major_secret_state, bin_str5,
+                                             bin_str5_size, key, key_length);
     LIBSPDM_ASSERT(ret_val);
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "key (0x%x) - ", key_length));
     libspdm_internal_dump_data(key, key_length);
@@ -134,9 +133,8 @@ return_status libspdm_generate_aead_key_and_iv(
     LIBSPDM_ASSERT_RETURN_ERROR(status);
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str6 (0x%x):\n", bin_str6_size));
     libspdm_internal_dump_hex(bin_str6, bin_str6_size);
-    ret_val = libspdm_hkdf_expand(secured_message_context->base_hash_algo,
-                                  major_secret, hash_size, bin_str6,
-                                  bin_str6_size, iv, iv_length);
+    ret_val = libspdm_hkdf_expand_with_state(major_secret_state, bin_str6,
+                                             bin_str6_size, iv, iv_length);
     LIBSPDM_ASSERT(ret_val);
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "iv (0x%x) - ", iv_length));
     libspdm_internal_dump_data(iv, iv_length);
@@ -149,14 +147,14 @@ return_status libspdm_generate_aead_key_and_iv(
  * This function generates SPDM finished_key for a session.
  *
  * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
- * @param  handshake_secret              The handshake secret.
+ * @param  handshake_secret_state        The HMAC state keyed with the handshake secret.
  * @param  finished_key                  The buffer to store the finished key.
  *
  * @retval RETURN_SUCCESS  SPDM finished_key for a session is generated.
  **/
 return_status libspdm_generate_finished_key(
     libspdm_secured_message_context_t *secured_message_context,
-    const uint8_t *handshake_secret, uint8_t *finished_key)
+    const libspdm_hmac_state_t *handshake_secret_state, uint8_t *finished_key)
 {
     return_status status;
     bool ret_val;
@@ -173,9 +171,8 @@ return_status libspdm_generate_finished_key(
     LIBSPDM_ASSERT_RETURN_ERROR(status);
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "bin_str7 (0x%x):\n", bin_str7_size));
     libspdm_internal_dump_hex(bin_str7, bin_str7_size);
-    ret_val = libspdm_hkdf_expand(secured_message_context->base_hash_algo,
-                                  handshake_secret, hash_size, bin_str7,
-                                  bin_str7_size, finished_key, hash_size);
+    ret_val = libspdm_hkdf_expand_with_state(handshake_secret_state, bin_str7,
+                                             bin_str7_size, finished_key, hash_size);
     LIBSPDM_ASSERT(ret_val);
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "finished_key (0x%x) - ", hash_size));
     libspdm_internal_dump_data(finished_key, hash_size);
@@ -184,6 +181,46 @@ return_status libspdm_generate_finished_key(
     return RETURN_SUCCESS;
 }
 
+/**
+ * This function generates the finished_key, AEAD key and IV of one direction secret.
+ *
+ * The direction secret keys one HMAC state, shared by all the HKDF expand calls.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  secret                        The request or response handshake or data secret.
+ * @param  finished_key                  The buffer to store the finished key.
+ *                                       NULL if no finished_key is needed.
+ * @param  key                          The buffer to store the AEAD key.
+ * @param  iv                           The buffer to store the AEAD IV.
+ *
+ * @retval RETURN_SUCCESS  The keys are generated.
+ **/
+static return_status libspdm_generate_secret_keys(
+    libspdm_secured_message_context_t *secured_message_context,
+    const uint8_t *secret, uint8_t *finished_key, uint8_t *key, uint8_t *iv)
+{
+    return_status status;
+    libspdm_hmac_state_t secret_state;
+
+    if (!libspdm_hmac_state_init(secured_message_context->base_hash_algo, &secret_state,
+                                 secret, secured_message_context->hash_size)) {
+        return RETURN_DEVICE_ERROR;
+    }
+
+    status = RETURN_SUCCESS;
+    if (finished_key != NULL) {
+        status = libspdm_generate_finished_key(secured_message_context, &secret_state,
+                                               finished_key);
+    }
+    if (!RETURN_ERROR(status)) {
+        status = libspdm_generate_aead_key_and_iv(secured_message_context, &secret_state,
+                                                  key, iv);
+    }
+
+    libspdm_hmac_state_free(&secret_state);
+    return status;
+}
+
 /**
  * This function generates SPDM HandshakeKey for a session.
  *
@@ -205,11 +242,13 @@ libspdm_generate_session_handshake_key(void *spdm_secured_message_context,
     uintn bin_str1_size;
     uint8_t bin_str2[128];
     uintn bin_str2_size;
+    libspdm_hmac_state_t handshake_secret_state;
     libspdm_secured_message_context_t *secured_message_context;
 
     secured_message_context = spdm_secured_message_context;
 
     hash_size = secured_message_context->hash_size;
+    libspdm_zero_mem(&handshake_secret_state, sizeof(handshake_secret_state));
 
     bin_str0_size = sizeof(bin_str0);
     status = libspdm_bin_concat(SPDM_BIN_STR_0_LABEL, sizeof(SPDM_BIN_STR_0_LABEL) - 1,
@@ -239,6 +278,15 @@ libspdm_generate_session_handshake_key(void *spdm_secured_message_context,
             secured_message_context->master_secret.handshake_secret,
             hash_size);
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
+
+        /* Key HMAC once for both handshake secrets.*/
+        if (!libspdm_hmac_state_init(secured_message_context->base_hash_algo,
+                                     &handshake_secret_state,
+                                     secured_message_context->master_secret.handshake_secret,
+                                     hash_size)) {
+            status = RETURN_DEVICE_ERROR;
+            goto cleanup;
+        }
     }
 
     bin_str1_size = sizeof(bin_str1);
@@ -259,13 +307,12 @@ libspdm_generate_session_handshake_key(void *spdm_secured_message_context,
             .request_handshake_secret,
             hash_size);
         if (!ret_val) {
-            return RETURN_UNSUPPORTED;
+            status = RETURN_UNSUPPORTED;
+            goto cleanup;
         }
     } else {
-        ret_val = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->master_secret.handshake_secret,
-            hash_size, bin_str1, bin_str1_size,
+        ret_val = libspdm_hkdf_expand_with_state(
+            &handshake_secret_state, bin_str1, bin_str1_size,
             secured_message_context->handshake_secret
             .request_handshake_secret,
             hash_size);
@@ -294,13 +341,12 @@ libspdm_generate_session_handshake_key(void *spdm_secured_message_context,
             .response_handshake_secret,
             hash_size);
         if (!ret_val) {
-            return RETURN_UNSUPPORTED;
+            status = RETURN_UNSUPPORTED;
+            goto cleanup;
         }
     } else {
-        ret_val = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->master_secret.handshake_secret,
-            hash_size, bin_str2, bin_str2_size,
+        ret_val = libspdm_hkdf_expand_with_state(
+            &handshake_secret_state, bin_str2, bin_str2_size,
             secured_message_context->handshake_secret
             .response_handshake_secret,
             hash_size);
@@ -311,42 +357,34 @@ libspdm_generate_session_handshake_key(void *spdm_secured_message_context,
                                .response_handshake_secret,
                                hash_size);
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
+    status = RETURN_SUCCESS;
 
-    status = libspdm_generate_finished_key(
-        secured_message_context,
-        secured_message_context->handshake_secret
-        .request_handshake_secret,
-        secured_message_context->handshake_secret.request_finished_key);
+cleanup:
+    libspdm_hmac_state_free(&handshake_secret_state);
     if (RETURN_ERROR(status)) {
         return status;
     }
 
-    status = libspdm_generate_finished_key(
+    status = libspdm_generate_secret_keys(
         secured_message_context,
         secured_message_context->handshake_secret
-        .response_handshake_secret,
-        secured_message_context->handshake_secret.response_finished_key);
-    if (RETURN_ERROR(status)) {
-        return status;
-    }
-
-    status = libspdm_generate_aead_key_and_iv(secured_message_context,
-                                              secured_message_context->handshake_secret
-                                              .request_handshake_secret,
-                                              secured_message_context->handshake_secret
-                                              .request_handshake_encryption_key,
-                                              secured_message_context->handshake_secret
-                                              .request_handshake_salt);
+        .request_handshake_secret,
+        secured_message_context->handshake_secret.request_finished_key,
+        secured_message_context->handshake_secret
+        .request_handshake_encryption_key,
+        secured_message_context->handshake_secret
+        .request_handshake_salt);
     if (RETURN_ERROR(status)) {
         return status;
     }
     secured_message_context->handshake_secret
     .request_handshake_sequence_number = 0;
 
-    status = libspdm_generate_aead_key_and_iv(
+    status = libspdm_generate_secret_keys(
         secured_message_context,
         secured_message_context->handshake_secret
         .response_handshake_secret,
+        secured_message_context->handshake_secret.response_finished_key,
         secured_message_context->handshake_secret
         .response_handshake_encryption_key,
         secured_message_context->handshake_secret
@@ -388,11 +426,13 @@ libspdm_generate_session_data_key(void *spdm_secured_message_context,
     uintn bin_str4_size;
     uint8_t bin_str8[128];
     uintn bin_str8_size;
+    libspdm_hmac_state_t master_secret_state;
     libspdm_secured_message_context_t *secured_message_context;
 
     secured_message_context = spdm_secured_message_context;
 
     hash_size = secured_message_context->hash_size;
+    libspdm_zero_mem(&master_secret_state, sizeof(master_secret_state));
 
     if (secured_message_context->use_psk) {
         /* No master_secret generation for PSK.*/
@@ -422,6 +462,15 @@ libspdm_generate_session_data_key(void *spdm_secured_message_context,
             secured_message_context->master_secret.master_secret,
             hash_size);
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
+
+        /* Key HMAC once for the data secrets and the export master secret.*/
+        if (!libspdm_hmac_state_init(secured_message_context->base_hash_algo,
+                                     &master_secret_state,
+                                     secured_message_context->master_secret.master_secret,
+                                     hash_size)) {
+            status = RETURN_DEVICE_ERROR;
+            goto cleanup;
+        }
     }
 
     bin_str3_size = sizeof(bin_str3);
@@ -442,13 +491,12 @@ libspdm_generate_session_data_key(void *spdm_secured_message_context,
             .request_data_secret,
             hash_size);
         if (!ret_val) {
-            return RETURN_UNSUPPORTED;
+            status = RETURN_UNSUPPORTED;
+            goto cleanup;
         }
     } else {
-        ret_val = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->master_secret.master_secret,
-            hash_size, bin_str3, bin_str3_size,
+        ret_val = libspdm_hkdf_expand_with_state(
+            &master_secret_state, bin_str3, bin_str3_size,
             secured_message_context->application_secret
             .request_data_secret,
             hash_size);
@@ -477,13 +525,12 @@ libspdm_generate_session_data_key(void *spdm_secured_message_context,
             .response_data_secret,
             hash_size);
         if (!ret_val) {
-            return RETURN_UNSUPPORTED;
+            status = RETURN_UNSUPPORTED;
+            goto cleanup;
         }
     } else {
-        ret_val = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->master_secret.master_secret,
-            hash_size, bin_str4, bin_str4_size,
+        ret_val = libspdm_hkdf_expand_with_state(
+            &master_secret_state, bin_str4, bin_str4_size,
             secured_message_context->application_secret
             .response_data_secret,
             hash_size);
@@ -513,13 +560,12 @@ libspdm_generate_session_data_key(void *spdm_secured_message_context,
             .export_master_secret,
             hash_size);
         if (!ret_val) {
-            return RETURN_UNSUPPORTED;
+            status = RETURN_UNSUPPORTED;
+            goto cleanup;
         }
     } else {
-        ret_val = libspdm_hkdf_expand(
-            secured_message_context->base_hash_algo,
-            secured_message_context->master_secret.master_secret,
-            hash_size, bin_str8, bin_str8_size,
+        ret_val = libspdm_hkdf_expand_with_state(
+            &master_secret_state, bin_str8, bin_str8_size,
             secured_message_context->handshake_secret
             .export_master_secret,
             hash_size);
@@ -530,10 +576,18 @@ libspdm_generate_session_data_key(void *spdm_secured_message_context,
         secured_message_context->handshake_secret.export_master_secret,
         hash_size);
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
+    status = RETURN_SUCCESS;
+
+cleanup:
+    libspdm_hmac_state_free(&master_secret_state);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
 
-    status = libspdm_generate_aead_key_and_iv(
+    status = libspdm_generate_secret_keys(
         secured_message_context,
         secured_message_context->application_secret.request_data_secret,
+        NULL,
         secured_message_context->application_secret
         .request_data_encryption_key,
         secured_message_context->application_secret.request_data_salt);
@@ -543,9 +597,10 @@ libspdm_generate_session_data_key(void *spdm_secured_message_context,
     secured_message_context->application_secret
     .request_data_sequence_number = 0;
 
-    status = libspdm_generate_aead_key_and_iv(
+    status = libspdm_generate_secret_keys(
         secured_message_context,
         secured_message_context->application_secret.response_data_secret,
+        NULL,
         secured_message_context->application_secret
         .response_data_encryption_key,
         secured_message_context->application_secret.response_data_salt);
@@ -638,10 +693,11 @@ libspdm_create_update_session_data_key(void *spdm_secured_message_context,
                                    hash_size);
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
 
-        status = libspdm_generate_aead_key_and_iv(
+        status = libspdm_generate_secret_keys(
             secured_message_context,
             secured_message_context->application_secret
             .request_data_secret,
+            NULL,
             secured_message_context->application_secret
             .request_data_encryption_key,
             secured_message_context->application_secret
@@ -699,10 +755,11 @@ libspdm_create_update_session_data_key(void *spdm_secured_message_context,
                                    hash_size);
         LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO, "\n"));
 
-        status = libspdm_generate_aead_key_and_iv(
+        status = libspdm_generate_secret_keys(
             secured_message_context,
             secured_message_context->application_secret
             .response_data_secret,
+            NULL,
             secured_message_context->application_secret
             .response_data_encryption_key,
             secured_message_context->application_secret
@@ -910,6 +967,27 @@ bool libspdm_hmac_init_with_request_finished_key(
         secured_message_context->hash_size);
 }
 
+/**
+ * Initializes a fixed-size HMAC state with request_finished_key.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  hmac_state                      Pointer to the HMAC state being initialized.
+ *
+ * @retval true   The key is set successfully.
+ * @retval false  The key is set unsuccessfully.
+ **/
+bool libspdm_hmac_state_init_with_request_finished_key(
+    void *spdm_secured_message_context, libspdm_hmac_state_t *hmac_state)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+
+    secured_message_context = spdm_secured_message_context;
+    return libspdm_hmac_state_init(
+        secured_message_context->base_hash_algo, hmac_state,
+        secured_message_context->handshake_secret.request_finished_key,
+        secured_message_context->hash_size);
+}
+
 /**
  * Makes a copy of an existing HMAC context, with request_finished_key.
  *
@@ -1057,6 +1135,27 @@ bool libspdm_hmac_init_with_response_finished_key(
         secured_message_context->hash_size);
 }
 
+/**
+ * Initializes a fixed-size HMAC state with response_finished_key.
+ *
+ * @param  spdm_secured_message_context    A pointer to the SPDM secured message context.
+ * @param  hmac_state                      Pointer to the HMAC state being initialized.
+ *
+ * @retval true   The key is set successfully.
+ * @retval false  The key is set unsuccessfully.
+ **/
+bool libspdm_hmac_state_init_with_response_finished_key(
+    void *spdm_secured_message_context, libspdm_hmac_state_t *hmac_state)
+{
+    libspdm_secured_message_context_t *secured_message_context;
+
+    secured_message_context = spdm_secured_message_context;
+    return libspdm_hmac_state_init(
+        secured_message_context->base_hash_algo, hmac_state,
+        secured_message_context->handshake_secret.response_finished_key,
+        secured_message_context->hash_size);
+}
+
 /**
  * Makes a copy of an existing HMAC context, with response_finished_key.
  *
@@ -0,0 +1,41 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Internal include file for the code shared by all the cryptlib implementations.
+ **/
+
+#ifndef __INTERNAL_CRYPT_COMMON_H__
+#define __INTERNAL_CRYPT_COMMON_H__
+
+#include <base.h>
+#include "library/memlib.h"
+#include "library/cryptlib.h"
+
+/* A spin lock, for the short critical sections of the process-wide state, see sync.c*/
+typedef volatile long libspdm_spin_lock_t;
+
+void libspdm_spin_lock_acquire(libspdm_spin_lock_t *lock);
+void libspdm_spin_lock_release(libspdm_spin_lock_t *lock);
+
+/* A one-time initialization, zero initialized, see sync.c*/
+typedef struct {
+    volatile long state;
+    bool result;
+} libspdm_once_t;
+
+bool libspdm_once(libspdm_once_t *once, bool (*init_function)(void));
+
+/* A pointer published once and then only read, see sync.c*/
+void *libspdm_atomic_load_pointer(void *volatile *target);
+void *libspdm_atomic_publish_pointer(void *volatile *target, void *value);
+
+/* Issuer signature verification cache, see x509_verify_cache.c*/
+bool libspdm_x509_verify_cache_is_enabled(void);
+bool libspdm_x509_verify_cache_lookup(const uint8_t *issuer_hash, const uint8_t *subject_hash);
+void libspdm_x509_verify_cache_insert(const uint8_t *issuer_hash, const uint8_t *subject_hash);
+
+#endif
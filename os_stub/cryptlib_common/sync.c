@@ -0,0 +1,157 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Synchronization of the process-wide state of the cryptlib implementations.
+ *
+ * The crypto libraries may be built without their own thread support, so the few globals
+ * shared by the contexts of several threads are protected here. A compiler without
+ * atomic intrinsics is not supported.
+ *
+ * It is built into malloclib, which every cryptlib links, so that the arenas of malloclib
+ * use the same primitives.
+ **/
+
+#include "internal_crypt_common.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif !defined(__GNUC__) && !defined(__clang__)
+#error "The cryptlib synchronization requires the _Interlocked or the __atomic intrinsics."
+#endif
+
+#define LIBSPDM_ONCE_NOT_STARTED 0
+#define LIBSPDM_ONCE_RUNNING 1
+#define LIBSPDM_ONCE_DONE 2
+
+/**
+ * Acquire a spin lock, wait while another thread holds it.
+ *
+ * @param  lock    The spin lock, initialized to 0.
+ **/
+void libspdm_spin_lock_acquire(libspdm_spin_lock_t *lock)
+{
+#if defined(_MSC_VER)
+    while (_InterlockedExchange(lock, 1) != 0) {
+    }
+#else
+    while (__atomic_exchange_n(lock, 1, __ATOMIC_ACQUIRE) != 0) {
+    }
+#endif
+}
+
+/**
+ * Release a spin lock acquired by libspdm_spin_lock_acquire().
+ *
+ * @param  lock    The spin lock.
+ **/
+void libspdm_spin_lock_release(libspdm_spin_lock_t *lock)
+{
+#if defined(_MSC_VER)
+    _InterlockedExchange(lock, 0);
+#else
+    __atomic_store_n(lock, 0, __ATOMIC_RELEASE);
+#endif
+}
+
+static long libspdm_once_load_state(libspdm_once_t *once)
+{
+#if defined(_MSC_VER)
+    return _InterlockedCompareExchange(&once->state, 0, 0);
+#else
+    return __atomic_load_n(&once->state, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/* Move the state from NOT_STARTED to RUNNING, return true for the only caller that did it.*/
+static bool libspdm_once_claim(libspdm_once_t *once)
+{
+#if defined(_MSC_VER)
+    return _InterlockedCompareExchange(&once->state, LIBSPDM_ONCE_RUNNING,
+                                       LIBSPDM_ONCE_NOT_STARTED) == LIBSPDM_ONCE_NOT_STARTED;
+#else
+    long expected;
+
+    expected = LIBSPDM_ONCE_NOT_STARTED;
+    return __atomic_compare_exchange_n(&once->state, &expected, LIBSPDM_ONCE_RUNNING, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * Run an initialization function once per process.
+ *
+ * Concurrent callers wait until the first one completed the initialization, and all callers
+ * get its result. A failed initialization is not retried.
+ *
+ * @param  once             The state of the initialization, zero initialized.
+ * @param  init_function    The initialization function.
+ *
+ * @return the result of the initialization function.
+ **/
+bool libspdm_once(libspdm_once_t *once, bool (*init_function)(void))
+{
+    if (libspdm_once_load_state(once) == LIBSPDM_ONCE_DONE) {
+        return once->result;
+    }
+
+    if (!libspdm_once_claim(once)) {
+        while (libspdm_once_load_state(once) != LIBSPDM_ONCE_DONE) {
+        }
+        return once->result;
+    }
+
+    once->result = init_function();
+#if defined(_MSC_VER)
+    _InterlockedExchange(&once->state, LIBSPDM_ONCE_DONE);
+#else
+    __atomic_store_n(&once->state, LIBSPDM_ONCE_DONE, __ATOMIC_RELEASE);
+#endif
+    return once->result;
+}
+
+/**
+ * Read a pointer published by libspdm_atomic_publish_pointer().
+ *
+ * @param  target    The shared pointer.
+ *
+ * @return the shared pointer, NULL if none is published yet.
+ **/
+void *libspdm_atomic_load_pointer(void *volatile *target)
+{
+#if defined(_MSC_VER)
+    return _InterlockedCompareExchangePointer(target, NULL, NULL);
+#else
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+/**
+ * Publish a pointer if none is published yet.
+ *
+ * @param  target    The shared pointer, initialized to NULL.
+ * @param  value     The pointer to publish.
+ *
+ * @return the shared pointer after the call, value only if it was published by this call.
+ **/
+void *libspdm_atomic_publish_pointer(void *volatile *target, void *value)
+{
+#if defined(_MSC_VER)
+    void *original;
+
+    original = _InterlockedCompareExchangePointer(target, value, NULL);
+    return (original == NULL) ? value : original;
+#else
+    void *expected;
+
+    expected = NULL;
+    if (__atomic_compare_exchange_n(target, &expected, value, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return value;
+    }
+    return expected;
+#endif
+}
@@ -0,0 +1,204 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Process-wide cache of successful issuer signature verifications.
+ *
+ * libspdm_x509_verify_cert_chain() records every (issuer, subject) certificate pair it
+ * verified, keyed by the SHA-256 of both DER encodings. When the same intermediate
+ * certificates show up again in the chain of another peer, only the pairs that are
+ * not cached, typically the leaf one, are verified again. The validity window of both
+ * certificates is still checked by the caller on every hit.
+ *
+ * The cache is disabled until libspdm_x509_verify_cache_set_max_entry_count() is called.
+ * The least recently used entry is evicted when the cache is full.
+ *
+ * It is shared by the cryptlib implementations, which call it from
+ * libspdm_x509_verify_cert_chain().
+ **/
+
+#include "internal_crypt_common.h"
+
+typedef struct {
+    uint8_t issuer_hash[LIBSPDM_SHA256_DIGEST_SIZE];
+    uint8_t subject_hash[LIBSPDM_SHA256_DIGEST_SIZE];
+    uint64_t last_use;
+} libspdm_x509_verify_cache_entry_t;
+
+typedef struct {
+    uintn max_entry_count;
+    uintn entry_count;
+    uint64_t use_counter;
+    uint64_t hit_count;
+    uint64_t miss_count;
+    libspdm_x509_verify_cache_entry_t entry[LIBSPDM_X509_VERIFY_CACHE_MAX_ENTRY_COUNT];
+} libspdm_x509_verify_cache_t;
+
+static libspdm_x509_verify_cache_t m_libspdm_x509_verify_cache;
+
+/* The critical sections are a few memory compares, so a spin lock is enough.*/
+static libspdm_spin_lock_t m_libspdm_x509_verify_cache_lock;
+
+static libspdm_x509_verify_cache_entry_t *libspdm_x509_verify_cache_find(
+    const uint8_t *issuer_hash, const uint8_t *subject_hash)
+{
+    uintn index;
+    libspdm_x509_verify_cache_entry_t *entry;
+
+    for (index = 0; index < m_libspdm_x509_verify_cache.entry_count; index++) {
+        entry = &m_libspdm_x509_verify_cache.entry[index];
+        if ((libspdm_const_compare_mem(entry->subject_hash, subject_hash,
+                                       LIBSPDM_SHA256_DIGEST_SIZE) == 0) &&
+            (libspdm_const_compare_mem(entry->issuer_hash, issuer_hash,
+                                       LIBSPDM_SHA256_DIGEST_SIZE) == 0)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Return if the issuer signature verification cache is enabled.
+ **/
+bool libspdm_x509_verify_cache_is_enabled(void)
+{
+    bool enabled;
+
+    libspdm_spin_lock_acquire(&m_libspdm_x509_verify_cache_lock);
+    enabled = (m_libspdm_x509_verify_cache.max_entry_count != 0);
+    libspdm_spin_lock_release(&m_libspdm_x509_verify_cache_lock);
+
+    return enabled;
+}
+
+/**
+ * Look up one successful issuer signature verification and update the hit/miss statistics.
+ *
+ * @param[in]  issuer_hash     SHA-256 of the DER-encoded issuer certificate.
+ * @param[in]  subject_hash    SHA-256 of the DER-encoded subject certificate.
+ *
+ * @retval  true   The subject certificate was already verified with this issuer.
+ * @retval  false  The pair is not cached.
+ **/
+bool libspdm_x509_verify_cache_lookup(const uint8_t *issuer_hash, const uint8_t *subject_hash)
+{
+    libspdm_x509_verify_cache_entry_t *entry;
+
+    libspdm_spin_lock_acquire(&m_libspdm_x509_verify_cache_lock);
+    entry = libspdm_x509_verify_cache_find(issuer_hash, subject_hash);
+    if (entry != NULL) {
+        entry->last_use = ++m_libspdm_x509_verify_cache.use_counter;
+        m_libspdm_x509_verify_cache.hit_count++;
+    } else {
+        m_libspdm_x509_verify_cache.miss_count++;
+    }
+    libspdm_spin_lock_release(&m_libspdm_x509_verify_cache_lock);
+
+    return entry != NULL;
+}
+
+/**
+ * Record one successful issuer signature verification.
+ *
+ * @param[in]  issuer_hash     SHA-256 of the DER-encoded issuer certificate.
+ * @param[in]  subject_hash    SHA-256 of the DER-encoded subject certificate.
+ **/
+void libspdm_x509_verify_cache_insert(const uint8_t *issuer_hash, const uint8_t *subject_hash)
+{
+    libspdm_x509_verify_cache_entry_t *entry;
+    uintn index;
+
+    libspdm_spin_lock_acquire(&m_libspdm_x509_verify_cache_lock);
+    if (m_libspdm_x509_verify_cache.max_entry_count == 0) {
+        libspdm_spin_lock_release(&m_libspdm_x509_verify_cache_lock);
+        return;
+    }
+    entry = libspdm_x509_verify_cache_find(issuer_hash, subject_hash);
+    if (entry == NULL) {
+        if (m_libspdm_x509_verify_cache.entry_count <
+            m_libspdm_x509_verify_cache.max_entry_count) {
+            entry = &m_libspdm_x509_verify_cache.entry[m_libspdm_x509_verify_cache.entry_count];
+            m_libspdm_x509_verify_cache.entry_count++;
+        } else {
+            entry = &m_libspdm_x509_verify_cache.entry[0];
+            for (index = 1; index < m_libspdm_x509_verify_cache.entry_count; index++) {
+                if (m_libspdm_x509_verify_cache.entry[index].last_use < entry->last_use) {
+                    entry = &m_libspdm_x509_verify_cache.entry[index];
+                }
+            }
+        }
+        libspdm_copy_mem(entry->issuer_hash, sizeof(entry->issuer_hash),
+                         issuer_hash, LIBSPDM_SHA256_DIGEST_SIZE);
+        libspdm_copy_mem(entry->subject_hash, sizeof(entry->subject_hash),
+                         subject_hash, LIBSPDM_SHA256_DIGEST_SIZE);
+    }
+    entry->last_use = ++m_libspdm_x509_verify_cache.use_counter;
+    libspdm_spin_lock_release(&m_libspdm_x509_verify_cache_lock);
+}
+
+/**
+ * Set the maximum number of entries of the process-wide issuer signature verification cache
+ * used by libspdm_x509_verify_cert_chain().
+ *
+ * The cache is disabled by default. Setting the maximum to 0 disables it again.
+ * The cached entries are flushed, the statistics are kept.
+ *
+ * @param[in]  max_entry_count   Maximum number of cached certificate pairs.
+ *
+ * @retval  true   The cache is configured.
+ * @retval  false  max_entry_count is larger than LIBSPDM_X509_VERIFY_CACHE_MAX_ENTRY_COUNT.
+ **/
+bool libspdm_x509_verify_cache_set_max_entry_count(uintn max_entry_count)
+{
+    if (max_entry_count > LIBSPDM_X509_VERIFY_CACHE_MAX_ENTRY_COUNT) {
+        return false;
+    }
+
+    libspdm_spin_lock_acquire(&m_libspdm_x509_verify_cache_lock);
+    m_libspdm_x509_verify_cache.max_entry_count = max_entry_count;
+    m_libspdm_x509_verify_cache.entry_count = 0;
+    libspdm_spin_lock_release(&m_libspdm_x509_verify_cache_lock);
+
+    return true;
+}
+
+/**
+ * Remove all entries of the issuer signature verification cache and reset its statistics.
+ **/
+void libspdm_x509_verify_cache_flush(void)
+{
+    libspdm_spin_lock_acquire(&m_libspdm_x509_verify_cache_lock);
+    m_libspdm_x509_verify_cache.entry_count = 0;
+    m_libspdm_x509_verify_cache.use_counter = 0;
+    m_libspdm_x509_verify_cache.hit_count = 0;
+    m_libspdm_x509_verify_cache.miss_count = 0;
+    libspdm_spin_lock_release(&m_libspdm_x509_verify_cache_lock);
+}
+
+/**
+ * Get the statistics of the issuer signature verification cache.
+ *
+ * @param[out]  hit_count     Number of certificate pairs whose signature check was skipped.
+ *                            Optional, may be NULL.
+ * @param[out]  miss_count    Number of certificate pairs that were verified.
+ *                            Optional, may be NULL.
+ * @param[out]  entry_count   Number of cached certificate pairs. Optional, may be NULL.
+ **/
+void libspdm_x509_verify_cache_get_statistics(uint64_t *hit_count, uint64_t *miss_count,
+                                              uintn *entry_count)
+{
+    libspdm_spin_lock_acquire(&m_libspdm_x509_verify_cache_lock);
+    if (hit_count != NULL) {
+        *hit_count = m_libspdm_x509_verify_cache.hit_count;
+    }
+    if (miss_count != NULL) {
+        *miss_count = m_libspdm_x509_verify_cache.miss_count;
+    }
+    if (entry_count != NULL) {
+        *entry_count = m_libspdm_x509_verify_cache.entry_count;
+    }
+    libspdm_spin_lock_release(&m_libspdm_x509_verify_cache_lock);
+}
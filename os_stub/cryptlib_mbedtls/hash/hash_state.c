@@ -0,0 +1,253 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Fixed-size hash state Wrapper Implementation.
+ *
+ * SHA-256/384/512 use the mbedtls digest context, embedded in libspdm_hash_state_t.
+ * The other hash algorithms fall back to a hash context allocated by the matching
+ * libspdm_*_new().
+ **/
+
+#include "internal_crypt_lib.h"
+#include <mbedtls/sha256.h>
+#include <mbedtls/sha512.h>
+
+STATIC_ASSERT(sizeof(mbedtls_sha256_context) <= LIBSPDM_HASH_STATE_CONTEXT_SIZE,
+              "mbedtls_sha256_context does not fit in libspdm_hash_state_t");
+STATIC_ASSERT(sizeof(mbedtls_sha512_context) <= LIBSPDM_HASH_STATE_CONTEXT_SIZE,
+              "mbedtls_sha512_context does not fit in libspdm_hash_state_t");
+
+typedef struct {
+    uintn hash_nid;
+    void *(*new_func)(void);
+    void (*free_func)(void *context);
+    bool (*init_func)(void *context);
+    bool (*duplicate_func)(const void *context, void *new_context);
+    bool (*update_func)(void *context, const void *data, uintn data_size);
+    bool (*final_func)(void *context, uint8_t *hash_value);
+} libspdm_hash_state_heap_func_t;
+
+static const libspdm_hash_state_heap_func_t m_libspdm_hash_state_heap_func[] = {
+    { LIBSPDM_CRYPTO_NID_SHA3_256, libspdm_sha3_256_new, libspdm_sha3_256_free,
+      libspdm_sha3_256_init, libspdm_sha3_256_duplicate, libspdm_sha3_256_update,
+      libspdm_sha3_256_final },
+    { LIBSPDM_CRYPTO_NID_SHA3_384, libspdm_sha3_384_new, libspdm_sha3_384_free,
+      libspdm_sha3_384_init, libspdm_sha3_384_duplicate, libspdm_sha3_384_update,
+      libspdm_sha3_384_final },
+    { LIBSPDM_CRYPTO_NID_SHA3_512, libspdm_sha3_512_new, libspdm_sha3_512_free,
+      libspdm_sha3_512_init, libspdm_sha3_512_duplicate, libspdm_sha3_512_update,
+      libspdm_sha3_512_final },
+    { LIBSPDM_CRYPTO_NID_SM3_256, libspdm_sm3_256_new, libspdm_sm3_256_free,
+      libspdm_sm3_256_init, libspdm_sm3_256_duplicate, libspdm_sm3_256_update,
+      libspdm_sm3_256_final },
+};
+
+static const libspdm_hash_state_heap_func_t *libspdm_hash_state_get_heap_func(uintn hash_nid)
+{
+    uintn index;
+
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_hash_state_heap_func); index++) {
+        if (m_libspdm_hash_state_heap_func[index].hash_nid == hash_nid) {
+            return &m_libspdm_hash_state_heap_func[index];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Initializes a hash state for subsequent use.
+ *
+ * The state does not need to be freed if the initialization fails.
+ *
+ * @param[in]   hash_nid   hash NID.
+ * @param[out]  state      Pointer to the hash state being initialized.
+ *
+ * @retval true   Hash state initialization succeeded.
+ * @retval false  Hash state initialization failed.
+ * @retval false  The hash algorithm is not supported.
+ **/
+bool libspdm_hash_state_init_by_nid(uintn hash_nid, libspdm_hash_state_t *state)
+{
+    const libspdm_hash_state_heap_func_t *heap_func;
+    int ret;
+
+    if (state == NULL) {
+        return false;
+    }
+    libspdm_zero_mem(state, sizeof(libspdm_hash_state_t));
+
+    switch (hash_nid) {
+    case LIBSPDM_CRYPTO_NID_SHA256:
+        mbedtls_sha256_init((mbedtls_sha256_context *)state->context);
+        ret = mbedtls_sha256_starts_ret((mbedtls_sha256_context *)state->context, false);
+        break;
+    case LIBSPDM_CRYPTO_NID_SHA384:
+    case LIBSPDM_CRYPTO_NID_SHA512:
+        mbedtls_sha512_init((mbedtls_sha512_context *)state->context);
+        ret = mbedtls_sha512_starts_ret((mbedtls_sha512_context *)state->context,
+                                        hash_nid == LIBSPDM_CRYPTO_NID_SHA384);
+        break;
+    default:
+        heap_func = libspdm_hash_state_get_heap_func(hash_nid);
+        if (heap_func == NULL) {
+            return false;
+        }
+        state->heap_context = heap_func->new_func();
+        if (state->heap_context == NULL) {
+            return false;
+        }
+        if (!heap_func->init_func(state->heap_context)) {
+            heap_func->free_func(state->heap_context);
+            state->heap_context = NULL;
+            return false;
+        }
+        ret = 0;
+        break;
+    }
+    if (ret != 0) {
+        return false;
+    }
+    state->hash_nid = hash_nid;
+    return true;
+}
+
+/**
+ * Makes a copy of an existing hash state.
+ *
+ * new_state must not hold an initialized hash state, it is overwritten.
+ *
+ * @param[in]   state      Pointer to the hash state being copied.
+ * @param[out]  new_state  Pointer to the new hash state.
+ *
+ * @retval true   Hash state copy succeeded.
+ * @retval false  Hash state copy failed.
+ **/
+bool libspdm_hash_state_duplicate(const libspdm_hash_state_t *state,
+                                  libspdm_hash_state_t *new_state)
+{
+    const libspdm_hash_state_heap_func_t *heap_func;
+
+    if ((state == NULL) || (new_state == NULL) ||
+        (state->hash_nid == LIBSPDM_CRYPTO_NID_NULL)) {
+        return false;
+    }
+    if (state->heap_context == NULL) {
+        /* Plain structure copy, the transcript duplicates its states for every TH.*/
+        *new_state = *state;
+        return true;
+    }
+
+    heap_func = libspdm_hash_state_get_heap_func(state->hash_nid);
+    LIBSPDM_ASSERT(heap_func != NULL);
+    libspdm_zero_mem(new_state, sizeof(libspdm_hash_state_t));
+    new_state->heap_context = heap_func->new_func();
+    if (new_state->heap_context == NULL) {
+        return false;
+    }
+    if (!heap_func->duplicate_func(state->heap_context, new_state->heap_context)) {
+        heap_func->free_func(new_state->heap_context);
+        new_state->heap_context = NULL;
+        return false;
+    }
+    new_state->hash_nid = state->hash_nid;
+    return true;
+}
+
+/**
+ * Digests the input data and updates the hash state.
+ *
+ * @param[in, out]  state      Pointer to the hash state.
+ * @param[in]       data       Pointer to the buffer containing the data to be hashed.
+ * @param[in]       data_size  size of data buffer in bytes.
+ *
+ * @retval true   Hash data digest succeeded.
+ * @retval false  Hash data digest failed.
+ **/
+bool libspdm_hash_state_update(libspdm_hash_state_t *state, const void *data,
+                               uintn data_size)
+{
+    if (state == NULL) {
+        return false;
+    }
+    if (data == NULL && data_size != 0) {
+        return false;
+    }
+    if (data_size == 0) {
+        return (state->hash_nid != LIBSPDM_CRYPTO_NID_NULL);
+    }
+
+    switch (state->hash_nid) {
+    case LIBSPDM_CRYPTO_NID_SHA256:
+        return mbedtls_sha256_update_ret((mbedtls_sha256_context *)state->context,
+                                         data, data_size) == 0;
+    case LIBSPDM_CRYPTO_NID_SHA384:
+    case LIBSPDM_CRYPTO_NID_SHA512:
+        return mbedtls_sha512_update_ret((mbedtls_sha512_context *)state->context,
+                                         data, data_size) == 0;
+    case LIBSPDM_CRYPTO_NID_NULL:
+        return false;
+    default:
+        return libspdm_hash_state_get_heap_func(state->hash_nid)->update_func(
+            state->heap_context, data, data_size);
+    }
+}
+
+/**
+ * Completes computation of the hash digest value and releases the hash state.
+ *
+ * @param[in, out]  state       Pointer to the hash state.
+ * @param[out]      hash_value  Pointer to a buffer that receives the hash digest value.
+ *
+ * @retval true   Hash digest computation succeeded.
+ * @retval false  Hash digest computation failed.
+ **/
+bool libspdm_hash_state_final(libspdm_hash_state_t *state, uint8_t *hash_value)
+{
+    bool result;
+
+    if ((state == NULL) || (hash_value == NULL)) {
+        return false;
+    }
+
+    switch (state->hash_nid) {
+    case LIBSPDM_CRYPTO_NID_SHA256:
+        result = mbedtls_sha256_finish_ret((mbedtls_sha256_context *)state->context,
+                                           hash_value) == 0;
+        break;
+    case LIBSPDM_CRYPTO_NID_SHA384:
+    case LIBSPDM_CRYPTO_NID_SHA512:
+        result = mbedtls_sha512_finish_ret((mbedtls_sha512_context *)state->context,
+                                           hash_value) == 0;
+        break;
+    case LIBSPDM_CRYPTO_NID_NULL:
+        return false;
+    default:
+        result = libspdm_hash_state_get_heap_func(state->hash_nid)->final_func(
+            state->heap_context, hash_value);
+        break;
+    }
+    libspdm_hash_state_free(state);
+    return result;
+}
+
+/**
+ * Releases a hash state. The state is zeroed.
+ *
+ * It is safe to release a state that is zeroed, already released or finalized.
+ *
+ * @param[in, out]  state  Pointer to the hash state.
+ **/
+void libspdm_hash_state_free(libspdm_hash_state_t *state)
+{
+    if (state == NULL) {
+        return;
+    }
+    if (state->heap_context != NULL) {
+        libspdm_hash_state_get_heap_func(state->hash_nid)->free_func(state->heap_context);
+    }
+    libspdm_zero_mem(state, sizeof(libspdm_hash_state_t));
+}
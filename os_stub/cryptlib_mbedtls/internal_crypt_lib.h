@@ -16,6 +16,7 @@
 #include "library/malloclib.h"
 #include "library/debuglib.h"
 #include "library/cryptlib.h"
+#include "internal_crypt_common.h"
 #include <stdio.h>
 
 
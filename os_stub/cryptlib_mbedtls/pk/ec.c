@@ -17,6 +17,109 @@
 #include <mbedtls/ecdsa.h>
 #include <mbedtls/bignum.h>
 
+/* P-256, P-384, P-521*/
+#define LIBSPDM_EC_FIXED_BASE_GROUP_COUNT 3
+
+/**
+ * Per-curve groups holding the precomputed comb table of the generator.
+ *
+ * mbedtls keeps the fixed-base table (MBEDTLS_ECP_FIXED_POINT_OPTIM) in the
+ * mbedtls_ecp_group, so every new EC context used to rebuild it on its first
+ * multiplication by G. These groups are built once and shared by all contexts
+ * of the same curve. Once published a group is only read, the comb lookup is
+ * unchanged and stays constant-time, so it can be used by concurrent callers.
+ **/
+static void *volatile m_libspdm_ec_fixed_base_group[LIBSPDM_EC_FIXED_BASE_GROUP_COUNT];
+
+/**
+ * Return the shared group with the precomputed generator table for a curve.
+ *
+ * The table is built on first use, from the default heap: it lives until the
+ * end of the process, so it must not come from the arena of the caller. If two
+ * callers race, the loser frees its own copy and uses the published one.
+ *
+ * @param grp_id    mbedtls curve id.
+ *
+ * @return the shared group, or NULL if the curve has no shared group or the
+ *         table cannot be built. Callers then fall back to their own group.
+ **/
+static mbedtls_ecp_group *libspdm_ec_get_fixed_base_group(mbedtls_ecp_group_id grp_id)
+{
+    void *volatile *target;
+    const libspdm_pool_allocator_t *previous_allocator;
+    mbedtls_ecp_group *group;
+    mbedtls_ecp_point point;
+    mbedtls_mpi one;
+    int32_t ret;
+
+    switch (grp_id) {
+    case MBEDTLS_ECP_DP_SECP256R1:
+        target = &m_libspdm_ec_fixed_base_group[0];
+        break;
+    case MBEDTLS_ECP_DP_SECP384R1:
+        target = &m_libspdm_ec_fixed_base_group[1];
+        break;
+    case MBEDTLS_ECP_DP_SECP521R1:
+        target = &m_libspdm_ec_fixed_base_group[2];
+        break;
+    default:
+        return NULL;
+    }
+
+    group = libspdm_atomic_load_pointer(target);
+    if (group != NULL) {
+        return group;
+    }
+
+    previous_allocator = libspdm_set_pool_allocator(NULL);
+    group = allocate_pool(sizeof(mbedtls_ecp_group));
+    if (group == NULL) {
+        libspdm_set_pool_allocator(previous_allocator);
+        return NULL;
+    }
+    mbedtls_ecp_group_init(group);
+    mbedtls_ecp_point_init(&point);
+    mbedtls_mpi_init(&one);
+
+    /* 1 * G builds the comb table of G and keeps it in group->T.*/
+    ret = mbedtls_ecp_group_load(group, grp_id);
+    if (ret == 0) {
+        ret = mbedtls_mpi_lset(&one, 1);
+    }
+    if (ret == 0) {
+        ret = mbedtls_ecp_mul(group, &point, &one, &group->G, libspdm_myrand, NULL);
+    }
+    mbedtls_ecp_point_free(&point);
+    mbedtls_mpi_free(&one);
+    libspdm_set_pool_allocator(previous_allocator);
+    if (ret != 0) {
+        mbedtls_ecp_group_free(group);
+        free_pool(group);
+        return NULL;
+    }
+
+    if (libspdm_atomic_publish_pointer(target, group) != group) {
+        mbedtls_ecp_group_free(group);
+        free_pool(group);
+        group = libspdm_atomic_load_pointer(target);
+    }
+    return group;
+}
+
+/**
+ * Return the group to use for a multiplication by the generator.
+ **/
+static mbedtls_ecp_group *libspdm_ec_get_group(mbedtls_ecdh_context *ctx)
+{
+    mbedtls_ecp_group *group;
+
+    group = libspdm_ec_get_fixed_base_group(ctx->grp.id);
+    if (group == NULL) {
+        group = &ctx->grp;
+    }
+    return group;
+}
+
 /**
  * Allocates and Initializes one Elliptic Curve context for subsequent use
  * with the NID.
@@ -273,8 +376,8 @@ bool libspdm_ec_generate_key(void *ec_context, uint8_t *public,
     }
 
     ctx = ec_context;
-    ret = mbedtls_ecdh_gen_public(&ctx->grp, &ctx->d, &ctx->Q, libspdm_myrand,
-                                  NULL);
+    ret = mbedtls_ecdh_gen_public(libspdm_ec_get_group(ctx), &ctx->d, &ctx->Q,
+                                  libspdm_myrand, NULL);
     if (ret != 0) {
         return false;
     }
@@ -511,8 +614,8 @@ bool libspdm_ecdsa_sign(void *ec_context, uintn hash_nid,
     mbedtls_mpi_init(&bn_r);
     mbedtls_mpi_init(&bn_s);
 
-    ret = mbedtls_ecdsa_sign(&ctx->grp, &bn_r, &bn_s, &ctx->d, message_hash,
-                             hash_size, libspdm_myrand, NULL);
+    ret = mbedtls_ecdsa_sign(libspdm_ec_get_group(ctx), &bn_r, &bn_s, &ctx->d,
+                             message_hash, hash_size, libspdm_myrand, NULL);
     if (ret != 0) {
         return false;
     }
@@ -640,8 +743,8 @@ bool libspdm_ecdsa_verify(void *ec_context, uintn hash_nid,
         return false;
     }
 
-    ret = mbedtls_ecdsa_verify(&ctx->grp, message_hash, hash_size, &ctx->Q,
-                               &bn_r, &bn_s);
+    ret = mbedtls_ecdsa_verify(libspdm_ec_get_group(ctx), message_hash, hash_size,
+                               &ctx->Q, &bn_r, &bn_s);
     mbedtls_mpi_free(&bn_r);
     mbedtls_mpi_free(&bn_s);
 
@@ -60,10 +60,16 @@ bool libspdm_x509_construct_certificate(const uint8_t *cert, uintn cert_size,
 
     mbedtls_x509_crt_init(mbedtls_cert);
 
-    *single_x509_cert = (uint8_t *)(void *)mbedtls_cert;
     ret = mbedtls_x509_crt_parse_der(mbedtls_cert, cert, cert_size);
+    if (ret != 0) {
+        mbedtls_x509_crt_free(mbedtls_cert);
+        free_pool(mbedtls_cert);
+        return false;
+    }
 
-    return ret == 0;
+    *single_x509_cert = (uint8_t *)(void *)mbedtls_cert;
+
+    return true;
 }
 
 static bool libspdm_x509_construct_certificate_stack_v(uint8_t **x509_stack,
@@ -215,39 +221,62 @@ bool libspdm_x509_get_subject_name(const uint8_t *cert, uintn cert_size,
                                    uintn *subject_size)
 {
     mbedtls_x509_crt crt;
-    int32_t ret;
     bool status;
 
     if (cert == NULL) {
         return false;
     }
 
-    status = false;
-
     mbedtls_x509_crt_init(&crt);
 
-    ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
-
-    if (ret == 0) {
-        if (*subject_size < crt.subject_raw.len) {
-            *subject_size = crt.subject_raw.len;
-            status = false;
-            goto cleanup;
-        }
-        if (cert_subject != NULL) {
-            libspdm_copy_mem(cert_subject, *subject_size,
-                             crt.subject_raw.p, crt.subject_raw.len);
-        }
-        *subject_size = crt.subject_raw.len;
-        status = true;
+    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) == 0) {
+        status = libspdm_x509_object_get_subject_name(&crt, cert_subject, subject_size);
+    } else {
+        status = false;
     }
 
-cleanup:
     mbedtls_x509_crt_free(&crt);
 
     return status;
 }
 
+/**
+ * Retrieve the subject bytes from one X509 object.
+ *
+ * @param[in]      x509_cert     Pointer to the X509 object.
+ * @param[out]     cert_subject  Pointer to the retrieved certificate subject bytes.
+ * @param[in, out] subject_size  The size in bytes of the cert_subject buffer on input,
+ *                             and the size of buffer returned cert_subject on output.
+ *
+ * @retval  true   The certificate subject retrieved successfully.
+ * @retval  false  Invalid X509 object, or the subject_size is too small for the result.
+ *                The subject_size will be updated with the required size.
+ *
+ **/
+bool libspdm_x509_object_get_subject_name(const void *x509_cert,
+                                          uint8_t *cert_subject,
+                                          uintn *subject_size)
+{
+    const mbedtls_x509_crt *crt;
+
+    if (x509_cert == NULL || subject_size == NULL) {
+        return false;
+    }
+
+    crt = x509_cert;
+    if (*subject_size < crt->subject_raw.len) {
+        *subject_size = crt->subject_raw.len;
+        return false;
+    }
+    if (cert_subject != NULL) {
+        libspdm_copy_mem(cert_subject, *subject_size,
+                         crt->subject_raw.p, crt->subject_raw.len);
+    }
+    *subject_size = crt->subject_raw.len;
+
+    return true;
+}
+
 return_status
 libspdm_internal_x509_get_nid_name(mbedtls_x509_name *name, const uint8_t *oid,
                                    uintn oid_size, char *common_name,
@@ -427,32 +456,62 @@ bool libspdm_rsa_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
                                           void **rsa_context)
 {
     mbedtls_x509_crt crt;
-    mbedtls_rsa_context *rsa;
-    int32_t ret;
+    bool status;
+
 
     mbedtls_x509_crt_init(&crt);
 
-    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) != 0) {
+    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) == 0) {
+        status = libspdm_rsa_get_public_key_from_x509_object(&crt, rsa_context);
+    } else {
+        status = false;
+    }
+
+    mbedtls_x509_crt_free(&crt);
+
+    return status;
+}
+
+/**
+ * Retrieve the RSA public key from one X509 object.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] rsa_context   Pointer to new-generated RSA context which contain the retrieved
+ *                         RSA public key component. Use libspdm_rsa_free() function to free the
+ *                         resource.
+ *
+ * If x509_cert is NULL, then return false.
+ * If rsa_context is NULL, then return false.
+ *
+ * @retval  true   RSA public key was retrieved successfully.
+ * @retval  false  Fail to retrieve RSA public key from X509 object.
+ *
+ **/
+bool libspdm_rsa_get_public_key_from_x509_object(const void *x509_cert,
+                                                 void **rsa_context)
+{
+    const mbedtls_x509_crt *crt;
+    mbedtls_rsa_context *rsa;
+    int32_t ret;
+
+    if (x509_cert == NULL || rsa_context == NULL) {
         return false;
     }
 
-    if (mbedtls_pk_get_type(&crt.pk) != MBEDTLS_PK_RSA) {
-        mbedtls_x509_crt_free(&crt);
+    crt = x509_cert;
+    if (mbedtls_pk_get_type(&crt->pk) != MBEDTLS_PK_RSA) {
         return false;
     }
 
     rsa = libspdm_rsa_new();
     if (rsa == NULL) {
-        mbedtls_x509_crt_free(&crt);
         return false;
     }
-    ret = mbedtls_rsa_copy(rsa, mbedtls_pk_rsa(crt.pk));
+    ret = mbedtls_rsa_copy(rsa, mbedtls_pk_rsa(crt->pk));
     if (ret != 0) {
         libspdm_rsa_free(rsa);
-        mbedtls_x509_crt_free(&crt);
         return false;
     }
-    mbedtls_x509_crt_free(&crt);
 
     *rsa_context = rsa;
     return true;
@@ -478,36 +537,66 @@ bool libspdm_ec_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
                                          void **ec_context)
 {
     mbedtls_x509_crt crt;
-    mbedtls_ecdh_context *ecdh;
-    int32_t ret;
+    bool status;
+
 
     mbedtls_x509_crt_init(&crt);
 
-    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) != 0) {
+    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) == 0) {
+        status = libspdm_ec_get_public_key_from_x509_object(&crt, ec_context);
+    } else {
+        status = false;
+    }
+
+    mbedtls_x509_crt_free(&crt);
+
+    return status;
+}
+
+/**
+ * Retrieve the EC public key from one X509 object.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] ec_context    Pointer to new-generated EC DSA context which contain the retrieved
+ *                         EC public key component. Use libspdm_ec_free() function to free the
+ *                         resource.
+ *
+ * If x509_cert is NULL, then return false.
+ * If ec_context is NULL, then return false.
+ *
+ * @retval  true   EC public key was retrieved successfully.
+ * @retval  false  Fail to retrieve EC public key from X509 object.
+ *
+ **/
+bool libspdm_ec_get_public_key_from_x509_object(const void *x509_cert,
+                                                void **ec_context)
+{
+    const mbedtls_x509_crt *crt;
+    mbedtls_ecdh_context *ecdh;
+    int32_t ret;
+
+    if (x509_cert == NULL || ec_context == NULL) {
         return false;
     }
 
-    if (mbedtls_pk_get_type(&crt.pk) != MBEDTLS_PK_ECKEY) {
-        mbedtls_x509_crt_free(&crt);
+    crt = x509_cert;
+    if (mbedtls_pk_get_type(&crt->pk) != MBEDTLS_PK_ECKEY) {
         return false;
     }
 
     ecdh = allocate_zero_pool(sizeof(mbedtls_ecdh_context));
     if (ecdh == NULL) {
-        mbedtls_x509_crt_free(&crt);
         return false;
     }
     mbedtls_ecdh_init(ecdh);
 
-    ret = mbedtls_ecdh_get_params(ecdh, mbedtls_pk_ec(crt.pk),
+    ret = mbedtls_ecdh_get_params(ecdh, mbedtls_pk_ec(crt->pk),
                                   MBEDTLS_ECDH_OURS);
     if (ret != 0) {
         mbedtls_ecdh_free(ecdh);
         free_pool(ecdh);
-        mbedtls_x509_crt_free(&crt);
         return false;
     }
-    mbedtls_x509_crt_free(&crt);
 
     *ec_context = ecdh;
     return true;
@@ -535,6 +624,27 @@ bool libspdm_ecd_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
     return false;
 }
 
+/**
+ * Retrieve the Ed public key from one X509 object.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] ecd_context   Pointer to new-generated Ed DSA context which contain the retrieved
+ *                         Ed public key component. Use libspdm_ecd_free() function to free the
+ *                         resource.
+ *
+ * If x509_cert is NULL, then return false.
+ * If ecd_context is NULL, then return false.
+ *
+ * @retval  true   Ed public key was retrieved successfully.
+ * @retval  false  Fail to retrieve Ed public key from X509 object.
+ *
+ **/
+bool libspdm_ecd_get_public_key_from_x509_object(const void *x509_cert,
+                                                 void **ecd_context)
+{
+    return false;
+}
+
 /**
  * Retrieve the sm2 public key from one DER-encoded X509 certificate.
  *
@@ -557,6 +667,67 @@ bool libspdm_sm2_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
     return false;
 }
 
+/**
+ * Retrieve the sm2 public key from one X509 object.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] sm2_context   Pointer to new-generated sm2 context which contain the retrieved
+ *                         sm2 public key component. Use sm2_free() function to free the
+ *                         resource.
+ *
+ * If x509_cert is NULL, then return false.
+ * If sm2_context is NULL, then return false.
+ *
+ * @retval  true   sm2 public key was retrieved successfully.
+ * @retval  false  Fail to retrieve sm2 public key from X509 object.
+ *
+ **/
+bool libspdm_sm2_get_public_key_from_x509_object(const void *x509_cert,
+                                                 void **sm2_context)
+{
+    return false;
+}
+
+/**
+ * Check if the current time is within the validity window of one X509 certificate object.
+ *
+ * @param[in]      crt          Pointer to the parsed certificate.
+ *
+ * @retval  true   The certificate is valid now.
+ * @retval  false  The certificate is not yet valid or has expired.
+ **/
+static bool libspdm_x509_object_is_time_valid(const mbedtls_x509_crt *crt)
+{
+    return (mbedtls_x509_time_is_past(&crt->valid_to) == 0) &&
+           (mbedtls_x509_time_is_future(&crt->valid_from) == 0);
+}
+
+/**
+ * Verify one X509 object was issued by the trusted CA X509 object.
+ *
+ * @param[in]      crt          Pointer to the X509 object to be verified.
+ * @param[in]      ca           Pointer to the trusted CA X509 object.
+ *
+ * @retval  true   The certificate was issued by the trusted CA.
+ * @retval  false  Invalid certificate or the certificate was not issued by the given
+ *                trusted CA.
+ **/
+static bool libspdm_x509_verify_cert_object(mbedtls_x509_crt *crt, mbedtls_x509_crt *ca)
+{
+    int32_t ret;
+    uint32_t v_flag = 0;
+    mbedtls_x509_crt_profile profile = { 0 };
+
+    libspdm_copy_mem(&profile, sizeof(profile),
+                     &mbedtls_x509_crt_profile_default,
+                     sizeof(mbedtls_x509_crt_profile));
+
+    ret = mbedtls_x509_crt_verify_with_profile(
+        crt, ca, NULL, &profile, NULL, &v_flag, NULL, NULL);
+
+    return ret == 0;
+}
+
 /**
  * Verify one X509 certificate was issued by the trusted CA.
  *
@@ -577,17 +748,14 @@ bool libspdm_x509_verify_cert(const uint8_t *cert, uintn cert_size,
                               const uint8_t *ca_cert, uintn ca_cert_size)
 {
     int32_t ret;
+    bool verify_flag;
     mbedtls_x509_crt ca, end;
-    uint32_t v_flag = 0;
-    mbedtls_x509_crt_profile profile = { 0 };
 
     if (cert == NULL || ca_cert == NULL) {
         return false;
     }
 
-    libspdm_copy_mem(&profile, sizeof(profile),
-                     &mbedtls_x509_crt_profile_default,
-                     sizeof(mbedtls_x509_crt_profile));
+    verify_flag = false;
 
     mbedtls_x509_crt_init(&ca);
     mbedtls_x509_crt_init(&end);
@@ -599,14 +767,13 @@ bool libspdm_x509_verify_cert(const uint8_t *cert, uintn cert_size,
     }
 
     if (ret == 0) {
-        ret = mbedtls_x509_crt_verify_with_profile(
-            &end, &ca, NULL, &profile, NULL, &v_flag, NULL, NULL);
+        verify_flag = libspdm_x509_verify_cert_object(&end, &ca);
     }
 
     mbedtls_x509_crt_free(&ca);
     mbedtls_x509_crt_free(&end);
 
-    return ret == 0;
+    return verify_flag;
 }
 
 /**
@@ -631,17 +798,38 @@ bool libspdm_x509_verify_cert_chain(uint8_t *root_cert, uintn root_cert_length,
                                     uint8_t *cert_chain, uintn cert_chain_length)
 {
     uintn asn1_len;
-    uintn preceding_cert_len;
-    uint8_t *preceding_cert;
     uintn current_cert_len;
     uint8_t *current_cert;
     uint8_t *tmp_ptr;
     uint32_t ret;
     bool verify_flag;
+    mbedtls_x509_crt crt[2];
+    mbedtls_x509_crt *preceding_crt;
+    mbedtls_x509_crt *current_crt;
+    mbedtls_x509_crt *swap_crt;
+    bool cache_enabled;
+    uint8_t preceding_hash[LIBSPDM_SHA256_DIGEST_SIZE];
+    uint8_t current_hash[LIBSPDM_SHA256_DIGEST_SIZE];
 
     verify_flag = false;
-    preceding_cert = root_cert;
-    preceding_cert_len = root_cert_length;
+
+
+    /* Each certificate is parsed only once: it is verified as the subject
+     * certificate, then kept as the issuer object of the next one.*/
+
+    preceding_crt = &crt[0];
+    current_crt = &crt[1];
+    mbedtls_x509_crt_init(preceding_crt);
+    mbedtls_x509_crt_init(current_crt);
+    if (mbedtls_x509_crt_parse_der(preceding_crt, root_cert, root_cert_length) != 0) {
+        mbedtls_x509_crt_free(preceding_crt);
+        return false;
+    }
+
+    cache_enabled = libspdm_x509_verify_cache_is_enabled();
+    if (cache_enabled) {
+        cache_enabled = libspdm_sha256_hash_all(root_cert, root_cert_length, preceding_hash);
+    }
 
     current_cert = cert_chain;
 
@@ -659,20 +847,43 @@ bool libspdm_x509_verify_cert_chain(uint8_t *root_cert, uintn root_cert_length,
 
         current_cert_len = asn1_len + (tmp_ptr - current_cert);
 
-        if (libspdm_x509_verify_cert(current_cert, current_cert_len,
-                                     preceding_cert,
-                                     preceding_cert_len) == false) {
+        if (mbedtls_x509_crt_parse_der(current_crt, current_cert, current_cert_len) != 0) {
             verify_flag = false;
             break;
-        } else {
+        }
+        if (cache_enabled) {
+            cache_enabled = libspdm_sha256_hash_all(current_cert, current_cert_len,
+                                                    current_hash);
+        }
+
+        /* A cached pair skips the signature check, but both certificates must still be valid now.*/
+        if (cache_enabled &&
+            libspdm_x509_object_is_time_valid(current_crt) &&
+            libspdm_x509_object_is_time_valid(preceding_crt) &&
+            libspdm_x509_verify_cache_lookup(preceding_hash, current_hash)) {
             verify_flag = true;
+        } else {
+            verify_flag = libspdm_x509_verify_cert_object(current_crt, preceding_crt);
+            if (!verify_flag) {
+                break;
+            }
+            if (cache_enabled) {
+                libspdm_x509_verify_cache_insert(preceding_hash, current_hash);
+            }
+        }
+        if (cache_enabled) {
+            libspdm_copy_mem(preceding_hash, sizeof(preceding_hash),
+                             current_hash, sizeof(current_hash));
         }
 
 
         /* Save preceding certificate*/
 
-        preceding_cert = current_cert;
-        preceding_cert_len = current_cert_len;
+        mbedtls_x509_crt_free(preceding_crt);
+        mbedtls_x509_crt_init(preceding_crt);
+        swap_crt = preceding_crt;
+        preceding_crt = current_crt;
+        current_crt = swap_crt;
 
 
         /* Move current certificate to next;*/
@@ -680,6 +891,9 @@ bool libspdm_x509_verify_cert_chain(uint8_t *root_cert, uintn root_cert_length,
         current_cert = current_cert + current_cert_len;
     } while (true);
 
+    mbedtls_x509_crt_free(&crt[0]);
+    mbedtls_x509_crt_free(&crt[1]);
+
     return verify_flag;
 }
 
@@ -808,22 +1022,18 @@ return_status libspdm_x509_get_version(const uint8_t *cert, uintn cert_size,
                                        uintn *version)
 {
     mbedtls_x509_crt crt;
-    int32_t ret;
     return_status status;
 
     if (cert == NULL) {
         return RETURN_INVALID_PARAMETER;
     }
 
-    status = RETURN_INVALID_PARAMETER;
-
     mbedtls_x509_crt_init(&crt);
 
-    ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
-
-    if (ret == 0) {
-        *version = crt.version - 1;
-        status = RETURN_SUCCESS;
+    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) == 0) {
+        status = libspdm_x509_object_get_version(&crt, version);
+    } else {
+        status = RETURN_INVALID_PARAMETER;
     }
 
     mbedtls_x509_crt_free(&crt);
@@ -831,6 +1041,26 @@ return_status libspdm_x509_get_version(const uint8_t *cert, uintn cert_size,
     return status;
 }
 
+/**
+ * Retrieve the version from one X509 object.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     version      Pointer to the retrieved version integer.
+ *
+ * @retval RETURN_SUCCESS           The certificate version retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or version is NULL.
+ *
+ **/
+return_status libspdm_x509_object_get_version(const void *x509_cert, uintn *version)
+{
+    if (x509_cert == NULL || version == NULL) {
+        return RETURN_INVALID_PARAMETER;
+    }
+
+    *version = ((const mbedtls_x509_crt *)x509_cert)->version - 1;
+    return RETURN_SUCCESS;
+}
+
 /**
  * Retrieve the serialNumber from one X.509 certificate.
  *
@@ -859,38 +1089,64 @@ return_status libspdm_x509_get_serial_number(const uint8_t *cert, uintn cert_siz
                                              uintn *serial_number_size)
 {
     mbedtls_x509_crt crt;
-    int32_t ret;
     return_status status;
 
     if (cert == NULL) {
         return RETURN_INVALID_PARAMETER;
     }
 
-    status = RETURN_INVALID_PARAMETER;
-
     mbedtls_x509_crt_init(&crt);
 
-    ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
-
-    if (ret == 0) {
-        if (*serial_number_size <= crt.serial.len) {
-            *serial_number_size = crt.serial.len + 1;
-            status = RETURN_BUFFER_TOO_SMALL;
-            goto cleanup;
-        }
-        if (serial_number != NULL) {
-            libspdm_copy_mem(serial_number, *serial_number_size, crt.serial.p, crt.serial.len);
-            serial_number[crt.serial.len] = '\0';
-        }
-        *serial_number_size = crt.serial.len + 1;
-        status = RETURN_SUCCESS;
+    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) == 0) {
+        status = libspdm_x509_object_get_serial_number(&crt, serial_number,
+                                                       serial_number_size);
+    } else {
+        status = RETURN_INVALID_PARAMETER;
     }
-cleanup:
+
     mbedtls_x509_crt_free(&crt);
 
     return status;
 }
 
+/**
+ * Retrieve the serialNumber from one X509 object.
+ *
+ * @param[in]      x509_cert     Pointer to the X509 object.
+ * @param[out]     serial_number  Pointer to the retrieved certificate serial_number bytes.
+ * @param[in, out] serial_number_size  The size in bytes of the serial_number buffer on input,
+ *                             and the size of buffer returned serial_number on output.
+ *
+ * @retval RETURN_SUCCESS           The certificate serialNumber retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or serial_number_size is NULL.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the serial_number_size is too small for the result.
+ *                                 The required size (including the final null) is
+ *                                 returned in serial_number_size.
+ **/
+return_status libspdm_x509_object_get_serial_number(const void *x509_cert,
+                                                    uint8_t *serial_number,
+                                                    uintn *serial_number_size)
+{
+    const mbedtls_x509_crt *crt;
+
+    if (x509_cert == NULL || serial_number_size == NULL) {
+        return RETURN_INVALID_PARAMETER;
+    }
+
+    crt = x509_cert;
+    if (*serial_number_size <= crt->serial.len) {
+        *serial_number_size = crt->serial.len + 1;
+        return RETURN_BUFFER_TOO_SMALL;
+    }
+    if (serial_number != NULL) {
+        libspdm_copy_mem(serial_number, *serial_number_size, crt->serial.p, crt->serial.len);
+        serial_number[crt->serial.len] = '\0';
+    }
+    *serial_number_size = crt->serial.len + 1;
+
+    return RETURN_SUCCESS;
+}
+
 /**
  * Retrieve the issuer bytes from one X.509 certificate.
  *
@@ -915,38 +1171,61 @@ bool libspdm_x509_get_issuer_name(const uint8_t *cert, uintn cert_size,
                                   uintn *issuer_size)
 {
     mbedtls_x509_crt crt;
-    int32_t ret;
     bool status;
 
     if (cert == NULL) {
         return false;
     }
 
-    status = false;
-
     mbedtls_x509_crt_init(&crt);
 
-    ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
-
-    if (ret == 0) {
-        if (*issuer_size < crt.issuer_raw.len) {
-            *issuer_size = crt.issuer_raw.len;
-            status = false;
-            goto cleanup;
-        }
-        if (cert_issuer != NULL) {
-            libspdm_copy_mem(cert_issuer, *issuer_size, crt.issuer_raw.p, crt.issuer_raw.len);
-        }
-        *issuer_size = crt.issuer_raw.len;
-        status = true;
+    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) == 0) {
+        status = libspdm_x509_object_get_issuer_name(&crt, cert_issuer, issuer_size);
+    } else {
+        status = false;
     }
 
-cleanup:
     mbedtls_x509_crt_free(&crt);
 
     return status;
 }
 
+/**
+ * Retrieve the issuer bytes from one X509 object.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     cert_issuer  Pointer to the retrieved certificate issuer bytes.
+ * @param[in, out] issuer_size  The size in bytes of the cert_issuer buffer on input,
+ *                             and the size of buffer returned cert_issuer on output.
+ *
+ * @retval  true   The certificate issuer retrieved successfully.
+ * @retval  false  Invalid X509 object, or the issuer_size is too small for the result.
+ *                The issuer_size will be updated with the required size.
+ *
+ **/
+bool libspdm_x509_object_get_issuer_name(const void *x509_cert,
+                                         uint8_t *cert_issuer,
+                                         uintn *issuer_size)
+{
+    const mbedtls_x509_crt *crt;
+
+    if (x509_cert == NULL || issuer_size == NULL) {
+        return false;
+    }
+
+    crt = x509_cert;
+    if (*issuer_size < crt->issuer_raw.len) {
+        *issuer_size = crt->issuer_raw.len;
+        return false;
+    }
+    if (cert_issuer != NULL) {
+        libspdm_copy_mem(cert_issuer, *issuer_size, crt->issuer_raw.p, crt->issuer_raw.len);
+    }
+    *issuer_size = crt->issuer_raw.len;
+
+    return true;
+}
+
 /**
  * Retrieve the issuer common name (CN) string from one X.509 certificate.
  *
@@ -1043,38 +1322,60 @@ return_status libspdm_x509_get_signature_algorithm(const uint8_t *cert,
                                                    uintn *oid_size)
 {
     mbedtls_x509_crt crt;
-    int32_t ret;
     return_status status;
 
     if (cert == NULL || cert_size == 0 || oid_size == NULL) {
         return RETURN_INVALID_PARAMETER;
     }
 
-    status = RETURN_INVALID_PARAMETER;
-
     mbedtls_x509_crt_init(&crt);
 
-    ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
-
-    if (ret == 0) {
-        if (*oid_size < crt.sig_oid.len) {
-            *oid_size = crt.serial.len;
-            status = RETURN_BUFFER_TOO_SMALL;
-            goto cleanup;
-        }
-        if (oid != NULL) {
-            libspdm_copy_mem(oid, *oid_size, crt.sig_oid.p, crt.sig_oid.len);
-        }
-        *oid_size = crt.sig_oid.len;
-        status = RETURN_SUCCESS;
+    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) == 0) {
+        status = libspdm_x509_object_get_signature_algorithm(&crt, oid, oid_size);
+    } else {
+        status = RETURN_INVALID_PARAMETER;
     }
 
-cleanup:
     mbedtls_x509_crt_free(&crt);
 
     return status;
 }
 
+/**
+ * Retrieve the signature algorithm from one X509 object.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     oid          signature algorithm Object identifier buffer.
+ * @param[in,out]  oid_size     signature algorithm Object identifier buffer size
+ *
+ * @retval RETURN_SUCCESS           The certificate signature algorithm retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or oid_size is NULL.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the oid_size is too small for the result.
+ *                                 The required size is returned in oid_size.
+ **/
+return_status libspdm_x509_object_get_signature_algorithm(const void *x509_cert,
+                                                          uint8_t *oid,
+                                                          uintn *oid_size)
+{
+    const mbedtls_x509_crt *crt;
+
+    if (x509_cert == NULL || oid_size == NULL) {
+        return RETURN_INVALID_PARAMETER;
+    }
+
+    crt = x509_cert;
+    if (*oid_size < crt->sig_oid.len) {
+        *oid_size = crt->sig_oid.len;
+        return RETURN_BUFFER_TOO_SMALL;
+    }
+    if (oid != NULL) {
+        libspdm_copy_mem(oid, *oid_size, crt->sig_oid.p, crt->sig_oid.len);
+    }
+    *oid_size = crt->sig_oid.len;
+
+    return RETURN_SUCCESS;
+}
+
 /**
  * Find first Extension data match with given OID
  *
@@ -1182,53 +1483,87 @@ return_status libspdm_x509_get_extension_data(const uint8_t *cert, uintn cert_si
                                               uintn *extension_data_size)
 {
     mbedtls_x509_crt crt;
-    int32_t ret;
     return_status status;
-    uint8_t *ptr;
-    uint8_t *end;
-    size_t obj_len;
 
     if (cert == NULL || cert_size == 0 || oid == NULL || oid_size == 0 ||
         extension_data_size == NULL) {
         return RETURN_INVALID_PARAMETER;
     }
 
-    status = RETURN_INVALID_PARAMETER;
-
     mbedtls_x509_crt_init(&crt);
 
-    ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
+    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) == 0) {
+        status = libspdm_x509_object_get_extension_data(&crt, oid, oid_size,
+                                                        extension_data,
+                                                        extension_data_size);
+    } else {
+        status = RETURN_INVALID_PARAMETER;
+    }
 
-    if (ret == 0) {
-        ptr = crt.v3_ext.p;
-        end = crt.v3_ext.p + crt.v3_ext.len;
-        ret = mbedtls_asn1_get_tag(&ptr, end, &obj_len,
-                                   MBEDTLS_ASN1_CONSTRUCTED |
-                                   MBEDTLS_ASN1_SEQUENCE);
+    mbedtls_x509_crt_free(&crt);
+
+    return status;
+}
+
+/**
+ * Retrieve Extension data from one X509 object.
+ *
+ * @param[in]      x509_cert           Pointer to the X509 object.
+ * @param[in]      oid                 Object identifier buffer
+ * @param[in]      oid_size            Object identifier buffer size
+ * @param[out]     extension_data      Extension bytes.
+ * @param[in, out] extension_data_size Extension bytes size.
+ *
+ * @retval RETURN_SUCCESS           The certificate Extension data retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert, oid or extension_data_size is NULL.
+ *                                 If the extensions of the X509 object are malformed.
+ * @retval RETURN_NOT_FOUND         If no Extension entry match oid.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the extension_data_size is too small for the result.
+ *                                 The required size is returned in extension_data_size.
+ **/
+return_status libspdm_x509_object_get_extension_data(const void *x509_cert,
+                                                     const uint8_t *oid, uintn oid_size,
+                                                     uint8_t *extension_data,
+                                                     uintn *extension_data_size)
+{
+    const mbedtls_x509_crt *crt;
+    int32_t ret;
+    return_status status;
+    uint8_t *ptr;
+    uint8_t *end;
+    size_t obj_len;
+
+    if (x509_cert == NULL || oid == NULL || oid_size == 0 ||
+        extension_data_size == NULL) {
+        return RETURN_INVALID_PARAMETER;
     }
 
-    if (ret == 0) {
-        status = libspdm_internal_x509_find_extension_data(
-            ptr, end, oid, oid_size, &ptr, &obj_len);
+    crt = x509_cert;
+    ptr = crt->v3_ext.p;
+    end = crt->v3_ext.p + crt->v3_ext.len;
+    ret = mbedtls_asn1_get_tag(&ptr, end, &obj_len,
+                               MBEDTLS_ASN1_CONSTRUCTED |
+                               MBEDTLS_ASN1_SEQUENCE);
+    if (ret != 0) {
+        return RETURN_INVALID_PARAMETER;
     }
 
-    if (status == RETURN_SUCCESS) {
-        if (*extension_data_size < obj_len) {
-            *extension_data_size = obj_len;
-            status = RETURN_BUFFER_TOO_SMALL;
-            goto cleanup;
-        }
-        if (oid != NULL) {
-            libspdm_copy_mem(extension_data, *extension_data_size, ptr, obj_len);
-        }
-        *extension_data_size = obj_len;
-        status = RETURN_SUCCESS;
+    status = libspdm_internal_x509_find_extension_data(
+        ptr, end, oid, oid_size, &ptr, &obj_len);
+    if (status != RETURN_SUCCESS) {
+        return status;
     }
 
-cleanup:
-    mbedtls_x509_crt_free(&crt);
+    if (*extension_data_size < obj_len) {
+        *extension_data_size = obj_len;
+        return RETURN_BUFFER_TOO_SMALL;
+    }
+    if (oid != NULL) {
+        libspdm_copy_mem(extension_data, *extension_data_size, ptr, obj_len);
+    }
+    *extension_data_size = obj_len;
 
-    return status;
+    return RETURN_SUCCESS;
 }
 
 /**
@@ -1257,49 +1592,72 @@ bool libspdm_x509_get_validity(const uint8_t *cert, uintn cert_size,
                                uintn *to_size)
 {
     mbedtls_x509_crt crt;
-    int32_t ret;
     bool status;
-    uintn t_size;
-    uintn f_size;
 
     if (cert == NULL) {
         return false;
     }
 
-    status = false;
-
     mbedtls_x509_crt_init(&crt);
 
-    ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
+    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) == 0) {
+        status = libspdm_x509_object_get_validity(&crt, from, from_size, to, to_size);
+    } else {
+        status = false;
+    }
 
-    if (ret == 0) {
-        f_size = sizeof(mbedtls_x509_time);
-        if (*from_size < f_size) {
-            *from_size = f_size;
-            goto done;
-        }
-        if (from != NULL) {
-            libspdm_copy_mem(from, *from_size, &(crt.valid_from), f_size);
-        }
+    mbedtls_x509_crt_free(&crt);
+
+    return status;
+}
+
+/**
+ * Retrieve the Validity from one X509 object.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     from         notBefore Pointer to date_time object.
+ * @param[in,out]  from_size     notBefore date_time object size.
+ * @param[out]     to           notAfter Pointer to date_time object.
+ * @param[in,out]  to_size       notAfter date_time object size.
+ *
+ * @retval  true   The certificate Validity retrieved successfully.
+ * @retval  false  Invalid X509 object, or Validity retrieve failed.
+ **/
+bool libspdm_x509_object_get_validity(const void *x509_cert,
+                                      uint8_t *from, uintn *from_size,
+                                      uint8_t *to, uintn *to_size)
+{
+    const mbedtls_x509_crt *crt;
+    uintn t_size;
+    uintn f_size;
+
+    if (x509_cert == NULL || from_size == NULL || to_size == NULL) {
+        return false;
+    }
+
+    crt = x509_cert;
+    f_size = sizeof(mbedtls_x509_time);
+    if (*from_size < f_size) {
         *from_size = f_size;
+        return false;
+    }
+    if (from != NULL) {
+        libspdm_copy_mem(from, *from_size, &(crt->valid_from), f_size);
+    }
+    *from_size = f_size;
 
-        t_size = sizeof(mbedtls_x509_time);
-        if (*to_size < t_size) {
-            *to_size = t_size;
-            goto done;
-        }
-        if (to != NULL) {
-            libspdm_copy_mem(to, *to_size, &(crt.valid_to),
-                             sizeof(mbedtls_x509_time));
-        }
+    t_size = sizeof(mbedtls_x509_time);
+    if (*to_size < t_size) {
         *to_size = t_size;
-        status = true;
+        return false;
     }
+    if (to != NULL) {
+        libspdm_copy_mem(to, *to_size, &(crt->valid_to),
+                         sizeof(mbedtls_x509_time));
+    }
+    *to_size = t_size;
 
-done:
-    mbedtls_x509_crt_free(&crt);
-
-    return status;
+    return true;
 }
 
 /**
@@ -1317,28 +1675,44 @@ bool libspdm_x509_get_key_usage(const uint8_t *cert, uintn cert_size,
                                 uintn *usage)
 {
     mbedtls_x509_crt crt;
-    int32_t ret;
     bool status;
 
     if (cert == NULL) {
         return false;
     }
 
-    status = false;
-
     mbedtls_x509_crt_init(&crt);
 
-    ret = mbedtls_x509_crt_parse_der(&crt, cert, cert_size);
-
-    if (ret == 0) {
-        *usage = crt.key_usage;
-        status = true;
+    if (mbedtls_x509_crt_parse_der(&crt, cert, cert_size) == 0) {
+        status = libspdm_x509_object_get_key_usage(&crt, usage);
+    } else {
+        status = false;
     }
+
     mbedtls_x509_crt_free(&crt);
 
     return status;
 }
 
+/**
+ * Retrieve the key usage from one X509 object.
+ *
+ * @param[in]      x509_cert        Pointer to the X509 object.
+ * @param[out]     usage            key usage (LIBSPDM_CRYPTO_X509_KU_*)
+ *
+ * @retval  true   The certificate key usage retrieved successfully.
+ * @retval  false  Invalid X509 object, or usage is NULL
+ **/
+bool libspdm_x509_object_get_key_usage(const void *x509_cert, uintn *usage)
+{
+    if (x509_cert == NULL || usage == NULL) {
+        return false;
+    }
+
+    *usage = ((const mbedtls_x509_crt *)x509_cert)->key_usage;
+    return true;
+}
+
 /**
  * Retrieve the Extended key usage from one X.509 certificate.
  *
@@ -1374,6 +1748,29 @@ return_status libspdm_x509_get_extended_key_usage(const uint8_t *cert,
     return status;
 }
 
+/**
+ * Retrieve the Extended key usage from one X509 object.
+ *
+ * @param[in]      x509_cert        Pointer to the X509 object.
+ * @param[out]     usage            key usage bytes.
+ * @param[in, out] usage_size        key usage buffer sizs in bytes.
+ *
+ * @retval RETURN_SUCCESS           The usage bytes retrieve successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or usage_size is NULL.
+ * @retval RETURN_NOT_FOUND         If no extended key usage exists.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the usage_size is too small for the result.
+ *                                 The required size is returned in usage_size.
+ **/
+return_status libspdm_x509_object_get_extended_key_usage(const void *x509_cert,
+                                                         uint8_t *usage,
+                                                         uintn *usage_size)
+{
+    return libspdm_x509_object_get_extension_data(x509_cert,
+                                                  m_libspdm_oid_ext_key_usage,
+                                                  sizeof(m_libspdm_oid_ext_key_usage),
+                                                  usage, usage_size);
+}
+
 /**
  * Retrieve the basic constraints from one X.509 certificate.
  *
@@ -1411,6 +1808,30 @@ return_status libspdm_x509_get_extended_basic_constraints(const uint8_t *cert,
     return status;
 }
 
+/**
+ * Retrieve the basic constraints from one X509 object.
+ *
+ * @param[in]      x509_cert                Pointer to the X509 object.
+ * @param[out]     basic_constraints        basic constraints bytes.
+ * @param[in, out] basic_constraints_size   basic constraints buffer sizs in bytes.
+ *
+ * @retval RETURN_SUCCESS           The basic constraints retrieve successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or basic_constraints_size is NULL.
+ * @retval RETURN_BUFFER_TOO_SMALL  The required buffer size is small.
+ *                                  The return buffer size is basic_constraints_size parameter.
+ * @retval RETURN_NOT_FOUND         If no Extension entry match oid.
+ **/
+return_status libspdm_x509_object_get_extended_basic_constraints(const void *x509_cert,
+                                                                 uint8_t *basic_constraints,
+                                                                 uintn *basic_constraints_size)
+{
+    return libspdm_x509_object_get_extension_data(x509_cert,
+                                                  m_libspdm_oid_basic_constraints,
+                                                  sizeof(m_libspdm_oid_basic_constraints),
+                                                  basic_constraints,
+                                                  basic_constraints_size);
+}
+
 /**
  * Return 0 if before <= after, 1 otherwise
  **/
@@ -74,3 +74,16 @@ void my_free(void *ptr)
         free_pool(pool_hdr);
     }
 }
+
+/**
+ * Routes the memory allocations of the crypto backend through allocate_pool() and free_pool().
+ *
+ * mbedtls is built with my_calloc() and my_free() as its platform memory functions, so its
+ * allocations always go through the pool allocation functions.
+ *
+ * @retval true   The crypto backend allocates memory with allocate_pool() and free_pool().
+ **/
+bool libspdm_crypt_use_pool_allocator(void)
+{
+    return true;
+}
@@ -0,0 +1,84 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Fixed-size hash state Wrapper Implementation.
+ **/
+
+#include "internal_crypt_lib.h"
+
+/**
+ * Initializes a hash state for subsequent use.
+ *
+ * @param[in]   hash_nid   hash NID.
+ * @param[out]  state      Pointer to the hash state being initialized.
+ *
+ * @retval true   Hash state initialization succeeded.
+ * @retval false  Hash state initialization failed.
+ * @retval false  The hash algorithm is not supported.
+ **/
+bool libspdm_hash_state_init_by_nid(uintn hash_nid, libspdm_hash_state_t *state)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Makes a copy of an existing hash state.
+ *
+ * @param[in]   state      Pointer to the hash state being copied.
+ * @param[out]  new_state  Pointer to the new hash state.
+ *
+ * @retval true   Hash state copy succeeded.
+ * @retval false  Hash state copy failed.
+ **/
+bool libspdm_hash_state_duplicate(const libspdm_hash_state_t *state,
+                                  libspdm_hash_state_t *new_state)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Digests the input data and updates the hash state.
+ *
+ * @param[in, out]  state      Pointer to the hash state.
+ * @param[in]       data       Pointer to the buffer containing the data to be hashed.
+ * @param[in]       data_size  size of data buffer in bytes.
+ *
+ * @retval true   Hash data digest succeeded.
+ * @retval false  Hash data digest failed.
+ **/
+bool libspdm_hash_state_update(libspdm_hash_state_t *state, const void *data,
+                               uintn data_size)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Completes computation of the hash digest value and releases the hash state.
+ *
+ * @param[in, out]  state       Pointer to the hash state.
+ * @param[out]      hash_value  Pointer to a buffer that receives the hash digest value.
+ *
+ * @retval true   Hash digest computation succeeded.
+ * @retval false  Hash digest computation failed.
+ **/
+bool libspdm_hash_state_final(libspdm_hash_state_t *state, uint8_t *hash_value)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Releases a hash state. The state is zeroed.
+ *
+ * @param[in, out]  state  Pointer to the hash state.
+ **/
+void libspdm_hash_state_free(libspdm_hash_state_t *state)
+{
+}
@@ -331,6 +331,41 @@ bool libspdm_x509_verify_cert_chain(uint8_t *root_cert, uintn root_cert_length,
     return false;
 }
 
+/**
+ * Set the maximum number of entries of the process-wide issuer signature verification cache
+ * used by libspdm_x509_verify_cert_chain().
+ *
+ * @param[in]  max_entry_count   Maximum number of cached certificate pairs.
+ *
+ * @retval  false  This interface is not supported.
+ **/
+bool libspdm_x509_verify_cache_set_max_entry_count(uintn max_entry_count)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Remove all entries of the issuer signature verification cache and reset its statistics.
+ **/
+void libspdm_x509_verify_cache_flush(void)
+{
+    LIBSPDM_ASSERT(false);
+}
+
+/**
+ * Get the statistics of the issuer signature verification cache.
+ *
+ * @param[out]  hit_count     Number of certificate pairs whose signature check was skipped.
+ * @param[out]  miss_count    Number of certificate pairs that were verified.
+ * @param[out]  entry_count   Number of cached certificate pairs.
+ **/
+void libspdm_x509_verify_cache_get_statistics(uint64_t *hit_count, uint64_t *miss_count,
+                                              uintn *entry_count)
+{
+    LIBSPDM_ASSERT(false);
+}
+
 /**
  * Get one X509 certificate from cert_chain.
  *
@@ -686,6 +721,330 @@ return_status libspdm_x509_get_extended_basic_constraints(const uint8_t *cert,
     return RETURN_UNSUPPORTED;
 }
 
+/**
+ * Retrieve the version from one X509 object.
+ *
+ * If this interface is not supported, then return RETURN_UNSUPPORTED.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     version      Pointer to the retrieved version integer.
+ *
+ * @retval RETURN_SUCCESS           The certificate version retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or version is NULL.
+ * @retval RETURN_UNSUPPORTED       The operation is not supported.
+ **/
+return_status libspdm_x509_object_get_version(const void *x509_cert, uintn *version)
+{
+    LIBSPDM_ASSERT(false);
+    return RETURN_UNSUPPORTED;
+}
+
+/**
+ * Retrieve the serialNumber from one X509 object.
+ *
+ * If this interface is not supported, then return RETURN_UNSUPPORTED.
+ *
+ * @param[in]      x509_cert          Pointer to the X509 object.
+ * @param[out]     serial_number      Pointer to the retrieved certificate serial_number bytes.
+ * @param[in, out] serial_number_size The size in bytes of the serial_number buffer on input,
+ *                                   and the size of buffer returned serial_number on output.
+ *
+ * @retval RETURN_SUCCESS           The certificate serialNumber retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or serial_number_size is NULL.
+ * @retval RETURN_NOT_FOUND         If no serial_number exists.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the serial_number_size is too small for the result.
+ *                                 The required size is returned in serial_number_size.
+ * @retval RETURN_UNSUPPORTED       The operation is not supported.
+ **/
+return_status libspdm_x509_object_get_serial_number(const void *x509_cert,
+                                                    uint8_t *serial_number,
+                                                    uintn *serial_number_size)
+{
+    LIBSPDM_ASSERT(false);
+    return RETURN_UNSUPPORTED;
+}
+
+/**
+ * Retrieve the subject bytes from one X509 object.
+ *
+ * If this interface is not supported, then return false.
+ *
+ * @param[in]      x509_cert     Pointer to the X509 object.
+ * @param[out]     cert_subject  Pointer to the retrieved certificate subject bytes.
+ * @param[in, out] subject_size  The size in bytes of the cert_subject buffer on input,
+ *                             and the size of buffer returned cert_subject on output.
+ *
+ * @retval  true   The certificate subject retrieved successfully.
+ * @retval  false  Invalid X509 object, or the subject_size is too small for the result.
+ *                The subject_size will be updated with the required size.
+ * @retval  false  This interface is not supported.
+ **/
+bool libspdm_x509_object_get_subject_name(const void *x509_cert,
+                                          uint8_t *cert_subject,
+                                          uintn *subject_size)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Retrieve the issuer bytes from one X509 object.
+ *
+ * If this interface is not supported, then return false.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     cert_issuer  Pointer to the retrieved certificate issuer bytes.
+ * @param[in, out] issuer_size  The size in bytes of the cert_issuer buffer on input,
+ *                             and the size of buffer returned cert_issuer on output.
+ *
+ * @retval  true   The certificate issuer retrieved successfully.
+ * @retval  false  Invalid X509 object, or the issuer_size is too small for the result.
+ *                The issuer_size will be updated with the required size.
+ * @retval  false  This interface is not supported.
+ **/
+bool libspdm_x509_object_get_issuer_name(const void *x509_cert,
+                                         uint8_t *cert_issuer,
+                                         uintn *issuer_size)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Retrieve the signature algorithm from one X509 object.
+ *
+ * If this interface is not supported, then return RETURN_UNSUPPORTED.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     oid          signature algorithm Object identifier buffer.
+ * @param[in,out]  oid_size     signature algorithm Object identifier buffer size
+ *
+ * @retval RETURN_SUCCESS           The certificate signature algorithm retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or oid_size is NULL.
+ * @retval RETURN_NOT_FOUND         If no signature algorithm exists.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the oid_size is too small for the result.
+ *                                 The required size is returned in oid_size.
+ * @retval RETURN_UNSUPPORTED       The operation is not supported.
+ **/
+return_status libspdm_x509_object_get_signature_algorithm(const void *x509_cert,
+                                                          uint8_t *oid,
+                                                          uintn *oid_size)
+{
+    LIBSPDM_ASSERT(false);
+    return RETURN_UNSUPPORTED;
+}
+
+/**
+ * Retrieve the Validity from one X509 object.
+ *
+ * If this interface is not supported, then return false.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     from         notBefore Pointer to date_time object.
+ * @param[in,out]  from_size     notBefore date_time object size.
+ * @param[out]     to           notAfter Pointer to date_time object.
+ * @param[in,out]  to_size       notAfter date_time object size.
+ *
+ * Note: libspdm_x509_compare_date_time to compare date_time oject
+ *      x509SetDateTime to get a date_time object from a date_time_str
+ *
+ * @retval  true   The certificate Validity retrieved successfully.
+ * @retval  false  Invalid X509 object, or Validity retrieve failed.
+ * @retval  false  This interface is not supported.
+ **/
+bool libspdm_x509_object_get_validity(const void *x509_cert,
+                                      uint8_t *from, uintn *from_size,
+                                      uint8_t *to, uintn *to_size)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Retrieve the key usage from one X509 object.
+ *
+ * If this interface is not supported, then return false.
+ *
+ * @param[in]      x509_cert        Pointer to the X509 object.
+ * @param[out]     usage            key usage (LIBSPDM_CRYPTO_X509_KU_*)
+ *
+ * @retval  true   The certificate key usage retrieved successfully.
+ * @retval  false  Invalid X509 object, or usage is NULL
+ * @retval  false  This interface is not supported.
+ **/
+bool libspdm_x509_object_get_key_usage(const void *x509_cert, uintn *usage)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Retrieve Extension data from one X509 object.
+ *
+ * If this interface is not supported, then return RETURN_UNSUPPORTED.
+ *
+ * @param[in]      x509_cert           Pointer to the X509 object.
+ * @param[in]      oid                 Object identifier buffer
+ * @param[in]      oid_size            Object identifier buffer size
+ * @param[out]     extension_data      Extension bytes.
+ * @param[in, out] extension_data_size Extension bytes size.
+ *
+ * @retval RETURN_SUCCESS           The certificate Extension data retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert, oid or extension_data_size is NULL.
+ * @retval RETURN_NOT_FOUND         If no Extension entry match oid.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the extension_data_size is too small for the result.
+ *                                 The required size is returned in extension_data_size.
+ * @retval RETURN_UNSUPPORTED       The operation is not supported.
+ **/
+return_status libspdm_x509_object_get_extension_data(const void *x509_cert,
+                                                     const uint8_t *oid, uintn oid_size,
+                                                     uint8_t *extension_data,
+                                                     uintn *extension_data_size)
+{
+    LIBSPDM_ASSERT(false);
+    return RETURN_UNSUPPORTED;
+}
+
+/**
+ * Retrieve the Extended key usage from one X509 object.
+ *
+ * If this interface is not supported, then return RETURN_UNSUPPORTED.
+ *
+ * @param[in]      x509_cert        Pointer to the X509 object.
+ * @param[out]     usage            key usage bytes.
+ * @param[in, out] usage_size        key usage buffer sizs in bytes.
+ *
+ * @retval RETURN_SUCCESS           The usage bytes retrieve successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or usage_size is NULL.
+ * @retval RETURN_NOT_FOUND         If no extended key usage exists.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the usage_size is too small for the result.
+ *                                 The required size is returned in usage_size.
+ * @retval RETURN_UNSUPPORTED       The operation is not supported.
+ **/
+return_status libspdm_x509_object_get_extended_key_usage(const void *x509_cert,
+                                                         uint8_t *usage,
+                                                         uintn *usage_size)
+{
+    LIBSPDM_ASSERT(false);
+    return RETURN_UNSUPPORTED;
+}
+
+/**
+ * Retrieve the basic constraints from one X509 object.
+ *
+ * If this interface is not supported, then return RETURN_UNSUPPORTED.
+ *
+ * @param[in]      x509_cert                Pointer to the X509 object.
+ * @param[out]     basic_constraints        basic constraints bytes.
+ * @param[in, out] basic_constraints_size   basic constraints buffer sizs in bytes.
+ *
+ * @retval RETURN_SUCCESS           The basic constraints retrieve successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or basic_constraints_size is NULL.
+ * @retval RETURN_BUFFER_TOO_SMALL  The required buffer size is small.
+ *                                  The return buffer size is basic_constraints_size parameter.
+ * @retval RETURN_NOT_FOUND         If no Extension entry match oid.
+ * @retval RETURN_UNSUPPORTED       The operation is not supported.
+ **/
+return_status libspdm_x509_object_get_extended_basic_constraints(const void *x509_cert,
+                                                                 uint8_t *basic_constraints,
+                                                                 uintn *basic_constraints_size)
+{
+    LIBSPDM_ASSERT(false);
+    return RETURN_UNSUPPORTED;
+}
+
+/**
+ * Retrieve the RSA public key from one X509 object.
+ *
+ * If x509_cert is NULL, then return false.
+ * If rsa_context is NULL, then return false.
+ * If this interface is not supported, then return false.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] rsa_context   Pointer to new-generated RSA context which contain the retrieved
+ *                         RSA public key component. Use libspdm_rsa_free() function to free the
+ *                         resource.
+ *
+ * @retval  true   RSA public key was retrieved successfully.
+ * @retval  false  Fail to retrieve RSA public key from X509 object.
+ * @retval  false  This interface is not supported.
+ **/
+bool libspdm_rsa_get_public_key_from_x509_object(const void *x509_cert,
+                                                 void **rsa_context)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Retrieve the EC public key from one X509 object.
+ *
+ * If x509_cert is NULL, then return false.
+ * If ec_context is NULL, then return false.
+ * If this interface is not supported, then return false.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] ec_context    Pointer to new-generated EC DSA context which contain the retrieved
+ *                         EC public key component. Use libspdm_ec_free() function to free the
+ *                         resource.
+ *
+ * @retval  true   EC public key was retrieved successfully.
+ * @retval  false  Fail to retrieve EC public key from X509 object.
+ * @retval  false  This interface is not supported.
+ **/
+bool libspdm_ec_get_public_key_from_x509_object(const void *x509_cert,
+                                                void **ec_context)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Retrieve the Ed public key from one X509 object.
+ *
+ * If x509_cert is NULL, then return false.
+ * If ecd_context is NULL, then return false.
+ * If this interface is not supported, then return false.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] ecd_context   Pointer to new-generated Ed DSA context which contain the retrieved
+ *                         Ed public key component. Use libspdm_ecd_free() function to free the
+ *                         resource.
+ *
+ * @retval  true   Ed public key was retrieved successfully.
+ * @retval  false  Fail to retrieve Ed public key from X509 object.
+ * @retval  false  This interface is not supported.
+ **/
+bool libspdm_ecd_get_public_key_from_x509_object(const void *x509_cert,
+                                                 void **ecd_context)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
+/**
+ * Retrieve the sm2 public key from one X509 object.
+ *
+ * If x509_cert is NULL, then return false.
+ * If sm2_context is NULL, then return false.
+ * If this interface is not supported, then return false.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] sm2_context   Pointer to new-generated sm2 context which contain the retrieved
+ *                         sm2 public key component. Use libspdm_sm2_dsa_free() function to free the
+ *                         resource.
+ *
+ * @retval  true   sm2 public key was retrieved successfully.
+ * @retval  false  Fail to retrieve sm2 public key from X509 object.
+ * @retval  false  This interface is not supported.
+ **/
+bool libspdm_sm2_get_public_key_from_x509_object(const void *x509_cert,
+                                                 void **sm2_context)
+{
+    LIBSPDM_ASSERT(false);
+    return false;
+}
+
 /**
  * format a date_time object into DataTime buffer
  *
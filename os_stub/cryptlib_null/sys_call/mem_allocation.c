@@ -0,0 +1,22 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Base Memory Allocation Routines Wrapper.
+ **/
+
+#include "internal_crypt_lib.h"
+
+/**
+ * Routes the memory allocations of the crypto backend through allocate_pool() and free_pool().
+ *
+ * @retval true   The crypto backend allocates memory with allocate_pool() and free_pool().
+ **/
+bool libspdm_crypt_use_pool_allocator(void)
+{
+    /* TBD*/
+    return true;
+}
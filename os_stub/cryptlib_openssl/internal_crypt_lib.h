@@ -16,6 +16,7 @@
 #include "library/malloclib.h"
 #include "library/debuglib.h"
 #include "library/cryptlib.h"
+#include "internal_crypt_common.h"
 
 #include "crt_support.h"
 
@@ -26,4 +27,8 @@
 #define OBJ_length(o) ((o)->length)
 #endif
 
+/* One-time global setup, see sys_call/openssl_init.c and rand/rand.c*/
+bool libspdm_openssl_init(void);
+bool libspdm_random_init(void);
+
 #endif
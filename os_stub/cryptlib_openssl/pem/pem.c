@@ -92,13 +92,7 @@ bool libspdm_rsa_get_private_key_from_pem(const uint8_t *pem_data,
     /* Add possible block-cipher descriptor for PEM data decryption.
      * NOTE: Only support most popular ciphers AES for the encrypted PEM.*/
 
-    if (EVP_add_cipher(EVP_aes_128_cbc()) == 0) {
-        return false;
-    }
-    if (EVP_add_cipher(EVP_aes_192_cbc()) == 0) {
-        return false;
-    }
-    if (EVP_add_cipher(EVP_aes_256_cbc()) == 0) {
+    if (!libspdm_openssl_init()) {
         return false;
     }
 
@@ -171,13 +165,7 @@ bool libspdm_ec_get_private_key_from_pem(const uint8_t *pem_data, uintn pem_size
     /* Add possible block-cipher descriptor for PEM data decryption.
      * NOTE: Only support most popular ciphers AES for the encrypted PEM.*/
 
-    if (EVP_add_cipher(EVP_aes_128_cbc()) == 0) {
-        return false;
-    }
-    if (EVP_add_cipher(EVP_aes_192_cbc()) == 0) {
-        return false;
-    }
-    if (EVP_add_cipher(EVP_aes_256_cbc()) == 0) {
+    if (!libspdm_openssl_init()) {
         return false;
     }
 
@@ -253,13 +241,7 @@ bool libspdm_ecd_get_private_key_from_pem(const uint8_t *pem_data,
     /* Add possible block-cipher descriptor for PEM data decryption.
      * NOTE: Only support most popular ciphers AES for the encrypted PEM.*/
 
-    if (EVP_add_cipher(EVP_aes_128_cbc()) == 0) {
-        return false;
-    }
-    if (EVP_add_cipher(EVP_aes_192_cbc()) == 0) {
-        return false;
-    }
-    if (EVP_add_cipher(EVP_aes_256_cbc()) == 0) {
+    if (!libspdm_openssl_init()) {
         return false;
     }
 
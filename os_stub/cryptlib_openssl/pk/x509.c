@@ -290,9 +290,6 @@ bool libspdm_x509_get_subject_name(const uint8_t *cert, uintn cert_size,
 {
     bool res;
     X509 *x509_cert;
-    X509_NAME *x509_name;
-    uintn x509_name_size;
-
 
     /* Check input parameters.*/
 
@@ -307,40 +304,63 @@ bool libspdm_x509_get_subject_name(const uint8_t *cert, uintn cert_size,
 
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
-        res = false;
-        goto done;
+        return false;
     }
 
-    res = false;
+    res = libspdm_x509_object_get_subject_name(x509_cert, cert_subject, subject_size);
+
+    X509_free(x509_cert);
+
+    return res;
+}
+
+/**
+ * Retrieve the subject bytes from one X509 object.
+ *
+ * @param[in]      x509_cert     Pointer to the X509 object.
+ * @param[out]     cert_subject  Pointer to the retrieved certificate subject bytes.
+ * @param[in, out] subject_size  The size in bytes of the cert_subject buffer on input,
+ *                             and the size of buffer returned cert_subject on output.
+ *
+ * @retval  true   The certificate subject retrieved successfully.
+ * @retval  false  Invalid X509 object, or the subject_size is too small for the result.
+ *                The subject_size will be updated with the required size.
+ *
+ **/
+bool libspdm_x509_object_get_subject_name(const void *x509_cert,
+                                          uint8_t *cert_subject,
+                                          uintn *subject_size)
+{
+    X509_NAME *x509_name;
+    uintn x509_name_size;
+
+
+    /* Check input parameters.*/
+
+    if (x509_cert == NULL || subject_size == NULL) {
+        return false;
+    }
 
 
     /* Retrieve subject name from certificate object.*/
 
-    x509_name = X509_get_subject_name(x509_cert);
+    x509_name = X509_get_subject_name((const X509 *)x509_cert);
     if (x509_name == NULL) {
-        goto done;
+        return false;
     }
 
     x509_name_size = i2d_X509_NAME(x509_name, NULL);
     if (*subject_size < x509_name_size) {
         *subject_size = x509_name_size;
-        goto done;
+        return false;
     }
     *subject_size = x509_name_size;
-    if (cert_subject != NULL) {
-        i2d_X509_NAME(x509_name, &cert_subject);
-        res = true;
-    }
-
-done:
-
-    /* Release Resources.*/
-
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
+    if (cert_subject == NULL) {
+        return false;
     }
+    i2d_X509_NAME(x509_name, &cert_subject);
 
-    return res;
+    return true;
 }
 
 /**
@@ -709,25 +729,40 @@ return_status libspdm_x509_get_version(const uint8_t *cert, uintn cert_size,
     X509 *x509_cert;
 
     x509_cert = NULL;
-    status = RETURN_SUCCESS;
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
 
         /* Invalid X.509 Certificate*/
 
-        status = RETURN_INVALID_PARAMETER;
+        return RETURN_INVALID_PARAMETER;
     }
 
-    if (!RETURN_ERROR(status)) {
-        *version = X509_get_version(x509_cert);
-    }
+    status = libspdm_x509_object_get_version(x509_cert, version);
 
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
-    }
+    X509_free(x509_cert);
     return status;
 }
 
+/**
+ * Retrieve the version from one X509 object.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     version      Pointer to the retrieved version integer.
+ *
+ * @retval RETURN_SUCCESS           The certificate version retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or version is NULL.
+ *
+ **/
+return_status libspdm_x509_object_get_version(const void *x509_cert, uintn *version)
+{
+    if (x509_cert == NULL || version == NULL) {
+        return RETURN_INVALID_PARAMETER;
+    }
+
+    *version = X509_get_version((const X509 *)x509_cert);
+    return RETURN_SUCCESS;
+}
+
 /**
  * Retrieve the serialNumber from one X.509 certificate.
  *
@@ -757,16 +792,13 @@ return_status libspdm_x509_get_serial_number(const uint8_t *cert, uintn cert_siz
 {
     bool res;
     X509 *x509_cert;
-    ASN1_INTEGER *asn1_integer;
     return_status status;
 
-    status = RETURN_INVALID_PARAMETER;
-
 
     /* Check input parameters.*/
 
     if (cert == NULL || serial_number_size == NULL) {
-        return status;
+        return RETURN_INVALID_PARAMETER;
     }
 
     x509_cert = NULL;
@@ -776,40 +808,66 @@ return_status libspdm_x509_get_serial_number(const uint8_t *cert, uintn cert_siz
 
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
-        goto done;
+        return RETURN_INVALID_PARAMETER;
     }
 
+    status = libspdm_x509_object_get_serial_number(x509_cert, serial_number,
+                                                   serial_number_size);
+
+    X509_free(x509_cert);
+
+    return status;
+}
+
+/**
+ * Retrieve the serialNumber from one X509 object.
+ *
+ * @param[in]      x509_cert     Pointer to the X509 object.
+ * @param[out]     serial_number  Pointer to the retrieved certificate serial_number bytes.
+ * @param[in, out] serial_number_size  The size in bytes of the serial_number buffer on input,
+ *                             and the size of buffer returned serial_number on output.
+ *
+ * @retval RETURN_SUCCESS           The certificate serialNumber retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or serial_number_size is NULL.
+ * @retval RETURN_NOT_FOUND         If no serial_number exists.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the serial_number_size is too small for the result.
+ *                                 The required size is returned in serial_number_size.
+ **/
+return_status libspdm_x509_object_get_serial_number(const void *x509_cert,
+                                                    uint8_t *serial_number,
+                                                    uintn *serial_number_size)
+{
+    const ASN1_INTEGER *asn1_integer;
+
+
+    /* Check input parameters.*/
+
+    if (x509_cert == NULL || serial_number_size == NULL) {
+        return RETURN_INVALID_PARAMETER;
+    }
 
-    /* Retrieve subject name from certificate object.*/
 
-    asn1_integer = X509_get_serialNumber(x509_cert);
+    /* Retrieve serial number from certificate object.*/
+
+    asn1_integer = X509_get0_serialNumber((const X509 *)x509_cert);
     if (asn1_integer == NULL) {
-        status = RETURN_NOT_FOUND;
-        goto done;
+        return RETURN_NOT_FOUND;
     }
 
     if (*serial_number_size < (uintn)asn1_integer->length) {
         *serial_number_size = (uintn)asn1_integer->length;
-        status = RETURN_BUFFER_TOO_SMALL;
-        goto done;
+        return RETURN_BUFFER_TOO_SMALL;
     }
 
-    if (serial_number != NULL) {
-        libspdm_copy_mem(serial_number, *serial_number_size,
-                         asn1_integer->data, (uintn)asn1_integer->length);
-        status = RETURN_SUCCESS;
+    if (serial_number == NULL) {
+        *serial_number_size = (uintn)asn1_integer->length;
+        return RETURN_INVALID_PARAMETER;
     }
+    libspdm_copy_mem(serial_number, *serial_number_size,
+                     asn1_integer->data, (uintn)asn1_integer->length);
     *serial_number_size = (uintn)asn1_integer->length;
 
-done:
-
-    /* Release Resources.*/
-
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
-    }
-
-    return status;
+    return RETURN_SUCCESS;
 }
 
 /**
@@ -837,9 +895,6 @@ bool libspdm_x509_get_issuer_name(const uint8_t *cert, uintn cert_size,
 {
     bool res;
     X509 *x509_cert;
-    X509_NAME *x509_name;
-    uintn x509_name_size;
-
 
     /* Check input parameters.*/
 
@@ -854,40 +909,63 @@ bool libspdm_x509_get_issuer_name(const uint8_t *cert, uintn cert_size,
 
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
-        res = false;
-        goto done;
+        return false;
     }
 
-    res = false;
+    res = libspdm_x509_object_get_issuer_name(x509_cert, cert_issuer, issuer_size);
+
+    X509_free(x509_cert);
+
+    return res;
+}
+
+/**
+ * Retrieve the issuer bytes from one X509 object.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     cert_issuer  Pointer to the retrieved certificate issuer bytes.
+ * @param[in, out] issuer_size  The size in bytes of the cert_issuer buffer on input,
+ *                             and the size of buffer returned cert_issuer on output.
+ *
+ * @retval  true   The certificate issuer retrieved successfully.
+ * @retval  false  Invalid X509 object, or the issuer_size is too small for the result.
+ *                The issuer_size will be updated with the required size.
+ *
+ **/
+bool libspdm_x509_object_get_issuer_name(const void *x509_cert,
+                                         uint8_t *cert_issuer,
+                                         uintn *issuer_size)
+{
+    X509_NAME *x509_name;
+    uintn x509_name_size;
+
+
+    /* Check input parameters.*/
+
+    if (x509_cert == NULL || issuer_size == NULL) {
+        return false;
+    }
 
 
     /* Retrieve issuer name from certificate object.*/
 
-    x509_name = X509_get_issuer_name(x509_cert);
+    x509_name = X509_get_issuer_name((const X509 *)x509_cert);
     if (x509_name == NULL) {
-        goto done;
+        return false;
     }
 
     x509_name_size = i2d_X509_NAME(x509_name, NULL);
     if (*issuer_size < x509_name_size) {
         *issuer_size = x509_name_size;
-        goto done;
+        return false;
     }
     *issuer_size = x509_name_size;
-    if (cert_issuer != NULL) {
-        i2d_X509_NAME(x509_name, &cert_issuer);
-        res = true;
-    }
-
-done:
-
-    /* Release Resources.*/
-
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
+    if (cert_issuer == NULL) {
+        return false;
     }
+    i2d_X509_NAME(x509_name, &cert_issuer);
 
-    return res;
+    return true;
 }
 
 /**
@@ -986,9 +1064,6 @@ return_status libspdm_x509_get_signature_algorithm(const uint8_t *cert,
     bool res;
     return_status status;
     X509 *x509_cert;
-    int nid;
-    ASN1_OBJECT *asn1_obj;
-    uintn obj_length;
 
 
     /* Check input parameters.*/
@@ -998,52 +1073,73 @@ return_status libspdm_x509_get_signature_algorithm(const uint8_t *cert,
     }
 
     x509_cert = NULL;
-    status = RETURN_INVALID_PARAMETER;
 
 
     /* Read DER-encoded X509 Certificate and Construct X509 object.*/
 
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
-        status = RETURN_INVALID_PARAMETER;
-        goto done;
+        return RETURN_INVALID_PARAMETER;
     }
 
+    status = libspdm_x509_object_get_signature_algorithm(x509_cert, oid, oid_size);
 
-    /* Retrieve subject name from certificate object.*/
+    X509_free(x509_cert);
+
+    return status;
+}
+
+/**
+ * Retrieve the signature algorithm from one X509 object.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     oid          signature algorithm Object identifier buffer.
+ * @param[in,out]  oid_size     signature algorithm Object identifier buffer size
+ *
+ * @retval RETURN_SUCCESS           The certificate signature algorithm retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or oid_size is NULL.
+ * @retval RETURN_NOT_FOUND         If no signature algorithm exists.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the oid_size is too small for the result.
+ *                                 The required size is returned in oid_size.
+ **/
+return_status libspdm_x509_object_get_signature_algorithm(const void *x509_cert,
+                                                          uint8_t *oid,
+                                                          uintn *oid_size)
+{
+    int nid;
+    ASN1_OBJECT *asn1_obj;
+    uintn obj_length;
+
+
+    /* Check input parameters.*/
+
+    if (x509_cert == NULL || oid_size == NULL) {
+        return RETURN_INVALID_PARAMETER;
+    }
+
+
+    /* Retrieve signature algorithm from certificate object.*/
 
-    nid = X509_get_signature_nid(x509_cert);
+    nid = X509_get_signature_nid((const X509 *)x509_cert);
     if (nid == NID_undef) {
-        status = RETURN_NOT_FOUND;
-        goto done;
+        return RETURN_NOT_FOUND;
     }
     asn1_obj = OBJ_nid2obj(nid);
     if (asn1_obj == NULL) {
-        status = RETURN_NOT_FOUND;
-        goto done;
+        return RETURN_NOT_FOUND;
     }
 
     obj_length = OBJ_length(asn1_obj);
     if (*oid_size < obj_length) {
         *oid_size = obj_length;
-        status = RETURN_BUFFER_TOO_SMALL;
-        goto done;
+        return RETURN_BUFFER_TOO_SMALL;
     }
     if (oid != NULL) {
         libspdm_copy_mem(oid, *oid_size, OBJ_get0_data(asn1_obj), obj_length);
     }
     *oid_size = obj_length;
-    status = RETURN_SUCCESS;
-
-done:
-
-    /* Release Resources.*/
-
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
-    }
 
-    return status;
+    return RETURN_SUCCESS;
 }
 
 /**
@@ -1073,10 +1169,6 @@ bool libspdm_x509_get_validity(const uint8_t *cert, uintn cert_size,
 {
     bool res;
     X509 *x509_cert;
-    const ASN1_TIME *f_time;
-    const ASN1_TIME *t_time;
-    uintn t_size;
-    uintn f_size;
 
 
     /* Check input parameters.*/
@@ -1087,30 +1179,64 @@ bool libspdm_x509_get_validity(const uint8_t *cert, uintn cert_size,
     }
 
     x509_cert = NULL;
-    res = false;
 
 
     /* Read DER-encoded X509 Certificate and Construct X509 object.*/
 
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
-        goto done;
+        return false;
+    }
+
+    res = libspdm_x509_object_get_validity(x509_cert, from, from_size, to, to_size);
+
+    X509_free(x509_cert);
+
+    return res;
+}
+
+/**
+ * Retrieve the Validity from one X509 object.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ * @param[out]     from         notBefore Pointer to date_time object.
+ * @param[in,out]  from_size     notBefore date_time object size.
+ * @param[out]     to           notAfter Pointer to date_time object.
+ * @param[in,out]  to_size       notAfter date_time object size.
+ *
+ * @retval  true   The certificate Validity retrieved successfully.
+ * @retval  false  Invalid X509 object, or Validity retrieve failed.
+ **/
+bool libspdm_x509_object_get_validity(const void *x509_cert,
+                                      uint8_t *from, uintn *from_size,
+                                      uint8_t *to, uintn *to_size)
+{
+    const ASN1_TIME *f_time;
+    const ASN1_TIME *t_time;
+    uintn t_size;
+    uintn f_size;
+
+
+    /* Check input parameters.*/
+
+    if (x509_cert == NULL || from_size == NULL || to_size == NULL) {
+        return false;
     }
 
 
     /* Retrieve Validity from/to from certificate object.*/
 
-    f_time = X509_get0_notBefore(x509_cert);
-    t_time = X509_get0_notAfter(x509_cert);
+    f_time = X509_get0_notBefore((const X509 *)x509_cert);
+    t_time = X509_get0_notAfter((const X509 *)x509_cert);
 
     if (f_time == NULL || t_time == NULL) {
-        goto done;
+        return false;
     }
 
     f_size = sizeof(ASN1_TIME) + f_time->length;
     if (*from_size < f_size) {
         *from_size = f_size;
-        goto done;
+        return false;
     }
     if (from != NULL) {
         libspdm_copy_mem(from, *from_size, f_time, sizeof(ASN1_TIME));
@@ -1124,7 +1250,7 @@ bool libspdm_x509_get_validity(const uint8_t *cert, uintn cert_size,
     t_size = sizeof(ASN1_TIME) + t_time->length;
     if (*to_size < t_size) {
         *to_size = t_size;
-        goto done;
+        return false;
     }
     if (to != NULL) {
         libspdm_copy_mem(to, *to_size, t_time, sizeof(ASN1_TIME));
@@ -1135,17 +1261,7 @@ bool libspdm_x509_get_validity(const uint8_t *cert, uintn cert_size,
     }
     *to_size = t_size;
 
-    res = true;
-
-done:
-
-    /* Release Resources.*/
-
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
-    }
-
-    return res;
+    return true;
 }
 
 /**
@@ -1264,34 +1380,50 @@ bool libspdm_x509_get_key_usage(const uint8_t *cert, uintn cert_size,
     }
 
     x509_cert = NULL;
-    res = false;
 
 
     /* Read DER-encoded X509 Certificate and Construct X509 object.*/
 
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
-        goto done;
+        return false;
     }
 
+    res = libspdm_x509_object_get_key_usage(x509_cert, usage);
 
-    /* Retrieve subject name from certificate object.*/
+    X509_free(x509_cert);
 
-    *usage = X509_get_key_usage(x509_cert);
-    if (*usage == NID_undef) {
-        goto done;
+    return res;
+}
+
+/**
+ * Retrieve the key usage from one X509 object.
+ *
+ * @param[in]      x509_cert        Pointer to the X509 object.
+ * @param[out]     usage            key usage (LIBSPDM_CRYPTO_X509_KU_*)
+ *
+ * @retval  true   The certificate key usage retrieved successfully.
+ * @retval  false  Invalid X509 object, or usage is NULL
+ **/
+bool libspdm_x509_object_get_key_usage(const void *x509_cert, uintn *usage)
+{
+
+    /* Check input parameters.*/
+
+    if (x509_cert == NULL || usage == NULL) {
+        return false;
     }
-    res = true;
 
-done:
 
-    /* Release Resources.*/
+    /* Retrieve key usage from certificate object.
+     * X509_get_key_usage() caches the decoded extensions in the object.*/
 
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
+    *usage = X509_get_key_usage((X509 *)x509_cert);
+    if (*usage == NID_undef) {
+        return false;
     }
 
-    return res;
+    return true;
 }
 
 /**
@@ -1320,44 +1452,81 @@ return_status libspdm_x509_get_extension_data(const uint8_t *cert, uintn cert_si
                                               uintn *extension_data_size)
 {
     return_status status;
-    intn i;
     bool res;
     X509 *x509_cert;
-    const STACK_OF(X509_EXTENSION) * extensions;
-    ASN1_OBJECT *asn1_obj;
-    ASN1_OCTET_STRING *asn1_oct;
-    X509_EXTENSION *ext;
-    uintn obj_length;
-    uintn oct_length;
-
-    status = RETURN_INVALID_PARAMETER;
 
 
     /* Check input parameters.*/
 
     if (cert == NULL || cert_size == 0 || oid == NULL || oid_size == 0 ||
         extension_data_size == NULL) {
-        return status;
+        return RETURN_INVALID_PARAMETER;
     }
 
     x509_cert = NULL;
-    res = false;
 
 
     /* Read DER-encoded X509 Certificate and Construct X509 object.*/
 
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
-        goto cleanup;
+        return RETURN_INVALID_PARAMETER;
+    }
+
+    status = libspdm_x509_object_get_extension_data(x509_cert, oid, oid_size,
+                                                    extension_data, extension_data_size);
+
+    X509_free(x509_cert);
+
+    return status;
+}
+
+/**
+ * Retrieve Extension data from one X509 object.
+ *
+ * @param[in]      x509_cert           Pointer to the X509 object.
+ * @param[in]      oid                 Object identifier buffer
+ * @param[in]      oid_size            Object identifier buffer size
+ * @param[out]     extension_data      Extension bytes.
+ * @param[in, out] extension_data_size Extension bytes size.
+ *
+ * @retval RETURN_SUCCESS           The certificate Extension data retrieved successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert, oid or extension_data_size is NULL.
+ * @retval RETURN_NOT_FOUND         If no Extension entry match oid.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the extension_data_size is too small for the result.
+ *                                 The required size is returned in extension_data_size.
+ **/
+return_status libspdm_x509_object_get_extension_data(const void *x509_cert,
+                                                     const uint8_t *oid, uintn oid_size,
+                                                     uint8_t *extension_data,
+                                                     uintn *extension_data_size)
+{
+    return_status status;
+    intn i;
+    const STACK_OF(X509_EXTENSION) * extensions;
+    ASN1_OBJECT *asn1_obj;
+    ASN1_OCTET_STRING *asn1_oct;
+    X509_EXTENSION *ext;
+    uintn obj_length;
+    uintn oct_length;
+
+
+    /* Check input parameters.*/
+
+    if (x509_cert == NULL || oid == NULL || oid_size == 0 ||
+        extension_data_size == NULL) {
+        return RETURN_INVALID_PARAMETER;
     }
 
 
     /* Retrieve extensions from certificate object.*/
 
     status = RETURN_NOT_FOUND;
-    extensions = X509_get0_extensions(x509_cert);
+    asn1_oct = NULL;
+    oct_length = 0;
+    extensions = X509_get0_extensions((const X509 *)x509_cert);
     if (sk_X509_EXTENSION_num(extensions) <= 0) {
-        goto cleanup;
+        return status;
     }
 
 
@@ -1392,23 +1561,13 @@ return_status libspdm_x509_get_extension_data(const uint8_t *cert, uintn cert_si
     if (status == RETURN_SUCCESS) {
         if (*extension_data_size < oct_length) {
             *extension_data_size = oct_length;
-            status = RETURN_BUFFER_TOO_SMALL;
-            goto cleanup;
+            return RETURN_BUFFER_TOO_SMALL;
         }
         if (oid != NULL) {
             libspdm_copy_mem(extension_data, *extension_data_size,
                              ASN1_STRING_get0_data(asn1_oct), asn1_oct->length);
         }
         *extension_data_size = oct_length;
-        status = RETURN_SUCCESS;
-    }
-
-cleanup:
-
-    /* Release Resources.*/
-
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
     }
 
     return status;
@@ -1443,6 +1602,29 @@ return_status libspdm_x509_get_extended_key_usage(const uint8_t *cert,
     return status;
 }
 
+/**
+ * Retrieve the Extended key usage from one X509 object.
+ *
+ * @param[in]      x509_cert        Pointer to the X509 object.
+ * @param[out]     usage            key usage bytes.
+ * @param[in, out] usage_size        key usage buffer sizs in bytes.
+ *
+ * @retval RETURN_SUCCESS           The usage bytes retrieve successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or usage_size is NULL.
+ * @retval RETURN_NOT_FOUND         If no extended key usage exists.
+ * @retval RETURN_BUFFER_TOO_SMALL  If the usage_size is too small for the result.
+ *                                 The required size is returned in usage_size.
+ **/
+return_status libspdm_x509_object_get_extended_key_usage(const void *x509_cert,
+                                                         uint8_t *usage,
+                                                         uintn *usage_size)
+{
+    return libspdm_x509_object_get_extension_data(x509_cert,
+                                                  m_libspdm_oid_ext_key_usage,
+                                                  sizeof(m_libspdm_oid_ext_key_usage),
+                                                  usage, usage_size);
+}
+
 /**
  * Retrieve the basic constraints from one X.509 certificate.
  *
@@ -1479,6 +1661,30 @@ return_status libspdm_x509_get_extended_basic_constraints(const uint8_t *cert,
     return status;
 }
 
+/**
+ * Retrieve the basic constraints from one X509 object.
+ *
+ * @param[in]      x509_cert                Pointer to the X509 object.
+ * @param[out]     basic_constraints        basic constraints bytes.
+ * @param[in, out] basic_constraints_size   basic constraints buffer sizs in bytes.
+ *
+ * @retval RETURN_SUCCESS           The basic constraints retrieve successfully.
+ * @retval RETURN_INVALID_PARAMETER If x509_cert or basic_constraints_size is NULL.
+ * @retval RETURN_BUFFER_TOO_SMALL  The required buffer size is small.
+ *                                  The return buffer size is basic_constraints_size parameter.
+ * @retval RETURN_NOT_FOUND         If no Extension entry match oid.
+ **/
+return_status libspdm_x509_object_get_extended_basic_constraints(const void *x509_cert,
+                                                                 uint8_t *basic_constraints,
+                                                                 uintn *basic_constraints_size)
+{
+    return libspdm_x509_object_get_extension_data(x509_cert,
+                                                  m_libspdm_oid_basic_constraints,
+                                                  sizeof(m_libspdm_oid_basic_constraints),
+                                                  basic_constraints,
+                                                  basic_constraints_size);
+}
+
 /**
  * Retrieve the RSA public key from one DER-encoded X509 certificate.
  *
@@ -1499,7 +1705,6 @@ bool libspdm_rsa_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
                                           void **rsa_context)
 {
     bool res;
-    EVP_PKEY *pkey;
     X509 *x509_cert;
 
 
@@ -1509,7 +1714,6 @@ bool libspdm_rsa_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
         return false;
     }
 
-    pkey = NULL;
     x509_cert = NULL;
 
 
@@ -1517,8 +1721,39 @@ bool libspdm_rsa_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
 
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
-        res = false;
-        goto done;
+        return false;
+    }
+
+    res = libspdm_rsa_get_public_key_from_x509_object(x509_cert, rsa_context);
+
+    X509_free(x509_cert);
+
+    return res;
+}
+
+/**
+ * Retrieve the RSA public key from one X509 object.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] rsa_context   Pointer to new-generated RSA context which contain the retrieved
+ *                         RSA public key component. Use libspdm_rsa_free() function to free the
+ *                         resource.
+ *
+ * @retval  true   RSA public key was retrieved successfully.
+ * @retval  false  Fail to retrieve RSA public key from X509 object.
+ *
+ **/
+bool libspdm_rsa_get_public_key_from_x509_object(const void *x509_cert,
+                                                 void **rsa_context)
+{
+    bool res;
+    EVP_PKEY *pkey;
+
+
+    /* Check input parameters.*/
+
+    if (x509_cert == NULL || rsa_context == NULL) {
+        return false;
     }
 
     res = false;
@@ -1526,7 +1761,7 @@ bool libspdm_rsa_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
 
     /* Retrieve and check EVP_PKEY data from X509 Certificate.*/
 
-    pkey = X509_get_pubkey(x509_cert);
+    pkey = X509_get_pubkey((X509 *)x509_cert);
     if ((pkey == NULL) || (EVP_PKEY_id(pkey) != EVP_PKEY_RSA)) {
         goto done;
     }
@@ -1543,10 +1778,6 @@ done:
 
     /* Release Resources.*/
 
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
-    }
-
     if (pkey != NULL) {
         EVP_PKEY_free(pkey);
     }
@@ -1574,7 +1805,6 @@ bool libspdm_ec_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
                                          void **ec_context)
 {
     bool res;
-    EVP_PKEY *pkey;
     X509 *x509_cert;
 
 
@@ -1584,7 +1814,6 @@ bool libspdm_ec_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
         return false;
     }
 
-    pkey = NULL;
     x509_cert = NULL;
 
 
@@ -1592,8 +1821,39 @@ bool libspdm_ec_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
 
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
-        res = false;
-        goto done;
+        return false;
+    }
+
+    res = libspdm_ec_get_public_key_from_x509_object(x509_cert, ec_context);
+
+    X509_free(x509_cert);
+
+    return res;
+}
+
+/**
+ * Retrieve the EC public key from one X509 object.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] ec_context   Pointer to new-generated EC context which contain the retrieved
+ *                         EC public key component. Use libspdm_ec_free() function to free the
+ *                         resource.
+ *
+ * @retval  true   EC public key was retrieved successfully.
+ * @retval  false  Fail to retrieve EC public key from X509 object.
+ *
+ **/
+bool libspdm_ec_get_public_key_from_x509_object(const void *x509_cert,
+                                                void **ec_context)
+{
+    bool res;
+    EVP_PKEY *pkey;
+
+
+    /* Check input parameters.*/
+
+    if (x509_cert == NULL || ec_context == NULL) {
+        return false;
     }
 
     res = false;
@@ -1601,7 +1861,7 @@ bool libspdm_ec_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
 
     /* Retrieve and check EVP_PKEY data from X509 Certificate.*/
 
-    pkey = X509_get_pubkey(x509_cert);
+    pkey = X509_get_pubkey((X509 *)x509_cert);
     if ((pkey == NULL) || (EVP_PKEY_id(pkey) != EVP_PKEY_EC)) {
         goto done;
     }
@@ -1617,10 +1877,6 @@ done:
 
     /* Release Resources.*/
 
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
-    }
-
     if (pkey != NULL) {
         EVP_PKEY_free(pkey);
     }
@@ -1648,9 +1904,7 @@ bool libspdm_ecd_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
                                           void **ecd_context)
 {
     bool res;
-    EVP_PKEY *pkey;
     X509 *x509_cert;
-    int32_t type;
 
 
     /* Check input parameters.*/
@@ -1659,7 +1913,6 @@ bool libspdm_ecd_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
         return false;
     }
 
-    pkey = NULL;
     x509_cert = NULL;
 
 
@@ -1667,36 +1920,56 @@ bool libspdm_ecd_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
 
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
-        res = false;
-        goto done;
+        return false;
     }
 
-    res = false;
+    res = libspdm_ecd_get_public_key_from_x509_object(x509_cert, ecd_context);
+
+    X509_free(x509_cert);
+
+    return res;
+}
+
+/**
+ * Retrieve the Ed public key from one X509 object.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] ecd_context   Pointer to new-generated Ed context which contain the retrieved
+ *                         Ed public key component. Use libspdm_ecd_free() function to free the
+ *                         resource.
+ *
+ * @retval  true   Ed public key was retrieved successfully.
+ * @retval  false  Fail to retrieve Ed public key from X509 object.
+ *
+ **/
+bool libspdm_ecd_get_public_key_from_x509_object(const void *x509_cert,
+                                                 void **ecd_context)
+{
+    EVP_PKEY *pkey;
+    int32_t type;
+
+
+    /* Check input parameters.*/
+
+    if (x509_cert == NULL || ecd_context == NULL) {
+        return false;
+    }
 
 
     /* Retrieve and check EVP_PKEY data from X509 Certificate.*/
 
-    pkey = X509_get_pubkey(x509_cert);
+    pkey = X509_get_pubkey((X509 *)x509_cert);
     if (pkey == NULL) {
-        goto done;
+        return false;
     }
     type = EVP_PKEY_id(pkey);
     if ((type != EVP_PKEY_ED25519) && (type != EVP_PKEY_ED448)) {
-        goto done;
+        EVP_PKEY_free(pkey);
+        return false;
     }
 
     *ecd_context = pkey;
-    res = true;
-
-done:
-
-    /* Release Resources.*/
-
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
-    }
-
-    return res;
+    return true;
 }
 
 /**
@@ -1719,11 +1992,7 @@ bool libspdm_sm2_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
                                           void **sm2_context)
 {
     bool res;
-    EVP_PKEY *pkey;
     X509 *x509_cert;
-    int32_t result;
-    EC_KEY *ec_key;
-    int32_t openssl_nid;
 
 
     /* Check input parameters.*/
@@ -1732,7 +2001,6 @@ bool libspdm_sm2_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
         return false;
     }
 
-    pkey = NULL;
     x509_cert = NULL;
 
 
@@ -1740,40 +2008,155 @@ bool libspdm_sm2_get_public_key_from_x509(const uint8_t *cert, uintn cert_size,
 
     res = libspdm_x509_construct_certificate(cert, cert_size, (uint8_t **)&x509_cert);
     if ((x509_cert == NULL) || (!res)) {
-        res = false;
-        goto done;
+        return false;
     }
 
-    res = false;
+    res = libspdm_sm2_get_public_key_from_x509_object(x509_cert, sm2_context);
+
+    X509_free(x509_cert);
+
+    return res;
+}
+
+/**
+ * Retrieve the sm2 public key from one X509 object.
+ *
+ * @param[in]  x509_cert     Pointer to the X509 object.
+ * @param[out] sm2_context   Pointer to new-generated sm2 context which contain the retrieved
+ *                         sm2 public key component. Use libspdm_sm2_dsa_free() function to free the
+ *                         resource.
+ *
+ * @retval  true   sm2 public key was retrieved successfully.
+ * @retval  false  Fail to retrieve sm2 public key from X509 object.
+ *
+ **/
+bool libspdm_sm2_get_public_key_from_x509_object(const void *x509_cert,
+                                                 void **sm2_context)
+{
+    EVP_PKEY *pkey;
+    int32_t result;
+    EC_KEY *ec_key;
+    int32_t openssl_nid;
+
+
+    /* Check input parameters.*/
+
+    if (x509_cert == NULL || sm2_context == NULL) {
+        return false;
+    }
 
 
     /* Retrieve and check EVP_PKEY data from X509 Certificate.*/
 
-    pkey = X509_get_pubkey(x509_cert);
+    pkey = X509_get_pubkey((X509 *)x509_cert);
     if (pkey == NULL) {
-        goto done;
+        return false;
     }
     ec_key = EVP_PKEY_get0_EC_KEY(pkey);
+    if (ec_key == NULL) {
+        EVP_PKEY_free(pkey);
+        return false;
+    }
     openssl_nid = EC_GROUP_get_curve_name(EC_KEY_get0_group(ec_key));
     if (openssl_nid != NID_sm2) {
-        goto done;
+        EVP_PKEY_free(pkey);
+        return false;
     }
     result = EVP_PKEY_set_alias_type(pkey, EVP_PKEY_SM2);
     if (result == 0) {
-        goto done;
+        EVP_PKEY_free(pkey);
+        return false;
     }
 
     *sm2_context = pkey;
-    res = true;
+    return true;
+}
+
+/**
+ * Check if the current time is within the validity window of one X509 certificate object.
+ *
+ * @param[in]      x509_cert    Pointer to the X509 object.
+ *
+ * @retval  true   The certificate is valid now.
+ * @retval  false  The certificate is not yet valid or has expired.
+ **/
+static bool libspdm_x509_object_is_time_valid(X509 *x509_cert)
+{
+    return (X509_cmp_current_time(X509_get0_notBefore(x509_cert)) < 0) &&
+           (X509_cmp_current_time(X509_get0_notAfter(x509_cert)) > 0);
+}
+
+/**
+ * Verify one X509 object was issued by the trusted CA X509 object.
+ *
+ * @param[in]      x509_cert      Pointer to the X509 object to be verified.
+ * @param[in]      x509_ca_cert   Pointer to the trusted CA X509 object.
+ *
+ * @retval  true   The certificate was issued by the trusted CA.
+ * @retval  false  Invalid certificate or the certificate was not issued by the given
+ *                trusted CA.
+ **/
+static bool libspdm_x509_verify_cert_object(X509 *x509_cert, X509 *x509_ca_cert)
+{
+    bool res;
+    X509_STORE *cert_store;
+    X509_STORE_CTX *cert_ctx;
+
+    res = false;
+    cert_store = NULL;
+    cert_ctx = NULL;
+
+
+    /* Register & Initialize necessary digest algorithms for certificate verification.*/
+
+    if (!libspdm_openssl_init()) {
+        goto done;
+    }
+
+
+    /* Set up X509 Store for trusted certificate.*/
+
+    cert_store = X509_STORE_new();
+    if (cert_store == NULL) {
+        goto done;
+    }
+    if (!(X509_STORE_add_cert(cert_store, x509_ca_cert))) {
+        goto done;
+    }
+
+
+    /* Allow partial certificate chains, terminated by a non-self-signed but
+     * still trusted intermediate certificate. Also disable time checks.*/
+
+    X509_STORE_set_flags(cert_store, X509_V_FLAG_PARTIAL_CHAIN);
+
+
+    /* Set up X509_STORE_CTX for the subsequent verification operation.*/
+
+    cert_ctx = X509_STORE_CTX_new();
+    if (cert_ctx == NULL) {
+        goto done;
+    }
+    if (!X509_STORE_CTX_init(cert_ctx, cert_store, x509_cert, NULL)) {
+        goto done;
+    }
+
+
+    /* X509 Certificate Verification.*/
+
+    res = (bool)X509_verify_cert(cert_ctx);
+    X509_STORE_CTX_cleanup(cert_ctx);
 
 done:
 
     /* Release Resources.*/
 
-    if (x509_cert != NULL) {
-        X509_free(x509_cert);
+    if (cert_store != NULL) {
+        X509_STORE_free(cert_store);
     }
 
+    X509_STORE_CTX_free(cert_ctx);
+
     return res;
 }
 
@@ -1799,8 +2182,6 @@ bool libspdm_x509_verify_cert(const uint8_t *cert, uintn cert_size,
     bool res;
     X509 *x509_cert;
     X509 *x509_ca_cert;
-    X509_STORE *cert_store;
-    X509_STORE_CTX *cert_ctx;
 
 
     /* Check input parameters.*/
@@ -1812,21 +2193,6 @@ bool libspdm_x509_verify_cert(const uint8_t *cert, uintn cert_size,
     res = false;
     x509_cert = NULL;
     x509_ca_cert = NULL;
-    cert_store = NULL;
-    cert_ctx = NULL;
-
-
-    /* Register & Initialize necessary digest algorithms for certificate verification.*/
-
-    if (EVP_add_digest(EVP_sha256()) == 0) {
-        goto done;
-    }
-    if (EVP_add_digest(EVP_sha384()) == 0) {
-        goto done;
-    }
-    if (EVP_add_digest(EVP_sha512()) == 0) {
-        goto done;
-    }
 
 
     /* Read DER-encoded certificate to be verified and Construct X509 object.*/
@@ -1847,41 +2213,7 @@ bool libspdm_x509_verify_cert(const uint8_t *cert, uintn cert_size,
         goto done;
     }
 
-    res = false;
-
-
-    /* Set up X509 Store for trusted certificate.*/
-
-    cert_store = X509_STORE_new();
-    if (cert_store == NULL) {
-        goto done;
-    }
-    if (!(X509_STORE_add_cert(cert_store, x509_ca_cert))) {
-        goto done;
-    }
-
-
-    /* Allow partial certificate chains, terminated by a non-self-signed but
-     * still trusted intermediate certificate. Also disable time checks.*/
-
-    X509_STORE_set_flags(cert_store, X509_V_FLAG_PARTIAL_CHAIN);
-
-
-    /* Set up X509_STORE_CTX for the subsequent verification operation.*/
-
-    cert_ctx = X509_STORE_CTX_new();
-    if (cert_ctx == NULL) {
-        goto done;
-    }
-    if (!X509_STORE_CTX_init(cert_ctx, cert_store, x509_cert, NULL)) {
-        goto done;
-    }
-
-
-    /* X509 Certificate Verification.*/
-
-    res = (bool)X509_verify_cert(cert_ctx);
-    X509_STORE_CTX_cleanup(cert_ctx);
+    res = libspdm_x509_verify_cert_object(x509_cert, x509_ca_cert);
 
 done:
 
@@ -1895,12 +2227,6 @@ done:
         X509_free(x509_ca_cert);
     }
 
-    if (cert_store != NULL) {
-        X509_STORE_free(cert_store);
-    }
-
-    X509_STORE_CTX_free(cert_ctx);
-
     return res;
 }
 
@@ -2005,13 +2331,28 @@ bool libspdm_x509_verify_cert_chain(uint8_t *root_cert, uintn root_cert_length,
     uint32_t obj_class;
     uint8_t *current_cert;
     uintn current_cert_len;
-    uint8_t *preceding_cert;
-    uintn preceding_cert_len;
+    X509 *current_x509;
+    X509 *preceding_x509;
     bool verify_flag;
     int32_t ret;
+    bool cache_enabled;
+    uint8_t preceding_hash[LIBSPDM_SHA256_DIGEST_SIZE];
+    uint8_t current_hash[LIBSPDM_SHA256_DIGEST_SIZE];
+
+
+    /* Each certificate is parsed only once: it is verified as the subject
+     * certificate, then kept as the issuer object of the next one.*/
+
+    preceding_x509 = NULL;
+    if (!libspdm_x509_construct_certificate(root_cert, root_cert_length,
+                                            (uint8_t **)&preceding_x509)) {
+        return false;
+    }
 
-    preceding_cert = root_cert;
-    preceding_cert_len = root_cert_length;
+    cache_enabled = libspdm_x509_verify_cache_is_enabled();
+    if (cache_enabled) {
+        cache_enabled = libspdm_sha256_hash_all(root_cert, root_cert_length, preceding_hash);
+    }
 
     current_cert = cert_chain;
     length = 0;
@@ -2036,18 +2377,42 @@ bool libspdm_x509_verify_cert_chain(uint8_t *root_cert, uintn root_cert_length,
 
         /* Verify current_cert with preceding cert;*/
 
-        verify_flag =
-            libspdm_x509_verify_cert(current_cert, current_cert_len,
-                                     preceding_cert, preceding_cert_len);
-        if (verify_flag == false) {
+        current_x509 = NULL;
+        if (!libspdm_x509_construct_certificate(current_cert, current_cert_len,
+                                                (uint8_t **)&current_x509)) {
+            verify_flag = false;
             break;
         }
+        if (cache_enabled) {
+            cache_enabled = libspdm_sha256_hash_all(current_cert, current_cert_len,
+                                                    current_hash);
+        }
+
+        /* A cached pair skips the signature check, but both certificates must still be valid now.*/
+        if (cache_enabled &&
+            libspdm_x509_object_is_time_valid(current_x509) &&
+            libspdm_x509_object_is_time_valid(preceding_x509) &&
+            libspdm_x509_verify_cache_lookup(preceding_hash, current_hash)) {
+            verify_flag = true;
+        } else {
+            verify_flag = libspdm_x509_verify_cert_object(current_x509, preceding_x509);
+            if (verify_flag && cache_enabled) {
+                libspdm_x509_verify_cache_insert(preceding_hash, current_hash);
+            }
+        }
 
 
         /* move Current cert to Preceding cert*/
 
-        preceding_cert_len = current_cert_len;
-        preceding_cert = current_cert;
+        X509_free(preceding_x509);
+        preceding_x509 = current_x509;
+        if (verify_flag == false) {
+            break;
+        }
+        if (cache_enabled) {
+            libspdm_copy_mem(preceding_hash, sizeof(preceding_hash),
+                             current_hash, sizeof(current_hash));
+        }
 
 
         /* Move to next*/
@@ -2055,6 +2420,8 @@ bool libspdm_x509_verify_cert_chain(uint8_t *root_cert, uintn root_cert_length,
         current_cert = current_cert + current_cert_len;
     }
 
+    X509_free(preceding_x509);
+
     return verify_flag;
 }
 
@@ -17,12 +17,90 @@
 
 uint8_t libspdm_default_seed[] = "Crypto Library default seed";
 
+#if !defined(OPENSSL_THREADS)
+
+/* Without OPENSSL_THREADS, the DRBG of OpenSSL is not locked. Its calls only take a few
+ * microseconds, so they are serialized by a spin lock around the default RAND method.*/
+static libspdm_spin_lock_t m_libspdm_random_lock;
+
+static int libspdm_random_locked_seed(const void *buf, int num)
+{
+    int ret;
+
+    libspdm_spin_lock_acquire(&m_libspdm_random_lock);
+    ret = RAND_OpenSSL()->seed(buf, num);
+    libspdm_spin_lock_release(&m_libspdm_random_lock);
+    return ret;
+}
+
+static int libspdm_random_locked_bytes(unsigned char *buf, int num)
+{
+    int ret;
+
+    libspdm_spin_lock_acquire(&m_libspdm_random_lock);
+    ret = RAND_OpenSSL()->bytes(buf, num);
+    libspdm_spin_lock_release(&m_libspdm_random_lock);
+    return ret;
+}
+
+static int libspdm_random_locked_add(const void *buf, int num, double randomness)
+{
+    int ret;
+
+    libspdm_spin_lock_acquire(&m_libspdm_random_lock);
+    ret = RAND_OpenSSL()->add(buf, num, randomness);
+    libspdm_spin_lock_release(&m_libspdm_random_lock);
+    return ret;
+}
+
+static int libspdm_random_locked_status(void)
+{
+    int ret;
+
+    libspdm_spin_lock_acquire(&m_libspdm_random_lock);
+    ret = RAND_OpenSSL()->status();
+    libspdm_spin_lock_release(&m_libspdm_random_lock);
+    return ret;
+}
+
+static const RAND_METHOD m_libspdm_random_locked_method = {
+    libspdm_random_locked_seed,
+    libspdm_random_locked_bytes,
+    NULL,
+    libspdm_random_locked_add,
+    libspdm_random_locked_bytes,
+    libspdm_random_locked_status,
+};
+
+#endif /* !defined(OPENSSL_THREADS)*/
+
+/**
+ * Set up the pseudorandom number generator, called once by libspdm_openssl_init().
+ *
+ * Without OPENSSL_THREADS, it serializes the OpenSSL DRBG, so that contexts can be used by
+ * concurrent threads. The default seed is mixed in here, not on every libspdm_random_seed().
+ *
+ * @retval true   The pseudorandom number generator is set up.
+ * @retval false  The pseudorandom number generator cannot be set up.
+ **/
+bool libspdm_random_init(void)
+{
+#if !defined(OPENSSL_THREADS)
+    if (RAND_set_rand_method(&m_libspdm_random_locked_method) != 1) {
+        return false;
+    }
+#endif /* !defined(OPENSSL_THREADS)*/
+
+    RAND_seed(libspdm_default_seed, sizeof(libspdm_default_seed));
+    return true;
+}
+
 /**
  * Sets up the seed value for the pseudorandom number generator.
  *
  * This function sets up the seed value for the pseudorandom number generator.
  * If seed is not NULL, then the seed passed in is used.
- * If seed is NULL, then default seed is used.
+ * If seed is NULL, then default seed is used. It is mixed in only once.
  *
  * @param[in]  seed      Pointer to seed value.
  *                      If NULL, default seed is used.
@@ -41,9 +119,10 @@ bool libspdm_random_seed(const uint8_t *seed, uintn seed_size)
 
 
     /* The software PRNG implementation built in OpenSSL depends on message digest algorithm.
-     * Make sure SHA-1 digest algorithm is available here.*/
+     * libspdm_openssl_init() makes sure SHA-256 digest algorithm is available, and mixes in
+     * the default seed.*/
 
-    if (EVP_add_digest(EVP_sha256()) == 0) {
+    if (!libspdm_openssl_init()) {
         return false;
     }
 
@@ -53,8 +132,6 @@ bool libspdm_random_seed(const uint8_t *seed, uintn seed_size)
 
     if (seed != NULL) {
         RAND_seed(seed, (uint32_t)seed_size);
-    } else {
-        RAND_seed(libspdm_default_seed, sizeof(libspdm_default_seed));
     }
 
     if (RAND_status() == 1) {
@@ -0,0 +1,90 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Base Memory Allocation Routines Wrapper.
+ **/
+
+#include "internal_crypt_lib.h"
+#include <openssl/crypto.h>
+
+/* Extra header to record the memory buffer size, for realloc.*/
+typedef struct {
+    uintn size;
+    uintn reserved;
+} libspdm_openssl_mem_head_t;
+
+static void *libspdm_openssl_malloc(size_t num, const char *file, int line)
+{
+    libspdm_openssl_mem_head_t *head;
+
+    if (num > (uintn)-1 - sizeof(libspdm_openssl_mem_head_t)) {
+        return NULL;
+    }
+    head = allocate_pool(sizeof(libspdm_openssl_mem_head_t) + num);
+    if (head == NULL) {
+        return NULL;
+    }
+    head->size = num;
+    return head + 1;
+}
+
+static void libspdm_openssl_free(void *ptr, const char *file, int line)
+{
+    /* In Standard C, free() handles a null pointer argument transparently. This
+     * is not true of free_pool() below, so protect it.*/
+    if (ptr != NULL) {
+        free_pool((libspdm_openssl_mem_head_t *)ptr - 1);
+    }
+}
+
+static void *libspdm_openssl_realloc(void *ptr, size_t num, const char *file, int line)
+{
+    libspdm_openssl_mem_head_t *head;
+    void *new_ptr;
+
+    if (ptr == NULL) {
+        return libspdm_openssl_malloc(num, file, line);
+    }
+    if (num == 0) {
+        libspdm_openssl_free(ptr, file, line);
+        return NULL;
+    }
+
+    new_ptr = libspdm_openssl_malloc(num, file, line);
+    if (new_ptr == NULL) {
+        return NULL;
+    }
+    head = (libspdm_openssl_mem_head_t *)ptr - 1;
+    libspdm_copy_mem(new_ptr, num, ptr, (head->size < num) ? head->size : num);
+    libspdm_openssl_free(ptr, file, line);
+    return new_ptr;
+}
+
+/**
+ * Routes the memory allocations of the crypto backend through allocate_pool() and free_pool().
+ *
+ * OpenSSL accepts new memory functions only before its first allocation. Its global state is
+ * then built from the default heap, before the caller may select an arena.
+ *
+ * @retval true   The crypto backend allocates memory with allocate_pool() and free_pool().
+ * @retval false  The crypto backend already allocated memory with another allocator.
+ **/
+bool libspdm_crypt_use_pool_allocator(void)
+{
+    void *(*malloc_fn)(size_t, const char *, int);
+    void *(*realloc_fn)(void *, size_t, const char *, int);
+    void (*free_fn)(void *, const char *, int);
+
+    CRYPTO_get_mem_functions(&malloc_fn, &realloc_fn, &free_fn);
+    if (((malloc_fn != libspdm_openssl_malloc) || (realloc_fn != libspdm_openssl_realloc) ||
+         (free_fn != libspdm_openssl_free)) &&
+        (CRYPTO_set_mem_functions(libspdm_openssl_malloc, libspdm_openssl_realloc,
+                                  libspdm_openssl_free) != 1)) {
+        return false;
+    }
+    return libspdm_openssl_init();
+}
@@ -0,0 +1,72 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * One-time global setup of OpenSSL.
+ *
+ * EVP_add_cipher() and EVP_add_digest() replace and free an entry of the global name table
+ * on every call. OpenSSL is built with OPENSSL_SYS_UEFI and without OPENSSL_THREADS, so the
+ * table is not locked, and calling them per PEM parse or per certificate verification from
+ * several threads corrupts it. They are called once here instead, together with the setup of
+ * the random number generator, and the table is only read afterwards.
+ *
+ * This state lives until the end of the process, so it is built from the default heap even if
+ * the caller selected an arena with libspdm_set_pool_allocator().
+ **/
+
+#include "internal_crypt_lib.h"
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+
+static libspdm_once_t m_libspdm_openssl_init_once;
+
+/**
+ * Initialize the OpenSSL library, register the algorithms looked up by name and set up the
+ * random number generator.
+ *
+ * @retval true   OpenSSL is set up.
+ * @retval false  The setup failed.
+ **/
+static bool libspdm_openssl_setup(void)
+{
+    const libspdm_pool_allocator_t *previous_allocator;
+    bool result;
+
+    previous_allocator = libspdm_set_pool_allocator(NULL);
+
+    result = (OPENSSL_init_crypto(0, NULL) != 0);
+
+    /* Block-cipher descriptors for PEM data decryption.
+     * NOTE: Only support most popular ciphers AES for the encrypted PEM.*/
+    result = result &&
+             (EVP_add_cipher(EVP_aes_128_cbc()) != 0) &&
+             (EVP_add_cipher(EVP_aes_192_cbc()) != 0) &&
+             (EVP_add_cipher(EVP_aes_256_cbc()) != 0);
+
+    /* Digests for certificate verification, and for the software PRNG.*/
+    result = result &&
+             (EVP_add_digest(EVP_sha256()) != 0) &&
+             (EVP_add_digest(EVP_sha384()) != 0) &&
+             (EVP_add_digest(EVP_sha512()) != 0);
+
+    result = result && libspdm_random_init();
+
+    libspdm_set_pool_allocator(previous_allocator);
+    return result;
+}
+
+/**
+ * Register the algorithms looked up by name and set up the random number generator, once.
+ *
+ * Concurrent callers wait until the first one completed the setup.
+ *
+ * @retval true   OpenSSL is set up.
+ * @retval false  The setup failed.
+ **/
+bool libspdm_openssl_init(void)
+{
+    return libspdm_once(&m_libspdm_openssl_init_once, libspdm_openssl_setup);
+}
@@ -61,4 +61,135 @@ void *allocate_zero_pool(uintn AllocationSize);
  **/
 void free_pool(const void *buffer);
 
+/**
+ * Allocates a block for the pool allocation functions.
+ *
+ * @param  context               The context of the allocator.
+ * @param  size                  The number of bytes to allocate.
+ *
+ * @return A pointer to the allocated block, or NULL to fall back to the default heap.
+ **/
+typedef void *(*libspdm_pool_allocate_func)(void *context, uintn size);
+
+/**
+ * Frees a block returned by libspdm_pool_allocate_func.
+ *
+ * @param  context               The context of the allocator.
+ * @param  buffer                Pointer to the block to free.
+ **/
+typedef void (*libspdm_pool_free_func)(void *context, void *buffer);
+
+typedef struct {
+    libspdm_pool_allocate_func allocate;
+    libspdm_pool_free_func free;
+    void *context;
+} libspdm_pool_allocator_t;
+
+/**
+ * Selects the allocator of the pool allocation functions in the calling thread.
+ *
+ * Every buffer records the allocator it comes from, so free_pool() returns it to that allocator
+ * whichever allocator is selected at that time.
+ *
+ * @param  allocator             The allocator, or NULL for the default heap.
+ *
+ * @return The allocator selected before, or NULL for the default heap.
+ **/
+const libspdm_pool_allocator_t *libspdm_set_pool_allocator(
+    const libspdm_pool_allocator_t *allocator);
+
+/* A bump allocator over a caller provided buffer.
+ * The blocks are not freed one by one: the whole buffer is reclaimed in one shot once the
+ * last live block is freed. When the buffer is full, the pool allocation functions fall back
+ * to the default heap. A block may be freed from another thread than the one that allocated
+ * it.*/
+typedef struct {
+    /* The allocator to select with libspdm_set_pool_allocator.*/
+    libspdm_pool_allocator_t allocator;
+    uint8_t *buffer;
+    uintn size;
+    uintn used;
+    uintn live_count;
+    /* Spin lock of used and live_count.*/
+    volatile long lock;
+} libspdm_arena_t;
+
+/**
+ * Initializes an arena over a buffer.
+ *
+ * @param  arena                 Pointer to the arena.
+ * @param  buffer                Pointer to the memory of the arena.
+ * @param  size                  The size in bytes of the memory of the arena.
+ **/
+void libspdm_arena_init(libspdm_arena_t *arena, void *buffer, uintn size);
+
+/**
+ * Ends the scope of an arena, such as a session or a request.
+ *
+ * The arena may be used for another scope afterwards.
+ *
+ * @param  arena                 Pointer to the arena.
+ *
+ * @retval true   The memory of the arena is reclaimed.
+ * @retval false  Some blocks of the scope are still live, the memory of the arena is reclaimed
+ *                once they are freed.
+ **/
+bool libspdm_arena_release(libspdm_arena_t *arena);
+
+/* Allocation statistics of a scope, such as an SPDM context or a session.
+ * They are recorded by the instrumented malloclib only (MALLOCLIB=instrumented).*/
+typedef struct {
+    uint64_t allocation_count;
+    uint64_t free_count;
+    uint64_t allocated_bytes;
+    uintn live_count;
+    uintn live_bytes;
+    /* High-water marks of live_count and live_bytes.*/
+    uintn peak_live_count;
+    uintn peak_live_bytes;
+    uintn largest_allocation;
+    /* Spin lock of the counters, zero initialized.*/
+    volatile long lock;
+} libspdm_malloc_stats_t;
+
+/**
+ * Returns whether the malloclib records allocation statistics.
+ *
+ * @retval true   The malloclib is instrumented.
+ * @retval false  The statistics stay zero.
+ **/
+bool libspdm_malloc_stats_is_enabled(void);
+
+/**
+ * Selects the statistics that record the pool allocations of the calling thread.
+ *
+ * Every buffer records the statistics it is counted in, so free_pool() updates them whatever
+ * statistics are selected at that time. The statistics must outlive their buffers.
+ *
+ * @param  stats                 The statistics, or NULL to record nothing.
+ *
+ * @return The statistics selected before.
+ **/
+libspdm_malloc_stats_t *libspdm_set_malloc_stats_scope(libspdm_malloc_stats_t *stats);
+
+/**
+ * Starts a new measurement with some statistics.
+ *
+ * The counters are zeroed and the high-water marks restart from the live buffers, which are
+ * still counted.
+ *
+ * @param  stats                 The statistics.
+ **/
+void libspdm_reset_malloc_stats(libspdm_malloc_stats_t *stats);
+
+/**
+ * Prints some statistics on one line.
+ *
+ * The statistics are read without the lock, so the scope should have no allocation in flight.
+ *
+ * @param  name                  The name of the scope.
+ * @param  stats                 The statistics.
+ **/
+void libspdm_dump_malloc_stats(const char *name, const libspdm_malloc_stats_t *stats);
+
 #endif
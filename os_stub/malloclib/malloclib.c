@@ -5,21 +5,123 @@
  **/
 
 #include <base.h>
+#include "library/malloclib.h"
+#include "internal_crypt_common.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 
+/* The instrumented malloclib records the allocation statistics, see libspdm_malloc_stats_t.*/
+#ifndef LIBSPDM_MALLOCLIB_INSTRUMENTED
+#define LIBSPDM_MALLOCLIB_INSTRUMENTED 0
+#endif
+
+#if defined(_MSC_VER)
+#define LIBSPDM_THREAD_LOCAL __declspec(thread)
+#else
+#define LIBSPDM_THREAD_LOCAL __thread
+#endif
+
+/* Alignment of the blocks, the same as the default heap.*/
+#define LIBSPDM_POOL_ALIGNMENT (sizeof(uintn) * 2)
+
+#define LIBSPDM_POOL_ALIGN(size) \
+    (((size) + LIBSPDM_POOL_ALIGNMENT - 1) & ~(LIBSPDM_POOL_ALIGNMENT - 1))
+
+/* Header of every block, to return it to the allocator it comes from.*/
+typedef struct {
+    const libspdm_pool_allocator_t *allocator;
+    uintn size;
+#if LIBSPDM_MALLOCLIB_INSTRUMENTED
+    libspdm_malloc_stats_t *stats;
+    uintn reserved;
+#endif
+} libspdm_pool_head_t;
+
+static LIBSPDM_THREAD_LOCAL const libspdm_pool_allocator_t *m_libspdm_pool_allocator;
+
+static LIBSPDM_THREAD_LOCAL libspdm_malloc_stats_t *m_libspdm_malloc_stats;
+
+#if LIBSPDM_MALLOCLIB_INSTRUMENTED
+static void libspdm_malloc_stats_record_allocate(libspdm_malloc_stats_t *stats, uintn size)
+{
+    libspdm_spin_lock_acquire(&stats->lock);
+    stats->allocation_count++;
+    stats->allocated_bytes += size;
+    stats->live_count++;
+    stats->live_bytes += size;
+    if (stats->live_count > stats->peak_live_count) {
+        stats->peak_live_count = stats->live_count;
+    }
+    if (stats->live_bytes > stats->peak_live_bytes) {
+        stats->peak_live_bytes = stats->live_bytes;
+    }
+    if (size > stats->largest_allocation) {
+        stats->largest_allocation = size;
+    }
+    libspdm_spin_lock_release(&stats->lock);
+}
+
+static void libspdm_malloc_stats_record_free(libspdm_malloc_stats_t *stats, uintn size)
+{
+    libspdm_spin_lock_acquire(&stats->lock);
+    assert((stats->live_count != 0) && (stats->live_bytes >= size));
+    stats->free_count++;
+    stats->live_count--;
+    stats->live_bytes -= size;
+    libspdm_spin_lock_release(&stats->lock);
+}
+#endif
+
+const libspdm_pool_allocator_t *libspdm_set_pool_allocator(
+    const libspdm_pool_allocator_t *allocator)
+{
+    const libspdm_pool_allocator_t *previous;
+
+    previous = m_libspdm_pool_allocator;
+    m_libspdm_pool_allocator = allocator;
+    return previous;
+}
+
 void *allocate_pool(uintn AllocationSize)
 {
-    return malloc(AllocationSize);
+    const libspdm_pool_allocator_t *allocator;
+    libspdm_pool_head_t *head;
+
+    if (AllocationSize > (uintn)-1 - sizeof(libspdm_pool_head_t)) {
+        return NULL;
+    }
+
+    allocator = m_libspdm_pool_allocator;
+    head = NULL;
+    if (allocator != NULL) {
+        head = allocator->allocate(allocator->context,
+                                   sizeof(libspdm_pool_head_t) + AllocationSize);
+    }
+    if (head == NULL) {
+        allocator = NULL;
+        head = malloc(sizeof(libspdm_pool_head_t) + AllocationSize);
+        if (head == NULL) {
+            return NULL;
+        }
+    }
+    head->allocator = allocator;
+    head->size = AllocationSize;
+#if LIBSPDM_MALLOCLIB_INSTRUMENTED
+    head->stats = m_libspdm_malloc_stats;
+    if (head->stats != NULL) {
+        libspdm_malloc_stats_record_allocate(head->stats, AllocationSize);
+    }
+#endif
+    return head + 1;
 }
 
 void *allocate_zero_pool(uintn AllocationSize)
 {
     void *buffer;
-    buffer = malloc(AllocationSize);
+    buffer = allocate_pool(AllocationSize);
     if (buffer == NULL) {
         return NULL;
     }
@@ -29,5 +131,126 @@ void *allocate_zero_pool(uintn AllocationSize)
 
 void free_pool(const void *buffer)
 {
-    free((void *)buffer);
+    libspdm_pool_head_t *head;
+
+    if (buffer == NULL) {
+        return;
+    }
+    head = (libspdm_pool_head_t *)buffer - 1;
+#if LIBSPDM_MALLOCLIB_INSTRUMENTED
+    if (head->stats != NULL) {
+        libspdm_malloc_stats_record_free(head->stats, head->size);
+    }
+#endif
+    if (head->allocator != NULL) {
+        head->allocator->free(head->allocator->context, head);
+    } else {
+        free(head);
+    }
+}
+
+static void *libspdm_arena_allocate(void *context, uintn size)
+{
+    libspdm_arena_t *arena;
+    void *block;
+
+    arena = context;
+    libspdm_spin_lock_acquire(&arena->lock);
+    block = NULL;
+    if ((size <= arena->size - arena->used) &&
+        (LIBSPDM_POOL_ALIGN(size) <= arena->size - arena->used)) {
+        block = arena->buffer + arena->used;
+        arena->used += LIBSPDM_POOL_ALIGN(size);
+        arena->live_count++;
+    }
+    libspdm_spin_lock_release(&arena->lock);
+    return block;
+}
+
+static void libspdm_arena_free(void *context, void *buffer)
+{
+    libspdm_arena_t *arena;
+
+    arena = context;
+    libspdm_spin_lock_acquire(&arena->lock);
+    assert(arena->live_count != 0);
+    arena->live_count--;
+    if (arena->live_count == 0) {
+        arena->used = 0;
+    }
+    libspdm_spin_lock_release(&arena->lock);
+}
+
+void libspdm_arena_init(libspdm_arena_t *arena, void *buffer, uintn size)
+{
+    uintn misalignment;
+
+    arena->allocator.allocate = libspdm_arena_allocate;
+    arena->allocator.free = libspdm_arena_free;
+    arena->allocator.context = arena;
+
+    misalignment = (LIBSPDM_POOL_ALIGNMENT - ((uintn)buffer & (LIBSPDM_POOL_ALIGNMENT - 1))) &
+                   (LIBSPDM_POOL_ALIGNMENT - 1);
+    if (size < misalignment) {
+        misalignment = size;
+    }
+    arena->buffer = (uint8_t *)buffer + misalignment;
+    arena->size = size - misalignment;
+    arena->used = 0;
+    arena->live_count = 0;
+    arena->lock = 0;
+}
+
+bool libspdm_arena_release(libspdm_arena_t *arena)
+{
+    bool result;
+
+    libspdm_spin_lock_acquire(&arena->lock);
+    result = (arena->live_count == 0);
+    if (result) {
+        arena->used = 0;
+    }
+    libspdm_spin_lock_release(&arena->lock);
+    return result;
+}
+
+bool libspdm_malloc_stats_is_enabled(void)
+{
+    return LIBSPDM_MALLOCLIB_INSTRUMENTED != 0;
+}
+
+libspdm_malloc_stats_t *libspdm_set_malloc_stats_scope(libspdm_malloc_stats_t *stats)
+{
+    libspdm_malloc_stats_t *previous;
+
+    previous = m_libspdm_malloc_stats;
+    m_libspdm_malloc_stats = stats;
+    return previous;
+}
+
+void libspdm_reset_malloc_stats(libspdm_malloc_stats_t *stats)
+{
+    libspdm_spin_lock_acquire(&stats->lock);
+    stats->allocation_count = 0;
+    stats->free_count = 0;
+    stats->allocated_bytes = 0;
+    stats->peak_live_count = stats->live_count;
+    stats->peak_live_bytes = stats->live_bytes;
+    stats->largest_allocation = 0;
+    libspdm_spin_lock_release(&stats->lock);
+}
+
+void libspdm_dump_malloc_stats(const char *name, const libspdm_malloc_stats_t *stats)
+{
+    printf("%-32s %8llu allocs %8llu frees %10llu bytes, live %llu (%llu bytes), "
+           "peak %llu (%llu bytes), largest %llu bytes\n",
+           name,
+           (unsigned long long)stats->allocation_count,
+           (unsigned long long)stats->free_count,
+           (unsigned long long)stats->allocated_bytes,
+           (unsigned long long)stats->live_count,
+           (unsigned long long)stats->live_bytes,
+           (unsigned long long)stats->peak_live_count,
+           (unsigned long long)stats->peak_live_bytes,
+           (unsigned long long)stats->largest_allocation);
 }
@@ -0,0 +1,231 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Word-wide and vector kernels of the optimized memlib.
+ *
+ * Buffers of at least one vector are handled with unaligned vectors at both ends and
+ * aligned vectors in between, so there is no byte loop for the head or the tail.
+ * Shorter buffers, and builds without vectors, use native words when both buffers have
+ * the same alignment, and bytes otherwise.
+ **/
+
+#include "memlib_kernel.h"
+
+#if defined(LIBSPDM_MEMLIB_AVX2)
+#include <immintrin.h>
+typedef __m256i libspdm_memlib_vector_t;
+#define libspdm_memlib_vector_load(p) _mm256_loadu_si256((const __m256i *)(const void *)(p))
+#define libspdm_memlib_vector_store(p, v) _mm256_storeu_si256((__m256i *)(void *)(p), (v))
+#define libspdm_memlib_vector_splat(b) _mm256_set1_epi8((char)(b))
+#define libspdm_memlib_vector_zero() _mm256_setzero_si256()
+#define libspdm_memlib_vector_xor(a, b) _mm256_xor_si256((a), (b))
+#define libspdm_memlib_vector_or(a, b) _mm256_or_si256((a), (b))
+#elif defined(LIBSPDM_MEMLIB_SSE2)
+#include <emmintrin.h>
+typedef __m128i libspdm_memlib_vector_t;
+#define libspdm_memlib_vector_load(p) _mm_loadu_si128((const __m128i *)(const void *)(p))
+#define libspdm_memlib_vector_store(p, v) _mm_storeu_si128((__m128i *)(void *)(p), (v))
+#define libspdm_memlib_vector_splat(b) _mm_set1_epi8((char)(b))
+#define libspdm_memlib_vector_zero() _mm_setzero_si128()
+#define libspdm_memlib_vector_xor(a, b) _mm_xor_si128((a), (b))
+#define libspdm_memlib_vector_or(a, b) _mm_or_si128((a), (b))
+#elif defined(LIBSPDM_MEMLIB_NEON)
+#include <arm_neon.h>
+typedef uint8x16_t libspdm_memlib_vector_t;
+#define libspdm_memlib_vector_load(p) vld1q_u8((const uint8_t *)(p))
+#define libspdm_memlib_vector_store(p, v) vst1q_u8((uint8_t *)(p), (v))
+#define libspdm_memlib_vector_splat(b) vdupq_n_u8((uint8_t)(b))
+#define libspdm_memlib_vector_zero() vdupq_n_u8(0)
+#define libspdm_memlib_vector_xor(a, b) veorq_u8((a), (b))
+#define libspdm_memlib_vector_or(a, b) vorrq_u8((a), (b))
+#endif
+
+#define LIBSPDM_MEMLIB_WORD_SIZE sizeof(uintn)
+
+#define LIBSPDM_MEMLIB_MISALIGNMENT(p, size) ((uintn)(p) & ((size) - 1))
+
+#if defined(LIBSPDM_MEMLIB_VECTOR_SIZE)
+static uint8_t libspdm_memlib_vector_fold(libspdm_memlib_vector_t vector)
+{
+    uint8_t lane[LIBSPDM_MEMLIB_VECTOR_SIZE];
+    uint8_t folded;
+    uintn index;
+
+    libspdm_memlib_vector_store(lane, vector);
+    folded = 0;
+    for (index = 0; index < LIBSPDM_MEMLIB_VECTOR_SIZE; index++) {
+        folded |= lane[index];
+    }
+    return folded;
+}
+#endif
+
+static uint8_t libspdm_memlib_word_fold(uintn word)
+{
+    uint8_t folded;
+    uintn index;
+
+    folded = 0;
+    for (index = 0; index < LIBSPDM_MEMLIB_WORD_SIZE; index++) {
+        folded |= (uint8_t)(word >> (index * 8));
+    }
+    return folded;
+}
+
+void libspdm_memlib_copy(uint8_t *dst, const uint8_t *src, uintn length)
+{
+    volatile uint8_t *dst_byte;
+    const volatile uint8_t *src_byte;
+    volatile uintn *dst_word;
+    const volatile uintn *src_word;
+#if defined(LIBSPDM_MEMLIB_VECTOR_SIZE)
+    libspdm_memlib_vector_t tail;
+    uintn offset;
+
+    if (length >= LIBSPDM_MEMLIB_VECTOR_SIZE) {
+        /* Both ends are loaded first, so that the unaligned stores of the head and of
+         * the tail may overlap the aligned stores in between.*/
+        tail = libspdm_memlib_vector_load(src + length - LIBSPDM_MEMLIB_VECTOR_SIZE);
+        libspdm_memlib_vector_store(dst, libspdm_memlib_vector_load(src));
+        offset = LIBSPDM_MEMLIB_VECTOR_SIZE -
+                 LIBSPDM_MEMLIB_MISALIGNMENT(dst, LIBSPDM_MEMLIB_VECTOR_SIZE);
+        while (offset + LIBSPDM_MEMLIB_VECTOR_SIZE <= length) {
+            libspdm_memlib_vector_store(dst + offset,
+                                        libspdm_memlib_vector_load(src + offset));
+            offset += LIBSPDM_MEMLIB_VECTOR_SIZE;
+            LIBSPDM_MEMLIB_BARRIER(dst);
+        }
+        libspdm_memlib_vector_store(dst + length - LIBSPDM_MEMLIB_VECTOR_SIZE, tail);
+        LIBSPDM_MEMLIB_BARRIER(dst);
+        return;
+    }
+#endif
+
+    dst_byte = dst;
+    src_byte = src;
+    if (LIBSPDM_MEMLIB_MISALIGNMENT(dst, LIBSPDM_MEMLIB_WORD_SIZE) ==
+        LIBSPDM_MEMLIB_MISALIGNMENT(src, LIBSPDM_MEMLIB_WORD_SIZE)) {
+        while (length != 0 &&
+               LIBSPDM_MEMLIB_MISALIGNMENT(dst_byte, LIBSPDM_MEMLIB_WORD_SIZE) != 0) {
+            *(dst_byte++) = *(src_byte++);
+            length--;
+        }
+        dst_word = (volatile uintn *)(volatile void *)dst_byte;
+        src_word = (const volatile uintn *)(const volatile void *)src_byte;
+        while (length >= LIBSPDM_MEMLIB_WORD_SIZE) {
+            *(dst_word++) = *(src_word++);
+            length -= LIBSPDM_MEMLIB_WORD_SIZE;
+        }
+        dst_byte = (volatile uint8_t *)dst_word;
+        src_byte = (const volatile uint8_t *)src_word;
+    }
+    while (length-- != 0) {
+        *(dst_byte++) = *(src_byte++);
+    }
+}
+
+void libspdm_memlib_fill(uint8_t *buffer, uintn length, uint8_t value)
+{
+    volatile uint8_t *byte;
+    volatile uintn *word;
+    uintn pattern;
+#if defined(LIBSPDM_MEMLIB_VECTOR_SIZE)
+    libspdm_memlib_vector_t vector;
+    uintn offset;
+
+    if (length >= LIBSPDM_MEMLIB_VECTOR_SIZE) {
+        vector = libspdm_memlib_vector_splat(value);
+        libspdm_memlib_vector_store(buffer, vector);
+        offset = LIBSPDM_MEMLIB_VECTOR_SIZE -
+                 LIBSPDM_MEMLIB_MISALIGNMENT(buffer, LIBSPDM_MEMLIB_VECTOR_SIZE);
+        while (offset + LIBSPDM_MEMLIB_VECTOR_SIZE <= length) {
+            libspdm_memlib_vector_store(buffer + offset, vector);
+            offset += LIBSPDM_MEMLIB_VECTOR_SIZE;
+            LIBSPDM_MEMLIB_BARRIER(buffer);
+        }
+        libspdm_memlib_vector_store(buffer + length - LIBSPDM_MEMLIB_VECTOR_SIZE, vector);
+        LIBSPDM_MEMLIB_BARRIER(buffer);
+        return;
+    }
+#endif
+
+    byte = buffer;
+    while (length != 0 && LIBSPDM_MEMLIB_MISALIGNMENT(byte, LIBSPDM_MEMLIB_WORD_SIZE) != 0) {
+        *(byte++) = value;
+        length--;
+    }
+    pattern = (uintn)value * ((uintn)-1 / 0xFF);
+    word = (volatile uintn *)(volatile void *)byte;
+    while (length >= LIBSPDM_MEMLIB_WORD_SIZE) {
+        *(word++) = pattern;
+        length -= LIBSPDM_MEMLIB_WORD_SIZE;
+    }
+    byte = (volatile uint8_t *)word;
+    while (length-- != 0) {
+        *(byte++) = value;
+    }
+}
+
+uint8_t libspdm_memlib_difference(const uint8_t *buffer1, const uint8_t *buffer2,
+                                  uintn length)
+{
+    const volatile uint8_t *byte1;
+    const volatile uint8_t *byte2;
+    const volatile uintn *word1;
+    const volatile uintn *word2;
+    uintn word_delta;
+    uint8_t delta;
+#if defined(LIBSPDM_MEMLIB_VECTOR_SIZE)
+    libspdm_memlib_vector_t vector_delta;
+    uintn offset;
+
+    if (length >= LIBSPDM_MEMLIB_VECTOR_SIZE) {
+        /* The last vector may overlap the previous one, comparing bytes twice does not
+         * change the accumulated difference.*/
+        vector_delta = libspdm_memlib_vector_zero();
+        for (offset = 0; offset + LIBSPDM_MEMLIB_VECTOR_SIZE <= length;
+             offset += LIBSPDM_MEMLIB_VECTOR_SIZE) {
+            vector_delta = libspdm_memlib_vector_or(
+                vector_delta,
+                libspdm_memlib_vector_xor(libspdm_memlib_vector_load(buffer1 + offset),
+                                          libspdm_memlib_vector_load(buffer2 + offset)));
+        }
+        offset = length - LIBSPDM_MEMLIB_VECTOR_SIZE;
+        vector_delta = libspdm_memlib_vector_or(
+            vector_delta,
+            libspdm_memlib_vector_xor(libspdm_memlib_vector_load(buffer1 + offset),
+                                      libspdm_memlib_vector_load(buffer2 + offset)));
+        return libspdm_memlib_vector_fold(vector_delta);
+    }
+#endif
+
+    byte1 = buffer1;
+    byte2 = buffer2;
+    delta = 0;
+    if (LIBSPDM_MEMLIB_MISALIGNMENT(buffer1, LIBSPDM_MEMLIB_WORD_SIZE) ==
+        LIBSPDM_MEMLIB_MISALIGNMENT(buffer2, LIBSPDM_MEMLIB_WORD_SIZE)) {
+        while (length != 0 &&
+               LIBSPDM_MEMLIB_MISALIGNMENT(byte1, LIBSPDM_MEMLIB_WORD_SIZE) != 0) {
+            delta |= *(byte1++) ^ *(byte2++);
+            length--;
+        }
+        word1 = (const volatile uintn *)(const volatile void *)byte1;
+        word2 = (const volatile uintn *)(const volatile void *)byte2;
+        word_delta = 0;
+        while (length >= LIBSPDM_MEMLIB_WORD_SIZE) {
+            word_delta |= *(word1++) ^ *(word2++);
+            length -= LIBSPDM_MEMLIB_WORD_SIZE;
+        }
+        delta |= libspdm_memlib_word_fold(word_delta);
+        byte1 = (const volatile uint8_t *)word1;
+        byte2 = (const volatile uint8_t *)word2;
+    }
+    while (length-- != 0) {
+        delta |= *(byte1++) ^ *(byte2++);
+    }
+    return delta;
+}
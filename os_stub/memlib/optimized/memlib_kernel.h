@@ -0,0 +1,81 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Word-wide and vector kernels of the optimized memlib.
+ *
+ * The kernels never call memcpy/memset, and the compiler is kept from turning them into
+ * such calls, because the intrinsic memcpy/memset of a freestanding build may be
+ * implemented with libspdm_copy_mem()/libspdm_set_mem().
+ *
+ * The vector width is chosen at build time from the compiler target:
+ * AVX2 (32 bytes), SSE2 or NEON (16 bytes). Without a vector unit, or with a compiler
+ * without a memory barrier, only the word-wide path is used.
+ **/
+
+#ifndef __MEMLIB_KERNEL_H__
+#define __MEMLIB_KERNEL_H__
+
+#include "base.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+/* The memory clobber keeps every store before the barrier, and the input keeps the
+ * buffer live, so neither the stores nor the loop can be elided or replaced.*/
+#define LIBSPDM_MEMLIB_BARRIER(buffer) __asm__ __volatile__ ("" : : "r"(buffer) : "memory")
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define LIBSPDM_MEMLIB_BARRIER(buffer) _ReadWriteBarrier()
+#endif
+
+#if defined(LIBSPDM_MEMLIB_BARRIER)
+#if defined(__AVX2__)
+#define LIBSPDM_MEMLIB_AVX2 1
+#define LIBSPDM_MEMLIB_VECTOR_SIZE 32
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define LIBSPDM_MEMLIB_SSE2 1
+#define LIBSPDM_MEMLIB_VECTOR_SIZE 16
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define LIBSPDM_MEMLIB_NEON 1
+#define LIBSPDM_MEMLIB_VECTOR_SIZE 16
+#endif
+#endif
+
+/* Name of the kernel variant, for diagnostics and benchmarks.*/
+#if defined(LIBSPDM_MEMLIB_AVX2)
+#define LIBSPDM_MEMLIB_KERNEL_NAME "avx2"
+#elif defined(LIBSPDM_MEMLIB_SSE2)
+#define LIBSPDM_MEMLIB_KERNEL_NAME "sse2"
+#elif defined(LIBSPDM_MEMLIB_NEON)
+#define LIBSPDM_MEMLIB_KERNEL_NAME "neon"
+#else
+#define LIBSPDM_MEMLIB_KERNEL_NAME "word"
+#endif
+
+/**
+ * Copy length bytes from src to dst. The buffers must not overlap.
+ **/
+void libspdm_memlib_copy(uint8_t *dst, const uint8_t *src, uintn length);
+
+/**
+ * Fill length bytes of buffer with value.
+ *
+ * Every byte is written, even if buffer is never read again.
+ **/
+void libspdm_memlib_fill(uint8_t *buffer, uintn length, uint8_t value);
+
+/**
+ * Compare length bytes of buffer1 and buffer2.
+ *
+ * The time only depends on length and on the alignment of the buffers, never on
+ * their content.
+ *
+ * @return 0 if the buffers are identical, otherwise the bitwise OR of all differences,
+ *         folded to one non-zero byte.
+ **/
+uint8_t libspdm_memlib_difference(const uint8_t *buffer1, const uint8_t *buffer2,
+                                  uintn length);
+
+#endif
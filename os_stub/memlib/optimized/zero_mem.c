@@ -0,0 +1,35 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * libspdm_zero_mem() implementation with word-wide and vector kernels.
+ **/
+
+#include "base.h"
+#include "memlib_kernel.h"
+
+/**
+ * Fills a target buffer with zeros, and returns the target buffer.
+ *
+ * This function fills length bytes of buffer with zeros, and returns buffer.
+ * The stores are never elided by the compiler, so it may clear secrets that are not
+ * read again.
+ *
+ * If length > 0 and buffer is NULL, then LIBSPDM_ASSERT().
+ * If length is greater than (MAX_ADDRESS - buffer + 1), then LIBSPDM_ASSERT().
+ *
+ * @param  buffer      The pointer to the target buffer to fill with zeros.
+ * @param  length      The number of bytes in buffer to fill with zeros.
+ *
+ * @return buffer.
+ *
+ **/
+void *libspdm_zero_mem(void *buffer, uintn length)
+{
+    libspdm_memlib_fill((uint8_t *)buffer, length, 0);
+
+    return buffer;
+}
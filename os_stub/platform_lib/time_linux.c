@@ -4,10 +4,13 @@
  * License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
  **/
 
+#define _POSIX_C_SOURCE 200112L
+
 #include <base.h>
 #include <stdlib.h>
 #include <sys/time.h>
 #include <errno.h>
+#include <time.h>
 
 /**
  * Suspends the execution of the current thread until the time-out interval elapses.
@@ -27,3 +30,17 @@ void libspdm_sleep(uint64_t milliseconds)
         err=select(0, NULL, NULL, NULL, &tv);
     } while(err<0 && errno==EINTR);
 }
+
+/**
+ * Returns a monotonic time stamp, for measuring elapsed time.
+ *
+ * @return the time stamp, in nanoseconds since an unspecified starting point.
+ *
+ **/
+uint64_t libspdm_get_time_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
@@ -19,3 +19,19 @@ void libspdm_sleep(uint64_t milliseconds)
 {
     Sleep((DWORD)milliseconds);
 }
+
+/**
+ * Returns a monotonic time stamp, for measuring elapsed time.
+ *
+ * @return the time stamp, in nanoseconds since an unspecified starting point.
+ *
+ **/
+uint64_t libspdm_get_time_ns(void)
+{
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+}
@@ -4,12 +4,14 @@
  *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
  **/
 
+#define _DEFAULT_SOURCE
 #include <base.h>
 #include <stdlib.h>
 #include "stdio.h"
 #include <unistd.h>
 #include <fcntl.h>
 #include <assert.h>
+#include <sys/syscall.h>
 
 /**
  * Generates a 64-bit random number.
@@ -28,6 +30,14 @@ bool libspdm_get_random_number_64(uint64_t *rand_data)
 
     assert(rand_data != NULL);
 
+#if defined(SYS_getrandom)
+    /* getrandom() needs no file descriptor, so concurrent callers do not contend in open().
+     * Fall back to /dev/urandom if the kernel does not support it.*/
+    if (syscall(SYS_getrandom, rand_data, sizeof(*rand_data), 0) == sizeof(*rand_data)) {
+        return true;
+    }
+#endif
+
     fd = open("/dev/urandom", O_RDONLY);
     if (fd < 0) {
         printf("cannot open /dev/urandom\n");
@@ -40,6 +40,16 @@ return_status libspdm_measurement_collection(
     return RETURN_UNSUPPORTED;
 }
 
+/**
+ * Return the generation of the device measurements.
+ *
+ * @return 0, the device does not track measurement changes.
+ **/
+uint32_t libspdm_measurement_get_generation(void)
+{
+    return 0;
+}
+
 /**
  * This function calculates the measurement summary hash.
  *
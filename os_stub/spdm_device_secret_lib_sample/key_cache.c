@@ -0,0 +1,302 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Private key cache for the sample device secret library.
+ *
+ * Each (role, asym algorithm) key is read from storage and parsed into a
+ * crypto backend context once per concurrent signer. The contexts stay resident
+ * until they are explicitly invalidated or reloaded, so signing no longer pays
+ * for file I/O and PEM/ASN.1 parsing on every call, and concurrent signers of
+ * the same key do not wait for each other.
+ **/
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+#undef NULL
+#include <base.h>
+#include "library/memlib.h"
+#include "spdm_device_secret_lib_internal.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+typedef SRWLOCK libspdm_key_cache_lock_t;
+#define LIBSPDM_KEY_CACHE_LOCK_INIT SRWLOCK_INIT
+#define libspdm_key_cache_lock(lock) AcquireSRWLockExclusive(lock)
+#define libspdm_key_cache_unlock(lock) ReleaseSRWLockExclusive(lock)
+#else
+#include <pthread.h>
+typedef pthread_mutex_t libspdm_key_cache_lock_t;
+#define LIBSPDM_KEY_CACHE_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+#define libspdm_key_cache_lock(lock) pthread_mutex_lock(lock)
+#define libspdm_key_cache_unlock(lock) pthread_mutex_unlock(lock)
+#endif
+
+/* One slot per SPDM_ALGORITHMS_BASE_ASYM_ALGO_* bit (BIT0 ~ BIT11). */
+#define LIBSPDM_KEY_CACHE_SLOT_COUNT 12
+
+/* Idle contexts kept per key, the concurrent signers beyond it parse their own context. */
+#define LIBSPDM_KEY_CACHE_MAX_IDLE_CONTEXT_COUNT 16
+
+/* A crypto backend context is not safe for concurrent signers, e.g. the RSA blinding state,
+ * so every signer takes a context of its own out of the entry. The lock only covers the
+ * idle list, never a signature. */
+typedef struct {
+    libspdm_key_cache_lock_t lock;
+    /* bumped on invalidation, the contexts of older generations are freed on release */
+    uint32_t generation;
+    uintn idle_count;
+    void *idle_context[LIBSPDM_KEY_CACHE_MAX_IDLE_CONTEXT_COUNT];
+} libspdm_key_cache_entry_t;
+
+#define LIBSPDM_KEY_CACHE_ENTRY_INIT { LIBSPDM_KEY_CACHE_LOCK_INIT, 0, 0, { NULL } }
+
+static libspdm_key_cache_entry_t m_libspdm_key_cache[2][LIBSPDM_KEY_CACHE_SLOT_COUNT] = {
+    {
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+    },
+    {
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+        LIBSPDM_KEY_CACHE_ENTRY_INIT, LIBSPDM_KEY_CACHE_ENTRY_INIT,
+    },
+};
+
+/**
+ * Return the cache entry for a role and a single asym algorithm bit.
+ *
+ * @return the cache entry, or NULL if asym_algo is not a single supported bit.
+ **/
+static libspdm_key_cache_entry_t *libspdm_get_key_cache_entry(bool is_requester,
+                                                              uint32_t asym_algo)
+{
+    uintn index;
+
+    for (index = 0; index < LIBSPDM_KEY_CACHE_SLOT_COUNT; index++) {
+        if (asym_algo == ((uint32_t)1 << index)) {
+            return &m_libspdm_key_cache[is_requester ? 1 : 0][index];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Read the private key from storage and parse it into a new asym context.
+ **/
+static bool libspdm_load_private_key(bool is_requester, uint32_t asym_algo,
+                                     void **context)
+{
+    void *private_pem;
+    uintn private_pem_size;
+    bool result;
+
+    if (is_requester) {
+        result = libspdm_read_requester_private_certificate(
+            (uint16_t)asym_algo, &private_pem, &private_pem_size);
+    } else {
+        result = libspdm_read_responder_private_certificate(
+            asym_algo, &private_pem, &private_pem_size);
+    }
+    if (!result) {
+        return false;
+    }
+
+    if (is_requester) {
+        result = libspdm_req_asym_get_private_key_from_pem(
+            (uint16_t)asym_algo, private_pem, private_pem_size, NULL, context);
+    } else {
+        result = libspdm_asym_get_private_key_from_pem(
+            asym_algo, private_pem, private_pem_size, NULL, context);
+    }
+    libspdm_zero_mem(private_pem, private_pem_size);
+    free(private_pem);
+
+    return result;
+}
+
+static void libspdm_free_private_key(bool is_requester, uint32_t asym_algo,
+                                     void *context)
+{
+    if (is_requester) {
+        libspdm_req_asym_free((uint16_t)asym_algo, context);
+    } else {
+        libspdm_asym_free(asym_algo, context);
+    }
+}
+
+/**
+ * Free the idle contexts of an entry, called with the entry locked.
+ **/
+static void libspdm_free_idle_private_keys(libspdm_key_cache_entry_t *entry,
+                                           bool is_requester, uint32_t asym_algo)
+{
+    while (entry->idle_count != 0) {
+        entry->idle_count--;
+        libspdm_free_private_key(is_requester, asym_algo,
+                                 entry->idle_context[entry->idle_count]);
+        entry->idle_context[entry->idle_count] = NULL;
+    }
+}
+
+/**
+ * Acquire a cached private key context for a role and an asym algorithm.
+ *
+ * The context is used by the caller alone until libspdm_release_private_key(), other
+ * signers of the same key get other contexts. A context is loaded and parsed only if no
+ * idle one is cached, so that happens once per concurrent signer.
+ *
+ * @param  is_requester   true for the requester key, false for the responder key.
+ * @param  asym_algo      SPDM base_asym_algo or req_base_asym_alg.
+ * @param  key            On output, the asym context and its generation. Must not be freed.
+ *
+ * @retval true   The key context is available.
+ * @retval false  The key cannot be loaded.
+ **/
+bool libspdm_acquire_private_key(bool is_requester, uint32_t asym_algo,
+                                 libspdm_private_key_t *key)
+{
+    libspdm_key_cache_entry_t *entry;
+
+    entry = libspdm_get_key_cache_entry(is_requester, asym_algo);
+    if (entry == NULL) {
+        return false;
+    }
+
+    libspdm_key_cache_lock(&entry->lock);
+    key->generation = entry->generation;
+    if (entry->idle_count != 0) {
+        entry->idle_count--;
+        key->context = entry->idle_context[entry->idle_count];
+        entry->idle_context[entry->idle_count] = NULL;
+        libspdm_key_cache_unlock(&entry->lock);
+        return true;
+    }
+    libspdm_key_cache_unlock(&entry->lock);
+
+    return libspdm_load_private_key(is_requester, asym_algo, &key->context);
+}
+
+/**
+ * Release a private key context acquired by libspdm_acquire_private_key().
+ *
+ * The context is cached for the next signer, unless the key was invalidated or reloaded
+ * since it was acquired.
+ *
+ * @param  is_requester   true for the requester key, false for the responder key.
+ * @param  asym_algo      SPDM base_asym_algo or req_base_asym_alg.
+ * @param  key            The key acquired by libspdm_acquire_private_key().
+ **/
+void libspdm_release_private_key(bool is_requester, uint32_t asym_algo,
+                                 libspdm_private_key_t *key)
+{
+    libspdm_key_cache_entry_t *entry;
+
+    entry = libspdm_get_key_cache_entry(is_requester, asym_algo);
+    LIBSPDM_ASSERT(entry != NULL);
+    if (entry == NULL) {
+        return;
+    }
+
+    libspdm_key_cache_lock(&entry->lock);
+    if ((key->generation == entry->generation) &&
+        (entry->idle_count < LIBSPDM_KEY_CACHE_MAX_IDLE_CONTEXT_COUNT)) {
+        entry->idle_context[entry->idle_count] = key->context;
+        entry->idle_count++;
+        key->context = NULL;
+    }
+    libspdm_key_cache_unlock(&entry->lock);
+
+    if (key->context != NULL) {
+        libspdm_free_private_key(is_requester, asym_algo, key->context);
+        key->context = NULL;
+    }
+}
+
+/**
+ * Drop a cached private key. The next signature reloads it from storage, the contexts
+ * in use are freed when they are released.
+ *
+ * @param  is_requester   true for the requester key, false for the responder key.
+ * @param  asym_algo      SPDM base_asym_algo or req_base_asym_alg.
+ **/
+void libspdm_invalidate_private_key(bool is_requester, uint32_t asym_algo)
+{
+    libspdm_key_cache_entry_t *entry;
+
+    entry = libspdm_get_key_cache_entry(is_requester, asym_algo);
+    if (entry == NULL) {
+        return;
+    }
+
+    libspdm_key_cache_lock(&entry->lock);
+    entry->generation++;
+    libspdm_free_idle_private_keys(entry, is_requester, asym_algo);
+    libspdm_key_cache_unlock(&entry->lock);
+}
+
+/**
+ * Drop all cached private keys of both roles.
+ **/
+void libspdm_invalidate_all_private_keys(void)
+{
+    uintn index;
+
+    for (index = 0; index < LIBSPDM_KEY_CACHE_SLOT_COUNT; index++) {
+        libspdm_invalidate_private_key(false, (uint32_t)1 << index);
+        libspdm_invalidate_private_key(true, (uint32_t)1 << index);
+    }
+}
+
+/**
+ * Reload a private key from storage, e.g. after key rotation.
+ *
+ * The new key is parsed before the cached one is replaced. If the new key
+ * cannot be loaded, the previously cached key (if any) is kept.
+ *
+ * @param  is_requester   true for the requester key, false for the responder key.
+ * @param  asym_algo      SPDM base_asym_algo or req_base_asym_alg.
+ *
+ * @retval true   The key is reloaded.
+ * @retval false  The key cannot be loaded.
+ **/
+bool libspdm_reload_private_key(bool is_requester, uint32_t asym_algo)
+{
+    libspdm_key_cache_entry_t *entry;
+    void *context;
+
+    entry = libspdm_get_key_cache_entry(is_requester, asym_algo);
+    if (entry == NULL) {
+        return false;
+    }
+
+    if (!libspdm_load_private_key(is_requester, asym_algo, &context)) {
+        return false;
+    }
+
+    libspdm_key_cache_lock(&entry->lock);
+    entry->generation++;
+    libspdm_free_idle_private_keys(entry, is_requester, asym_algo);
+    entry->idle_context[0] = context;
+    entry->idle_count = 1;
+    libspdm_key_cache_unlock(&entry->lock);
+
+    return true;
+}
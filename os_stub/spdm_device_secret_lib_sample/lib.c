@@ -22,6 +22,11 @@
 #include <base.h>
 #include "library/memlib.h"
 #include "spdm_device_secret_lib_internal.h"
+#include "internal_crypt_common.h"
+
+/* The generation is moved by the threads of several responder contexts.*/
+static uint32_t m_libspdm_measurement_generation = 1;
+static libspdm_spin_lock_t m_libspdm_measurement_generation_lock;
 
 bool libspdm_read_responder_private_certificate(uint32_t base_asym_algo,
                                                 void **data, uintn *size)
@@ -113,6 +118,34 @@ bool libspdm_read_requester_private_certificate(uint16_t req_base_asym_alg,
     return res;
 }
 
+/**
+ * Return if a measurement index is measured from an image file of the measurement provider.
+ *
+ * An image is too large for a raw bit stream block, its digest is returned even if
+ * the raw bit stream is requested.
+ **/
+static bool libspdm_use_measurement_image(uint32_t measurement_hash_algo,
+                                          uint8_t measurements_index)
+{
+    return (measurement_hash_algo != SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_RAW_BIT_STREAM_ONLY) &&
+           libspdm_measurement_provider_has_image(measurements_index);
+}
+
+/**
+ * Return the size of an image hash measurement block.
+ **/
+static uintn libspdm_get_measurement_image_hash_block_size(bool use_bit_stream,
+                                                           uint32_t measurement_hash_algo,
+                                                           uint8_t measurements_index)
+{
+    if (!use_bit_stream ||
+        libspdm_use_measurement_image(measurement_hash_algo, measurements_index)) {
+        return sizeof(spdm_measurement_block_dmtf_t) +
+               libspdm_get_measurement_hash_size(measurement_hash_algo);
+    }
+    return sizeof(spdm_measurement_block_dmtf_t) + LIBSPDM_MEASUREMENT_RAW_DATA_SIZE;
+}
+
 /**
  * Fill image hash measurement block.
  *
@@ -139,6 +172,28 @@ uintn libspdm_fill_measurement_image_hash_block (
 
     libspdm_set_mem(data, sizeof(data), (uint8_t)(measurements_index));
 
+    if (libspdm_use_measurement_image(measurement_hash_algo, measurements_index)) {
+        measurement_block->measurement_block_dmtf_header
+        .dmtf_spec_measurement_value_type =
+            (measurements_index - 1);
+        measurement_block->measurement_block_dmtf_header
+        .dmtf_spec_measurement_value_size =
+            (uint16_t)hash_size;
+
+        measurement_block->measurement_block_common_header
+        .measurement_size =
+            (uint16_t)(sizeof(spdm_measurement_block_dmtf_header_t) +
+                       (uint16_t)hash_size);
+
+        if (!libspdm_measurement_provider_get_digest(measurements_index,
+                                                     measurement_hash_algo,
+                                                     (void *)(measurement_block + 1))) {
+            return 0;
+        }
+
+        return sizeof(spdm_measurement_block_dmtf_t) + hash_size;
+    }
+
     if (!use_bit_stream) {
         measurement_block->measurement_block_dmtf_header
         .dmtf_spec_measurement_value_type =
@@ -391,14 +446,10 @@ return_status libspdm_measurement_collection(
         /* Calculate total_size_needed based on hash algo selected.
          * If we have an hash algo, then the first HASH_NUMBER elements will be
          * hash values, otherwise HASH_NUMBER raw bitstream values.*/
-        if (!use_bit_stream) {
-            total_size_needed =
-                LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER *
-                (sizeof(spdm_measurement_block_dmtf_t) + hash_size);
-        } else {
-            total_size_needed =
-                LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER *
-                (sizeof(spdm_measurement_block_dmtf_t) + LIBSPDM_MEASUREMENT_RAW_DATA_SIZE);
+        total_size_needed = 0;
+        for (index = 1; index <= LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER; index++) {
+            total_size_needed += libspdm_get_measurement_image_hash_block_size(
+                use_bit_stream, measurement_hash_algo, index);
         }
         /* Next one - SVN is always raw bitstream data.*/
         total_size_needed +=
@@ -420,6 +471,12 @@ return_status libspdm_measurement_collection(
         *measurements_count = LIBSPDM_MEASUREMENT_BLOCK_NUMBER;
         measurement_block = measurements;
 
+        /* hash the image files of all measurement blocks in parallel*/
+        if ((measurement_hash_algo != SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_RAW_BIT_STREAM_ONLY) &&
+            !libspdm_measurement_provider_prepare(measurement_hash_algo)) {
+            return RETURN_DEVICE_ERROR;
+        }
+
         /* The first HASH_NUMBER blocks may be hash values or raw bitstream*/
         for (index = 1; index <= LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER; index++) {
             measurement_block_size = libspdm_fill_measurement_image_hash_block (use_bit_stream,
@@ -451,15 +508,8 @@ return_status libspdm_measurement_collection(
     } else {
         /* One Index */
         if (measurements_index <= LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER) {
-            if (!use_bit_stream) {
-                total_size_needed =
-                    sizeof(spdm_measurement_block_dmtf_t) +
-                    hash_size;
-            } else {
-                total_size_needed =
-                    sizeof(spdm_measurement_block_dmtf_t) +
-                    LIBSPDM_MEASUREMENT_RAW_DATA_SIZE;
-            }
+            total_size_needed = libspdm_get_measurement_image_hash_block_size(
+                use_bit_stream, measurement_hash_algo, measurements_index);
             LIBSPDM_ASSERT(total_size_needed <= *measurements_size);
             if (total_size_needed > *measurements_size) {
                 return RETURN_BUFFER_TOO_SMALL;
@@ -548,6 +598,40 @@ return_status libspdm_measurement_collection(
     return RETURN_SUCCESS;
 }
 
+/**
+ * Return the generation of the device measurements.
+ *
+ * The generation moves when libspdm_measurement_update_generation() is called,
+ * or when an image file of the measurement provider changed.
+ *
+ * @return The measurement generation.
+ **/
+uint32_t libspdm_measurement_get_generation(void)
+{
+    uint32_t generation;
+
+    if (libspdm_measurement_provider_check_images()) {
+        libspdm_measurement_update_generation();
+    }
+    libspdm_spin_lock_acquire(&m_libspdm_measurement_generation_lock);
+    generation = m_libspdm_measurement_generation;
+    libspdm_spin_lock_release(&m_libspdm_measurement_generation_lock);
+    return generation;
+}
+
+/**
+ * Record a change of the device measurements, by moving to the next generation.
+ **/
+void libspdm_measurement_update_generation(void)
+{
+    libspdm_spin_lock_acquire(&m_libspdm_measurement_generation_lock);
+    m_libspdm_measurement_generation++;
+    if (m_libspdm_measurement_generation == 0) {
+        m_libspdm_measurement_generation = 1;
+    }
+    libspdm_spin_lock_release(&m_libspdm_measurement_generation_lock);
+}
+
 /**
  * This function calculates the measurement summary hash.
  *
@@ -713,35 +797,23 @@ bool libspdm_requester_data_sign(
     const uint8_t *message, uintn message_size,
     uint8_t *signature, uintn *sig_size)
 {
-    void *context;
-    void *private_pem;
-    uintn private_pem_size;
+    libspdm_private_key_t key;
     bool result;
 
-    result = libspdm_read_requester_private_certificate(
-        req_base_asym_alg, &private_pem, &private_pem_size);
-    if (!result) {
-        return false;
-    }
-
-    result = libspdm_req_asym_get_private_key_from_pem(req_base_asym_alg,
-                                                       private_pem,
-                                                       private_pem_size, NULL,
-                                                       &context);
+    result = libspdm_acquire_private_key(true, req_base_asym_alg, &key);
     if (!result) {
         return false;
     }
     if (is_data_hash) {
         result = libspdm_req_asym_sign_hash(spdm_version, op_code, req_base_asym_alg,
-                                            base_hash_algo, context,
+                                            base_hash_algo, key.context,
                                             message, message_size, signature, sig_size);
     } else {
         result = libspdm_req_asym_sign(spdm_version, op_code, req_base_asym_alg, base_hash_algo,
-                                       context,
+                                       key.context,
                                        message, message_size, signature, sig_size);
     }
-    libspdm_req_asym_free(req_base_asym_alg, context);
-    free(private_pem);
+    libspdm_release_private_key(true, req_base_asym_alg, &key);
 
     return result;
 }
@@ -767,38 +839,30 @@ bool libspdm_responder_data_sign(
     const uint8_t *message, uintn message_size,
     uint8_t *signature, uintn *sig_size)
 {
-    void *context;
-    void *private_pem;
-    uintn private_pem_size;
+    libspdm_private_key_t key;
     bool result;
 
-    result = libspdm_read_responder_private_certificate(
-        base_asym_algo, &private_pem, &private_pem_size);
-    if (!result) {
-        return false;
-    }
-
-    result = libspdm_asym_get_private_key_from_pem(
-        base_asym_algo, private_pem, private_pem_size, NULL, &context);
+    result = libspdm_acquire_private_key(false, base_asym_algo, &key);
     if (!result) {
         return false;
     }
     if (is_data_hash) {
         result = libspdm_asym_sign_hash(spdm_version, op_code, base_asym_algo, base_hash_algo,
-                                        context,
+                                        key.context,
                                         message, message_size, signature, sig_size);
     } else {
-        result = libspdm_asym_sign(spdm_version, op_code, base_asym_algo, base_hash_algo, context,
+        result = libspdm_asym_sign(spdm_version, op_code, base_asym_algo, base_hash_algo,
+                                   key.context,
                                    message, message_size, signature, sig_size);
     }
-    libspdm_asym_free(base_asym_algo, context);
-    free(private_pem);
+    libspdm_release_private_key(false, base_asym_algo, &key);
 
     return result;
 }
 
 uint8_t m_libspdm_my_zero_filled_buffer[64];
-uint8_t m_libspdm_bin_str0[0x11] = {
+/* The template of the bin_str0 label, copied by every caller, as the length differs per hash.*/
+const uint8_t m_libspdm_bin_str0[0x11] = {
     0x00, 0x00, /* length - to be filled*/
     0x73, 0x70, 0x64, 0x6d, 0x31, 0x2e, 0x31, 0x20, /* version: 'spdm1.1 '*/
     0x64, 0x65, 0x72, 0x69, 0x76, 0x65, 0x64, /* label: 'derived'*/
@@ -845,9 +909,6 @@ bool libspdm_psk_handshake_secret_hkdf_expand(
     } else {
         return false;
     }
-    printf("[PSK]: ");
-    libspdm_dump_hex_str(psk, psk_size);
-    printf("\n");
 
     hash_size = libspdm_get_hash_size(base_hash_algo);
 
@@ -894,6 +955,7 @@ bool libspdm_psk_master_secret_hkdf_expand(
     uint8_t handshake_secret[64];
     uint8_t salt1[64];
     uint8_t master_secret[64];
+    uint8_t bin_str0[sizeof(m_libspdm_bin_str0)];
 
     if ((psk_hint == NULL) && (psk_hint_size == 0)) {
         psk = LIBSPDM_TEST_PSK_DATA_STRING;
@@ -916,10 +978,10 @@ bool libspdm_psk_master_secret_hkdf_expand(
         return result;
     }
 
-    *(uint16_t *)m_libspdm_bin_str0 = (uint16_t)hash_size;
+    libspdm_copy_mem(bin_str0, sizeof(bin_str0), m_libspdm_bin_str0, sizeof(m_libspdm_bin_str0));
+    *(uint16_t *)bin_str0 = (uint16_t)hash_size;
     result = libspdm_hkdf_expand(base_hash_algo, handshake_secret, hash_size,
-                                 m_libspdm_bin_str0, sizeof(m_libspdm_bin_str0), salt1,
-                                 hash_size);
+                                 bin_str0, sizeof(bin_str0), salt1, hash_size);
     libspdm_zero_mem(handshake_secret, hash_size);
     if (!result) {
         return result;
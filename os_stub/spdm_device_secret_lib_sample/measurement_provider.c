@@ -0,0 +1,696 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Image file measurement provider for the sample device secret library.
+ *
+ * The firmware measurement indices (1 ~ LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER) may be
+ * backed by an image file instead of the built-in raw data. The measurement value is the
+ * plain digest of the whole file, as required by the DMTF measurement specification, so
+ * one image is always hashed as a single stream:
+ *  - the image is read and hashed chunk by chunk, with a read-ahead hint for the next
+ *    chunks, so the file I/O of the next chunk overlaps the hashing of the current one,
+ *  - libspdm_measurement_provider_prepare() hashes the images of one collection on
+ *    several threads, one image per thread at a time,
+ *  - the digests are cached per image and measurement hash algorithm, keyed by the file
+ *    identity (device, inode, size, modification time), so an unchanged image is hashed
+ *    once.
+ *
+ * A changed file identity also moves the measurement generation reported by
+ * libspdm_measurement_get_generation().
+ **/
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+
+#undef NULL
+#include <base.h>
+#include "library/memlib.h"
+#include "spdm_device_secret_lib_internal.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+typedef SRWLOCK libspdm_measurement_provider_lock_t;
+#define LIBSPDM_MEASUREMENT_PROVIDER_LOCK_INIT SRWLOCK_INIT
+#define libspdm_measurement_provider_lock(lock) AcquireSRWLockExclusive(lock)
+#define libspdm_measurement_provider_unlock(lock) ReleaseSRWLockExclusive(lock)
+#else
+typedef pthread_mutex_t libspdm_measurement_provider_lock_t;
+#define LIBSPDM_MEASUREMENT_PROVIDER_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+#define libspdm_measurement_provider_lock(lock) pthread_mutex_lock(lock)
+#define libspdm_measurement_provider_unlock(lock) pthread_mutex_unlock(lock)
+#endif
+
+/* One digest slot per SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_* bit (BIT0 ~ BIT7). */
+#define LIBSPDM_MEASUREMENT_PROVIDER_HASH_ALGO_COUNT 8
+
+typedef struct {
+    uint64_t device;
+    uint64_t inode;
+    uint64_t size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+} libspdm_measurement_image_id_t;
+
+typedef struct {
+    /* empty if the measurement index uses the built-in raw data*/
+    char file_name[LIBSPDM_MEASUREMENT_PROVIDER_MAX_PATH];
+    /* identity returned by the last libspdm_measurement_provider_check_images()*/
+    libspdm_measurement_image_id_t seen_id;
+    bool seen_id_valid;
+    /* identity of the cached digests*/
+    libspdm_measurement_image_id_t digest_id;
+    uint32_t digest_valid;
+    uint8_t digest[LIBSPDM_MEASUREMENT_PROVIDER_HASH_ALGO_COUNT][LIBSPDM_MAX_HASH_SIZE];
+} libspdm_measurement_image_t;
+
+typedef struct {
+    uintn thread_count;
+    uintn read_ahead_size;
+    uint64_t hit_count;
+    uint64_t miss_count;
+    uint64_t hashed_bytes;
+    libspdm_measurement_image_t image[LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER];
+} libspdm_measurement_provider_t;
+
+static libspdm_measurement_provider_lock_t m_libspdm_measurement_provider_lock =
+    LIBSPDM_MEASUREMENT_PROVIDER_LOCK_INIT;
+
+static libspdm_measurement_provider_t m_libspdm_measurement_provider = {
+    1, LIBSPDM_MEASUREMENT_PROVIDER_DEFAULT_READ_AHEAD_SIZE,
+};
+
+/* One image of libspdm_measurement_provider_prepare() to be hashed by a worker thread. */
+typedef struct {
+    uint8_t measurement_index;
+    char file_name[LIBSPDM_MEASUREMENT_PROVIDER_MAX_PATH];
+    libspdm_measurement_image_id_t id;
+} libspdm_measurement_provider_job_t;
+
+typedef struct {
+    uint32_t measurement_hash_algo;
+    uintn read_ahead_size;
+    uintn job_count;
+    uintn next_job;
+    bool result;
+    libspdm_measurement_provider_job_t job[LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER];
+} libspdm_measurement_provider_work_t;
+
+/**
+ * Return the base hash algorithm computing a measurement hash algorithm.
+ **/
+static uint32_t libspdm_measurement_provider_get_base_hash_algo(uint32_t measurement_hash_algo)
+{
+    switch (measurement_hash_algo) {
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_256:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_256;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_384:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_384;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA3_512:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA3_512;
+    case SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SM3_256:
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Return the digest slot of a measurement hash algorithm.
+ **/
+static uintn libspdm_measurement_provider_get_digest_slot(uint32_t measurement_hash_algo)
+{
+    uintn slot;
+
+    for (slot = 0; slot < LIBSPDM_MEASUREMENT_PROVIDER_HASH_ALGO_COUNT; slot++) {
+        if ((measurement_hash_algo & (1u << slot)) != 0) {
+            break;
+        }
+    }
+    return slot;
+}
+
+/**
+ * Read the identity of an image file.
+ **/
+static bool libspdm_measurement_provider_get_image_id(const char *file_name,
+                                                      libspdm_measurement_image_id_t *id)
+{
+#if defined(_WIN32)
+    struct _stat64 file_stat;
+
+    if (_stat64(file_name, &file_stat) != 0) {
+        return false;
+    }
+    id->mtime_nsec = 0;
+#else
+    struct stat file_stat;
+
+    if (stat(file_name, &file_stat) != 0) {
+        return false;
+    }
+    id->mtime_nsec = (int64_t)file_stat.st_mtim.tv_nsec;
+#endif
+    id->device = (uint64_t)file_stat.st_dev;
+    id->inode = (uint64_t)file_stat.st_ino;
+    id->size = (uint64_t)file_stat.st_size;
+    id->mtime_sec = (int64_t)file_stat.st_mtime;
+    return true;
+}
+
+static bool libspdm_measurement_provider_is_same_image(const libspdm_measurement_image_id_t *id1,
+                                                       const libspdm_measurement_image_id_t *id2)
+{
+    return (id1->device == id2->device) && (id1->inode == id2->inode) &&
+           (id1->size == id2->size) && (id1->mtime_sec == id2->mtime_sec) &&
+           (id1->mtime_nsec == id2->mtime_nsec);
+}
+
+/**
+ * Hash a whole image file as one stream.
+ *
+ * @param  file_name               The image file.
+ * @param  measurement_hash_algo   The measurement hash algorithm.
+ * @param  read_ahead_size         The size in bytes to prefetch ahead of the hashed chunk.
+ * @param  digest                  The buffer receiving the digest.
+ * @param  image_size              The number of hashed bytes.
+ *
+ * @retval true   the image is hashed.
+ * @retval false  the image cannot be read or hashed.
+ **/
+static bool libspdm_measurement_provider_hash_image(const char *file_name,
+                                                    uint32_t measurement_hash_algo,
+                                                    uintn read_ahead_size,
+                                                    uint8_t *digest,
+                                                    uint64_t *image_size)
+{
+    libspdm_hash_state_t state;
+    bool result;
+#if defined(_WIN32)
+    FILE *fp_in;
+    uint8_t *buffer;
+    size_t read_size;
+
+    *image_size = 0;
+    fp_in = fopen(file_name, "rb");
+    if (fp_in == NULL) {
+        return false;
+    }
+    buffer = malloc(LIBSPDM_MEASUREMENT_PROVIDER_CHUNK_SIZE);
+    if (buffer == NULL) {
+        fclose(fp_in);
+        return false;
+    }
+    /* stdio buffering is the read-ahead here*/
+    setvbuf(fp_in, NULL, _IOFBF, read_ahead_size == 0 ? BUFSIZ : read_ahead_size);
+    result = libspdm_hash_state_init(
+        libspdm_measurement_provider_get_base_hash_algo(measurement_hash_algo), &state);
+    while (result) {
+        read_size = fread(buffer, 1, LIBSPDM_MEASUREMENT_PROVIDER_CHUNK_SIZE, fp_in);
+        if (read_size == 0) {
+            result = (ferror(fp_in) == 0);
+            break;
+        }
+        result = libspdm_hash_state_update(&state, buffer, read_size);
+        *image_size += read_size;
+    }
+    free(buffer);
+    fclose(fp_in);
+#else
+    int fd;
+    uint8_t *buffer;
+    uint64_t offset;
+    ssize_t read_size;
+
+    *image_size = 0;
+    fd = open(file_name, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    buffer = malloc(LIBSPDM_MEASUREMENT_PROVIDER_CHUNK_SIZE);
+    if (buffer == NULL) {
+        close(fd);
+        return false;
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    /* The image is read, not mapped: a file truncated while it is hashed ends the stream
+     * early instead of faulting on the pages past the new end of file.*/
+    result = libspdm_hash_state_init(
+        libspdm_measurement_provider_get_base_hash_algo(measurement_hash_algo), &state);
+    offset = 0;
+    while (result) {
+        /* let the kernel read the next chunks while this one is hashed*/
+        if (read_ahead_size != 0) {
+            posix_fadvise(fd, (off_t)(offset + LIBSPDM_MEASUREMENT_PROVIDER_CHUNK_SIZE),
+                          (off_t)read_ahead_size, POSIX_FADV_WILLNEED);
+        }
+        read_size = pread(fd, buffer, LIBSPDM_MEASUREMENT_PROVIDER_CHUNK_SIZE, (off_t)offset);
+        if (read_size < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            result = false;
+            break;
+        }
+        if (read_size == 0) {
+            break;
+        }
+        result = libspdm_hash_state_update(&state, buffer, (uintn)read_size);
+        offset += (uint64_t)read_size;
+    }
+    free(buffer);
+    close(fd);
+    *image_size = offset;
+#endif
+
+    if (!result) {
+        libspdm_hash_state_free(&state);
+        return false;
+    }
+    return libspdm_hash_state_final(&state, digest);
+}
+
+/**
+ * Store one digest in the cache, unless the image was replaced or resized meanwhile.
+ **/
+static void libspdm_measurement_provider_store_digest(uint8_t measurement_index,
+                                                      const char *file_name,
+                                                      const libspdm_measurement_image_id_t *id,
+                                                      uint32_t measurement_hash_algo,
+                                                      const uint8_t *digest,
+                                                      uint64_t image_size)
+{
+    libspdm_measurement_image_t *image;
+    uintn slot;
+
+    slot = libspdm_measurement_provider_get_digest_slot(measurement_hash_algo);
+    libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+    image = &m_libspdm_measurement_provider.image[measurement_index - 1];
+    m_libspdm_measurement_provider.hashed_bytes += image_size;
+    if ((strcmp(image->file_name, file_name) == 0) && (image_size == id->size)) {
+        if ((image->digest_valid == 0) ||
+            !libspdm_measurement_provider_is_same_image(&image->digest_id, id)) {
+            image->digest_id = *id;
+            image->digest_valid = 0;
+        }
+        libspdm_copy_mem(image->digest[slot], sizeof(image->digest[slot]),
+                         digest, libspdm_get_measurement_hash_size(measurement_hash_algo));
+        image->digest_valid |= (1u << slot);
+    }
+    libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+}
+
+/**
+ * Worker of libspdm_measurement_provider_prepare(), hashes images until all jobs are taken.
+ **/
+static void libspdm_measurement_provider_worker(libspdm_measurement_provider_work_t *work)
+{
+    libspdm_measurement_provider_job_t *job;
+    uint8_t digest[LIBSPDM_MAX_HASH_SIZE];
+    uint64_t image_size;
+
+    for (;;) {
+        libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+        job = NULL;
+        if (work->next_job < work->job_count) {
+            job = &work->job[work->next_job];
+            work->next_job++;
+        }
+        libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+        if (job == NULL) {
+            return;
+        }
+
+        if (libspdm_measurement_provider_hash_image(job->file_name,
+                                                    work->measurement_hash_algo,
+                                                    work->read_ahead_size,
+                                                    digest, &image_size)) {
+            libspdm_measurement_provider_store_digest(job->measurement_index, job->file_name,
+                                                      &job->id, work->measurement_hash_algo,
+                                                      digest, image_size);
+        } else {
+            libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+            work->result = false;
+            libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+        }
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI libspdm_measurement_provider_thread(LPVOID parameter)
+{
+    libspdm_measurement_provider_worker(parameter);
+    return 0;
+}
+#else
+static void *libspdm_measurement_provider_thread(void *parameter)
+{
+    libspdm_measurement_provider_worker(parameter);
+    return NULL;
+}
+#endif
+
+/**
+ * Back a measurement index with an image file.
+ *
+ * The cached digests of the index are dropped and the measurement generation moves.
+ *
+ * @param  measurement_index   The measurement index, 1 ~ LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER.
+ * @param  file_name           The image file. NULL restores the built-in raw data.
+ *
+ * @retval true   the measurement index is configured.
+ * @retval false  the measurement index is not an image index, or the file name is too long.
+ **/
+bool libspdm_measurement_provider_set_image(uint8_t measurement_index, const char *file_name)
+{
+    libspdm_measurement_image_t *image;
+
+    if ((measurement_index == 0) ||
+        (measurement_index > LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER)) {
+        return false;
+    }
+    if ((file_name != NULL) && (strlen(file_name) >= LIBSPDM_MEASUREMENT_PROVIDER_MAX_PATH)) {
+        return false;
+    }
+
+    libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+    image = &m_libspdm_measurement_provider.image[measurement_index - 1];
+    libspdm_zero_mem(image, sizeof(libspdm_measurement_image_t));
+    if (file_name != NULL) {
+        libspdm_copy_mem(image->file_name, sizeof(image->file_name),
+                         file_name, strlen(file_name) + 1);
+    }
+    libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+
+    libspdm_measurement_update_generation();
+    return true;
+}
+
+/**
+ * Return if a measurement index is backed by an image file.
+ **/
+bool libspdm_measurement_provider_has_image(uint8_t measurement_index)
+{
+    bool has_image;
+
+    if ((measurement_index == 0) ||
+        (measurement_index > LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER)) {
+        return false;
+    }
+    libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+    has_image = (m_libspdm_measurement_provider.image[measurement_index - 1].file_name[0] != 0);
+    libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+    return has_image;
+}
+
+/**
+ * Configure how the images are hashed.
+ *
+ * @param  thread_count      The maximum number of images hashed in parallel,
+ *                           1 ~ LIBSPDM_MEASUREMENT_PROVIDER_MAX_THREAD_COUNT.
+ * @param  read_ahead_size   The size in bytes prefetched ahead of the hashed chunk, 0 to disable.
+ *
+ * @retval true   the provider is configured.
+ * @retval false  thread_count is out of range.
+ **/
+bool libspdm_measurement_provider_configure(uintn thread_count, uintn read_ahead_size)
+{
+    if ((thread_count == 0) || (thread_count > LIBSPDM_MEASUREMENT_PROVIDER_MAX_THREAD_COUNT)) {
+        return false;
+    }
+    libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+    m_libspdm_measurement_provider.thread_count = thread_count;
+    m_libspdm_measurement_provider.read_ahead_size = read_ahead_size;
+    libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+    return true;
+}
+
+/**
+ * Hash all images whose digest of the measurement hash algorithm is not cached, in parallel.
+ *
+ * @param  measurement_hash_algo   The measurement hash algorithm.
+ *
+ * @retval true   all image digests are cached.
+ * @retval false  an image cannot be read or hashed.
+ **/
+bool libspdm_measurement_provider_prepare(uint32_t measurement_hash_algo)
+{
+    libspdm_measurement_provider_work_t work;
+    libspdm_measurement_image_t *image;
+    libspdm_measurement_image_id_t id;
+    uintn thread_count;
+    uintn index;
+    uintn slot;
+#if defined(_WIN32)
+    HANDLE thread[LIBSPDM_MEASUREMENT_PROVIDER_MAX_THREAD_COUNT];
+#else
+    pthread_t thread[LIBSPDM_MEASUREMENT_PROVIDER_MAX_THREAD_COUNT];
+#endif
+    uintn started_count;
+
+    if (libspdm_measurement_provider_get_base_hash_algo(measurement_hash_algo) == 0) {
+        return false;
+    }
+    slot = libspdm_measurement_provider_get_digest_slot(measurement_hash_algo);
+
+    thread_count = 1;
+    libspdm_zero_mem(&work, sizeof(work));
+    work.measurement_hash_algo = measurement_hash_algo;
+    work.result = true;
+    for (index = 0; index < LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER; index++) {
+        libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+        image = &m_libspdm_measurement_provider.image[index];
+        if (image->file_name[0] == 0) {
+            libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+            continue;
+        }
+        libspdm_copy_mem(work.job[work.job_count].file_name,
+                         sizeof(work.job[work.job_count].file_name),
+                         image->file_name, sizeof(image->file_name));
+        libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+
+        if (!libspdm_measurement_provider_get_image_id(work.job[work.job_count].file_name,
+                                                       &id)) {
+            return false;
+        }
+
+        libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+        if (((image->digest_valid & (1u << slot)) != 0) &&
+            libspdm_measurement_provider_is_same_image(&image->digest_id, &id)) {
+            m_libspdm_measurement_provider.hit_count++;
+        } else {
+            m_libspdm_measurement_provider.miss_count++;
+            work.job[work.job_count].measurement_index = (uint8_t)(index + 1);
+            work.job[work.job_count].id = id;
+            work.job_count++;
+        }
+        thread_count = m_libspdm_measurement_provider.thread_count;
+        work.read_ahead_size = m_libspdm_measurement_provider.read_ahead_size;
+        libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+    }
+    if (work.job_count == 0) {
+        return true;
+    }
+
+    thread_count = MIN(thread_count, work.job_count);
+    started_count = 0;
+    for (index = 1; index < thread_count; index++) {
+#if defined(_WIN32)
+        thread[started_count] = CreateThread(NULL, 0, libspdm_measurement_provider_thread,
+                                             &work, 0, NULL);
+        if (thread[started_count] == NULL) {
+            break;
+        }
+#else
+        if (pthread_create(&thread[started_count], NULL,
+                           libspdm_measurement_provider_thread, &work) != 0) {
+            break;
+        }
+#endif
+        started_count++;
+    }
+    /* the calling thread is one of the workers*/
+    libspdm_measurement_provider_worker(&work);
+    for (index = 0; index < started_count; index++) {
+#if defined(_WIN32)
+        WaitForSingleObject(thread[index], INFINITE);
+        CloseHandle(thread[index]);
+#else
+        pthread_join(thread[index], NULL);
+#endif
+    }
+
+    return work.result;
+}
+
+/**
+ * Get the digest of the image backing a measurement index.
+ *
+ * The digest is hashed on a cache miss.
+ *
+ * @param  measurement_index       The measurement index.
+ * @param  measurement_hash_algo   The measurement hash algorithm.
+ * @param  digest                  The buffer receiving the digest.
+ *
+ * @retval true   the digest is returned.
+ * @retval false  the index has no image, or the image cannot be read or hashed.
+ **/
+bool libspdm_measurement_provider_get_digest(uint8_t measurement_index,
+                                             uint32_t measurement_hash_algo,
+                                             uint8_t *digest)
+{
+    libspdm_measurement_image_t *image;
+    libspdm_measurement_image_id_t id;
+    char file_name[LIBSPDM_MEASUREMENT_PROVIDER_MAX_PATH];
+    uintn read_ahead_size;
+    uint64_t image_size;
+    uintn slot;
+
+    if ((measurement_index == 0) ||
+        (measurement_index > LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER) ||
+        (libspdm_measurement_provider_get_base_hash_algo(measurement_hash_algo) == 0)) {
+        return false;
+    }
+    slot = libspdm_measurement_provider_get_digest_slot(measurement_hash_algo);
+
+    libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+    image = &m_libspdm_measurement_provider.image[measurement_index - 1];
+    libspdm_copy_mem(file_name, sizeof(file_name), image->file_name, sizeof(image->file_name));
+    read_ahead_size = m_libspdm_measurement_provider.read_ahead_size;
+    libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+    if (file_name[0] == 0) {
+        return false;
+    }
+    if (!libspdm_measurement_provider_get_image_id(file_name, &id)) {
+        return false;
+    }
+
+    libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+    if ((strcmp(image->file_name, file_name) == 0) &&
+        ((image->digest_valid & (1u << slot)) != 0) &&
+        libspdm_measurement_provider_is_same_image(&image->digest_id, &id)) {
+        libspdm_copy_mem(digest, libspdm_get_measurement_hash_size(measurement_hash_algo),
+                         image->digest[slot],
+                         libspdm_get_measurement_hash_size(measurement_hash_algo));
+        m_libspdm_measurement_provider.hit_count++;
+        libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+        return true;
+    }
+    m_libspdm_measurement_provider.miss_count++;
+    libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+
+    if (!libspdm_measurement_provider_hash_image(file_name, measurement_hash_algo,
+                                                 read_ahead_size, digest, &image_size)) {
+        return false;
+    }
+    libspdm_measurement_provider_store_digest(measurement_index, file_name, &id,
+                                              measurement_hash_algo, digest, image_size);
+    return true;
+}
+
+/**
+ * Check the identity of all image files.
+ *
+ * @retval true   an image file changed since the previous check.
+ * @retval false  no image file changed.
+ **/
+bool libspdm_measurement_provider_check_images(void)
+{
+    libspdm_measurement_image_t *image;
+    libspdm_measurement_image_id_t id;
+    char file_name[LIBSPDM_MEASUREMENT_PROVIDER_MAX_PATH];
+    bool id_valid;
+    bool changed;
+    uintn index;
+
+    changed = false;
+    for (index = 0; index < LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER; index++) {
+        libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+        image = &m_libspdm_measurement_provider.image[index];
+        libspdm_copy_mem(file_name, sizeof(file_name),
+                         image->file_name, sizeof(image->file_name));
+        libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+        if (file_name[0] == 0) {
+            continue;
+        }
+
+        id_valid = libspdm_measurement_provider_get_image_id(file_name, &id);
+
+        libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+        if (strcmp(image->file_name, file_name) == 0) {
+            if ((id_valid != image->seen_id_valid) ||
+                (id_valid && !libspdm_measurement_provider_is_same_image(&image->seen_id,
+                                                                         &id))) {
+                changed = true;
+            }
+            image->seen_id = id;
+            image->seen_id_valid = id_valid;
+        }
+        libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+    }
+    return changed;
+}
+
+/**
+ * Drop all cached image digests. The statistics are kept.
+ **/
+void libspdm_measurement_provider_flush(void)
+{
+    uintn index;
+
+    libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+    for (index = 0; index < LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER; index++) {
+        m_libspdm_measurement_provider.image[index].digest_valid = 0;
+    }
+    libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+}
+
+/**
+ * Get the statistics of the image digest cache.
+ *
+ * @param[out]  hit_count      Number of image digests served from the cache. Optional, may be NULL.
+ * @param[out]  miss_count     Number of image digests that were hashed. Optional, may be NULL.
+ * @param[out]  hashed_bytes   Number of hashed image bytes. Optional, may be NULL.
+ **/
+void libspdm_measurement_provider_get_statistics(uint64_t *hit_count, uint64_t *miss_count,
+                                                 uint64_t *hashed_bytes)
+{
+    libspdm_measurement_provider_lock(&m_libspdm_measurement_provider_lock);
+    if (hit_count != NULL) {
+        *hit_count = m_libspdm_measurement_provider.hit_count;
+    }
+    if (miss_count != NULL) {
+        *miss_count = m_libspdm_measurement_provider.miss_count;
+    }
+    if (hashed_bytes != NULL) {
+        *hashed_bytes = m_libspdm_measurement_provider.hashed_bytes;
+    }
+    libspdm_measurement_provider_unlock(&m_libspdm_measurement_provider_lock);
+}
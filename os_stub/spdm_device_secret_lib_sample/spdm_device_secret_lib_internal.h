@@ -64,6 +64,66 @@ bool libspdm_read_responder_root_public_certificate_by_size(
     uintn *hash_size);
 
 
+/* private key*/
+
+bool libspdm_read_responder_private_certificate(uint32_t base_asym_algo,
+                                                void **data, uintn *size);
+
+bool libspdm_read_requester_private_certificate(uint16_t req_base_asym_alg,
+                                                void **data, uintn *size);
+
+
+/* private key cache*/
+
+/* A private key context acquired from the cache, for one signer*/
+typedef struct {
+    void *context;
+    uint32_t generation;
+} libspdm_private_key_t;
+
+bool libspdm_acquire_private_key(bool is_requester, uint32_t asym_algo,
+                                 libspdm_private_key_t *key);
+
+void libspdm_release_private_key(bool is_requester, uint32_t asym_algo,
+                                 libspdm_private_key_t *key);
+
+void libspdm_invalidate_private_key(bool is_requester, uint32_t asym_algo);
+
+void libspdm_invalidate_all_private_keys(void);
+
+bool libspdm_reload_private_key(bool is_requester, uint32_t asym_algo);
+
+
+/* measurement*/
+
+void libspdm_measurement_update_generation(void);
+
+/* measurement image provider*/
+
+#define LIBSPDM_MEASUREMENT_PROVIDER_MAX_PATH 260
+#define LIBSPDM_MEASUREMENT_PROVIDER_MAX_THREAD_COUNT 16
+#define LIBSPDM_MEASUREMENT_PROVIDER_CHUNK_SIZE 0x100000
+#define LIBSPDM_MEASUREMENT_PROVIDER_DEFAULT_READ_AHEAD_SIZE 0x400000
+
+bool libspdm_measurement_provider_set_image(uint8_t measurement_index, const char *file_name);
+
+bool libspdm_measurement_provider_has_image(uint8_t measurement_index);
+
+bool libspdm_measurement_provider_configure(uintn thread_count, uintn read_ahead_size);
+
+bool libspdm_measurement_provider_prepare(uint32_t measurement_hash_algo);
+
+bool libspdm_measurement_provider_get_digest(uint8_t measurement_index,
+                                             uint32_t measurement_hash_algo,
+                                             uint8_t *digest);
+
+bool libspdm_measurement_provider_check_images(void);
+
+void libspdm_measurement_provider_flush(void);
+
+void libspdm_measurement_provider_get_statistics(uint64_t *hit_count, uint64_t *miss_count,
+                                                 uint64_t *hashed_bytes);
+
 /* External*/
 
 bool libspdm_read_input_file(const char *file_name, void **file_data,
@@ -0,0 +1,225 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Attestation benchmark of an in-process requester and responder.
+ *
+ * Every attestation starts a new connection and gets all measurements:
+ *  - manual: VCA, GET_DIGESTS, GET_CERTIFICATE, CHALLENGE and a signed GET_MEASUREMENTS,
+ *  - attest: libspdm_attest(), first with a new requester context, then with the
+ *            certificate chain verified by the previous attestation.
+ *
+ * Every round trip can be delayed by an emulated link latency, to show what the
+ * round trips cost on a real transport.
+ *
+ * Usage: bench_attest [iterations] [link_latency_us]
+ **/
+
+#include "bench_loopback.h"
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 100
+#define LIBSPDM_BENCH_DEFAULT_LINK_LATENCY_US 100
+
+static const char *m_libspdm_bench_attest_step_name[LIBSPDM_ATTEST_STEP_COUNT] = {
+    "VCA",
+    "GET_DIGESTS",
+    "GET_CERTIFICATE",
+    "CHALLENGE",
+    "GET_MEASUREMENTS",
+};
+
+/* Make the next request of the requester start a new connection.*/
+static bool libspdm_bench_new_connection(libspdm_bench_loopback_t *loopback)
+{
+    libspdm_data_parameter_t parameter;
+    uint32_t connection_state;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    connection_state = LIBSPDM_CONNECTION_STATE_NOT_STARTED;
+    return !RETURN_ERROR(libspdm_set_data(loopback->requester_context,
+                                          LIBSPDM_DATA_CONNECTION_STATE, &parameter,
+                                          &connection_state, sizeof(connection_state)));
+}
+
+static return_status libspdm_bench_attest_manual(libspdm_bench_loopback_t *loopback)
+{
+    return_status status;
+    uint8_t slot_mask;
+    uint8_t total_digest_buffer[LIBSPDM_MAX_HASH_SIZE * SPDM_MAX_SLOT_COUNT];
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint32_t measurement_record_length;
+    uint8_t number_of_blocks;
+
+    status = libspdm_init_connection(loopback->requester_context, false);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    status = libspdm_get_digest(loopback->requester_context, &slot_mask,
+                                total_digest_buffer);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    status = libspdm_get_certificate(loopback->requester_context, 0, NULL, NULL);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    status = libspdm_challenge(loopback->requester_context, 0,
+                               SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                               NULL, NULL);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    measurement_record_length = sizeof(measurement_record);
+    return libspdm_get_measurement(
+        loopback->requester_context, NULL,
+        SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        0, NULL, &number_of_blocks, &measurement_record_length, measurement_record);
+}
+
+static return_status libspdm_bench_attest(libspdm_bench_loopback_t *loopback,
+                                          libspdm_attest_evidence_t *evidence)
+{
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint32_t measurement_record_length;
+
+    measurement_record_length = sizeof(measurement_record);
+    return libspdm_attest(loopback->requester_context, 0, &measurement_record_length,
+                          measurement_record, evidence);
+}
+
+static void libspdm_bench_report_round_trips(libspdm_bench_loopback_t *loopback,
+                                             const char *name, uintn iterations,
+                                             uint64_t elapsed, uint64_t round_trip_count)
+{
+    char report_name[64];
+
+    snprintf(report_name, sizeof(report_name), "%s (%d us link)", name,
+             (int)(loopback->link_latency_ns / 1000));
+    libspdm_bench_report(report_name, iterations, elapsed);
+    printf("%-48s %12d round trips\n", "", (int)(round_trip_count / iterations));
+}
+
+static void libspdm_bench_report_steps(const uint64_t *step_time_ns, uint8_t step_mask,
+                                       uintn iterations)
+{
+    uint8_t step;
+
+    for (step = 0; step < LIBSPDM_ATTEST_STEP_COUNT; step++) {
+        if ((step_mask & (1 << step)) == 0) {
+            continue;
+        }
+        printf("%-48s %10.2f us %s\n", "",
+               (double)step_time_ns[step] / 1000.0 / (double)iterations,
+               m_libspdm_bench_attest_step_name[step]);
+    }
+}
+
+static bool libspdm_bench_run_manual(libspdm_bench_loopback_t *loopback, uintn iterations)
+{
+    uintn index;
+    uint64_t round_trip_count;
+    uint64_t start;
+    uint64_t elapsed;
+
+    round_trip_count = loopback->round_trip_count;
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_bench_new_connection(loopback) ||
+            RETURN_ERROR(libspdm_bench_attest_manual(loopback))) {
+            printf("manual - FAIL\n");
+            return false;
+        }
+    }
+    elapsed = libspdm_bench_get_time_ns() - start;
+    libspdm_bench_report_round_trips(loopback, "manual", iterations, elapsed,
+                                     loopback->round_trip_count - round_trip_count);
+    return true;
+}
+
+static bool libspdm_bench_run_attest(libspdm_bench_loopback_t *loopback, const char *name,
+                                     uintn iterations)
+{
+    uintn index;
+    uint64_t round_trip_count;
+    uint64_t start;
+    uint64_t elapsed;
+    libspdm_attest_evidence_t evidence;
+    uint64_t step_time_ns[LIBSPDM_ATTEST_STEP_COUNT];
+    uint8_t step_mask;
+    uint8_t step;
+
+    libspdm_zero_mem(step_time_ns, sizeof(step_time_ns));
+    step_mask = 0;
+    round_trip_count = loopback->round_trip_count;
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_bench_new_connection(loopback) ||
+            RETURN_ERROR(libspdm_bench_attest(loopback, &evidence)) ||
+            !evidence.authenticated) {
+            printf("%s - FAIL\n", name);
+            return false;
+        }
+        step_mask |= evidence.step_mask;
+        for (step = 0; step < LIBSPDM_ATTEST_STEP_COUNT; step++) {
+            step_time_ns[step] += evidence.step_time_ns[step];
+        }
+    }
+    elapsed = libspdm_bench_get_time_ns() - start;
+    libspdm_bench_report_round_trips(loopback, name, iterations, elapsed,
+                                     loopback->round_trip_count - round_trip_count);
+    libspdm_bench_report_steps(step_time_ns, step_mask, iterations);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    libspdm_bench_loopback_t *loopback;
+    uintn iterations;
+    uint64_t link_latency_ns[2];
+    uintn index;
+    int return_value;
+
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    link_latency_ns[1] = LIBSPDM_BENCH_DEFAULT_LINK_LATENCY_US * 1000;
+    if (argc > 1) {
+        iterations = (uintn)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        link_latency_ns[1] = (uint64_t)strtoul(argv[2], NULL, 0) * 1000;
+    }
+    link_latency_ns[0] = 0;
+    if (iterations == 0) {
+        iterations = 1;
+    }
+
+    loopback = malloc(sizeof(libspdm_bench_loopback_t));
+    if (loopback == NULL) {
+        printf("loopback init - FAIL\n");
+        return 1;
+    }
+
+    return_value = 0;
+    for (index = 0; index < ARRAY_SIZE(link_latency_ns); index++) {
+        /* a new requester has no verified certificate chain*/
+        if (!libspdm_bench_loopback_init(loopback)) {
+            printf("loopback init - FAIL\n");
+            free(loopback);
+            return 1;
+        }
+        loopback->link_latency_ns = link_latency_ns[index];
+        if (!libspdm_bench_run_attest(loopback, "attest, new requester", 1) ||
+            !libspdm_bench_run_attest(loopback, "attest", iterations) ||
+            !libspdm_bench_run_manual(loopback, iterations)) {
+            return_value = 1;
+        }
+        libspdm_bench_loopback_free(loopback);
+    }
+
+    free(loopback);
+    return return_value;
+}
@@ -0,0 +1,227 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Certificate chain verification benchmark.
+ *
+ * For every sample chain (including the long chains) it measures:
+ *  - pairwise:  libspdm_x509_verify_cert() on every adjacent pair, so each
+ *               certificate is parsed twice,
+ *  - chain:     libspdm_x509_verify_cert_chain(), each certificate parsed once,
+ *  - leaf:      libspdm_x509_certificate_check() of the leaf certificate,
+ *  - full:      libspdm_verify_cert_chain_data(), chain + leaf check.
+ *  - cached:    full, with a warm issuer signature verification cache, so only the
+ *               validity windows are checked again.
+ *
+ * The result is reported in chains per second.
+ * Run it from the directory holding the sample keys.
+ *
+ * Usage: bench_cert_chain [iterations]
+ **/
+
+#include "bench_common.h"
+#include "library/spdm_crypt_lib.h"
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 100
+
+typedef struct {
+    const char *file;
+    uint32_t base_asym_algo;
+    uint32_t base_hash_algo;
+    const char *name;
+} libspdm_bench_cert_chain_t;
+
+static const libspdm_bench_cert_chain_t m_libspdm_bench_cert_chain[] = {
+#if LIBSPDM_ECDSA_SUPPORT == 1
+    { "ecp256/bundle_responder.certchain.der",
+      SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "ecp256" },
+    { "ecp384/bundle_responder.certchain.der",
+      SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, "ecp384" },
+    { "long_chains/Shorter1024B_bundle_responder.certchain.der",
+      SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "Shorter1024B" },
+#endif
+#if (LIBSPDM_RSA_SSA_SUPPORT == 1)
+    { "rsa2048/bundle_responder.certchain.der",
+      SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "rsa2048" },
+    { "long_chains/ShorterMAXINT16_bundle_responder.certchain.der",
+      SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "ShorterMAXINT16" },
+    { "long_chains/ShorterMAXUINT16_bundle_responder.certchain.der",
+      SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "ShorterMAXUINT16" },
+#endif
+};
+
+/* Verify the chain one adjacent pair at a time, as libspdm_x509_verify_cert_chain() used to. */
+static bool libspdm_bench_verify_pairwise(uint8_t *cert_chain, uintn cert_chain_size)
+{
+    uint8_t *preceding_cert;
+    uintn preceding_cert_size;
+    uint8_t *current_cert;
+    uintn current_cert_size;
+    int32_t index;
+
+    if (!libspdm_x509_get_cert_from_cert_chain(cert_chain, cert_chain_size, 0,
+                                               &preceding_cert, &preceding_cert_size)) {
+        return false;
+    }
+    for (index = 0;; index++) {
+        if (!libspdm_x509_get_cert_from_cert_chain(cert_chain, cert_chain_size, index,
+                                                   &current_cert, &current_cert_size)) {
+            break;
+        }
+        if (!libspdm_x509_verify_cert(current_cert, current_cert_size,
+                                      preceding_cert, preceding_cert_size)) {
+            return false;
+        }
+        preceding_cert = current_cert;
+        preceding_cert_size = current_cert_size;
+    }
+    return true;
+}
+
+static bool libspdm_bench_cert_chain(const libspdm_bench_cert_chain_t *chain, uintn iterations)
+{
+    uint8_t *cert_chain;
+    uintn cert_chain_size;
+    uint8_t *root_cert;
+    uintn root_cert_size;
+    uint8_t *leaf_cert;
+    uintn leaf_cert_size;
+    uint8_t *cert;
+    uintn cert_size;
+    uintn cert_count;
+    uintn index;
+    uint64_t start;
+    bool result;
+    char name[64];
+    uint64_t cache_hit_count;
+    uint64_t cache_miss_count;
+    uintn cache_entry_count;
+
+    if (!libspdm_read_input_file(chain->file, (void **)&cert_chain, &cert_chain_size)) {
+        return false;
+    }
+
+    result = false;
+    cert_count = 0;
+    while (libspdm_x509_get_cert_from_cert_chain(cert_chain, cert_chain_size,
+                                                 (int32_t)cert_count, &cert, &cert_size)) {
+        cert_count++;
+    }
+    if (!libspdm_x509_get_cert_from_cert_chain(cert_chain, cert_chain_size, 0,
+                                               &root_cert, &root_cert_size) ||
+        !libspdm_x509_get_cert_from_cert_chain(cert_chain, cert_chain_size, -1,
+                                               &leaf_cert, &leaf_cert_size)) {
+        goto done;
+    }
+    printf("%s: %d certificates, %d bytes\n", chain->name, (int)cert_count,
+           (int)cert_chain_size);
+
+    /* pairwise*/
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_bench_verify_pairwise(cert_chain, cert_chain_size)) {
+            goto done;
+        }
+    }
+    snprintf(name, sizeof(name), "%s pairwise", chain->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    /* chain*/
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_x509_verify_cert_chain(root_cert, root_cert_size,
+                                            cert_chain, cert_chain_size)) {
+            goto done;
+        }
+    }
+    snprintf(name, sizeof(name), "%s chain", chain->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    /* leaf*/
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_x509_certificate_check(leaf_cert, leaf_cert_size,
+                                            chain->base_asym_algo, chain->base_hash_algo,
+                                            true)) {
+            goto done;
+        }
+    }
+    snprintf(name, sizeof(name), "%s leaf", chain->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    /* full*/
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_verify_cert_chain_data(cert_chain, cert_chain_size,
+                                            chain->base_asym_algo, chain->base_hash_algo,
+                                            true)) {
+            goto done;
+        }
+    }
+    snprintf(name, sizeof(name), "%s full", chain->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    /* cached, warm the cache first*/
+    libspdm_x509_verify_cache_set_max_entry_count(LIBSPDM_X509_VERIFY_CACHE_MAX_ENTRY_COUNT);
+    libspdm_x509_verify_cache_flush();
+    if (!libspdm_verify_cert_chain_data(cert_chain, cert_chain_size,
+                                        chain->base_asym_algo, chain->base_hash_algo,
+                                        true)) {
+        libspdm_x509_verify_cache_set_max_entry_count(0);
+        goto done;
+    }
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_verify_cert_chain_data(cert_chain, cert_chain_size,
+                                            chain->base_asym_algo, chain->base_hash_algo,
+                                            true)) {
+            libspdm_x509_verify_cache_set_max_entry_count(0);
+            goto done;
+        }
+    }
+    snprintf(name, sizeof(name), "%s cached", chain->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+    libspdm_x509_verify_cache_get_statistics(&cache_hit_count, &cache_miss_count,
+                                             &cache_entry_count);
+    printf("%s cache: %llu hits, %llu misses, %d entries\n", chain->name,
+           (unsigned long long)cache_hit_count, (unsigned long long)cache_miss_count,
+           (int)cache_entry_count);
+    libspdm_x509_verify_cache_set_max_entry_count(0);
+
+    result = true;
+
+done:
+    free(cert_chain);
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    uintn iterations;
+    uintn index;
+    int return_value;
+
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = (uintn)strtoul(argv[1], NULL, 0);
+    }
+
+    return_value = 0;
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_cert_chain); index++) {
+        if (!libspdm_bench_cert_chain(&m_libspdm_bench_cert_chain[index], iterations)) {
+            printf("%s - FAIL\n", m_libspdm_bench_cert_chain[index].name);
+            return_value = 1;
+        }
+    }
+
+    return return_value;
+}
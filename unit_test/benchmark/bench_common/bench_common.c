@@ -0,0 +1,107 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#endif
+
+#include "bench_common.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+uint64_t libspdm_bench_get_time_ns(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+uint64_t libspdm_bench_get_cycles(void)
+{
+#if (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))) || \
+    ((defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)))
+    return __rdtsc();
+#else
+    return libspdm_bench_get_time_ns();
+#endif
+}
+
+void libspdm_bench_report(const char *name, uintn iterations, uint64_t elapsed_ns)
+{
+    double us_per_op;
+    double ops_per_sec;
+
+    if ((iterations == 0) || (elapsed_ns == 0)) {
+        printf("%-48s %10s\n", name, "n/a");
+        return;
+    }
+    us_per_op = (double)elapsed_ns / 1000.0 / (double)iterations;
+    ops_per_sec = (double)iterations * 1000000000.0 / (double)elapsed_ns;
+    printf("%-48s %12.2f us/op %12.1f ops/s\n", name, us_per_op, ops_per_sec);
+}
+
+void libspdm_dump_hex_str(const uint8_t *buffer, uintn buffer_size)
+{
+    uintn index;
+
+    for (index = 0; index < buffer_size; index++) {
+        printf("%02x", buffer[index]);
+    }
+}
+
+bool libspdm_read_input_file(const char *file_name, void **file_data,
+                             uintn *file_size)
+{
+    FILE *fp_in;
+    uintn temp_result;
+
+    if ((fp_in = fopen(file_name, "rb")) == NULL) {
+        printf("Unable to open file %s\n", file_name);
+        *file_data = NULL;
+        return false;
+    }
+
+    fseek(fp_in, 0, SEEK_END);
+    *file_size = ftell(fp_in);
+
+    *file_data = (void *)malloc(*file_size);
+    if (NULL == *file_data) {
+        printf("No sufficient memory to allocate %s\n", file_name);
+        fclose(fp_in);
+        return false;
+    }
+
+    fseek(fp_in, 0, SEEK_SET);
+    temp_result = fread(*file_data, 1, *file_size, fp_in);
+    if (temp_result != *file_size) {
+        printf("Read input file error %s", file_name);
+        free((void *)*file_data);
+        fclose(fp_in);
+        return false;
+    }
+
+    fclose(fp_in);
+
+    return true;
+}
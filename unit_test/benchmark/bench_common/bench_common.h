@@ -0,0 +1,53 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef __SPDM_BENCH_COMMON_H__
+#define __SPDM_BENCH_COMMON_H__
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#undef NULL
+
+#include "hal/base.h"
+#include "hal/library/debuglib.h"
+#include "hal/library/memlib.h"
+#include "library/malloclib.h"
+#include "hal/library/cryptlib.h"
+
+/**
+ * Return a monotonic timestamp in nanoseconds.
+ **/
+uint64_t libspdm_bench_get_time_ns(void);
+
+/**
+ * Return the CPU timestamp counter.
+ *
+ * On architectures without a readable cycle counter, it falls back to
+ * libspdm_bench_get_time_ns().
+ **/
+uint64_t libspdm_bench_get_cycles(void);
+
+/**
+ * Print one benchmark result line.
+ *
+ * @param  name          The name of the measured operation.
+ * @param  iterations    The number of measured iterations.
+ * @param  elapsed_ns    The total time in nanoseconds of all iterations.
+ **/
+void libspdm_bench_report(const char *name, uintn iterations, uint64_t elapsed_ns);
+
+bool libspdm_read_input_file(const char *file_name, void **file_data,
+                             uintn *file_size);
+
+void libspdm_dump_hex_str(const uint8_t *buffer, uintn buffer_size);
+
+#endif
@@ -0,0 +1,345 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "bench_loopback.h"
+#include "library/spdm_transport_test_lib.h"
+#include "spdm_device_secret_lib_internal.h"
+
+static const libspdm_bench_loopback_algo_t m_libspdm_bench_loopback_default_algo = {
+    "sha384-ecdsa_p384-secp384r1-aes256gcm",
+    LIBSPDM_BENCH_LOOPBACK_BASE_HASH_ALGO,
+    LIBSPDM_BENCH_LOOPBACK_BASE_ASYM_ALGO,
+    LIBSPDM_BENCH_LOOPBACK_MEASUREMENT_HASH_ALGO,
+    SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1,
+    SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM,
+};
+
+static libspdm_bench_loopback_t *libspdm_bench_loopback_get(void *spdm_context)
+{
+    libspdm_data_parameter_t parameter;
+    void *app_context_data;
+    uintn data_size;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    data_size = sizeof(app_context_data);
+    if (RETURN_ERROR(libspdm_get_data(spdm_context, LIBSPDM_DATA_APP_CONTEXT_DATA,
+                                      &parameter, &app_context_data, &data_size))) {
+        return NULL;
+    }
+    return app_context_data;
+}
+
+static return_status libspdm_bench_loopback_requester_send(void *spdm_context,
+                                                           uintn message_size,
+                                                           const void *message,
+                                                           uint64_t timeout)
+{
+    libspdm_bench_loopback_t *loopback;
+
+    loopback = libspdm_bench_loopback_get(spdm_context);
+    if (message_size > sizeof(loopback->message)) {
+        return RETURN_DEVICE_ERROR;
+    }
+    libspdm_copy_mem(loopback->message, sizeof(loopback->message), message, message_size);
+    loopback->message_size = message_size;
+    loopback->round_trip_count++;
+    return RETURN_SUCCESS;
+}
+
+static return_status libspdm_bench_loopback_requester_receive(void *spdm_context,
+                                                              uintn *message_size,
+                                                              void *message,
+                                                              uint64_t timeout)
+{
+    libspdm_bench_loopback_t *loopback;
+    return_status status;
+    uint64_t start;
+    libspdm_malloc_stats_t *requester_malloc_stats;
+
+    loopback = libspdm_bench_loopback_get(spdm_context);
+    start = libspdm_bench_get_time_ns();
+    if (loopback->responder_malloc_stats != NULL) {
+        requester_malloc_stats = libspdm_set_malloc_stats_scope(loopback->responder_malloc_stats);
+        status = libspdm_responder_dispatch_message(loopback->responder_context);
+        libspdm_set_malloc_stats_scope(requester_malloc_stats);
+    } else {
+        status = libspdm_responder_dispatch_message(loopback->responder_context);
+    }
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    if (*message_size < loopback->message_size) {
+        return RETURN_DEVICE_ERROR;
+    }
+    libspdm_copy_mem(message, *message_size, loopback->message, loopback->message_size);
+    *message_size = loopback->message_size;
+
+    /* The responder time is part of the round trip, the link latency comes on top.*/
+    while (libspdm_bench_get_time_ns() - start < loopback->link_latency_ns) {
+    }
+    return RETURN_SUCCESS;
+}
+
+static return_status libspdm_bench_loopback_responder_send(void *spdm_context,
+                                                           uintn message_size,
+                                                           const void *message,
+                                                           uint64_t timeout)
+{
+    libspdm_bench_loopback_t *loopback;
+
+    loopback = libspdm_bench_loopback_get(spdm_context);
+    if (message_size > sizeof(loopback->message)) {
+        return RETURN_DEVICE_ERROR;
+    }
+    libspdm_copy_mem(loopback->message, sizeof(loopback->message), message, message_size);
+    loopback->message_size = message_size;
+    return RETURN_SUCCESS;
+}
+
+static return_status libspdm_bench_loopback_responder_receive(void *spdm_context,
+                                                              uintn *message_size,
+                                                              void *message,
+                                                              uint64_t timeout)
+{
+    libspdm_bench_loopback_t *loopback;
+
+    loopback = libspdm_bench_loopback_get(spdm_context);
+    if (*message_size < loopback->message_size) {
+        return RETURN_DEVICE_ERROR;
+    }
+    libspdm_copy_mem(message, *message_size, loopback->message, loopback->message_size);
+    *message_size = loopback->message_size;
+    return RETURN_SUCCESS;
+}
+
+static bool libspdm_bench_loopback_init_context(libspdm_bench_loopback_t *loopback,
+                                                void *spdm_context, bool is_requester)
+{
+    libspdm_data_parameter_t parameter;
+    void *app_context_data;
+    uint32_t data32;
+    uint16_t data16;
+    uint8_t data8;
+
+    libspdm_init_context(spdm_context);
+    if (is_requester) {
+        libspdm_register_device_io_func(spdm_context,
+                                        libspdm_bench_loopback_requester_send,
+                                        libspdm_bench_loopback_requester_receive);
+    } else {
+        libspdm_register_device_io_func(spdm_context,
+                                        libspdm_bench_loopback_responder_send,
+                                        libspdm_bench_loopback_responder_receive);
+    }
+    libspdm_register_transport_layer_func(spdm_context,
+                                          libspdm_transport_test_encode_message,
+                                          libspdm_transport_test_decode_message);
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    app_context_data = loopback;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_APP_CONTEXT_DATA, &parameter,
+                     &app_context_data, sizeof(app_context_data));
+
+    if (is_requester) {
+        data32 = SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CERT_CAP |
+                 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_CHAL_CAP |
+                 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_ENCRYPT_CAP |
+                 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_MAC_CAP |
+                 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP |
+                 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_HBEAT_CAP |
+                 SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_UPD_CAP;
+    #if LIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP
+        data32 |= SPDM_GET_CAPABILITIES_REQUEST_FLAGS_PSK_CAP_REQUESTER;
+    #endif /* LIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP*/
+    } else {
+        data32 = SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ENCRYPT_CAP |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MAC_CAP |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_HBEAT_CAP |
+                 SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_UPD_CAP;
+    #if LIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP
+        data32 |= SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_PSK_CAP_RESPONDER_WITH_CONTEXT;
+    #endif /* LIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP*/
+    }
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_CAPABILITY_FLAGS, &parameter,
+                     &data32, sizeof(data32));
+
+    data8 = SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_MEASUREMENT_SPEC, &parameter,
+                     &data8, sizeof(data8));
+    data32 = loopback->algo.measurement_hash_algo;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_MEASUREMENT_HASH_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data32 = loopback->algo.base_asym_algo;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_BASE_ASYM_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data32 = loopback->algo.base_hash_algo;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_BASE_HASH_ALGO, &parameter,
+                     &data32, sizeof(data32));
+    data16 = loopback->algo.dhe_named_group;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_DHE_NAME_GROUP, &parameter,
+                     &data16, sizeof(data16));
+    data16 = loopback->algo.aead_cipher_suite;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_AEAD_CIPHER_SUITE, &parameter,
+                     &data16, sizeof(data16));
+    data16 = SPDM_ALGORITHMS_KEY_SCHEDULE_HMAC_HASH;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_KEY_SCHEDULE, &parameter,
+                     &data16, sizeof(data16));
+    data8 = SPDM_ALGORITHMS_OPAQUE_DATA_FORMAT_1;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_OTHER_PARAMS_SUPPORT, &parameter,
+                     &data8, sizeof(data8));
+
+    if (is_requester) {
+    #if LIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP
+        libspdm_set_data(spdm_context, LIBSPDM_DATA_PSK_HINT, &parameter,
+                         (void *)LIBSPDM_TEST_PSK_HINT_STRING,
+                         sizeof(LIBSPDM_TEST_PSK_HINT_STRING));
+    #endif /* LIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP*/
+        return true;
+    }
+
+    data8 = 1;
+    libspdm_set_data(spdm_context, LIBSPDM_DATA_LOCAL_SLOT_COUNT, &parameter,
+                     &data8, sizeof(data8));
+    parameter.additional_data[0] = 0;
+    return !RETURN_ERROR(libspdm_set_data(spdm_context, LIBSPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+                                          &parameter, loopback->cert_chain,
+                                          loopback->cert_chain_size));
+}
+
+/**
+ * Create the requester and responder contexts of a loopback, with the default algorithms.
+ *
+ * @param  loopback       The loopback to initialize.
+ *
+ * @retval true   The loopback is initialized.
+ * @retval false  The loopback cannot be initialized, nothing needs to be freed.
+ **/
+bool libspdm_bench_loopback_init(libspdm_bench_loopback_t *loopback)
+{
+    return libspdm_bench_loopback_init_algo(loopback, &m_libspdm_bench_loopback_default_algo);
+}
+
+/**
+ * Create the requester and responder contexts of a loopback, with the given algorithms.
+ *
+ * @param  loopback       The loopback to initialize.
+ * @param  algo           The algorithms of both contexts.
+ *
+ * @retval true   The loopback is initialized.
+ * @retval false  The loopback cannot be initialized, nothing needs to be freed.
+ **/
+bool libspdm_bench_loopback_init_algo(libspdm_bench_loopback_t *loopback,
+                                      const libspdm_bench_loopback_algo_t *algo)
+{
+    libspdm_data_parameter_t parameter;
+    void *hash;
+    uintn hash_size;
+    uint8_t *root_cert;
+    uintn root_cert_size;
+
+    libspdm_zero_mem(loopback, sizeof(libspdm_bench_loopback_t));
+    loopback->algo = *algo;
+    if (!libspdm_read_responder_public_certificate_chain(
+            algo->base_hash_algo, algo->base_asym_algo,
+            &loopback->cert_chain, &loopback->cert_chain_size, NULL, NULL) ||
+        !libspdm_read_responder_root_public_certificate(
+            algo->base_hash_algo, algo->base_asym_algo,
+            &loopback->root_cert_chain, &loopback->root_cert_chain_size, &hash, &hash_size)) {
+        goto error;
+    }
+    if (!libspdm_x509_get_cert_from_cert_chain(
+            (uint8_t *)loopback->root_cert_chain + sizeof(spdm_cert_chain_t) + hash_size,
+            loopback->root_cert_chain_size - sizeof(spdm_cert_chain_t) - hash_size,
+            0, &root_cert, &root_cert_size)) {
+        goto error;
+    }
+
+    loopback->requester_context = malloc(libspdm_get_context_size());
+    loopback->responder_context = malloc(libspdm_get_context_size());
+    if ((loopback->requester_context == NULL) || (loopback->responder_context == NULL)) {
+        goto error;
+    }
+    if (!libspdm_bench_loopback_init_context(loopback, loopback->requester_context, true) ||
+        !libspdm_bench_loopback_init_context(loopback, loopback->responder_context, false)) {
+        goto error;
+    }
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    if (RETURN_ERROR(libspdm_set_data(loopback->requester_context,
+                                      LIBSPDM_DATA_PEER_PUBLIC_ROOT_CERT, &parameter,
+                                      root_cert, root_cert_size))) {
+        goto error;
+    }
+    return true;
+
+error:
+    libspdm_bench_loopback_free(loopback);
+    return false;
+}
+
+/**
+ * Authenticate the responder: VCA, GET_DIGESTS, GET_CERTIFICATE and CHALLENGE of slot 0.
+ *
+ * @param  loopback       The loopback.
+ *
+ * @return The status of the first failing request, or RETURN_SUCCESS.
+ **/
+return_status libspdm_bench_loopback_connect(libspdm_bench_loopback_t *loopback)
+{
+    return_status status;
+    uint8_t slot_mask;
+    uint8_t total_digest_buffer[LIBSPDM_MAX_HASH_SIZE * SPDM_MAX_SLOT_COUNT];
+    uint8_t cert_chain[LIBSPDM_MAX_CERT_CHAIN_SIZE];
+    uintn cert_chain_size;
+
+    status = libspdm_init_connection(loopback->requester_context, false);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    status = libspdm_get_digest(loopback->requester_context, &slot_mask,
+                                total_digest_buffer);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    cert_chain_size = sizeof(cert_chain);
+    status = libspdm_get_certificate(loopback->requester_context, 0, &cert_chain_size,
+                                     cert_chain);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    return libspdm_challenge(loopback->requester_context, 0,
+                             SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                             NULL, NULL);
+}
+
+/**
+ * Free the requester and responder contexts of a loopback.
+ *
+ * @param  loopback       The loopback.
+ **/
+void libspdm_bench_loopback_free(libspdm_bench_loopback_t *loopback)
+{
+    if (loopback->requester_context != NULL) {
+        free(loopback->requester_context);
+    }
+    if (loopback->responder_context != NULL) {
+        free(loopback->responder_context);
+    }
+    if (loopback->cert_chain != NULL) {
+        free(loopback->cert_chain);
+    }
+    if (loopback->root_cert_chain != NULL) {
+        free(loopback->root_cert_chain);
+    }
+    libspdm_zero_mem(loopback, sizeof(libspdm_bench_loopback_t));
+}
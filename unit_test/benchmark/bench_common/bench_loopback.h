@@ -0,0 +1,94 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef __SPDM_BENCH_LOOPBACK_H__
+#define __SPDM_BENCH_LOOPBACK_H__
+
+#include "bench_common.h"
+#include "library/spdm_requester_lib.h"
+#include "library/spdm_responder_lib.h"
+
+/* The algorithms offered by both contexts of a loopback.*/
+typedef struct {
+    const char *name;
+    uint32_t base_hash_algo;
+    uint32_t base_asym_algo;
+    uint32_t measurement_hash_algo;
+    uint16_t dhe_named_group;
+    uint16_t aead_cipher_suite;
+} libspdm_bench_loopback_algo_t;
+
+/*
+ * An in-process requester and responder, connected over the test transport.
+ *
+ * Every requester message is dispatched to the responder synchronously,
+ * so one send/receive pair of the requester is one round trip.
+ */
+typedef struct {
+    libspdm_bench_loopback_algo_t algo;
+    void *requester_context;
+    void *responder_context;
+    /* the transport message in flight, in either direction*/
+    uintn message_size;
+    uint8_t message[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    /* number of requester round trips*/
+    uint64_t round_trip_count;
+    /* emulated link latency added to every round trip*/
+    uint64_t link_latency_ns;
+    /* if not NULL, the allocation statistics selected while the responder runs*/
+    libspdm_malloc_stats_t *responder_malloc_stats;
+    void *cert_chain;
+    uintn cert_chain_size;
+    void *root_cert_chain;
+    uintn root_cert_chain_size;
+} libspdm_bench_loopback_t;
+
+#define LIBSPDM_BENCH_LOOPBACK_BASE_HASH_ALGO SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384
+#define LIBSPDM_BENCH_LOOPBACK_BASE_ASYM_ALGO SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384
+#define LIBSPDM_BENCH_LOOPBACK_MEASUREMENT_HASH_ALGO \
+    SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384
+
+/**
+ * Create the requester and responder contexts of a loopback, with the default algorithms.
+ *
+ * @param  loopback       The loopback to initialize.
+ *
+ * @retval true   The loopback is initialized.
+ * @retval false  The loopback cannot be initialized, nothing needs to be freed.
+ **/
+bool libspdm_bench_loopback_init(libspdm_bench_loopback_t *loopback);
+
+/**
+ * Create the requester and responder contexts of a loopback, with the given algorithms.
+ *
+ * The sample certificate chain of the asymmetric algorithm is provisioned to the responder.
+ *
+ * @param  loopback       The loopback to initialize.
+ * @param  algo           The algorithms of both contexts.
+ *
+ * @retval true   The loopback is initialized.
+ * @retval false  The loopback cannot be initialized, nothing needs to be freed.
+ **/
+bool libspdm_bench_loopback_init_algo(libspdm_bench_loopback_t *loopback,
+                                      const libspdm_bench_loopback_algo_t *algo);
+
+/**
+ * Authenticate the responder: VCA, GET_DIGESTS, GET_CERTIFICATE and CHALLENGE of slot 0.
+ *
+ * @param  loopback       The loopback.
+ *
+ * @return The status of the first failing request, or RETURN_SUCCESS.
+ **/
+return_status libspdm_bench_loopback_connect(libspdm_bench_loopback_t *loopback);
+
+/**
+ * Free the requester and responder contexts of a loopback.
+ *
+ * @param  loopback       The loopback.
+ **/
+void libspdm_bench_loopback_free(libspdm_bench_loopback_t *loopback);
+
+#endif
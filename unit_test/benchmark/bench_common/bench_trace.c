@@ -0,0 +1,200 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "bench_trace.h"
+
+#define LIBSPDM_BENCH_TRACE_ATTACH_COUNT 4
+
+typedef struct {
+    void *spdm_context;
+    libspdm_bench_trace_t *trace;
+} libspdm_bench_trace_attachment_t;
+
+static libspdm_bench_trace_attachment_t
+    m_libspdm_bench_trace_attachment[LIBSPDM_BENCH_TRACE_ATTACH_COUNT];
+
+static const char *m_libspdm_bench_trace_phase_name[LIBSPDM_TRACE_PHASE_MAX] = {
+    "encode",
+    "send",
+    "wait",
+    "decode",
+    "process",
+    "sign",
+    "verify",
+    "hash",
+    "key derivation",
+};
+
+typedef struct {
+    uint8_t request_code;
+    const char *name;
+} libspdm_bench_trace_request_name_t;
+
+static const libspdm_bench_trace_request_name_t m_libspdm_bench_trace_request_name[] = {
+    { SPDM_GET_DIGESTS, "GET_DIGESTS" },
+    { SPDM_GET_CERTIFICATE, "GET_CERTIFICATE" },
+    { SPDM_CHALLENGE, "CHALLENGE" },
+    { SPDM_GET_VERSION, "GET_VERSION" },
+    { SPDM_GET_MEASUREMENTS, "GET_MEASUREMENTS" },
+    { SPDM_GET_CAPABILITIES, "GET_CAPABILITIES" },
+    { SPDM_NEGOTIATE_ALGORITHMS, "NEGOTIATE_ALGORITHMS" },
+    { SPDM_KEY_EXCHANGE, "KEY_EXCHANGE" },
+    { SPDM_FINISH, "FINISH" },
+    { SPDM_PSK_EXCHANGE, "PSK_EXCHANGE" },
+    { SPDM_PSK_FINISH, "PSK_FINISH" },
+    { SPDM_HEARTBEAT, "HEARTBEAT" },
+    { SPDM_KEY_UPDATE, "KEY_UPDATE" },
+    { SPDM_GET_ENCAPSULATED_REQUEST, "GET_ENCAPSULATED_REQUEST" },
+    { SPDM_DELIVER_ENCAPSULATED_RESPONSE, "DELIVER_ENCAPSULATED_RESPONSE" },
+    { SPDM_END_SESSION, "END_SESSION" },
+    { SPDM_VENDOR_DEFINED_REQUEST, "VENDOR_DEFINED_REQUEST" },
+    { SPDM_RESPOND_IF_READY, "RESPOND_IF_READY" },
+};
+
+static const char *libspdm_bench_trace_request_name(uint8_t request_code)
+{
+    uintn index;
+
+    if (request_code == 0) {
+        return "APP";
+    }
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_trace_request_name); index++) {
+        if (m_libspdm_bench_trace_request_name[index].request_code == request_code) {
+            return m_libspdm_bench_trace_request_name[index].name;
+        }
+    }
+    return "UNKNOWN";
+}
+
+static uintn libspdm_bench_trace_bucket(uint64_t time_ns)
+{
+    uint64_t time_us;
+    uintn bucket;
+
+    time_us = time_ns / 1000;
+    bucket = 0;
+    while ((time_us != 0) && (bucket < LIBSPDM_BENCH_TRACE_BUCKET_COUNT - 1)) {
+        time_us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+/* The upper bound in us of the bucket holding the given percentile of an entry.*/
+static uint64_t libspdm_bench_trace_percentile_us(const libspdm_bench_trace_entry_t *entry,
+                                                  uintn percentile)
+{
+    uint64_t rank;
+    uint64_t count;
+    uintn bucket;
+
+    rank = (entry->count * percentile + 99) / 100;
+    count = 0;
+    for (bucket = 0; bucket < LIBSPDM_BENCH_TRACE_BUCKET_COUNT; bucket++) {
+        count += entry->histogram[bucket];
+        if (count >= rank) {
+            break;
+        }
+    }
+    return (uint64_t)1 << bucket;
+}
+
+static void libspdm_bench_trace_event(void *spdm_context, const libspdm_trace_event_t *event)
+{
+    libspdm_bench_trace_entry_t *entry;
+    uint64_t time_ns;
+    uintn index;
+
+    for (index = 0; index < LIBSPDM_BENCH_TRACE_ATTACH_COUNT; index++) {
+        if (m_libspdm_bench_trace_attachment[index].spdm_context == spdm_context) {
+            break;
+        }
+    }
+    if ((index == LIBSPDM_BENCH_TRACE_ATTACH_COUNT) || (event->phase >= LIBSPDM_TRACE_PHASE_MAX)) {
+        return;
+    }
+
+    entry = &m_libspdm_bench_trace_attachment[index].trace->entry
+            [event->request_code & (LIBSPDM_BENCH_TRACE_REQUEST_CODE_COUNT - 1)][event->phase];
+    time_ns = event->end_time - event->start_time;
+    if ((entry->count == 0) || (time_ns < entry->min_time_ns)) {
+        entry->min_time_ns = time_ns;
+    }
+    if (time_ns > entry->max_time_ns) {
+        entry->max_time_ns = time_ns;
+    }
+    entry->count++;
+    entry->total_time_ns += time_ns;
+    entry->total_size += event->size;
+    entry->histogram[libspdm_bench_trace_bucket(time_ns)]++;
+}
+
+void libspdm_bench_trace_reset(libspdm_bench_trace_t *trace)
+{
+    libspdm_zero_mem(trace, sizeof(*trace));
+}
+
+bool libspdm_bench_trace_attach(libspdm_bench_trace_t *trace, void *spdm_context)
+{
+    uintn index;
+
+    libspdm_bench_trace_detach(spdm_context);
+    for (index = 0; index < LIBSPDM_BENCH_TRACE_ATTACH_COUNT; index++) {
+        if (m_libspdm_bench_trace_attachment[index].spdm_context == NULL) {
+            m_libspdm_bench_trace_attachment[index].spdm_context = spdm_context;
+            m_libspdm_bench_trace_attachment[index].trace = trace;
+            libspdm_register_trace_func(spdm_context, libspdm_bench_trace_event,
+                                        libspdm_bench_get_time_ns);
+            return true;
+        }
+    }
+    return false;
+}
+
+void libspdm_bench_trace_detach(void *spdm_context)
+{
+    uintn index;
+
+    for (index = 0; index < LIBSPDM_BENCH_TRACE_ATTACH_COUNT; index++) {
+        if (m_libspdm_bench_trace_attachment[index].spdm_context == spdm_context) {
+            libspdm_register_trace_func(spdm_context, NULL, NULL);
+            m_libspdm_bench_trace_attachment[index].spdm_context = NULL;
+            m_libspdm_bench_trace_attachment[index].trace = NULL;
+        }
+    }
+}
+
+void libspdm_bench_trace_dump(const char *name, const libspdm_bench_trace_t *trace)
+{
+    const libspdm_bench_trace_entry_t *entry;
+    uintn request_index;
+    uintn phase;
+    uint8_t request_code;
+
+    printf("%s\n", name);
+    printf("  %-30s %-14s %8s %10s %10s %10s %8s %8s %8s\n", "request", "phase", "count",
+           "avg (us)", "min (us)", "max (us)", "p50<=us", "p99<=us", "avg size");
+    for (request_index = 0; request_index < LIBSPDM_BENCH_TRACE_REQUEST_CODE_COUNT;
+         request_index++) {
+        request_code = (request_index == 0) ? 0 : (uint8_t)(request_index | 0x80);
+        for (phase = 0; phase < LIBSPDM_TRACE_PHASE_MAX; phase++) {
+            entry = &trace->entry[request_index][phase];
+            if (entry->count == 0) {
+                continue;
+            }
+            printf("  %-30s %-14s %8llu %10.1f %10.1f %10.1f %8llu %8llu %8llu\n",
+                   libspdm_bench_trace_request_name(request_code),
+                   m_libspdm_bench_trace_phase_name[phase],
+                   (unsigned long long)entry->count,
+                   (double)entry->total_time_ns / (double)entry->count / 1000.0,
+                   (double)entry->min_time_ns / 1000.0,
+                   (double)entry->max_time_ns / 1000.0,
+                   (unsigned long long)libspdm_bench_trace_percentile_us(entry, 50),
+                   (unsigned long long)libspdm_bench_trace_percentile_us(entry, 99),
+                   (unsigned long long)(entry->total_size / entry->count));
+        }
+    }
+}
@@ -0,0 +1,73 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#ifndef __SPDM_BENCH_TRACE_H__
+#define __SPDM_BENCH_TRACE_H__
+
+#include "bench_common.h"
+#include "library/spdm_common_lib.h"
+
+/*
+ * A trace sink, that aggregates the latency of the trace events per request code and phase.
+ *
+ * Bucket 0 counts the phases shorter than 1 us, bucket N the phases in [2^(N-1), 2^N) us,
+ * and the last bucket all the longer phases.
+ */
+#define LIBSPDM_BENCH_TRACE_BUCKET_COUNT 24
+
+/* The request codes are 0x80 to 0xFF, APP messages are traced with the request code 0.*/
+#define LIBSPDM_BENCH_TRACE_REQUEST_CODE_COUNT 0x80
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_time_ns;
+    uint64_t min_time_ns;
+    uint64_t max_time_ns;
+    uint64_t total_size;
+    uint32_t histogram[LIBSPDM_BENCH_TRACE_BUCKET_COUNT];
+} libspdm_bench_trace_entry_t;
+
+typedef struct {
+    libspdm_bench_trace_entry_t
+        entry[LIBSPDM_BENCH_TRACE_REQUEST_CODE_COUNT][LIBSPDM_TRACE_PHASE_MAX];
+} libspdm_bench_trace_t;
+
+/**
+ * Clear the aggregated latencies of a trace sink.
+ *
+ * @param  trace          The trace sink.
+ **/
+void libspdm_bench_trace_reset(libspdm_bench_trace_t *trace);
+
+/**
+ * Register a trace sink as the trace function of an SPDM context.
+ *
+ * Several contexts can have a sink, each context has at most one.
+ *
+ * @param  trace          The trace sink.
+ * @param  spdm_context   The SPDM context.
+ *
+ * @retval true   The sink receives the events of the context.
+ * @retval false  Too many contexts have a sink.
+ **/
+bool libspdm_bench_trace_attach(libspdm_bench_trace_t *trace, void *spdm_context);
+
+/**
+ * Unregister the trace sink of an SPDM context.
+ *
+ * @param  spdm_context   The SPDM context.
+ **/
+void libspdm_bench_trace_detach(void *spdm_context);
+
+/**
+ * Print the latency of every traced request code and phase, with the histogram percentiles.
+ *
+ * @param  name           The name of the trace sink.
+ * @param  trace          The trace sink.
+ **/
+void libspdm_bench_trace_dump(const char *name, const libspdm_bench_trace_t *trace);
+
+#endif
@@ -0,0 +1,731 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Microbenchmark of the crypto primitives used by libspdm, for the selected crypto backend.
+ *
+ * Measures:
+ *  - hash, HMAC:          every hash algorithm, at several message sizes,
+ *  - HKDF:                extract and expand of every hash algorithm,
+ *  - AEAD:                encrypt and decrypt of every cipher suite, at several message sizes,
+ *  - sign, verify:        every asym algorithm, with the sample keys, on a 64 byte SPDM 1.2 message,
+ *  - DHE:                 keygen (new + generate + free) and derive of every named group,
+ *  - X.509:               parse of the leaf certificate and verify of the sample chains,
+ *  - random:              random bytes.
+ * The bulk operations are also reported in MB/s and cycles per byte.
+ * A primitive that fails during the warmup is reported as not supported by the backend.
+ *
+ * The backend is selected at build time, with -DCRYPTO=mbedtls or -DCRYPTO=openssl.
+ *
+ * Usage: bench_crypt [iterations] [warmup] [filter]
+ * Only the primitives whose name contains filter are run.
+ **/
+
+#include "bench_common.h"
+#include "spdm_device_secret_lib_internal.h"
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 100
+#define LIBSPDM_BENCH_DEFAULT_WARMUP 10
+
+/* The largest bulk message, the largest SPDM secured message payload.*/
+#define LIBSPDM_BENCH_CRYPT_MAX_DATA_SIZE 4096
+
+#define LIBSPDM_BENCH_STRING(x) #x
+#define LIBSPDM_BENCH_XSTRING(x) LIBSPDM_BENCH_STRING(x)
+#ifdef LIBSPDM_BENCH_CRYPTO
+#define LIBSPDM_BENCH_CRYPT_BACKEND LIBSPDM_BENCH_XSTRING(LIBSPDM_BENCH_CRYPTO)
+#else
+#define LIBSPDM_BENCH_CRYPT_BACKEND "unknown"
+#endif
+
+typedef bool (*libspdm_bench_crypt_func_t)(void *context);
+
+typedef bool (*libspdm_bench_hash_all_func_t)(const void *data, uintn data_size,
+                                              uint8_t *hash_value);
+typedef bool (*libspdm_bench_hmac_all_func_t)(const void *data, uintn data_size,
+                                              const uint8_t *key, uintn key_size,
+                                              uint8_t *hmac_value);
+typedef bool (*libspdm_bench_hkdf_extract_func_t)(const uint8_t *key, uintn key_size,
+                                                  const uint8_t *salt, uintn salt_size,
+                                                  uint8_t *prk_out, uintn prk_out_size);
+typedef bool (*libspdm_bench_hkdf_expand_func_t)(const uint8_t *prk, uintn prk_size,
+                                                 const uint8_t *info, uintn info_size,
+                                                 uint8_t *out, uintn out_size);
+typedef bool (*libspdm_bench_aead_encrypt_func_t)(const uint8_t *key, uintn key_size,
+                                                  const uint8_t *iv, uintn iv_size,
+                                                  const uint8_t *a_data, uintn a_data_size,
+                                                  const uint8_t *data_in, uintn data_in_size,
+                                                  uint8_t *tag_out, uintn tag_size,
+                                                  uint8_t *data_out, uintn *data_out_size);
+typedef bool (*libspdm_bench_aead_decrypt_func_t)(const uint8_t *key, uintn key_size,
+                                                  const uint8_t *iv, uintn iv_size,
+                                                  const uint8_t *a_data, uintn a_data_size,
+                                                  const uint8_t *data_in, uintn data_in_size,
+                                                  const uint8_t *tag, uintn tag_size,
+                                                  uint8_t *data_out, uintn *data_out_size);
+
+typedef struct {
+    const char *name;
+    uintn hash_size;
+    libspdm_bench_hash_all_func_t hash_all;
+    libspdm_bench_hmac_all_func_t hmac_all;
+    libspdm_bench_hkdf_extract_func_t hkdf_extract;
+    libspdm_bench_hkdf_expand_func_t hkdf_expand;
+} libspdm_bench_crypt_hash_t;
+
+static const libspdm_bench_crypt_hash_t m_libspdm_bench_crypt_hash[] = {
+#if LIBSPDM_SHA256_SUPPORT
+    { "sha256", LIBSPDM_SHA256_DIGEST_SIZE, libspdm_sha256_hash_all, libspdm_hmac_sha256_all,
+      libspdm_hkdf_sha256_extract, libspdm_hkdf_sha256_expand },
+#endif
+#if LIBSPDM_SHA384_SUPPORT
+    { "sha384", LIBSPDM_SHA384_DIGEST_SIZE, libspdm_sha384_hash_all, libspdm_hmac_sha384_all,
+      libspdm_hkdf_sha384_extract, libspdm_hkdf_sha384_expand },
+#endif
+#if LIBSPDM_SHA512_SUPPORT
+    { "sha512", LIBSPDM_SHA512_DIGEST_SIZE, libspdm_sha512_hash_all, libspdm_hmac_sha512_all,
+      libspdm_hkdf_sha512_extract, libspdm_hkdf_sha512_expand },
+#endif
+#if LIBSPDM_SHA3_256_SUPPORT
+    { "sha3_256", LIBSPDM_SHA3_256_DIGEST_SIZE, libspdm_sha3_256_hash_all,
+      libspdm_hmac_sha3_256_all, libspdm_hkdf_sha3_256_extract, libspdm_hkdf_sha3_256_expand },
+#endif
+#if LIBSPDM_SHA3_384_SUPPORT
+    { "sha3_384", LIBSPDM_SHA3_384_DIGEST_SIZE, libspdm_sha3_384_hash_all,
+      libspdm_hmac_sha3_384_all, libspdm_hkdf_sha3_384_extract, libspdm_hkdf_sha3_384_expand },
+#endif
+#if LIBSPDM_SHA3_512_SUPPORT
+    { "sha3_512", LIBSPDM_SHA3_512_DIGEST_SIZE, libspdm_sha3_512_hash_all,
+      libspdm_hmac_sha3_512_all, libspdm_hkdf_sha3_512_extract, libspdm_hkdf_sha3_512_expand },
+#endif
+#if LIBSPDM_SM3_256_SUPPORT
+    { "sm3_256", LIBSPDM_SM3_256_DIGEST_SIZE, libspdm_sm3_256_hash_all,
+      libspdm_hmac_sm3_256_all, libspdm_hkdf_sm3_256_extract, libspdm_hkdf_sm3_256_expand },
+#endif
+};
+
+typedef struct {
+    const char *name;
+    uintn key_size;
+    libspdm_bench_aead_encrypt_func_t encrypt;
+    libspdm_bench_aead_decrypt_func_t decrypt;
+} libspdm_bench_crypt_aead_t;
+
+static const libspdm_bench_crypt_aead_t m_libspdm_bench_crypt_aead[] = {
+#if LIBSPDM_AEAD_GCM_SUPPORT
+    { "aes128gcm", 16, libspdm_aead_aes_gcm_encrypt, libspdm_aead_aes_gcm_decrypt },
+    { "aes256gcm", 32, libspdm_aead_aes_gcm_encrypt, libspdm_aead_aes_gcm_decrypt },
+#endif
+#if LIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT
+    { "chacha20poly1305", 32, libspdm_aead_chacha20_poly1305_encrypt,
+      libspdm_aead_chacha20_poly1305_decrypt },
+#endif
+#if LIBSPDM_AEAD_SM4_SUPPORT
+    { "sm4gcm", 16, libspdm_aead_sm4_gcm_encrypt, libspdm_aead_sm4_gcm_decrypt },
+#endif
+};
+
+typedef struct {
+    uint32_t asym_algo;
+    uint32_t hash_algo;
+    const char *name;
+} libspdm_bench_crypt_asym_t;
+
+static const libspdm_bench_crypt_asym_t m_libspdm_bench_crypt_asym[] = {
+#if (LIBSPDM_RSA_SSA_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "rsassa2048" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_3072,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, "rsassa3072" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_4096,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512, "rsassa4096" },
+#endif
+#if (LIBSPDM_RSA_PSS_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_2048,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "rsapss2048" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_3072,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, "rsapss3072" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_4096,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512, "rsapss4096" },
+#endif
+#if (LIBSPDM_ECDSA_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "ecdsa_p256" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, "ecdsa_p384" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P521,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512, "ecdsa_p521" },
+#endif
+#if (LIBSPDM_SM2_DSA_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_SM2_ECC_SM2_P256,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256, "sm2_p256" },
+#endif
+#if (LIBSPDM_EDDSA_ED25519_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_EDDSA_ED25519,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512, "ed25519" },
+#endif
+#if (LIBSPDM_EDDSA_ED448_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_EDDSA_ED448,
+      SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512, "ed448" },
+#endif
+};
+
+typedef struct {
+    uint16_t dhe_named_group;
+    const char *name;
+} libspdm_bench_crypt_dhe_t;
+
+static const libspdm_bench_crypt_dhe_t m_libspdm_bench_crypt_dhe[] = {
+#if (LIBSPDM_FFDHE_SUPPORT == 1)
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_2048, "ffdhe2048" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_3072, "ffdhe3072" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_4096, "ffdhe4096" },
+#endif
+#if (LIBSPDM_ECDHE_SUPPORT == 1)
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1, "secp256r1" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1, "secp384r1" },
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_521_R1, "secp521r1" },
+#endif
+#if (LIBSPDM_SM2_KEY_EXCHANGE_SUPPORT == 1)
+    { SPDM_ALGORITHMS_DHE_NAMED_GROUP_SM2_P256, "sm2_p256" },
+#endif
+};
+
+static const uintn m_libspdm_bench_crypt_data_size[] = { 64, 1024, 4096 };
+
+/* The operation arguments, shared by all the operations.*/
+typedef struct {
+    const libspdm_bench_crypt_hash_t *hash;
+    const libspdm_bench_crypt_aead_t *aead;
+    const libspdm_bench_crypt_asym_t *asym;
+    uint16_t dhe_named_group;
+    uintn data_size;
+    void *context;
+    void *peer_context;
+    uint8_t *cert;
+    uintn cert_size;
+    uint8_t *root_cert;
+    uintn root_cert_size;
+    uint8_t *cert_chain;
+    uintn cert_chain_size;
+    uint8_t key[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t iv[12];
+    uint8_t tag[16];
+    uint8_t public_key[LIBSPDM_MAX_DHE_KEY_SIZE];
+    uintn public_key_size;
+    uint8_t peer_public_key[LIBSPDM_MAX_DHE_KEY_SIZE];
+    uintn peer_public_key_size;
+    uint8_t signature[LIBSPDM_MAX_ASYM_KEY_SIZE];
+    uintn sig_size;
+    uint8_t data[LIBSPDM_BENCH_CRYPT_MAX_DATA_SIZE];
+    uint8_t output[LIBSPDM_BENCH_CRYPT_MAX_DATA_SIZE];
+} libspdm_bench_crypt_state_t;
+
+static libspdm_bench_crypt_state_t m_libspdm_bench_crypt_state;
+static uintn m_libspdm_bench_iterations;
+static uintn m_libspdm_bench_warmup;
+static const char *m_libspdm_bench_filter;
+
+static void libspdm_bench_crypt_report(const char *name, uintn data_size, uintn iterations,
+                                       uint64_t elapsed_ns, uint64_t elapsed_cycles)
+{
+    if ((data_size == 0) || (elapsed_ns == 0)) {
+        libspdm_bench_report(name, iterations, elapsed_ns);
+        return;
+    }
+    printf("%-48s %12.2f us/op %12.1f ops/s %10.1f MB/s %8.2f cycles/B\n", name,
+           (double)elapsed_ns / 1000.0 / (double)iterations,
+           (double)iterations * 1000000000.0 / (double)elapsed_ns,
+           (double)(data_size * iterations) * 1000.0 / (double)elapsed_ns,
+           (double)elapsed_cycles / (double)(data_size * iterations));
+}
+
+static bool libspdm_bench_crypt_is_selected(const char *name)
+{
+    return (m_libspdm_bench_filter == NULL) || (strstr(name, m_libspdm_bench_filter) != NULL);
+}
+
+static void libspdm_bench_crypt_report_unsupported(const char *name)
+{
+    if (libspdm_bench_crypt_is_selected(name)) {
+        printf("%-48s %10s\n", name, "not supported");
+    }
+}
+
+/* Run an operation, after the warmup. An operation that fails during the warmup is skipped.*/
+static bool libspdm_bench_crypt_run(const char *name, uintn data_size,
+                                    libspdm_bench_crypt_func_t func)
+{
+    libspdm_bench_crypt_state_t *state;
+    uint64_t start_time;
+    uint64_t start_cycles;
+    uint64_t elapsed_ns;
+    uint64_t elapsed_cycles;
+    uintn index;
+
+    if (!libspdm_bench_crypt_is_selected(name)) {
+        return true;
+    }
+    state = &m_libspdm_bench_crypt_state;
+    for (index = 0; index < m_libspdm_bench_warmup; index++) {
+        if (!func(state)) {
+            libspdm_bench_crypt_report_unsupported(name);
+            return true;
+        }
+    }
+
+    start_time = libspdm_bench_get_time_ns();
+    start_cycles = libspdm_bench_get_cycles();
+    for (index = 0; index < m_libspdm_bench_iterations; index++) {
+        if (!func(state)) {
+            printf("%s - FAIL\n", name);
+            return false;
+        }
+    }
+    elapsed_cycles = libspdm_bench_get_cycles() - start_cycles;
+    elapsed_ns = libspdm_bench_get_time_ns() - start_time;
+
+    libspdm_bench_crypt_report(name, data_size, m_libspdm_bench_iterations, elapsed_ns,
+                               elapsed_cycles);
+    return true;
+}
+
+static bool libspdm_bench_crypt_hash_all(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+
+    state = context;
+    return state->hash->hash_all(state->data, state->data_size, state->output);
+}
+
+static bool libspdm_bench_crypt_hmac_all(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+
+    state = context;
+    return state->hash->hmac_all(state->data, state->data_size, state->key,
+                                 state->hash->hash_size, state->output);
+}
+
+static bool libspdm_bench_crypt_hkdf_extract(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+
+    state = context;
+    return state->hash->hkdf_extract(state->data, state->hash->hash_size, state->key,
+                                     state->hash->hash_size, state->output,
+                                     state->hash->hash_size);
+}
+
+static bool libspdm_bench_crypt_hkdf_expand(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+
+    state = context;
+    return state->hash->hkdf_expand(state->key, state->hash->hash_size, state->data, 16,
+                                    state->output, state->hash->hash_size);
+}
+
+static bool libspdm_bench_crypt_aead_encrypt(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+    uintn output_size;
+
+    state = context;
+    output_size = sizeof(state->output);
+    return state->aead->encrypt(state->key, state->aead->key_size, state->iv,
+                                sizeof(state->iv), state->iv, sizeof(state->iv),
+                                state->data, state->data_size, state->tag, sizeof(state->tag),
+                                state->output, &output_size);
+}
+
+static bool libspdm_bench_crypt_aead_decrypt(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+    uintn data_size;
+
+    state = context;
+    data_size = sizeof(state->data);
+    return state->aead->decrypt(state->key, state->aead->key_size, state->iv,
+                                sizeof(state->iv), state->iv, sizeof(state->iv),
+                                state->output, state->data_size, state->tag, sizeof(state->tag),
+                                state->data, &data_size);
+}
+
+static bool libspdm_bench_crypt_sign(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+
+    state = context;
+    state->sig_size = sizeof(state->signature);
+    return libspdm_asym_sign(
+        SPDM_MESSAGE_VERSION_12 << SPDM_VERSION_NUMBER_SHIFT_BIT, SPDM_CHALLENGE_AUTH,
+        state->asym->asym_algo, state->asym->hash_algo, state->context, state->data, 64,
+        state->signature, &state->sig_size);
+}
+
+static bool libspdm_bench_crypt_verify(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+
+    state = context;
+    return libspdm_asym_verify(
+        SPDM_MESSAGE_VERSION_12 << SPDM_VERSION_NUMBER_SHIFT_BIT, SPDM_CHALLENGE_AUTH,
+        state->asym->asym_algo, state->asym->hash_algo, state->peer_context, state->data, 64,
+        state->signature, state->sig_size);
+}
+
+static bool libspdm_bench_crypt_dhe_keygen(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+    void *dhe_context;
+    bool result;
+
+    state = context;
+    dhe_context = libspdm_dhe_new(SPDM_MESSAGE_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+                                  state->dhe_named_group, true);
+    if (dhe_context == NULL) {
+        return false;
+    }
+    state->public_key_size = sizeof(state->public_key);
+    result = libspdm_dhe_generate_key(state->dhe_named_group, dhe_context, state->public_key,
+                                      &state->public_key_size);
+    libspdm_dhe_free(state->dhe_named_group, dhe_context);
+    return result;
+}
+
+static bool libspdm_bench_crypt_dhe_derive(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+    uintn key_size;
+
+    state = context;
+    key_size = sizeof(state->output);
+    return libspdm_dhe_compute_key(state->dhe_named_group, state->context,
+                                   state->peer_public_key, state->peer_public_key_size,
+                                   state->output, &key_size);
+}
+
+static bool libspdm_bench_crypt_x509_parse(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+    uint8_t *x509_cert;
+    uintn subject_size;
+    bool result;
+
+    state = context;
+    x509_cert = NULL;
+    if (!libspdm_x509_construct_certificate(state->cert, state->cert_size, &x509_cert)) {
+        return false;
+    }
+    libspdm_x509_free(x509_cert);
+    subject_size = sizeof(state->output);
+    result = libspdm_x509_get_subject_name(state->cert, state->cert_size, state->output,
+                                           &subject_size);
+    return result;
+}
+
+static bool libspdm_bench_crypt_x509_verify(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+
+    state = context;
+    /* measure the signature checks, not the verification cache*/
+    libspdm_x509_verify_cache_flush();
+    return libspdm_x509_verify_cert_chain(state->root_cert, state->root_cert_size,
+                                          state->cert_chain, state->cert_chain_size);
+}
+
+static bool libspdm_bench_crypt_random(void *context)
+{
+    libspdm_bench_crypt_state_t *state;
+
+    state = context;
+    return libspdm_random_bytes(state->output, state->data_size);
+}
+
+static bool libspdm_bench_crypt_hash(void)
+{
+    libspdm_bench_crypt_state_t *state;
+    uintn index;
+    uintn size_index;
+    char name[64];
+
+    state = &m_libspdm_bench_crypt_state;
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_crypt_hash); index++) {
+        state->hash = &m_libspdm_bench_crypt_hash[index];
+        for (size_index = 0; size_index < ARRAY_SIZE(m_libspdm_bench_crypt_data_size);
+             size_index++) {
+            state->data_size = m_libspdm_bench_crypt_data_size[size_index];
+            snprintf(name, sizeof(name), "hash %s %d", state->hash->name, (int)state->data_size);
+            if (!libspdm_bench_crypt_run(name, state->data_size, libspdm_bench_crypt_hash_all)) {
+                return false;
+            }
+            snprintf(name, sizeof(name), "hmac %s %d", state->hash->name, (int)state->data_size);
+            if (!libspdm_bench_crypt_run(name, state->data_size, libspdm_bench_crypt_hmac_all)) {
+                return false;
+            }
+        }
+        snprintf(name, sizeof(name), "hkdf %s extract", state->hash->name);
+        if (!libspdm_bench_crypt_run(name, 0, libspdm_bench_crypt_hkdf_extract)) {
+            return false;
+        }
+        snprintf(name, sizeof(name), "hkdf %s expand", state->hash->name);
+        if (!libspdm_bench_crypt_run(name, 0, libspdm_bench_crypt_hkdf_expand)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool libspdm_bench_crypt_aead(void)
+{
+    libspdm_bench_crypt_state_t *state;
+    uintn index;
+    uintn size_index;
+    char name[64];
+
+    state = &m_libspdm_bench_crypt_state;
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_crypt_aead); index++) {
+        state->aead = &m_libspdm_bench_crypt_aead[index];
+        for (size_index = 0; size_index < ARRAY_SIZE(m_libspdm_bench_crypt_data_size);
+             size_index++) {
+            state->data_size = m_libspdm_bench_crypt_data_size[size_index];
+            snprintf(name, sizeof(name), "aead %s encrypt %d", state->aead->name,
+                     (int)state->data_size);
+            if (!libspdm_bench_crypt_run(name, state->data_size,
+                                         libspdm_bench_crypt_aead_encrypt)) {
+                return false;
+            }
+            /* decrypt the output of the encryption*/
+            libspdm_bench_crypt_aead_encrypt(state);
+            snprintf(name, sizeof(name), "aead %s decrypt %d", state->aead->name,
+                     (int)state->data_size);
+            if (!libspdm_bench_crypt_run(name, state->data_size,
+                                         libspdm_bench_crypt_aead_decrypt)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Load the private key and the public key of the sample responder certificate.*/
+static bool libspdm_bench_crypt_load_asym_key(libspdm_bench_crypt_state_t *state)
+{
+    void *private_pem;
+    uintn private_pem_size;
+    void *cert_chain;
+    uintn cert_chain_size;
+    const uint8_t *leaf_cert;
+    uintn leaf_cert_size;
+    bool result;
+
+    if (!libspdm_read_responder_private_certificate(state->asym->asym_algo, &private_pem,
+                                                    &private_pem_size)) {
+        return false;
+    }
+    result = libspdm_asym_get_private_key_from_pem(state->asym->asym_algo, private_pem,
+                                                   private_pem_size, NULL, &state->context);
+    free(private_pem);
+    if (!result) {
+        return false;
+    }
+
+    if (!libspdm_read_responder_public_certificate_chain(state->asym->hash_algo,
+                                                         state->asym->asym_algo, &cert_chain,
+                                                         &cert_chain_size, NULL, NULL)) {
+        return false;
+    }
+    result = libspdm_x509_get_cert_from_cert_chain(
+        (uint8_t *)cert_chain + sizeof(spdm_cert_chain_t) +
+        libspdm_get_hash_size(state->asym->hash_algo),
+        cert_chain_size - sizeof(spdm_cert_chain_t) -
+        libspdm_get_hash_size(state->asym->hash_algo),
+        -1, (uint8_t **)&leaf_cert, &leaf_cert_size) &&
+             libspdm_asym_get_public_key_from_x509(state->asym->asym_algo, leaf_cert,
+                                                   leaf_cert_size, &state->peer_context);
+    free(cert_chain);
+    return result;
+}
+
+static bool libspdm_bench_crypt_asym(void)
+{
+    libspdm_bench_crypt_state_t *state;
+    uintn index;
+    char name[64];
+    bool result;
+
+    state = &m_libspdm_bench_crypt_state;
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_crypt_asym); index++) {
+        state->asym = &m_libspdm_bench_crypt_asym[index];
+        state->context = NULL;
+        state->peer_context = NULL;
+        snprintf(name, sizeof(name), "%s sign", state->asym->name);
+        result = true;
+        if (!libspdm_bench_crypt_load_asym_key(state)) {
+            libspdm_bench_crypt_report_unsupported(name);
+        } else {
+            result = libspdm_bench_crypt_run(name, 0, libspdm_bench_crypt_sign);
+            /* verify the output of the signature*/
+            snprintf(name, sizeof(name), "%s verify", state->asym->name);
+            if (result && !libspdm_bench_crypt_sign(state)) {
+                libspdm_bench_crypt_report_unsupported(name);
+            } else if (result) {
+                result = libspdm_bench_crypt_run(name, 0, libspdm_bench_crypt_verify);
+            }
+        }
+        if (state->context != NULL) {
+            libspdm_asym_free(state->asym->asym_algo, state->context);
+        }
+        if (state->peer_context != NULL) {
+            libspdm_asym_free(state->asym->asym_algo, state->peer_context);
+        }
+        if (!result) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool libspdm_bench_crypt_dhe(void)
+{
+    libspdm_bench_crypt_state_t *state;
+    void *peer_context;
+    uintn index;
+    char name[64];
+    bool result;
+
+    state = &m_libspdm_bench_crypt_state;
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_crypt_dhe); index++) {
+        state->dhe_named_group = m_libspdm_bench_crypt_dhe[index].dhe_named_group;
+        snprintf(name, sizeof(name), "dhe %s keygen", m_libspdm_bench_crypt_dhe[index].name);
+        if (!libspdm_bench_crypt_run(name, 0, libspdm_bench_crypt_dhe_keygen)) {
+            return false;
+        }
+
+        /* derive with a fixed key pair and peer public key*/
+        snprintf(name, sizeof(name), "dhe %s derive", m_libspdm_bench_crypt_dhe[index].name);
+        state->context = libspdm_dhe_new(
+            SPDM_MESSAGE_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT, state->dhe_named_group,
+            true);
+        peer_context = libspdm_dhe_new(
+            SPDM_MESSAGE_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT, state->dhe_named_group,
+            false);
+        state->public_key_size = sizeof(state->public_key);
+        state->peer_public_key_size = sizeof(state->peer_public_key);
+        if ((state->context == NULL) || (peer_context == NULL) ||
+            !libspdm_dhe_generate_key(state->dhe_named_group, state->context,
+                                      state->public_key, &state->public_key_size) ||
+            !libspdm_dhe_generate_key(state->dhe_named_group, peer_context,
+                                      state->peer_public_key, &state->peer_public_key_size)) {
+            libspdm_bench_crypt_report_unsupported(name);
+            result = true;
+        } else {
+            result = libspdm_bench_crypt_run(name, 0, libspdm_bench_crypt_dhe_derive);
+        }
+        if (state->context != NULL) {
+            libspdm_dhe_free(state->dhe_named_group, state->context);
+            state->context = NULL;
+        }
+        if (peer_context != NULL) {
+            libspdm_dhe_free(state->dhe_named_group, peer_context);
+        }
+        if (!result) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool libspdm_bench_crypt_x509(void)
+{
+    libspdm_bench_crypt_state_t *state;
+    void *cert_chain;
+    uintn cert_chain_size;
+    uintn hash_size;
+    uintn index;
+    char name[64];
+    bool result;
+
+    state = &m_libspdm_bench_crypt_state;
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_crypt_asym); index++) {
+        state->asym = &m_libspdm_bench_crypt_asym[index];
+        snprintf(name, sizeof(name), "x509 %s parse", state->asym->name);
+        if (!libspdm_read_responder_public_certificate_chain(
+                state->asym->hash_algo, state->asym->asym_algo, &cert_chain,
+                &cert_chain_size, NULL, NULL)) {
+            libspdm_bench_crypt_report_unsupported(name);
+            continue;
+        }
+        hash_size = libspdm_get_hash_size(state->asym->hash_algo);
+        state->cert_chain = (uint8_t *)cert_chain + sizeof(spdm_cert_chain_t) + hash_size;
+        state->cert_chain_size = cert_chain_size - sizeof(spdm_cert_chain_t) - hash_size;
+        if (!libspdm_x509_get_cert_from_cert_chain(state->cert_chain, state->cert_chain_size,
+                                                   0, &state->root_cert,
+                                                   &state->root_cert_size) ||
+            !libspdm_x509_get_cert_from_cert_chain(state->cert_chain, state->cert_chain_size,
+                                                   -1, &state->cert, &state->cert_size)) {
+            libspdm_bench_crypt_report_unsupported(name);
+            free(cert_chain);
+            continue;
+        }
+        result = libspdm_bench_crypt_run(name, 0, libspdm_bench_crypt_x509_parse);
+        snprintf(name, sizeof(name), "x509 %s verify chain", state->asym->name);
+        result = result && libspdm_bench_crypt_run(name, 0, libspdm_bench_crypt_x509_verify);
+        free(cert_chain);
+        if (!result) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    libspdm_bench_crypt_state_t *state;
+    uintn index;
+    int return_value;
+
+    m_libspdm_bench_iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    m_libspdm_bench_warmup = LIBSPDM_BENCH_DEFAULT_WARMUP;
+    if (argc > 1) {
+        m_libspdm_bench_iterations = (uintn)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        m_libspdm_bench_warmup = (uintn)strtoul(argv[2], NULL, 0);
+    }
+    if (argc > 3) {
+        m_libspdm_bench_filter = argv[3];
+    }
+    /* the warmup also detects the primitives that the backend does not support*/
+    if (m_libspdm_bench_warmup == 0) {
+        m_libspdm_bench_warmup = 1;
+    }
+
+    state = &m_libspdm_bench_crypt_state;
+    for (index = 0; index < sizeof(state->data); index++) {
+        state->data[index] = (uint8_t)index;
+    }
+    libspdm_set_mem(state->key, sizeof(state->key), 0x5a);
+    libspdm_set_mem(state->iv, sizeof(state->iv), 0xa5);
+
+    printf("crypto: %s\n", LIBSPDM_BENCH_CRYPT_BACKEND);
+    return_value = 0;
+    if (!libspdm_bench_crypt_hash() ||
+        !libspdm_bench_crypt_aead() ||
+        !libspdm_bench_crypt_asym() ||
+        !libspdm_bench_crypt_dhe() ||
+        !libspdm_bench_crypt_x509()) {
+        return_value = 1;
+    }
+    state->data_size = 32;
+    if (!libspdm_bench_crypt_run("random 32", state->data_size, libspdm_bench_crypt_random)) {
+        return_value = 1;
+    }
+
+    return return_value;
+}
@@ -0,0 +1,127 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * EC benchmark for the crypto backend.
+ *
+ * Measures the operations that multiply by the curve generator:
+ *  - keygen: new context + ephemeral key generation + free, as done per ECDHE session,
+ *  - sign:   EC-DSA signature with a long-term key context,
+ *  - verify: EC-DSA verification.
+ *
+ * Usage: bench_crypt_ec [iterations]
+ **/
+
+#include "bench_common.h"
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 200
+
+typedef struct {
+    uintn nid;
+    uintn hash_nid;
+    uintn hash_size;
+    const char *name;
+} libspdm_bench_ec_curve_t;
+
+static const libspdm_bench_ec_curve_t m_libspdm_bench_ec_curve[] = {
+    { LIBSPDM_CRYPTO_NID_SECP256R1, LIBSPDM_CRYPTO_NID_SHA256, LIBSPDM_SHA256_DIGEST_SIZE, "p256" },
+    { LIBSPDM_CRYPTO_NID_SECP384R1, LIBSPDM_CRYPTO_NID_SHA384, LIBSPDM_SHA384_DIGEST_SIZE, "p384" },
+    { LIBSPDM_CRYPTO_NID_SECP521R1, LIBSPDM_CRYPTO_NID_SHA512, LIBSPDM_SHA512_DIGEST_SIZE, "p521" },
+};
+
+static bool libspdm_bench_ec(const libspdm_bench_ec_curve_t *curve, uintn iterations)
+{
+    void *ec_context;
+    void *key_context;
+    uint8_t public_key[66 * 2];
+    uintn public_key_size;
+    uint8_t message_hash[LIBSPDM_SHA512_DIGEST_SIZE];
+    uint8_t signature[66 * 2];
+    uintn sig_size;
+    uintn index;
+    uint64_t start;
+    char name[64];
+    bool result;
+
+    libspdm_set_mem(message_hash, sizeof(message_hash), 0x5a);
+
+    /* keygen*/
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        ec_context = libspdm_ec_new_by_nid(curve->nid);
+        if (ec_context == NULL) {
+            return false;
+        }
+        public_key_size = sizeof(public_key);
+        result = libspdm_ec_generate_key(ec_context, public_key, &public_key_size);
+        libspdm_ec_free(ec_context);
+        if (!result) {
+            return false;
+        }
+    }
+    snprintf(name, sizeof(name), "ec %s keygen", curve->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    key_context = libspdm_ec_new_by_nid(curve->nid);
+    if (key_context == NULL) {
+        return false;
+    }
+    public_key_size = sizeof(public_key);
+    if (!libspdm_ec_generate_key(key_context, public_key, &public_key_size)) {
+        libspdm_ec_free(key_context);
+        return false;
+    }
+
+    /* sign*/
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        sig_size = sizeof(signature);
+        if (!libspdm_ecdsa_sign(key_context, curve->hash_nid, message_hash,
+                                curve->hash_size, signature, &sig_size)) {
+            libspdm_ec_free(key_context);
+            return false;
+        }
+    }
+    snprintf(name, sizeof(name), "ecdsa %s sign", curve->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    /* verify*/
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_ecdsa_verify(key_context, curve->hash_nid, message_hash,
+                                  curve->hash_size, signature, sig_size)) {
+            libspdm_ec_free(key_context);
+            return false;
+        }
+    }
+    snprintf(name, sizeof(name), "ecdsa %s verify", curve->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    libspdm_ec_free(key_context);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uintn iterations;
+    uintn index;
+    int return_value;
+
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = (uintn)strtoul(argv[1], NULL, 0);
+    }
+
+    return_value = 0;
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_ec_curve); index++) {
+        if (!libspdm_bench_ec(&m_libspdm_bench_ec_curve[index], iterations)) {
+            printf("ec %s - FAIL\n", m_libspdm_bench_ec_curve[index].name);
+            return_value = 1;
+        }
+    }
+
+    return return_value;
+}
@@ -0,0 +1,218 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Signing benchmark for the sample device secret library.
+ *
+ * For every asym algorithm it compares:
+ *  - load:     read the PEM key file and parse it (the cost removed by the key cache),
+ *  - uncached: load + sign + free, as every signature used to do,
+ *  - cached:   libspdm_responder_data_sign / libspdm_requester_data_sign with a warm cache.
+ *
+ * Usage: bench_device_sign [iterations]
+ **/
+
+#include "bench_common.h"
+#include "library/spdm_device_secret_lib.h"
+#include "spdm_device_secret_lib_internal.h"
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 100
+
+typedef struct {
+    uint32_t asym_algo;
+    const char *name;
+} libspdm_bench_asym_algo_t;
+
+static const libspdm_bench_asym_algo_t m_libspdm_bench_asym_algo[] = {
+#if (LIBSPDM_RSA_SSA_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048, "rsassa2048" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_3072, "rsassa3072" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_4096, "rsassa4096" },
+#endif
+#if (LIBSPDM_RSA_PSS_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_2048, "rsapss2048" },
+#endif
+#if (LIBSPDM_ECDSA_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256, "ecdsa_p256" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384, "ecdsa_p384" },
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P521, "ecdsa_p521" },
+#endif
+#if (LIBSPDM_SM2_DSA_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_SM2_ECC_SM2_P256, "sm2_p256" },
+#endif
+#if (LIBSPDM_EDDSA_ED25519_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_EDDSA_ED25519, "ed25519" },
+#endif
+#if (LIBSPDM_EDDSA_ED448_SUPPORT == 1)
+    { SPDM_ALGORITHMS_BASE_ASYM_ALGO_EDDSA_ED448, "ed448" },
+#endif
+};
+
+static uint8_t m_libspdm_bench_message[256];
+
+static uint32_t libspdm_bench_get_hash_algo(uint32_t asym_algo)
+{
+    if (asym_algo == SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_SM2_ECC_SM2_P256) {
+        return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256;
+    }
+    return SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256;
+}
+
+/* Read and parse the key, as the device secret library did for every signature. */
+static bool libspdm_bench_load_key(bool is_requester, uint32_t asym_algo, void **context)
+{
+    void *private_pem;
+    uintn private_pem_size;
+    bool result;
+
+    if (is_requester) {
+        result = libspdm_read_requester_private_certificate(
+            (uint16_t)asym_algo, &private_pem, &private_pem_size);
+    } else {
+        result = libspdm_read_responder_private_certificate(
+            asym_algo, &private_pem, &private_pem_size);
+    }
+    if (!result) {
+        return false;
+    }
+    if (is_requester) {
+        result = libspdm_req_asym_get_private_key_from_pem(
+            (uint16_t)asym_algo, private_pem, private_pem_size, NULL, context);
+    } else {
+        result = libspdm_asym_get_private_key_from_pem(
+            asym_algo, private_pem, private_pem_size, NULL, context);
+    }
+    free(private_pem);
+    return result;
+}
+
+static bool libspdm_bench_uncached_sign(bool is_requester, uint32_t asym_algo,
+                                        uint8_t *signature, uintn *sig_size)
+{
+    void *context;
+    bool result;
+
+    if (!libspdm_bench_load_key(is_requester, asym_algo, &context)) {
+        return false;
+    }
+    if (is_requester) {
+        result = libspdm_req_asym_sign(
+            SPDM_MESSAGE_VERSION_12 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+            SPDM_FINISH, (uint16_t)asym_algo, libspdm_bench_get_hash_algo(asym_algo),
+            context, m_libspdm_bench_message, sizeof(m_libspdm_bench_message),
+            signature, sig_size);
+        libspdm_req_asym_free((uint16_t)asym_algo, context);
+    } else {
+        result = libspdm_asym_sign(
+            SPDM_MESSAGE_VERSION_12 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+            SPDM_CHALLENGE_AUTH, asym_algo, libspdm_bench_get_hash_algo(asym_algo),
+            context, m_libspdm_bench_message, sizeof(m_libspdm_bench_message),
+            signature, sig_size);
+        libspdm_asym_free(asym_algo, context);
+    }
+    return result;
+}
+
+static bool libspdm_bench_cached_sign(bool is_requester, uint32_t asym_algo,
+                                      uint8_t *signature, uintn *sig_size)
+{
+    if (is_requester) {
+        return libspdm_requester_data_sign(
+            SPDM_MESSAGE_VERSION_12 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+            SPDM_FINISH, (uint16_t)asym_algo, libspdm_bench_get_hash_algo(asym_algo),
+            false, m_libspdm_bench_message, sizeof(m_libspdm_bench_message),
+            signature, sig_size);
+    } else {
+        return libspdm_responder_data_sign(
+            SPDM_MESSAGE_VERSION_12 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+            SPDM_CHALLENGE_AUTH, asym_algo, libspdm_bench_get_hash_algo(asym_algo),
+            false, m_libspdm_bench_message, sizeof(m_libspdm_bench_message),
+            signature, sig_size);
+    }
+}
+
+static bool libspdm_bench_device_sign(bool is_requester,
+                                      const libspdm_bench_asym_algo_t *algo,
+                                      uintn iterations)
+{
+    uint8_t signature[LIBSPDM_MAX_ASYM_KEY_SIZE];
+    uintn sig_size;
+    void *context;
+    uintn index;
+    uint64_t start;
+    char name[64];
+
+    /* load only*/
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_bench_load_key(is_requester, algo->asym_algo, &context)) {
+            return false;
+        }
+        libspdm_asym_free(algo->asym_algo, context);
+    }
+    snprintf(name, sizeof(name), "%s %s load", is_requester ? "req" : "rsp", algo->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    /* uncached sign*/
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        sig_size = sizeof(signature);
+        if (!libspdm_bench_uncached_sign(is_requester, algo->asym_algo, signature, &sig_size)) {
+            return false;
+        }
+    }
+    snprintf(name, sizeof(name), "%s %s sign uncached", is_requester ? "req" : "rsp",
+             algo->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    /* cached sign, warm the cache first*/
+    libspdm_invalidate_private_key(is_requester, algo->asym_algo);
+    sig_size = sizeof(signature);
+    if (!libspdm_bench_cached_sign(is_requester, algo->asym_algo, signature, &sig_size)) {
+        return false;
+    }
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        sig_size = sizeof(signature);
+        if (!libspdm_bench_cached_sign(is_requester, algo->asym_algo, signature, &sig_size)) {
+            return false;
+        }
+    }
+    snprintf(name, sizeof(name), "%s %s sign cached", is_requester ? "req" : "rsp",
+             algo->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uintn iterations;
+    uintn index;
+    int return_value;
+
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = (uintn)strtoul(argv[1], NULL, 0);
+    }
+
+    libspdm_set_mem(m_libspdm_bench_message, sizeof(m_libspdm_bench_message), 0x5a);
+
+    return_value = 0;
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_asym_algo); index++) {
+        if (!libspdm_bench_device_sign(false, &m_libspdm_bench_asym_algo[index], iterations)) {
+            printf("rsp %s - FAIL\n", m_libspdm_bench_asym_algo[index].name);
+            return_value = 1;
+        }
+        if (!libspdm_bench_device_sign(true, &m_libspdm_bench_asym_algo[index], iterations)) {
+            printf("req %s - FAIL\n", m_libspdm_bench_asym_algo[index].name);
+            return_value = 1;
+        }
+    }
+
+    libspdm_invalidate_all_private_keys();
+    return return_value;
+}
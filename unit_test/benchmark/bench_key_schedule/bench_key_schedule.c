@@ -0,0 +1,330 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Session key schedule benchmark.
+ *
+ * It replays the HKDF work of libspdm_generate_session_handshake_key and
+ * libspdm_generate_session_data_key for a DHE session:
+ *  - per-label: libspdm_hkdf_expand() for every label, so HMAC is keyed for each
+ *               of the 16 labels,
+ *  - keyed:     one HMAC state per secret and libspdm_hkdf_expand_with_state(),
+ *               as the key schedule does now, so HMAC is keyed once for each of the
+ *               6 secrets, plus once for the salt1 label.
+ *
+ * Both paths must derive the same keys. The result is reported in us and CPU cycles
+ * per handshake.
+ *
+ * Usage: bench_key_schedule [iterations]
+ **/
+
+#include "bench_common.h"
+#include "library/spdm_crypt_lib.h"
+#include "library/spdm_secured_message_lib.h"
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 10000
+
+#define LIBSPDM_BENCH_AEAD_KEY_SIZE 32
+#define LIBSPDM_BENCH_AEAD_IV_SIZE 12
+
+typedef struct {
+    uint32_t base_hash_algo;
+    const char *name;
+} libspdm_bench_hash_algo_t;
+
+static const libspdm_bench_hash_algo_t m_libspdm_bench_hash_algo[] = {
+#if LIBSPDM_SHA256_SUPPORT == 1
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "sha256" },
+#endif
+#if LIBSPDM_SHA384_SUPPORT == 1
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, "sha384" },
+#endif
+#if LIBSPDM_SHA512_SUPPORT == 1
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512, "sha512" },
+#endif
+#if LIBSPDM_SM3_256_SUPPORT == 1
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256, "sm3_256" },
+#endif
+};
+
+/* bin_str0 .. bin_str8 of one session*/
+typedef struct {
+    uint8_t data[128];
+    uintn size;
+} libspdm_bench_bin_str_t;
+
+typedef struct {
+    uint8_t finished_key[2][LIBSPDM_MAX_HASH_SIZE];
+    uint8_t handshake_key[2][LIBSPDM_BENCH_AEAD_KEY_SIZE];
+    uint8_t handshake_iv[2][LIBSPDM_BENCH_AEAD_IV_SIZE];
+    uint8_t export_master_secret[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t data_key[2][LIBSPDM_BENCH_AEAD_KEY_SIZE];
+    uint8_t data_iv[2][LIBSPDM_BENCH_AEAD_IV_SIZE];
+} libspdm_bench_session_keys_t;
+
+static libspdm_bench_bin_str_t m_libspdm_bench_bin_str[9];
+static uint8_t m_libspdm_bench_zero_filled_buffer[LIBSPDM_MAX_HASH_SIZE];
+static uint8_t m_libspdm_bench_dhe_secret[LIBSPDM_MAX_DHE_KEY_SIZE];
+static uint8_t m_libspdm_bench_th_hash[LIBSPDM_MAX_HASH_SIZE];
+
+static bool libspdm_bench_init_bin_str(uintn hash_size)
+{
+    static const char *label[] = {
+        SPDM_BIN_STR_0_LABEL, SPDM_BIN_STR_1_LABEL, SPDM_BIN_STR_2_LABEL,
+        SPDM_BIN_STR_3_LABEL, SPDM_BIN_STR_4_LABEL, SPDM_BIN_STR_5_LABEL,
+        SPDM_BIN_STR_6_LABEL, SPDM_BIN_STR_7_LABEL, SPDM_BIN_STR_8_LABEL,
+    };
+    uintn index;
+    uint16_t length;
+    const uint8_t *context;
+
+    for (index = 0; index < ARRAY_SIZE(label); index++) {
+        length = (uint16_t)hash_size;
+        context = NULL;
+        if (index == 5) {
+            length = LIBSPDM_BENCH_AEAD_KEY_SIZE;
+        } else if (index == 6) {
+            length = LIBSPDM_BENCH_AEAD_IV_SIZE;
+        } else if ((index >= 1) && (index != 7)) {
+            context = m_libspdm_bench_th_hash;
+        }
+        m_libspdm_bench_bin_str[index].size = sizeof(m_libspdm_bench_bin_str[index].data);
+        if (RETURN_ERROR(libspdm_bin_concat(label[index], strlen(label[index]), context,
+                                            length, hash_size,
+                                            m_libspdm_bench_bin_str[index].data,
+                                            &m_libspdm_bench_bin_str[index].size))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* The key schedule as it was: HMAC is keyed again for every label.*/
+static bool libspdm_bench_key_schedule_per_label(uint32_t base_hash_algo,
+                                                 libspdm_bench_session_keys_t *keys)
+{
+    uint8_t handshake_secret[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t direction_secret[2][LIBSPDM_MAX_HASH_SIZE];
+    uint8_t salt1[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t master_secret[LIBSPDM_MAX_HASH_SIZE];
+    libspdm_bench_bin_str_t *bin_str;
+    uintn hash_size;
+    uintn index;
+    bool result;
+
+    hash_size = libspdm_get_hash_size(base_hash_algo);
+    bin_str = m_libspdm_bench_bin_str;
+
+    result = libspdm_hmac_all(base_hash_algo, m_libspdm_bench_zero_filled_buffer, hash_size,
+                              m_libspdm_bench_dhe_secret, sizeof(m_libspdm_bench_dhe_secret),
+                              handshake_secret);
+    for (index = 0; index < 2; index++) {
+        result = result &&
+                 libspdm_hkdf_expand(base_hash_algo, handshake_secret, hash_size,
+                                     bin_str[1 + index].data, bin_str[1 + index].size,
+                                     direction_secret[index], hash_size);
+    }
+    for (index = 0; index < 2; index++) {
+        result = result &&
+                 libspdm_hkdf_expand(base_hash_algo, direction_secret[index], hash_size,
+                                     bin_str[7].data, bin_str[7].size,
+                                     keys->finished_key[index], hash_size) &&
+                 libspdm_hkdf_expand(base_hash_algo, direction_secret[index], hash_size,
+                                     bin_str[5].data, bin_str[5].size,
+                                     keys->handshake_key[index],
+                                     LIBSPDM_BENCH_AEAD_KEY_SIZE) &&
+                 libspdm_hkdf_expand(base_hash_algo, direction_secret[index], hash_size,
+                                     bin_str[6].data, bin_str[6].size,
+                                     keys->handshake_iv[index], LIBSPDM_BENCH_AEAD_IV_SIZE);
+    }
+
+    result = result &&
+             libspdm_hkdf_expand(base_hash_algo, handshake_secret, hash_size,
+                                 bin_str[0].data, bin_str[0].size, salt1, hash_size) &&
+             libspdm_hmac_all(base_hash_algo, m_libspdm_bench_zero_filled_buffer, hash_size,
+                              salt1, hash_size, master_secret);
+    for (index = 0; index < 2; index++) {
+        result = result &&
+                 libspdm_hkdf_expand(base_hash_algo, master_secret, hash_size,
+                                     bin_str[3 + index].data, bin_str[3 + index].size,
+                                     direction_secret[index], hash_size);
+    }
+    result = result &&
+             libspdm_hkdf_expand(base_hash_algo, master_secret, hash_size,
+                                 bin_str[8].data, bin_str[8].size,
+                                 keys->export_master_secret, hash_size);
+    for (index = 0; index < 2; index++) {
+        result = result &&
+                 libspdm_hkdf_expand(base_hash_algo, direction_secret[index], hash_size,
+                                     bin_str[5].data, bin_str[5].size,
+                                     keys->data_key[index], LIBSPDM_BENCH_AEAD_KEY_SIZE) &&
+                 libspdm_hkdf_expand(base_hash_algo, direction_secret[index], hash_size,
+                                     bin_str[6].data, bin_str[6].size,
+                                     keys->data_iv[index], LIBSPDM_BENCH_AEAD_IV_SIZE);
+    }
+    return result;
+}
+
+/* The key schedule as it is now: one keyed HMAC state per secret.*/
+static bool libspdm_bench_key_schedule_keyed(uint32_t base_hash_algo,
+                                             libspdm_bench_session_keys_t *keys)
+{
+    uint8_t handshake_secret[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t direction_secret[2][LIBSPDM_MAX_HASH_SIZE];
+    uint8_t salt1[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t master_secret[LIBSPDM_MAX_HASH_SIZE];
+    libspdm_hmac_state_t secret_state;
+    libspdm_bench_bin_str_t *bin_str;
+    uintn hash_size;
+    uintn index;
+    bool result;
+
+    hash_size = libspdm_get_hash_size(base_hash_algo);
+    bin_str = m_libspdm_bench_bin_str;
+
+    result = libspdm_hmac_all(base_hash_algo, m_libspdm_bench_zero_filled_buffer, hash_size,
+                              m_libspdm_bench_dhe_secret, sizeof(m_libspdm_bench_dhe_secret),
+                              handshake_secret) &&
+             libspdm_hmac_state_init(base_hash_algo, &secret_state,
+                                     handshake_secret, hash_size);
+    for (index = 0; index < 2; index++) {
+        result = result &&
+                 libspdm_hkdf_expand_with_state(&secret_state,
+                                                bin_str[1 + index].data, bin_str[1 + index].size,
+                                                direction_secret[index], hash_size);
+    }
+    libspdm_hmac_state_free(&secret_state);
+    for (index = 0; index < 2; index++) {
+        result = result &&
+                 libspdm_hmac_state_init(base_hash_algo, &secret_state,
+                                         direction_secret[index], hash_size) &&
+                 libspdm_hkdf_expand_with_state(&secret_state,
+                                                bin_str[7].data, bin_str[7].size,
+                                                keys->finished_key[index], hash_size) &&
+                 libspdm_hkdf_expand_with_state(&secret_state,
+                                                bin_str[5].data, bin_str[5].size,
+                                                keys->handshake_key[index],
+                                                LIBSPDM_BENCH_AEAD_KEY_SIZE) &&
+                 libspdm_hkdf_expand_with_state(&secret_state,
+                                                bin_str[6].data, bin_str[6].size,
+                                                keys->handshake_iv[index],
+                                                LIBSPDM_BENCH_AEAD_IV_SIZE);
+        libspdm_hmac_state_free(&secret_state);
+    }
+
+    result = result &&
+             libspdm_hkdf_expand(base_hash_algo, handshake_secret, hash_size,
+                                 bin_str[0].data, bin_str[0].size, salt1, hash_size) &&
+             libspdm_hmac_all(base_hash_algo, m_libspdm_bench_zero_filled_buffer, hash_size,
+                              salt1, hash_size, master_secret) &&
+             libspdm_hmac_state_init(base_hash_algo, &secret_state, master_secret, hash_size);
+    for (index = 0; index < 2; index++) {
+        result = result &&
+                 libspdm_hkdf_expand_with_state(&secret_state,
+                                                bin_str[3 + index].data, bin_str[3 + index].size,
+                                                direction_secret[index], hash_size);
+    }
+    result = result &&
+             libspdm_hkdf_expand_with_state(&secret_state, bin_str[8].data, bin_str[8].size,
+                                            keys->export_master_secret, hash_size);
+    libspdm_hmac_state_free(&secret_state);
+    for (index = 0; index < 2; index++) {
+        result = result &&
+                 libspdm_hmac_state_init(base_hash_algo, &secret_state,
+                                         direction_secret[index], hash_size) &&
+                 libspdm_hkdf_expand_with_state(&secret_state,
+                                                bin_str[5].data, bin_str[5].size,
+                                                keys->data_key[index],
+                                                LIBSPDM_BENCH_AEAD_KEY_SIZE) &&
+                 libspdm_hkdf_expand_with_state(&secret_state,
+                                                bin_str[6].data, bin_str[6].size,
+                                                keys->data_iv[index], LIBSPDM_BENCH_AEAD_IV_SIZE);
+        libspdm_hmac_state_free(&secret_state);
+    }
+    return result;
+}
+
+static bool libspdm_bench_key_schedule(const libspdm_bench_hash_algo_t *algo, uintn iterations)
+{
+    libspdm_bench_session_keys_t expected_keys;
+    libspdm_bench_session_keys_t keys;
+    uintn index;
+    uint64_t start;
+    uint64_t start_cycles;
+    uint64_t per_label_cycles;
+    uint64_t keyed_cycles;
+    char name[64];
+
+    if (!libspdm_bench_init_bin_str(libspdm_get_hash_size(algo->base_hash_algo))) {
+        return false;
+    }
+
+    /* both paths derive the same keys*/
+    libspdm_zero_mem(&expected_keys, sizeof(expected_keys));
+    libspdm_zero_mem(&keys, sizeof(keys));
+    if (!libspdm_bench_key_schedule_per_label(algo->base_hash_algo, &expected_keys) ||
+        !libspdm_bench_key_schedule_keyed(algo->base_hash_algo, &keys) ||
+        (libspdm_const_compare_mem(&keys, &expected_keys, sizeof(keys)) != 0)) {
+        return false;
+    }
+
+    start = libspdm_bench_get_time_ns();
+    start_cycles = libspdm_bench_get_cycles();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_bench_key_schedule_per_label(algo->base_hash_algo, &keys)) {
+            return false;
+        }
+    }
+    per_label_cycles = libspdm_bench_get_cycles() - start_cycles;
+    snprintf(name, sizeof(name), "%s per-label", algo->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    start = libspdm_bench_get_time_ns();
+    start_cycles = libspdm_bench_get_cycles();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_bench_key_schedule_keyed(algo->base_hash_algo, &keys)) {
+            return false;
+        }
+    }
+    keyed_cycles = libspdm_bench_get_cycles() - start_cycles;
+    snprintf(name, sizeof(name), "%s keyed", algo->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+
+    printf("%s: %llu -> %llu cycles per handshake, %lld saved\n", algo->name,
+           (unsigned long long)(per_label_cycles / iterations),
+           (unsigned long long)(keyed_cycles / iterations),
+           (long long)(per_label_cycles / iterations) - (long long)(keyed_cycles / iterations));
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uintn iterations;
+    uintn index;
+    int return_value;
+
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = (uintn)strtoul(argv[1], NULL, 0);
+    }
+    if (iterations == 0) {
+        iterations = 1;
+    }
+
+    libspdm_set_mem(m_libspdm_bench_dhe_secret, sizeof(m_libspdm_bench_dhe_secret), 0x5a);
+    libspdm_set_mem(m_libspdm_bench_th_hash, sizeof(m_libspdm_bench_th_hash), 0xa5);
+
+    return_value = 0;
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_hash_algo); index++) {
+        if (!libspdm_bench_key_schedule(&m_libspdm_bench_hash_algo[index], iterations)) {
+            printf("%s - FAIL\n", m_libspdm_bench_hash_algo[index].name);
+            return_value = 1;
+        }
+    }
+
+    return return_value;
+}
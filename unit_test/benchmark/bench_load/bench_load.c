@@ -0,0 +1,324 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Handshake throughput of concurrent, independent requester/responder pairs.
+ *
+ * For every thread count, each thread creates its own loopback (a requester and a responder
+ * context over the in-memory transport), connects it, and runs KEY_EXCHANGE + FINISH or
+ * PSK_EXCHANGE + PSK_FINISH sessions, each followed by END_SESSION. The threads start the
+ * measured handshakes together, and the aggregate handshakes per second is reported with the
+ * scaling efficiency relative to one thread. An efficiency well below 100% with idle cores
+ * points at global state that serializes the threads; a failed handshake points at global
+ * state that is not thread-safe.
+ *
+ * The thread counts are 1, 2, 4, ... up to max_threads, and max_threads itself.
+ *
+ * Usage: bench_load [max_threads] [handshakes_per_thread]
+ **/
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include "bench_loopback.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#if !defined(_MSC_VER) && !defined(__GNUC__) && !defined(__clang__)
+#error "bench_load requires the _Interlocked or the __atomic intrinsics."
+#endif
+
+#define LIBSPDM_BENCH_LOAD_DEFAULT_MAX_THREADS 8
+#define LIBSPDM_BENCH_LOAD_DEFAULT_HANDSHAKES 20
+#define LIBSPDM_BENCH_LOAD_MAX_THREADS 256
+
+/* The state shared by the threads of one run.*/
+typedef struct {
+    bool use_psk;
+    uintn handshakes;
+    /* number of threads ready to start the measured handshakes*/
+    volatile long ready_count;
+    /* set when all the threads are ready*/
+    volatile long go;
+} libspdm_bench_load_run_t;
+
+typedef struct {
+    libspdm_bench_load_run_t *run;
+    uint64_t end_ns;
+    uintn completed;
+    bool result;
+} libspdm_bench_load_worker_t;
+
+static long libspdm_bench_load_read(volatile long *target)
+{
+#if defined(_MSC_VER)
+    return _InterlockedCompareExchange(target, 0, 0);
+#else
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static void libspdm_bench_load_increment(volatile long *target)
+{
+#if defined(_MSC_VER)
+    _InterlockedIncrement(target);
+#else
+    __atomic_add_fetch(target, 1, __ATOMIC_ACQ_REL);
+#endif
+}
+
+static void libspdm_bench_load_yield(void)
+{
+#if defined(_WIN32)
+    Sleep(0);
+#else
+    sched_yield();
+#endif
+}
+
+/* The scaling can only be linear up to the number of CPUs, it is printed with the results.*/
+static uintn libspdm_bench_load_cpu_count(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return (uintn)info.dwNumberOfProcessors;
+#else
+    long count;
+
+    count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (uintn)count : 1;
+#endif
+}
+
+static bool libspdm_bench_load_handshake(libspdm_bench_loopback_t *loopback, bool use_psk)
+{
+    uint32_t session_id;
+    uint8_t heartbeat_period;
+    uint8_t measurement_hash[LIBSPDM_MAX_HASH_SIZE];
+
+    if (RETURN_ERROR(libspdm_start_session(loopback->requester_context, use_psk,
+                                           SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                                           0, 0, &session_id, &heartbeat_period,
+                                           measurement_hash))) {
+        return false;
+    }
+    return !RETURN_ERROR(libspdm_stop_session(loopback->requester_context, session_id, 0));
+}
+
+/* Set up a loopback, wait for the other threads, then run the measured handshakes.*/
+static void libspdm_bench_load_work(libspdm_bench_load_worker_t *worker)
+{
+    libspdm_bench_load_run_t *run;
+    libspdm_bench_loopback_t *loopback;
+    bool ready;
+    uintn index;
+
+    run = worker->run;
+    loopback = malloc(sizeof(libspdm_bench_loopback_t));
+    ready = (loopback != NULL) && libspdm_bench_loopback_init(loopback);
+    if (ready) {
+        /* one handshake outside of the measurement, for the lazy setup of the crypto library*/
+        ready = !RETURN_ERROR(libspdm_bench_loopback_connect(loopback)) &&
+                libspdm_bench_load_handshake(loopback, run->use_psk);
+    }
+
+    libspdm_bench_load_increment(&run->ready_count);
+    while (libspdm_bench_load_read(&run->go) == 0) {
+        libspdm_bench_load_yield();
+    }
+
+    worker->completed = 0;
+    if (ready) {
+        for (index = 0; index < run->handshakes; index++) {
+            if (!libspdm_bench_load_handshake(loopback, run->use_psk)) {
+                break;
+            }
+            worker->completed++;
+        }
+    }
+    worker->end_ns = libspdm_bench_get_time_ns();
+    worker->result = ready && (worker->completed == run->handshakes);
+
+    if (loopback != NULL) {
+        if (ready) {
+            libspdm_bench_loopback_free(loopback);
+        }
+        free(loopback);
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI libspdm_bench_load_thread(LPVOID context)
+{
+    libspdm_bench_load_work(context);
+    return 0;
+}
+#else
+static void *libspdm_bench_load_thread(void *context)
+{
+    libspdm_bench_load_work(context);
+    return NULL;
+}
+#endif
+
+/**
+ * Run the handshakes on thread_count threads.
+ *
+ * @param  thread_count          The number of threads.
+ * @param  use_psk               Run PSK_EXCHANGE + PSK_FINISH instead of KEY_EXCHANGE + FINISH.
+ * @param  handshakes            The number of measured handshakes per thread.
+ * @param  handshakes_per_sec    On output, the aggregate handshakes per second.
+ *
+ * @retval true   All the handshakes succeeded.
+ * @retval false  A thread could not be created, or a handshake failed.
+ **/
+static bool libspdm_bench_load_run(uintn thread_count, bool use_psk, uintn handshakes,
+                                   double *handshakes_per_sec)
+{
+    libspdm_bench_load_run_t run;
+    libspdm_bench_load_worker_t worker[LIBSPDM_BENCH_LOAD_MAX_THREADS];
+#if defined(_WIN32)
+    HANDLE thread[LIBSPDM_BENCH_LOAD_MAX_THREADS];
+#else
+    pthread_t thread[LIBSPDM_BENCH_LOAD_MAX_THREADS];
+#endif
+    uint64_t start_ns;
+    uint64_t end_ns;
+    uintn completed;
+    uintn created;
+    bool result;
+    uintn index;
+
+    libspdm_zero_mem(&run, sizeof(run));
+    run.use_psk = use_psk;
+    run.handshakes = handshakes;
+
+    for (created = 0; created < thread_count; created++) {
+        libspdm_zero_mem(&worker[created], sizeof(worker[created]));
+        worker[created].run = &run;
+#if defined(_WIN32)
+        thread[created] = CreateThread(NULL, 0, libspdm_bench_load_thread, &worker[created], 0,
+                                       NULL);
+        if (thread[created] == NULL) {
+            break;
+        }
+#else
+        if (pthread_create(&thread[created], NULL, libspdm_bench_load_thread,
+                           &worker[created]) != 0) {
+            break;
+        }
+#endif
+    }
+
+    /* A thread that cannot be created is never ready, release the others anyway.*/
+    while ((uintn)libspdm_bench_load_read(&run.ready_count) < created) {
+        libspdm_bench_load_yield();
+    }
+    start_ns = libspdm_bench_get_time_ns();
+    libspdm_bench_load_increment(&run.go);
+
+    result = (created == thread_count);
+    end_ns = start_ns;
+    completed = 0;
+    for (index = 0; index < created; index++) {
+#if defined(_WIN32)
+        WaitForSingleObject(thread[index], INFINITE);
+        CloseHandle(thread[index]);
+#else
+        pthread_join(thread[index], NULL);
+#endif
+        if (!worker[index].result) {
+            result = false;
+        }
+        if (worker[index].end_ns > end_ns) {
+            end_ns = worker[index].end_ns;
+        }
+        completed += worker[index].completed;
+    }
+
+    *handshakes_per_sec = (end_ns == start_ns) ?
+                          0.0 : (double)completed * 1000000000.0 / (double)(end_ns - start_ns);
+    return result;
+}
+
+static bool libspdm_bench_load_run_all(uintn max_threads, bool use_psk, uintn handshakes)
+{
+    const char *name;
+    double handshakes_per_sec;
+    double single_thread_rate;
+    uintn thread_count;
+    bool result;
+
+    name = use_psk ? "psk_exchange_finish" : "key_exchange_finish";
+    result = true;
+    single_thread_rate = 0.0;
+    thread_count = 1;
+    while (true) {
+        if (!libspdm_bench_load_run(thread_count, use_psk, handshakes, &handshakes_per_sec)) {
+            printf("%-22s %8llu - FAIL\n", name, (unsigned long long)thread_count);
+            result = false;
+        } else {
+            if (thread_count == 1) {
+                single_thread_rate = handshakes_per_sec;
+            }
+            printf("%-22s %8llu %14.1f %14.1f", name, (unsigned long long)thread_count,
+                   handshakes_per_sec, handshakes_per_sec / (double)thread_count);
+            if (single_thread_rate != 0.0) {
+                printf(" %9.1f%%", handshakes_per_sec * 100.0 /
+                       (single_thread_rate * (double)thread_count));
+            }
+            printf("\n");
+        }
+
+        if (thread_count == max_threads) {
+            break;
+        }
+        thread_count = (thread_count * 2 > max_threads) ? max_threads : thread_count * 2;
+    }
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    uintn max_threads;
+    uintn handshakes;
+    int return_value;
+
+    max_threads = LIBSPDM_BENCH_LOAD_DEFAULT_MAX_THREADS;
+    handshakes = LIBSPDM_BENCH_LOAD_DEFAULT_HANDSHAKES;
+    if (argc > 1) {
+        max_threads = (uintn)strtoul(argv[1], NULL, 0);
+        if ((max_threads == 0) || (max_threads > LIBSPDM_BENCH_LOAD_MAX_THREADS)) {
+            max_threads = LIBSPDM_BENCH_LOAD_DEFAULT_MAX_THREADS;
+        }
+    }
+    if (argc > 2) {
+        handshakes = (uintn)strtoul(argv[2], NULL, 0);
+        if (handshakes == 0) {
+            handshakes = LIBSPDM_BENCH_LOAD_DEFAULT_HANDSHAKES;
+        }
+    }
+
+    printf("cpus: %llu\n", (unsigned long long)libspdm_bench_load_cpu_count());
+    printf("%-22s %8s %14s %14s %10s\n", "handshake", "threads", "handshakes/s",
+           "per thread/s", "scaling");
+    return_value = 0;
+    if (!libspdm_bench_load_run_all(max_threads, false, handshakes)) {
+        return_value = 1;
+    }
+    if (!libspdm_bench_load_run_all(max_threads, true, handshakes)) {
+        return_value = 1;
+    }
+    return return_value;
+}
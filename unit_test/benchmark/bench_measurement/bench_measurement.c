@@ -0,0 +1,229 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Measurement collection benchmark of the sample measurement image provider.
+ *
+ * Every firmware measurement index is backed by an image file of the same size.
+ * For every image size it measures libspdm_measurement_collection() of all measurements:
+ *  - cold:  the image digest cache is flushed, so all images are hashed again,
+ *           with 1, 2 and 4 threads, and with 1 thread without read-ahead,
+ *  - warm:  the image digests are served from the cache.
+ *
+ * The images are written right before they are measured, so they are in the page cache:
+ * the cold numbers are the hashing cost, not the storage cost.
+ *
+ * Usage: bench_measurement [max_image_mib] [iterations]
+ **/
+
+#include "bench_common.h"
+#include "library/spdm_crypt_lib.h"
+#include "spdm_device_secret_lib_internal.h"
+
+#define LIBSPDM_BENCH_DEFAULT_MAX_IMAGE_MIB 64
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 3
+#define LIBSPDM_BENCH_MEASUREMENT_HASH_ALGO SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384
+
+static const char *m_libspdm_bench_image_file[LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER] = {
+    "bench_measurement_image1.bin",
+    "bench_measurement_image2.bin",
+    "bench_measurement_image3.bin",
+    "bench_measurement_image4.bin",
+};
+
+static bool libspdm_bench_write_image(const char *file_name, uintn image_size, uint8_t seed)
+{
+    FILE *fp_out;
+    uint8_t buffer[0x10000];
+    uintn index;
+    uintn write_size;
+
+    for (index = 0; index < sizeof(buffer); index++) {
+        buffer[index] = (uint8_t)(index * 31 + seed);
+    }
+    fp_out = fopen(file_name, "wb");
+    if (fp_out == NULL) {
+        printf("Unable to create file %s\n", file_name);
+        return false;
+    }
+    for (index = 0; index < image_size; index += write_size) {
+        write_size = image_size - index;
+        if (write_size > sizeof(buffer)) {
+            write_size = sizeof(buffer);
+        }
+        if (fwrite(buffer, 1, write_size, fp_out) != write_size) {
+            fclose(fp_out);
+            return false;
+        }
+    }
+    fclose(fp_out);
+    return true;
+}
+
+static bool libspdm_bench_collect(void)
+{
+    uint8_t measurements[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uintn measurements_size;
+    uint8_t measurements_count;
+    return_status status;
+
+    measurements_size = sizeof(measurements);
+    status = libspdm_measurement_collection(
+        SPDM_MESSAGE_VERSION_12 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+        SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF,
+        LIBSPDM_BENCH_MEASUREMENT_HASH_ALGO,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        0, NULL, &measurements_count, measurements, &measurements_size);
+    return !RETURN_ERROR(status);
+}
+
+/* The provider digest must be the plain digest of the whole image.*/
+static bool libspdm_bench_check_digest(void)
+{
+    uint8_t measurement[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uintn measurement_size;
+    uint8_t measurement_count;
+    spdm_measurement_block_dmtf_t *measurement_block;
+    void *image;
+    uintn image_size;
+    uint8_t digest[LIBSPDM_MAX_HASH_SIZE];
+    uintn hash_size;
+    bool result;
+
+    measurement_size = sizeof(measurement);
+    if (RETURN_ERROR(libspdm_measurement_collection(
+                         SPDM_MESSAGE_VERSION_12 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+                         SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF,
+                         LIBSPDM_BENCH_MEASUREMENT_HASH_ALGO, 1, 0, NULL,
+                         &measurement_count, measurement, &measurement_size))) {
+        return false;
+    }
+    if (!libspdm_read_input_file(m_libspdm_bench_image_file[0], &image, &image_size)) {
+        return false;
+    }
+    hash_size = libspdm_get_measurement_hash_size(LIBSPDM_BENCH_MEASUREMENT_HASH_ALGO);
+    result = libspdm_measurement_hash_all(LIBSPDM_BENCH_MEASUREMENT_HASH_ALGO,
+                                          image, image_size, digest);
+    free(image);
+    measurement_block = (void *)measurement;
+    return result &&
+           (measurement_block->measurement_block_dmtf_header.dmtf_spec_measurement_value_size ==
+            hash_size) &&
+           (memcmp(measurement_block + 1, digest, hash_size) == 0);
+}
+
+static bool libspdm_bench_cold(const char *name, uintn thread_count, uintn read_ahead_size,
+                               uintn iterations)
+{
+    uintn index;
+    uint64_t start;
+    uint64_t elapsed;
+
+    if (!libspdm_measurement_provider_configure(thread_count, read_ahead_size)) {
+        return false;
+    }
+    elapsed = 0;
+    for (index = 0; index < iterations; index++) {
+        libspdm_measurement_provider_flush();
+        start = libspdm_bench_get_time_ns();
+        if (!libspdm_bench_collect()) {
+            return false;
+        }
+        elapsed += libspdm_bench_get_time_ns() - start;
+    }
+    libspdm_bench_report(name, iterations, elapsed);
+    return true;
+}
+
+static bool libspdm_bench_measurement(uintn image_mib, uintn iterations)
+{
+    uintn index;
+    uint64_t start;
+    char name[64];
+    uint64_t hit_count;
+    uint64_t miss_count;
+    uint64_t hashed_bytes;
+    bool result;
+
+    result = false;
+    for (index = 0; index < LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER; index++) {
+        if (!libspdm_bench_write_image(m_libspdm_bench_image_file[index],
+                                       image_mib * 0x100000, (uint8_t)index) ||
+            !libspdm_measurement_provider_set_image((uint8_t)(index + 1),
+                                                    m_libspdm_bench_image_file[index])) {
+            goto done;
+        }
+    }
+    snprintf(name, sizeof(name), "%d x %d MiB cold 1 thread no read-ahead",
+             LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER, (int)image_mib);
+    if (!libspdm_bench_cold(name, 1, 0, iterations)) {
+        goto done;
+    }
+    for (index = 1; index <= 4; index *= 2) {
+        snprintf(name, sizeof(name), "%d x %d MiB cold %d thread(s)",
+                 LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER, (int)image_mib, (int)index);
+        if (!libspdm_bench_cold(name, index, LIBSPDM_MEASUREMENT_PROVIDER_DEFAULT_READ_AHEAD_SIZE,
+                                iterations)) {
+            goto done;
+        }
+    }
+
+    /* the cached digests were hashed by the 4 threads*/
+    if (!libspdm_bench_check_digest()) {
+        printf("%d MiB: image digest mismatch\n", (int)image_mib);
+        goto done;
+    }
+
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations * 100; index++) {
+        if (!libspdm_bench_collect()) {
+            goto done;
+        }
+    }
+    snprintf(name, sizeof(name), "%d x %d MiB warm",
+             LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER, (int)image_mib);
+    libspdm_bench_report(name, iterations * 100, libspdm_bench_get_time_ns() - start);
+
+    libspdm_measurement_provider_get_statistics(&hit_count, &miss_count, &hashed_bytes);
+    printf("%d MiB cache: %llu hits, %llu misses, %llu MiB hashed\n", (int)image_mib,
+           (unsigned long long)hit_count, (unsigned long long)miss_count,
+           (unsigned long long)(hashed_bytes / 0x100000));
+    result = true;
+
+done:
+    for (index = 0; index < LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER; index++) {
+        libspdm_measurement_provider_set_image((uint8_t)(index + 1), NULL);
+        remove(m_libspdm_bench_image_file[index]);
+    }
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    uintn max_image_mib;
+    uintn iterations;
+    uintn image_mib;
+    int return_value;
+
+    max_image_mib = LIBSPDM_BENCH_DEFAULT_MAX_IMAGE_MIB;
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        max_image_mib = (uintn)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        iterations = (uintn)strtoul(argv[2], NULL, 0);
+    }
+
+    return_value = 0;
+    for (image_mib = 1; image_mib <= max_image_mib; image_mib *= 4) {
+        if (!libspdm_bench_measurement(image_mib, iterations)) {
+            printf("%d MiB - FAIL\n", (int)image_mib);
+            return_value = 1;
+        }
+    }
+
+    return return_value;
+}
@@ -0,0 +1,138 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Measurement retrieval benchmark of an in-process requester and responder.
+ *
+ * It retrieves all measurements of the sample responder with a single signature:
+ *  - all:   one signed GET_MEASUREMENTS of all measurements, the baseline,
+ *  - sweep: libspdm_get_measurement_sweep(), one unsigned GET_MEASUREMENTS of all measurements,
+ *           then one signed GET_MEASUREMENTS of the last index.
+ *
+ * Every round trip can be delayed by an emulated link latency, to show what the
+ * round trips cost on a real transport.
+ *
+ * Usage: bench_measurement_sweep [iterations] [link_latency_us]
+ **/
+
+#include "bench_loopback.h"
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 100
+#define LIBSPDM_BENCH_DEFAULT_LINK_LATENCY_US 100
+
+typedef return_status (*libspdm_bench_get_measurements_func)(void *spdm_context,
+                                                             uint8_t *signature_count);
+
+static return_status libspdm_bench_get_measurements_all(void *spdm_context,
+                                                        uint8_t *signature_count)
+{
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint32_t measurement_record_length;
+    uint8_t number_of_blocks;
+    return_status status;
+
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement(
+        spdm_context, NULL, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        0, NULL, &number_of_blocks, &measurement_record_length, measurement_record);
+    *signature_count = 1;
+    return status;
+}
+
+static return_status libspdm_bench_get_measurements_sweep(void *spdm_context,
+                                                          uint8_t *signature_count)
+{
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint32_t measurement_record_length;
+    libspdm_measurement_table_t measurement_table;
+
+    measurement_record_length = sizeof(measurement_record);
+    *signature_count = 1;
+    return libspdm_get_measurement_sweep(spdm_context, NULL, 0, NULL,
+                                         &measurement_record_length, measurement_record,
+                                         &measurement_table);
+}
+
+static bool libspdm_bench_run(libspdm_bench_loopback_t *loopback, const char *name,
+                              libspdm_bench_get_measurements_func get_measurements,
+                              uintn iterations)
+{
+    uintn index;
+    uint64_t round_trip_count;
+    uint64_t start;
+    uint64_t elapsed;
+    uint8_t signature_count;
+    char report_name[64];
+
+    round_trip_count = loopback->round_trip_count;
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (RETURN_ERROR(get_measurements(loopback->requester_context, &signature_count))) {
+            printf("%s - FAIL\n", name);
+            return false;
+        }
+    }
+    elapsed = libspdm_bench_get_time_ns() - start;
+    round_trip_count = loopback->round_trip_count - round_trip_count;
+
+    snprintf(report_name, sizeof(report_name), "%s (%d us link)", name,
+             (int)(loopback->link_latency_ns / 1000));
+    libspdm_bench_report(report_name, iterations, elapsed);
+    printf("%-48s %12d round trips %6d signatures\n", "",
+           (int)(round_trip_count / iterations), (int)signature_count);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    libspdm_bench_loopback_t *loopback;
+    uintn iterations;
+    uint64_t link_latency_ns[2];
+    uintn index;
+    int return_value;
+
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    link_latency_ns[1] = LIBSPDM_BENCH_DEFAULT_LINK_LATENCY_US * 1000;
+    if (argc > 1) {
+        iterations = (uintn)strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        link_latency_ns[1] = (uint64_t)strtoul(argv[2], NULL, 0) * 1000;
+    }
+    link_latency_ns[0] = 0;
+    if (iterations == 0) {
+        iterations = 1;
+    }
+
+    loopback = malloc(sizeof(libspdm_bench_loopback_t));
+    if ((loopback == NULL) || !libspdm_bench_loopback_init(loopback)) {
+        printf("loopback init - FAIL\n");
+        free(loopback);
+        return 1;
+    }
+    if (RETURN_ERROR(libspdm_bench_loopback_connect(loopback))) {
+        printf("loopback connect - FAIL\n");
+        libspdm_bench_loopback_free(loopback);
+        free(loopback);
+        return 1;
+    }
+
+    return_value = 0;
+    for (index = 0; index < ARRAY_SIZE(link_latency_ns); index++) {
+        loopback->link_latency_ns = link_latency_ns[index];
+        if (!libspdm_bench_run(loopback, "signed all measurements",
+                               libspdm_bench_get_measurements_all, iterations) ||
+            !libspdm_bench_run(loopback, "sweep",
+                               libspdm_bench_get_measurements_sweep, iterations)) {
+            return_value = 1;
+        }
+    }
+
+    libspdm_bench_loopback_free(loopback);
+    free(loopback);
+    return return_value;
+}
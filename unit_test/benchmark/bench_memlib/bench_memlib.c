@@ -0,0 +1,292 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * memlib benchmark.
+ *
+ * It measures libspdm_copy_mem, libspdm_set_mem, libspdm_zero_mem and
+ * libspdm_const_compare_mem of the memlib the benchmark is linked with, next to the
+ * byte-at-a-time loops of the portable memlib, for buffers from 16 bytes to 8 KB.
+ * Build with -DMEMLIB=portable or -DMEMLIB=optimized to compare both memlibs.
+ *
+ * Before measuring, the results are checked against the byte loops for every length up
+ * to 300 bytes and every misalignment of the buffers. The compare is also timed with
+ * the first and with the last byte different, which must not change its time.
+ *
+ * Usage: bench_memlib [megabytes_per_measurement]
+ **/
+
+#include "bench_common.h"
+
+#define LIBSPDM_BENCH_DEFAULT_MEGABYTES 64
+#define LIBSPDM_BENCH_MAX_SIZE 8192
+#define LIBSPDM_BENCH_CHECK_SIZE 300
+#define LIBSPDM_BENCH_CHECK_ALIGNMENT 32
+
+static uint8_t m_libspdm_bench_buffer1[LIBSPDM_BENCH_MAX_SIZE + LIBSPDM_BENCH_CHECK_ALIGNMENT];
+static uint8_t m_libspdm_bench_buffer2[LIBSPDM_BENCH_MAX_SIZE + LIBSPDM_BENCH_CHECK_ALIGNMENT];
+static uint8_t m_libspdm_bench_buffer3[LIBSPDM_BENCH_MAX_SIZE + LIBSPDM_BENCH_CHECK_ALIGNMENT];
+
+static const uintn m_libspdm_bench_size[] = {
+    16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192,
+};
+
+/* The loops of the portable memlib.*/
+static void libspdm_bench_byte_copy(void *dst_buf, const void *src_buf, uintn length)
+{
+    volatile uint8_t *dst;
+    const volatile uint8_t *src;
+
+    dst = dst_buf;
+    src = src_buf;
+    while (length-- != 0) {
+        *(dst++) = *(src++);
+    }
+}
+
+static void libspdm_bench_byte_set(void *buffer, uintn length, uint8_t value)
+{
+    volatile uint8_t *pointer;
+
+    pointer = buffer;
+    while (length-- != 0) {
+        *(pointer++) = value;
+    }
+}
+
+static uint8_t libspdm_bench_byte_compare(const void *buffer1, const void *buffer2,
+                                          uintn length)
+{
+    const volatile uint8_t *pointer1;
+    const volatile uint8_t *pointer2;
+    uint8_t delta;
+
+    pointer1 = buffer1;
+    pointer2 = buffer2;
+    delta = 0;
+    while (length-- != 0) {
+        delta |= *(pointer1++) ^ *(pointer2++);
+    }
+    return delta;
+}
+
+static void libspdm_bench_fill_pattern(uint8_t *buffer, uintn length, uint8_t seed)
+{
+    uintn index;
+
+    for (index = 0; index < length; index++) {
+        buffer[index] = (uint8_t)(index * 7 + seed);
+    }
+}
+
+static bool libspdm_bench_check_copy(uintn length, uintn dst_offset, uintn src_offset)
+{
+    uint8_t *dst;
+    uint8_t *src;
+
+    libspdm_bench_fill_pattern(m_libspdm_bench_buffer1, sizeof(m_libspdm_bench_buffer1), 1);
+    libspdm_bench_fill_pattern(m_libspdm_bench_buffer2, sizeof(m_libspdm_bench_buffer2), 2);
+    libspdm_bench_fill_pattern(m_libspdm_bench_buffer3, sizeof(m_libspdm_bench_buffer3), 2);
+    dst = m_libspdm_bench_buffer2 + dst_offset;
+    src = m_libspdm_bench_buffer1 + src_offset;
+
+    if (libspdm_copy_mem(dst, length, src, length) != 0) {
+        return false;
+    }
+    libspdm_bench_byte_copy(m_libspdm_bench_buffer3 + dst_offset, src, length);
+    /* The bytes around the destination must be untouched too.*/
+    return memcmp(m_libspdm_bench_buffer2, m_libspdm_bench_buffer3,
+                  sizeof(m_libspdm_bench_buffer2)) == 0;
+}
+
+static bool libspdm_bench_check_set(uintn length, uintn offset, uint8_t value)
+{
+    libspdm_bench_fill_pattern(m_libspdm_bench_buffer2, sizeof(m_libspdm_bench_buffer2), 2);
+    libspdm_bench_fill_pattern(m_libspdm_bench_buffer3, sizeof(m_libspdm_bench_buffer3), 2);
+    if (value == 0) {
+        libspdm_zero_mem(m_libspdm_bench_buffer2 + offset, length);
+    } else {
+        libspdm_set_mem(m_libspdm_bench_buffer2 + offset, length, value);
+    }
+    libspdm_bench_byte_set(m_libspdm_bench_buffer3 + offset, length, value);
+    return memcmp(m_libspdm_bench_buffer2, m_libspdm_bench_buffer3,
+                  sizeof(m_libspdm_bench_buffer2)) == 0;
+}
+
+static bool libspdm_bench_check_compare(uintn length, uintn offset1, uintn offset2)
+{
+    uint8_t *buffer1;
+    uint8_t *buffer2;
+    uintn index;
+
+    buffer1 = m_libspdm_bench_buffer1 + offset1;
+    buffer2 = m_libspdm_bench_buffer2 + offset2;
+    libspdm_bench_fill_pattern(buffer1, length, 3);
+    libspdm_bench_fill_pattern(buffer2, length, 3);
+    if (libspdm_const_compare_mem(buffer1, buffer2, length) != 0) {
+        return false;
+    }
+    for (index = 0; index < length; index++) {
+        buffer2[index] ^= 0x80;
+        if (libspdm_const_compare_mem(buffer1, buffer2, length) == 0) {
+            return false;
+        }
+        buffer2[index] ^= 0x80;
+    }
+    return true;
+}
+
+static bool libspdm_bench_check(void)
+{
+    uintn length;
+    uintn offset1;
+    uintn offset2;
+
+    for (length = 0; length <= LIBSPDM_BENCH_CHECK_SIZE; length++) {
+        for (offset1 = 0; offset1 < LIBSPDM_BENCH_CHECK_ALIGNMENT; offset1++) {
+            if (!libspdm_bench_check_set(length, offset1, 0) ||
+                !libspdm_bench_check_set(length, offset1, 0xA5)) {
+                printf("set/zero length %d offset %d - FAIL\n", (int)length, (int)offset1);
+                return false;
+            }
+            for (offset2 = 0; offset2 < LIBSPDM_BENCH_CHECK_ALIGNMENT; offset2 += 3) {
+                if (!libspdm_bench_check_copy(length, offset1, offset2)) {
+                    printf("copy length %d offsets %d/%d - FAIL\n", (int)length,
+                           (int)offset1, (int)offset2);
+                    return false;
+                }
+                if (!libspdm_bench_check_compare(length, offset1, offset2)) {
+                    printf("compare length %d offsets %d/%d - FAIL\n", (int)length,
+                           (int)offset1, (int)offset2);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static void libspdm_bench_report_bytes(const char *operation, uintn size, uintn iterations,
+                                       uint64_t elapsed_ns)
+{
+    char report_name[64];
+
+    snprintf(report_name, sizeof(report_name), "%s %d", operation, (int)size);
+    if ((iterations == 0) || (elapsed_ns == 0)) {
+        printf("%-48s %10s\n", report_name, "n/a");
+        return;
+    }
+    printf("%-48s %10.1f ns/op %10.2f GB/s\n", report_name,
+           (double)elapsed_ns / (double)iterations,
+           (double)size * (double)iterations / (double)elapsed_ns);
+}
+
+static void libspdm_bench_run_size(uintn size, uintn bytes_per_measurement)
+{
+    uintn iterations;
+    uintn index;
+    uint64_t start;
+    uint8_t delta;
+
+    iterations = bytes_per_measurement / size;
+    libspdm_bench_fill_pattern(m_libspdm_bench_buffer1, size, 1);
+    libspdm_bench_fill_pattern(m_libspdm_bench_buffer2, size, 1);
+
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        libspdm_copy_mem(m_libspdm_bench_buffer2, size, m_libspdm_bench_buffer1, size);
+    }
+    libspdm_bench_report_bytes("copy_mem", size, iterations,
+                               libspdm_bench_get_time_ns() - start);
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        libspdm_bench_byte_copy(m_libspdm_bench_buffer2, m_libspdm_bench_buffer1, size);
+    }
+    libspdm_bench_report_bytes("  byte loop", size, iterations,
+                               libspdm_bench_get_time_ns() - start);
+
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        libspdm_set_mem(m_libspdm_bench_buffer2, size, (uint8_t)index);
+    }
+    libspdm_bench_report_bytes("set_mem", size, iterations,
+                               libspdm_bench_get_time_ns() - start);
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        libspdm_bench_byte_set(m_libspdm_bench_buffer2, size, (uint8_t)index);
+    }
+    libspdm_bench_report_bytes("  byte loop", size, iterations,
+                               libspdm_bench_get_time_ns() - start);
+
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        libspdm_zero_mem(m_libspdm_bench_buffer2, size);
+    }
+    libspdm_bench_report_bytes("zero_mem", size, iterations,
+                               libspdm_bench_get_time_ns() - start);
+
+    libspdm_bench_fill_pattern(m_libspdm_bench_buffer2, size, 1);
+    delta = 0;
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        delta |= (uint8_t)libspdm_const_compare_mem(m_libspdm_bench_buffer1,
+                                                    m_libspdm_bench_buffer2, size);
+    }
+    libspdm_bench_report_bytes("const_compare_mem, equal", size, iterations,
+                               libspdm_bench_get_time_ns() - start);
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        delta |= libspdm_bench_byte_compare(m_libspdm_bench_buffer1,
+                                            m_libspdm_bench_buffer2, size);
+    }
+    libspdm_bench_report_bytes("  byte loop", size, iterations,
+                               libspdm_bench_get_time_ns() - start);
+
+    m_libspdm_bench_buffer2[0] ^= 1;
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        delta |= (uint8_t)libspdm_const_compare_mem(m_libspdm_bench_buffer1,
+                                                    m_libspdm_bench_buffer2, size);
+    }
+    libspdm_bench_report_bytes("const_compare_mem, first byte differs", size, iterations,
+                               libspdm_bench_get_time_ns() - start);
+    m_libspdm_bench_buffer2[0] ^= 1;
+    m_libspdm_bench_buffer2[size - 1] ^= 1;
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        delta |= (uint8_t)libspdm_const_compare_mem(m_libspdm_bench_buffer1,
+                                                    m_libspdm_bench_buffer2, size);
+    }
+    libspdm_bench_report_bytes("const_compare_mem, last byte differs", size, iterations,
+                               libspdm_bench_get_time_ns() - start);
+    if (delta == 0) {
+        printf("const_compare_mem %d - FAIL\n", (int)size);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uintn bytes_per_measurement;
+    uintn index;
+
+    bytes_per_measurement = LIBSPDM_BENCH_DEFAULT_MEGABYTES;
+    if (argc > 1) {
+        bytes_per_measurement = (uintn)strtoul(argv[1], NULL, 0);
+    }
+    if (bytes_per_measurement == 0) {
+        bytes_per_measurement = 1;
+    }
+    bytes_per_measurement *= 1024 * 1024;
+
+    if (!libspdm_bench_check()) {
+        return 1;
+    }
+
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_size); index++) {
+        libspdm_bench_run_size(m_libspdm_bench_size[index], bytes_per_measurement);
+    }
+    return 0;
+}
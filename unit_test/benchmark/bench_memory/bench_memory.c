@@ -0,0 +1,181 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Heap usage of an in-process requester and responder.
+ *
+ * Every flow is measured with the allocation statistics of three scopes:
+ *  - requester: the requester context,
+ *  - responder: the responder context, outside any session,
+ *  - responder session: the responder sessions, selected through the memory scope events.
+ *
+ * The crypto backend allocates through the pool allocator, so its objects are counted.
+ * The blocks still live after the first flow that uses an algorithm are the lazy initialization
+ * of the crypto backend, they are not freed before the exit.
+ * The statistics are recorded by the instrumented malloclib only (-DMALLOCLIB=instrumented).
+ *
+ * Usage: bench_memory [peak_budget_bytes]
+ * With a budget, the benchmark fails if the peak live bytes of a scope exceed it.
+ **/
+
+#include "bench_loopback.h"
+
+typedef enum {
+    LIBSPDM_BENCH_MEMORY_SCOPE_REQUESTER,
+    LIBSPDM_BENCH_MEMORY_SCOPE_RESPONDER,
+    LIBSPDM_BENCH_MEMORY_SCOPE_RESPONDER_SESSION,
+    LIBSPDM_BENCH_MEMORY_SCOPE_COUNT
+} libspdm_bench_memory_scope_t;
+
+static const char *m_libspdm_bench_memory_scope_name[LIBSPDM_BENCH_MEMORY_SCOPE_COUNT] = {
+    "requester",
+    "responder",
+    "responder session",
+};
+
+static libspdm_malloc_stats_t m_libspdm_bench_memory_stats[LIBSPDM_BENCH_MEMORY_SCOPE_COUNT];
+
+static void libspdm_bench_memory_scope(void *spdm_context, uint32_t session_id,
+                                       libspdm_memory_scope_event_t event)
+{
+    if ((event == LIBSPDM_MEMORY_SCOPE_ENTER) && (session_id != 0)) {
+        libspdm_set_malloc_stats_scope(
+            &m_libspdm_bench_memory_stats[LIBSPDM_BENCH_MEMORY_SCOPE_RESPONDER_SESSION]);
+    } else {
+        libspdm_set_malloc_stats_scope(
+            &m_libspdm_bench_memory_stats[LIBSPDM_BENCH_MEMORY_SCOPE_RESPONDER]);
+    }
+}
+
+static return_status libspdm_bench_memory_connect(libspdm_bench_loopback_t *loopback)
+{
+    libspdm_data_parameter_t parameter;
+    uint32_t connection_state;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    connection_state = LIBSPDM_CONNECTION_STATE_NOT_STARTED;
+    libspdm_set_data(loopback->requester_context, LIBSPDM_DATA_CONNECTION_STATE, &parameter,
+                     &connection_state, sizeof(connection_state));
+    return libspdm_bench_loopback_connect(loopback);
+}
+
+static return_status libspdm_bench_memory_measurements(libspdm_bench_loopback_t *loopback)
+{
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint32_t measurement_record_length;
+    uint8_t number_of_blocks;
+
+    measurement_record_length = sizeof(measurement_record);
+    return libspdm_get_measurement(
+        loopback->requester_context, NULL,
+        SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        0, NULL, &number_of_blocks, &measurement_record_length, measurement_record);
+}
+
+static return_status libspdm_bench_memory_session(libspdm_bench_loopback_t *loopback)
+{
+    return_status status;
+    uint32_t session_id;
+    uint8_t heartbeat_period;
+    uint8_t measurement_hash[LIBSPDM_MAX_HASH_SIZE];
+
+    status = libspdm_start_session(loopback->requester_context, false,
+                                   SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                                   0, 0, &session_id, &heartbeat_period, measurement_hash);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    status = libspdm_heartbeat(loopback->requester_context, session_id);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    return libspdm_stop_session(loopback->requester_context, session_id, 0);
+}
+
+static bool libspdm_bench_memory_run(libspdm_bench_loopback_t *loopback, const char *name,
+                                     return_status (*flow)(libspdm_bench_loopback_t *loopback),
+                                     uintn peak_budget)
+{
+    libspdm_malloc_stats_t *previous_stats;
+    return_status status;
+    uintn index;
+    char scope_name[64];
+    bool result;
+
+    for (index = 0; index < LIBSPDM_BENCH_MEMORY_SCOPE_COUNT; index++) {
+        libspdm_reset_malloc_stats(&m_libspdm_bench_memory_stats[index]);
+    }
+
+    previous_stats = libspdm_set_malloc_stats_scope(
+        &m_libspdm_bench_memory_stats[LIBSPDM_BENCH_MEMORY_SCOPE_REQUESTER]);
+    status = flow(loopback);
+    libspdm_set_malloc_stats_scope(previous_stats);
+    if (RETURN_ERROR(status)) {
+        printf("%s - FAIL (status 0x%x)\n", name, (uint32_t)status);
+        return false;
+    }
+
+    result = true;
+    for (index = 0; index < LIBSPDM_BENCH_MEMORY_SCOPE_COUNT; index++) {
+        snprintf(scope_name, sizeof(scope_name), "%s, %s", name,
+                 m_libspdm_bench_memory_scope_name[index]);
+        libspdm_dump_malloc_stats(scope_name, &m_libspdm_bench_memory_stats[index]);
+        if ((peak_budget != 0) &&
+            (m_libspdm_bench_memory_stats[index].peak_live_bytes > peak_budget)) {
+            printf("%s - FAIL (peak over the budget of %d bytes)\n", scope_name,
+                   (int)peak_budget);
+            result = false;
+        }
+    }
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    libspdm_bench_loopback_t *loopback;
+    uintn peak_budget;
+    int return_value;
+
+    peak_budget = 0;
+    if (argc > 1) {
+        peak_budget = (uintn)strtoul(argv[1], NULL, 0);
+    }
+
+    if (!libspdm_crypt_use_pool_allocator()) {
+        printf("pool allocator - FAIL\n");
+        return 1;
+    }
+    if (!libspdm_malloc_stats_is_enabled()) {
+        printf("The malloclib is not instrumented, build with -DMALLOCLIB=instrumented.\n");
+    }
+
+    loopback = malloc(sizeof(libspdm_bench_loopback_t));
+    if ((loopback == NULL) || !libspdm_bench_loopback_init(loopback)) {
+        printf("loopback init - FAIL\n");
+        free(loopback);
+        return 1;
+    }
+    loopback->responder_malloc_stats =
+        &m_libspdm_bench_memory_stats[LIBSPDM_BENCH_MEMORY_SCOPE_RESPONDER];
+    libspdm_register_memory_scope_func(loopback->responder_context,
+                                       libspdm_bench_memory_scope);
+
+    return_value = 0;
+    if (!libspdm_bench_memory_run(loopback, "connect", libspdm_bench_memory_connect,
+                                  peak_budget) ||
+        !libspdm_bench_memory_run(loopback, "measurements", libspdm_bench_memory_measurements,
+                                  peak_budget) ||
+        !libspdm_bench_memory_run(loopback, "session", libspdm_bench_memory_session,
+                                  peak_budget)) {
+        return_value = 1;
+    }
+
+    libspdm_bench_loopback_free(loopback);
+    free(loopback);
+    return return_value;
+}
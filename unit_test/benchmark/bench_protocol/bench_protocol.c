@@ -0,0 +1,501 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * End-to-end latency of the SPDM requests, between an in-process requester and responder.
+ *
+ * Every algorithm suite runs on a fresh loopback, authenticated once before the measurements:
+ *  - VCA, GET_DIGESTS, GET_CERTIFICATE, CHALLENGE,
+ *  - GET_MEASUREMENTS with and without signature,
+ *  - KEY_EXCHANGE + FINISH and PSK_EXCHANGE + PSK_FINISH, until the session is established,
+ *  - HEARTBEAT, KEY_UPDATE and the APP message round trip of several sizes, in a session.
+ * A suite is skipped if the crypto backend or the sample keys do not support its algorithms.
+ *
+ * The crypto backend is selected at build time, with -DCRYPTO=mbedtls or -DCRYPTO=openssl,
+ * and is recorded in the results, so the results of both builds can be compared.
+ *
+ * Usage: bench_protocol [iterations] [json_file]
+ * With a JSON file, the results are also written to it, one object per suite and operation.
+ **/
+
+#include "bench_loopback.h"
+
+#define LIBSPDM_BENCH_PROTOCOL_DEFAULT_ITERATIONS 10
+#define LIBSPDM_BENCH_PROTOCOL_RESULT_COUNT 256
+
+#define LIBSPDM_BENCH_PROTOCOL_STRING(x) #x
+#define LIBSPDM_BENCH_PROTOCOL_XSTRING(x) LIBSPDM_BENCH_PROTOCOL_STRING(x)
+#ifdef LIBSPDM_BENCH_CRYPTO
+#define LIBSPDM_BENCH_PROTOCOL_CRYPTO LIBSPDM_BENCH_PROTOCOL_XSTRING(LIBSPDM_BENCH_CRYPTO)
+#else
+#define LIBSPDM_BENCH_PROTOCOL_CRYPTO "unknown"
+#endif
+
+static const libspdm_bench_loopback_algo_t m_libspdm_bench_protocol_algo[] = {
+    {
+        "sha256-ecdsa_p256-secp256r1-aes128gcm",
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256,
+        SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256,
+        SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1,
+        SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM,
+    },
+    {
+        "sha384-ecdsa_p384-secp384r1-aes256gcm",
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384,
+        SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384,
+        SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1,
+        SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM,
+    },
+    {
+        "sha512-ecdsa_p521-secp521r1-aes256gcm",
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512,
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P521,
+        SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512,
+        SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_521_R1,
+        SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM,
+    },
+    {
+        "sha384-ecdsa_p384-secp384r1-chacha20poly1305",
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P384,
+        SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384,
+        SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_384_R1,
+        SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305,
+    },
+    {
+        "sha256-rsassa2048-ffdhe2048-aes128gcm",
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048,
+        SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256,
+        SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_2048,
+        SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_128_GCM,
+    },
+    {
+        "sha384-rsapss3072-ffdhe3072-aes256gcm",
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSAPSS_3072,
+        SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_384,
+        SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_3072,
+        SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM,
+    },
+    {
+        "sha512-rsassa4096-ffdhe4096-aes256gcm",
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512,
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_4096,
+        SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512,
+        SPDM_ALGORITHMS_DHE_NAMED_GROUP_FFDHE_4096,
+        SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AES_256_GCM,
+    },
+    {
+        "sha512-ed25519-secp256r1-chacha20poly1305",
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512,
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_EDDSA_ED25519,
+        SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_512,
+        SPDM_ALGORITHMS_DHE_NAMED_GROUP_SECP_256_R1,
+        SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_CHACHA20_POLY1305,
+    },
+    {
+        "sm3-sm2-sm2p256-sm4gcm",
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256,
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_SM2_ECC_SM2_P256,
+        SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SM3_256,
+        SPDM_ALGORITHMS_DHE_NAMED_GROUP_SM2_P256,
+        SPDM_ALGORITHMS_AEAD_CIPHER_SUITE_AEAD_SM4_GCM,
+    },
+};
+
+/* The APP messages, echoed by the responder.*/
+typedef struct {
+    const char *operation;
+    uintn size;
+} libspdm_bench_protocol_app_t;
+
+static const libspdm_bench_protocol_app_t m_libspdm_bench_protocol_app[] = {
+    { "app_message_64", 64 },
+    { "app_message_256", 256 },
+    { "app_message_1024", 1024 },
+    { "app_message_4096", 4096 },
+};
+
+typedef struct {
+    const char *algo;
+    const char *operation;
+    uintn iterations;
+    uint64_t elapsed_ns;
+    uint64_t round_trip_count;
+    /* the APP message bytes sent and received, else 0*/
+    uint64_t app_bytes;
+} libspdm_bench_protocol_result_t;
+
+static libspdm_bench_protocol_result_t
+    m_libspdm_bench_protocol_result[LIBSPDM_BENCH_PROTOCOL_RESULT_COUNT];
+static uintn m_libspdm_bench_protocol_result_count;
+
+/* The state of the measured operation, shared with the operation functions.*/
+typedef struct {
+    libspdm_bench_loopback_t *loopback;
+    uint32_t session_id;
+    uintn app_size;
+} libspdm_bench_protocol_state_t;
+
+static return_status libspdm_bench_protocol_app_echo(
+    void *spdm_context, const uint32_t *session_id, bool is_app_message,
+    uintn request_size, const void *request, uintn *response_size, void *response)
+{
+    if (!is_app_message || (session_id == NULL) || (*response_size < request_size)) {
+        return RETURN_UNSUPPORTED;
+    }
+    libspdm_copy_mem(response, *response_size, request, request_size);
+    *response_size = request_size;
+    return RETURN_SUCCESS;
+}
+
+/* GET_DIGESTS and GET_CERTIFICATE are only allowed before the responder is authenticated.*/
+static return_status libspdm_bench_protocol_set_negotiated(libspdm_bench_protocol_state_t *state)
+{
+    libspdm_data_parameter_t parameter;
+    uint32_t connection_state;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    connection_state = LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+    libspdm_set_data(state->loopback->requester_context, LIBSPDM_DATA_CONNECTION_STATE,
+                     &parameter, &connection_state, sizeof(connection_state));
+    libspdm_set_data(state->loopback->responder_context, LIBSPDM_DATA_CONNECTION_STATE,
+                     &parameter, &connection_state, sizeof(connection_state));
+    return RETURN_SUCCESS;
+}
+
+static return_status libspdm_bench_protocol_vca(libspdm_bench_protocol_state_t *state)
+{
+    libspdm_data_parameter_t parameter;
+    uint32_t connection_state;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    connection_state = LIBSPDM_CONNECTION_STATE_NOT_STARTED;
+    libspdm_set_data(state->loopback->requester_context, LIBSPDM_DATA_CONNECTION_STATE,
+                     &parameter, &connection_state, sizeof(connection_state));
+    return libspdm_init_connection(state->loopback->requester_context, false);
+}
+
+static return_status libspdm_bench_protocol_get_digests(libspdm_bench_protocol_state_t *state)
+{
+    uint8_t slot_mask;
+    uint8_t total_digest_buffer[LIBSPDM_MAX_HASH_SIZE * SPDM_MAX_SLOT_COUNT];
+
+    return libspdm_get_digest(state->loopback->requester_context, &slot_mask,
+                              total_digest_buffer);
+}
+
+static return_status libspdm_bench_protocol_get_certificate(
+    libspdm_bench_protocol_state_t *state)
+{
+    uint8_t cert_chain[LIBSPDM_MAX_CERT_CHAIN_SIZE];
+    uintn cert_chain_size;
+
+    cert_chain_size = sizeof(cert_chain);
+    return libspdm_get_certificate(state->loopback->requester_context, 0, &cert_chain_size,
+                                   cert_chain);
+}
+
+static return_status libspdm_bench_protocol_challenge(libspdm_bench_protocol_state_t *state)
+{
+    return libspdm_challenge(state->loopback->requester_context, 0,
+                             SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH, NULL, NULL);
+}
+
+static return_status libspdm_bench_protocol_get_measurements(
+    libspdm_bench_protocol_state_t *state, uint8_t request_attribute)
+{
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint32_t measurement_record_length;
+    uint8_t number_of_blocks;
+
+    measurement_record_length = sizeof(measurement_record);
+    return libspdm_get_measurement(
+        state->loopback->requester_context, NULL, request_attribute,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        0, NULL, &number_of_blocks, &measurement_record_length, measurement_record);
+}
+
+static return_status libspdm_bench_protocol_get_measurements_signed(
+    libspdm_bench_protocol_state_t *state)
+{
+    return libspdm_bench_protocol_get_measurements(
+        state, SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE);
+}
+
+static return_status libspdm_bench_protocol_get_measurements_unsigned(
+    libspdm_bench_protocol_state_t *state)
+{
+    return_status status;
+
+    status = libspdm_bench_protocol_get_measurements(state, 0);
+
+    /* The unsigned measurements are kept for the next signature, do not let them pile up.*/
+    libspdm_reset_message_m(state->loopback->requester_context, NULL);
+    libspdm_reset_message_m(state->loopback->responder_context, NULL);
+    return status;
+}
+
+static return_status libspdm_bench_protocol_start_session(libspdm_bench_protocol_state_t *state,
+                                                          bool use_psk)
+{
+    uint8_t heartbeat_period;
+    uint8_t measurement_hash[LIBSPDM_MAX_HASH_SIZE];
+
+    return libspdm_start_session(state->loopback->requester_context, use_psk,
+                                 SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                                 0, 0, &state->session_id, &heartbeat_period,
+                                 measurement_hash);
+}
+
+static return_status libspdm_bench_protocol_key_exchange(libspdm_bench_protocol_state_t *state)
+{
+    return libspdm_bench_protocol_start_session(state, false);
+}
+
+static return_status libspdm_bench_protocol_psk_exchange(libspdm_bench_protocol_state_t *state)
+{
+    return libspdm_bench_protocol_start_session(state, true);
+}
+
+static return_status libspdm_bench_protocol_end_session(libspdm_bench_protocol_state_t *state)
+{
+    return libspdm_stop_session(state->loopback->requester_context, state->session_id, 0);
+}
+
+static return_status libspdm_bench_protocol_heartbeat(libspdm_bench_protocol_state_t *state)
+{
+    return libspdm_heartbeat(state->loopback->requester_context, state->session_id);
+}
+
+static return_status libspdm_bench_protocol_key_update(libspdm_bench_protocol_state_t *state)
+{
+    return libspdm_key_update(state->loopback->requester_context, state->session_id, false);
+}
+
+static return_status libspdm_bench_protocol_app_message(libspdm_bench_protocol_state_t *state)
+{
+    uint8_t request[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    uint8_t response[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    uintn response_size;
+    return_status status;
+
+    libspdm_set_mem(request, state->app_size, 0x5A);
+    response_size = sizeof(response);
+    status = libspdm_send_receive_data(state->loopback->requester_context, &state->session_id,
+                                       true, request, state->app_size, response,
+                                       &response_size);
+    if (!RETURN_ERROR(status) && (response_size != state->app_size)) {
+        status = RETURN_DEVICE_ERROR;
+    }
+    return status;
+}
+
+/* Run an operation, and record its latency. A setup and a cleanup run around every iteration,
+ * out of the measured time.*/
+static bool libspdm_bench_protocol_run(
+    libspdm_bench_protocol_state_t *state, const char *operation, uintn iterations,
+    return_status (*setup)(libspdm_bench_protocol_state_t *state),
+    return_status (*run)(libspdm_bench_protocol_state_t *state),
+    return_status (*cleanup)(libspdm_bench_protocol_state_t *state))
+{
+    libspdm_bench_protocol_result_t *result;
+    return_status status;
+    uint64_t start_time;
+    uint64_t round_trip_count;
+    uintn index;
+    char name[96];
+
+    if (m_libspdm_bench_protocol_result_count == LIBSPDM_BENCH_PROTOCOL_RESULT_COUNT) {
+        printf("%s - FAIL (too many results)\n", operation);
+        return false;
+    }
+    result = &m_libspdm_bench_protocol_result[m_libspdm_bench_protocol_result_count];
+    libspdm_zero_mem(result, sizeof(libspdm_bench_protocol_result_t));
+    result->algo = state->loopback->algo.name;
+    result->operation = operation;
+
+    for (index = 0; index < iterations; index++) {
+        status = (setup != NULL) ? setup(state) : RETURN_SUCCESS;
+        if (!RETURN_ERROR(status)) {
+            round_trip_count = state->loopback->round_trip_count;
+            start_time = libspdm_bench_get_time_ns();
+            status = run(state);
+            result->elapsed_ns += libspdm_bench_get_time_ns() - start_time;
+            result->round_trip_count += state->loopback->round_trip_count - round_trip_count;
+        }
+        if (!RETURN_ERROR(status) && (cleanup != NULL)) {
+            status = cleanup(state);
+        }
+        if (RETURN_ERROR(status)) {
+            printf("%s - FAIL (status 0x%x)\n", operation, (uint32_t)status);
+            return false;
+        }
+    }
+    result->iterations = iterations;
+    result->app_bytes = (uint64_t)state->app_size * 2 * iterations;
+    m_libspdm_bench_protocol_result_count++;
+
+    snprintf(name, sizeof(name), "  %s", operation);
+    libspdm_bench_report(name, iterations, result->elapsed_ns);
+    return true;
+}
+
+static bool libspdm_bench_protocol_run_session(libspdm_bench_protocol_state_t *state,
+                                               uintn iterations)
+{
+    bool result;
+    uintn index;
+
+    if (RETURN_ERROR(libspdm_bench_protocol_key_exchange(state))) {
+        printf("  session - FAIL\n");
+        return false;
+    }
+    result = libspdm_bench_protocol_run(state, "heartbeat", iterations, NULL,
+                                        libspdm_bench_protocol_heartbeat, NULL) &&
+             libspdm_bench_protocol_run(state, "key_update", iterations, NULL,
+                                        libspdm_bench_protocol_key_update, NULL);
+    for (index = 0; result && (index < ARRAY_SIZE(m_libspdm_bench_protocol_app)); index++) {
+        state->app_size = m_libspdm_bench_protocol_app[index].size;
+        result = libspdm_bench_protocol_run(state, m_libspdm_bench_protocol_app[index].operation,
+                                            iterations, NULL,
+                                            libspdm_bench_protocol_app_message, NULL);
+    }
+    state->app_size = 0;
+    if (RETURN_ERROR(libspdm_bench_protocol_end_session(state))) {
+        printf("  end session - FAIL\n");
+        return false;
+    }
+    return result;
+}
+
+/* Run all the operations with one algorithm suite. A suite that cannot connect is skipped.*/
+static bool libspdm_bench_protocol_run_algo(const libspdm_bench_loopback_algo_t *algo,
+                                            uintn iterations)
+{
+    libspdm_bench_loopback_t *loopback;
+    libspdm_bench_protocol_state_t state;
+    bool result;
+
+    loopback = malloc(sizeof(libspdm_bench_loopback_t));
+    if (loopback == NULL) {
+        printf("%s - FAIL (out of memory)\n", algo->name);
+        return false;
+    }
+    if (!libspdm_bench_loopback_init_algo(loopback, algo)) {
+        printf("%s - not supported\n", algo->name);
+        free(loopback);
+        return true;
+    }
+    if (RETURN_ERROR(libspdm_bench_loopback_connect(loopback))) {
+        printf("%s - not supported\n", algo->name);
+        libspdm_bench_loopback_free(loopback);
+        free(loopback);
+        return true;
+    }
+    libspdm_register_get_response_func(loopback->responder_context,
+                                       libspdm_bench_protocol_app_echo);
+
+    printf("%s\n", algo->name);
+    libspdm_zero_mem(&state, sizeof(state));
+    state.loopback = loopback;
+    result = libspdm_bench_protocol_run(&state, "vca", iterations, NULL,
+                                        libspdm_bench_protocol_vca, NULL) &&
+             libspdm_bench_protocol_run(&state, "get_digests", iterations,
+                                        libspdm_bench_protocol_set_negotiated,
+                                        libspdm_bench_protocol_get_digests, NULL) &&
+             libspdm_bench_protocol_run(&state, "get_certificate", iterations,
+                                        libspdm_bench_protocol_set_negotiated,
+                                        libspdm_bench_protocol_get_certificate, NULL) &&
+             libspdm_bench_protocol_run(&state, "challenge", iterations, NULL,
+                                        libspdm_bench_protocol_challenge, NULL) &&
+             libspdm_bench_protocol_run(&state, "get_measurements_signed", iterations, NULL,
+                                        libspdm_bench_protocol_get_measurements_signed, NULL) &&
+             libspdm_bench_protocol_run(&state, "get_measurements_unsigned", iterations, NULL,
+                                        libspdm_bench_protocol_get_measurements_unsigned,
+                                        NULL) &&
+             libspdm_bench_protocol_run(&state, "key_exchange_finish", iterations, NULL,
+                                        libspdm_bench_protocol_key_exchange,
+                                        libspdm_bench_protocol_end_session) &&
+             libspdm_bench_protocol_run(&state, "psk_exchange_finish", iterations, NULL,
+                                        libspdm_bench_protocol_psk_exchange,
+                                        libspdm_bench_protocol_end_session) &&
+             libspdm_bench_protocol_run_session(&state, iterations);
+
+    libspdm_bench_loopback_free(loopback);
+    free(loopback);
+    return result;
+}
+
+static bool libspdm_bench_protocol_write_json(const char *file_name, uintn iterations)
+{
+    const libspdm_bench_protocol_result_t *result;
+    FILE *file;
+    uintn index;
+
+    file = fopen(file_name, "w");
+    if (file == NULL) {
+        printf("!!!Unable to write file(%s)\n", file_name);
+        return false;
+    }
+    fprintf(file, "{\n");
+    fprintf(file, "  \"benchmark\": \"bench_protocol\",\n");
+    fprintf(file, "  \"crypto\": \"%s\",\n", LIBSPDM_BENCH_PROTOCOL_CRYPTO);
+    fprintf(file, "  \"iterations\": %llu,\n", (unsigned long long)iterations);
+    fprintf(file, "  \"results\": [");
+    for (index = 0; index < m_libspdm_bench_protocol_result_count; index++) {
+        result = &m_libspdm_bench_protocol_result[index];
+        fprintf(file, "%s\n    {\"suite\": \"%s\", \"operation\": \"%s\", ",
+                (index == 0) ? "" : ",", result->algo, result->operation);
+        fprintf(file, "\"iterations\": %llu, \"us_per_op\": %.3f, ",
+                (unsigned long long)result->iterations,
+                (double)result->elapsed_ns / 1000.0 / (double)result->iterations);
+        fprintf(file, "\"round_trips_per_op\": %.2f, \"app_bytes\": %llu",
+                (double)result->round_trip_count / (double)result->iterations,
+                (unsigned long long)result->app_bytes);
+        if (result->app_bytes != 0) {
+            fprintf(file, ", \"app_mb_per_s\": %.3f",
+                    (double)result->app_bytes * 1000.0 / (double)result->elapsed_ns);
+        }
+        fprintf(file, "}");
+    }
+    fprintf(file, "\n  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uintn iterations;
+    uintn index;
+    int return_value;
+
+    iterations = LIBSPDM_BENCH_PROTOCOL_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = (uintn)strtoul(argv[1], NULL, 0);
+        if (iterations == 0) {
+            iterations = LIBSPDM_BENCH_PROTOCOL_DEFAULT_ITERATIONS;
+        }
+    }
+
+    printf("crypto: %s\n", LIBSPDM_BENCH_PROTOCOL_CRYPTO);
+    return_value = 0;
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_protocol_algo); index++) {
+        if (!libspdm_bench_protocol_run_algo(&m_libspdm_bench_protocol_algo[index], iterations)) {
+            return_value = 1;
+        }
+    }
+
+    if ((argc > 2) && !libspdm_bench_protocol_write_json(argv[2], iterations)) {
+        return_value = 1;
+    }
+    return return_value;
+}
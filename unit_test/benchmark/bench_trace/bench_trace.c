@@ -0,0 +1,174 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Per-phase latency of an in-process requester and responder, from the trace events.
+ *
+ * Every iteration authenticates the responder, gets the signed measurements and runs a
+ * KEY_EXCHANGE session. The iterations run once without a trace function and once with the
+ * trace sinks, to report the cost of the tracing, then the latency of every request code and
+ * phase is printed for the requester and the responder.
+ *
+ * Usage: bench_trace [iterations] [capture_file]
+ * With a capture file, the messages of the requester in the traced iterations are also captured,
+ * and the capture buffer is saved for spdm_capture_decode.
+ **/
+
+#include "bench_loopback.h"
+#include "bench_trace.h"
+
+#define LIBSPDM_BENCH_TRACE_DEFAULT_ITERATIONS 20
+#define LIBSPDM_BENCH_TRACE_CAPTURE_SIZE 0x10000
+
+static uint8_t m_libspdm_bench_trace_capture[LIBSPDM_BENCH_TRACE_CAPTURE_SIZE];
+
+static bool libspdm_bench_trace_save_capture(const char *file_name)
+{
+    FILE *file;
+    bool result;
+
+    file = fopen(file_name, "wb");
+    if (file == NULL) {
+        return false;
+    }
+    result = fwrite(m_libspdm_bench_trace_capture, 1, sizeof(m_libspdm_bench_trace_capture),
+                    file) == sizeof(m_libspdm_bench_trace_capture);
+    fclose(file);
+    return result;
+}
+
+static return_status libspdm_bench_trace_iteration(libspdm_bench_loopback_t *loopback)
+{
+    libspdm_data_parameter_t parameter;
+    uint32_t connection_state;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint32_t measurement_record_length;
+    uint8_t number_of_blocks;
+    uint32_t session_id;
+    uint8_t heartbeat_period;
+    uint8_t measurement_hash[LIBSPDM_MAX_HASH_SIZE];
+    return_status status;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    connection_state = LIBSPDM_CONNECTION_STATE_NOT_STARTED;
+    libspdm_set_data(loopback->requester_context, LIBSPDM_DATA_CONNECTION_STATE, &parameter,
+                     &connection_state, sizeof(connection_state));
+    status = libspdm_bench_loopback_connect(loopback);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement(
+        loopback->requester_context, NULL,
+        SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+        0, NULL, &number_of_blocks, &measurement_record_length, measurement_record);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+
+    status = libspdm_start_session(loopback->requester_context, false,
+                                   SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH,
+                                   0, 0, &session_id, &heartbeat_period, measurement_hash);
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+    return libspdm_stop_session(loopback->requester_context, session_id, 0);
+}
+
+static bool libspdm_bench_trace_run(libspdm_bench_loopback_t *loopback, const char *name,
+                                    uintn iterations)
+{
+    return_status status;
+    uint64_t start_time;
+    uintn index;
+
+    start_time = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        status = libspdm_bench_trace_iteration(loopback);
+        if (RETURN_ERROR(status)) {
+            printf("%s - FAIL (status 0x%x)\n", name, (uint32_t)status);
+            return false;
+        }
+    }
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start_time);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    libspdm_bench_loopback_t *loopback;
+    libspdm_bench_trace_t *requester_trace;
+    libspdm_bench_trace_t *responder_trace;
+    uintn iterations;
+    const char *capture_file;
+    int return_value;
+
+    iterations = LIBSPDM_BENCH_TRACE_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = (uintn)strtoul(argv[1], NULL, 0);
+    }
+    capture_file = (argc > 2) ? argv[2] : NULL;
+
+    loopback = malloc(sizeof(libspdm_bench_loopback_t));
+    requester_trace = malloc(sizeof(libspdm_bench_trace_t));
+    responder_trace = malloc(sizeof(libspdm_bench_trace_t));
+    if ((loopback == NULL) || (requester_trace == NULL) || (responder_trace == NULL) ||
+        !libspdm_bench_loopback_init(loopback)) {
+        printf("loopback init - FAIL\n");
+        free(loopback);
+        free(requester_trace);
+        free(responder_trace);
+        return 1;
+    }
+    libspdm_bench_trace_reset(requester_trace);
+    libspdm_bench_trace_reset(responder_trace);
+
+    return_value = 1;
+    /* The first iteration warms up the crypto backend.*/
+    if (!libspdm_bench_trace_run(loopback, "warm up", 1) ||
+        !libspdm_bench_trace_run(loopback, "iteration, no trace", iterations)) {
+        goto done;
+    }
+    if (!libspdm_bench_trace_attach(requester_trace, loopback->requester_context) ||
+        !libspdm_bench_trace_attach(responder_trace, loopback->responder_context)) {
+        printf("trace attach - FAIL\n");
+        goto done;
+    }
+    if ((capture_file != NULL) &&
+        RETURN_ERROR(libspdm_start_message_capture(
+                         loopback->requester_context, m_libspdm_bench_trace_capture,
+                         sizeof(m_libspdm_bench_trace_capture),
+                         LIBSPDM_CAPTURE_FLAG_MESSAGE | LIBSPDM_CAPTURE_FLAG_WIRE,
+                         libspdm_bench_get_time_ns))) {
+        printf("message capture - FAIL\n");
+        goto done;
+    }
+    if (!libspdm_bench_trace_run(loopback, "iteration, trace", iterations)) {
+        goto done;
+    }
+    if (capture_file != NULL) {
+        libspdm_stop_message_capture(loopback->requester_context);
+        if (!libspdm_bench_trace_save_capture(capture_file)) {
+            printf("save %s - FAIL\n", capture_file);
+            goto done;
+        }
+    }
+    libspdm_bench_trace_dump("requester", requester_trace);
+    libspdm_bench_trace_dump("responder", responder_trace);
+    return_value = 0;
+
+done:
+    libspdm_bench_trace_detach(loopback->requester_context);
+    libspdm_bench_trace_detach(loopback->responder_context);
+    libspdm_bench_loopback_free(loopback);
+    free(loopback);
+    free(requester_trace);
+    free(responder_trace);
+    return return_value;
+}
@@ -0,0 +1,339 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Transcript hashing benchmark.
+ *
+ * It replays the transcript hashing of one KEY_EXCHANGE/FINISH handshake, as done by
+ * libspdm_append_message_k/f and libspdm_calculate_th_*_for_exchange/finish:
+ *  - context: hash and HMAC contexts from libspdm_hash_new/libspdm_hmac_new, every TH
+ *             computed on a duplicated context, as the transcript used to do,
+ *  - state:   embedded libspdm_hash_state_t/libspdm_hmac_state_t, as the transcript does now.
+ *
+ * Besides the time, it reports the number of hash/HMAC contexts allocated per handshake.
+ * A state only counts as allocated when the backend keeps it in heap_context.
+ *
+ * Usage: bench_transcript [iterations]
+ **/
+
+#include "bench_common.h"
+#include "library/spdm_crypt_lib.h"
+
+#define LIBSPDM_BENCH_DEFAULT_ITERATIONS 10000
+
+typedef struct {
+    uint32_t base_hash_algo;
+    const char *name;
+} libspdm_bench_hash_algo_t;
+
+static const libspdm_bench_hash_algo_t m_libspdm_bench_hash_algo[] = {
+#if LIBSPDM_SHA256_SUPPORT == 1
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256, "sha256" },
+#endif
+#if LIBSPDM_SHA384_SUPPORT == 1
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384, "sha384" },
+#endif
+#if LIBSPDM_SHA512_SUPPORT == 1
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512, "sha512" },
+#endif
+#if LIBSPDM_SM3_256_SUPPORT == 1
+    { SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SM3_256, "sm3_256" },
+#endif
+};
+
+/* VCA, certificate chain hash, KEY_EXCHANGE request/response and FINISH request/response.*/
+static uint8_t m_libspdm_bench_message_a[150];
+static uint8_t m_libspdm_bench_cert_chain_hash[LIBSPDM_MAX_HASH_SIZE];
+static uint8_t m_libspdm_bench_message_k[2][200];
+static uint8_t m_libspdm_bench_message_f[2][100];
+static uint8_t m_libspdm_bench_finished_key[2][LIBSPDM_MAX_HASH_SIZE];
+
+static uintn m_libspdm_bench_allocation_count;
+
+static void *libspdm_bench_hash_new(uint32_t base_hash_algo)
+{
+    m_libspdm_bench_allocation_count++;
+    return libspdm_hash_new(base_hash_algo);
+}
+
+static void *libspdm_bench_hmac_new(uint32_t base_hash_algo)
+{
+    m_libspdm_bench_allocation_count++;
+    return libspdm_hmac_new(base_hash_algo);
+}
+
+static bool libspdm_bench_hash_final_copy(uint32_t base_hash_algo, const void *hash_ctx,
+                                          uint8_t *hash_value)
+{
+    void *hash_ctx_copy;
+    bool result;
+
+    hash_ctx_copy = libspdm_bench_hash_new(base_hash_algo);
+    result = libspdm_hash_duplicate(base_hash_algo, hash_ctx, hash_ctx_copy) &&
+             libspdm_hash_final(base_hash_algo, hash_ctx_copy, hash_value);
+    libspdm_hash_free(base_hash_algo, hash_ctx_copy);
+    return result;
+}
+
+static bool libspdm_bench_hmac_final_copy(uint32_t base_hash_algo, const void *hmac_ctx,
+                                          uint8_t *hmac_value)
+{
+    void *hmac_ctx_copy;
+    bool result;
+
+    hmac_ctx_copy = libspdm_bench_hmac_new(base_hash_algo);
+    result = libspdm_hmac_duplicate(base_hash_algo, hmac_ctx, hmac_ctx_copy) &&
+             libspdm_hmac_final(base_hash_algo, hmac_ctx_copy, hmac_value);
+    libspdm_hmac_free(base_hash_algo, hmac_ctx_copy);
+    return result;
+}
+
+/* One handshake with hash/HMAC contexts.*/
+static bool libspdm_bench_transcript_context(uint32_t base_hash_algo)
+{
+    void *th;
+    void *hmac_th[2];
+    void *th_backup;
+    void *hmac_th_backup[2];
+    uint8_t value[LIBSPDM_MAX_HASH_SIZE];
+    uint32_t hash_size;
+    uintn index;
+    bool result;
+
+    hash_size = libspdm_get_hash_size(base_hash_algo);
+
+    /* KEY_EXCHANGE: TH for the signature, then the HMAC once the finished_key is ready.*/
+    th = libspdm_bench_hash_new(base_hash_algo);
+    result = libspdm_hash_init(base_hash_algo, th) &&
+             libspdm_hash_update(base_hash_algo, th, m_libspdm_bench_message_a,
+                                 sizeof(m_libspdm_bench_message_a)) &&
+             libspdm_hash_update(base_hash_algo, th, m_libspdm_bench_cert_chain_hash,
+                                 hash_size) &&
+             libspdm_hash_update(base_hash_algo, th, m_libspdm_bench_message_k[0],
+                                 sizeof(m_libspdm_bench_message_k[0])) &&
+             libspdm_bench_hash_final_copy(base_hash_algo, th, value);
+    for (index = 0; index < 2; index++) {
+        hmac_th[index] = libspdm_bench_hmac_new(base_hash_algo);
+        result = result &&
+                 libspdm_hmac_init(base_hash_algo, hmac_th[index],
+                                   m_libspdm_bench_finished_key[index], hash_size) &&
+                 libspdm_hmac_update(base_hash_algo, hmac_th[index],
+                                     m_libspdm_bench_message_a,
+                                     sizeof(m_libspdm_bench_message_a)) &&
+                 libspdm_hmac_update(base_hash_algo, hmac_th[index],
+                                     m_libspdm_bench_cert_chain_hash, hash_size) &&
+                 libspdm_hmac_update(base_hash_algo, hmac_th[index],
+                                     m_libspdm_bench_message_k[0],
+                                     sizeof(m_libspdm_bench_message_k[0]));
+    }
+    result = result && libspdm_bench_hmac_final_copy(base_hash_algo, hmac_th[0], value) &&
+             libspdm_hash_update(base_hash_algo, th, m_libspdm_bench_message_k[1],
+                                 sizeof(m_libspdm_bench_message_k[1]));
+    for (index = 0; index < 2; index++) {
+        result = result &&
+                 libspdm_hmac_update(base_hash_algo, hmac_th[index],
+                                     m_libspdm_bench_message_k[1],
+                                     sizeof(m_libspdm_bench_message_k[1]));
+    }
+
+    /* FINISH: backup for reset_message_f, then the request and response HMACs and th2.*/
+    th_backup = libspdm_bench_hash_new(base_hash_algo);
+    result = result && libspdm_hash_duplicate(base_hash_algo, th, th_backup);
+    for (index = 0; index < 2; index++) {
+        hmac_th_backup[index] = libspdm_bench_hmac_new(base_hash_algo);
+        result = result &&
+                 libspdm_hmac_duplicate(base_hash_algo, hmac_th[index], hmac_th_backup[index]);
+    }
+    result = result &&
+             libspdm_hash_update(base_hash_algo, th, m_libspdm_bench_message_f[0],
+                                 sizeof(m_libspdm_bench_message_f[0])) &&
+             libspdm_hmac_update(base_hash_algo, hmac_th[0], m_libspdm_bench_message_f[0],
+                                 sizeof(m_libspdm_bench_message_f[0])) &&
+             libspdm_hmac_update(base_hash_algo, hmac_th[1], m_libspdm_bench_message_f[0],
+                                 sizeof(m_libspdm_bench_message_f[0])) &&
+             libspdm_bench_hmac_final_copy(base_hash_algo, hmac_th[1], value) &&
+             libspdm_bench_hmac_final_copy(base_hash_algo, hmac_th[0], value) &&
+             libspdm_hash_update(base_hash_algo, th, m_libspdm_bench_message_f[1],
+                                 sizeof(m_libspdm_bench_message_f[1])) &&
+             libspdm_bench_hash_final_copy(base_hash_algo, th, value);
+
+    libspdm_hash_free(base_hash_algo, th);
+    libspdm_hash_free(base_hash_algo, th_backup);
+    for (index = 0; index < 2; index++) {
+        libspdm_hmac_free(base_hash_algo, hmac_th[index]);
+        libspdm_hmac_free(base_hash_algo, hmac_th_backup[index]);
+    }
+    return result;
+}
+
+static void libspdm_bench_count_hash_state(const libspdm_hash_state_t *state)
+{
+    if (state->heap_context != NULL) {
+        m_libspdm_bench_allocation_count++;
+    }
+}
+
+static void libspdm_bench_count_hmac_state(const libspdm_hmac_state_t *state)
+{
+    libspdm_bench_count_hash_state(&state->inner);
+    libspdm_bench_count_hash_state(&state->outer);
+}
+
+static bool libspdm_bench_hash_state_final_copy(const libspdm_hash_state_t *state,
+                                                uint8_t *hash_value)
+{
+    libspdm_bench_count_hash_state(state);
+    return libspdm_hash_state_final_copy(state, hash_value);
+}
+
+static bool libspdm_bench_hmac_state_final_copy(const libspdm_hmac_state_t *state,
+                                                uint8_t *hmac_value)
+{
+    libspdm_bench_count_hmac_state(state);
+    return libspdm_hmac_state_final_copy(state, hmac_value);
+}
+
+/* The same handshake with embedded hash/HMAC states.*/
+static bool libspdm_bench_transcript_state(uint32_t base_hash_algo)
+{
+    libspdm_hash_state_t th;
+    libspdm_hmac_state_t hmac_th[2];
+    libspdm_hash_state_t th_backup;
+    libspdm_hmac_state_t hmac_th_backup[2];
+    uint8_t value[LIBSPDM_MAX_HASH_SIZE];
+    uint32_t hash_size;
+    uintn index;
+    bool result;
+
+    hash_size = libspdm_get_hash_size(base_hash_algo);
+    libspdm_zero_mem(&th_backup, sizeof(th_backup));
+    libspdm_zero_mem(hmac_th, sizeof(hmac_th));
+    libspdm_zero_mem(hmac_th_backup, sizeof(hmac_th_backup));
+
+    result = libspdm_hash_state_init(base_hash_algo, &th);
+    if (result) {
+        libspdm_bench_count_hash_state(&th);
+    }
+    result = result &&
+             libspdm_hash_state_update(&th, m_libspdm_bench_message_a,
+                                       sizeof(m_libspdm_bench_message_a)) &&
+             libspdm_hash_state_update(&th, m_libspdm_bench_cert_chain_hash, hash_size) &&
+             libspdm_hash_state_update(&th, m_libspdm_bench_message_k[0],
+                                       sizeof(m_libspdm_bench_message_k[0])) &&
+             libspdm_bench_hash_state_final_copy(&th, value);
+    for (index = 0; index < 2; index++) {
+        result = result &&
+                 libspdm_hmac_state_init(base_hash_algo, &hmac_th[index],
+                                         m_libspdm_bench_finished_key[index], hash_size) &&
+                 libspdm_hmac_state_update(&hmac_th[index], m_libspdm_bench_message_a,
+                                           sizeof(m_libspdm_bench_message_a)) &&
+                 libspdm_hmac_state_update(&hmac_th[index], m_libspdm_bench_cert_chain_hash,
+                                           hash_size) &&
+                 libspdm_hmac_state_update(&hmac_th[index], m_libspdm_bench_message_k[0],
+                                           sizeof(m_libspdm_bench_message_k[0]));
+        libspdm_bench_count_hmac_state(&hmac_th[index]);
+    }
+    result = result && libspdm_bench_hmac_state_final_copy(&hmac_th[0], value) &&
+             libspdm_hash_state_update(&th, m_libspdm_bench_message_k[1],
+                                       sizeof(m_libspdm_bench_message_k[1]));
+    for (index = 0; index < 2; index++) {
+        result = result &&
+                 libspdm_hmac_state_update(&hmac_th[index], m_libspdm_bench_message_k[1],
+                                           sizeof(m_libspdm_bench_message_k[1]));
+    }
+
+    result = result && libspdm_hash_state_duplicate(&th, &th_backup);
+    libspdm_bench_count_hash_state(&th_backup);
+    for (index = 0; index < 2; index++) {
+        result = result && libspdm_hmac_state_duplicate(&hmac_th[index], &hmac_th_backup[index]);
+        libspdm_bench_count_hmac_state(&hmac_th_backup[index]);
+    }
+    result = result &&
+             libspdm_hash_state_update(&th, m_libspdm_bench_message_f[0],
+                                       sizeof(m_libspdm_bench_message_f[0])) &&
+             libspdm_hmac_state_update(&hmac_th[0], m_libspdm_bench_message_f[0],
+                                       sizeof(m_libspdm_bench_message_f[0])) &&
+             libspdm_hmac_state_update(&hmac_th[1], m_libspdm_bench_message_f[0],
+                                       sizeof(m_libspdm_bench_message_f[0])) &&
+             libspdm_bench_hmac_state_final_copy(&hmac_th[1], value) &&
+             libspdm_bench_hmac_state_final_copy(&hmac_th[0], value) &&
+             libspdm_hash_state_update(&th, m_libspdm_bench_message_f[1],
+                                       sizeof(m_libspdm_bench_message_f[1])) &&
+             libspdm_bench_hash_state_final_copy(&th, value);
+
+    libspdm_hash_state_free(&th);
+    libspdm_hash_state_free(&th_backup);
+    for (index = 0; index < 2; index++) {
+        libspdm_hmac_state_free(&hmac_th[index]);
+        libspdm_hmac_state_free(&hmac_th_backup[index]);
+    }
+    return result;
+}
+
+static bool libspdm_bench_transcript(const libspdm_bench_hash_algo_t *algo, uintn iterations)
+{
+    uintn index;
+    uint64_t start;
+    char name[64];
+
+    m_libspdm_bench_allocation_count = 0;
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_bench_transcript_context(algo->base_hash_algo)) {
+            return false;
+        }
+    }
+    snprintf(name, sizeof(name), "%s context", algo->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+    printf("%s context: %d allocations per handshake\n", algo->name,
+           (int)(m_libspdm_bench_allocation_count / iterations));
+
+    m_libspdm_bench_allocation_count = 0;
+    start = libspdm_bench_get_time_ns();
+    for (index = 0; index < iterations; index++) {
+        if (!libspdm_bench_transcript_state(algo->base_hash_algo)) {
+            return false;
+        }
+    }
+    snprintf(name, sizeof(name), "%s state", algo->name);
+    libspdm_bench_report(name, iterations, libspdm_bench_get_time_ns() - start);
+    printf("%s state: %d allocations per handshake\n", algo->name,
+           (int)(m_libspdm_bench_allocation_count / iterations));
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uintn iterations;
+    uintn index;
+    int return_value;
+
+    iterations = LIBSPDM_BENCH_DEFAULT_ITERATIONS;
+    if (argc > 1) {
+        iterations = (uintn)strtoul(argv[1], NULL, 0);
+    }
+    if (iterations == 0) {
+        iterations = 1;
+    }
+
+    libspdm_set_mem(m_libspdm_bench_message_a, sizeof(m_libspdm_bench_message_a), 0x11);
+    libspdm_set_mem(m_libspdm_bench_cert_chain_hash, sizeof(m_libspdm_bench_cert_chain_hash),
+                    0x22);
+    libspdm_set_mem(m_libspdm_bench_message_k, sizeof(m_libspdm_bench_message_k), 0x33);
+    libspdm_set_mem(m_libspdm_bench_message_f, sizeof(m_libspdm_bench_message_f), 0x44);
+    libspdm_set_mem(m_libspdm_bench_finished_key, sizeof(m_libspdm_bench_finished_key), 0x55);
+
+    return_value = 0;
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_bench_hash_algo); index++) {
+        if (!libspdm_bench_transcript(&m_libspdm_bench_hash_algo[index], iterations)) {
+            printf("%s - FAIL\n", m_libspdm_bench_hash_algo[index].name);
+            return_value = 1;
+        }
+    }
+
+    return return_value;
+}
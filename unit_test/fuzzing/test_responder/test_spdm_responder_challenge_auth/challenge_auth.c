@@ -222,7 +222,7 @@ void libspdm_test_responder_challenge_case5(void **State)
     free(data);
     #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     #else
-    free(spdm_context->transcript.digest_context_m1m2);
+    libspdm_hash_state_free(&spdm_context->transcript.digest_context_m1m2);
     #endif
 }
 
@@ -113,7 +113,7 @@ void libspdm_test_responder_encap_challenge_case1(void **State)
     free(data);
     #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     #else
-    free(spdm_context->transcript.digest_context_mut_m1m2);
+    libspdm_hash_state_free(&spdm_context->transcript.digest_context_mut_m1m2);
     #endif
 }
 
@@ -154,7 +154,7 @@ void libspdm_test_get_encap_request_challenge_case2(void **State)
     free(data);
     #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     #else
-    free(spdm_context->transcript.digest_context_mut_m1m2);
+    libspdm_hash_state_free(&spdm_context->transcript.digest_context_mut_m1m2);
     #endif
 }
 
@@ -60,7 +60,7 @@ void libspdm_test_get_response_encapsulated_request_case1(void **State)
     free(data);
     #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     #else
-    free(spdm_context->transcript.digest_context_mut_m1m2);
+    libspdm_hash_state_free(&spdm_context->transcript.digest_context_mut_m1m2);
     #endif
 }
 
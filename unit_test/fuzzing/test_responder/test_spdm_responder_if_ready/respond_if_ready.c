@@ -57,12 +57,12 @@ void libspdm_test_responder_respond_if_ready(void **State)
     spdm_context->local_context.slot_count = 1;
 
     spdm_context->last_spdm_request_size = spdm_test_get_digest_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &spdm_test_get_digest_request,  spdm_test_get_digest_request_size);
 
     spdm_context->cache_spdm_request_size =
         spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm = 1;
@@ -76,7 +76,7 @@ void libspdm_test_responder_respond_if_ready(void **State)
                                           &response_size, response);
     #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     #else
-    free(spdm_context->transcript.digest_context_m1m2);
+    libspdm_hash_state_free(&spdm_context->transcript.digest_context_m1m2);
     #endif
 }
 
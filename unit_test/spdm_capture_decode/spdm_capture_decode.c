@@ -0,0 +1,299 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * Render a message capture as an SPDM transcript.
+ *
+ * The capture file is the capture buffer given to libspdm_start_message_capture, saved as is
+ * between two SPDM calls of the context. The ring has no protocol for a concurrent reader, so a
+ * buffer saved during an SPDM call may be torn; the offsets are still checked before use.
+ * The records are printed from the oldest, with the sequence number, the time stamp relative to
+ * the first record, the direction and the session, then the decoded SPDM header and the bytes.
+ * The capture is read in the byte order of the host, the same as the device that captured it.
+ *
+ * Usage: spdm_capture_decode [-s] capture_file
+ * With -s, only the summary line of every record is printed.
+ **/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "library/spdm_common_lib.h"
+
+typedef struct {
+    uint8_t code;
+    const char *name;
+} libspdm_capture_decode_name_t;
+
+static const libspdm_capture_decode_name_t m_libspdm_capture_decode_code_name[] = {
+    { SPDM_DIGESTS, "DIGESTS" },
+    { SPDM_CERTIFICATE, "CERTIFICATE" },
+    { SPDM_CHALLENGE_AUTH, "CHALLENGE_AUTH" },
+    { SPDM_VERSION, "VERSION" },
+    { SPDM_MEASUREMENTS, "MEASUREMENTS" },
+    { SPDM_CAPABILITIES, "CAPABILITIES" },
+    { SPDM_ALGORITHMS, "ALGORITHMS" },
+    { SPDM_VENDOR_DEFINED_RESPONSE, "VENDOR_DEFINED_RESPONSE" },
+    { SPDM_ERROR, "ERROR" },
+    { SPDM_KEY_EXCHANGE_RSP, "KEY_EXCHANGE_RSP" },
+    { SPDM_FINISH_RSP, "FINISH_RSP" },
+    { SPDM_PSK_EXCHANGE_RSP, "PSK_EXCHANGE_RSP" },
+    { SPDM_PSK_FINISH_RSP, "PSK_FINISH_RSP" },
+    { SPDM_HEARTBEAT_ACK, "HEARTBEAT_ACK" },
+    { SPDM_KEY_UPDATE_ACK, "KEY_UPDATE_ACK" },
+    { SPDM_ENCAPSULATED_REQUEST, "ENCAPSULATED_REQUEST" },
+    { SPDM_ENCAPSULATED_RESPONSE_ACK, "ENCAPSULATED_RESPONSE_ACK" },
+    { SPDM_END_SESSION_ACK, "END_SESSION_ACK" },
+    { SPDM_GET_DIGESTS, "GET_DIGESTS" },
+    { SPDM_GET_CERTIFICATE, "GET_CERTIFICATE" },
+    { SPDM_CHALLENGE, "CHALLENGE" },
+    { SPDM_GET_VERSION, "GET_VERSION" },
+    { SPDM_GET_MEASUREMENTS, "GET_MEASUREMENTS" },
+    { SPDM_GET_CAPABILITIES, "GET_CAPABILITIES" },
+    { SPDM_NEGOTIATE_ALGORITHMS, "NEGOTIATE_ALGORITHMS" },
+    { SPDM_VENDOR_DEFINED_REQUEST, "VENDOR_DEFINED_REQUEST" },
+    { SPDM_RESPOND_IF_READY, "RESPOND_IF_READY" },
+    { SPDM_KEY_EXCHANGE, "KEY_EXCHANGE" },
+    { SPDM_FINISH, "FINISH" },
+    { SPDM_PSK_EXCHANGE, "PSK_EXCHANGE" },
+    { SPDM_PSK_FINISH, "PSK_FINISH" },
+    { SPDM_HEARTBEAT, "HEARTBEAT" },
+    { SPDM_KEY_UPDATE, "KEY_UPDATE" },
+    { SPDM_GET_ENCAPSULATED_REQUEST, "GET_ENCAPSULATED_REQUEST" },
+    { SPDM_DELIVER_ENCAPSULATED_RESPONSE, "DELIVER_ENCAPSULATED_RESPONSE" },
+    { SPDM_END_SESSION, "END_SESSION" },
+};
+
+static const libspdm_capture_decode_name_t m_libspdm_capture_decode_error_name[] = {
+    { SPDM_ERROR_CODE_INVALID_REQUEST, "InvalidRequest" },
+    { SPDM_ERROR_CODE_INVALID_SESSION, "InvalidSession" },
+    { SPDM_ERROR_CODE_BUSY, "Busy" },
+    { SPDM_ERROR_CODE_UNEXPECTED_REQUEST, "UnexpectedRequest" },
+    { SPDM_ERROR_CODE_UNSPECIFIED, "Unspecified" },
+    { SPDM_ERROR_CODE_DECRYPT_ERROR, "DecryptError" },
+    { SPDM_ERROR_CODE_UNSUPPORTED_REQUEST, "UnsupportedRequest" },
+    { SPDM_ERROR_CODE_REQUEST_IN_FLIGHT, "RequestInFlight" },
+    { SPDM_ERROR_CODE_INVALID_RESPONSE_CODE, "InvalidResponseCode" },
+    { SPDM_ERROR_CODE_SESSION_LIMIT_EXCEEDED, "SessionLimitExceeded" },
+    { SPDM_ERROR_CODE_SESSION_REQUIRED, "SessionRequired" },
+    { SPDM_ERROR_CODE_RESET_REQUIRED, "ResetRequired" },
+    { SPDM_ERROR_CODE_RESPONSE_TOO_LARGE, "ResponseTooLarge" },
+    { SPDM_ERROR_CODE_REQUEST_TOO_LARGE, "RequestTooLarge" },
+    { SPDM_ERROR_CODE_LARGE_RESPONSE, "LargeResponse" },
+    { SPDM_ERROR_CODE_MESSAGE_LOST, "MessageLost" },
+    { SPDM_ERROR_CODE_VERSION_MISMATCH, "VersionMismatch" },
+    { SPDM_ERROR_CODE_RESPONSE_NOT_READY, "ResponseNotReady" },
+    { SPDM_ERROR_CODE_REQUEST_RESYNCH, "RequestResynch" },
+    { SPDM_ERROR_CODE_VENDOR_DEFINED, "VendorDefined" },
+};
+
+static const char *libspdm_capture_decode_name(const libspdm_capture_decode_name_t *table,
+                                               uintn count, uint8_t code)
+{
+    uintn index;
+
+    for (index = 0; index < count; index++) {
+        if (table[index].code == code) {
+            return table[index].name;
+        }
+    }
+    return "UNKNOWN";
+}
+
+static void libspdm_capture_decode_dump_hex(const uint8_t *data, uintn size)
+{
+    uintn index;
+
+    for (index = 0; index < size; index++) {
+        if ((index % 16) == 0) {
+            printf("      %04x:", (uint32_t)index);
+        }
+        printf(" %02x", data[index]);
+        if (((index % 16) == 15) || (index == size - 1)) {
+            printf("\n");
+        }
+    }
+}
+
+/* Print the SPDM header of a plain text message, and the fields worth a glance.*/
+static void libspdm_capture_decode_spdm(const uint8_t *message, uintn size)
+{
+    const spdm_message_header_t *header;
+    const spdm_version_response_t *version_response;
+    const uint8_t *version_entry;
+    uint16_t version;
+    uintn index;
+
+    if (size < sizeof(spdm_message_header_t)) {
+        printf(" (short message)");
+        return;
+    }
+    header = (const spdm_message_header_t *)message;
+    printf(" SPDM %d.%d %s (0x%02x) param 0x%02x 0x%02x",
+           header->spdm_version >> 4, header->spdm_version & 0xF,
+           libspdm_capture_decode_name(m_libspdm_capture_decode_code_name,
+                                       ARRAY_SIZE(m_libspdm_capture_decode_code_name),
+                                       header->request_response_code),
+           header->request_response_code, header->param1, header->param2);
+
+    switch (header->request_response_code) {
+    case SPDM_ERROR:
+        printf(" [%s]", libspdm_capture_decode_name(
+                   m_libspdm_capture_decode_error_name,
+                   ARRAY_SIZE(m_libspdm_capture_decode_error_name), header->param1));
+        break;
+    case SPDM_VERSION:
+        if (size < sizeof(spdm_version_response_t)) {
+            break;
+        }
+        version_response = (const spdm_version_response_t *)message;
+        version_entry = message + sizeof(spdm_version_response_t);
+        printf(" [");
+        for (index = 0; index < version_response->version_number_entry_count; index++) {
+            if (sizeof(spdm_version_response_t) +
+                (index + 1) * sizeof(spdm_version_number_t) > size) {
+                break;
+            }
+            version = (uint16_t)(version_entry[index * 2] | (version_entry[index * 2 + 1] << 8));
+            version >>= SPDM_VERSION_NUMBER_SHIFT_BIT;
+            printf("%s%d.%d", (index == 0) ? "" : " ", version >> 4, version & 0xF);
+        }
+        printf("]");
+        break;
+    default:
+        break;
+    }
+}
+
+static bool libspdm_capture_decode(const uint8_t *capture, uintn capture_size, bool summary)
+{
+    const libspdm_capture_header_t *header;
+    const libspdm_capture_record_t *record;
+    const uint8_t *data;
+    uint32_t offset;
+    uint32_t index;
+    uint64_t first_time_stamp;
+    bool first;
+    uintn captured_size;
+
+    if (capture_size < sizeof(libspdm_capture_header_t)) {
+        printf("capture too short\n");
+        return false;
+    }
+    header = (const libspdm_capture_header_t *)capture;
+    if ((header->signature != LIBSPDM_CAPTURE_SIGNATURE) ||
+        (header->version != LIBSPDM_CAPTURE_VERSION)) {
+        printf("not a message capture, or an unsupported version\n");
+        return false;
+    }
+    if ((header->data_size > capture_size - sizeof(libspdm_capture_header_t)) ||
+        (header->tail >= header->data_size) || (header->head >= header->data_size)) {
+        printf("capture truncated or corrupted\n");
+        return false;
+    }
+    data = capture + sizeof(libspdm_capture_header_t);
+
+    printf("capture: %u records, sequence %llu, %u bytes, flags 0x%x\n",
+           header->record_count, (unsigned long long)header->sequence, header->data_size,
+           header->flags);
+
+    offset = header->tail;
+    first_time_stamp = 0;
+    first = true;
+    for (index = 0; index < header->record_count; index++) {
+        if (header->data_size - offset < sizeof(libspdm_capture_record_t)) {
+            offset = 0;
+        }
+        record = (const libspdm_capture_record_t *)(data + offset);
+        if ((record->record_size < sizeof(libspdm_capture_record_t)) ||
+            (record->record_size > header->data_size - offset)) {
+            printf("record at offset 0x%x corrupted\n", offset);
+            return false;
+        }
+        offset += record->record_size;
+        if (record->type == LIBSPDM_CAPTURE_RECORD_PAD) {
+            continue;
+        }
+        if (first) {
+            first = false;
+            first_time_stamp = record->time_stamp;
+            if (record->sequence != 0) {
+                printf("... %llu older records overwritten\n",
+                       (unsigned long long)record->sequence);
+            }
+        }
+
+        captured_size = record->record_size - sizeof(libspdm_capture_record_t);
+        if (captured_size > record->message_size) {
+            captured_size = record->message_size;
+        }
+        printf("#%llu +%llu %-4s session 0x%08x %-4s %u bytes",
+               (unsigned long long)record->sequence,
+               (unsigned long long)(record->time_stamp - first_time_stamp),
+               (record->direction == LIBSPDM_CAPTURE_DIRECTION_SEND) ? "send" : "recv",
+               record->session_id,
+               (record->type == LIBSPDM_CAPTURE_RECORD_SPDM) ? "spdm" :
+               (record->type == LIBSPDM_CAPTURE_RECORD_APP) ? "app" : "wire",
+               record->message_size);
+        if (captured_size < record->message_size) {
+            printf(" (truncated to %u)", (uint32_t)captured_size);
+        }
+        if (record->type == LIBSPDM_CAPTURE_RECORD_SPDM) {
+            libspdm_capture_decode_spdm((const uint8_t *)(record + 1), captured_size);
+        }
+        printf("\n");
+        if (!summary) {
+            libspdm_capture_decode_dump_hex((const uint8_t *)(record + 1), captured_size);
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *file_name;
+    bool summary;
+    FILE *file;
+    uint8_t *capture;
+    long capture_size;
+    bool result;
+
+    summary = false;
+    file_name = NULL;
+    if ((argc == 3) && (strcmp(argv[1], "-s") == 0)) {
+        summary = true;
+        file_name = argv[2];
+    } else if (argc == 2) {
+        file_name = argv[1];
+    }
+    if (file_name == NULL) {
+        printf("Usage: spdm_capture_decode [-s] capture_file\n");
+        return 1;
+    }
+
+    file = fopen(file_name, "rb");
+    if (file == NULL) {
+        printf("cannot open %s\n", file_name);
+        return 1;
+    }
+    fseek(file, 0, SEEK_END);
+    capture_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    capture = (capture_size > 0) ? malloc((size_t)capture_size) : NULL;
+    if ((capture == NULL) || (fread(capture, 1, (size_t)capture_size, file) !=
+                              (size_t)capture_size)) {
+        printf("cannot read %s\n", file_name);
+        fclose(file);
+        free(capture);
+        return 1;
+    }
+    fclose(file);
+
+    result = libspdm_capture_decode(capture, (uintn)capture_size, summary);
+    free(capture);
+    return result ? 0 : 1;
+}
@@ -83,6 +83,27 @@ GLOBAL_REMOVE_IF_UNREFERENCED uint8_t
     0x29, 0x7d, 0xa0, 0x2b, 0x8f, 0x4b, 0xa8, 0xe0
 };
 
+typedef struct {
+    uintn hash_nid;
+    const char *name;
+    const uint8_t *digest;
+    uintn digest_size;
+    bool embedded;
+} libspdm_hash_state_test_t;
+
+GLOBAL_REMOVE_IF_UNREFERENCED const libspdm_hash_state_test_t m_libspdm_hash_state_test[] = {
+    { LIBSPDM_CRYPTO_NID_SHA256, "SHA256", m_libspdm_sha256_digest,
+      LIBSPDM_SHA256_DIGEST_SIZE, true },
+    { LIBSPDM_CRYPTO_NID_SHA384, "SHA384", m_libspdm_sha384_digest,
+      LIBSPDM_SHA384_DIGEST_SIZE, true },
+    { LIBSPDM_CRYPTO_NID_SHA512, "SHA512", m_libspdm_sha512_digest,
+      LIBSPDM_SHA512_DIGEST_SIZE, true },
+    { LIBSPDM_CRYPTO_NID_SHA3_256, "SHA3_256", m_libspdm_sha3_256_digest,
+      LIBSPDM_SHA3_256_DIGEST_SIZE, false },
+    { LIBSPDM_CRYPTO_NID_SM3_256, "SM3_256", m_libspdm_sm3_256_digest,
+      LIBSPDM_SM3_256_DIGEST_SIZE, false },
+};
+
 /**
  * Validate Crypto digest Interfaces.
  *
@@ -96,6 +117,9 @@ return_status libspdm_validate_crypt_digest(void)
     uintn data_size;
     uint8_t digest[LIBSPDM_MAX_DIGEST_SIZE];
     bool status;
+    libspdm_hash_state_t hash_state;
+    libspdm_hash_state_t hash_state_copy;
+    uintn index;
 
     libspdm_my_print(" Crypt hash Engine Testing:\n");
     data_size = libspdm_ascii_str_len(m_libspdm_hash_data);
@@ -439,5 +463,54 @@ return_status libspdm_validate_crypt_digest(void)
         libspdm_my_print("[Failed]\n");
     }
 
+    libspdm_my_print("- Hash state: ");
+
+    /* Fixed-size hash state Validation, the SHA-2 states must not be allocated*/
+
+    for (index = 0; index < ARRAY_SIZE(m_libspdm_hash_state_test); index++) {
+        libspdm_my_print(m_libspdm_hash_state_test[index].name);
+        libspdm_my_print("... ");
+        status = libspdm_hash_state_init_by_nid(m_libspdm_hash_state_test[index].hash_nid,
+                                                &hash_state);
+        if (!status) {
+            if (m_libspdm_hash_state_test[index].embedded) {
+                break;
+            }
+            /* the backend may not support this algorithm*/
+            status = true;
+            continue;
+        }
+        if (m_libspdm_hash_state_test[index].embedded && (hash_state.heap_context != NULL)) {
+            status = false;
+        }
+        status = status &&
+                 libspdm_hash_state_update(&hash_state, m_libspdm_hash_data, 1) &&
+                 libspdm_hash_state_duplicate(&hash_state, &hash_state_copy);
+        if (status) {
+            status = libspdm_hash_state_update(&hash_state_copy, m_libspdm_hash_data + 1,
+                                               data_size - 1) &&
+                     libspdm_hash_state_final(&hash_state_copy, digest) &&
+                     (libspdm_const_compare_mem(digest, m_libspdm_hash_state_test[index].digest,
+                                                m_libspdm_hash_state_test[index].digest_size) ==
+                      0);
+            libspdm_hash_state_free(&hash_state_copy);
+        }
+        status = status &&
+                 libspdm_hash_state_update(&hash_state, m_libspdm_hash_data + 1,
+                                           data_size - 1) &&
+                 libspdm_hash_state_final(&hash_state, digest) &&
+                 (libspdm_const_compare_mem(digest, m_libspdm_hash_state_test[index].digest,
+                                            m_libspdm_hash_state_test[index].digest_size) == 0);
+        libspdm_hash_state_free(&hash_state);
+        if (!status) {
+            break;
+        }
+    }
+    if (status) {
+        libspdm_my_print("[Pass]\n");
+    } else {
+        libspdm_my_print("[Failed]\n");
+    }
+
     return RETURN_SUCCESS;
 }
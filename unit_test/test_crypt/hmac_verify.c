@@ -62,7 +62,7 @@ return_status libspdm_validate_crypt_hmac(void)
     status = libspdm_hmac_sha256_set_key(hmac_ctx, m_libspdm_hmac_sha256_key, 20);
     if (!status) {
         libspdm_my_print("[Fail]");
-        free_pool(hmac_ctx);
+        libspdm_hmac_sha256_free(hmac_ctx);
         return RETURN_ABORTED;
     }
 
@@ -70,7 +70,7 @@ return_status libspdm_validate_crypt_hmac(void)
     status = libspdm_hmac_sha256_update(hmac_ctx, m_libspdm_hmac_data, 8);
     if (!status) {
         libspdm_my_print("[Fail]");
-        free_pool(hmac_ctx);
+        libspdm_hmac_sha256_free(hmac_ctx);
         return RETURN_ABORTED;
     }
 
@@ -78,11 +78,11 @@ return_status libspdm_validate_crypt_hmac(void)
     status = libspdm_hmac_sha256_final(hmac_ctx, digest);
     if (!status) {
         libspdm_my_print("[Fail]");
-        free_pool(hmac_ctx);
+        libspdm_hmac_sha256_free(hmac_ctx);
         return RETURN_ABORTED;
     }
 
-    free_pool(hmac_ctx);
+    libspdm_hmac_sha256_free(hmac_ctx);
 
     libspdm_my_print("Check value... ");
     if (libspdm_const_compare_mem(digest, m_libspdm_hmac_sha256_digest,
@@ -108,7 +108,7 @@ return_status libspdm_validate_crypt_hmac(void)
     status = libspdm_hmac_sha3_256_set_key(hmac_ctx, m_libspdm_hmac_sha256_key, 20);
     if (!status) {
         libspdm_my_print("[Fail]");
-        free_pool(hmac_ctx);
+        libspdm_hmac_sha3_256_free(hmac_ctx);
         return RETURN_ABORTED;
     }
 
@@ -116,7 +116,7 @@ return_status libspdm_validate_crypt_hmac(void)
     status = libspdm_hmac_sha3_256_update(hmac_ctx, m_libspdm_hmac_data, 8);
     if (!status) {
         libspdm_my_print("[Fail]");
-        free_pool(hmac_ctx);
+        libspdm_hmac_sha3_256_free(hmac_ctx);
         return RETURN_ABORTED;
     }
 
@@ -124,11 +124,11 @@ return_status libspdm_validate_crypt_hmac(void)
     status = libspdm_hmac_sha3_256_final(hmac_ctx, digest);
     if (!status) {
         libspdm_my_print("[Fail]");
-        free_pool(hmac_ctx);
+        libspdm_hmac_sha3_256_free(hmac_ctx);
         return RETURN_ABORTED;
     }
 
-    free_pool(hmac_ctx);
+    libspdm_hmac_sha3_256_free(hmac_ctx);
     libspdm_my_print("[Pass]\n");
 
     libspdm_my_print("- HMAC-SM3_256: ");
@@ -145,7 +145,7 @@ return_status libspdm_validate_crypt_hmac(void)
     status = libspdm_hmac_sm3_256_set_key(hmac_ctx, m_libspdm_hmac_sha256_key, 20);
     if (!status) {
         libspdm_my_print("[Fail]");
-        free_pool(hmac_ctx);
+        libspdm_hmac_sm3_256_free(hmac_ctx);
         return RETURN_ABORTED;
     }
 
@@ -153,7 +153,7 @@ return_status libspdm_validate_crypt_hmac(void)
     status = libspdm_hmac_sm3_256_update(hmac_ctx, m_libspdm_hmac_data, 8);
     if (!status) {
         libspdm_my_print("[Fail]");
-        free_pool(hmac_ctx);
+        libspdm_hmac_sm3_256_free(hmac_ctx);
         return RETURN_ABORTED;
     }
 
@@ -161,11 +161,11 @@ return_status libspdm_validate_crypt_hmac(void)
     status = libspdm_hmac_sm3_256_final(hmac_ctx, digest);
     if (!status) {
         libspdm_my_print("[Fail]");
-        free_pool(hmac_ctx);
+        libspdm_hmac_sm3_256_free(hmac_ctx);
         return RETURN_ABORTED;
     }
 
-    free_pool(hmac_ctx);
+    libspdm_hmac_sm3_256_free(hmac_ctx);
     libspdm_my_print("[Pass]\n");
 
     return RETURN_SUCCESS;
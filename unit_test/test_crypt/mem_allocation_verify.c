@@ -0,0 +1,184 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "test_crypt.h"
+
+#define LIBSPDM_TEST_ARENA_SIZE 0x4000
+
+uint64_t m_libspdm_test_arena_buffer[LIBSPDM_TEST_ARENA_SIZE / sizeof(uint64_t)];
+
+/**
+ * Validate the routing of the crypto backend allocations through the pool allocator.
+ *
+ * It must run before any other validation, as the crypto backend may accept new memory
+ * functions only before its first allocation.
+ *
+ * @retval  RETURN_SUCCESS  Validation succeeded.
+ * @retval  RETURN_ABORTED  Validation failed.
+ *
+ **/
+return_status libspdm_validate_crypt_pool_allocator(void)
+{
+    libspdm_arena_t arena;
+    const libspdm_pool_allocator_t *previous_allocator;
+    void *hash_ctx;
+    uint8_t digest[LIBSPDM_SHA256_DIGEST_SIZE];
+    bool status;
+
+    libspdm_my_print(" \nCrypto Memory Allocation Testing:\n");
+
+    libspdm_my_print("- Pool allocator... ");
+    if (!libspdm_crypt_use_pool_allocator()) {
+        libspdm_my_print("[Fail]");
+        return RETURN_ABORTED;
+    }
+
+    /* The first hash initializes the global state of the crypto backend, which lives
+     * until the end of the process and therefore must not come from an arena.*/
+    if (!libspdm_sha256_hash_all("warm up", sizeof("warm up"), digest)) {
+        libspdm_my_print("[Fail]");
+        return RETURN_ABORTED;
+    }
+
+    libspdm_my_print("Arena... ");
+    libspdm_arena_init(&arena, m_libspdm_test_arena_buffer, sizeof(m_libspdm_test_arena_buffer));
+    previous_allocator = libspdm_set_pool_allocator(&arena.allocator);
+    hash_ctx = libspdm_sha256_new();
+    libspdm_set_pool_allocator(previous_allocator);
+    if (hash_ctx == NULL) {
+        libspdm_my_print("[Fail]");
+        return RETURN_ABORTED;
+    }
+    status = (arena.live_count != 0) && !libspdm_arena_release(&arena);
+    status = status && libspdm_sha256_init(hash_ctx) &&
+             libspdm_sha256_update(hash_ctx, "arena", sizeof("arena")) &&
+             libspdm_sha256_final(hash_ctx, digest);
+    libspdm_sha256_free(hash_ctx);
+    if (!status) {
+        libspdm_my_print("[Fail]");
+        return RETURN_ABORTED;
+    }
+
+    libspdm_my_print("Release... ");
+    if (!libspdm_arena_release(&arena) || (arena.used != 0)) {
+        libspdm_my_print("[Fail]");
+        return RETURN_ABORTED;
+    }
+
+    libspdm_my_print("[Pass]\n");
+
+    return RETURN_SUCCESS;
+}
+
+/**
+ * Check the counters of some allocation statistics.
+ **/
+static bool libspdm_test_malloc_stats_equal(const libspdm_malloc_stats_t *stats,
+                                            uint64_t allocation_count, uint64_t free_count,
+                                            uintn live_count, uintn live_bytes,
+                                            uintn peak_live_count, uintn peak_live_bytes)
+{
+    return (stats->allocation_count == allocation_count) &&
+           (stats->free_count == free_count) &&
+           (stats->live_count == live_count) && (stats->live_bytes == live_bytes) &&
+           (stats->peak_live_count == peak_live_count) &&
+           (stats->peak_live_bytes == peak_live_bytes);
+}
+
+/**
+ * Validate the allocation statistics of nested scopes.
+ *
+ * A free is accounted in the scope of the allocation, whatever scope is selected then. Without
+ * the instrumented malloclib, the statistics must stay zero.
+ *
+ * @retval  RETURN_SUCCESS  Validation succeeded.
+ * @retval  RETURN_ABORTED  Validation failed.
+ *
+ **/
+return_status libspdm_validate_malloc_stats(void)
+{
+    libspdm_malloc_stats_t outer_stats;
+    libspdm_malloc_stats_t inner_stats;
+    libspdm_malloc_stats_t *previous_stats;
+    void *outer_buffer[2];
+    void *inner_buffer[3];
+    bool enabled;
+    bool status;
+
+    libspdm_my_print("- Allocation statistics... ");
+    enabled = libspdm_malloc_stats_is_enabled();
+    libspdm_zero_mem(&outer_stats, sizeof(outer_stats));
+    libspdm_zero_mem(&inner_stats, sizeof(inner_stats));
+
+    /* outer: 100, inner: 200 + 50, then outer again: 30*/
+    previous_stats = libspdm_set_malloc_stats_scope(&outer_stats);
+    outer_buffer[0] = allocate_pool(100);
+    libspdm_set_malloc_stats_scope(&inner_stats);
+    inner_buffer[0] = allocate_pool(200);
+    inner_buffer[1] = allocate_pool(50);
+    status = (libspdm_set_malloc_stats_scope(&outer_stats) == &inner_stats);
+    outer_buffer[1] = allocate_pool(30);
+    if ((outer_buffer[0] == NULL) || (outer_buffer[1] == NULL) ||
+        (inner_buffer[0] == NULL) || (inner_buffer[1] == NULL)) {
+        libspdm_set_malloc_stats_scope(previous_stats);
+        libspdm_my_print("[Fail]");
+        return RETURN_ABORTED;
+    }
+    if (enabled) {
+        status = status &&
+                 libspdm_test_malloc_stats_equal(&outer_stats, 2, 0, 2, 130, 2, 130) &&
+                 libspdm_test_malloc_stats_equal(&inner_stats, 2, 0, 2, 250, 2, 250) &&
+                 (inner_stats.largest_allocation == 200);
+    }
+
+    libspdm_my_print("Cross scope free... ");
+    /* freed while the outer scope is selected, counted in the inner scope*/
+    free_pool(inner_buffer[0]);
+    /* freed while no scope is selected*/
+    libspdm_set_malloc_stats_scope(NULL);
+    free_pool(outer_buffer[0]);
+    if (enabled) {
+        status = status &&
+                 libspdm_test_malloc_stats_equal(&outer_stats, 2, 1, 1, 30, 2, 130) &&
+                 libspdm_test_malloc_stats_equal(&inner_stats, 2, 1, 1, 50, 2, 250);
+    }
+
+    libspdm_my_print("Reset... ");
+    /* the peaks restart from the live buffers*/
+    libspdm_reset_malloc_stats(&inner_stats);
+    libspdm_set_malloc_stats_scope(&inner_stats);
+    inner_buffer[2] = allocate_pool(10);
+    libspdm_set_malloc_stats_scope(previous_stats);
+    if (inner_buffer[2] == NULL) {
+        status = false;
+    }
+    if (enabled) {
+        status = status &&
+                 libspdm_test_malloc_stats_equal(&inner_stats, 1, 0, 2, 60, 2, 60) &&
+                 (inner_stats.largest_allocation == 10);
+    }
+
+    free_pool(inner_buffer[1]);
+    free_pool(inner_buffer[2]);
+    free_pool(outer_buffer[1]);
+    if (enabled) {
+        status = status &&
+                 libspdm_test_malloc_stats_equal(&outer_stats, 2, 2, 0, 0, 2, 130) &&
+                 libspdm_test_malloc_stats_equal(&inner_stats, 1, 2, 0, 0, 2, 60);
+    } else {
+        status = status &&
+                 libspdm_test_malloc_stats_equal(&outer_stats, 0, 0, 0, 0, 0, 0) &&
+                 libspdm_test_malloc_stats_equal(&inner_stats, 0, 0, 0, 0, 0, 0);
+    }
+    if (!status) {
+        libspdm_my_print("[Fail]");
+        return RETURN_ABORTED;
+    }
+
+    libspdm_my_print("[Pass]\n");
+
+    return RETURN_SUCCESS;
+}
@@ -40,6 +40,16 @@ return_status libspdm_cryptest_main(void)
     libspdm_my_print("\nCrypto Wrapper Cryptosystem Testing: \n");
     libspdm_my_print("-------------------------------------------- \n");
 
+    status = libspdm_validate_crypt_pool_allocator();
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+
+    status = libspdm_validate_malloc_stats();
+    if (RETURN_ERROR(status)) {
+        return status;
+    }
+
     libspdm_random_seed(NULL, 0);
 
     status = libspdm_validate_crypt_digest();
@@ -174,4 +174,22 @@ return_status libspdm_validate_crypt_sm2_2(void);
  **/
 return_status libspdm_validate_crypt_prng(void);
 
+/**
+ * Validate the routing of the crypto backend allocations through the pool allocator.
+ *
+ * @retval  RETURN_SUCCESS  Validation succeeded.
+ * @retval  RETURN_ABORTED  Validation failed.
+ *
+ **/
+return_status libspdm_validate_crypt_pool_allocator(void);
+
+/**
+ * Validate the allocation statistics of nested scopes.
+ *
+ * @retval  RETURN_SUCCESS  Validation succeeded.
+ * @retval  RETURN_ABORTED  Validation failed.
+ *
+ **/
+return_status libspdm_validate_malloc_stats(void);
+
 #endif
@@ -43,6 +43,9 @@ return_status libspdm_validate_crypt_x509(char *Path, uintn len)
     uint8_t date_time2[64];
     return_status ret_status;
     char file_name_buffer[1024];
+    uint64_t cache_hit_count;
+    uint64_t cache_miss_count;
+    uintn cache_entry_count;
 
     ret_status = RETURN_ABORTED;
     test_cert = NULL;
@@ -118,6 +121,37 @@ return_status libspdm_validate_crypt_x509(char *Path, uintn len)
     }
 
 
+    /* X509 Certificate Chain Verification with the issuer signature verification cache.*/
+
+    libspdm_my_print("- X509 Certificate Chain Verification with Cache ... ");
+    if (!libspdm_x509_verify_cache_set_max_entry_count(LIBSPDM_X509_VERIFY_CACHE_MAX_ENTRY_COUNT)) {
+        libspdm_my_print("[Fail]\n");
+        goto cleanup;
+    }
+    libspdm_x509_verify_cache_flush();
+    status = libspdm_x509_verify_cert_chain((uint8_t *)test_ca_cert, test_ca_cert_len,
+                                            (uint8_t *)test_bundle_cert,
+                                            test_bundle_cert_len);
+    libspdm_x509_verify_cache_get_statistics(&cache_hit_count, &cache_miss_count,
+                                             &cache_entry_count);
+    if (!status || (cache_hit_count != 0) || (cache_miss_count == 0) ||
+        (cache_entry_count != cache_miss_count)) {
+        libspdm_my_print("[Fail]\n");
+        libspdm_x509_verify_cache_set_max_entry_count(0);
+        goto cleanup;
+    }
+    status = libspdm_x509_verify_cert_chain((uint8_t *)test_ca_cert, test_ca_cert_len,
+                                            (uint8_t *)test_bundle_cert,
+                                            test_bundle_cert_len);
+    libspdm_x509_verify_cache_get_statistics(&cache_hit_count, NULL, NULL);
+    libspdm_x509_verify_cache_set_max_entry_count(0);
+    if (!status || (cache_hit_count != cache_miss_count)) {
+        libspdm_my_print("[Fail]\n");
+        goto cleanup;
+    } else {
+        libspdm_my_print("[Pass]\n");
+    }
+
     /* X509 Get leaf certificate from cert_chain Verificate*/
 
     LIBSPDM_DEBUG((LIBSPDM_DEBUG_INFO,
@@ -6,14 +6,17 @@
 
 #include "hal/base.h"
 
+/* Volatile, so that the link time optimization cannot drop the code using the allocation.*/
+static void *volatile m_null_pool;
+
 void *allocate_pool(uintn AllocationSize)
 {
-    return NULL;
+    return m_null_pool;
 }
 
 void *allocate_zero_pool(uintn AllocationSize)
 {
-    return NULL;
+    return m_null_pool;
 }
 
 void free_pool(const void *buffer)
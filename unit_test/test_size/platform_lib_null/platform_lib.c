@@ -0,0 +1,63 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include <base.h>
+
+/**
+ * Suspends the execution of the current thread until the time-out interval elapses.
+ *
+ * @param milliseconds     The time interval for which execution is to be suspended, in milliseconds.
+ *
+ **/
+void libspdm_sleep(uint64_t milliseconds)
+{
+}
+
+/**
+ * Returns a monotonic time stamp, for measuring elapsed time.
+ *
+ * @return the time stamp, in nanoseconds since an unspecified starting point.
+ *
+ **/
+uint64_t libspdm_get_time_ns(void)
+{
+    return 0;
+}
+
+/**
+ * If no heartbeat arrives in seconds, the watchdog timeout event
+ * should terminate the session.
+ *
+ * @param  session_id     Indicate the SPDM session ID.
+ * @param  seconds        heartbeat period, in seconds.
+ *
+ **/
+bool libspdm_start_watchdog(uint32_t session_id, uint16_t seconds)
+{
+    return true;
+}
+
+/**
+ * stop watchdog.
+ *
+ * @param  session_id     Indicate the SPDM session ID.
+ *
+ **/
+bool libspdm_stop_watchdog(uint32_t session_id)
+{
+    return true;
+}
+
+/**
+ * Reset the watchdog in heartbeat response.
+ *
+ * @param  session_id     Indicate the SPDM session ID.
+ *
+ **/
+bool libspdm_reset_watchdog(uint32_t session_id)
+{
+    return true;
+}
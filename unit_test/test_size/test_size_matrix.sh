@@ -0,0 +1,77 @@
+#!/bin/bash
+
+# Reports the code size and the RAM footprint of libspdm for a matrix of configurations.
+# Every configuration is built in build_size/<configuration> with its config switches
+# (see include/library/spdm_lib_config.h) in CMAKE_C_FLAGS. For each one it prints:
+#  - the text, data and bss of the test_size_of_spdm_requester and test_size_of_spdm_responder
+#    images, which link the null crypto library, so it is the size of libspdm itself,
+#  - the test_size_report output: the context sizes and the peak stack of a full handshake.
+# This script can be run from any directory within the libspdm repository.
+
+set -e
+
+if [ "$#" -lt "1" ];then
+    echo "Usage: $0 <CRYPTO> [configuration...]"
+    echo "<CRYPTO> means selected Crypto library: mbedtls or openssl"
+    echo "[configuration] means the configurations to build, all of them by default:"
+    echo "    default transcript ecc_only one_session no_psk no_trace_capture measurement_cache"
+    exit 1
+fi
+
+if [[ $1 != "mbedtls" && $1 != "openssl" ]]; then
+    echo "ERROR: Unknown crypto library $1."
+    exit 1
+fi
+CRYPTO=$1
+shift
+
+if ! command -v size &> /dev/null
+then
+    echo "ERROR: Unable to execute size."
+    exit 1
+fi
+
+declare -A CONFIG_FLAGS
+CONFIG_FLAGS[default]=""
+CONFIG_FLAGS[transcript]="-DLIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT=1"
+CONFIG_FLAGS[ecc_only]="-DLIBSPDM_RSA_SSA_SUPPORT=0 -DLIBSPDM_RSA_PSS_SUPPORT=0 \
+-DLIBSPDM_SM2_DSA_SUPPORT=0 -DLIBSPDM_EDDSA_ED25519_SUPPORT=0 -DLIBSPDM_EDDSA_ED448_SUPPORT=0 \
+-DLIBSPDM_FFDHE_SUPPORT=0 -DLIBSPDM_SM2_KEY_EXCHANGE_SUPPORT=0 \
+-DLIBSPDM_AEAD_CHACHA20_POLY1305_SUPPORT=0 -DLIBSPDM_AEAD_SM4_SUPPORT=0 \
+-DLIBSPDM_SHA3_256_SUPPORT=0 -DLIBSPDM_SHA3_384_SUPPORT=0 -DLIBSPDM_SHA3_512_SUPPORT=0 \
+-DLIBSPDM_SM3_256_SUPPORT=0"
+CONFIG_FLAGS[one_session]="-DLIBSPDM_MAX_SESSION_COUNT=1"
+CONFIG_FLAGS[no_psk]="-DLIBSPDM_ENABLE_CAPABILITY_PSK_EX_CAP=0"
+CONFIG_FLAGS[no_trace_capture]="-DLIBSPDM_TRACE_SUPPORT=0 -DLIBSPDM_MESSAGE_CAPTURE_SUPPORT=0"
+CONFIG_FLAGS[measurement_cache]="-DLIBSPDM_MEASUREMENT_CACHE_SUPPORT=1 \
+-DLIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT=1"
+
+if [ "$#" -eq "0" ];then
+    set -- default transcript ecc_only one_session no_psk no_trace_capture measurement_cache
+fi
+
+for CONFIG in "$@"; do
+    if [ -z "${CONFIG_FLAGS[$CONFIG]+set}" ]; then
+        echo "ERROR: Unknown configuration $CONFIG."
+        exit 1
+    fi
+done
+
+# Change directory to top of repository.
+cd `dirname $0`
+cd ../../
+mkdir -p build_size
+
+for CONFIG in "$@"; do
+    BUILD_DIR=build_size/$CONFIG
+    echo "## $CONFIG: ${CONFIG_FLAGS[$CONFIG]}"
+
+    cmake -S . -B $BUILD_DIR -DARCH=x64 -DTOOLCHAIN=GCC -DTARGET=Release -DCRYPTO=$CRYPTO \
+          -DCMAKE_C_FLAGS="${CONFIG_FLAGS[$CONFIG]}" > $BUILD_DIR.log
+    cmake --build $BUILD_DIR -j`nproc` --target copy_sample_key test_size_of_spdm_requester \
+          test_size_of_spdm_responder test_size_report >> $BUILD_DIR.log
+
+    size $BUILD_DIR/bin/test_size_of_spdm_requester $BUILD_DIR/bin/test_size_of_spdm_responder
+    (cd $BUILD_DIR/bin && ./test_size_report)
+    echo
+done
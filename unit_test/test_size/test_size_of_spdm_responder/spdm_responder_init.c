@@ -6,7 +6,7 @@
 
 #include "spdm_responder.h"
 
-return_status libspdm_responder_send_message(const void *spdm_context,
+return_status libspdm_responder_send_message(void *spdm_context,
                                              uintn message_size, const void *message,
                                              uint64_t timeout)
 {
@@ -14,7 +14,7 @@ return_status libspdm_responder_send_message(const void *spdm_context,
     return RETURN_SUCCESS;
 }
 
-return_status libspdm_responder_receive_message(const void *spdm_context,
+return_status libspdm_responder_receive_message(void *spdm_context,
                                                 uintn *message_size,
                                                 void *message,
                                                 uint64_t timeout)
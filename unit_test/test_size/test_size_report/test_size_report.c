@@ -0,0 +1,162 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+/** @file
+ * RAM footprint of the library, for the configuration it is built with.
+ *
+ * Reports:
+ *  - the configuration switches that size the context,
+ *  - the size of the SPDM context, of a session and of a secured message context,
+ *  - the peak stack of a full handshake between an in-process requester and responder:
+ *    VCA, GET_DIGESTS, GET_CERTIFICATE, CHALLENGE, signed GET_MEASUREMENTS,
+ *    KEY_EXCHANGE, FINISH, HEARTBEAT, KEY_UPDATE and END_SESSION.
+ *    The responder runs nested in the requester, so it is the sum of both call chains.
+ *    It is measured on a painted thread stack, and includes the crypto library.
+ *
+ * The code size is reported by test_size_matrix.sh, from the test_size_of_spdm_requester and
+ * test_size_of_spdm_responder images built with the same configuration.
+ *
+ * Usage: test_size_report
+ **/
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200112L
+#include <pthread.h>
+#endif
+
+#include "bench_loopback.h"
+#include "internal/libspdm_common_lib.h"
+#include "internal/libspdm_secured_message_lib.h"
+
+#define LIBSPDM_TEST_SIZE_STACK_SIZE (1024 * 1024)
+#define LIBSPDM_TEST_SIZE_STACK_PATTERN 0xA5
+
+typedef struct {
+    /* the address of a local of the handshake thread entry, the top of the measured stack*/
+    uintn stack_top;
+    bool result;
+} libspdm_test_size_handshake_t;
+
+static void libspdm_test_size_print(const char *name, uint64_t value)
+{
+    printf("%-48s %10llu\n", name, (unsigned long long)value);
+}
+
+static bool libspdm_test_size_run_handshake(void)
+{
+    libspdm_bench_loopback_t *loopback;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint32_t measurement_record_length;
+    uint8_t number_of_blocks;
+    uint8_t heartbeat_period;
+    uint8_t measurement_hash[LIBSPDM_MAX_HASH_SIZE];
+    uint32_t session_id;
+    bool result;
+
+    loopback = malloc(sizeof(libspdm_bench_loopback_t));
+    if ((loopback == NULL) || !libspdm_bench_loopback_init(loopback)) {
+        free(loopback);
+        return false;
+    }
+    measurement_record_length = sizeof(measurement_record);
+    result =
+        !RETURN_ERROR(libspdm_bench_loopback_connect(loopback)) &&
+        !RETURN_ERROR(libspdm_get_measurement(
+                          loopback->requester_context, NULL,
+                          SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE,
+                          SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS,
+                          0, NULL, &number_of_blocks, &measurement_record_length,
+                          measurement_record)) &&
+        !RETURN_ERROR(libspdm_start_session(
+                          loopback->requester_context, false,
+                          SPDM_CHALLENGE_REQUEST_NO_MEASUREMENT_SUMMARY_HASH, 0, 0,
+                          &session_id, &heartbeat_period, measurement_hash)) &&
+        !RETURN_ERROR(libspdm_heartbeat(loopback->requester_context, session_id)) &&
+        !RETURN_ERROR(libspdm_key_update(loopback->requester_context, session_id, false)) &&
+        !RETURN_ERROR(libspdm_stop_session(loopback->requester_context, session_id, 0));
+
+    libspdm_bench_loopback_free(loopback);
+    free(loopback);
+    return result;
+}
+
+#if !defined(_WIN32)
+static void *libspdm_test_size_handshake_thread(void *context)
+{
+    libspdm_test_size_handshake_t *handshake;
+    volatile uint8_t stack_top;
+
+    handshake = context;
+    handshake->stack_top = (uintn)&stack_top;
+    handshake->result = libspdm_test_size_run_handshake();
+    return NULL;
+}
+
+/* Run the handshake on a painted stack, and return the depth of the deepest byte written.*/
+static bool libspdm_test_size_measure_stack(uintn *peak_stack)
+{
+    libspdm_test_size_handshake_t handshake;
+    pthread_attr_t attr;
+    pthread_t thread;
+    uint8_t *stack;
+    uintn index;
+
+    if (posix_memalign((void **)&stack, 4096, LIBSPDM_TEST_SIZE_STACK_SIZE) != 0) {
+        return false;
+    }
+    libspdm_set_mem(stack, LIBSPDM_TEST_SIZE_STACK_SIZE, LIBSPDM_TEST_SIZE_STACK_PATTERN);
+    libspdm_zero_mem(&handshake, sizeof(handshake));
+    if ((pthread_attr_init(&attr) != 0) ||
+        (pthread_attr_setstack(&attr, stack, LIBSPDM_TEST_SIZE_STACK_SIZE) != 0) ||
+        (pthread_create(&thread, &attr, libspdm_test_size_handshake_thread, &handshake) != 0)) {
+        free(stack);
+        return false;
+    }
+    pthread_join(thread, NULL);
+    pthread_attr_destroy(&attr);
+
+    /* the stack grows down, the lowest byte changed is the deepest*/
+    for (index = 0; index < LIBSPDM_TEST_SIZE_STACK_SIZE; index++) {
+        if (stack[index] != LIBSPDM_TEST_SIZE_STACK_PATTERN) {
+            break;
+        }
+    }
+    *peak_stack = handshake.stack_top - (uintn)(stack + index);
+    free(stack);
+    return handshake.result && (index != 0);
+}
+#endif
+
+int main(void)
+{
+#if !defined(_WIN32)
+    uintn peak_stack;
+#endif
+
+    libspdm_test_size_print("LIBSPDM_MAX_MESSAGE_BUFFER_SIZE", LIBSPDM_MAX_MESSAGE_BUFFER_SIZE);
+    libspdm_test_size_print("LIBSPDM_MAX_CERT_CHAIN_SIZE", LIBSPDM_MAX_CERT_CHAIN_SIZE);
+    libspdm_test_size_print("LIBSPDM_MAX_SESSION_COUNT", LIBSPDM_MAX_SESSION_COUNT);
+    libspdm_test_size_print("LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT",
+                            LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT);
+
+    libspdm_test_size_print("sizeof(libspdm_context_t)", sizeof(libspdm_context_t));
+    libspdm_test_size_print("sizeof(libspdm_transcript_t)", sizeof(libspdm_transcript_t));
+    libspdm_test_size_print("sizeof(libspdm_session_info_t)", sizeof(libspdm_session_info_t));
+    libspdm_test_size_print("libspdm_secured_message_get_context_size()",
+                            libspdm_secured_message_get_context_size());
+    libspdm_test_size_print("libspdm_get_context_size()", libspdm_get_context_size());
+
+#if !defined(_WIN32)
+    if (!libspdm_test_size_measure_stack(&peak_stack)) {
+        printf("handshake - FAIL\n");
+        return 1;
+    }
+    libspdm_test_size_print("handshake peak stack", peak_stack);
+#else
+    printf("%-48s %10s\n", "handshake peak stack", "n/a");
+#endif
+    return 0;
+}
@@ -578,6 +578,100 @@ static void libspdm_test_set_data_case9(void **state)
     free(data);
 }
 
+static void *libspdm_test_allocate_context(uintn size)
+{
+    return malloc(size);
+}
+
+static void libspdm_test_free_context(void *buffer)
+{
+    free(buffer);
+}
+
+/**
+ * Test 10: test the context laid out from a runtime configuration.
+ *
+ * case                                              Expected Behavior
+ * default configuration;                            same size as libspdm_get_context_size.
+ * configuration out of bounds;                      size 0 and RETURN_INVALID_PARAMETER.
+ * buffer smaller than the configuration;            return RETURN_BUFFER_TOO_SMALL.
+ * small configuration;                              smaller context, local DataTransferSize and
+ *                                                   session count follow the configuration.
+ * allocated context;                                return RETURN_SUCCESS, and the context is freed.
+ **/
+static void libspdm_test_init_context_ex_case10(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_context_config_t config;
+    uintn context_size;
+    void *context;
+    uint32_t data32;
+    uintn data_size;
+    libspdm_data_parameter_t parameter;
+
+    spdm_test_context = *state;
+    spdm_test_context->case_id = 0xA;
+
+    /*case: default configuration*/
+    config.max_message_size = LIBSPDM_MAX_MESSAGE_BUFFER_SIZE;
+    config.max_session_count = LIBSPDM_MAX_SESSION_COUNT;
+    config.max_cert_chain_size = LIBSPDM_MAX_MESSAGE_BUFFER_SIZE;
+    assert_int_equal(libspdm_get_context_size_ex(&config), libspdm_get_context_size());
+
+    /*case: configuration out of bounds*/
+    config.max_message_size = SPDM_MIN_DATA_TRANSFER_SIZE_VERSION_12 - 1;
+    assert_int_equal(libspdm_get_context_size_ex(&config), 0);
+    config.max_message_size = LIBSPDM_MAX_MESSAGE_BUFFER_SIZE + 1;
+    assert_int_equal(libspdm_get_context_size_ex(&config), 0);
+    config.max_message_size = LIBSPDM_MAX_MESSAGE_BUFFER_SIZE;
+    config.max_session_count = LIBSPDM_MAX_SESSION_COUNT + 1;
+    assert_int_equal(libspdm_get_context_size_ex(&config), 0);
+    status = libspdm_allocate_context(&config, libspdm_test_allocate_context,
+                                      libspdm_test_free_context, &context);
+    assert_int_equal(status, RETURN_INVALID_PARAMETER);
+
+    /*case: buffer smaller than the configuration*/
+    config.max_message_size = 0x100;
+    config.max_session_count = 1;
+    config.max_cert_chain_size = 0x400;
+    context_size = libspdm_get_context_size_ex(&config);
+    assert_int_not_equal(context_size, 0);
+    assert_true(context_size < libspdm_get_context_size());
+    context = malloc(context_size);
+    assert_non_null(context);
+    status = libspdm_init_context_ex(context, context_size - 1, &config);
+    assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+
+    /*case: small configuration*/
+    status = libspdm_init_context_ex(context, context_size, &config);
+    assert_int_equal(status, RETURN_SUCCESS);
+    spdm_context = context;
+    assert_true((uint8_t *)spdm_context->request_response >= (uint8_t *)context);
+    assert_true((uint8_t *)spdm_context->request_response + config.max_message_size <=
+                (uint8_t *)context + context_size);
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    data_size = sizeof(data32);
+    status = libspdm_get_data(spdm_context, LIBSPDM_DATA_CAPABILITY_DATA_TRANSFER_SIZE,
+                              &parameter, &data32, &data_size);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(data32, config.max_message_size);
+
+    assert_non_null(libspdm_assign_session_id(spdm_context, 0xFFFFFFFE, false));
+    assert_null(libspdm_assign_session_id(spdm_context, 0xFFFFFFFD, false));
+    free(context);
+
+    /*case: allocated context*/
+    status = libspdm_allocate_context(&config, libspdm_test_allocate_context,
+                                      libspdm_test_free_context, &context);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_non_null(context);
+    libspdm_free_context(context);
+}
+
 static libspdm_test_context_t m_libspdm_common_context_data_test_context = {
     LIBSPDM_TEST_CONTEXT_SIGNATURE,
     true,
@@ -599,6 +693,8 @@ int libspdm_common_context_data_test_main(void)
         cmocka_unit_test(libspdm_test_verify_peer_cert_chain_buffer_case8),
 
         cmocka_unit_test(libspdm_test_set_data_case9),
+
+        cmocka_unit_test(libspdm_test_init_context_ex_case10),
     };
 
     libspdm_setup_test_context(&m_libspdm_common_context_data_test_context);
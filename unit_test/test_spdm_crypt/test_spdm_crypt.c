@@ -232,6 +232,144 @@ void libspdm_test_crypt_spdm_x509_certificate_check(void **state)
     free(file_buffer);
 }
 
+void libspdm_test_crypt_spdm_cert_chain_index(void **state)
+{
+    bool status;
+    uint8_t *file_buffer;
+    uintn file_buffer_size;
+    libspdm_cert_chain_index_t cert_chain_index;
+    uint8_t *cert;
+    uintn cert_size;
+    uint8_t *indexed_cert;
+    uintn indexed_cert_size;
+    int32_t index;
+
+    status = libspdm_read_input_file("rsa2048/bundle_requester.certchain.der",
+                                     (void **)&file_buffer, &file_buffer_size);
+    assert_true(status);
+    libspdm_build_cert_chain_index(file_buffer, file_buffer_size, &cert_chain_index);
+    assert_int_not_equal(cert_chain_index.cert_count, 0);
+    for (index = -1; index <= (int32_t)cert_chain_index.cert_count; index++) {
+        status = libspdm_x509_get_cert_from_cert_chain(file_buffer, file_buffer_size, index,
+                                                       &cert, &cert_size);
+        assert_int_equal(libspdm_get_cert_from_cert_chain_index(
+                             &cert_chain_index, file_buffer, file_buffer_size, index,
+                             &indexed_cert, &indexed_cert_size), status);
+        if (status) {
+            assert_ptr_equal(indexed_cert, cert);
+            assert_int_equal(indexed_cert_size, cert_size);
+        }
+    }
+    free(file_buffer);
+
+    /* Deeper than LIBSPDM_MAX_CERT_CHAIN_DEPTH, the chain is walked.*/
+    status = libspdm_read_input_file("long_chains/ShorterMAXUINT16_bundle_responder.certchain.der",
+                                     (void **)&file_buffer, &file_buffer_size);
+    assert_true(status);
+    libspdm_build_cert_chain_index(file_buffer, file_buffer_size, &cert_chain_index);
+    assert_int_equal(cert_chain_index.cert_count, 0);
+    status = libspdm_x509_get_cert_from_cert_chain(file_buffer, file_buffer_size, -1,
+                                                   &cert, &cert_size);
+    assert_true(status);
+    status = libspdm_get_cert_from_cert_chain_index(&cert_chain_index, file_buffer,
+                                                    file_buffer_size, -1,
+                                                    &indexed_cert, &indexed_cert_size);
+    assert_true(status);
+    assert_ptr_equal(indexed_cert, cert);
+    assert_int_equal(indexed_cert_size, cert_size);
+    free(file_buffer);
+}
+
+void libspdm_test_crypt_spdm_hmac_state(void **state)
+{
+    static const uint32_t base_hash_algo[] = {
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512,
+    };
+    /* finished_key size, and a key longer than every block size*/
+    static const uintn key_size[] = { 32, 48, 64, 200 };
+    uint8_t key[200];
+    uint8_t data[300];
+    uint8_t expected[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t hmac_value[LIBSPDM_MAX_HASH_SIZE];
+    libspdm_hmac_state_t hmac_state;
+    libspdm_hmac_state_t hmac_state_copy;
+    uint32_t hash_size;
+    uintn algo_index;
+    uintn key_index;
+
+    libspdm_set_mem(key, sizeof(key), 0x5a);
+    libspdm_set_mem(data, sizeof(data), 0xa5);
+
+    for (algo_index = 0; algo_index < ARRAY_SIZE(base_hash_algo); algo_index++) {
+        hash_size = libspdm_get_hash_size(base_hash_algo[algo_index]);
+        for (key_index = 0; key_index < ARRAY_SIZE(key_size); key_index++) {
+            assert_true(libspdm_hmac_all(base_hash_algo[algo_index], data, sizeof(data),
+                                         key, key_size[key_index], expected));
+
+            assert_true(libspdm_hmac_state_init(base_hash_algo[algo_index], &hmac_state,
+                                                key, key_size[key_index]));
+            assert_true(libspdm_hmac_state_update(&hmac_state, data, 100));
+
+            /* the copy and the original continue independently*/
+            assert_true(libspdm_hmac_state_duplicate(&hmac_state, &hmac_state_copy));
+            assert_true(libspdm_hmac_state_update(&hmac_state_copy, data + 100,
+                                                  sizeof(data) - 100));
+            assert_true(libspdm_hmac_state_final_copy(&hmac_state_copy, hmac_value));
+            assert_memory_equal(hmac_value, expected, hash_size);
+            assert_true(libspdm_hmac_state_final(&hmac_state_copy, hmac_value));
+            assert_memory_equal(hmac_value, expected, hash_size);
+
+            assert_true(libspdm_hmac_state_update(&hmac_state, data + 100,
+                                                  sizeof(data) - 100));
+            assert_true(libspdm_hmac_state_final(&hmac_state, hmac_value));
+            assert_memory_equal(hmac_value, expected, hash_size);
+            libspdm_hmac_state_free(&hmac_state);
+        }
+    }
+}
+
+void libspdm_test_crypt_spdm_hkdf_expand_with_state(void **state)
+{
+    static const uint32_t base_hash_algo[] = {
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_256,
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_384,
+        SPDM_ALGORITHMS_BASE_HASH_ALGO_TPM_ALG_SHA_512,
+    };
+    /* AEAD IV, AEAD key, one block, and several blocks*/
+    static const uintn out_size[] = { 12, 32, 64, 200 };
+    uint8_t prk[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t info[100];
+    uint8_t expected[200];
+    uint8_t out[200];
+    libspdm_hmac_state_t prk_state;
+    uint32_t hash_size;
+    uintn algo_index;
+    uintn out_index;
+
+    libspdm_set_mem(prk, sizeof(prk), 0x5a);
+    libspdm_set_mem(info, sizeof(info), 0xa5);
+
+    for (algo_index = 0; algo_index < ARRAY_SIZE(base_hash_algo); algo_index++) {
+        hash_size = libspdm_get_hash_size(base_hash_algo[algo_index]);
+        assert_true(libspdm_hmac_state_init(base_hash_algo[algo_index], &prk_state,
+                                            prk, hash_size));
+        for (out_index = 0; out_index < ARRAY_SIZE(out_size); out_index++) {
+            assert_true(libspdm_hkdf_expand(base_hash_algo[algo_index], prk, hash_size,
+                                            info, sizeof(info), expected,
+                                            out_size[out_index]));
+            /* the PRK state is reused for every label*/
+            assert_true(libspdm_hkdf_expand_with_state(&prk_state, info, sizeof(info),
+                                                       out, out_size[out_index]));
+            assert_memory_equal(out, expected, out_size[out_index]);
+        }
+        assert_false(libspdm_hkdf_expand_with_state(&prk_state, info, sizeof(info),
+                                                    out, (uintn)hash_size * 255 + 1));
+        libspdm_hmac_state_free(&prk_state);
+    }
+}
+
 int libspdm_crypt_lib_setup(void **state)
 {
     return 0;
@@ -249,7 +387,10 @@ int libspdm_crypt_lib_test_main(void)
             libspdm_test_crypt_spdm_get_dmtf_subject_alt_name_from_bytes),
         cmocka_unit_test(
             libspdm_test_crypt_spdm_get_dmtf_subject_alt_name),
-        cmocka_unit_test(libspdm_test_crypt_spdm_x509_certificate_check)
+        cmocka_unit_test(libspdm_test_crypt_spdm_x509_certificate_check),
+        cmocka_unit_test(libspdm_test_crypt_spdm_cert_chain_index),
+        cmocka_unit_test(libspdm_test_crypt_spdm_hmac_state),
+        cmocka_unit_test(libspdm_test_crypt_spdm_hkdf_expand_with_state)
     };
 
     return cmocka_run_group_tests(spdm_crypt_lib_tests,
@@ -0,0 +1,635 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#include "spdm_unit_test.h"
+#include "internal/libspdm_requester_lib.h"
+
+#if (LIBSPDM_ENABLE_CAPABILITY_CERT_CAP) && (LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP) && \
+    (LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP)
+
+#define LIBSPDM_ATTEST_TEST_MAX_REQUEST_COUNT 0x20
+
+static uintn m_libspdm_local_buffer_size;
+static uint8_t m_libspdm_local_buffer[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+
+static void *m_libspdm_local_certificate_chain;
+static uintn m_libspdm_local_certificate_chain_size;
+
+/* The request code and param1 of every request sent by libspdm_attest()*/
+static uint8_t m_libspdm_attest_request_code[LIBSPDM_ATTEST_TEST_MAX_REQUEST_COUNT];
+static uint8_t m_libspdm_attest_request_param1[LIBSPDM_ATTEST_TEST_MAX_REQUEST_COUNT];
+static uintn m_libspdm_attest_request_count;
+static uint16_t m_libspdm_attest_certificate_offset;
+static uint16_t m_libspdm_attest_certificate_length;
+static uintn m_libspdm_attest_measurements_count;
+
+/**
+ * Cache the certificate chain of the responder as verified for a slot, the way
+ * libspdm_get_certificate() leaves it.
+ **/
+static void libspdm_test_attest_cache_cert_chain(libspdm_context_t *spdm_context,
+                                                 uint8_t slot_id, void *data,
+                                                 uintn data_size)
+{
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+        data_size;
+    libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+                     sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer),
+                     data, data_size);
+#else
+    libspdm_hash_all(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        data, data_size,
+        spdm_context->connection_info.peer_used_cert_chain_buffer_hash);
+    spdm_context->connection_info.peer_used_cert_chain_buffer_hash_size =
+        libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+    libspdm_get_leaf_cert_public_key_from_cert_chain(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        spdm_context->connection_info.algorithm.base_asym_algo,
+        data, data_size,
+        &spdm_context->connection_info.peer_used_leaf_cert_public_key);
+#endif
+    spdm_context->connection_info.peer_used_cert_chain_slot_id = slot_id;
+}
+
+/**
+ * Set up an SPDM 1.1 connection past NEGOTIATED, so libspdm_attest() sends no VCA
+ * and no GET_DIGESTS.
+ **/
+static void libspdm_test_attest_setup_context(libspdm_context_t *spdm_context,
+                                              uint32_t capability_flags)
+{
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AFTER_CERTIFICATE;
+    spdm_context->connection_info.capability.flags = capability_flags;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.req_base_asym_alg =
+        m_libspdm_use_req_asym_algo;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    libspdm_reset_message_a(spdm_context);
+    libspdm_reset_message_b(spdm_context);
+    libspdm_reset_message_c(spdm_context);
+    libspdm_reset_message_m(spdm_context, NULL);
+
+    m_libspdm_attest_request_count = 0;
+    m_libspdm_attest_measurements_count = 0;
+}
+
+return_status libspdm_requester_attest_test_send_message(void *spdm_context,
+                                                         uintn request_size,
+                                                         const void *request,
+                                                         uint64_t timeout)
+{
+    const spdm_message_header_t *spdm_request;
+    uintn header_size;
+    uintn message_size;
+
+    header_size = sizeof(libspdm_test_message_header_t);
+    spdm_request = (const void *)((const uint8_t *)request + header_size);
+    message_size = request_size - header_size;
+
+    if (m_libspdm_attest_request_count == LIBSPDM_ATTEST_TEST_MAX_REQUEST_COUNT) {
+        return RETURN_DEVICE_ERROR;
+    }
+    m_libspdm_attest_request_code[m_libspdm_attest_request_count] =
+        spdm_request->request_response_code;
+    m_libspdm_attest_request_param1[m_libspdm_attest_request_count] = spdm_request->param1;
+    m_libspdm_attest_request_count++;
+
+    /* the transport pads the requests, keep only the request for the signed transcript*/
+    switch (spdm_request->request_response_code) {
+    case SPDM_GET_CERTIFICATE:
+        m_libspdm_attest_certificate_offset =
+            ((const spdm_get_certificate_request_t *)spdm_request)->offset;
+        m_libspdm_attest_certificate_length =
+            ((const spdm_get_certificate_request_t *)spdm_request)->length;
+        return RETURN_SUCCESS;
+    case SPDM_CHALLENGE:
+        message_size = sizeof(spdm_challenge_request_t);
+        break;
+    case SPDM_GET_MEASUREMENTS:
+        if ((spdm_request->param1 &
+             SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) != 0) {
+            message_size = sizeof(spdm_get_measurements_request_t);
+        } else {
+            message_size = sizeof(spdm_message_header_t);
+        }
+        break;
+    default:
+        return RETURN_DEVICE_ERROR;
+    }
+    m_libspdm_local_buffer_size = 0;
+    libspdm_copy_mem(m_libspdm_local_buffer, sizeof(m_libspdm_local_buffer),
+                     spdm_request, message_size);
+    m_libspdm_local_buffer_size += message_size;
+    return RETURN_SUCCESS;
+}
+
+/**
+ * Build the CERTIFICATE response of the last GET_CERTIFICATE, from the certificate chain of
+ * the responder.
+ **/
+static return_status libspdm_test_attest_certificate_response(void *spdm_context,
+                                                              uintn *response_size,
+                                                              void *response)
+{
+    spdm_certificate_response_t *spdm_response;
+    uint8_t temp_buf[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    uintn temp_buf_size;
+    uint16_t portion_length;
+
+    if (m_libspdm_local_certificate_chain == NULL) {
+        libspdm_read_responder_public_certificate_chain(
+            m_libspdm_use_hash_algo, m_libspdm_use_asym_algo,
+            &m_libspdm_local_certificate_chain,
+            &m_libspdm_local_certificate_chain_size, NULL, NULL);
+    }
+    if (m_libspdm_local_certificate_chain == NULL) {
+        return RETURN_OUT_OF_RESOURCES;
+    }
+    if (m_libspdm_attest_certificate_offset >= m_libspdm_local_certificate_chain_size) {
+        return RETURN_DEVICE_ERROR;
+    }
+    portion_length = (uint16_t)MIN(m_libspdm_attest_certificate_length,
+                                   m_libspdm_local_certificate_chain_size -
+                                   m_libspdm_attest_certificate_offset);
+
+    temp_buf_size = sizeof(spdm_certificate_response_t) + portion_length;
+    spdm_response = (void *)temp_buf;
+
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+    spdm_response->header.request_response_code = SPDM_CERTIFICATE;
+    spdm_response->header.param1 = m_libspdm_attest_request_param1[
+        m_libspdm_attest_request_count - 1];
+    spdm_response->header.param2 = 0;
+    spdm_response->portion_length = portion_length;
+    spdm_response->remainder_length =
+        (uint16_t)(m_libspdm_local_certificate_chain_size -
+                   m_libspdm_attest_certificate_offset - portion_length);
+    libspdm_copy_mem(spdm_response + 1,
+                     sizeof(temp_buf) - sizeof(*spdm_response),
+                     (uint8_t *)m_libspdm_local_certificate_chain +
+                     m_libspdm_attest_certificate_offset,
+                     portion_length);
+
+    if (spdm_response->remainder_length == 0) {
+        free(m_libspdm_local_certificate_chain);
+        m_libspdm_local_certificate_chain = NULL;
+        m_libspdm_local_certificate_chain_size = 0;
+    }
+
+    return libspdm_transport_test_encode_message(spdm_context, NULL, false,
+                                                 false, temp_buf_size,
+                                                 temp_buf, response_size,
+                                                 response);
+}
+
+/**
+ * Build a CHALLENGE_AUTH response of slot 0, signed over the CHALLENGE request.
+ **/
+static return_status libspdm_test_attest_challenge_auth_response(void *spdm_context,
+                                                                 uintn *response_size,
+                                                                 void *response)
+{
+    spdm_challenge_auth_response_t *spdm_response;
+    void *data;
+    uintn data_size;
+    uint8_t *ptr;
+    uintn sig_size;
+    uint8_t temp_buf[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    uintn temp_buf_size;
+
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, NULL, NULL);
+    temp_buf_size = sizeof(spdm_challenge_auth_response_t) +
+                    libspdm_get_hash_size(m_libspdm_use_hash_algo) +
+                    SPDM_NONCE_SIZE + 0 + sizeof(uint16_t) + 0 +
+                    libspdm_get_asym_signature_size(m_libspdm_use_asym_algo);
+    spdm_response = (void *)temp_buf;
+
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+    spdm_response->header.request_response_code = SPDM_CHALLENGE_AUTH;
+    spdm_response->header.param1 = 0;
+    spdm_response->header.param2 = (1 << 0);
+    ptr = (void *)(spdm_response + 1);
+    libspdm_hash_all(m_libspdm_use_hash_algo, data, data_size, ptr);
+    free(data);
+    ptr += libspdm_get_hash_size(m_libspdm_use_hash_algo);
+    libspdm_get_random_number(SPDM_NONCE_SIZE, ptr);
+    ptr += SPDM_NONCE_SIZE;
+    *(uint16_t *)ptr = 0;
+    ptr += sizeof(uint16_t);
+    libspdm_copy_mem(&m_libspdm_local_buffer[m_libspdm_local_buffer_size],
+                     sizeof(m_libspdm_local_buffer) - m_libspdm_local_buffer_size,
+                     spdm_response, (uintn)ptr - (uintn)spdm_response);
+    m_libspdm_local_buffer_size += ((uintn)ptr - (uintn)spdm_response);
+    sig_size = libspdm_get_asym_signature_size(m_libspdm_use_asym_algo);
+    libspdm_responder_data_sign(
+        spdm_response->header.spdm_version << SPDM_VERSION_NUMBER_SHIFT_BIT,
+            SPDM_CHALLENGE_AUTH,
+            m_libspdm_use_asym_algo, m_libspdm_use_hash_algo,
+            false, m_libspdm_local_buffer, m_libspdm_local_buffer_size,
+            ptr, &sig_size);
+
+    return libspdm_transport_test_encode_message(spdm_context, NULL, false,
+                                                 false, temp_buf_size,
+                                                 temp_buf, response_size,
+                                                 response);
+}
+
+/**
+ * Build a MEASUREMENTS response of one block, signed over the GET_MEASUREMENTS request.
+ **/
+static return_status libspdm_test_attest_measurements_response(void *spdm_context,
+                                                               uintn *response_size,
+                                                               void *response)
+{
+    spdm_measurements_response_t *spdm_response;
+    uint8_t *ptr;
+    uintn sig_size;
+    uintn measurment_sig_size;
+    spdm_measurement_block_dmtf_t *measurment_block;
+    uint8_t temp_buf[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    uintn temp_buf_size;
+
+    measurment_sig_size =
+        SPDM_NONCE_SIZE + sizeof(uint16_t) + 0 +
+        libspdm_get_asym_signature_size(m_libspdm_use_asym_algo);
+    temp_buf_size = sizeof(spdm_measurements_response_t) +
+                    sizeof(spdm_measurement_block_dmtf_t) +
+                    libspdm_get_measurement_hash_size(
+        m_libspdm_use_measurement_hash_algo) +
+                    measurment_sig_size;
+    spdm_response = (void *)temp_buf;
+
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+    spdm_response->header.request_response_code = SPDM_MEASUREMENTS;
+    spdm_response->header.param1 = 0;
+    spdm_response->header.param2 = 0;
+    spdm_response->number_of_blocks = 1;
+    libspdm_write_uint24(
+        spdm_response->measurement_record_length,
+        (uint32_t)(sizeof(spdm_measurement_block_dmtf_t) +
+                   libspdm_get_measurement_hash_size(
+                       m_libspdm_use_measurement_hash_algo)));
+    measurment_block = (void *)(spdm_response + 1);
+    libspdm_set_mem(measurment_block,
+                    sizeof(spdm_measurement_block_dmtf_t) +
+                    libspdm_get_measurement_hash_size(
+                        m_libspdm_use_measurement_hash_algo),
+                    1);
+    measurment_block->measurement_block_common_header
+    .measurement_specification =
+        SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+    measurment_block->measurement_block_common_header
+    .measurement_size =
+        (uint16_t)(sizeof(spdm_measurement_block_dmtf_header_t) +
+                   libspdm_get_measurement_hash_size(
+                       m_libspdm_use_measurement_hash_algo));
+    ptr = (void *)((uint8_t *)spdm_response + temp_buf_size -
+                   measurment_sig_size);
+    libspdm_get_random_number(SPDM_NONCE_SIZE, ptr);
+    ptr += SPDM_NONCE_SIZE;
+    *(uint16_t *)ptr = 0;
+    ptr += sizeof(uint16_t);
+    libspdm_copy_mem(&m_libspdm_local_buffer[m_libspdm_local_buffer_size],
+                     sizeof(m_libspdm_local_buffer) - m_libspdm_local_buffer_size,
+                     spdm_response, (uintn)ptr - (uintn)spdm_response);
+    m_libspdm_local_buffer_size += ((uintn)ptr - (uintn)spdm_response);
+    sig_size = libspdm_get_asym_signature_size(m_libspdm_use_asym_algo);
+    libspdm_responder_data_sign(
+        spdm_response->header.spdm_version << SPDM_VERSION_NUMBER_SHIFT_BIT,
+            SPDM_MEASUREMENTS,
+            m_libspdm_use_asym_algo, m_libspdm_use_hash_algo,
+            false, m_libspdm_local_buffer, m_libspdm_local_buffer_size,
+            ptr, &sig_size);
+
+    return libspdm_transport_test_encode_message(spdm_context, NULL, false,
+                                                 false, temp_buf_size,
+                                                 temp_buf, response_size,
+                                                 response);
+}
+
+/**
+ * Build an ERROR response of the error code.
+ **/
+static return_status libspdm_test_attest_error_response(void *spdm_context,
+                                                        uintn *response_size,
+                                                        void *response,
+                                                        uint8_t error_code)
+{
+    spdm_error_response_t spdm_response;
+
+    spdm_response.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+    spdm_response.header.request_response_code = SPDM_ERROR;
+    spdm_response.header.param1 = error_code;
+    spdm_response.header.param2 = 0;
+
+    return libspdm_transport_test_encode_message(spdm_context, NULL, false,
+                                                 false, sizeof(spdm_response),
+                                                 &spdm_response,
+                                                 response_size, response);
+}
+
+return_status libspdm_requester_attest_test_receive_message(void *spdm_context,
+                                                            uintn *response_size,
+                                                            void *response,
+                                                            uint64_t timeout)
+{
+    libspdm_test_context_t *spdm_test_context;
+    uint8_t request_code;
+
+    spdm_test_context = libspdm_get_test_context();
+    if (m_libspdm_attest_request_count == 0) {
+        return RETURN_DEVICE_ERROR;
+    }
+    request_code = m_libspdm_attest_request_code[m_libspdm_attest_request_count - 1];
+    if (request_code == SPDM_GET_MEASUREMENTS) {
+        m_libspdm_attest_measurements_count++;
+    }
+
+    switch (spdm_test_context->case_id) {
+    case 0x1: /*certificate chain of the slot*/
+        if (request_code != SPDM_GET_CERTIFICATE) {
+            return RETURN_DEVICE_ERROR;
+        }
+        return libspdm_test_attest_certificate_response(spdm_context, response_size,
+                                                        response);
+
+    case 0x2: /*GET_MEASUREMENTS rejected until CHALLENGE*/
+        if (request_code == SPDM_CHALLENGE) {
+            return libspdm_test_attest_challenge_auth_response(spdm_context, response_size,
+                                                               response);
+        }
+        if (request_code != SPDM_GET_MEASUREMENTS) {
+            return RETURN_DEVICE_ERROR;
+        }
+        if (m_libspdm_attest_measurements_count == 1) {
+            return libspdm_test_attest_error_response(spdm_context, response_size, response,
+                                                      SPDM_ERROR_CODE_UNEXPECTED_REQUEST);
+        }
+        return libspdm_test_attest_measurements_response(spdm_context, response_size,
+                                                         response);
+
+    case 0x3: { /*truncated MEASUREMENTS*/
+        spdm_message_header_t spdm_response;
+
+        if (request_code != SPDM_GET_MEASUREMENTS) {
+            return RETURN_DEVICE_ERROR;
+        }
+        spdm_response.spdm_version = SPDM_MESSAGE_VERSION_11;
+        spdm_response.request_response_code = SPDM_MEASUREMENTS;
+        spdm_response.param1 = 0;
+        spdm_response.param2 = 0;
+        return libspdm_transport_test_encode_message(spdm_context, NULL, false,
+                                                     false, sizeof(spdm_response),
+                                                     &spdm_response,
+                                                     response_size, response);
+    }
+
+    case 0x4: /*GET_MEASUREMENTS always rejected*/
+        if (request_code != SPDM_GET_MEASUREMENTS) {
+            return RETURN_DEVICE_ERROR;
+        }
+        return libspdm_test_attest_error_response(spdm_context, response_size, response,
+                                                  SPDM_ERROR_CODE_UNEXPECTED_REQUEST);
+
+    default:
+        return RETURN_DEVICE_ERROR;
+    }
+}
+
+/**
+ * Test 1: the verified certificate chain is of another slot.
+ * Expected Behavior: GET_CERTIFICATE is sent for the slot, even though the cached chain has
+ * the same content, then an attestation of the same slot reuses it without any request.
+ **/
+void libspdm_test_requester_attest_case1(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_attest_evidence_t evidence;
+    void *data;
+    uintn data_size;
+    void *hash;
+    uintn hash_size;
+    uint8_t *root_cert;
+    uintn root_cert_size;
+    uint8_t cert_chain_hash[LIBSPDM_MAX_HASH_SIZE];
+    uintn index;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x1;
+    libspdm_test_attest_setup_context(spdm_context,
+                                      SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP);
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, &hash, &hash_size);
+    libspdm_x509_get_cert_from_cert_chain((uint8_t *)data + sizeof(spdm_cert_chain_t) + hash_size,
+                                          data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
+                                          &root_cert, &root_cert_size);
+    spdm_context->local_context.peer_root_cert_provision_size[0] = root_cert_size;
+    spdm_context->local_context.peer_root_cert_provision[0] = root_cert;
+    spdm_context->local_context.peer_cert_chain_provision = NULL;
+    spdm_context->local_context.peer_cert_chain_provision_size = 0;
+    libspdm_test_attest_cache_cert_chain(spdm_context, 1, data, data_size);
+    libspdm_hash_all(m_libspdm_use_hash_algo, data, data_size, cert_chain_hash);
+
+    status = libspdm_attest(spdm_context, 0, NULL, NULL, &evidence);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(evidence.step_mask, 1 << LIBSPDM_ATTEST_STEP_GET_CERTIFICATE);
+    assert_int_equal(evidence.authenticated, false);
+    assert_int_equal(evidence.cert_chain_hash_size,
+                     libspdm_get_hash_size(m_libspdm_use_hash_algo));
+    assert_memory_equal(evidence.cert_chain_hash, cert_chain_hash,
+                        evidence.cert_chain_hash_size);
+    assert_int_equal(spdm_context->connection_info.peer_used_cert_chain_slot_id, 0);
+    assert_int_not_equal(m_libspdm_attest_request_count, 0);
+    for (index = 0; index < m_libspdm_attest_request_count; index++) {
+        assert_int_equal(m_libspdm_attest_request_code[index], SPDM_GET_CERTIFICATE);
+        assert_int_equal(m_libspdm_attest_request_param1[index], 0);
+    }
+
+    m_libspdm_attest_request_count = 0;
+    status = libspdm_attest(spdm_context, 0, NULL, NULL, &evidence);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(evidence.step_mask, 0);
+    assert_int_equal(m_libspdm_attest_request_count, 0);
+    assert_memory_equal(evidence.cert_chain_hash, cert_chain_hash,
+                        evidence.cert_chain_hash_size);
+    spdm_context->local_context.peer_root_cert_provision_size[0] = 0;
+    spdm_context->local_context.peer_root_cert_provision[0] = NULL;
+    free(data);
+}
+
+/**
+ * Test 2: the device signs measurements, but rejects GET_MEASUREMENTS before CHALLENGE.
+ * Expected Behavior: CHALLENGE is sent after the ERROR response, then the signed
+ * GET_MEASUREMENTS again, and the device is attested.
+ **/
+void libspdm_test_requester_attest_case2(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_attest_evidence_t evidence;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    void *data;
+    uintn data_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x2;
+    libspdm_test_attest_setup_context(spdm_context,
+                                      SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+                                      SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP |
+                                      SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG);
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, NULL, NULL);
+    libspdm_test_attest_cache_cert_chain(spdm_context, 0, data, data_size);
+
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_attest(spdm_context, 0, &measurement_record_length,
+                            measurement_record, &evidence);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(evidence.step_mask,
+                     (1 << LIBSPDM_ATTEST_STEP_CHALLENGE) |
+                     (1 << LIBSPDM_ATTEST_STEP_GET_MEASUREMENTS));
+    assert_int_equal(evidence.authenticated, true);
+    assert_int_equal(evidence.number_of_blocks, 1);
+    assert_int_equal(measurement_record_length,
+                     sizeof(spdm_measurement_block_dmtf_t) +
+                     libspdm_get_measurement_hash_size(m_libspdm_use_measurement_hash_algo));
+    assert_int_equal(m_libspdm_attest_request_count, 3);
+    assert_int_equal(m_libspdm_attest_request_code[0], SPDM_GET_MEASUREMENTS);
+    assert_int_equal(m_libspdm_attest_request_code[1], SPDM_CHALLENGE);
+    assert_int_equal(m_libspdm_attest_request_code[2], SPDM_GET_MEASUREMENTS);
+    assert_int_equal(spdm_context->peer_error_code, 0);
+    free(data);
+}
+
+/**
+ * Test 3: the MEASUREMENTS response is truncated.
+ * Expected Behavior: the failure is returned without CHALLENGE, since the device did not
+ * reject the request with an ERROR response.
+ **/
+void libspdm_test_requester_attest_case3(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_attest_evidence_t evidence;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    void *data;
+    uintn data_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x3;
+    libspdm_test_attest_setup_context(spdm_context,
+                                      SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+                                      SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CHAL_CAP |
+                                      SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG);
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, NULL, NULL);
+    libspdm_test_attest_cache_cert_chain(spdm_context, 0, data, data_size);
+
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_attest(spdm_context, 0, &measurement_record_length,
+                            measurement_record, &evidence);
+    assert_int_equal(status, RETURN_DEVICE_ERROR);
+    assert_int_equal(evidence.step_mask, 1 << LIBSPDM_ATTEST_STEP_GET_MEASUREMENTS);
+    assert_int_equal(evidence.authenticated, false);
+    assert_int_equal(m_libspdm_attest_request_count, 1);
+    assert_int_equal(spdm_context->peer_error_code, 0);
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#endif
+    free(data);
+}
+
+/**
+ * Test 4: the device rejects GET_MEASUREMENTS, and does not support CHALLENGE.
+ * Expected Behavior: the failure is returned without CHALLENGE, with the error code of the
+ * device.
+ **/
+void libspdm_test_requester_attest_case4(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    libspdm_attest_evidence_t evidence;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    void *data;
+    uintn data_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x4;
+    libspdm_test_attest_setup_context(spdm_context,
+                                      SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP |
+                                      SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG);
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, NULL, NULL);
+    libspdm_test_attest_cache_cert_chain(spdm_context, 0, data, data_size);
+
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_attest(spdm_context, 0, &measurement_record_length,
+                            measurement_record, &evidence);
+    assert_int_equal(status, RETURN_DEVICE_ERROR);
+    assert_int_equal(evidence.step_mask, 1 << LIBSPDM_ATTEST_STEP_GET_MEASUREMENTS);
+    assert_int_equal(evidence.authenticated, false);
+    assert_int_equal(m_libspdm_attest_request_count, 1);
+    assert_int_equal(spdm_context->peer_error_code, SPDM_ERROR_CODE_UNEXPECTED_REQUEST);
+    free(data);
+}
+
+libspdm_test_context_t m_libspdm_requester_attest_test_context = {
+    LIBSPDM_TEST_CONTEXT_SIGNATURE,
+    true,
+    libspdm_requester_attest_test_send_message,
+    libspdm_requester_attest_test_receive_message,
+};
+
+int libspdm_requester_attest_test_main(void)
+{
+    const struct CMUnitTest spdm_requester_attest_tests[] = {
+        /* Cached certificate chain of another slot*/
+        cmocka_unit_test(libspdm_test_requester_attest_case1),
+        /* GET_MEASUREMENTS rejected before CHALLENGE*/
+        cmocka_unit_test(libspdm_test_requester_attest_case2),
+        /* Truncated MEASUREMENTS response*/
+        cmocka_unit_test(libspdm_test_requester_attest_case3),
+        /* GET_MEASUREMENTS rejected without CHAL_CAP*/
+        cmocka_unit_test(libspdm_test_requester_attest_case4),
+    };
+
+    libspdm_setup_test_context(&m_libspdm_requester_attest_test_context);
+
+    return cmocka_run_group_tests(spdm_requester_attest_tests,
+                                  libspdm_unit_test_group_setup,
+                                  libspdm_unit_test_group_teardown);
+}
+
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CERT_CAP && ..._CHAL_CAP && ..._MEAS_CAP*/
@@ -12,6 +12,10 @@
 static void *m_libspdm_local_certificate_chain;
 static uintn m_libspdm_local_certificate_chain_size;
 
+static uint16_t m_libspdm_get_certificate_request_offset;
+static uint16_t m_libspdm_get_certificate_request_length;
+static uintn m_libspdm_get_certificate_request_count;
+
 /* Loading the target expiration certificate chain and saving root certificate hash
  * "rsa3072_Expiration/bundle_responder.certchain.der"*/
 bool libspdm_libspdm_read_responder_public_certificate_chain_expiration(
@@ -138,6 +142,16 @@ return_status libspdm_requester_get_certificate_test_send_message(
         return RETURN_SUCCESS;
     case 0x17:
         return RETURN_SUCCESS;
+    case 0x18: {
+        const spdm_get_certificate_request_t *spdm_request;
+
+        spdm_request = (const void *)((const uint8_t *)request +
+                                      sizeof(libspdm_test_message_header_t));
+        m_libspdm_get_certificate_request_offset = spdm_request->offset;
+        m_libspdm_get_certificate_request_length = spdm_request->length;
+        m_libspdm_get_certificate_request_count++;
+    }
+        return RETURN_SUCCESS;
     default:
         return RETURN_DEVICE_ERROR;
     }
@@ -690,8 +704,6 @@ return_status libspdm_requester_get_certificate_test_receive_message(
         uintn temp_buf_size;
         uint16_t portion_length;
         uint16_t remainder_length;
-        uintn count;
-        static uintn calling_index = 0;
 
         if (m_libspdm_local_certificate_chain == NULL) {
             libspdm_read_responder_public_certificate_chain(
@@ -702,21 +714,11 @@ return_status libspdm_requester_get_certificate_test_receive_message(
         if (m_libspdm_local_certificate_chain == NULL) {
             return RETURN_OUT_OF_RESOURCES;
         }
-        count = (m_libspdm_local_certificate_chain_size +
-                 LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN + 1) /
-                LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN;
-        if (calling_index != count - 1) {
-            portion_length = LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN;
-            remainder_length =
-                (uint16_t)(m_libspdm_local_certificate_chain_size -
-                           LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN *
-                           (calling_index + 1));
-        } else {
-            portion_length = (uint16_t)(
-                m_libspdm_local_certificate_chain_size -
-                LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN * (count - 1));
-            remainder_length = 0;
-        }
+        /* The requester stops after the first portion, which holds the root hash.*/
+        portion_length = LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN;
+        remainder_length =
+            (uint16_t)(m_libspdm_local_certificate_chain_size -
+                       LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN);
 
         temp_buf_size =
             sizeof(spdm_certificate_response_t) + portion_length;
@@ -730,8 +732,7 @@ return_status libspdm_requester_get_certificate_test_receive_message(
         spdm_response->remainder_length = remainder_length;
         libspdm_copy_mem(spdm_response + 1,
                          sizeof(temp_buf) - sizeof(*spdm_response),
-                         (uint8_t *)m_libspdm_local_certificate_chain +
-                         LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN * calling_index,
+                         m_libspdm_local_certificate_chain,
                          portion_length);
 
         libspdm_transport_test_encode_message(spdm_context, NULL, false,
@@ -739,13 +740,9 @@ return_status libspdm_requester_get_certificate_test_receive_message(
                                               temp_buf, response_size,
                                               response);
 
-        calling_index++;
-        if (calling_index == count) {
-            calling_index = 0;
-            free(m_libspdm_local_certificate_chain);
-            m_libspdm_local_certificate_chain = NULL;
-            m_libspdm_local_certificate_chain_size = 0;
-        }
+        free(m_libspdm_local_certificate_chain);
+        m_libspdm_local_certificate_chain = NULL;
+        m_libspdm_local_certificate_chain_size = 0;
     }
         return RETURN_SUCCESS;
 
@@ -836,7 +833,7 @@ return_status libspdm_requester_get_certificate_test_receive_message(
         if (m_libspdm_local_certificate_chain == NULL) {
             return RETURN_OUT_OF_RESOURCES;
         }
-        count = (m_libspdm_local_certificate_chain_size + get_cert_length + 1) /
+        count = (m_libspdm_local_certificate_chain_size + get_cert_length - 1) /
                 get_cert_length;
         if (calling_index != count - 1) {
             portion_length = get_cert_length;
@@ -1528,6 +1525,49 @@ return_status libspdm_requester_get_certificate_test_receive_message(
     }
         return RETURN_SUCCESS;
 
+    case 0x18: {
+        spdm_certificate_response_t *spdm_response;
+        uint8_t temp_buf[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+        uintn temp_buf_size;
+        uint16_t portion_length;
+        uint16_t remainder_length;
+
+        /* The chain is owned by the test, serve exactly the requested portion.*/
+        if (m_libspdm_get_certificate_request_offset >=
+            m_libspdm_local_certificate_chain_size) {
+            return RETURN_DEVICE_ERROR;
+        }
+        portion_length = (uint16_t)MIN(
+            m_libspdm_get_certificate_request_length,
+            m_libspdm_local_certificate_chain_size -
+            m_libspdm_get_certificate_request_offset);
+        remainder_length = (uint16_t)(m_libspdm_local_certificate_chain_size -
+                                      m_libspdm_get_certificate_request_offset -
+                                      portion_length);
+
+        temp_buf_size =
+            sizeof(spdm_certificate_response_t) + portion_length;
+        spdm_response = (void *)temp_buf;
+
+        spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_10;
+        spdm_response->header.request_response_code = SPDM_CERTIFICATE;
+        spdm_response->header.param1 = 0;
+        spdm_response->header.param2 = 0;
+        spdm_response->portion_length = portion_length;
+        spdm_response->remainder_length = remainder_length;
+        libspdm_copy_mem(spdm_response + 1,
+                         sizeof(temp_buf) - sizeof(*spdm_response),
+                         (uint8_t *)m_libspdm_local_certificate_chain +
+                         m_libspdm_get_certificate_request_offset,
+                         portion_length);
+
+        libspdm_transport_test_encode_message(spdm_context, NULL, false,
+                                              false, temp_buf_size,
+                                              temp_buf, response_size,
+                                              response);
+    }
+        return RETURN_SUCCESS;
+
     default:
         return RETURN_DEVICE_ERROR;
     }
@@ -2213,7 +2253,7 @@ void libspdm_test_requester_get_certificate_case11(void **state)
 
 /**
  * Test 12: Normal procedure, but the retrieved root certificate does not match
- * Expected Behavior: get a RETURN_SECURITY_VIOLATION, and receives the correct number of Certificate messages
+ * Expected Behavior: get a RETURN_SECURITY_VIOLATION after the first Certificate message, which holds the root hash
  **/
 void libspdm_test_requester_get_certificate_case12(void **state)
 {
@@ -2228,9 +2268,6 @@ void libspdm_test_requester_get_certificate_case12(void **state)
     uintn hash_size;
     uint8_t *root_cert;
     uintn root_cert_size;
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    uintn count;
-#endif
 
     spdm_test_context = *state;
     spdm_context = spdm_test_context->spdm_context;
@@ -2274,12 +2311,10 @@ void libspdm_test_requester_get_certificate_case12(void **state)
                                      cert_chain);
     assert_int_equal(status, RETURN_SECURITY_VIOLATION);
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
-    count = (data_size + LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN - 1) /
-            LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN;
     assert_int_equal(spdm_context->transcript.message_b.buffer_size,
-                     sizeof(spdm_get_certificate_request_t) * count +
-                     sizeof(spdm_certificate_response_t) * count +
-                     data_size);
+                     sizeof(spdm_get_certificate_request_t) +
+                     sizeof(spdm_certificate_response_t) +
+                     LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN);
 #endif
     free(data);
 }
@@ -2437,8 +2472,6 @@ void libspdm_test_requester_get_certificate_case15(void **state)
     return_status status;
     libspdm_test_context_t *spdm_test_context;
     libspdm_context_t *spdm_context;
-    uintn cert_chain_size;
-    uint8_t cert_chain[LIBSPDM_MAX_CERT_CHAIN_SIZE];
     void *data;
     uintn data_size;
     void *hash;
@@ -2447,6 +2480,10 @@ void libspdm_test_requester_get_certificate_case15(void **state)
     uintn root_cert_size;
 #if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     uintn count;
+    uintn cert_chain_size;
+    uint8_t cert_chain[LIBSPDM_MAX_CERT_CHAIN_SIZE];
+#else
+    uint8_t hash_data[LIBSPDM_MAX_HASH_SIZE];
 #endif
 
     spdm_test_context = *state;
@@ -2475,22 +2512,23 @@ void libspdm_test_requester_get_certificate_case15(void **state)
     spdm_context->local_context.peer_cert_chain_provision_size = 0;
     spdm_context->connection_info.algorithm.base_hash_algo =
         m_libspdm_use_hash_algo;
+    /*MAXUINT16_CERT signature_algo is SHA256RSA */
     spdm_context->connection_info.algorithm.base_asym_algo =
-        m_libspdm_use_asym_algo;
+        SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048;
     spdm_context->connection_info.algorithm.req_base_asym_alg =
         m_libspdm_use_req_asym_algo;
     /* Reseting message buffer*/
     libspdm_reset_message_b(spdm_context);
     /* Calculating expected number of messages received*/
 
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
     cert_chain_size = sizeof(cert_chain);
     libspdm_zero_mem(cert_chain, sizeof(cert_chain));
     status = libspdm_get_certificate(spdm_context, 0, &cert_chain_size,
                                      cert_chain);
-    /* It may fail because the spdm does not support too long message.
+    /* It may fail because the recorded transcript does not support too long message.
      * assert_int_equal (status, RETURN_SUCCESS);*/
     if (status == RETURN_SUCCESS) {
-#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
         count = (data_size + LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN - 1) /
                 LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN;
         assert_int_equal(
@@ -2498,8 +2536,17 @@ void libspdm_test_requester_get_certificate_case15(void **state)
             sizeof(spdm_get_certificate_request_t) * count +
             sizeof(spdm_certificate_response_t) * count +
             data_size);
-#endif
     }
+#else
+    /* The chain is verified while it is received, so its size is not limited by a buffer.*/
+    status = libspdm_get_certificate(spdm_context, 0, NULL, NULL);
+    assert_int_equal(status, RETURN_SUCCESS);
+    libspdm_hash_all(m_libspdm_use_hash_algo, data, data_size, hash_data);
+    assert_int_equal(spdm_context->connection_info.peer_used_cert_chain_buffer_hash_size,
+                     libspdm_get_hash_size(m_libspdm_use_hash_algo));
+    assert_memory_equal(spdm_context->connection_info.peer_used_cert_chain_buffer_hash,
+                        hash_data, libspdm_get_hash_size(m_libspdm_use_hash_algo));
+#endif
     free(data);
 }
 
@@ -2831,6 +2878,7 @@ void libspdm_test_requester_get_certificate_case21(void **state)
     uintn hash_size;
     uint8_t *root_cert;
     uintn root_cert_size;
+    uint16_t cert_chain_block_len;
 
     spdm_test_context = *state;
     spdm_context = spdm_test_context->spdm_context;
@@ -2864,11 +2912,16 @@ void libspdm_test_requester_get_certificate_case21(void **state)
     spdm_context->connection_info.algorithm.req_base_asym_alg =
         m_libspdm_use_req_asym_algo;
 
+    /* request exactly the portion that the responder returns without error*/
+    cert_chain_block_len = LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN;
+    spdm_context->local_context.cert_chain_block_len = cert_chain_block_len;
+
     cert_chain_size = sizeof(cert_chain);
     libspdm_zero_mem(cert_chain, sizeof(cert_chain));
     status = libspdm_get_certificate(spdm_context, 0, &cert_chain_size,
                                      cert_chain);
-    assert_int_equal(status, RETURN_UNSUPPORTED);
+    assert_int_equal(status, RETURN_DEVICE_ERROR);
+    spdm_context->local_context.cert_chain_block_len = 0;
     free(data);
 }
 
@@ -3000,6 +3053,135 @@ libspdm_test_context_t m_libspdm_requester_get_certificate_test_context = {
     libspdm_requester_get_certificate_test_receive_message,
 };
 
+/**
+ * Test 24: get certificate chains of different sizes with different local DataTransferSize
+ * and LIBSPDM_DATA_CERT_CHAIN_BLOCK_LEN.
+ * Expected Behavior: every GET_CERTIFICATE requests as much as the local DataTransferSize
+ * allows, so the number of round trips is the chain size divided by that portion.
+ **/
+void libspdm_test_requester_get_certificate_case24(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    void *data;
+    uintn data_size;
+    void *hash;
+    uintn hash_size;
+    uint8_t *root_cert;
+    uintn root_cert_size;
+    uintn chain_index;
+    uintn dts_index;
+    uintn block_len_index;
+    uintn expected_block_len;
+    uintn expected_count;
+    uintn cert_chain_size;
+    uint8_t cert_chain[LIBSPDM_MAX_CERT_CHAIN_SIZE];
+    static const uint32_t data_transfer_size[] = {
+        0,
+        sizeof(spdm_certificate_response_t) + 0x100,
+        sizeof(spdm_certificate_response_t) + 0x400,
+        LIBSPDM_MAX_MESSAGE_BUFFER_SIZE,
+    };
+    static const uint16_t cert_chain_block_len[] = { 0, 0x200 };
+    static const struct {
+        uint32_t base_asym_algo;
+        uint16_t chain_id;
+    } chain_list[] = {
+        { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256, LIBSPDM_TEST_CERT_SMALL },
+        { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256, 0 },
+#if !LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+        /*MAXUINT16_CERT signature_algo is SHA256RSA */
+        { SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_RSASSA_2048, LIBSPDM_TEST_CERT_MAXUINT16 },
+#endif
+    };
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x18;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_10 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+    spdm_context->connection_info.capability.flags &=
+        ~SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_ALIAS_CERT_CAP;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.req_base_asym_alg =
+        m_libspdm_use_req_asym_algo;
+
+    for (chain_index = 0; chain_index < ARRAY_SIZE(chain_list); chain_index++) {
+        if (chain_list[chain_index].chain_id == 0) {
+            libspdm_read_responder_public_certificate_chain(
+                m_libspdm_use_hash_algo, chain_list[chain_index].base_asym_algo,
+                &data, &data_size, &hash, &hash_size);
+        } else {
+            libspdm_read_responder_public_certificate_chain_by_size(
+                m_libspdm_use_hash_algo, chain_list[chain_index].base_asym_algo,
+                chain_list[chain_index].chain_id, &data, &data_size, &hash, &hash_size);
+        }
+        assert_non_null(data);
+        libspdm_x509_get_cert_from_cert_chain(
+            (uint8_t *)data + sizeof(spdm_cert_chain_t) + hash_size,
+            data_size - sizeof(spdm_cert_chain_t) - hash_size, 0,
+            &root_cert, &root_cert_size);
+        spdm_context->local_context.peer_root_cert_provision_size[0] =
+            root_cert_size;
+        spdm_context->local_context.peer_root_cert_provision[0] = root_cert;
+        spdm_context->local_context.peer_cert_chain_provision = NULL;
+        spdm_context->local_context.peer_cert_chain_provision_size = 0;
+        spdm_context->connection_info.algorithm.base_asym_algo =
+            chain_list[chain_index].base_asym_algo;
+        m_libspdm_local_certificate_chain = data;
+        m_libspdm_local_certificate_chain_size = data_size;
+
+        for (dts_index = 0; dts_index < ARRAY_SIZE(data_transfer_size); dts_index++) {
+            for (block_len_index = 0; block_len_index < ARRAY_SIZE(cert_chain_block_len);
+                 block_len_index++) {
+                spdm_context->local_context.capability.data_transfer_size =
+                    data_transfer_size[dts_index];
+                spdm_context->local_context.cert_chain_block_len =
+                    cert_chain_block_len[block_len_index];
+                expected_block_len = LIBSPDM_MAX_CERT_CHAIN_RECEIVE_BLOCK_LEN;
+                if (cert_chain_block_len[block_len_index] != 0) {
+                    expected_block_len = MIN(expected_block_len,
+                                                     cert_chain_block_len[block_len_index]);
+                }
+                if (data_transfer_size[dts_index] != 0) {
+                    expected_block_len = MIN(
+                        expected_block_len,
+                        data_transfer_size[dts_index] - sizeof(spdm_certificate_response_t));
+                }
+                expected_count = (data_size + expected_block_len - 1) / expected_block_len;
+
+                spdm_context->connection_info.connection_state =
+                    LIBSPDM_CONNECTION_STATE_AFTER_DIGESTS;
+                libspdm_reset_message_b(spdm_context);
+                m_libspdm_get_certificate_request_count = 0;
+                if (data_size <= sizeof(cert_chain)) {
+                    cert_chain_size = sizeof(cert_chain);
+                    status = libspdm_get_certificate(spdm_context, 0, &cert_chain_size,
+                                                     cert_chain);
+                    assert_int_equal(status, RETURN_SUCCESS);
+                    assert_int_equal(cert_chain_size, data_size);
+                    assert_memory_equal(cert_chain, data, data_size);
+                } else {
+                    status = libspdm_get_certificate(spdm_context, 0, NULL, NULL);
+                    assert_int_equal(status, RETURN_SUCCESS);
+                }
+                assert_int_equal(m_libspdm_get_certificate_request_count, expected_count);
+            }
+        }
+
+        m_libspdm_local_certificate_chain = NULL;
+        m_libspdm_local_certificate_chain_size = 0;
+        free(data);
+    }
+
+    spdm_context->local_context.capability.data_transfer_size =
+        LIBSPDM_MAX_MESSAGE_BUFFER_SIZE;
+    spdm_context->local_context.cert_chain_block_len = 0;
+}
 int libspdm_requester_get_certificate_test_main(void)
 {
     const struct CMUnitTest spdm_requester_get_certificate_tests[] = {
@@ -3050,6 +3232,8 @@ int libspdm_requester_get_certificate_test_main(void)
         cmocka_unit_test(libspdm_test_requester_get_certificate_case22),
         /* hardware identify OID is found in AliasCert model cert */
         cmocka_unit_test(libspdm_test_requester_get_certificate_case23),
+        /* Successful response: round trips follow the local DataTransferSize*/
+        cmocka_unit_test(libspdm_test_requester_get_certificate_case24),
     };
 
     libspdm_setup_test_context(&m_libspdm_requester_get_certificate_test_context);
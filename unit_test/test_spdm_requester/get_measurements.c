@@ -12,11 +12,22 @@
 
 #define LIBSPDM_ALTERNATIVE_DEFAULT_SLOT_ID 2
 #define LIBSPDM_LARGE_MEASUREMENT_SIZE ((1 << 24) - 1)
+#define LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER 3
 
 static uintn m_libspdm_local_buffer_size;
 static uint8_t m_libspdm_local_buffer[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
 static uint8_t m_libspdm_local_psk_hint[32];
 
+/* The populated indices of the measurement sweep responders, and their last request*/
+static uint8_t m_libspdm_sweep_index_list[LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER] = {1, 2, 3};
+static uint8_t m_libspdm_sparse_sweep_index_list[LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER] =
+{2, 0x10, 0xFD};
+static spdm_message_header_t m_libspdm_sweep_request;
+static uintn m_libspdm_sweep_request_size;
+static uintn m_libspdm_sweep_request_count;
+/* A populated index that the sweep responders reject in a request of this index alone*/
+static uint8_t m_libspdm_sweep_rejected_index;
+
 uintn libspdm_test_get_measurement_request_size(const void *spdm_context,
                                                 const void *buffer,
                                                 uintn buffer_size)
@@ -81,6 +92,7 @@ return_status libspdm_requester_get_measurements_test_send_message(
     case 0x1:
         return RETURN_DEVICE_ERROR;
     case 0x2:
+    case 0x26:
         m_libspdm_local_buffer_size = 0;
         message_size = libspdm_test_get_measurement_request_size(
             spdm_context, (uint8_t *)request + header_size,
@@ -397,11 +409,137 @@ return_status libspdm_requester_get_measurements_test_send_message(
                          app_message, app_message_size - 3);
         m_libspdm_local_buffer_size += app_message_size - 3;
         return RETURN_SUCCESS;
+    case 0x23:
+    case 0x24:
+    case 0x25:
+        message_size = libspdm_test_get_measurement_request_size(
+            spdm_context, (uint8_t *)request + header_size,
+            request_size - header_size);
+        libspdm_copy_mem(&m_libspdm_sweep_request, sizeof(m_libspdm_sweep_request),
+                         (uint8_t *)request + header_size, sizeof(spdm_message_header_t));
+        m_libspdm_sweep_request_size = message_size;
+        m_libspdm_sweep_request_count++;
+        libspdm_copy_mem(&m_libspdm_local_buffer[m_libspdm_local_buffer_size],
+                         sizeof(m_libspdm_local_buffer) - m_libspdm_local_buffer_size,
+                         (uint8_t *)request + header_size, message_size);
+        m_libspdm_local_buffer_size += message_size;
+        return RETURN_SUCCESS;
     default:
         return RETURN_DEVICE_ERROR;
     }
 }
 
+/**
+ * Encode the response of a measurement sweep responder to the last request.
+ *
+ * An index that is not in the index list, or that is m_libspdm_sweep_rejected_index, is rejected
+ * with ERROR(InvalidRequest) and its request leaves the transcript. A signed response covers all
+ * the requests and responses since the previous signed response.
+ *
+ * @param  spdm_context     A pointer to the SPDM context.
+ * @param  index_list       The LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER populated indices.
+ * @param  response_size    The size in bytes of the response buffer, the encoded size on output.
+ * @param  response         The response buffer.
+ **/
+static void libspdm_test_encode_sweep_response(void *spdm_context, const uint8_t *index_list,
+                                               uintn *response_size, void *response)
+{
+    spdm_measurements_response_t *spdm_response;
+    spdm_error_response_t spdm_error_response;
+    spdm_measurement_block_dmtf_t *measurment_block;
+    uintn measurment_block_size;
+    uint8_t operation;
+    uint8_t number_of_blocks;
+    uint8_t list_index;
+    uint8_t *ptr;
+    uintn sig_size;
+    uint8_t temp_buf[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    uintn temp_buf_size;
+
+    measurment_block_size = sizeof(spdm_measurement_block_dmtf_t) +
+                            libspdm_get_measurement_hash_size(
+        m_libspdm_use_measurement_hash_algo);
+    operation = m_libspdm_sweep_request.param2;
+    spdm_response = (void *)temp_buf;
+
+    spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_11;
+    spdm_response->header.request_response_code = SPDM_MEASUREMENTS;
+    spdm_response->header.param1 = 0;
+    spdm_response->header.param2 = 0;
+    ptr = (void *)(spdm_response + 1);
+    number_of_blocks = 0;
+    if (operation ==
+        SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_TOTAL_NUMBER_OF_MEASUREMENTS) {
+        spdm_response->header.param1 = LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER;
+    } else {
+        for (list_index = 0; list_index < LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER;
+             list_index++) {
+            if ((operation !=
+                 SPDM_GET_MEASUREMENTS_REQUEST_MEASUREMENT_OPERATION_ALL_MEASUREMENTS) &&
+                ((operation != index_list[list_index]) ||
+                 (operation == m_libspdm_sweep_rejected_index))) {
+                continue;
+            }
+            measurment_block = (void *)ptr;
+            libspdm_set_mem(measurment_block, measurment_block_size, index_list[list_index]);
+            measurment_block->measurement_block_common_header.index = index_list[list_index];
+            measurment_block->measurement_block_common_header
+            .measurement_specification =
+                SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+            measurment_block->measurement_block_common_header
+            .measurement_size =
+                (uint16_t)(measurment_block_size -
+                           sizeof(spdm_measurement_block_common_header_t));
+            ptr += measurment_block_size;
+            number_of_blocks++;
+        }
+        if (number_of_blocks == 0) {
+            m_libspdm_local_buffer_size -= m_libspdm_sweep_request_size;
+
+            spdm_error_response.header.spdm_version = SPDM_MESSAGE_VERSION_11;
+            spdm_error_response.header.request_response_code = SPDM_ERROR;
+            spdm_error_response.header.param1 = SPDM_ERROR_CODE_INVALID_REQUEST;
+            spdm_error_response.header.param2 = 0;
+
+            libspdm_transport_test_encode_message(spdm_context, NULL, false,
+                                                  false, sizeof(spdm_error_response),
+                                                  &spdm_error_response,
+                                                  response_size, response);
+            return;
+        }
+    }
+    spdm_response->number_of_blocks = number_of_blocks;
+    libspdm_write_uint24(spdm_response->measurement_record_length,
+                         (uint32_t)(number_of_blocks * measurment_block_size));
+    libspdm_get_random_number(SPDM_NONCE_SIZE, ptr);
+    ptr += SPDM_NONCE_SIZE;
+    *(uint16_t *)ptr = 0;
+    ptr += sizeof(uint16_t);
+    temp_buf_size = (uintn)ptr - (uintn)spdm_response;
+    libspdm_copy_mem(&m_libspdm_local_buffer[m_libspdm_local_buffer_size],
+                     sizeof(m_libspdm_local_buffer) - m_libspdm_local_buffer_size,
+                     spdm_response, temp_buf_size);
+    m_libspdm_local_buffer_size += temp_buf_size;
+
+    if ((m_libspdm_sweep_request.param1 &
+         SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE) != 0) {
+        sig_size = libspdm_get_asym_signature_size(m_libspdm_use_asym_algo);
+        libspdm_responder_data_sign(
+            spdm_response->header.spdm_version << SPDM_VERSION_NUMBER_SHIFT_BIT,
+                SPDM_MEASUREMENTS,
+                m_libspdm_use_asym_algo, m_libspdm_use_hash_algo,
+                false, m_libspdm_local_buffer, m_libspdm_local_buffer_size,
+                ptr, &sig_size);
+        temp_buf_size += sig_size;
+        m_libspdm_local_buffer_size = 0;
+    }
+
+    libspdm_transport_test_encode_message(spdm_context, NULL, false,
+                                          false, temp_buf_size,
+                                          temp_buf, response_size,
+                                          response);
+}
+
 return_status libspdm_requester_get_measurements_test_receive_message(
     void *spdm_context, uintn *response_size,
     void *response, uint64_t timeout)
@@ -414,7 +552,8 @@ return_status libspdm_requester_get_measurements_test_receive_message(
     case 0x1:
         return RETURN_DEVICE_ERROR;
 
-    case 0x2: {
+    case 0x2:
+    case 0x26: {
         spdm_measurements_response_t *spdm_response;
         uint8_t *ptr;
         uint8_t hash_data[LIBSPDM_MAX_HASH_SIZE];
@@ -2580,6 +2719,89 @@ return_status libspdm_requester_get_measurements_test_receive_message(
         ->application_secret.response_data_sequence_number--;
     }
         return RETURN_SUCCESS;
+    case 0x23:
+        libspdm_test_encode_sweep_response(spdm_context, m_libspdm_sweep_index_list,
+                                           response_size, response);
+        return RETURN_SUCCESS;
+
+    case 0x24: {
+        static uintn sub_index0x24 = 0;
+
+        spdm_measurements_response_t *spdm_response;
+        spdm_measurement_block_dmtf_t *measurment_block;
+        uintn measurment_block_size;
+        uint8_t *ptr;
+        uintn sig_size;
+        uint8_t index;
+        uint8_t temp_buf[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+        uintn temp_buf_size;
+
+        measurment_block_size = sizeof(spdm_measurement_block_dmtf_t) +
+                                libspdm_get_measurement_hash_size(
+            m_libspdm_use_measurement_hash_algo);
+        spdm_response = (void *)temp_buf;
+
+        spdm_response->header.spdm_version = SPDM_MESSAGE_VERSION_12;
+        spdm_response->header.request_response_code = SPDM_MEASUREMENTS;
+        spdm_response->header.param1 = 0;
+        spdm_response->header.param2 = 0;
+        /* the 4th response reports a change within its L1/L2*/
+        if (sub_index0x24 == 3) {
+            spdm_response->header.param2 = SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED;
+        }
+        spdm_response->number_of_blocks = LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER;
+        libspdm_write_uint24(spdm_response->measurement_record_length,
+                             (uint32_t)(LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER *
+                                        measurment_block_size));
+        ptr = (void *)(spdm_response + 1);
+        for (index = 1; index <= LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER; index++) {
+            measurment_block = (void *)ptr;
+            /* block 2 changes from the 3rd response on*/
+            libspdm_set_mem(measurment_block, measurment_block_size,
+                            ((index == 2) && (sub_index0x24 >= 2)) ? 0x22 : index);
+            measurment_block->measurement_block_common_header.index = index;
+            measurment_block->measurement_block_common_header
+            .measurement_specification =
+                SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF;
+            measurment_block->measurement_block_common_header
+            .measurement_size =
+                (uint16_t)(measurment_block_size -
+                           sizeof(spdm_measurement_block_common_header_t));
+            ptr += measurment_block_size;
+        }
+        libspdm_get_random_number(SPDM_NONCE_SIZE, ptr);
+        ptr += SPDM_NONCE_SIZE;
+        *(uint16_t *)ptr = 0;
+        ptr += sizeof(uint16_t);
+        temp_buf_size = (uintn)ptr - (uintn)spdm_response;
+        libspdm_copy_mem(&m_libspdm_local_buffer[m_libspdm_local_buffer_size],
+                         sizeof(m_libspdm_local_buffer) - m_libspdm_local_buffer_size,
+                         spdm_response, temp_buf_size);
+        m_libspdm_local_buffer_size += temp_buf_size;
+
+        sig_size = libspdm_get_asym_signature_size(m_libspdm_use_asym_algo);
+        libspdm_responder_data_sign(
+            spdm_response->header.spdm_version << SPDM_VERSION_NUMBER_SHIFT_BIT,
+                SPDM_MEASUREMENTS,
+                m_libspdm_use_asym_algo, m_libspdm_use_hash_algo,
+                false, m_libspdm_local_buffer, m_libspdm_local_buffer_size,
+                ptr, &sig_size);
+        temp_buf_size += sig_size;
+        m_libspdm_local_buffer_size = 0;
+        sub_index0x24++;
+
+        libspdm_transport_test_encode_message(spdm_context, NULL, false,
+                                              false, temp_buf_size,
+                                              temp_buf, response_size,
+                                              response);
+    }
+        return RETURN_SUCCESS;
+
+    case 0x25:
+        libspdm_test_encode_sweep_response(spdm_context, m_libspdm_sparse_sweep_index_list,
+                                           response_size, response);
+        return RETURN_SUCCESS;
+
     default:
         return RETURN_DEVICE_ERROR;
     }
@@ -5212,6 +5434,251 @@ void libspdm_test_requester_get_measurements_case34(void **state)
     free(data);
 }
 
+/**
+ * Test 35: Successful measurement sweep of the indices 1 to 3, one unsigned request for all
+ * measurements, then a signed request for the index 3
+ * Expected Behavior: get a RETURN_SUCCESS return code after two requests, a measurement table of
+ * all blocks pointing into the measurement record, and an empty transcript.message_m
+ **/
+void libspdm_test_requester_get_measurements_case35(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    libspdm_measurement_table_t measurement_table;
+    const libspdm_measurement_table_entry_t *entry;
+    uintn measurement_block_size;
+    uint8_t index;
+    void *data;
+    uintn data_size;
+    void *hash;
+    uintn hash_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x23;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, &hash, &hash_size);
+    libspdm_reset_message_m(spdm_context, NULL);
+    m_libspdm_local_buffer_size = 0;
+    m_libspdm_sweep_request_count = 0;
+    m_libspdm_sweep_rejected_index = 0;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+        data_size;
+    libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+                     sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer),
+                     data, data_size);
+#else
+    libspdm_hash_all(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        data, data_size,
+        spdm_context->connection_info.peer_used_cert_chain_buffer_hash);
+    spdm_context->connection_info.peer_used_cert_chain_buffer_hash_size =
+        libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+    libspdm_get_leaf_cert_public_key_from_cert_chain(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        spdm_context->connection_info.algorithm.base_asym_algo,
+        data, data_size,
+        &spdm_context->connection_info.peer_used_leaf_cert_public_key);
+#endif
+
+    libspdm_zero_mem(&measurement_table, sizeof(measurement_table));
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_sweep(spdm_context, NULL, 0, NULL,
+                                           &measurement_record_length,
+                                           measurement_record, &measurement_table);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(m_libspdm_sweep_request_count, 2);
+    assert_int_equal(m_libspdm_sweep_request.param2, LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER);
+    measurement_block_size = sizeof(spdm_measurement_block_dmtf_t) +
+                             libspdm_get_measurement_hash_size(
+        m_libspdm_use_measurement_hash_algo);
+    assert_int_equal(measurement_record_length,
+                     LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER * measurement_block_size);
+    assert_int_equal(measurement_table.number_of_blocks,
+                     LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER);
+    for (index = 1; index <= LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER; index++) {
+        entry = libspdm_get_measurement_table_entry(&measurement_table, index);
+        assert_non_null(entry);
+        assert_ptr_equal(entry->measurement,
+                         measurement_record + (index - 1) * measurement_block_size +
+                         sizeof(spdm_measurement_block_common_header_t));
+        assert_int_equal(entry->measurement_size,
+                         measurement_block_size -
+                         sizeof(spdm_measurement_block_common_header_t));
+    }
+    assert_null(libspdm_get_measurement_table_entry(
+                    &measurement_table, LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER + 1));
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#endif
+    free(data);
+}
+
+#if LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT
+/**
+ * Test 36: Refresh the measurement cache four times, block 2 changes in the 3rd response and
+ * the 4th response reports a change within its L1/L2
+ * Expected Behavior: the generation moves only when a block changes, the changes since a
+ * generation are the changed blocks, and all blocks after the reported change
+ **/
+void libspdm_test_requester_get_measurements_case36(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint32_t generation;
+    uint32_t first_generation;
+    uint32_t block_generation;
+    uint8_t index_list[LIBSPDM_MAX_MEASUREMENT_BLOCK_COUNT];
+    uint8_t index_count;
+    uint8_t measurement_block[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint32_t measurement_block_length;
+    uintn measurement_block_size;
+    void *data;
+    uintn data_size;
+    void *hash;
+    uintn hash_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x24;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, &hash, &hash_size);
+    libspdm_reset_message_m(spdm_context, NULL);
+    m_libspdm_local_buffer_size = 0;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+        data_size;
+    libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+                     sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer),
+                     data, data_size);
+#else
+    libspdm_hash_all(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        data, data_size,
+        spdm_context->connection_info.peer_used_cert_chain_buffer_hash);
+    spdm_context->connection_info.peer_used_cert_chain_buffer_hash_size =
+        libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+    libspdm_get_leaf_cert_public_key_from_cert_chain(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        spdm_context->connection_info.algorithm.base_asym_algo,
+        data, data_size,
+        &spdm_context->connection_info.peer_used_leaf_cert_public_key);
+#endif
+    libspdm_invalidate_peer_measurement_cache(spdm_context);
+    index_count = ARRAY_SIZE(index_list);
+    status = libspdm_get_cached_measurement_changes(spdm_context, 0, &index_count, index_list);
+    assert_int_equal(status, RETURN_NOT_FOUND);
+    measurement_block_size = sizeof(spdm_measurement_block_dmtf_t) +
+                             libspdm_get_measurement_hash_size(
+        m_libspdm_use_measurement_hash_algo);
+
+    /* 1st response: all blocks are new*/
+    status = libspdm_refresh_measurement_cache(spdm_context, NULL, 0, &first_generation);
+    assert_int_equal(status, RETURN_SUCCESS);
+    index_count = ARRAY_SIZE(index_list);
+    status = libspdm_get_cached_measurement_changes(spdm_context, first_generation - 1,
+                                                    &index_count, index_list);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(index_count, LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER);
+    measurement_block_length = sizeof(measurement_block);
+    status = libspdm_get_cached_measurement(spdm_context, 2, &block_generation,
+                                            &measurement_block_length, measurement_block);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(measurement_block_length, measurement_block_size);
+    assert_int_equal(block_generation, first_generation);
+    assert_int_equal(measurement_block[measurement_block_length - 1], 2);
+
+    /* 2nd response: nothing changed*/
+    status = libspdm_refresh_measurement_cache(spdm_context, NULL, 0, &generation);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(generation, first_generation);
+    index_count = ARRAY_SIZE(index_list);
+    status = libspdm_get_cached_measurement_changes(spdm_context, generation,
+                                                    &index_count, index_list);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(index_count, 0);
+
+    /* 3rd response: block 2 changed*/
+    status = libspdm_refresh_measurement_cache(spdm_context, NULL, 0, &generation);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(generation, first_generation + 1);
+    index_count = ARRAY_SIZE(index_list);
+    status = libspdm_get_cached_measurement_changes(spdm_context, first_generation,
+                                                    &index_count, index_list);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(index_count, 1);
+    assert_int_equal(index_list[0], 2);
+    measurement_block_length = sizeof(measurement_block);
+    status = libspdm_get_cached_measurement(spdm_context, 2, &block_generation,
+                                            &measurement_block_length, measurement_block);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(block_generation, generation);
+    assert_int_equal(measurement_block[measurement_block_length - 1], 0x22);
+    status = libspdm_get_cached_measurement(spdm_context, 1, &block_generation,
+                                            &measurement_block_length, measurement_block);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(block_generation, first_generation);
+    index_count = 0;
+    status = libspdm_get_cached_measurement_changes(spdm_context, 0, &index_count, index_list);
+    assert_int_equal(status, RETURN_BUFFER_TOO_SMALL);
+    assert_int_equal(index_count, LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER);
+
+    /* 4th response: the same blocks, but a change is reported, so the cache is dropped*/
+    first_generation = generation;
+    status = libspdm_refresh_measurement_cache(spdm_context, NULL, 0, &generation);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_true(generation > first_generation);
+    index_count = ARRAY_SIZE(index_list);
+    status = libspdm_get_cached_measurement_changes(spdm_context, first_generation,
+                                                    &index_count, index_list);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(index_count, LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER);
+    status = libspdm_get_cached_measurement(spdm_context,
+                                            LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER + 1, NULL,
+                                            &measurement_block_length, measurement_block);
+    assert_int_equal(status, RETURN_NOT_FOUND);
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#endif
+    free(data);
+}
+#endif /* LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT*/
+
 libspdm_test_context_t m_libspdm_requester_get_measurements_test_context = {
     LIBSPDM_TEST_CONTEXT_SIGNATURE,
     true,
@@ -5219,6 +5686,213 @@ libspdm_test_context_t m_libspdm_requester_get_measurements_test_context = {
     libspdm_requester_get_measurements_test_receive_message,
 };
 
+/**
+ * Test 37: Measurement sweep of the sparse indices 2, 0x10 and 0xFD, then again with a device
+ * that rejects a request of the index 0xFD alone
+ * Expected Behavior: the first sweep signs 0xFD after two requests, the second sweep signs 0x10
+ * after the rejected request, both get a RETURN_SUCCESS return code, all blocks and an empty
+ * transcript.message_m
+ **/
+void libspdm_test_requester_get_measurements_case37(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    libspdm_measurement_table_t measurement_table;
+    const libspdm_measurement_table_entry_t *entry;
+    uintn measurement_block_size;
+    uint8_t list_index;
+    void *data;
+    uintn data_size;
+    void *hash;
+    uintn hash_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x25;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, &hash, &hash_size);
+    libspdm_reset_message_m(spdm_context, NULL);
+    m_libspdm_local_buffer_size = 0;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+        data_size;
+    libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+                     sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer),
+                     data, data_size);
+#else
+    libspdm_hash_all(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        data, data_size,
+        spdm_context->connection_info.peer_used_cert_chain_buffer_hash);
+    spdm_context->connection_info.peer_used_cert_chain_buffer_hash_size =
+        libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+    libspdm_get_leaf_cert_public_key_from_cert_chain(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        spdm_context->connection_info.algorithm.base_asym_algo,
+        data, data_size,
+        &spdm_context->connection_info.peer_used_leaf_cert_public_key);
+#endif
+    measurement_block_size = sizeof(spdm_measurement_block_dmtf_t) +
+                             libspdm_get_measurement_hash_size(
+        m_libspdm_use_measurement_hash_algo);
+
+    /* the last index is signed*/
+    libspdm_zero_mem(&measurement_table, sizeof(measurement_table));
+    m_libspdm_sweep_request_count = 0;
+    m_libspdm_sweep_rejected_index = 0;
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_sweep(spdm_context, NULL, 0, NULL,
+                                           &measurement_record_length,
+                                           measurement_record, &measurement_table);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(m_libspdm_sweep_request_count, 2);
+    assert_int_equal(m_libspdm_sweep_request.param2, 0xFD);
+    assert_int_equal(measurement_record_length,
+                     LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER * measurement_block_size);
+    assert_int_equal(measurement_table.number_of_blocks,
+                     LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER);
+    for (list_index = 0; list_index < LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER; list_index++) {
+        entry = libspdm_get_measurement_table_entry(
+            &measurement_table, m_libspdm_sparse_sweep_index_list[list_index]);
+        assert_non_null(entry);
+        assert_ptr_equal(entry->measurement,
+                         measurement_record + list_index * measurement_block_size +
+                         sizeof(spdm_measurement_block_common_header_t));
+        assert_int_equal(((const uint8_t *)entry->measurement)[
+                             sizeof(spdm_measurement_block_dmtf_header_t)],
+                         m_libspdm_sparse_sweep_index_list[list_index]);
+    }
+    assert_null(libspdm_get_measurement_table_entry(&measurement_table, 1));
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#endif
+
+    /* 0xFD is rejected alone, so 0x10 is signed*/
+    libspdm_zero_mem(&measurement_table, sizeof(measurement_table));
+    m_libspdm_sweep_request_count = 0;
+    m_libspdm_sweep_rejected_index = 0xFD;
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement_sweep(spdm_context, NULL, 0, NULL,
+                                           &measurement_record_length,
+                                           measurement_record, &measurement_table);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(m_libspdm_sweep_request_count, 3);
+    assert_int_equal(m_libspdm_sweep_request.param2, 0x10);
+    assert_int_equal(measurement_record_length,
+                     LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER * measurement_block_size);
+    assert_int_equal(measurement_table.number_of_blocks,
+                     LIBSPDM_MEASUREMENT_SWEEP_BLOCK_NUMBER);
+    assert_non_null(libspdm_get_measurement_table_entry(&measurement_table, 0xFD));
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#endif
+    m_libspdm_sweep_rejected_index = 0;
+    free(data);
+}
+
+/**
+ * Test 38: Out-of-session GET_MEASUREMENTS with signature once the algorithms are negotiated,
+ * without CHALLENGE, then before the algorithms are negotiated
+ * Expected Behavior: get a RETURN_SUCCESS return code, with an empty transcript.message_m, in the
+ * NEGOTIATED state, and a RETURN_UNSUPPORTED return code in the AFTER_CAPABILITIES state
+ **/
+void libspdm_test_requester_get_measurements_case38(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint8_t number_of_block;
+    uint32_t measurement_record_length;
+    uint8_t measurement_record[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uint8_t request_attribute;
+    void *data;
+    uintn data_size;
+    void *hash;
+    uintn hash_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x26;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data,
+                                                    &data_size, &hash, &hash_size);
+    libspdm_reset_message_m(spdm_context, NULL);
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    spdm_context->connection_info.peer_used_cert_chain_buffer_size =
+        data_size;
+    libspdm_copy_mem(spdm_context->connection_info.peer_used_cert_chain_buffer,
+                     sizeof(spdm_context->connection_info.peer_used_cert_chain_buffer),
+                     data, data_size);
+#else
+    libspdm_hash_all(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        data, data_size,
+        spdm_context->connection_info.peer_used_cert_chain_buffer_hash);
+    spdm_context->connection_info.peer_used_cert_chain_buffer_hash_size =
+        libspdm_get_hash_size(spdm_context->connection_info.algorithm.base_hash_algo);
+    libspdm_get_leaf_cert_public_key_from_cert_chain(
+        spdm_context->connection_info.algorithm.base_hash_algo,
+        spdm_context->connection_info.algorithm.base_asym_algo,
+        data, data_size,
+        &spdm_context->connection_info.peer_used_leaf_cert_public_key);
+#endif
+
+    request_attribute =
+        SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE;
+
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement(spdm_context, NULL, request_attribute, 1,
+                                     0, NULL, &number_of_block,
+                                     &measurement_record_length,
+                                     measurement_record);
+    assert_int_equal(status, RETURN_SUCCESS);
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#endif
+
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
+    measurement_record_length = sizeof(measurement_record);
+    status = libspdm_get_measurement(spdm_context, NULL, request_attribute, 1,
+                                     0, NULL, &number_of_block,
+                                     &measurement_record_length,
+                                     measurement_record);
+    assert_int_equal(status, RETURN_UNSUPPORTED);
+    free(data);
+}
+
 int libspdm_requester_get_measurements_test_main(void)
 {
     const struct CMUnitTest spdm_requester_get_measurements_tests[] = {
@@ -5290,6 +5964,16 @@ int libspdm_requester_get_measurements_test_main(void)
         cmocka_unit_test(libspdm_test_requester_get_measurements_case33),
         /* Successful response to get a session based measurement with signature*/
         cmocka_unit_test(libspdm_test_requester_get_measurements_case34),
+        /* Successful measurement sweep with a single signature*/
+        cmocka_unit_test(libspdm_test_requester_get_measurements_case35),
+#if LIBSPDM_PEER_MEASUREMENT_CACHE_SUPPORT
+        /* Measurement cache refresh, with a changed block and a reported change*/
+        cmocka_unit_test(libspdm_test_requester_get_measurements_case36),
+#endif
+        /* Measurement sweep of sparse indices, with a rejected last index*/
+        cmocka_unit_test(libspdm_test_requester_get_measurements_case37),
+        /* Successful response to get a measurement with signature in the NEGOTIATED state*/
+        cmocka_unit_test(libspdm_test_requester_get_measurements_case38),
     };
 
     libspdm_setup_test_context(
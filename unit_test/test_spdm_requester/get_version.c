@@ -54,6 +54,10 @@ libspdm_return_t libspdm_requester_get_version_test_send_message(
         return LIBSPDM_STATUS_SUCCESS;
     case 0xF:
         return LIBSPDM_STATUS_SUCCESS;
+    case 0x10:
+        return LIBSPDM_STATUS_SUCCESS;
+    case 0x11:
+        return LIBSPDM_STATUS_SUCCESS;
     default:
         return RETURN_DEVICE_ERROR;
     }
@@ -70,7 +74,9 @@ libspdm_return_t libspdm_requester_get_version_test_receive_message(
     case 0x1:
         return LIBSPDM_STATUS_SUCCESS;
 
-    case 0x2: {
+    case 0x2:
+    case 0x10:
+    case 0x11: {
         libspdm_version_response_mine_t spdm_response;
 
         libspdm_zero_mem(&spdm_response, sizeof(spdm_response));
@@ -648,6 +654,200 @@ void libspdm_test_requester_get_version_case15(void **state)
         spdm_context->connection_info.version >> SPDM_VERSION_NUMBER_SHIFT_BIT, 0x11);
 }
 
+#if LIBSPDM_TRACE_SUPPORT
+#define LIBSPDM_TEST_TRACE_EVENT_COUNT 8
+
+static libspdm_trace_event_t m_libspdm_test_trace_event[LIBSPDM_TEST_TRACE_EVENT_COUNT];
+static uintn m_libspdm_test_trace_event_count;
+static uint64_t m_libspdm_test_trace_time;
+
+static void libspdm_test_trace(void *spdm_context, const libspdm_trace_event_t *event)
+{
+    if (m_libspdm_test_trace_event_count < LIBSPDM_TEST_TRACE_EVENT_COUNT) {
+        m_libspdm_test_trace_event[m_libspdm_test_trace_event_count] = *event;
+    }
+    m_libspdm_test_trace_event_count++;
+}
+
+static uint64_t libspdm_test_trace_get_time(void)
+{
+    return m_libspdm_test_trace_time++;
+}
+
+/**
+ * Test 16: receiving a correct VERSION message while a trace function is registered.
+ * Expected behavior: the ENCODE, SEND, WAIT and DECODE phases of GET_VERSION are traced in
+ * order, with the message sizes and without overlapping time stamps.
+ **/
+void libspdm_test_requester_get_version_case16(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    const libspdm_trace_phase_t expected_phase[] = {
+        LIBSPDM_TRACE_PHASE_ENCODE,
+        LIBSPDM_TRACE_PHASE_SEND,
+        LIBSPDM_TRACE_PHASE_WAIT,
+        LIBSPDM_TRACE_PHASE_DECODE,
+    };
+    uintn index;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x10;
+
+    m_libspdm_test_trace_event_count = 0;
+    m_libspdm_test_trace_time = 1;
+    libspdm_register_trace_func(spdm_context, libspdm_test_trace,
+                                libspdm_test_trace_get_time);
+
+    status = libspdm_get_version(spdm_context, NULL, NULL);
+    libspdm_register_trace_func(spdm_context, NULL, NULL);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    assert_int_equal(m_libspdm_test_trace_event_count, ARRAY_SIZE(expected_phase));
+    for (index = 0; index < ARRAY_SIZE(expected_phase); index++) {
+        assert_int_equal(m_libspdm_test_trace_event[index].phase, expected_phase[index]);
+        assert_int_equal(m_libspdm_test_trace_event[index].request_code, SPDM_GET_VERSION);
+        assert_int_equal(m_libspdm_test_trace_event[index].session_id, INVALID_SESSION_ID);
+        assert_true(m_libspdm_test_trace_event[index].size != 0);
+        assert_true(m_libspdm_test_trace_event[index].start_time <
+                    m_libspdm_test_trace_event[index].end_time);
+        if (index != 0) {
+            assert_true(m_libspdm_test_trace_event[index - 1].end_time <
+                        m_libspdm_test_trace_event[index].start_time);
+        }
+    }
+    assert_int_equal(m_libspdm_test_trace_event[0].size, sizeof(spdm_get_version_request_t));
+
+    /* No event once the trace function is unregistered.*/
+    m_libspdm_test_trace_event_count = 0;
+    status = libspdm_get_version(spdm_context, NULL, NULL);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(m_libspdm_test_trace_event_count, 0);
+}
+#endif
+
+#if LIBSPDM_MESSAGE_CAPTURE_SUPPORT
+/* Walk the records of a capture from the oldest, and check that they end at the head.*/
+static uint32_t libspdm_test_capture_walk(const libspdm_capture_header_t *header,
+                                          const libspdm_capture_record_t **record_list,
+                                          uint32_t record_list_count)
+{
+    const uint8_t *data;
+    const libspdm_capture_record_t *record;
+    uint32_t offset;
+    uint32_t index;
+    uint32_t count;
+
+    data = (const uint8_t *)(header + 1);
+    offset = header->tail;
+    count = 0;
+    for (index = 0; index < header->record_count; index++) {
+        if (header->data_size - offset < sizeof(libspdm_capture_record_t)) {
+            offset = 0;
+        }
+        record = (const libspdm_capture_record_t *)(data + offset);
+        assert_true(record->record_size >= sizeof(libspdm_capture_record_t));
+        assert_true(record->record_size <= header->data_size - offset);
+        assert_int_equal(record->record_size % 8, 0);
+        offset += record->record_size;
+        if ((record->type != LIBSPDM_CAPTURE_RECORD_PAD) && (count < record_list_count)) {
+            record_list[count++] = record;
+        }
+    }
+    if (header->data_size - offset < sizeof(libspdm_capture_record_t)) {
+        offset = 0;
+    }
+    assert_int_equal(offset, header->head);
+    return count;
+}
+
+/**
+ * Test 17: receiving a correct VERSION message while the messages are captured.
+ * Expected behavior: GET_VERSION and VERSION are captured in plain text and on the wire, in
+ * order; a small capture keeps the latest records; no record once the capture is stopped.
+ **/
+void libspdm_test_requester_get_version_case17(void **state)
+{
+    libspdm_return_t status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uint64_t capture[0x200 / sizeof(uint64_t)];
+    libspdm_capture_header_t *header;
+    const libspdm_capture_record_t *record[4];
+    const spdm_message_header_t *spdm_message;
+    const uint8_t expected_type[] = {
+        LIBSPDM_CAPTURE_RECORD_SPDM,
+        LIBSPDM_CAPTURE_RECORD_WIRE,
+        LIBSPDM_CAPTURE_RECORD_WIRE,
+        LIBSPDM_CAPTURE_RECORD_SPDM,
+    };
+    const uint8_t expected_direction[] = {
+        LIBSPDM_CAPTURE_DIRECTION_SEND,
+        LIBSPDM_CAPTURE_DIRECTION_SEND,
+        LIBSPDM_CAPTURE_DIRECTION_RECEIVE,
+        LIBSPDM_CAPTURE_DIRECTION_RECEIVE,
+    };
+    uint64_t sequence;
+    uintn index;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x11;
+    header = (libspdm_capture_header_t *)capture;
+
+    status = libspdm_start_message_capture(
+        spdm_context, capture, sizeof(capture),
+        LIBSPDM_CAPTURE_FLAG_MESSAGE | LIBSPDM_CAPTURE_FLAG_WIRE, NULL);
+    assert_int_equal(status, RETURN_SUCCESS);
+    status = libspdm_get_version(spdm_context, NULL, NULL);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+
+    assert_int_equal(header->signature, LIBSPDM_CAPTURE_SIGNATURE);
+    assert_int_equal(header->record_count, ARRAY_SIZE(expected_type));
+    assert_int_equal(header->sequence, ARRAY_SIZE(expected_type));
+    assert_int_equal(libspdm_test_capture_walk(header, record, ARRAY_SIZE(record)),
+                     ARRAY_SIZE(expected_type));
+    for (index = 0; index < ARRAY_SIZE(expected_type); index++) {
+        assert_int_equal(record[index]->type, expected_type[index]);
+        assert_int_equal(record[index]->direction, expected_direction[index]);
+        assert_int_equal(record[index]->session_id, INVALID_SESSION_ID);
+        assert_int_equal(record[index]->sequence, index);
+    }
+    assert_int_equal(record[0]->message_size, sizeof(spdm_get_version_request_t));
+    spdm_message = (const spdm_message_header_t *)(record[0] + 1);
+    assert_int_equal(spdm_message->request_response_code, SPDM_GET_VERSION);
+    spdm_message = (const spdm_message_header_t *)(record[3] + 1);
+    assert_int_equal(spdm_message->request_response_code, SPDM_VERSION);
+
+    /* The oldest records are overwritten, the latest is the last VERSION.*/
+    status = libspdm_start_message_capture(
+        spdm_context, capture, sizeof(libspdm_capture_header_t) + 0x80,
+        LIBSPDM_CAPTURE_FLAG_MESSAGE, NULL);
+    assert_int_equal(status, RETURN_SUCCESS);
+    for (index = 0; index < 5; index++) {
+        status = libspdm_get_version(spdm_context, NULL, NULL);
+        assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    }
+    assert_true(header->sequence >= 10);
+    assert_true(header->record_count < 10);
+    libspdm_test_capture_walk(header, record, 0);
+    index = libspdm_test_capture_walk(header, record, ARRAY_SIZE(record));
+    assert_true(index != 0);
+    assert_int_equal(record[index - 1]->sequence, header->sequence - 1);
+    assert_int_equal(record[index - 1]->type, LIBSPDM_CAPTURE_RECORD_SPDM);
+    assert_int_equal(record[index - 1]->direction, LIBSPDM_CAPTURE_DIRECTION_RECEIVE);
+
+    /* No record once the capture is stopped.*/
+    libspdm_stop_message_capture(spdm_context);
+    sequence = header->sequence;
+    status = libspdm_get_version(spdm_context, NULL, NULL);
+    assert_int_equal(status, LIBSPDM_STATUS_SUCCESS);
+    assert_int_equal(header->sequence, sequence);
+}
+#endif
+
 libspdm_test_context_t m_libspdm_requester_get_version_test_context = {
     LIBSPDM_TEST_CONTEXT_SIGNATURE,
     true,
@@ -683,6 +883,14 @@ int libspdm_requester_get_version_test_main(void)
         cmocka_unit_test(libspdm_test_requester_get_version_case14),
         /* Successful response for unordered version set*/
         cmocka_unit_test(libspdm_test_requester_get_version_case15),
+#if LIBSPDM_TRACE_SUPPORT
+        /* Successful response with a trace function*/
+        cmocka_unit_test(libspdm_test_requester_get_version_case16),
+#endif
+#if LIBSPDM_MESSAGE_CAPTURE_SUPPORT
+        /* Successful response with a message capture*/
+        cmocka_unit_test(libspdm_test_requester_get_version_case17),
+#endif
     };
 
     libspdm_setup_test_context(&m_libspdm_requester_get_version_test_context);
@@ -27,6 +27,11 @@ int libspdm_requester_encap_challenge_auth_test_main(void);
 int libspdm_requester_get_measurements_test_main(void);
 #endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
 
+#if (LIBSPDM_ENABLE_CAPABILITY_CERT_CAP) && (LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP) && \
+    (LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP)
+int libspdm_requester_attest_test_main(void);
+#endif /* LIBSPDM_ENABLE_CAPABILITY_CERT_CAP && ..._CHAL_CAP && ..._MEAS_CAP*/
+
 #if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
 int libspdm_requester_key_exchange_test_main(void);
 int libspdm_requester_finish_test_main(void);
@@ -87,6 +92,13 @@ int main(void)
     }
     #endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
 
+    #if (LIBSPDM_ENABLE_CAPABILITY_CERT_CAP) && (LIBSPDM_ENABLE_CAPABILITY_CHAL_CAP) && \
+    (LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP)
+    if (libspdm_requester_attest_test_main() != 0) {
+        return_value = 1;
+    }
+    #endif /* LIBSPDM_ENABLE_CAPABILITY_CERT_CAP && ..._CHAL_CAP && ..._MEAS_CAP*/
+
     #if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
     if (libspdm_requester_key_exchange_test_main() != 0) {
         return_value = 1;
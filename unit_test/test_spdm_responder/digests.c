@@ -499,6 +499,67 @@ void libspdm_test_responder_digests_case9(void **state)
     assert_int_equal(spdm_response->header.param2, SPDM_GET_DIGESTS);
 }
 
+/**
+ * Test 10: the chain is updated in place and set again with LIBSPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN
+ * Expected Behavior: the DIGESTS response carries the digest of the updated chain, not the
+ * cached digest of the previous one
+ **/
+void libspdm_test_responder_digests_case10(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uintn response_size;
+    uint8_t response[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    spdm_digest_response_t *spdm_response;
+    libspdm_data_parameter_t parameter;
+    uint8_t expected_digest[LIBSPDM_MAX_HASH_SIZE];
+    uintn hash_size;
+    uintn index;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0xA;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_10 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_CERT_CAP;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    hash_size = libspdm_get_hash_size(m_libspdm_use_hash_algo);
+    spdm_context->local_context.slot_count = 1;
+
+    libspdm_zero_mem(&parameter, sizeof(parameter));
+    parameter.location = LIBSPDM_DATA_LOCATION_LOCAL;
+    parameter.additional_data[0] = 0;
+
+    for (index = 0; index < 2; index++) {
+        libspdm_set_mem(m_libspdm_local_certificate_chain, LIBSPDM_MAX_MESSAGE_BUFFER_SIZE,
+                        (uint8_t)(0xFF - index));
+        status = libspdm_set_data(spdm_context, LIBSPDM_DATA_LOCAL_PUBLIC_CERT_CHAIN,
+                                  &parameter, m_libspdm_local_certificate_chain,
+                                  LIBSPDM_MAX_MESSAGE_BUFFER_SIZE);
+        assert_int_equal(status, RETURN_SUCCESS);
+        libspdm_hash_all(m_libspdm_use_hash_algo, m_libspdm_local_certificate_chain,
+                         LIBSPDM_MAX_MESSAGE_BUFFER_SIZE, expected_digest);
+
+        spdm_context->connection_info.connection_state =
+            LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+        response_size = sizeof(response);
+        libspdm_reset_message_b(spdm_context);
+        status = libspdm_get_response_digests(spdm_context,
+                                              m_libspdm_get_digests_request1_size,
+                                              &m_libspdm_get_digests_request1,
+                                              &response_size, response);
+        assert_int_equal(status, RETURN_SUCCESS);
+        assert_int_equal(response_size, sizeof(spdm_digest_response_t) + hash_size);
+        spdm_response = (void *)response;
+        assert_int_equal(spdm_response->header.request_response_code,
+                         SPDM_DIGESTS);
+        assert_memory_equal(spdm_response + 1, expected_digest, hash_size);
+    }
+}
+
 libspdm_test_context_t m_libspdm_responder_digests_test_context = {
     LIBSPDM_TEST_CONTEXT_SIGNATURE,
     false,
@@ -525,6 +586,8 @@ int libspdm_responder_digests_test_main(void)
         cmocka_unit_test(libspdm_test_responder_digests_case8),
         /* No digest to send*/
         cmocka_unit_test(libspdm_test_responder_digests_case9),
+        /* Cached digest flushed by libspdm_set_data*/
+        cmocka_unit_test(libspdm_test_responder_digests_case10),
     };
 
     libspdm_setup_test_context(&m_libspdm_responder_digests_test_context);
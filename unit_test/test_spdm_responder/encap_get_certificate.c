@@ -74,7 +74,7 @@ void test_spdm_responder_encap_get_certificate_case1(void **state)
     spdm_context->connection_info.algorithm.req_base_asym_alg =
         SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256;
 
-    libspdm_init_managed_buffer(&spdm_context->encap_context.certificate_chain_buffer,
+    libspdm_init_managed_buffer(spdm_context->encap_context.certificate_chain_buffer,
                                 LIBSPDM_MAX_MESSAGE_BUFFER_SIZE);
 
     if (m_libspdm_local_certificate_chain == NULL)
@@ -231,7 +231,7 @@ void test_spdm_responder_encap_get_certificate_case3(void **state)
     spdm_context->connection_info.algorithm.req_base_asym_alg =
         SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256;
 
-    libspdm_init_managed_buffer(&spdm_context->encap_context.certificate_chain_buffer,
+    libspdm_init_managed_buffer(spdm_context->encap_context.certificate_chain_buffer,
                                 LIBSPDM_MAX_MESSAGE_BUFFER_SIZE);
 
     if (m_libspdm_local_certificate_chain == NULL)
@@ -329,7 +329,7 @@ void test_spdm_responder_encap_get_certificate_case4(void **state)
     spdm_context->connection_info.algorithm.req_base_asym_alg =
         SPDM_ALGORITHMS_BASE_ASYM_ALGO_TPM_ALG_ECDSA_ECC_NIST_P256;
 
-    libspdm_init_managed_buffer(&spdm_context->encap_context.certificate_chain_buffer,
+    libspdm_init_managed_buffer(spdm_context->encap_context.certificate_chain_buffer,
                                 LIBSPDM_MAX_MESSAGE_BUFFER_SIZE);
 
     if (m_libspdm_local_certificate_chain == NULL)
@@ -366,10 +366,13 @@ void test_spdm_responder_encap_get_certificate_case4(void **state)
     m_libspdm_local_certificate_chain = NULL;
     m_libspdm_local_certificate_chain_size = 0;
 
+    /* the GET_CERTIFICATE request asked for LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN*/
+    spdm_context->local_context.cert_chain_block_len = LIBSPDM_MAX_CERT_CHAIN_BLOCK_LEN;
     status = libspdm_process_encap_response_certificate(spdm_context, spdm_response_size,
                                                         spdm_response,
                                                         &need_continue);
     assert_int_equal(status, RETURN_DEVICE_ERROR);
+    spdm_context->local_context.cert_chain_block_len = 0;
     free(data);
 }
 
@@ -6,6 +6,7 @@
 
 #include "spdm_unit_test.h"
 #include "internal/libspdm_responder_lib.h"
+#include "library/malloclib.h"
 
 #if LIBSPDM_ENABLE_CAPABILITY_KEY_EX_CAP
 
@@ -1445,6 +1446,238 @@ void libspdm_test_responder_key_exchange_case15(void **state)
     free(data1);
 }
 
+static uint32_t m_libspdm_memory_scope_session_id;
+static libspdm_memory_scope_event_t m_libspdm_memory_scope_event;
+static uintn m_libspdm_memory_scope_event_count;
+
+static void libspdm_test_memory_scope(void *spdm_context, uint32_t session_id,
+                                      libspdm_memory_scope_event_t event)
+{
+    m_libspdm_memory_scope_session_id = session_id;
+    m_libspdm_memory_scope_event = event;
+    m_libspdm_memory_scope_event_count++;
+}
+
+/**
+ * Test 16: the memory scope of the new session is entered once it is assigned, and released
+ * when it is freed.
+ **/
+void libspdm_test_responder_key_exchange_case16(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uintn response_size;
+    uint8_t response[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    void *data1;
+    uintn data_size1;
+    uint8_t *ptr;
+    uintn dhe_key_size;
+    void *dhe_context;
+    uintn opaque_key_exchange_req_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x10;
+
+    /* Clear previous sessions */
+    if(spdm_context->session_info[0].session_id != INVALID_SESSION_ID) {
+        libspdm_free_session_id(spdm_context,0xFFFFFFFF);
+    }
+
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.dhe_named_group =
+        m_libspdm_use_dhe_algo;
+    spdm_context->connection_info.algorithm.aead_cipher_suite =
+        m_libspdm_use_aead_algo;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data1,
+                                                    &data_size1, NULL, NULL);
+    spdm_context->local_context.local_cert_chain_provision[0] = data1;
+    spdm_context->local_context.local_cert_chain_provision_size[0] =
+        data_size1;
+    spdm_context->local_context.slot_count = 1;
+    libspdm_reset_message_a(spdm_context);
+    spdm_context->local_context.mut_auth_requested = 0;
+
+    libspdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
+                              m_libspdm_key_exchange_request1.random_data);
+    m_libspdm_key_exchange_request1.req_session_id = 0xFFFF;
+    m_libspdm_key_exchange_request1.reserved = 0;
+    ptr = m_libspdm_key_exchange_request1.exchange_data;
+    dhe_key_size = libspdm_get_dhe_pub_key_size(m_libspdm_use_dhe_algo);
+    dhe_context = libspdm_dhe_new(spdm_context->connection_info.version, m_libspdm_use_dhe_algo,
+                                  false);
+    libspdm_dhe_generate_key(m_libspdm_use_dhe_algo, dhe_context, ptr, &dhe_key_size);
+    ptr += dhe_key_size;
+    libspdm_dhe_free(m_libspdm_use_dhe_algo, dhe_context);
+    opaque_key_exchange_req_size =
+        libspdm_get_opaque_data_supported_version_data_size(spdm_context);
+    *(uint16_t *)ptr = (uint16_t)opaque_key_exchange_req_size;
+    ptr += sizeof(uint16_t);
+    libspdm_build_opaque_data_supported_version_data(
+        spdm_context, &opaque_key_exchange_req_size, ptr);
+    ptr += opaque_key_exchange_req_size;
+
+    m_libspdm_memory_scope_event_count = 0;
+    libspdm_register_memory_scope_func(spdm_context, libspdm_test_memory_scope);
+
+    response_size = sizeof(response);
+    status = libspdm_get_response_key_exchange(
+        spdm_context, m_libspdm_key_exchange_request1_size,
+        &m_libspdm_key_exchange_request1, &response_size, response);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(m_libspdm_memory_scope_event_count, 1);
+    assert_int_equal(m_libspdm_memory_scope_event, LIBSPDM_MEMORY_SCOPE_ENTER);
+    assert_int_equal(m_libspdm_memory_scope_session_id, 0xFFFFFFFF);
+
+    libspdm_free_session_id(spdm_context, 0xFFFFFFFF);
+    assert_int_equal(m_libspdm_memory_scope_event_count, 2);
+    assert_int_equal(m_libspdm_memory_scope_event, LIBSPDM_MEMORY_SCOPE_RELEASE);
+    assert_int_equal(m_libspdm_memory_scope_session_id, 0xFFFFFFFF);
+
+    libspdm_register_memory_scope_func(spdm_context, NULL);
+    free(data1);
+}
+
+#define LIBSPDM_TEST_SESSION_ARENA_SIZE 0x10000
+
+static uint64_t m_libspdm_session_arena_buffer[LIBSPDM_TEST_SESSION_ARENA_SIZE /
+                                               sizeof(uint64_t)];
+static libspdm_arena_t m_libspdm_session_arena;
+static const libspdm_pool_allocator_t *m_libspdm_session_arena_previous_allocator;
+static bool m_libspdm_session_arena_released;
+
+static void libspdm_test_session_arena_scope(void *spdm_context, uint32_t session_id,
+                                             libspdm_memory_scope_event_t event)
+{
+    if (session_id == INVALID_SESSION_ID) {
+        return;
+    }
+    if (event == LIBSPDM_MEMORY_SCOPE_ENTER) {
+        m_libspdm_session_arena_previous_allocator =
+            libspdm_set_pool_allocator(&m_libspdm_session_arena.allocator);
+    } else if (event == LIBSPDM_MEMORY_SCOPE_RELEASE) {
+        libspdm_set_pool_allocator(m_libspdm_session_arena_previous_allocator);
+        m_libspdm_session_arena_released = libspdm_arena_release(&m_libspdm_session_arena);
+    }
+}
+
+/**
+ * Test 17: the objects allocated from the arena of the new session are all freed with the
+ * session, so the arena is reclaimed. The state kept by the crypto backend until the end of
+ * the process must not come from the arena.
+ **/
+void libspdm_test_responder_key_exchange_case17(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uintn response_size;
+    uint8_t response[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    spdm_key_exchange_response_t *spdm_response;
+    void *data1;
+    uintn data_size1;
+    uint8_t *ptr;
+    uintn dhe_key_size;
+    void *dhe_context;
+    uintn opaque_key_exchange_req_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x11;
+
+    /* Clear previous sessions */
+    if(spdm_context->session_info[0].session_id != INVALID_SESSION_ID) {
+        libspdm_free_session_id(spdm_context,0xFFFFFFFF);
+    }
+
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+    spdm_context->connection_info.capability.flags |=
+        SPDM_GET_CAPABILITIES_REQUEST_FLAGS_KEY_EX_CAP;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_KEY_EX_CAP;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.algorithm.dhe_named_group =
+        m_libspdm_use_dhe_algo;
+    spdm_context->connection_info.algorithm.aead_cipher_suite =
+        m_libspdm_use_aead_algo;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    libspdm_read_responder_public_certificate_chain(m_libspdm_use_hash_algo,
+                                                    m_libspdm_use_asym_algo, &data1,
+                                                    &data_size1, NULL, NULL);
+    spdm_context->local_context.local_cert_chain_provision[0] = data1;
+    spdm_context->local_context.local_cert_chain_provision_size[0] =
+        data_size1;
+    spdm_context->local_context.slot_count = 1;
+    libspdm_reset_message_a(spdm_context);
+    spdm_context->local_context.mut_auth_requested = 0;
+
+    libspdm_get_random_number(SPDM_RANDOM_DATA_SIZE,
+                              m_libspdm_key_exchange_request1.random_data);
+    m_libspdm_key_exchange_request1.req_session_id = 0xFFFF;
+    m_libspdm_key_exchange_request1.reserved = 0;
+    ptr = m_libspdm_key_exchange_request1.exchange_data;
+    dhe_key_size = libspdm_get_dhe_pub_key_size(m_libspdm_use_dhe_algo);
+    dhe_context = libspdm_dhe_new(spdm_context->connection_info.version, m_libspdm_use_dhe_algo,
+                                  false);
+    libspdm_dhe_generate_key(m_libspdm_use_dhe_algo, dhe_context, ptr, &dhe_key_size);
+    ptr += dhe_key_size;
+    libspdm_dhe_free(m_libspdm_use_dhe_algo, dhe_context);
+    opaque_key_exchange_req_size =
+        libspdm_get_opaque_data_supported_version_data_size(spdm_context);
+    *(uint16_t *)ptr = (uint16_t)opaque_key_exchange_req_size;
+    ptr += sizeof(uint16_t);
+    libspdm_build_opaque_data_supported_version_data(
+        spdm_context, &opaque_key_exchange_req_size, ptr);
+    ptr += opaque_key_exchange_req_size;
+
+    libspdm_arena_init(&m_libspdm_session_arena, m_libspdm_session_arena_buffer,
+                       sizeof(m_libspdm_session_arena_buffer));
+    m_libspdm_session_arena_released = false;
+    libspdm_register_memory_scope_func(spdm_context, libspdm_test_session_arena_scope);
+
+    response_size = sizeof(response);
+    status = libspdm_get_response_key_exchange(
+        spdm_context, m_libspdm_key_exchange_request1_size,
+        &m_libspdm_key_exchange_request1, &response_size, response);
+    assert_int_equal(status, RETURN_SUCCESS);
+    spdm_response = (void *)response;
+    assert_int_equal(spdm_response->header.request_response_code, SPDM_KEY_EXCHANGE_RSP);
+
+    libspdm_free_session_id(spdm_context, 0xFFFFFFFF);
+    assert_true(m_libspdm_session_arena_released);
+    assert_int_equal(m_libspdm_session_arena.live_count, 0);
+    assert_int_equal(m_libspdm_session_arena.used, 0);
+
+    libspdm_register_memory_scope_func(spdm_context, NULL);
+    free(data1);
+}
+
 libspdm_test_context_t m_libspdm_responder_key_exchange_test_context = {
     LIBSPDM_TEST_CONTEXT_SIGNATURE,
     false,
@@ -1483,6 +1716,10 @@ int libspdm_responder_key_exchange_test_main(void)
         cmocka_unit_test(libspdm_test_responder_key_exchange_case14),
         /* HANDSHAKE_IN_THE_CLEAR set for requester and responder */
         cmocka_unit_test(libspdm_test_responder_key_exchange_case15),
+        /* Memory scope of the new session */
+        cmocka_unit_test(libspdm_test_responder_key_exchange_case16),
+        /* Arena of the new session reclaimed when it is freed */
+        cmocka_unit_test(libspdm_test_responder_key_exchange_case17),
     };
 
     libspdm_setup_test_context(&m_libspdm_responder_key_exchange_test_context);
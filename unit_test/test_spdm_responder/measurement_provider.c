@@ -0,0 +1,272 @@
+/**
+ *  Copyright Notice:
+ *  Copyright 2022 DMTF. All rights reserved.
+ *  License: BSD 3-Clause License. For full text see link: https://github.com/DMTF/libspdm/blob/main/LICENSE.md
+ **/
+
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#include <sys/types.h>
+#include <utime.h>
+#else
+#include <sys/types.h>
+#include <sys/utime.h>
+#endif
+
+#include "spdm_unit_test.h"
+#include "internal/libspdm_responder_lib.h"
+
+#if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
+
+#define LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE "test_measurement_provider.bin"
+/* more than one chunk, so the image is hashed as a multi-chunk stream*/
+#define LIBSPDM_TEST_MEASUREMENT_IMAGE_SIZE (LIBSPDM_MEASUREMENT_PROVIDER_CHUNK_SIZE + 0x123)
+#define LIBSPDM_TEST_MEASUREMENT_HASH_ALGO SPDM_ALGORITHMS_MEASUREMENT_HASH_ALGO_TPM_ALG_SHA_256
+
+/**
+ * Write the test image file, filled with a byte pattern.
+ **/
+static void libspdm_test_measurement_provider_write_image(uintn image_size, uint8_t seed,
+                                                          uint8_t *digest)
+{
+    FILE *fp_out;
+    uint8_t *image;
+    uintn index;
+
+    image = malloc(image_size);
+    assert_non_null(image);
+    for (index = 0; index < image_size; index++) {
+        image[index] = (uint8_t)(index * 7 + seed);
+    }
+    fp_out = fopen(LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE, "wb");
+    assert_non_null(fp_out);
+    assert_int_equal(fwrite(image, 1, image_size, fp_out), image_size);
+    fclose(fp_out);
+
+    assert_true(libspdm_measurement_hash_all(LIBSPDM_TEST_MEASUREMENT_HASH_ALGO,
+                                             image, image_size, digest));
+    free(image);
+}
+
+/**
+ * Move the modification time of the test image file, the content is unchanged.
+ **/
+static void libspdm_test_measurement_provider_touch_image(time_t mtime)
+{
+#if defined(_WIN32)
+    struct _utimbuf times;
+
+    times.actime = mtime;
+    times.modtime = mtime;
+    assert_int_equal(_utime(LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE, &times), 0);
+#else
+    struct utimbuf times;
+
+    times.actime = mtime;
+    times.modtime = mtime;
+    assert_int_equal(utime(LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE, &times), 0);
+#endif
+}
+
+/**
+ * Test 1: the digests hashed by libspdm_measurement_provider_prepare() are served from the
+ * cache, and match the digest of the whole image.
+ **/
+void libspdm_test_measurement_provider_case1(void **state)
+{
+    uint8_t expected_digest[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t digest[LIBSPDM_MAX_HASH_SIZE];
+    uint64_t hit_count[2];
+    uint64_t miss_count[2];
+    uint64_t hashed_bytes[2];
+
+    libspdm_test_measurement_provider_write_image(LIBSPDM_TEST_MEASUREMENT_IMAGE_SIZE, 1,
+                                                  expected_digest);
+    assert_true(libspdm_measurement_provider_set_image(1, LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE));
+    libspdm_measurement_provider_get_statistics(&hit_count[0], &miss_count[0], &hashed_bytes[0]);
+
+    assert_true(libspdm_measurement_provider_prepare(LIBSPDM_TEST_MEASUREMENT_HASH_ALGO));
+    libspdm_measurement_provider_get_statistics(&hit_count[1], &miss_count[1], &hashed_bytes[1]);
+    assert_int_equal(hit_count[1], hit_count[0]);
+    assert_int_equal(miss_count[1], miss_count[0] + 1);
+    assert_int_equal(hashed_bytes[1], hashed_bytes[0] + LIBSPDM_TEST_MEASUREMENT_IMAGE_SIZE);
+
+    assert_true(libspdm_measurement_provider_get_digest(1, LIBSPDM_TEST_MEASUREMENT_HASH_ALGO,
+                                                        digest));
+    libspdm_measurement_provider_get_statistics(&hit_count[0], &miss_count[0], &hashed_bytes[0]);
+    assert_int_equal(hit_count[0], hit_count[1] + 1);
+    assert_int_equal(miss_count[0], miss_count[1]);
+    assert_int_equal(hashed_bytes[0], hashed_bytes[1]);
+    assert_memory_equal(digest, expected_digest,
+                        libspdm_get_measurement_hash_size(LIBSPDM_TEST_MEASUREMENT_HASH_ALGO));
+
+    /* a prepared image is not hashed again*/
+    assert_true(libspdm_measurement_provider_prepare(LIBSPDM_TEST_MEASUREMENT_HASH_ALGO));
+    libspdm_measurement_provider_get_statistics(&hit_count[1], &miss_count[1], NULL);
+    assert_int_equal(hit_count[1], hit_count[0] + 1);
+    assert_int_equal(miss_count[1], miss_count[0]);
+
+    assert_true(libspdm_measurement_provider_set_image(1, NULL));
+    remove(LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE);
+}
+
+/**
+ * Test 2: a cached digest misses once the modification time of the image moved, and a
+ * replaced shorter image is hashed to its own digest.
+ **/
+void libspdm_test_measurement_provider_case2(void **state)
+{
+    uint8_t expected_digest[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t digest[LIBSPDM_MAX_HASH_SIZE];
+    uint64_t hit_count[2];
+    uint64_t miss_count[2];
+    uintn hash_size;
+
+    hash_size = libspdm_get_measurement_hash_size(LIBSPDM_TEST_MEASUREMENT_HASH_ALGO);
+    libspdm_test_measurement_provider_write_image(LIBSPDM_TEST_MEASUREMENT_IMAGE_SIZE, 2,
+                                                  expected_digest);
+    libspdm_test_measurement_provider_touch_image(1000000000);
+    assert_true(libspdm_measurement_provider_set_image(1, LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE));
+    assert_true(libspdm_measurement_provider_get_digest(1, LIBSPDM_TEST_MEASUREMENT_HASH_ALGO,
+                                                        digest));
+
+    libspdm_test_measurement_provider_touch_image(1000000100);
+    libspdm_measurement_provider_get_statistics(&hit_count[0], &miss_count[0], NULL);
+    assert_true(libspdm_measurement_provider_get_digest(1, LIBSPDM_TEST_MEASUREMENT_HASH_ALGO,
+                                                        digest));
+    libspdm_measurement_provider_get_statistics(&hit_count[1], &miss_count[1], NULL);
+    assert_int_equal(hit_count[1], hit_count[0]);
+    assert_int_equal(miss_count[1], miss_count[0] + 1);
+    assert_memory_equal(digest, expected_digest, hash_size);
+
+    /* the digest of the new identity is cached*/
+    assert_true(libspdm_measurement_provider_get_digest(1, LIBSPDM_TEST_MEASUREMENT_HASH_ALGO,
+                                                        digest));
+    libspdm_measurement_provider_get_statistics(&hit_count[0], &miss_count[0], NULL);
+    assert_int_equal(hit_count[0], hit_count[1] + 1);
+    assert_int_equal(miss_count[0], miss_count[1]);
+
+    libspdm_test_measurement_provider_write_image(0x100, 3, expected_digest);
+    assert_true(libspdm_measurement_provider_get_digest(1, LIBSPDM_TEST_MEASUREMENT_HASH_ALGO,
+                                                        digest));
+    assert_memory_equal(digest, expected_digest, hash_size);
+
+    assert_true(libspdm_measurement_provider_set_image(1, NULL));
+    remove(LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE);
+}
+
+/**
+ * Test 3: a changed image is reported once by libspdm_measurement_provider_check_images(),
+ * and moves the measurement generation.
+ **/
+void libspdm_test_measurement_provider_case3(void **state)
+{
+    uint8_t expected_digest[LIBSPDM_MAX_HASH_SIZE];
+    uint32_t generation;
+
+    libspdm_test_measurement_provider_write_image(0x200, 4, expected_digest);
+    libspdm_test_measurement_provider_touch_image(1000000000);
+    assert_true(libspdm_measurement_provider_set_image(1, LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE));
+
+    /* the first check records the identity of the new image*/
+    libspdm_measurement_provider_check_images();
+    assert_false(libspdm_measurement_provider_check_images());
+    generation = libspdm_measurement_get_generation();
+    assert_int_equal(libspdm_measurement_get_generation(), generation);
+
+    libspdm_test_measurement_provider_touch_image(1000000100);
+    assert_true(libspdm_measurement_provider_check_images());
+    assert_false(libspdm_measurement_provider_check_images());
+
+    libspdm_test_measurement_provider_touch_image(1000000200);
+    assert_int_not_equal(libspdm_measurement_get_generation(), generation);
+    generation = libspdm_measurement_get_generation();
+    assert_int_equal(libspdm_measurement_get_generation(), generation);
+
+    /* a removed image is a change too*/
+    remove(LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE);
+    assert_true(libspdm_measurement_provider_check_images());
+
+    assert_true(libspdm_measurement_provider_set_image(1, NULL));
+}
+
+/**
+ * Test 4: libspdm_measurement_provider_set_image(NULL) restores the built-in raw data of the
+ * measurement index.
+ **/
+void libspdm_test_measurement_provider_case4(void **state)
+{
+    uint8_t expected_digest[LIBSPDM_MAX_HASH_SIZE];
+    uint8_t raw_data[LIBSPDM_MEASUREMENT_RAW_DATA_SIZE];
+    uint8_t measurements[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    spdm_measurement_block_dmtf_t *measurement_block;
+    uintn measurements_size;
+    uint8_t measurements_count;
+    uint8_t content_changed;
+    uint8_t digest[LIBSPDM_MAX_HASH_SIZE];
+    uint32_t generation;
+    uintn hash_size;
+
+    hash_size = libspdm_get_measurement_hash_size(LIBSPDM_TEST_MEASUREMENT_HASH_ALGO);
+    measurement_block = (void *)measurements;
+    libspdm_test_measurement_provider_write_image(0x300, 5, expected_digest);
+    assert_false(libspdm_measurement_provider_set_image(0, LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE));
+    assert_false(libspdm_measurement_provider_set_image(
+                     LIBSPDM_MEASUREMENT_BLOCK_HASH_NUMBER + 1,
+                     LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE));
+
+    generation = libspdm_measurement_get_generation();
+    assert_true(libspdm_measurement_provider_set_image(1, LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE));
+    assert_int_not_equal(libspdm_measurement_get_generation(), generation);
+    assert_true(libspdm_measurement_provider_has_image(1));
+
+    measurements_size = sizeof(measurements);
+    assert_int_equal(libspdm_measurement_collection(
+                         SPDM_MESSAGE_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+                         SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF,
+                         LIBSPDM_TEST_MEASUREMENT_HASH_ALGO, 1, 0, &content_changed,
+                         &measurements_count, measurements, &measurements_size),
+                     RETURN_SUCCESS);
+    assert_int_equal(measurement_block->measurement_block_dmtf_header
+                     .dmtf_spec_measurement_value_size, hash_size);
+    assert_memory_equal(measurement_block + 1, expected_digest, hash_size);
+
+    generation = libspdm_measurement_get_generation();
+    assert_true(libspdm_measurement_provider_set_image(1, NULL));
+    assert_int_not_equal(libspdm_measurement_get_generation(), generation);
+    assert_false(libspdm_measurement_provider_has_image(1));
+    assert_false(libspdm_measurement_provider_get_digest(1, LIBSPDM_TEST_MEASUREMENT_HASH_ALGO,
+                                                         digest));
+
+    libspdm_set_mem(raw_data, sizeof(raw_data), 1);
+    assert_true(libspdm_measurement_hash_all(LIBSPDM_TEST_MEASUREMENT_HASH_ALGO,
+                                             raw_data, sizeof(raw_data), expected_digest));
+    measurements_size = sizeof(measurements);
+    assert_int_equal(libspdm_measurement_collection(
+                         SPDM_MESSAGE_VERSION_11 << SPDM_VERSION_NUMBER_SHIFT_BIT,
+                         SPDM_MEASUREMENT_BLOCK_HEADER_SPECIFICATION_DMTF,
+                         LIBSPDM_TEST_MEASUREMENT_HASH_ALGO, 1, 0, &content_changed,
+                         &measurements_count, measurements, &measurements_size),
+                     RETURN_SUCCESS);
+    assert_memory_equal(measurement_block + 1, expected_digest, hash_size);
+
+    remove(LIBSPDM_TEST_MEASUREMENT_IMAGE_FILE);
+}
+
+int libspdm_measurement_provider_test_main(void)
+{
+    const struct CMUnitTest spdm_measurement_provider_tests[] = {
+        /* Cache hit after prepare*/
+        cmocka_unit_test(libspdm_test_measurement_provider_case1),
+        /* Cache miss after the modification time moved*/
+        cmocka_unit_test(libspdm_test_measurement_provider_case2),
+        /* Changed image moves the measurement generation*/
+        cmocka_unit_test(libspdm_test_measurement_provider_case3),
+        /* set_image(NULL) restores the built-in raw data*/
+        cmocka_unit_test(libspdm_test_measurement_provider_case4),
+    };
+
+    return cmocka_run_group_tests(spdm_measurement_provider_tests, NULL, NULL);
+}
+
+#endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
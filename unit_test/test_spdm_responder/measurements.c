@@ -96,6 +96,18 @@ spdm_get_measurements_request_t m_libspdm_get_measurements_request13 = {
 };
 uintn m_libspdm_get_measurements_request13_size = sizeof(spdm_message_header_t);
 
+spdm_get_measurements_request_t m_libspdm_get_measurements_request14 = {
+    { SPDM_MESSAGE_VERSION_12, SPDM_GET_MEASUREMENTS, 0, 1 },
+};
+uintn m_libspdm_get_measurements_request14_size = sizeof(spdm_message_header_t);
+
+spdm_get_measurements_request_t m_libspdm_get_measurements_request15 = {
+    { SPDM_MESSAGE_VERSION_12, SPDM_GET_MEASUREMENTS,
+      SPDM_GET_MEASUREMENTS_REQUEST_ATTRIBUTES_GENERATE_SIGNATURE, 1 },
+};
+uintn m_libspdm_get_measurements_request15_size =
+    sizeof(m_libspdm_get_measurements_request15);
+
 static uint8_t m_libspdm_local_psk_hint[32];
 
 /**
@@ -1503,6 +1515,167 @@ void libspdm_test_responder_measurements_case23(void **state)
 #endif
 }
 
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+/**
+ * Test 24: Measurement generation moves during L1/L2 of a 1.2 connection
+ * Expected Behavior: the signed response reports a detected change, the next L1/L2 reports no change,
+ * and the measurement block served from the measurement cache matches the device measurement.
+ **/
+void libspdm_test_responder_measurements_case24(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uintn response_size;
+    uint8_t response[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    spdm_measurements_response_t *spdm_response;
+    uint8_t device_measurement[LIBSPDM_MAX_MEASUREMENT_RECORD_SIZE];
+    uintn device_measurement_size;
+    uint8_t device_measurement_count;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x18;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AUTHENTICATED;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_12 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->last_spdm_request_session_id_valid = false;
+    spdm_context->local_context.opaque_measurement_rsp_size = 0;
+    spdm_context->local_context.opaque_measurement_rsp = NULL;
+    libspdm_reset_message_m(spdm_context, NULL);
+
+    /* first GET_MEASUREMENTS of L1/L2*/
+    response_size = sizeof(response);
+    status = libspdm_get_response_measurements(
+        spdm_context, m_libspdm_get_measurements_request14_size,
+        &m_libspdm_get_measurements_request14, &response_size, response);
+    assert_int_equal(status, RETURN_SUCCESS);
+    spdm_response = (void *)response;
+    assert_int_equal(spdm_response->header.request_response_code, SPDM_MEASUREMENTS);
+
+    device_measurement_size = sizeof(device_measurement);
+    status = libspdm_measurement_collection(
+        spdm_context->connection_info.version,
+        m_libspdm_use_measurement_spec, m_libspdm_use_measurement_hash_algo, 1, 0, NULL,
+        &device_measurement_count, device_measurement, &device_measurement_size);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(spdm_response->number_of_blocks, 1);
+    assert_int_equal(libspdm_read_uint24(spdm_response->measurement_record_length),
+                     device_measurement_size);
+    assert_memory_equal(spdm_response + 1, device_measurement, device_measurement_size);
+
+    /* the measurements change before the signed GET_MEASUREMENTS*/
+    libspdm_measurement_update_generation();
+    libspdm_get_random_number(SPDM_NONCE_SIZE, m_libspdm_get_measurements_request15.nonce);
+    response_size = sizeof(response);
+    status = libspdm_get_response_measurements(
+        spdm_context, m_libspdm_get_measurements_request15_size,
+        &m_libspdm_get_measurements_request15, &response_size, response);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(spdm_response->header.request_response_code, SPDM_MEASUREMENTS);
+    assert_int_equal(spdm_response->header.param2 & SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_MASK,
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_DETECTED);
+
+    /* a new L1/L2 starts with the new generation*/
+    libspdm_get_random_number(SPDM_NONCE_SIZE, m_libspdm_get_measurements_request15.nonce);
+    response_size = sizeof(response);
+    status = libspdm_get_response_measurements(
+        spdm_context, m_libspdm_get_measurements_request15_size,
+        &m_libspdm_get_measurements_request15, &response_size, response);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(spdm_response->header.request_response_code, SPDM_MEASUREMENTS);
+    assert_int_equal(spdm_response->header.param2 & SPDM_MEASUREMENTS_RESPONSE_CONTENT_CHANGE_MASK,
+                     SPDM_MEASUREMENTS_RESPONSE_CONTENT_NO_CHANGE_DETECTED);
+}
+#endif /* LIBSPDM_MEASUREMENT_CACHE_SUPPORT*/
+
+/**
+ * Test 25: Out-of-session GET_MEASUREMENTS with signature once the algorithms are negotiated,
+ * without CHALLENGE, then before the algorithms are negotiated
+ * Expected Behavior: a signed MEASUREMENTS response in the NEGOTIATED state, and an
+ * ERROR_RESPONSE with code SPDM_ERROR_CODE_UNEXPECTED_REQUEST in the AFTER_CAPABILITIES state
+ **/
+void libspdm_test_responder_measurements_case25(void **state)
+{
+    return_status status;
+    libspdm_test_context_t *spdm_test_context;
+    libspdm_context_t *spdm_context;
+    uintn response_size;
+    uint8_t response[LIBSPDM_MAX_MESSAGE_BUFFER_SIZE];
+    spdm_measurements_response_t *spdm_response;
+    uintn measurment_sig_size;
+
+    spdm_test_context = *state;
+    spdm_context = spdm_test_context->spdm_context;
+    spdm_test_context->case_id = 0x19;
+    spdm_context->connection_info.version = SPDM_MESSAGE_VERSION_11 <<
+                                            SPDM_VERSION_NUMBER_SHIFT_BIT;
+    spdm_context->response_state = LIBSPDM_RESPONSE_STATE_NORMAL;
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_NEGOTIATED;
+    spdm_context->last_spdm_request_session_id_valid = false;
+    spdm_context->local_context.capability.flags |=
+        SPDM_GET_CAPABILITIES_RESPONSE_FLAGS_MEAS_CAP_SIG;
+    spdm_context->connection_info.algorithm.base_hash_algo =
+        m_libspdm_use_hash_algo;
+    spdm_context->connection_info.algorithm.base_asym_algo =
+        m_libspdm_use_asym_algo;
+    spdm_context->connection_info.algorithm.measurement_spec =
+        m_libspdm_use_measurement_spec;
+    spdm_context->connection_info.algorithm.measurement_hash_algo =
+        m_libspdm_use_measurement_hash_algo;
+    libspdm_reset_message_m(spdm_context, NULL);
+    spdm_context->local_context.opaque_measurement_rsp_size = 0;
+    spdm_context->local_context.opaque_measurement_rsp = NULL;
+    measurment_sig_size = SPDM_NONCE_SIZE + sizeof(uint16_t) + 0 +
+                          libspdm_get_asym_signature_size(m_libspdm_use_asym_algo);
+
+    response_size = sizeof(response);
+    libspdm_get_random_number(SPDM_NONCE_SIZE,
+                              m_libspdm_get_measurements_request10.nonce);
+    status = libspdm_get_response_measurements(
+        spdm_context, m_libspdm_get_measurements_request10_size,
+        &m_libspdm_get_measurements_request10, &response_size, response);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(response_size,
+                     sizeof(spdm_measurements_response_t) +
+                     sizeof(spdm_measurement_block_dmtf_t) +
+                     libspdm_get_measurement_hash_size(
+                         m_libspdm_use_measurement_hash_algo) +
+                     measurment_sig_size);
+    spdm_response = (void *)response;
+    assert_int_equal(spdm_response->header.request_response_code,
+                     SPDM_MEASUREMENTS);
+#if LIBSPDM_RECORD_TRANSCRIPT_DATA_SUPPORT
+    assert_int_equal(spdm_context->transcript.message_m.buffer_size, 0);
+#endif
+
+    spdm_context->connection_info.connection_state =
+        LIBSPDM_CONNECTION_STATE_AFTER_CAPABILITIES;
+    response_size = sizeof(response);
+    status = libspdm_get_response_measurements(
+        spdm_context, m_libspdm_get_measurements_request10_size,
+        &m_libspdm_get_measurements_request10, &response_size, response);
+    assert_int_equal(status, RETURN_SUCCESS);
+    assert_int_equal(response_size, sizeof(spdm_error_response_t));
+    spdm_response = (void *)response;
+    assert_int_equal(spdm_response->header.request_response_code,
+                     SPDM_ERROR);
+    assert_int_equal(spdm_response->header.param1,
+                     SPDM_ERROR_CODE_UNEXPECTED_REQUEST);
+}
+
 libspdm_test_context_t m_libspdm_responder_measurements_test_context = {
     LIBSPDM_TEST_CONTEXT_SIGNATURE,
     false,
@@ -1560,6 +1733,12 @@ int libspdm_responder_measurements_test_main(void)
         cmocka_unit_test(libspdm_test_responder_measurements_case22),
         /* Successful response to get a session based measurement with signature*/
         cmocka_unit_test(libspdm_test_responder_measurements_case23),
+#if LIBSPDM_MEASUREMENT_CACHE_SUPPORT
+        /* Measurement generation moves during L1/L2*/
+        cmocka_unit_test(libspdm_test_responder_measurements_case24),
+#endif
+        /* Success Case: signed measurement in the NEGOTIATED state, without CHALLENGE*/
+        cmocka_unit_test(libspdm_test_responder_measurements_case25),
     };
 
     libspdm_setup_test_context(&m_libspdm_responder_measurements_test_context);
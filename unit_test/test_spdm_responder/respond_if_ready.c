@@ -316,12 +316,12 @@ void libspdm_test_responder_respond_if_ready_case1(void **state) {
     spdm_context->local_context.slot_count = 1;
 
     spdm_context->last_spdm_request_size = m_libspdm_get_digest_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_get_digest_request, m_libspdm_get_digest_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -387,12 +387,12 @@ void libspdm_test_responder_respond_if_ready_case2(void **state) {
     spdm_context->local_context.slot_count = 1;
 
     spdm_context->last_spdm_request_size = m_libspdm_get_certificate_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_get_certificate_request, m_libspdm_get_certificate_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -465,12 +465,12 @@ void libspdm_test_responder_respond_if_ready_case3(void **state) {
     spdm_context->local_context.opaque_challenge_auth_rsp_size = 0;
 
     spdm_context->last_spdm_request_size = m_libspdm_challenge_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_challenge_request, m_libspdm_challenge_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -536,12 +536,12 @@ void libspdm_test_responder_respond_if_ready_case4(void **state) {
     spdm_context->local_context.opaque_measurement_rsp = NULL;
 
     spdm_context->last_spdm_request_size = m_libspdm_get_measurements_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_get_measurements_request, m_libspdm_get_measurements_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -638,12 +638,12 @@ void libspdm_test_responder_respond_if_ready_case5(void **state) {
     ptr += opaque_key_exchange_req_size;
 
     spdm_context->last_spdm_request_size = m_libspdm_key_exchange_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_key_exchange_request, m_libspdm_key_exchange_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -768,12 +768,12 @@ void libspdm_test_responder_respond_if_ready_case6(void **state) {
                           &th_curr), request_finished_key, hash_size, ptr);
 
     spdm_context->last_spdm_request_size = sizeof(spdm_finish_request_t) + hmac_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_finish_request, m_libspdm_finish_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -873,12 +873,12 @@ void libspdm_test_responder_respond_if_ready_case7(void **state) {
     ptr += opaque_psk_exchange_req_size;
 
     spdm_context->last_spdm_request_size = m_libspdm_psk_exchange_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_psk_exchange_request, m_libspdm_psk_exchange_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -998,12 +998,12 @@ void libspdm_test_responder_respond_if_ready_case8(void **state) {
                           &th_curr), request_finished_key, hash_size, ptr);
 
     spdm_context->last_spdm_request_size = sizeof(spdm_psk_finish_request_t) + hmac_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_psk_finish_request, m_libspdm_psk_finish_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -1058,12 +1058,12 @@ void libspdm_test_responder_respond_if_ready_case9(void **state) {
                      (uint8_t)(0xFF));
     spdm_context->local_context.slot_count = 1;
     spdm_context->last_spdm_request_size = m_libspdm_get_digest_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_get_digest_request, m_libspdm_get_digest_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -1118,12 +1118,12 @@ void libspdm_test_responder_respond_if_ready_case10(void **state) {
                      (uint8_t)(0xFF));
     spdm_context->local_context.slot_count = 1;
     spdm_context->last_spdm_request_size = m_libspdm_get_digest_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_get_digest_request, m_libspdm_get_digest_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -1179,12 +1179,12 @@ void libspdm_test_responder_respond_if_ready_case11(void **state) {
                      (uint8_t)(0xFF));
     spdm_context->local_context.slot_count = 1;
     spdm_context->last_spdm_request_size = m_libspdm_get_digest_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_get_digest_request, m_libspdm_get_digest_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -1242,12 +1242,12 @@ void libspdm_test_responder_respond_if_ready_case12(void **state) {
                      (uint8_t)(0xFF));
     spdm_context->local_context.slot_count = 1;
     spdm_context->last_spdm_request_size = m_libspdm_get_digest_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_get_digest_request, m_libspdm_get_digest_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -1308,12 +1308,12 @@ void libspdm_test_responder_respond_if_ready_case13(void **state) {
                      (uint8_t)(0xFF));
     spdm_context->local_context.slot_count = 1;
     spdm_context->last_spdm_request_size = m_libspdm_get_digest_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_get_digest_request, m_libspdm_get_digest_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -1367,12 +1367,12 @@ void libspdm_test_responder_respond_if_ready_case14(void **state) {
                      (uint8_t)(0xFF));
     spdm_context->local_context.slot_count = 1;
     spdm_context->last_spdm_request_size = m_libspdm_get_digest_request_size;
-    libspdm_copy_mem(spdm_context->last_spdm_request, sizeof(spdm_context->last_spdm_request),
+    libspdm_copy_mem(spdm_context->last_spdm_request, spdm_context->config.max_message_size,
                      &m_libspdm_get_digest_request, m_libspdm_get_digest_request_size);
 
     /*RESPOND_IF_READY specific data*/
     spdm_context->cache_spdm_request_size = spdm_context->last_spdm_request_size;
-    libspdm_copy_mem(spdm_context->cache_spdm_request, sizeof(spdm_context->cache_spdm_request),
+    libspdm_copy_mem(spdm_context->cache_spdm_request, spdm_context->config.max_message_size,
                      spdm_context->last_spdm_request, spdm_context->last_spdm_request_size);
     spdm_context->error_data.rd_exponent = 1;
     spdm_context->error_data.rd_tm        = 1;
@@ -23,6 +23,7 @@ int libspdm_responder_challenge_auth_test_main(void);
 
 #if LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP
 int libspdm_responder_measurements_test_main(void);
+int libspdm_measurement_provider_test_main(void);
 #endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
 
 #if (LIBSPDM_ENABLE_CAPABILITY_CERT_CAP ||                                     \
@@ -52,6 +53,11 @@ int main(void)
 {
     int return_value = 0;
 
+    /* Route the crypto backend through the pool allocator, for the session arena tests.*/
+    if (!libspdm_crypt_use_pool_allocator()) {
+        return 1;
+    }
+
     if (libspdm_responder_version_test_main() != 0) {
         return_value = 1;
     }
@@ -88,6 +94,9 @@ int main(void)
     if (libspdm_responder_measurements_test_main() != 0) {
         return_value = 1;
     }
+    if (libspdm_measurement_provider_test_main() != 0) {
+        return_value = 1;
+    }
     #endif /* LIBSPDM_ENABLE_CAPABILITY_MEAS_CAP*/
 
 #if (LIBSPDM_ENABLE_CAPABILITY_CERT_CAP ||                                     \